@@ -0,0 +1,189 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "bench.h"
+
+volatile uint64_t bench_sink;
+
+typedef enum {
+    BENCH_FORMAT_TEXT,
+    BENCH_FORMAT_CSV,
+    BENCH_FORMAT_JSON,
+} bench_format_t;
+
+static uint64_t bench_min_time_ns = 200000000ULL;
+static const char *bench_filter = NULL;
+static uint32_t bench_state = 1;
+static bench_format_t bench_format = BENCH_FORMAT_TEXT;
+static uint64_t bench_results = 0;
+
+uint64_t bench_now_ns(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+uint32_t bench_random(void) {
+    /* xorshift32 */
+    bench_state ^= bench_state << 13;
+    bench_state ^= bench_state >> 17;
+    bench_state ^= bench_state << 5;
+    return bench_state;
+}
+
+void bench_random_seed(uint32_t seed) {
+    bench_state = seed ? seed : 1;
+}
+
+/* Run fn long enough and return the elapsed time, iterations via pointer. */
+static uint64_t bench_measure(bench_fn_t fn, void *context, uint64_t *iterations_out) {
+    uint64_t iterations = 1;
+    uint64_t elapsed = 0;
+
+    /* Warm up caches and branch predictors. */
+    fn(context, 1);
+
+    /* Grow iteration count until the run is long enough. */
+    for (;;) {
+        uint64_t start = bench_now_ns();
+        fn(context, iterations);
+        elapsed = bench_now_ns() - start;
+
+        if (elapsed >= bench_min_time_ns) {
+            break;
+        }
+        if (elapsed < bench_min_time_ns / 100) {
+            iterations *= 10;
+        } else {
+            iterations = iterations * bench_min_time_ns / elapsed + 1;
+        }
+    }
+
+    *iterations_out = iterations;
+    return elapsed;
+}
+
+/* Names are quoted as is, they never contain quotes or backslashes. */
+static void bench_report(
+    const char *group, const char *name, uint64_t iterations, double ns_per_op, double ops_per_second,
+    double bytes_per_second
+) {
+    switch (bench_format) {
+        case BENCH_FORMAT_CSV:
+            printf(
+                "%s,\"%s\",%llu,%.2f,%.0f,%.0f\n", group, name, (unsigned long long)iterations, ns_per_op,
+                ops_per_second, bytes_per_second
+            );
+            break;
+        case BENCH_FORMAT_JSON:
+            printf(
+                "%s\n  {\"group\": \"%s\", \"name\": \"%s\", \"iterations\": %llu, \"ns_per_op\": %.2f, "
+                "\"ops_per_second\": %.0f, \"bytes_per_second\": %.0f}",
+                bench_results > 0 ? "," : "", group, name, (unsigned long long)iterations, ns_per_op,
+                ops_per_second, bytes_per_second
+            );
+            break;
+        default:
+            if (bytes_per_second > 0) {
+                printf("%-12s %-40s %12.2f ms/op %14.2f GB/s\n", group, name, ns_per_op / 1e6, bytes_per_second / 1e9);
+            } else {
+                printf("%-12s %-40s %12.2f ns/op %14.0f ops/s\n", group, name, ns_per_op, ops_per_second);
+            }
+            break;
+    }
+    bench_results++;
+    fflush(stdout);
+}
+
+void bench_run(const char *group, const char *name, bench_fn_t fn, void *context, uint64_t items) {
+    uint64_t iterations;
+    uint64_t elapsed;
+
+    if (bench_filter != NULL && strstr(group, bench_filter) == NULL) {
+        return;
+    }
+
+    elapsed = bench_measure(fn, context, &iterations);
+
+    double ops = (double)iterations * (double)items;
+    double ns_per_op = (double)elapsed / ops;
+    double ops_per_second = ops * 1e9 / (double)elapsed;
+
+    bench_report(group, name, iterations, ns_per_op, ops_per_second, 0);
+}
+
+void bench_run_bytes(const char *group, const char *name, bench_fn_t fn, void *context, uint64_t bytes) {
+    uint64_t iterations;
+    uint64_t elapsed;
+
+    if (bench_filter != NULL && strstr(group, bench_filter) == NULL) {
+        return;
+    }
+
+    elapsed = bench_measure(fn, context, &iterations);
+
+    double ns_per_op = (double)elapsed / (double)iterations;
+    double ops_per_second = (double)iterations * 1e9 / (double)elapsed;
+    double bytes_per_second = (double)iterations * (double)bytes * 1e9 / (double)elapsed;
+
+    bench_report(group, name, iterations, ns_per_op, ops_per_second, bytes_per_second);
+}
+
+int main(int argc, char **argv) {
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--time") == 0 && i + 1 < argc) {
+            bench_min_time_ns = strtoull(argv[++i], NULL, 10) * 1000000ULL;
+        } else if (strcmp(argv[i], "--format") == 0 && i + 1 < argc) {
+            const char *format = argv[++i];
+
+            if (strcmp(format, "csv") == 0) {
+                bench_format = BENCH_FORMAT_CSV;
+            } else if (strcmp(format, "json") == 0) {
+                bench_format = BENCH_FORMAT_JSON;
+            } else if (strcmp(format, "text") == 0) {
+                bench_format = BENCH_FORMAT_TEXT;
+            } else {
+                fprintf(stderr, "Unknown format: %s\n", format);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--help") == 0 || strcmp(argv[i], "-h") == 0) {
+            printf("Usage: %s [--time <ms>] [--format text|csv|json] [<group>]\n", argv[0]);
+            return 0;
+        } else {
+            bench_filter = argv[i];
+        }
+    }
+
+    if (bench_format == BENCH_FORMAT_CSV) {
+        printf("group,name,iterations,ns_per_op,ops_per_second,bytes_per_second\n");
+    } else if (bench_format == BENCH_FORMAT_JSON) {
+        printf("[");
+    }
+
+    bench_message();
+    bench_message_pack();
+    bench_auth();
+    bench_decode();
+    bench_location_batch();
+    bench_tracker();
+    bench_auth_reassembler();
+    bench_auth_queue();
+    bench_json();
+    bench_transport();
+    bench_pcap();
+    bench_pipeline();
+    bench_ring();
+    bench_scheduler();
+
+    if (bench_format == BENCH_FORMAT_JSON) {
+        printf("\n]\n");
+    }
+
+    return 0;
+}
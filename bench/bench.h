@@ -0,0 +1,46 @@
+#ifndef _BENCH_BENCH_H
+#define _BENCH_BENCH_H
+
+#include <stdint.h>
+
+/*
+ * Minimal benchmark harness. A benchmark function runs its workload
+ * the given number of iterations. The harness calibrates the iteration
+ * count so that each measurement runs for at least the minimum time.
+ */
+typedef void (*bench_fn_t)(void *context, uint64_t iterations);
+
+/* Write results here so the compiler cannot drop the workload. */
+extern volatile uint64_t bench_sink;
+
+uint64_t bench_now_ns(void);
+
+/*
+ * Measure fn and report the result. The items parameter tells how many
+ * operations one iteration performs, ie. batch size.
+ */
+void bench_run(const char *group, const char *name, bench_fn_t fn, void *context, uint64_t items);
+
+/* Same as bench_run() but reports throughput of one iteration processing bytes. */
+void bench_run_bytes(const char *group, const char *name, bench_fn_t fn, void *context, uint64_t bytes);
+
+/* Deterministic pseudo random numbers so runs are reproducible. */
+uint32_t bench_random(void);
+void bench_random_seed(uint32_t seed);
+
+void bench_message(void);
+void bench_message_pack(void);
+void bench_auth(void);
+void bench_decode(void);
+void bench_location_batch(void);
+void bench_tracker(void);
+void bench_auth_reassembler(void);
+void bench_auth_queue(void);
+void bench_json(void);
+void bench_transport(void);
+void bench_pcap(void);
+void bench_pipeline(void);
+void bench_ring(void);
+void bench_scheduler(void);
+
+#endif
@@ -0,0 +1,166 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "bench.h"
+#include "rid/auth.h"
+#include "rid/auth_signer.h"
+#include "rid/basic_id.h"
+#include "rid/location.h"
+#include "rid/message_pack.h"
+#include "rid/system.h"
+
+#define BENCH_AUTH_SIGNATURE_SIZE 64
+
+typedef struct {
+    rid_basic_id_t basic_id;
+    rid_location_t location;
+    rid_system_t system;
+    rid_message_pack_t pack;
+    rid_auth_t auth;
+    rid_auth_signer_t signer;
+} bench_auth_context_t;
+
+static bench_auth_context_t context;
+
+/*
+ * Dummy backends. They touch every input byte once so the numbers show
+ * the cost of building the signed payload, not of any real algorithm.
+ */
+static uint8_t checksum(const uint8_t *input, size_t input_length) {
+    uint8_t sum = 0;
+
+    for (size_t i = 0; i < input_length; ++i) {
+        sum = (uint8_t)(sum + input[i]);
+    }
+    return sum;
+}
+
+static int dummy_sign(
+    void *unused, const uint8_t *input, size_t input_length,
+    uint8_t *signature, size_t signature_size, size_t *signature_length
+) {
+    (void)unused;
+
+    if (signature_size < BENCH_AUTH_SIGNATURE_SIZE) {
+        return -1;
+    }
+    memset(signature, checksum(input, input_length), BENCH_AUTH_SIGNATURE_SIZE);
+    *signature_length = BENCH_AUTH_SIGNATURE_SIZE;
+    return 0;
+}
+
+static int dummy_verify(
+    void *unused, const uint8_t *input, size_t input_length,
+    const uint8_t *signature, size_t signature_length
+) {
+    (void)unused;
+
+    return signature_length == BENCH_AUTH_SIGNATURE_SIZE && signature[0] == checksum(input, input_length) ? 0 : 1;
+}
+
+static uint8_t hash_state;
+
+static int dummy_hash_init(void *state) {
+    *(uint8_t *)state = 0;
+    return 0;
+}
+
+static int dummy_hash_update(void *state, const uint8_t *data, size_t size) {
+    *(uint8_t *)state = (uint8_t)(*(uint8_t *)state + checksum(data, size));
+    return 0;
+}
+
+static int dummy_hash_final(void *state, uint8_t *digest, size_t digest_size, size_t *digest_length) {
+    if (digest_size < 1) {
+        return -1;
+    }
+    digest[0] = *(uint8_t *)state;
+    *digest_length = 1;
+    return 0;
+}
+
+static const rid_auth_hash_t dummy_hash = {
+    dummy_hash_init, dummy_hash_update, dummy_hash_final, &hash_state
+};
+
+static void fill_messages(void) {
+    rid_basic_id_init(&context.basic_id);
+    rid_basic_id_set_type(&context.basic_id, RID_ID_TYPE_SERIAL_NUMBER);
+    rid_basic_id_set_uas_id(&context.basic_id, "1ABCD2345EF678XYZ");
+
+    rid_location_init(&context.location);
+    rid_location_set_latitude(&context.location, 60.1699);
+    rid_location_set_longitude(&context.location, 24.9384);
+
+    rid_system_init(&context.system);
+    rid_system_set_operator_latitude(&context.system, 60.1698);
+    rid_system_set_operator_longitude(&context.system, 24.9383);
+
+    rid_message_pack_init(&context.pack);
+    rid_message_pack_add_message(&context.pack, &context.basic_id);
+    rid_message_pack_add_message(&context.pack, &context.location);
+    rid_message_pack_add_message(&context.pack, &context.system);
+
+    rid_auth_init(&context.auth);
+    rid_auth_set_timestamp(&context.auth, 100000);
+}
+
+static void bench_sign(void *unused, uint64_t iterations) {
+    (void)unused;
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        rid_auth_sign(&context.auth, &context.pack, dummy_sign, NULL);
+        bench_sink += context.auth.page_0.length;
+    }
+}
+
+static void bench_verify(void *unused, uint64_t iterations) {
+    (void)unused;
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        bench_sink += (uint64_t)rid_auth_verify(&context.auth, &context.pack, dummy_verify, NULL);
+    }
+}
+
+static void bench_sign_hashed(void *unused, uint64_t iterations) {
+    (void)unused;
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        rid_auth_sign_hashed(&context.auth, &context.pack, &dummy_hash, dummy_sign, NULL);
+        bench_sink += context.auth.page_0.length;
+    }
+}
+
+static void bench_verify_hashed(void *unused, uint64_t iterations) {
+    (void)unused;
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        bench_sink += (uint64_t)rid_auth_verify_hashed(&context.auth, &context.pack, &dummy_hash, dummy_verify, NULL);
+    }
+}
+
+/* Location changes between signatures, the rest of the pack does not. */
+static void bench_signer(void *unused, uint64_t iterations) {
+    (void)unused;
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        rid_location_set_timestamp(&context.location, (uint16_t)(n % 36000));
+        rid_auth_signer_set_message(&context.signer, &context.location);
+        rid_auth_signer_sign(&context.signer, &context.auth, dummy_sign, NULL);
+        bench_sink += context.auth.page_0.length;
+    }
+}
+
+void bench_auth(void) {
+    fill_messages();
+
+    bench_run("auth", "rid_auth_sign (3 messages)", bench_sign, NULL, 1);
+    bench_run("auth", "rid_auth_verify (3 messages)", bench_verify, NULL, 1);
+    bench_run("auth", "rid_auth_sign_hashed (3 messages)", bench_sign_hashed, NULL, 1);
+
+    rid_auth_sign_hashed(&context.auth, &context.pack, &dummy_hash, dummy_sign, NULL);
+    bench_run("auth", "rid_auth_verify_hashed (3 messages)", bench_verify_hashed, NULL, 1);
+
+    rid_auth_signer_init(&context.signer, &context.pack);
+    bench_run("auth", "rid_auth_signer_sign (3 messages)", bench_signer, NULL, 1);
+}
@@ -0,0 +1,160 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+#include "rid/auth.h"
+#include "rid/auth_queue.h"
+#include "rid/basic_id.h"
+#include "rid/location.h"
+#include "rid/message.h"
+#include "rid/message_pack.h"
+
+#define BENCH_AUTH_QUEUE_CAPACITY 256
+#define BENCH_AUTH_QUEUE_JOBS 1024
+#define BENCH_AUTH_QUEUE_BATCH 16
+
+/* Busy time of the slow verify callback. */
+#define BENCH_AUTH_QUEUE_VERIFY_NS 20000
+
+typedef struct {
+    rid_auth_queue_t queue;
+    void *storage;
+    size_t storage_size;
+    rid_message_pack_t pack;
+    rid_auth_t auth;
+} bench_auth_queue_context_t;
+
+static bench_auth_queue_context_t context;
+
+static int sign(
+    void *unused, const uint8_t *input, size_t input_length,
+    uint8_t *signature, size_t signature_size, size_t *signature_length
+) {
+    (void)unused;
+    (void)signature_size;
+    memset(signature, 0, 64);
+    for (size_t i = 0; i < input_length; ++i) {
+        signature[i % 64] ^= input[i];
+    }
+    *signature_length = 64;
+    return 0;
+}
+
+static int verify(
+    void *unused, const uint8_t *input, size_t input_length,
+    const uint8_t *signature, size_t signature_length
+) {
+    (void)unused;
+    (void)signature_length;
+    return input[input_length - 1] != signature[0];
+}
+
+static int verify_slow(
+    void *unused, const uint8_t *input, size_t input_length,
+    const uint8_t *signature, size_t signature_length
+) {
+    uint64_t end = bench_now_ns() + BENCH_AUTH_QUEUE_VERIFY_NS;
+
+    while (bench_now_ns() < end) {
+    }
+    return verify(unused, input, input_length, signature, signature_length);
+}
+
+static void setup(void) {
+    rid_basic_id_t basic_id;
+    rid_location_t location;
+
+    rid_basic_id_init(&basic_id);
+    rid_basic_id_set_uas_id(&basic_id, "1ABCD2345EF678XYZ");
+    rid_location_init(&location);
+    rid_location_set_latitude(&location, 60.1699);
+    rid_location_set_longitude(&location, 24.9384);
+
+    rid_message_pack_init(&context.pack);
+    rid_message_pack_add_message(&context.pack, &basic_id);
+    rid_message_pack_add_message(&context.pack, &location);
+
+    rid_auth_init(&context.auth);
+    rid_auth_set_timestamp(&context.auth, 1000);
+    rid_auth_sign(&context.auth, &context.pack, sign, NULL);
+
+    context.storage_size = rid_auth_queue_storage_size(BENCH_AUTH_QUEUE_CAPACITY);
+    context.storage = malloc(context.storage_size);
+}
+
+/* Queue overhead, submit and work in the same thread. */
+static void bench_overhead(void *unused, uint64_t iterations) {
+    (void)unused;
+
+    rid_auth_queue_init(&context.queue, context.storage, context.storage_size, BENCH_AUTH_QUEUE_CAPACITY);
+    rid_auth_queue_set_crypto(&context.queue, sign, verify, NULL);
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        for (size_t i = 0; i < BENCH_AUTH_QUEUE_JOBS; i += BENCH_AUTH_QUEUE_BATCH) {
+            for (size_t j = 0; j < BENCH_AUTH_QUEUE_BATCH; ++j) {
+                rid_auth_queue_submit_verify(&context.queue, &context.auth, &context.pack, NULL);
+            }
+            bench_sink += (uint64_t)rid_auth_queue_work(&context.queue, BENCH_AUTH_QUEUE_BATCH);
+        }
+    }
+}
+
+static void *work(void *argument) {
+    rid_auth_queue_t *queue = (rid_auth_queue_t *)argument;
+    int count;
+
+    while ((count = rid_auth_queue_work(queue, BENCH_AUTH_QUEUE_BATCH)) != RID_ERROR_NOT_FOUND) {
+        if (count == 0) {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+/* Slow verify callback, the submitting thread retries when the queue is full. */
+static void bench_workers(void *workers, uint64_t iterations) {
+    size_t worker_count = *(size_t *)workers;
+    pthread_t threads[8];
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        rid_auth_queue_init(&context.queue, context.storage, context.storage_size, BENCH_AUTH_QUEUE_CAPACITY);
+        rid_auth_queue_set_crypto(&context.queue, sign, verify_slow, NULL);
+
+        for (size_t i = 0; i < worker_count; ++i) {
+            pthread_create(&threads[i], NULL, work, &context.queue);
+        }
+
+        for (size_t i = 0; i < BENCH_AUTH_QUEUE_JOBS; ++i) {
+            while (rid_auth_queue_submit_verify(&context.queue, &context.auth, &context.pack, NULL) == RID_ERROR_BUFFER_TOO_SMALL) {
+                sched_yield();
+            }
+        }
+        rid_auth_queue_close(&context.queue);
+
+        for (size_t i = 0; i < worker_count; ++i) {
+            pthread_join(threads[i], NULL);
+        }
+    }
+}
+
+void bench_auth_queue(void) {
+    static size_t worker_counts[] = {1, 2, 4, 8};
+    char name[64];
+
+    setup();
+
+    bench_run("auth_queue", "submit and work (no crypto)", bench_overhead, NULL, BENCH_AUTH_QUEUE_JOBS);
+
+    for (size_t i = 0; i < sizeof(worker_counts) / sizeof(worker_counts[0]); ++i) {
+        snprintf(name, sizeof(name), "20 us verify (%zu workers)", worker_counts[i]);
+        bench_run("auth_queue", name, bench_workers, &worker_counts[i], BENCH_AUTH_QUEUE_JOBS);
+    }
+
+    free(context.storage);
+}
@@ -0,0 +1,83 @@
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "bench.h"
+#include "rid/auth.h"
+#include "rid/auth_reassembler.h"
+#include "rid/message.h"
+#include "rid/transport.h"
+
+#define BENCH_AUTH_AIRCRAFT 1000
+#define BENCH_AUTH_PAGES 4
+
+typedef struct {
+    rid_auth_reassembler_t reassembler;
+    void *storage;
+    size_t storage_size;
+    rid_auth_t auth;
+    rid_address_t addresses[BENCH_AUTH_AIRCRAFT];
+    uint64_t now;
+} bench_auth_reassembler_context_t;
+
+static bench_auth_reassembler_context_t context;
+
+static void setup(void) {
+    uint8_t signature[64];
+
+    bench_random_seed(5);
+
+    context.storage_size = rid_auth_reassembler_storage_size(BENCH_AUTH_AIRCRAFT);
+    context.storage = malloc(context.storage_size);
+    rid_auth_reassembler_init(&context.reassembler, context.storage, context.storage_size, BENCH_AUTH_AIRCRAFT);
+
+    for (size_t i = 0; i < sizeof(signature); ++i) {
+        signature[i] = (uint8_t)bench_random();
+    }
+
+    /* 64 byte signature takes pages 0 to 3. */
+    rid_auth_init(&context.auth);
+    rid_auth_set_type(&context.auth, RID_AUTH_TYPE_MESSAGE_SET_SIGNATURE);
+    rid_auth_set_signature(&context.auth, signature, sizeof(signature));
+
+    for (size_t i = 0; i < BENCH_AUTH_AIRCRAFT; ++i) {
+        uint32_t r = bench_random();
+        rid_address_t address = {{0x60, (uint8_t)(i >> 8), (uint8_t)i, (uint8_t)r, (uint8_t)(r >> 8), (uint8_t)(r >> 16)}};
+        context.addresses[i] = address;
+    }
+}
+
+static const void *page(uint8_t page_number) {
+    if (page_number == 0) {
+        return &context.auth.page_0;
+    }
+    return &context.auth.page_x[page_number - 1];
+}
+
+/* Pages of 1000 aircraft interleaved, every aircraft completes once. */
+static void bench_update(void *unused, uint64_t iterations) {
+    rid_auth_t auth;
+
+    (void)unused;
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        context.now++;
+        for (uint8_t p = 0; p < BENCH_AUTH_PAGES; ++p) {
+            for (size_t i = 0; i < BENCH_AUTH_AIRCRAFT; ++i) {
+                bench_sink += (uint64_t)rid_auth_reassembler_update(
+                    &context.reassembler, &context.addresses[i], page(p), context.now, &auth
+                );
+            }
+        }
+    }
+}
+
+void bench_auth_reassembler(void) {
+    setup();
+
+    bench_run(
+        "auth_reassembler", "rid_auth_reassembler_update (1k aircraft)", bench_update, NULL,
+        BENCH_AUTH_AIRCRAFT * BENCH_AUTH_PAGES
+    );
+
+    free(context.storage);
+}
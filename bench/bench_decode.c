@@ -0,0 +1,153 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "bench.h"
+#include "rid/basic_id.h"
+#include "rid/decode.h"
+#include "rid/location.h"
+#include "rid/message.h"
+#include "rid/operator_id.h"
+#include "rid/self_id.h"
+#include "rid/system.h"
+
+#define BENCH_DECODE_COUNT 4096
+
+typedef struct {
+    rid_message_t messages[BENCH_DECODE_COUNT];
+    rid_decoded_t decoded[BENCH_DECODE_COUNT];
+    int errors[BENCH_DECODE_COUNT];
+} bench_decode_context_t;
+
+static bench_decode_context_t context;
+
+/* Location heavy mix similar to what a receiver sees. */
+static void fill_messages(void) {
+    bench_random_seed(1);
+
+    for (size_t i = 0; i < BENCH_DECODE_COUNT; ++i) {
+        void *message = &context.messages[i];
+        uint32_t r = bench_random() % 10;
+
+        if (r < 6) {
+            rid_location_init(message);
+            rid_location_set_operational_status(message, RID_OPERATIONAL_STATUS_AIRBORNE);
+            rid_location_set_latitude(message, 60.0 + (double)(bench_random() % 100000) / 100000.0);
+            rid_location_set_longitude(message, 24.0 + (double)(bench_random() % 100000) / 100000.0);
+            rid_location_set_geodetic_altitude(message, (float)(bench_random() % 500));
+            rid_location_set_pressure_altitude(message, (float)(bench_random() % 500));
+            rid_location_set_height(message, (float)(bench_random() % 120));
+            rid_location_set_speed(message, (float)(bench_random() % 100));
+            rid_location_set_vertical_speed(message, 1.5f);
+            rid_location_set_track_direction(message, (uint16_t)(bench_random() % 360));
+            rid_location_set_timestamp(message, (uint16_t)(bench_random() % 36000));
+        } else if (r < 7) {
+            rid_basic_id_init(message);
+            rid_basic_id_set_type(message, RID_ID_TYPE_SERIAL_NUMBER);
+            rid_basic_id_set_uas_id(message, "1ABCD2345EF678XYZ");
+        } else if (r < 8) {
+            rid_system_init(message);
+            rid_system_set_operator_latitude(message, 60.1699);
+            rid_system_set_operator_longitude(message, 24.9384);
+            rid_system_set_timestamp(message, 123456);
+        } else if (r < 9) {
+            rid_self_id_init(message);
+            rid_self_id_set_description(message, "Survey flight");
+        } else {
+            rid_operator_id_init(message);
+            rid_operator_id_set(message, "FIN87astrdge12k8");
+        }
+    }
+}
+
+/* What a consumer has to write today: validate, switch, call getters. */
+static void bench_per_message(void *unused, uint64_t iterations) {
+    (void)unused;
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        for (size_t i = 0; i < BENCH_DECODE_COUNT; ++i) {
+            const void *message = &context.messages[i];
+            rid_decoded_t *decoded = &context.decoded[i];
+
+            context.errors[i] = rid_message_validate(message);
+            decoded->protocol_version = rid_message_get_protocol_version(message);
+            decoded->message_type = rid_message_get_type(message);
+
+            switch (decoded->message_type) {
+                case RID_MESSAGE_TYPE_BASIC_ID: {
+                    rid_decoded_basic_id_t *out = &decoded->message.basic_id;
+                    out->id_type = rid_basic_id_get_type(message);
+                    out->ua_type = rid_basic_id_get_ua_type(message);
+                    rid_basic_id_get_uas_id(message, out->uas_id, sizeof(out->uas_id));
+                    break;
+                }
+                case RID_MESSAGE_TYPE_LOCATION: {
+                    rid_decoded_location_t *out = &decoded->message.location;
+                    out->operational_status = rid_location_get_operational_status(message);
+                    out->height_type = rid_location_get_height_type(message);
+                    out->track_direction = rid_location_get_track_direction(message);
+                    out->speed = rid_location_get_speed(message);
+                    out->vertical_speed = rid_location_get_vertical_speed(message);
+                    out->latitude = rid_location_get_latitude(message);
+                    out->longitude = rid_location_get_longitude(message);
+                    out->pressure_altitude = rid_location_get_pressure_altitude(message);
+                    out->geodetic_altitude = rid_location_get_geodetic_altitude(message);
+                    out->height = rid_location_get_height(message);
+                    out->horizontal_accuracy = rid_location_get_horizontal_accuracy(message);
+                    out->vertical_accuracy = rid_location_get_vertical_accuracy(message);
+                    out->speed_accuracy = rid_location_get_speed_accuracy(message);
+                    out->baro_altitude_accuracy = rid_location_get_baro_altitude_accuracy(message);
+                    out->timestamp = rid_location_get_timestamp(message);
+                    out->timestamp_accuracy = rid_location_get_timestamp_accuracy(message);
+                    break;
+                }
+                case RID_MESSAGE_TYPE_SELF_ID: {
+                    rid_decoded_self_id_t *out = &decoded->message.self_id;
+                    out->description_type = rid_self_id_get_description_type(message);
+                    rid_self_id_get_description(message, out->description, sizeof(out->description));
+                    break;
+                }
+                case RID_MESSAGE_TYPE_SYSTEM: {
+                    rid_decoded_system_t *out = &decoded->message.system;
+                    out->operator_location_type = rid_system_get_operator_location_type(message);
+                    out->classification_type = rid_system_get_classification_type(message);
+                    out->ua_classification_category = rid_system_get_ua_classification_category(message);
+                    out->ua_classification_class = rid_system_get_ua_classification_class(message);
+                    out->operator_latitude = rid_system_get_operator_latitude(message);
+                    out->operator_longitude = rid_system_get_operator_longitude(message);
+                    out->operator_altitude = rid_system_get_operator_altitude(message);
+                    out->area_count = rid_system_get_area_count(message);
+                    out->area_radius = rid_system_get_area_radius(message);
+                    out->area_ceiling = rid_system_get_area_ceiling(message);
+                    out->area_floor = rid_system_get_area_floor(message);
+                    out->timestamp = rid_system_get_timestamp(message);
+                    break;
+                }
+                case RID_MESSAGE_TYPE_OPERATOR_ID: {
+                    rid_decoded_operator_id_t *out = &decoded->message.operator_id;
+                    out->id_type = rid_operator_id_get_type(message);
+                    rid_operator_id_get(message, out->operator_id, sizeof(out->operator_id));
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+        bench_sink += (uint64_t)context.errors[n % BENCH_DECODE_COUNT];
+    }
+}
+
+static void bench_batch(void *unused, uint64_t iterations) {
+    (void)unused;
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        rid_decode_batch(context.messages, 0, BENCH_DECODE_COUNT, context.decoded, context.errors);
+        bench_sink += (uint64_t)context.errors[n % BENCH_DECODE_COUNT];
+    }
+}
+
+void bench_decode(void) {
+    fill_messages();
+
+    bench_run("decode", "per_message_getters", bench_per_message, NULL, BENCH_DECODE_COUNT);
+    bench_run("decode", "rid_decode_batch", bench_batch, NULL, BENCH_DECODE_COUNT);
+}
@@ -0,0 +1,289 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "bench.h"
+#include "rid/auth.h"
+#include "rid/basic_id.h"
+#include "rid/json.h"
+#include "rid/location.h"
+#include "rid/message.h"
+#include "rid/message_pack.h"
+#include "rid/ndjson.h"
+#include "rid/operator_id.h"
+#include "rid/self_id.h"
+#include "rid/system.h"
+#include "rid/transport.h"
+
+#define BENCH_JSON_COUNT 256
+
+typedef struct {
+    rid_location_t locations[BENCH_JSON_COUNT];
+    rid_system_t systems[BENCH_JSON_COUNT];
+    rid_basic_id_t basic_id;
+    rid_self_id_t self_id;
+    rid_operator_id_t operator_id;
+    rid_auth_t auth;
+    rid_message_pack_t pack;
+    rid_message_t stream[BENCH_JSON_COUNT];
+    uint64_t timestamps[BENCH_JSON_COUNT];
+    rid_address_t sources[BENCH_JSON_COUNT];
+    char buffer[4096];
+    uint8_t cbor[4096];
+    char location_json[512];
+    size_t location_json_length;
+    char ndjson[BENCH_JSON_COUNT * 512];
+    size_t ndjson_length;
+} bench_json_context_t;
+
+static bench_json_context_t context;
+
+static void fill_messages(void) {
+    bench_random_seed(4);
+
+    for (size_t i = 0; i < BENCH_JSON_COUNT; ++i) {
+        rid_location_t *location = &context.locations[i];
+        rid_system_t *system = &context.systems[i];
+
+        rid_location_init(location);
+        rid_location_set_operational_status(location, RID_OPERATIONAL_STATUS_AIRBORNE);
+        rid_location_set_latitude(location, 60.0 + (double)(bench_random() % 100000) / 100000.0);
+        rid_location_set_longitude(location, 24.0 + (double)(bench_random() % 100000) / 100000.0);
+        rid_location_set_geodetic_altitude(location, (float)(bench_random() % 500));
+        rid_location_set_pressure_altitude(location, (float)(bench_random() % 500));
+        rid_location_set_height(location, (float)(bench_random() % 120));
+        rid_location_set_speed(location, (float)(bench_random() % 100));
+        rid_location_set_vertical_speed(location, (float)(bench_random() % 20) - 10.0f);
+        rid_location_set_track_direction(location, (uint16_t)(bench_random() % 360));
+        rid_location_set_timestamp(location, (uint16_t)(bench_random() % 36000));
+
+        rid_system_init(system);
+        rid_system_set_operator_latitude(system, 60.0 + (double)(bench_random() % 100000) / 100000.0);
+        rid_system_set_operator_longitude(system, 24.0 + (double)(bench_random() % 100000) / 100000.0);
+        rid_system_set_operator_altitude(system, (float)(bench_random() % 100));
+        rid_system_set_area_count(system, 1);
+        rid_system_set_area_ceiling(system, 120.0f);
+        rid_system_set_area_floor(system, 0.0f);
+        rid_system_set_timestamp(system, bench_random());
+    }
+
+    /* Location heavy stream, every eighth message is a System message. */
+    for (size_t i = 0; i < BENCH_JSON_COUNT; ++i) {
+        rid_address_t address = {{0x02, 0x00, 0x00, 0x00, 0x00, (uint8_t)(i % 16)}};
+        const void *message = (i % 8 == 7) ? (const void *)&context.systems[i] : (const void *)&context.locations[i];
+
+        memcpy(&context.stream[i], message, RID_MESSAGE_SIZE);
+        context.timestamps[i] = 1760000000000ULL + i * 50;
+        context.sources[i] = address;
+    }
+
+    uint8_t signature[64];
+
+    for (size_t i = 0; i < sizeof(signature); ++i) {
+        signature[i] = (uint8_t)bench_random();
+    }
+
+    rid_basic_id_init(&context.basic_id);
+    rid_basic_id_set_type(&context.basic_id, RID_ID_TYPE_SERIAL_NUMBER);
+    rid_basic_id_set_ua_type(&context.basic_id, RID_UA_TYPE_HELICOPTER_OR_MULTIROTOR);
+    rid_basic_id_set_uas_id(&context.basic_id, "1ABCD2345EF678XYZ");
+
+    rid_self_id_init(&context.self_id);
+    rid_self_id_set_description(&context.self_id, "Drone delivery test");
+
+    rid_operator_id_init(&context.operator_id);
+    rid_operator_id_set(&context.operator_id, "FIN87astrdge12k8");
+
+    rid_auth_init(&context.auth);
+    rid_auth_set_type(&context.auth, RID_AUTH_TYPE_MESSAGE_SET_SIGNATURE);
+    rid_auth_set_timestamp(&context.auth, 100000);
+    rid_auth_set_signature(&context.auth, signature, sizeof(signature));
+
+    rid_message_pack_init(&context.pack);
+    rid_message_pack_add_message(&context.pack, &context.locations[0]);
+    rid_message_pack_add_message(&context.pack, &context.systems[0]);
+    rid_message_pack_add_message(&context.pack, &context.locations[1]);
+
+    rid_location_to_json(&context.locations[0], context.location_json, sizeof(context.location_json), NULL);
+    context.location_json_length = strlen(context.location_json);
+    rid_messages_to_ndjson(
+        context.stream, 0, BENCH_JSON_COUNT, context.timestamps, context.sources,
+        context.ndjson, sizeof(context.ndjson), NULL
+    );
+    context.ndjson_length = strlen(context.ndjson);
+}
+
+static void bench_location(void *unused, uint64_t iterations) {
+    (void)unused;
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        size_t needed;
+        rid_location_to_json(&context.locations[n % BENCH_JSON_COUNT], context.buffer, sizeof(context.buffer), &needed);
+        bench_sink += needed;
+    }
+}
+
+static void bench_system(void *unused, uint64_t iterations) {
+    (void)unused;
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        size_t needed;
+        rid_system_to_json(&context.systems[n % BENCH_JSON_COUNT], context.buffer, sizeof(context.buffer), &needed);
+        bench_sink += needed;
+    }
+}
+
+static void bench_basic_id(void *unused, uint64_t iterations) {
+    (void)unused;
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        size_t needed;
+        rid_basic_id_to_json(&context.basic_id, context.buffer, sizeof(context.buffer), &needed);
+        bench_sink += needed;
+    }
+}
+
+static void bench_self_id(void *unused, uint64_t iterations) {
+    (void)unused;
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        size_t needed;
+        rid_self_id_to_json(&context.self_id, context.buffer, sizeof(context.buffer), &needed);
+        bench_sink += needed;
+    }
+}
+
+static void bench_operator_id(void *unused, uint64_t iterations) {
+    (void)unused;
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        size_t needed;
+        rid_operator_id_to_json(&context.operator_id, context.buffer, sizeof(context.buffer), &needed);
+        bench_sink += needed;
+    }
+}
+
+static void bench_auth_message(void *unused, uint64_t iterations) {
+    (void)unused;
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        size_t needed;
+        rid_auth_to_json(&context.auth, context.buffer, sizeof(context.buffer), &needed);
+        bench_sink += needed;
+    }
+}
+
+static void bench_pack(void *unused, uint64_t iterations) {
+    (void)unused;
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        size_t needed;
+        rid_message_pack_to_json(&context.pack, context.buffer, sizeof(context.buffer), &needed);
+        bench_sink += needed;
+    }
+}
+
+static void bench_location_cbor(void *unused, uint64_t iterations) {
+    (void)unused;
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        size_t needed;
+        rid_location_to_cbor(&context.locations[n % BENCH_JSON_COUNT], context.cbor, sizeof(context.cbor), &needed);
+        bench_sink += needed;
+    }
+}
+
+static void bench_system_cbor(void *unused, uint64_t iterations) {
+    (void)unused;
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        size_t needed;
+        rid_system_to_cbor(&context.systems[n % BENCH_JSON_COUNT], context.cbor, sizeof(context.cbor), &needed);
+        bench_sink += needed;
+    }
+}
+
+static void bench_message_pack_cbor(void *unused, uint64_t iterations) {
+    (void)unused;
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        size_t needed;
+        rid_message_pack_to_cbor(&context.pack, context.cbor, sizeof(context.cbor), &needed);
+        bench_sink += needed;
+    }
+}
+
+static int count_write(void *context, const char *data, size_t length) {
+    (void)data;
+    *(size_t *)context += length;
+    return 0;
+}
+
+static void bench_message_pack_sink(void *unused, uint64_t iterations) {
+    size_t written = 0;
+    rid_json_sink_t sink;
+    (void)unused;
+
+    rid_json_sink_init(&sink, count_write, &written);
+    for (uint64_t n = 0; n < iterations; ++n) {
+        rid_message_pack_to_json_sink(&context.pack, &sink);
+    }
+    bench_sink += written;
+}
+
+static void bench_ndjson(void *unused, uint64_t iterations) {
+    size_t written = 0;
+    rid_json_sink_t sink;
+    (void)unused;
+
+    rid_json_sink_init(&sink, count_write, &written);
+    for (uint64_t n = 0; n < iterations; ++n) {
+        rid_messages_to_ndjson_sink(
+            context.stream, 0, BENCH_JSON_COUNT, context.timestamps, context.sources, &sink
+        );
+    }
+    bench_sink += written;
+}
+
+static void bench_location_from_json(void *unused, uint64_t iterations) {
+    rid_location_t location;
+    (void)unused;
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        rid_message_from_json(context.location_json, context.location_json_length, &location, sizeof(location));
+        bench_sink += location.latitude;
+    }
+}
+
+static void bench_ndjson_reader(void *unused, uint64_t iterations) {
+    rid_ndjson_reader_t reader;
+    rid_message_t message;
+    rid_address_t source;
+    uint64_t received;
+    (void)unused;
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        rid_ndjson_reader_init(&reader, context.ndjson, context.ndjson_length);
+        while (rid_ndjson_reader_next(&reader, &message, sizeof(message), &received, &source) == RID_SUCCESS) {
+            bench_sink += received;
+        }
+    }
+}
+
+void bench_json(void) {
+    fill_messages();
+
+    bench_run("json", "rid_location_to_json", bench_location, NULL, 1);
+    bench_run("json", "rid_system_to_json", bench_system, NULL, 1);
+    bench_run("json", "rid_basic_id_to_json", bench_basic_id, NULL, 1);
+    bench_run("json", "rid_self_id_to_json", bench_self_id, NULL, 1);
+    bench_run("json", "rid_operator_id_to_json", bench_operator_id, NULL, 1);
+    bench_run("json", "rid_auth_to_json (64 byte signature)", bench_auth_message, NULL, 1);
+    bench_run("json", "rid_message_pack_to_json (3 messages)", bench_pack, NULL, 1);
+    bench_run("json", "rid_message_pack_to_json_sink (3 messages)", bench_message_pack_sink, NULL, 1);
+    bench_run("json", "rid_messages_to_ndjson_sink (per message)", bench_ndjson, NULL, BENCH_JSON_COUNT);
+    bench_run("json", "rid_location_to_cbor", bench_location_cbor, NULL, 1);
+    bench_run("json", "rid_system_to_cbor", bench_system_cbor, NULL, 1);
+    bench_run("json", "rid_message_pack_to_cbor (3 messages)", bench_message_pack_cbor, NULL, 1);
+    bench_run("json", "rid_message_from_json (location)", bench_location_from_json, NULL, 1);
+    bench_run("json", "rid_ndjson_reader_next (per message)", bench_ndjson_reader, NULL, BENCH_JSON_COUNT);
+}
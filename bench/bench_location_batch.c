@@ -0,0 +1,84 @@
+#include <stdint.h>
+#include <stdio.h>
+
+#include "bench.h"
+#include "rid/location.h"
+#include "rid/location_batch.h"
+#include "rid/message.h"
+
+#define BENCH_LOCATION_BATCH_COUNT 4096
+
+typedef struct {
+    rid_location_t messages[BENCH_LOCATION_BATCH_COUNT];
+    uint8_t storage[BENCH_LOCATION_BATCH_COUNT * 40 + 512];
+    rid_location_batch_t batch;
+} bench_location_batch_context_t;
+
+static bench_location_batch_context_t context;
+
+static void fill_messages(void) {
+    bench_random_seed(2);
+
+    for (size_t i = 0; i < BENCH_LOCATION_BATCH_COUNT; ++i) {
+        rid_location_t *message = &context.messages[i];
+
+        rid_location_init(message);
+        rid_location_set_operational_status(message, RID_OPERATIONAL_STATUS_AIRBORNE);
+        rid_location_set_latitude(message, 60.0 + (double)(bench_random() % 100000) / 100000.0);
+        rid_location_set_longitude(message, 24.0 + (double)(bench_random() % 100000) / 100000.0);
+        rid_location_set_geodetic_altitude(message, (float)(bench_random() % 500));
+        rid_location_set_pressure_altitude(message, (float)(bench_random() % 500));
+        rid_location_set_height(message, (float)(bench_random() % 120));
+        rid_location_set_speed(message, (float)(bench_random() % 100));
+        rid_location_set_vertical_speed(message, (float)(bench_random() % 20) - 10.0f);
+        rid_location_set_track_direction(message, (uint16_t)(bench_random() % 360));
+        rid_location_set_timestamp(message, (uint16_t)(bench_random() % 36000));
+    }
+
+    rid_location_batch_init(
+        &context.batch, context.storage, sizeof(context.storage), BENCH_LOCATION_BATCH_COUNT
+    );
+}
+
+/* Filling the same columns one message at a time with the getters. */
+static void bench_getters(void *unused, uint64_t iterations) {
+    rid_location_batch_t *batch = &context.batch;
+    (void)unused;
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        for (size_t i = 0; i < BENCH_LOCATION_BATCH_COUNT; ++i) {
+            const rid_location_t *message = &context.messages[i];
+
+            batch->latitude[i] = rid_location_get_latitude(message);
+            batch->longitude[i] = rid_location_get_longitude(message);
+            batch->geodetic_altitude[i] = rid_location_get_geodetic_altitude(message);
+            batch->pressure_altitude[i] = rid_location_get_pressure_altitude(message);
+            batch->height[i] = rid_location_get_height(message);
+            batch->speed[i] = rid_location_get_speed(message);
+            batch->vertical_speed[i] = rid_location_get_vertical_speed(message);
+            batch->track_direction[i] = rid_location_get_track_direction(message);
+            batch->timestamp[i] = rid_location_get_timestamp(message);
+        }
+        bench_sink += batch->track_direction[n % BENCH_LOCATION_BATCH_COUNT];
+    }
+}
+
+static void bench_batch(void *unused, uint64_t iterations) {
+    rid_location_batch_t *batch = &context.batch;
+    (void)unused;
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        rid_location_batch_decode(batch, context.messages, 0, BENCH_LOCATION_BATCH_COUNT);
+        bench_sink += batch->track_direction[n % BENCH_LOCATION_BATCH_COUNT];
+    }
+}
+
+void bench_location_batch(void) {
+    char name[64];
+
+    fill_messages();
+    snprintf(name, sizeof(name), "rid_location_batch_decode (%s)", rid_location_batch_kernel());
+
+    bench_run("location", "per_message_getters", bench_getters, NULL, BENCH_LOCATION_BATCH_COUNT);
+    bench_run("location", name, bench_batch, NULL, BENCH_LOCATION_BATCH_COUNT);
+}
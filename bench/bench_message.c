@@ -0,0 +1,292 @@
+#include <stddef.h>
+#include <stdint.h>
+
+#include "bench.h"
+#include "rid/auth.h"
+#include "rid/auth_page.h"
+#include "rid/basic_id.h"
+#include "rid/location.h"
+#include "rid/message.h"
+#include "rid/operator_id.h"
+#include "rid/self_id.h"
+#include "rid/system.h"
+
+typedef struct {
+    rid_basic_id_t basic_id;
+    rid_location_t location;
+    rid_self_id_t self_id;
+    rid_system_t system;
+    rid_operator_id_t operator_id;
+    rid_auth_t auth;
+    rid_auth_page_0_t page_0;
+    rid_auth_page_x_t page_x;
+    char text[64];
+    uint8_t signature[RID_AUTH_PAGE_MAX_SIGNATURE_SIZE];
+} bench_message_context_t;
+
+static bench_message_context_t context;
+
+/*
+ * One iteration sets a field and reads it back. The value changes with
+ * every iteration so the setter can not be skipped.
+ */
+#define BENCH_PAIR(fn, set, get)                              \
+    static void fn(void *unused, uint64_t iterations) {       \
+        (void)unused;                                         \
+        for (uint64_t n = 0; n < iterations; ++n) {           \
+            set;                                              \
+            bench_sink += (uint64_t)(get);                    \
+        }                                                     \
+    }
+
+#define BENCH_ONE(fn, call)                                   \
+    static void fn(void *unused, uint64_t iterations) {       \
+        (void)unused;                                         \
+        for (uint64_t n = 0; n < iterations; ++n) {           \
+            bench_sink += (uint64_t)(call);                   \
+        }                                                     \
+    }
+
+#define SMALL(n) ((unsigned)((n) & 3))
+#define DEGREES(n) (60.0 + (double)((n) & 1023) * 0.0001)
+#define METERS(n) ((float)((n) & 1023))
+
+BENCH_PAIR(bench_basic_id_type,
+    rid_basic_id_set_type(&context.basic_id, (rid_basic_id_type_t)SMALL(n)),
+    rid_basic_id_get_type(&context.basic_id))
+BENCH_PAIR(bench_basic_id_ua_type,
+    rid_basic_id_set_ua_type(&context.basic_id, (rid_ua_type_t)SMALL(n)),
+    rid_basic_id_get_ua_type(&context.basic_id))
+BENCH_PAIR(bench_basic_id_uas_id,
+    rid_basic_id_set_uas_id(&context.basic_id, (n & 1) ? "1ABCD2345EF678XYZ" : "1ABCD2345EF678XYA"),
+    rid_basic_id_get_uas_id(&context.basic_id, context.text, sizeof(context.text)) + context.text[16])
+
+BENCH_PAIR(bench_location_height_type,
+    rid_location_set_height_type(&context.location, (rid_height_type_t)(n & 1)),
+    rid_location_get_height_type(&context.location))
+BENCH_PAIR(bench_location_operational_status,
+    rid_location_set_operational_status(&context.location, (rid_operational_status_t)SMALL(n)),
+    rid_location_get_operational_status(&context.location))
+BENCH_PAIR(bench_location_track_direction,
+    rid_location_set_track_direction(&context.location, (uint16_t)(n % 360)),
+    rid_location_get_track_direction(&context.location))
+BENCH_PAIR(bench_location_speed,
+    rid_location_set_speed(&context.location, METERS(n) / 8),
+    rid_location_get_speed(&context.location))
+BENCH_PAIR(bench_location_vertical_speed,
+    rid_location_set_vertical_speed(&context.location, METERS(n) / 64),
+    rid_location_get_vertical_speed(&context.location))
+BENCH_PAIR(bench_location_latitude,
+    rid_location_set_latitude(&context.location, DEGREES(n)),
+    rid_location_get_latitude(&context.location))
+BENCH_PAIR(bench_location_longitude,
+    rid_location_set_longitude(&context.location, DEGREES(n)),
+    rid_location_get_longitude(&context.location))
+BENCH_PAIR(bench_location_pressure_altitude,
+    rid_location_set_pressure_altitude(&context.location, METERS(n)),
+    rid_location_get_pressure_altitude(&context.location))
+BENCH_PAIR(bench_location_geodetic_altitude,
+    rid_location_set_geodetic_altitude(&context.location, METERS(n)),
+    rid_location_get_geodetic_altitude(&context.location))
+BENCH_PAIR(bench_location_height,
+    rid_location_set_height(&context.location, METERS(n)),
+    rid_location_get_height(&context.location))
+BENCH_PAIR(bench_location_horizontal_accuracy,
+    rid_location_set_horizontal_accuracy(&context.location, (rid_horizontal_accuracy_t)SMALL(n)),
+    rid_location_get_horizontal_accuracy(&context.location))
+BENCH_PAIR(bench_location_vertical_accuracy,
+    rid_location_set_vertical_accuracy(&context.location, (rid_vertical_accuracy_t)SMALL(n)),
+    rid_location_get_vertical_accuracy(&context.location))
+BENCH_PAIR(bench_location_speed_accuracy,
+    rid_location_set_speed_accuracy(&context.location, (rid_speed_accuracy_t)SMALL(n)),
+    rid_location_get_speed_accuracy(&context.location))
+BENCH_PAIR(bench_location_baro_altitude_accuracy,
+    rid_location_set_baro_altitude_accuracy(&context.location, (rid_vertical_accuracy_t)SMALL(n)),
+    rid_location_get_baro_altitude_accuracy(&context.location))
+BENCH_PAIR(bench_location_timestamp,
+    rid_location_set_timestamp(&context.location, (uint16_t)(n % 36000)),
+    rid_location_get_timestamp(&context.location))
+/* There is no unixtime getter, the result is read back as a timestamp. */
+BENCH_PAIR(bench_location_unixtime,
+    rid_location_set_unixtime(&context.location, (uint32_t)(1700000000 + n)),
+    rid_location_get_timestamp(&context.location))
+BENCH_PAIR(bench_location_timestamp_accuracy,
+    rid_location_set_timestamp_accuracy(&context.location, (rid_timestamp_accuracy_t)SMALL(n)),
+    rid_location_get_timestamp_accuracy(&context.location))
+
+BENCH_PAIR(bench_self_id_description_type,
+    rid_self_id_set_description_type(&context.self_id, (rid_description_type_t)SMALL(n)),
+    rid_self_id_get_description_type(&context.self_id))
+BENCH_PAIR(bench_self_id_description,
+    rid_self_id_set_description(&context.self_id, (n & 1) ? "Drone delivery test" : "Drone delivery tesT"),
+    rid_self_id_get_description(&context.self_id, context.text, sizeof(context.text)) + context.text[18])
+
+BENCH_PAIR(bench_system_operator_location_type,
+    rid_system_set_operator_location_type(&context.system, (rid_operator_location_type_t)SMALL(n)),
+    rid_system_get_operator_location_type(&context.system))
+BENCH_PAIR(bench_system_classification_type,
+    rid_system_set_classification_type(&context.system, (rid_classification_type_t)(n & 1)),
+    rid_system_get_classification_type(&context.system))
+BENCH_PAIR(bench_system_ua_classification_category,
+    rid_system_set_ua_classification_category(&context.system, (rid_ua_classification_category_t)SMALL(n)),
+    rid_system_get_ua_classification_category(&context.system))
+BENCH_PAIR(bench_system_ua_classification_class,
+    rid_system_set_ua_classification_class(&context.system, (rid_ua_classification_class_t)SMALL(n)),
+    rid_system_get_ua_classification_class(&context.system))
+BENCH_PAIR(bench_system_operator_latitude,
+    rid_system_set_operator_latitude(&context.system, DEGREES(n)),
+    rid_system_get_operator_latitude(&context.system))
+BENCH_PAIR(bench_system_operator_longitude,
+    rid_system_set_operator_longitude(&context.system, DEGREES(n)),
+    rid_system_get_operator_longitude(&context.system))
+BENCH_PAIR(bench_system_operator_altitude,
+    rid_system_set_operator_altitude(&context.system, METERS(n)),
+    rid_system_get_operator_altitude(&context.system))
+BENCH_PAIR(bench_system_area_count,
+    rid_system_set_area_count(&context.system, (uint16_t)(n & 1023)),
+    rid_system_get_area_count(&context.system))
+BENCH_PAIR(bench_system_area_radius,
+    rid_system_set_area_radius(&context.system, (uint16_t)(n & 1023)),
+    rid_system_get_area_radius(&context.system))
+BENCH_PAIR(bench_system_area_ceiling,
+    rid_system_set_area_ceiling(&context.system, METERS(n)),
+    rid_system_get_area_ceiling(&context.system))
+BENCH_PAIR(bench_system_area_floor,
+    rid_system_set_area_floor(&context.system, METERS(n)),
+    rid_system_get_area_floor(&context.system))
+BENCH_PAIR(bench_system_timestamp,
+    rid_system_set_timestamp(&context.system, (uint32_t)n),
+    rid_system_get_timestamp(&context.system))
+BENCH_PAIR(bench_system_unixtime,
+    rid_system_set_unixtime(&context.system, (uint32_t)(1700000000 + n)),
+    rid_system_get_unixtime(&context.system))
+
+BENCH_PAIR(bench_operator_id_type,
+    rid_operator_id_set_type(&context.operator_id, (rid_operator_id_type_t)(n & 1)),
+    rid_operator_id_get_type(&context.operator_id))
+BENCH_PAIR(bench_operator_id,
+    rid_operator_id_set(&context.operator_id, (n & 1) ? "FIN87astrdge12k8" : "FIN87astrdge12k9"),
+    rid_operator_id_get(&context.operator_id, context.text, sizeof(context.text)) + context.text[15])
+
+BENCH_PAIR(bench_auth_type,
+    rid_auth_set_type(&context.auth, (rid_auth_type_t)(1 + SMALL(n))),
+    rid_auth_get_type(&context.auth))
+BENCH_PAIR(bench_auth_timestamp,
+    rid_auth_set_timestamp(&context.auth, (uint32_t)n),
+    rid_auth_get_timestamp(&context.auth))
+BENCH_PAIR(bench_auth_unixtime,
+    rid_auth_set_unixtime(&context.auth, (uint32_t)(1700000000 + n)),
+    rid_auth_get_unixtime(&context.auth))
+BENCH_PAIR(bench_auth_signature,
+    (context.signature[0] = (uint8_t)n, rid_auth_set_signature(&context.auth, context.signature, 64)),
+    rid_auth_get_signature(&context.auth, context.signature, sizeof(context.signature)) + context.signature[0])
+
+BENCH_PAIR(bench_auth_page_0_type,
+    rid_auth_page_0_set_type(&context.page_0, (rid_auth_type_t)(1 + SMALL(n))),
+    rid_auth_page_0_get_type(&context.page_0))
+BENCH_PAIR(bench_auth_page_0_last_page_index,
+    rid_auth_page_0_set_last_page_index(&context.page_0, (uint8_t)(n % 16)),
+    rid_auth_page_0_get_last_page_index(&context.page_0))
+BENCH_PAIR(bench_auth_page_0_length,
+    rid_auth_page_0_set_length(&context.page_0, (uint8_t)n),
+    rid_auth_page_0_get_length(&context.page_0))
+BENCH_PAIR(bench_auth_page_0_timestamp,
+    rid_auth_page_0_set_timestamp(&context.page_0, (uint32_t)n),
+    rid_auth_page_0_get_timestamp(&context.page_0))
+BENCH_PAIR(bench_auth_page_0_data,
+    (context.signature[0] = (uint8_t)n, rid_auth_page_0_set_data(&context.page_0, context.signature, 17)),
+    rid_auth_page_0_get_data(&context.page_0, context.signature, sizeof(context.signature)) + context.signature[0])
+BENCH_PAIR(bench_auth_page_x_type,
+    rid_auth_page_x_set_type(&context.page_x, (rid_auth_type_t)(1 + SMALL(n))),
+    rid_auth_page_x_get_type(&context.page_x))
+BENCH_PAIR(bench_auth_page_x_number,
+    rid_auth_page_x_set_number(&context.page_x, (uint8_t)(1 + n % 15)),
+    rid_auth_page_x_get_number(&context.page_x))
+BENCH_PAIR(bench_auth_page_x_data,
+    (context.signature[0] = (uint8_t)n, rid_auth_page_x_set_data(&context.page_x, context.signature, 23)),
+    rid_auth_page_x_get_data(&context.page_x, context.signature, sizeof(context.signature)) + context.signature[0])
+
+BENCH_ONE(bench_validate_basic_id, rid_message_validate(&context.basic_id))
+BENCH_ONE(bench_validate_location, rid_message_validate(&context.location))
+BENCH_ONE(bench_validate_self_id, rid_message_validate(&context.self_id))
+BENCH_ONE(bench_validate_system, rid_message_validate(&context.system))
+BENCH_ONE(bench_validate_operator_id, rid_message_validate(&context.operator_id))
+BENCH_ONE(bench_validate_auth, rid_message_validate(&context.auth.page_0))
+
+typedef struct {
+    const char *name;
+    bench_fn_t fn;
+} bench_message_case_t;
+
+static const bench_message_case_t bench_message_cases[] = {
+    {"rid_basic_id_set/get_type", bench_basic_id_type},
+    {"rid_basic_id_set/get_ua_type", bench_basic_id_ua_type},
+    {"rid_basic_id_set/get_uas_id", bench_basic_id_uas_id},
+    {"rid_location_set/get_height_type", bench_location_height_type},
+    {"rid_location_set/get_operational_status", bench_location_operational_status},
+    {"rid_location_set/get_track_direction", bench_location_track_direction},
+    {"rid_location_set/get_speed", bench_location_speed},
+    {"rid_location_set/get_vertical_speed", bench_location_vertical_speed},
+    {"rid_location_set/get_latitude", bench_location_latitude},
+    {"rid_location_set/get_longitude", bench_location_longitude},
+    {"rid_location_set/get_pressure_altitude", bench_location_pressure_altitude},
+    {"rid_location_set/get_geodetic_altitude", bench_location_geodetic_altitude},
+    {"rid_location_set/get_height", bench_location_height},
+    {"rid_location_set/get_horizontal_accuracy", bench_location_horizontal_accuracy},
+    {"rid_location_set/get_vertical_accuracy", bench_location_vertical_accuracy},
+    {"rid_location_set/get_speed_accuracy", bench_location_speed_accuracy},
+    {"rid_location_set/get_baro_altitude_accuracy", bench_location_baro_altitude_accuracy},
+    {"rid_location_set/get_timestamp", bench_location_timestamp},
+    {"rid_location_set_unixtime/get_timestamp", bench_location_unixtime},
+    {"rid_location_set/get_timestamp_accuracy", bench_location_timestamp_accuracy},
+    {"rid_self_id_set/get_description_type", bench_self_id_description_type},
+    {"rid_self_id_set/get_description", bench_self_id_description},
+    {"rid_system_set/get_operator_location_type", bench_system_operator_location_type},
+    {"rid_system_set/get_classification_type", bench_system_classification_type},
+    {"rid_system_set/get_ua_classification_category", bench_system_ua_classification_category},
+    {"rid_system_set/get_ua_classification_class", bench_system_ua_classification_class},
+    {"rid_system_set/get_operator_latitude", bench_system_operator_latitude},
+    {"rid_system_set/get_operator_longitude", bench_system_operator_longitude},
+    {"rid_system_set/get_operator_altitude", bench_system_operator_altitude},
+    {"rid_system_set/get_area_count", bench_system_area_count},
+    {"rid_system_set/get_area_radius", bench_system_area_radius},
+    {"rid_system_set/get_area_ceiling", bench_system_area_ceiling},
+    {"rid_system_set/get_area_floor", bench_system_area_floor},
+    {"rid_system_set/get_timestamp", bench_system_timestamp},
+    {"rid_system_set/get_unixtime", bench_system_unixtime},
+    {"rid_operator_id_set/get_type", bench_operator_id_type},
+    {"rid_operator_id_set/get", bench_operator_id},
+    {"rid_auth_set/get_type", bench_auth_type},
+    {"rid_auth_set/get_timestamp", bench_auth_timestamp},
+    {"rid_auth_set/get_unixtime", bench_auth_unixtime},
+    {"rid_auth_set/get_signature (64 bytes)", bench_auth_signature},
+    {"rid_auth_page_0_set/get_type", bench_auth_page_0_type},
+    {"rid_auth_page_0_set/get_last_page_index", bench_auth_page_0_last_page_index},
+    {"rid_auth_page_0_set/get_length", bench_auth_page_0_length},
+    {"rid_auth_page_0_set/get_timestamp", bench_auth_page_0_timestamp},
+    {"rid_auth_page_0_set/get_data (17 bytes)", bench_auth_page_0_data},
+    {"rid_auth_page_x_set/get_type", bench_auth_page_x_type},
+    {"rid_auth_page_x_set/get_number", bench_auth_page_x_number},
+    {"rid_auth_page_x_set/get_data (23 bytes)", bench_auth_page_x_data},
+    {"rid_message_validate (basic_id)", bench_validate_basic_id},
+    {"rid_message_validate (location)", bench_validate_location},
+    {"rid_message_validate (self_id)", bench_validate_self_id},
+    {"rid_message_validate (system)", bench_validate_system},
+    {"rid_message_validate (operator_id)", bench_validate_operator_id},
+    {"rid_message_validate (auth)", bench_validate_auth},
+};
+
+void bench_message(void) {
+    rid_basic_id_init(&context.basic_id);
+    rid_location_init(&context.location);
+    rid_self_id_init(&context.self_id);
+    rid_system_init(&context.system);
+    rid_operator_id_init(&context.operator_id);
+    rid_auth_init(&context.auth);
+    rid_auth_page_0_init(&context.page_0);
+    rid_auth_page_x_init(&context.page_x, 1);
+
+    for (size_t i = 0; i < sizeof(bench_message_cases) / sizeof(bench_message_cases[0]); ++i) {
+        bench_run("message", bench_message_cases[i].name, bench_message_cases[i].fn, NULL, 1);
+    }
+}
@@ -0,0 +1,217 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "bench.h"
+#include "rid/auth.h"
+#include "rid/basic_id.h"
+#include "rid/location.h"
+#include "rid/message.h"
+#include "rid/message_pack.h"
+#include "rid/operator_id.h"
+#include "rid/self_id.h"
+#include "rid/system.h"
+
+typedef struct {
+    rid_basic_id_t basic_id;
+    rid_location_t location;
+    rid_self_id_t self_id;
+    rid_system_t system;
+    rid_operator_id_t operator_id;
+    rid_auth_t auth;
+    rid_auth_t received;
+    /* Full pack with the auth pages in the middle. */
+    rid_message_pack_t pack;
+    /* Same messages in reverse order. */
+    rid_message_pack_t unsorted;
+    rid_message_pack_t scratch;
+    rid_message_pack_index_t index;
+} bench_message_pack_context_t;
+
+static bench_message_pack_context_t context;
+
+static void fill_messages(void) {
+    uint8_t signature[64];
+
+    bench_random_seed(5);
+    for (size_t i = 0; i < sizeof(signature); ++i) {
+        signature[i] = (uint8_t)bench_random();
+    }
+
+    rid_basic_id_init(&context.basic_id);
+    rid_basic_id_set_type(&context.basic_id, RID_ID_TYPE_SERIAL_NUMBER);
+    rid_basic_id_set_uas_id(&context.basic_id, "1ABCD2345EF678XYZ");
+
+    rid_location_init(&context.location);
+    rid_location_set_latitude(&context.location, 60.1699);
+    rid_location_set_longitude(&context.location, 24.9384);
+
+    rid_self_id_init(&context.self_id);
+    rid_self_id_set_description(&context.self_id, "Drone delivery test");
+
+    rid_system_init(&context.system);
+    rid_system_set_operator_latitude(&context.system, 60.1698);
+    rid_system_set_operator_longitude(&context.system, 24.9383);
+
+    rid_operator_id_init(&context.operator_id);
+    rid_operator_id_set(&context.operator_id, "FIN87astrdge12k8");
+
+    rid_auth_init(&context.auth);
+    rid_auth_set_type(&context.auth, RID_AUTH_TYPE_MESSAGE_SET_SIGNATURE);
+    rid_auth_set_timestamp(&context.auth, 100000);
+    rid_auth_set_signature(&context.auth, signature, sizeof(signature));
+
+    rid_message_pack_init(&context.pack);
+    rid_message_pack_add_message(&context.pack, &context.basic_id);
+    rid_message_pack_add_message(&context.pack, &context.location);
+    rid_message_pack_set_auth(&context.pack, &context.auth);
+    rid_message_pack_add_message(&context.pack, &context.self_id);
+    rid_message_pack_add_message(&context.pack, &context.system);
+    rid_message_pack_add_message(&context.pack, &context.operator_id);
+
+    rid_message_pack_init(&context.unsorted);
+    for (uint8_t i = rid_message_pack_message_count(&context.pack); i > 0; --i) {
+        memcpy(
+            &context.unsorted.messages[context.unsorted.message_count * RID_MESSAGE_SIZE],
+            rid_message_pack_get_message_at(&context.pack, i - 1), RID_MESSAGE_SIZE
+        );
+        context.unsorted.message_count++;
+    }
+}
+
+static void bench_add_message(void *unused, uint64_t iterations) {
+    (void)unused;
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        rid_message_pack_init(&context.scratch);
+        rid_message_pack_add_message(&context.scratch, &context.basic_id);
+        rid_message_pack_add_message(&context.scratch, &context.location);
+        rid_message_pack_add_message(&context.scratch, &context.self_id);
+        rid_message_pack_add_message(&context.scratch, &context.system);
+        rid_message_pack_add_message(&context.scratch, &context.operator_id);
+        bench_sink += context.scratch.message_count;
+    }
+}
+
+static void bench_set_message_at(void *unused, uint64_t iterations) {
+    (void)unused;
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        rid_location_set_timestamp(&context.location, (uint16_t)(n % 36000));
+        rid_message_pack_set_message_at(&context.scratch, 1, &context.location);
+        bench_sink += *(const uint8_t *)rid_message_pack_get_message_at(&context.scratch, 1);
+    }
+}
+
+static void bench_copy_message_at(void *unused, uint64_t iterations) {
+    rid_location_t location;
+    (void)unused;
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        rid_message_pack_copy_message_at(&context.pack, (uint8_t)(n % 9), &location);
+        bench_sink += location.latitude;
+    }
+}
+
+static void bench_sort(void *unused, uint64_t iterations) {
+    (void)unused;
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        memcpy(&context.scratch, &context.unsorted, sizeof(context.scratch));
+        rid_message_pack_sort(&context.scratch);
+        bench_sink += context.scratch.messages[0];
+    }
+}
+
+static void bench_find(void *unused, uint64_t iterations) {
+    (void)unused;
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        uint8_t index = 0;
+        rid_message_pack_find_message_index_by_type(&context.pack, RID_MESSAGE_TYPE_OPERATOR_ID, 0, &index);
+        bench_sink += index;
+    }
+}
+
+static void bench_index_build(void *unused, uint64_t iterations) {
+    (void)unused;
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        rid_message_pack_index_build(&context.index, &context.pack);
+        bench_sink += context.index.present;
+    }
+}
+
+static void bench_index_first(void *unused, uint64_t iterations) {
+    (void)unused;
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        bench_sink += rid_message_pack_index_first(&context.index, RID_MESSAGE_TYPE_OPERATOR_ID);
+    }
+}
+
+static void bench_set_auth(void *unused, uint64_t iterations) {
+    (void)unused;
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        rid_message_pack_set_auth(&context.scratch, &context.auth);
+        bench_sink += context.scratch.message_count;
+    }
+}
+
+static void bench_get_auth(void *unused, uint64_t iterations) {
+    (void)unused;
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        rid_message_pack_get_auth(&context.pack, &context.received);
+        bench_sink += context.received.page_0.length;
+    }
+}
+
+static void bench_get_auth_indexed(void *unused, uint64_t iterations) {
+    (void)unused;
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        rid_message_pack_get_auth_indexed(&context.pack, &context.index, &context.received);
+        bench_sink += context.received.page_0.length;
+    }
+}
+
+static void bench_view_init(void *unused, uint64_t iterations) {
+    rid_message_pack_view_t view;
+    size_t size = rid_message_pack_size(&context.pack);
+    (void)unused;
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        rid_message_pack_view_init(&view, (const uint8_t *)&context.pack, size);
+        bench_sink += view.size;
+    }
+}
+
+static void bench_validate(void *unused, uint64_t iterations) {
+    (void)unused;
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        bench_sink += (uint64_t)rid_message_pack_validate(&context.pack);
+    }
+}
+
+void bench_message_pack(void) {
+    fill_messages();
+    rid_message_pack_index_build(&context.index, &context.pack);
+
+    bench_run("message_pack", "rid_message_pack_add_message (5 messages)", bench_add_message, NULL, 1);
+    memcpy(&context.scratch, &context.pack, sizeof(context.scratch));
+    bench_run("message_pack", "rid_message_pack_set/get_message_at", bench_set_message_at, NULL, 1);
+    bench_run("message_pack", "rid_message_pack_copy_message_at", bench_copy_message_at, NULL, 1);
+    bench_run("message_pack", "rid_message_pack_sort (9 messages)", bench_sort, NULL, 1);
+    bench_run("message_pack", "rid_message_pack_find_message_index_by_type", bench_find, NULL, 1);
+    bench_run("message_pack", "rid_message_pack_index_build (9 messages)", bench_index_build, NULL, 1);
+    bench_run("message_pack", "rid_message_pack_index_first", bench_index_first, NULL, 1);
+
+    memcpy(&context.scratch, &context.pack, sizeof(context.scratch));
+    bench_run("message_pack", "rid_message_pack_set_auth (4 pages)", bench_set_auth, NULL, 1);
+    bench_run("message_pack", "rid_message_pack_get_auth (4 pages)", bench_get_auth, NULL, 1);
+    bench_run("message_pack", "rid_message_pack_get_auth_indexed (4 pages)", bench_get_auth_indexed, NULL, 1);
+    bench_run("message_pack", "rid_message_pack_view_init", bench_view_init, NULL, 1);
+    bench_run("message_pack", "rid_message_pack_validate (9 messages)", bench_validate, NULL, 1);
+}
@@ -0,0 +1,269 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+#include "rid/beacon.h"
+#include "rid/bluetooth.h"
+#include "rid/location.h"
+#include "rid/message.h"
+#include "rid/message_pack.h"
+#include "rid/nan.h"
+#include "rid/pcap.h"
+#include "rid/transport.h"
+
+#define BENCH_PCAP_SIZE (32 * 1024 * 1024)
+#define BENCH_PCAP_CHUNKS 8
+
+typedef struct {
+    uint8_t *wifi;
+    size_t wifi_size;
+    uint8_t *bluetooth;
+    size_t bluetooth_size;
+    rid_location_t location;
+    rid_message_pack_t pack;
+} bench_pcap_context_t;
+
+static bench_pcap_context_t context;
+
+static void put32(uint8_t *data, size_t *size, uint32_t value) {
+    data[(*size)++] = (uint8_t)value;
+    data[(*size)++] = (uint8_t)(value >> 8);
+    data[(*size)++] = (uint8_t)(value >> 16);
+    data[(*size)++] = (uint8_t)(value >> 24);
+}
+
+/* Radiotap header with flags, rate, channel and signal fields. */
+static size_t wifi_radiotap(uint8_t *frame) {
+    const uint8_t header[] = {
+        0x00, 0x00, 0x12, 0x00, 0x2E, 0x00, 0x00, 0x00,
+        0x10, 0x02, 0x6C, 0x09, 0xA0, 0x00, 0xC4, 0x00, 0x00, 0x00,
+    };
+
+    memcpy(frame, header, sizeof(header));
+    return sizeof(header);
+}
+
+/* Beacon with a dozen or so elements, Remote ID in every sixteenth one. */
+static size_t wifi_beacon(uint8_t *frame, size_t n) {
+    size_t size = 24 + RID_BEACON_FIXED_SIZE;
+    size_t elements = 10 + bench_random() % 10;
+
+    memset(frame, 0, size);
+    frame[0] = 0x80;
+    for (size_t i = 0; i < 6; ++i) {
+        frame[10 + i] = frame[16 + i] = (uint8_t)bench_random();
+    }
+
+    for (size_t i = 0; i < elements; ++i) {
+        uint8_t length = (uint8_t)(bench_random() % 32);
+
+        frame[size] = i == elements - 1 ? RID_BEACON_ELEMENT_ID_VENDOR_SPECIFIC : (uint8_t)(bench_random() % 200);
+        frame[size + 1] = length;
+        for (size_t j = 0; j < length; ++j) {
+            frame[size + 2 + j] = (uint8_t)bench_random();
+        }
+        size += 2 + length;
+    }
+
+    if (n % 16 == 0) {
+        size_t written = 0;
+        rid_beacon_build(&context.pack, (uint8_t)n, &frame[size], RID_BEACON_MAX_SIZE, &written);
+        size += written;
+    }
+
+    return size;
+}
+
+/* Data frame which the reader skips after the frame control field. */
+static size_t wifi_data(uint8_t *frame) {
+    size_t size = 64 + bench_random() % 1400;
+
+    frame[0] = 0x88;
+    for (size_t i = 1; i < size; ++i) {
+        frame[i] = (uint8_t)bench_random();
+    }
+
+    return size;
+}
+
+/* Monitor mode capture in pcapng, mostly data frames and beacons. */
+static void setup_wifi(void) {
+    uint8_t *data = context.wifi;
+    size_t size = 0;
+    uint8_t frame[2048];
+
+    put32(data, &size, 0x0A0D0D0A);
+    put32(data, &size, 28);
+    put32(data, &size, 0x1A2B3C4D);
+    put32(data, &size, 0x00000001);
+    put32(data, &size, 0xFFFFFFFF);
+    put32(data, &size, 0xFFFFFFFF);
+    put32(data, &size, 28);
+
+    put32(data, &size, 1);
+    put32(data, &size, 20);
+    put32(data, &size, RID_PCAP_LINKTYPE_IEEE802_11_RADIOTAP);
+    put32(data, &size, 0);
+    put32(data, &size, 20);
+
+    for (size_t n = 0;; ++n) {
+        uint64_t timestamp = 1760000000000000ULL + n * 100;
+        size_t length = wifi_radiotap(frame);
+        uint32_t padded;
+        uint32_t r = bench_random() % 10;
+
+        if (r < 5) {
+            length += wifi_beacon(&frame[length], n);
+        } else if (r < 6) {
+            rid_address_t source = {{0x02, 0x00, 0x00, 0x00, 0x00, (uint8_t)n}};
+            size_t written = 0;
+            rid_nan_build(&context.pack, (uint8_t)n, &source, &frame[length], RID_NAN_MAX_SIZE, &written);
+            length += written;
+        } else {
+            length += wifi_data(&frame[length]);
+        }
+
+        padded = (uint32_t)((length + 3) & ~(size_t)3);
+        if (size + 32 + padded > BENCH_PCAP_SIZE) {
+            break;
+        }
+
+        put32(data, &size, 6);
+        put32(data, &size, 32 + padded);
+        put32(data, &size, 0);
+        put32(data, &size, (uint32_t)(timestamp >> 32));
+        put32(data, &size, (uint32_t)timestamp);
+        put32(data, &size, (uint32_t)length);
+        put32(data, &size, (uint32_t)length);
+        memcpy(&data[size], frame, length);
+        memset(&data[size + length], 0, padded - length);
+        size += padded;
+        put32(data, &size, 32 + padded);
+    }
+
+    context.wifi_size = size;
+}
+
+/* Bluetooth LE sniffer capture in pcap, Remote ID in every eighth advertisement. */
+static void setup_bluetooth(void) {
+    uint8_t *data = context.bluetooth;
+    size_t size = 0;
+    uint8_t packet[64];
+
+    put32(data, &size, 0xA1B2C3D4);
+    put32(data, &size, 0x00040002);
+    put32(data, &size, 0);
+    put32(data, &size, 0);
+    put32(data, &size, 65535);
+    put32(data, &size, RID_PCAP_LINKTYPE_BLUETOOTH_LE_LL_WITH_PHDR);
+
+    for (uint32_t n = 0;; ++n) {
+        size_t length = 10 + 4 + 2 + RID_ADDRESS_SIZE;
+        size_t advertising;
+
+        memset(packet, 0, 10);
+        packet[10] = 0xD6;
+        packet[11] = 0xBE;
+        packet[12] = 0x89;
+        packet[13] = 0x8E;
+        packet[14] = 0x02;
+        for (size_t i = 0; i < RID_ADDRESS_SIZE; ++i) {
+            packet[16 + i] = (uint8_t)bench_random();
+        }
+
+        if (n % 8 == 0) {
+            rid_bluetooth_build(&context.location, (uint8_t)n, &packet[length], RID_BLUETOOTH_LEGACY_SIZE, &advertising);
+        } else {
+            /* Flags followed by manufacturer specific data. */
+            advertising = 3 + 2 + bench_random() % 24;
+            packet[length] = 0x02;
+            packet[length + 1] = 0x01;
+            packet[length + 2] = 0x06;
+            packet[length + 3] = (uint8_t)(advertising - 4);
+            packet[length + 4] = 0xFF;
+            for (size_t i = 5; i < advertising; ++i) {
+                packet[length + i] = (uint8_t)bench_random();
+            }
+        }
+        packet[15] = (uint8_t)(RID_ADDRESS_SIZE + advertising);
+        length += advertising + 3;
+
+        if (size + 16 + length > BENCH_PCAP_SIZE) {
+            break;
+        }
+
+        put32(data, &size, 1760000000 + n / 10000);
+        put32(data, &size, n % 10000 * 100);
+        put32(data, &size, (uint32_t)length);
+        put32(data, &size, (uint32_t)length);
+        memcpy(&data[size], packet, length);
+        size += length;
+    }
+
+    context.bluetooth_size = size;
+}
+
+static void setup(void) {
+    bench_random_seed(6);
+
+    rid_location_init(&context.location);
+    rid_location_set_latitude(&context.location, 60.1699);
+    rid_location_set_longitude(&context.location, 24.9384);
+
+    rid_message_pack_init(&context.pack);
+    for (size_t i = 0; i < 4; ++i) {
+        rid_message_pack_add_message(&context.pack, &context.location);
+    }
+
+    context.wifi = malloc(BENCH_PCAP_SIZE);
+    context.bluetooth = malloc(BENCH_PCAP_SIZE);
+    setup_wifi();
+    setup_bluetooth();
+}
+
+static void bench_read(const uint8_t *data, size_t size, uint64_t iterations) {
+    rid_pcap_reader_t reader;
+    rid_pcap_record_t record;
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        rid_pcap_reader_init(&reader, data, size);
+        while (rid_pcap_reader_next(&reader, &record) == RID_SUCCESS) {
+            bench_sink += record.counter;
+        }
+    }
+}
+
+static void bench_wifi(void *unused, uint64_t iterations) {
+    (void)unused;
+    bench_read(context.wifi, context.wifi_size, iterations);
+}
+
+static void bench_bluetooth(void *unused, uint64_t iterations) {
+    (void)unused;
+    bench_read(context.bluetooth, context.bluetooth_size, iterations);
+}
+
+static void bench_split(void *unused, uint64_t iterations) {
+    rid_pcap_reader_t reader;
+    rid_pcap_reader_t chunks[BENCH_PCAP_CHUNKS];
+    size_t count = 0;
+    (void)unused;
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        rid_pcap_reader_init(&reader, context.bluetooth, context.bluetooth_size);
+        rid_pcap_reader_split(&reader, chunks, BENCH_PCAP_CHUNKS, &count);
+        bench_sink += count;
+    }
+}
+
+void bench_pcap(void) {
+    setup();
+
+    bench_run_bytes("pcap", "rid_pcap_reader_next (Wi-Fi pcapng)", bench_wifi, NULL, context.wifi_size);
+    bench_run_bytes("pcap", "rid_pcap_reader_next (Bluetooth pcap)", bench_bluetooth, NULL, context.bluetooth_size);
+    bench_run("pcap", "rid_pcap_reader_split (8 chunks)", bench_split, NULL, 1);
+
+    free(context.wifi);
+    free(context.bluetooth);
+}
@@ -0,0 +1,186 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+#include "rid/location.h"
+#include "rid/message.h"
+#include "rid/pcap.h"
+#include "rid/pipeline.h"
+#include "rid/tracker.h"
+#include "rid/transport.h"
+
+#define BENCH_PIPELINE_AIRCRAFT 10000
+#define BENCH_PIPELINE_RECORDS 65536
+#define BENCH_PIPELINE_CAPACITY 1024
+#define BENCH_PIPELINE_BATCH 64
+#define BENCH_PIPELINE_LOCATIONS 256
+
+typedef struct {
+    rid_pipeline_t pipeline;
+    size_t index;
+    pthread_t thread;
+} bench_pipeline_worker_t;
+
+typedef struct {
+    rid_location_t locations[BENCH_PIPELINE_LOCATIONS];
+    rid_pcap_record_t records[BENCH_PIPELINE_RECORDS];
+    void *storage;
+    rid_tracker_t tracker;
+    void *tracker_storage;
+} bench_pipeline_context_t;
+
+static bench_pipeline_context_t context;
+
+static void setup(void) {
+    size_t size = rid_tracker_storage_size(BENCH_PIPELINE_AIRCRAFT);
+
+    bench_random_seed(5);
+
+    for (size_t i = 0; i < BENCH_PIPELINE_LOCATIONS; ++i) {
+        rid_location_init(&context.locations[i]);
+        rid_location_set_latitude(&context.locations[i], 60.0 + (double)(bench_random() % 10000) / 10000.0);
+        rid_location_set_longitude(&context.locations[i], 24.0 + (double)(bench_random() % 10000) / 10000.0);
+        rid_location_set_geodetic_altitude(&context.locations[i], (float)(bench_random() % 500));
+        rid_location_set_speed(&context.locations[i], (float)(bench_random() % 40));
+    }
+
+    for (size_t i = 0; i < BENCH_PIPELINE_RECORDS; ++i) {
+        rid_pcap_record_t *record = &context.records[i];
+        uint32_t aircraft = bench_random() % BENCH_PIPELINE_AIRCRAFT;
+
+        memset(record, 0, sizeof(*record));
+        record->source.octets[0] = 0x60;
+        record->source.octets[3] = (uint8_t)(aircraft >> 16);
+        record->source.octets[4] = (uint8_t)(aircraft >> 8);
+        record->source.octets[5] = (uint8_t)aircraft;
+        record->message = (const uint8_t *)&context.locations[bench_random() % BENCH_PIPELINE_LOCATIONS];
+        record->message_size = RID_MESSAGE_SIZE;
+        record->timestamp = i;
+        record->transport = RID_TRANSPORT_BLUETOOTH_LEGACY;
+    }
+
+    context.storage = malloc(rid_pipeline_storage_size(16, BENCH_PIPELINE_CAPACITY, BENCH_PIPELINE_AIRCRAFT));
+    context.tracker_storage = malloc(size);
+    rid_tracker_init(&context.tracker, context.tracker_storage, size, BENCH_PIPELINE_AIRCRAFT);
+}
+
+/* Decoding and JSON export, the work done in parallel. */
+static int export_json(void *unused, rid_tracker_t *tracker, rid_pipeline_item_t *item) {
+    char json[1024];
+    (void)unused;
+    (void)tracker;
+
+    if (item->status != RID_SUCCESS) {
+        return item->status;
+    }
+    rid_message_to_json(item->record.message, json, sizeof(json), NULL);
+    return (int)strlen(json);
+}
+
+static void *work(void *argument) {
+    bench_pipeline_worker_t *worker = (bench_pipeline_worker_t *)argument;
+    int count;
+
+    while ((count = rid_pipeline_work(&worker->pipeline, worker->index, BENCH_PIPELINE_BATCH)) != RID_ERROR_NOT_FOUND) {
+        if (count == 0) {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+/* Same work without the pipeline. */
+static void bench_single(void *unused, uint64_t iterations) {
+    (void)unused;
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        for (size_t i = 0; i < BENCH_PIPELINE_RECORDS; ++i) {
+            rid_pipeline_item_t item;
+
+            item.record = context.records[i];
+            item.status = rid_tracker_update(&context.tracker, &item.record.source, item.record.message, item.record.timestamp);
+            bench_sink += (uint64_t)export_json(NULL, &context.tracker, &item);
+        }
+    }
+}
+
+/*
+ * Reader and output stages run in the calling thread, interleaved, so
+ * N workers use N + 1 threads.
+ */
+static void bench_run_pipeline(size_t worker_count, rid_pipeline_mode_t mode, uint64_t iterations) {
+    static bench_pipeline_worker_t workers[16];
+    rid_pipeline_item_t items[BENCH_PIPELINE_BATCH];
+    size_t size = rid_pipeline_storage_size(worker_count, BENCH_PIPELINE_CAPACITY, BENCH_PIPELINE_AIRCRAFT);
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        rid_pipeline_t pipeline;
+        size_t pushed = 0;
+        int count = 0;
+
+        rid_pipeline_init(&pipeline, context.storage, size, worker_count, BENCH_PIPELINE_CAPACITY, BENCH_PIPELINE_AIRCRAFT, mode);
+        rid_pipeline_set_callback(&pipeline, export_json, NULL);
+
+        for (size_t i = 0; i < worker_count; ++i) {
+            workers[i].pipeline = pipeline;
+            workers[i].index = i;
+            pthread_create(&workers[i].thread, NULL, work, &workers[i]);
+        }
+
+        while (count != RID_ERROR_NOT_FOUND) {
+            while (pushed < BENCH_PIPELINE_RECORDS && rid_pipeline_push(&pipeline, &context.records[pushed]) == RID_SUCCESS) {
+                if (++pushed == BENCH_PIPELINE_RECORDS) {
+                    rid_pipeline_close(&pipeline);
+                }
+            }
+
+            count = rid_pipeline_collect(&pipeline, items, BENCH_PIPELINE_BATCH);
+            for (int i = 0; i < count; ++i) {
+                bench_sink += (uint64_t)items[i].status;
+            }
+            if (count == 0) {
+                sched_yield();
+            }
+        }
+
+        for (size_t i = 0; i < worker_count; ++i) {
+            pthread_join(workers[i].thread, NULL);
+        }
+    }
+}
+
+static void bench_unordered(void *workers, uint64_t iterations) {
+    bench_run_pipeline(*(size_t *)workers, RID_PIPELINE_UNORDERED, iterations);
+}
+
+static void bench_ordered(void *workers, uint64_t iterations) {
+    bench_run_pipeline(*(size_t *)workers, RID_PIPELINE_ORDERED, iterations);
+}
+
+void bench_pipeline(void) {
+    static size_t worker_counts[] = {1, 2, 4, 8, 16};
+    char name[64];
+
+    setup();
+
+    bench_run("pipeline", "tracker and JSON (no pipeline)", bench_single, NULL, BENCH_PIPELINE_RECORDS);
+
+    for (size_t i = 0; i < sizeof(worker_counts) / sizeof(worker_counts[0]); ++i) {
+        snprintf(name, sizeof(name), "unordered (%zu workers)", worker_counts[i]);
+        bench_run("pipeline", name, bench_unordered, &worker_counts[i], BENCH_PIPELINE_RECORDS);
+    }
+
+    for (size_t i = 0; i < sizeof(worker_counts) / sizeof(worker_counts[0]); ++i) {
+        snprintf(name, sizeof(name), "ordered (%zu workers)", worker_counts[i]);
+        bench_run("pipeline", name, bench_ordered, &worker_counts[i], BENCH_PIPELINE_RECORDS);
+    }
+
+    free(context.storage);
+    free(context.tracker_storage);
+}
@@ -0,0 +1,131 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "bench.h"
+#include "rid/location.h"
+#include "rid/message.h"
+#include "rid/message_pack.h"
+#include "rid/ring.h"
+
+#define BENCH_RING_CAPACITY 1024
+#define BENCH_RING_BATCH 32
+#define BENCH_RING_MESSAGES 262144
+#define BENCH_RING_PRODUCERS 2
+
+typedef struct {
+    rid_ring_t ring;
+    void *storage;
+    rid_message_t messages[BENCH_RING_BATCH];
+    rid_message_pack_t packs[BENCH_RING_BATCH];
+    size_t per_producer;
+} bench_ring_context_t;
+
+static bench_ring_context_t context;
+
+static void setup(void) {
+    rid_location_t location;
+
+    rid_location_init(&location);
+    rid_location_set_latitude(&location, 60.1699);
+    rid_location_set_longitude(&location, 24.9384);
+
+    for (size_t i = 0; i < BENCH_RING_BATCH; ++i) {
+        context.messages[i] = *(rid_message_t *)&location;
+        rid_message_pack_init(&context.packs[i]);
+        for (size_t j = 0; j < 4; ++j) {
+            rid_message_pack_add_message(&context.packs[i], &location);
+        }
+    }
+
+    context.storage = malloc(rid_ring_storage_size(RID_RING_MESSAGE_PACK, BENCH_RING_CAPACITY));
+}
+
+/* Push and pop a batch in the same thread, the cost of the copies and counters. */
+static void bench_batch(void *type, uint64_t iterations) {
+    static rid_message_pack_t out[BENCH_RING_BATCH];
+    rid_ring_type_t ring_type = *(rid_ring_type_t *)type;
+    const void *in = ring_type == RID_RING_MESSAGE ? (const void *)context.messages : (const void *)context.packs;
+    size_t size = rid_ring_storage_size(ring_type, BENCH_RING_CAPACITY);
+
+    rid_ring_init(&context.ring, context.storage, size, ring_type, BENCH_RING_CAPACITY, RID_RING_SINGLE_PRODUCER);
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        bench_sink += (uint64_t)rid_ring_push(&context.ring, in, BENCH_RING_BATCH);
+        bench_sink += (uint64_t)rid_ring_pop(&context.ring, out, BENCH_RING_BATCH);
+    }
+}
+
+static void *produce(void *unused) {
+    size_t pushed = 0;
+    (void)unused;
+
+    while (pushed < context.per_producer) {
+        size_t count = context.per_producer - pushed < BENCH_RING_BATCH ? context.per_producer - pushed : BENCH_RING_BATCH;
+        int n = rid_ring_push(&context.ring, context.messages, count);
+
+        if (n > 0) {
+            pushed += (size_t)n;
+        } else {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+/* Producer threads push, the calling thread pops until everything has arrived. */
+static void bench_threads(void *producers, uint64_t iterations) {
+    static rid_message_t out[BENCH_RING_BATCH];
+    pthread_t threads[BENCH_RING_PRODUCERS];
+    size_t producer_count = *(size_t *)producers;
+    size_t size = rid_ring_storage_size(RID_RING_MESSAGE, BENCH_RING_CAPACITY);
+
+    context.per_producer = BENCH_RING_MESSAGES / producer_count;
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        size_t popped = 0;
+
+        rid_ring_init(
+            &context.ring, context.storage, size, RID_RING_MESSAGE, BENCH_RING_CAPACITY,
+            producer_count > 1 ? RID_RING_MULTI_PRODUCER : RID_RING_SINGLE_PRODUCER
+        );
+
+        for (size_t i = 0; i < producer_count; ++i) {
+            pthread_create(&threads[i], NULL, produce, NULL);
+        }
+
+        while (popped < context.per_producer * producer_count) {
+            int count = rid_ring_pop(&context.ring, out, BENCH_RING_BATCH);
+
+            if (count > 0) {
+                popped += (size_t)count;
+                bench_sink += out[0].body[0];
+            } else {
+                sched_yield();
+            }
+        }
+
+        for (size_t i = 0; i < producer_count; ++i) {
+            pthread_join(threads[i], NULL);
+        }
+    }
+}
+
+void bench_ring(void) {
+    static rid_ring_type_t message = RID_RING_MESSAGE;
+    static rid_ring_type_t pack = RID_RING_MESSAGE_PACK;
+    static size_t single = 1;
+    static size_t multi = BENCH_RING_PRODUCERS;
+
+    setup();
+
+    bench_run("ring", "push and pop (message, batch of 32)", bench_batch, &message, BENCH_RING_BATCH);
+    bench_run("ring", "push and pop (pack of 4, batch of 32)", bench_batch, &pack, BENCH_RING_BATCH);
+    bench_run("ring", "single producer thread", bench_threads, &single, BENCH_RING_MESSAGES);
+    bench_run("ring", "two producer threads", bench_threads, &multi, BENCH_RING_MESSAGES);
+
+    free(context.storage);
+}
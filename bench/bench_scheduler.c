@@ -0,0 +1,96 @@
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "bench.h"
+#include "rid/basic_id.h"
+#include "rid/location.h"
+#include "rid/message.h"
+#include "rid/operator_id.h"
+#include "rid/scheduler.h"
+#include "rid/system.h"
+#include "rid/transport.h"
+
+#define BENCH_SCHEDULER_AIRCRAFT 10000
+#define BENCH_SCHEDULER_FRAMES 4096
+
+typedef struct {
+    rid_scheduler_t scheduler;
+    void *storage;
+    rid_location_t location;
+    rid_scheduler_frame_t frame;
+    uint64_t now;
+} bench_scheduler_context_t;
+
+static bench_scheduler_context_t context;
+
+static void setup(rid_transport_t transport) {
+    rid_basic_id_t basic_id;
+    rid_system_t system;
+    rid_operator_id_t operator_id;
+    size_t size = rid_scheduler_storage_size(transport, BENCH_SCHEDULER_AIRCRAFT);
+
+    bench_random_seed(5);
+
+    context.storage = malloc(size);
+    rid_scheduler_init(&context.scheduler, context.storage, size, transport, BENCH_SCHEDULER_AIRCRAFT);
+
+    rid_basic_id_init(&basic_id);
+    rid_basic_id_set_uas_id(&basic_id, "1ABCD2345EF678XYZ");
+    rid_location_init(&context.location);
+    rid_location_set_latitude(&context.location, 60.1699);
+    rid_system_init(&system);
+    rid_operator_id_init(&operator_id);
+
+    /* Start times spread over one second. */
+    for (uint32_t i = 0; i < BENCH_SCHEDULER_AIRCRAFT; ++i) {
+        uint64_t start = bench_random() % 1000;
+
+        rid_scheduler_set_message(&context.scheduler, i, &basic_id, start);
+        rid_scheduler_set_message(&context.scheduler, i, &context.location, start);
+        rid_scheduler_set_message(&context.scheduler, i, &system, start);
+        rid_scheduler_set_message(&context.scheduler, i, &operator_id, start);
+    }
+    context.now = 0;
+}
+
+static void teardown(void) {
+    free(context.storage);
+}
+
+/* Steady state, the clock always runs ahead so a frame is always due. */
+static void bench_next(void *unused, uint64_t iterations) {
+    (void)unused;
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        for (size_t i = 0; i < BENCH_SCHEDULER_FRAMES; ++i) {
+            if (rid_scheduler_next(&context.scheduler, context.now, &context.frame) != RID_SUCCESS) {
+                context.now = rid_scheduler_next_due(&context.scheduler);
+                rid_scheduler_next(&context.scheduler, context.now, &context.frame);
+            }
+            bench_sink += context.frame.size;
+        }
+    }
+}
+
+static void bench_update(void *unused, uint64_t iterations) {
+    (void)unused;
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        for (size_t i = 0; i < BENCH_SCHEDULER_FRAMES; ++i) {
+            uint32_t aircraft = bench_random() % BENCH_SCHEDULER_AIRCRAFT;
+            rid_scheduler_set_message(&context.scheduler, aircraft, &context.location, context.now);
+        }
+    }
+    bench_sink += rid_scheduler_count(&context.scheduler);
+}
+
+void bench_scheduler(void) {
+    setup(RID_TRANSPORT_BLUETOOTH_LEGACY);
+    bench_run("scheduler", "rid_scheduler_next (legacy, 10k aircraft)", bench_next, NULL, BENCH_SCHEDULER_FRAMES);
+    bench_run("scheduler", "rid_scheduler_set_message (10k aircraft)", bench_update, NULL, BENCH_SCHEDULER_FRAMES);
+    teardown();
+
+    setup(RID_TRANSPORT_WIFI_NAN);
+    bench_run("scheduler", "rid_scheduler_next (NAN, 10k aircraft)", bench_next, NULL, BENCH_SCHEDULER_FRAMES);
+    teardown();
+}
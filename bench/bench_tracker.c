@@ -0,0 +1,96 @@
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "bench.h"
+#include "rid/location.h"
+#include "rid/message.h"
+#include "rid/tracker.h"
+#include "rid/transport.h"
+
+#define BENCH_TRACKER_AIRCRAFT 10000
+#define BENCH_TRACKER_UPDATES 4096
+
+typedef struct {
+    rid_tracker_t tracker;
+    void *storage;
+    size_t storage_size;
+    rid_location_t location;
+    rid_address_t addresses[BENCH_TRACKER_AIRCRAFT];
+    uint32_t order[BENCH_TRACKER_UPDATES];
+    uint64_t now;
+} bench_tracker_context_t;
+
+static bench_tracker_context_t context;
+
+static void setup(void) {
+    bench_random_seed(3);
+
+    context.storage_size = rid_tracker_storage_size(BENCH_TRACKER_AIRCRAFT);
+    context.storage = malloc(context.storage_size);
+    rid_tracker_init(&context.tracker, context.storage, context.storage_size, BENCH_TRACKER_AIRCRAFT);
+
+    rid_location_init(&context.location);
+    rid_location_set_latitude(&context.location, 60.1699);
+    rid_location_set_longitude(&context.location, 24.9384);
+
+    for (size_t i = 0; i < BENCH_TRACKER_AIRCRAFT; ++i) {
+        uint32_t r = bench_random();
+        rid_address_t address = {{0x60, (uint8_t)(i >> 8), (uint8_t)i, (uint8_t)r, (uint8_t)(r >> 8), (uint8_t)(r >> 16)}};
+        context.addresses[i] = address;
+        rid_tracker_update(&context.tracker, &address, &context.location, 0);
+    }
+
+    for (size_t i = 0; i < BENCH_TRACKER_UPDATES; ++i) {
+        context.order[i] = bench_random() % BENCH_TRACKER_AIRCRAFT;
+    }
+}
+
+/* Steady state with a full table of 10k aircraft. */
+static void bench_update(void *unused, uint64_t iterations) {
+    (void)unused;
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        context.now++;
+        for (size_t i = 0; i < BENCH_TRACKER_UPDATES; ++i) {
+            rid_tracker_update(&context.tracker, &context.addresses[context.order[i]], &context.location, context.now);
+        }
+    }
+    bench_sink += rid_tracker_count(&context.tracker);
+}
+
+static void bench_find(void *unused, uint64_t iterations) {
+    (void)unused;
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        for (size_t i = 0; i < BENCH_TRACKER_UPDATES; ++i) {
+            const rid_aircraft_t *aircraft = rid_tracker_find(&context.tracker, &context.addresses[context.order[i]]);
+            bench_sink += aircraft->last_seen;
+        }
+    }
+}
+
+/* Expire half of the aircraft and add them back. */
+static void bench_expire(void *unused, uint64_t iterations) {
+    (void)unused;
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        context.now++;
+        for (size_t i = 0; i < BENCH_TRACKER_AIRCRAFT; i += 2) {
+            rid_tracker_update(&context.tracker, &context.addresses[i], &context.location, context.now);
+        }
+        bench_sink += rid_tracker_expire(&context.tracker, context.now);
+        for (size_t i = 1; i < BENCH_TRACKER_AIRCRAFT; i += 2) {
+            rid_tracker_update(&context.tracker, &context.addresses[i], &context.location, context.now);
+        }
+    }
+}
+
+void bench_tracker(void) {
+    setup();
+
+    bench_run("tracker", "rid_tracker_update (10k aircraft)", bench_update, NULL, BENCH_TRACKER_UPDATES);
+    bench_run("tracker", "rid_tracker_find (10k aircraft)", bench_find, NULL, BENCH_TRACKER_UPDATES);
+    bench_run("tracker", "expire and readd half", bench_expire, NULL, BENCH_TRACKER_AIRCRAFT);
+
+    free(context.storage);
+}
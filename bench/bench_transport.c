@@ -0,0 +1,181 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "bench.h"
+#include "rid/beacon.h"
+#include "rid/bluetooth.h"
+#include "rid/location.h"
+#include "rid/message.h"
+#include "rid/message_pack.h"
+#include "rid/nan.h"
+#include "rid/transport.h"
+
+#define BENCH_TRANSPORT_COUNT 256
+#define BENCH_TRANSPORT_BEACON_SIZE 512
+
+typedef struct {
+    uint8_t advertisements[BENCH_TRANSPORT_COUNT][RID_BLUETOOTH_LEGACY_SIZE];
+    uint8_t frames[BENCH_TRANSPORT_COUNT][RID_NAN_MAX_SIZE];
+    size_t frame_sizes[BENCH_TRANSPORT_COUNT];
+    uint8_t beacons[BENCH_TRANSPORT_COUNT][BENCH_TRANSPORT_BEACON_SIZE];
+    size_t beacon_sizes[BENCH_TRANSPORT_COUNT];
+    rid_location_t location;
+    rid_message_pack_t pack;
+} bench_transport_context_t;
+
+static bench_transport_context_t context;
+
+static void setup(void) {
+    bench_random_seed(5);
+
+    rid_location_init(&context.location);
+    rid_location_set_latitude(&context.location, 60.1699);
+    rid_location_set_longitude(&context.location, 24.9384);
+
+    /* Mostly other advertisers, every sixteenth one is Remote ID. */
+    for (size_t i = 0; i < BENCH_TRANSPORT_COUNT; ++i) {
+        uint8_t *payload = context.advertisements[i];
+
+        if (i % 16 == 15) {
+            rid_bluetooth_build(&context.location, (uint8_t)i, payload, RID_BLUETOOTH_LEGACY_SIZE, NULL);
+            continue;
+        }
+
+        /* Flags followed by manufacturer specific data. */
+        payload[0] = 0x02;
+        payload[1] = 0x01;
+        payload[2] = 0x06;
+        payload[3] = 0x1A;
+        payload[4] = 0xFF;
+        for (size_t j = 5; j < RID_BLUETOOTH_LEGACY_SIZE; ++j) {
+            payload[j] = (uint8_t)bench_random();
+        }
+    }
+
+    rid_message_pack_init(&context.pack);
+    for (size_t i = 0; i < 4; ++i) {
+        rid_message_pack_add_message(&context.pack, &context.location);
+    }
+
+    /* Every sixteenth frame is Remote ID, others are action frames of other services. */
+    for (size_t i = 0; i < BENCH_TRANSPORT_COUNT; ++i) {
+        const rid_address_t source = {{0x02, 0x00, 0x00, 0x00, 0x00, (uint8_t)i}};
+        uint8_t *frame = context.frames[i];
+
+        rid_nan_build(&context.pack, (uint8_t)i, &source, frame, RID_NAN_MAX_SIZE, &context.frame_sizes[i]);
+        if (i % 16 == 15) {
+            continue;
+        }
+        if (i % 2) {
+            /* Some other NAN service. */
+            frame[33] = (uint8_t)bench_random();
+        } else {
+            /* Some other vendor specific action. */
+            frame[29] = (uint8_t)bench_random() | 0x80;
+        }
+    }
+
+    /* Typical access point beacons with a dozen elements, every sixteenth one with Remote ID. */
+    for (size_t i = 0; i < BENCH_TRANSPORT_COUNT; ++i) {
+        uint8_t *body = context.beacons[i];
+        size_t size = RID_BEACON_FIXED_SIZE;
+
+        memset(body, 0, RID_BEACON_FIXED_SIZE);
+        for (size_t element = 0; element < 12; ++element) {
+            uint8_t length = (uint8_t)(bench_random() % 24);
+
+            body[size] = element == 11 ? RID_BEACON_ELEMENT_ID_VENDOR_SPECIFIC : (uint8_t)(bench_random() % 200);
+            body[size + 1] = length;
+            for (size_t j = 0; j < length; ++j) {
+                body[size + 2 + j] = (uint8_t)bench_random();
+            }
+            size += 2 + length;
+        }
+        context.beacon_sizes[i] = size;
+
+        if (i % 16 == 15) {
+            rid_beacon_update(body, &context.beacon_sizes[i], BENCH_TRANSPORT_BEACON_SIZE, &context.pack, (uint8_t)i);
+        }
+    }
+}
+
+static void bench_bluetooth_parse(void *unused, uint64_t iterations) {
+    rid_bluetooth_frame_t frame;
+    uint64_t found = 0;
+    (void)unused;
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        const uint8_t *payload = context.advertisements[n % BENCH_TRANSPORT_COUNT];
+        found += rid_bluetooth_parse(payload, RID_BLUETOOTH_LEGACY_SIZE, &frame) == RID_SUCCESS;
+    }
+    bench_sink += found;
+}
+
+static void bench_bluetooth_build(void *unused, uint64_t iterations) {
+    uint8_t payload[RID_BLUETOOTH_LEGACY_SIZE];
+    (void)unused;
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        rid_bluetooth_build(&context.location, (uint8_t)n, payload, sizeof(payload), NULL);
+        bench_sink += payload[5];
+    }
+}
+
+static void bench_nan_parse(void *unused, uint64_t iterations) {
+    rid_nan_frame_t frame;
+    uint64_t found = 0;
+    (void)unused;
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        size_t i = n % BENCH_TRANSPORT_COUNT;
+        found += rid_nan_parse(context.frames[i], context.frame_sizes[i], &frame) == RID_SUCCESS;
+    }
+    bench_sink += found;
+}
+
+static void bench_nan_build(void *unused, uint64_t iterations) {
+    static uint8_t frame[RID_NAN_MAX_SIZE];
+    const rid_address_t source = {{0x02, 0x00, 0x00, 0x00, 0x00, 0x01}};
+    size_t written = 0;
+    (void)unused;
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        rid_nan_build(&context.pack, (uint8_t)n, &source, frame, sizeof(frame), &written);
+        bench_sink += written;
+    }
+}
+
+static void bench_beacon_parse(void *unused, uint64_t iterations) {
+    rid_beacon_frame_t frame;
+    uint64_t found = 0;
+    (void)unused;
+
+    for (uint64_t n = 0; n < iterations; ++n) {
+        size_t i = n % BENCH_TRANSPORT_COUNT;
+        found += rid_beacon_parse(context.beacons[i], context.beacon_sizes[i], &frame) == RID_SUCCESS;
+    }
+    bench_sink += found;
+}
+
+static void bench_beacon_update(void *unused, uint64_t iterations) {
+    static uint8_t body[BENCH_TRANSPORT_BEACON_SIZE];
+    size_t size = context.beacon_sizes[15];
+    (void)unused;
+
+    memcpy(body, context.beacons[15], size);
+    for (uint64_t n = 0; n < iterations; ++n) {
+        rid_beacon_update(body, &size, sizeof(body), &context.pack, (uint8_t)n);
+        bench_sink += size;
+    }
+}
+
+void bench_transport(void) {
+    setup();
+
+    bench_run("transport", "rid_bluetooth_parse (1/16 Remote ID)", bench_bluetooth_parse, NULL, 1);
+    bench_run("transport", "rid_bluetooth_build", bench_bluetooth_build, NULL, 1);
+    bench_run("transport", "rid_nan_parse (1/16 Remote ID)", bench_nan_parse, NULL, 1);
+    bench_run("transport", "rid_nan_build (4 messages)", bench_nan_build, NULL, 1);
+    bench_run("transport", "rid_beacon_parse (1/16 Remote ID)", bench_beacon_parse, NULL, 1);
+    bench_run("transport", "rid_beacon_update (4 messages)", bench_beacon_update, NULL, 1);
+}
@@ -4,7 +4,7 @@
 
 #include "rid/rid.h"
 
-#define BTMON_HEADER_SIZE 2 /* App code + counter */
+#define INPUT_MAX_SIZE 255 /* Extended advertising payload */
 
 static int hex_to_bytes(const char *hex, uint8_t *bytes, size_t max_length) {
     size_t hex_length = strlen(hex);
@@ -35,35 +35,54 @@ static void strip_newline(char *str) {
     }
 }
 
+typedef struct {
+    int counter;
+    int started;
+} cli_output_t;
+
+static int cli_write(void *context, const char *data, size_t length) {
+    cli_output_t *output = (cli_output_t *)context;
+
+    /* Insert counter after opening brace */
+    if (!output->started && output->counter >= 0 && length > 0) {
+        printf("{\"counter\": %d, ", output->counter);
+        data++;
+        length--;
+    }
+    output->started = 1;
+
+    if (fwrite(data, 1, length, stdout) != length) {
+        return RID_ERROR_WRITE_FAILED;
+    }
+
+    return 0;
+}
+
 static int decode_and_print(const char *hex_string, int force) {
-    uint8_t buffer[RID_MESSAGE_PACK_MAX_SIZE + BTMON_HEADER_SIZE];
+    uint8_t buffer[INPUT_MAX_SIZE];
     int length = hex_to_bytes(hex_string, buffer, sizeof(buffer));
     if (length < 0) {
         fprintf(stderr, "Error: Invalid hex string\n");
         return 1;
     }
 
-    uint8_t *message = buffer;
+    const uint8_t *message = buffer;
     int counter = -1;
-
-    if (length < RID_MESSAGE_SIZE) {
+    rid_bluetooth_frame_t frame;
+
+    /* btmon prints service data with app code and counter, also accept whole advertisements */
+    if (rid_bluetooth_parse_service_data(buffer, (size_t)length, &frame) == RID_SUCCESS ||
+        rid_bluetooth_parse(buffer, (size_t)length, &frame) == RID_SUCCESS) {
+        counter = frame.counter;
+        message = frame.message;
+    } else if (length < RID_MESSAGE_SIZE) {
         fprintf(stderr, "Error: Expected at least %d bytes, got %d\n", RID_MESSAGE_SIZE, length);
         return 1;
-    }
-
-    if (length > RID_MESSAGE_PACK_MAX_SIZE + BTMON_HEADER_SIZE) {
-        fprintf(stderr, "Error: Expected at most %d bytes, got %d\n", RID_MESSAGE_PACK_MAX_SIZE + BTMON_HEADER_SIZE, length);
+    } else if (length > RID_MESSAGE_PACK_MAX_SIZE) {
+        fprintf(stderr, "Error: Expected at most %d bytes, got %d\n", RID_MESSAGE_PACK_MAX_SIZE, length);
         return 1;
     }
 
-    /* Check for btmon input which has the extra two byte header */
-    if (buffer[0] == RID_TRANSPORT_BLUETOOTH_APP_CODE) {
-        /* Counter is the second byte */
-        counter = buffer[1];
-        /* Message starts at third byte */
-        message = buffer + 2;
-    }
-
     int rc = rid_message_validate(message);
     if (rc < 0) {
         if (force) {
@@ -74,20 +93,17 @@ static int decode_and_print(const char *hex_string, int force) {
         }
     }
 
-    char json[4096];
-    rc = rid_message_to_json(message, json, sizeof(json), NULL);
+    /* Stream JSON straight to stdout, with optional counter prefix */
+    cli_output_t output = {counter, 0};
+    rid_json_sink_t sink;
+    rid_json_sink_init(&sink, cli_write, &output);
+
+    rc = rid_message_to_json_sink(message, &sink);
     if (rc < 0) {
         fprintf(stderr, "Error: %s\n", rid_error_to_string(rc));
         return 1;
     }
-
-    /* Output with optional counter prefix */
-    if (counter >= 0) {
-        /* Insert counter after opening brace */
-        printf("{\"counter\": %d, %s\n", counter, json + 1);
-    } else {
-        printf("%s\n", json);
-    }
+    putchar('\n');
     fflush(stdout);
 
     return 0;
@@ -0,0 +1,146 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "rid/rid.h"
+
+#define MAX_THREADS 64
+
+typedef struct {
+    rid_pcap_reader_t reader;
+    uint64_t counts[RID_TRANSPORT_MAX + 1];
+    int status;
+    pthread_t thread;
+} worker_t;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void *scan(void *argument) {
+    worker_t *worker = (worker_t *)argument;
+    rid_pcap_record_t record;
+
+    while ((worker->status = rid_pcap_reader_next(&worker->reader, &record)) == RID_SUCCESS) {
+        worker->counts[record.transport]++;
+    }
+
+    return NULL;
+}
+
+/* Count messages per transport using several threads. */
+static int count_parallel(rid_pcap_reader_t *reader, size_t size, size_t threads) {
+    static rid_pcap_reader_t chunks[MAX_THREADS];
+    static worker_t workers[MAX_THREADS];
+    uint64_t counts[RID_TRANSPORT_MAX + 1] = {0};
+    uint64_t start = now_ns();
+    size_t chunk_count;
+    double seconds;
+
+    rid_pcap_reader_split(reader, chunks, threads, &chunk_count);
+
+    for (size_t i = 0; i < chunk_count; ++i) {
+        workers[i].reader = chunks[i];
+        pthread_create(&workers[i].thread, NULL, scan, &workers[i]);
+    }
+
+    for (size_t i = 0; i < chunk_count; ++i) {
+        pthread_join(workers[i].thread, NULL);
+        if (workers[i].status != RID_ERROR_NOT_FOUND) {
+            fprintf(stderr, "Warning: chunk %zu: %s\n", i, rid_error_to_string(workers[i].status));
+        }
+        for (int transport = 0; transport <= RID_TRANSPORT_MAX; ++transport) {
+            counts[transport] += workers[i].counts[transport];
+        }
+    }
+
+    seconds = (double)(now_ns() - start) / 1e9;
+
+    for (int transport = 0; transport <= RID_TRANSPORT_MAX; ++transport) {
+        printf("%-28s %llu\n", rid_transport_to_string((rid_transport_t)transport),
+               (unsigned long long)counts[transport]);
+    }
+    fprintf(stderr, "%zu threads, %.3f s, %.2f GB/s\n", chunk_count, seconds, (double)size / seconds / 1e9);
+
+    return 0;
+}
+
+static int stdout_write(void *context, const char *data, size_t length) {
+    (void)context;
+    return fwrite(data, 1, length, stdout) == length ? 0 : RID_ERROR_WRITE_FAILED;
+}
+
+/* Print every message as newline delimited JSON. */
+static int print_ndjson(rid_pcap_reader_t *reader) {
+    rid_pcap_record_t record;
+    rid_json_sink_t sink;
+    int status;
+
+    rid_json_sink_init(&sink, stdout_write, NULL);
+
+    while ((status = rid_pcap_reader_next(reader, &record)) == RID_SUCCESS) {
+        /* Milliseconds like rid_tracker_update() uses. */
+        uint64_t received = record.timestamp / 1000;
+
+        rid_messages_to_ndjson_sink(record.message, record.message_size, 1, &received, &record.source, &sink);
+    }
+
+    if (status != RID_ERROR_NOT_FOUND) {
+        fprintf(stderr, "Error: %s\n", rid_error_to_string(status));
+        return 1;
+    }
+
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    rid_pcap_mapping_t mapping;
+    rid_pcap_reader_t reader;
+    const char *path = NULL;
+    size_t threads = 0;
+    int status;
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+            threads = strtoul(argv[++i], NULL, 10);
+        } else {
+            path = argv[i];
+        }
+    }
+
+    if (path == NULL || threads > MAX_THREADS) {
+        fprintf(stderr, "Usage: %s [-j <threads>] <file.pcap|file.pcapng>\n", argv[0]);
+        return 1;
+    }
+
+    status = rid_pcap_map(&mapping, path);
+    if (status != RID_SUCCESS) {
+        fprintf(stderr, "Error: %s: %s\n", path, rid_error_to_string(status));
+        return 1;
+    }
+
+    status = rid_pcap_reader_init(&reader, mapping.data, mapping.size);
+    if (status != RID_SUCCESS) {
+        fprintf(stderr, "Error: %s: %s\n", path, rid_error_to_string(status));
+        rid_pcap_unmap(&mapping);
+        return 1;
+    }
+
+    if (threads > 0) {
+        status = count_parallel(&reader, mapping.size, threads);
+    } else {
+        status = print_ndjson(&reader);
+    }
+
+    rid_pcap_unmap(&mapping);
+
+    return status;
+}
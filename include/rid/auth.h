@@ -48,6 +48,7 @@ SPDX-License-Identifier: MIT
 #include <stdint.h>
 
 #include "rid/auth_page.h"
+#include "rid/json.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -56,6 +57,12 @@ extern "C" {
 /** @brief Max signature size in bytes. */
 #define RID_AUTH_PAGE_MAX_SIGNATURE_SIZE 255
 
+/** @brief Max signed payload size, nine messages and the timestamp. */
+#define RID_AUTH_MAX_PAYLOAD_SIZE (9 * 25 + 4)
+
+/** @brief Max digest size of a streaming hash in bytes. */
+#define RID_AUTH_MAX_DIGEST_SIZE 64
+
 /**
  * @brief Container for multi-page authentication data.
  *
@@ -79,7 +86,9 @@ typedef struct rid_auth {
  * @param signature_length Length of the signature in bytes.
  *
  * @retval 0 on success.
- * @retval Non-zero on verification failure.
+ * @retval RID_ERROR_INVALID_SIGNATURE if the signature does not match.
+ * @retval Other non-zero values if the signature could not be verified,
+ *         for example when the crypto backend is unavailable.
  */
 typedef int (*rid_auth_verify_cb_t)(
     void *context,
@@ -113,6 +122,61 @@ typedef int (*rid_auth_sign_cb_t)(
     size_t *signature_length
 );
 
+/**
+ * @brief Streaming hash used by hash-then-sign backends.
+ *
+ * The signed payload is fed to update() one message at a time, the flat
+ * payload is never built. All callbacks return 0 on success and non-zero
+ * on failure.
+ */
+typedef struct rid_auth_hash {
+    /** @brief Start a new hash. */
+    int (*init)(void *context);
+    /** @brief Feed size bytes of the payload. */
+    int (*update)(void *context, const uint8_t *data, size_t size);
+    /** @brief Write the digest, at most digest_size bytes, and its length. */
+    int (*final)(void *context, uint8_t *digest, size_t digest_size, size_t *digest_length);
+    /** @brief Opaque context passed to the callbacks, usually the hash state. */
+    void *context;
+} rid_auth_hash_t;
+
+/**
+ * @brief Signed payload and signature of one batch item.
+ *
+ * The batch callback sets result to 0 if the signature is valid and
+ * to non-zero otherwise. Index is the position of the item in the
+ * arrays passed to rid_auth_verify_batch().
+ */
+typedef struct rid_auth_verify_item {
+    const uint8_t *input;
+    size_t input_length;
+    const uint8_t *signature;
+    size_t signature_length;
+    size_t index;
+    int result;
+} rid_auth_verify_item_t;
+
+/**
+ * @brief Callback function type for verifying many signatures at once.
+ *
+ * Called by rid_auth_verify_batch() with the items whose payload could
+ * be built. Payloads of consecutive items are stored back to back in
+ * one contiguous buffer.
+ *
+ * @param context Opaque context passed to the callback.
+ * @param items Items to verify, the callback sets their result.
+ * @param count Number of items.
+ *
+ * @retval 0 if results were set.
+ * @retval Non-zero if the whole batch failed, the value is then used as
+ *         the result of every item.
+ */
+typedef int (*rid_auth_verify_batch_cb_t)(
+    void *context,
+    rid_auth_verify_item_t *items,
+    size_t count
+);
+
 /**
  * @brief Verify an authentication signature using a caller supplied callback.
  *
@@ -146,6 +210,51 @@ int rid_auth_verify(
     void *context
 );
 
+/**
+ * @brief Get the scratch size needed for verifying a batch.
+ *
+ * @param count Number of auth and message pairs in the batch.
+ *
+ * @return Size of the scratch area in bytes.
+ */
+size_t rid_auth_verify_batch_scratch_size(size_t count);
+
+/**
+ * @brief Verify many authentication signatures with one callback call.
+ *
+ * Builds the signed payloads of all pairs into the scratch area and
+ * passes them to the batch callback in one call. Without a batch
+ * callback the single verify callback is called for each pair instead.
+ * Pairs which fail the checks done by rid_auth_verify() are left out
+ * of the batch.
+ *
+ * @param auths Authentication data containers.
+ * @param messages Message Packs whose non-AUTH messages were signed.
+ * @param count Number of pairs.
+ * @param scratch Scratch area for the payloads.
+ * @param scratch_size Size of the scratch area in bytes.
+ * @param batch_callback Callback verifying the whole batch or NULL.
+ * @param callback Callback verifying one pair, used if batch_callback is NULL.
+ * @param context Opaque context passed to the callbacks.
+ * @param results Receives the rid_auth_verify() return value of each pair.
+ *
+ * @retval RID_SUCCESS if the batch was processed, see results.
+ * @retval RID_ERROR_NULL_POINTER if a pointer argument is NULL or both
+ *         callbacks are NULL.
+ * @retval RID_ERROR_BUFFER_TOO_SMALL if the scratch area is too small.
+ */
+int rid_auth_verify_batch(
+    const rid_auth_t *const *auths,
+    const void *const *messages,
+    size_t count,
+    void *scratch,
+    size_t scratch_size,
+    rid_auth_verify_batch_cb_t batch_callback,
+    rid_auth_verify_cb_t callback,
+    void *context,
+    int *results
+);
+
 /**
  * @brief Create an authentication signature with a caller supplied callback.
  *
@@ -181,6 +290,59 @@ int rid_auth_sign(
     void *context
 );
 
+/**
+ * @brief Create an authentication signature over a streamed hash.
+ *
+ * Works like rid_auth_sign() but feeds the payload to the hash and calls
+ * the sign callback with the digest as input.
+ *
+ * @param auth Pointer to the authentication data container. The signature
+ *             produced by the callback is stored here.
+ * @param message Pointer to a rid_message_pack_t whose non-AUTH messages
+ *                are to be signed.
+ * @param hash Streaming hash callbacks.
+ * @param callback Callback function signing the digest.
+ * @param context Opaque context passed to the sign callback.
+ *
+ * @retval RID_SUCCESS if signing succeeded.
+ * @retval RID_ERROR_NULL_POINTER if any argument except context is NULL.
+ * @retval Any return value of rid_auth_sign().
+ * @retval Any non-zero value returned by the hash callbacks.
+ */
+int rid_auth_sign_hashed(
+    rid_auth_t *auth,
+    const void *message,
+    const rid_auth_hash_t *hash,
+    rid_auth_sign_cb_t callback,
+    void *context
+);
+
+/**
+ * @brief Verify an authentication signature over a streamed hash.
+ *
+ * Works like rid_auth_verify() but feeds the payload to the hash and
+ * calls the verify callback with the digest as input.
+ *
+ * @param auth Pointer to the authentication data container.
+ * @param message Pointer to a rid_message_pack_t whose non-AUTH messages
+ *                were signed.
+ * @param hash Streaming hash callbacks.
+ * @param callback Callback function verifying the digest.
+ * @param context Opaque context passed to the verify callback.
+ *
+ * @retval RID_SUCCESS if verification succeeded.
+ * @retval RID_ERROR_NULL_POINTER if any argument except context is NULL.
+ * @retval Any return value of rid_auth_verify().
+ * @retval Any non-zero value returned by the hash callbacks.
+ */
+int rid_auth_verify_hashed(
+    const rid_auth_t *auth,
+    const void *message,
+    const rid_auth_hash_t *hash,
+    rid_auth_verify_cb_t callback,
+    void *context
+);
+
 /**
  * @brief Initialize an authentication data container.
  *
@@ -344,6 +506,39 @@ int rid_auth_to_json(
     const rid_auth_t *auth, char *buffer, size_t buffer_size, size_t *needed_size
 );
 
+/**
+ * @brief Write combined Authentication messages as JSON to a sink.
+ *
+ * @param auth Pointer to the Auth container structure.
+ * @param sink Sink receiving the output.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if @p auth or @p sink is NULL.
+ * @retval Other values returned by the sink write callback.
+ */
+int rid_auth_to_json_sink(const rid_auth_t *auth, const rid_json_sink_t *sink);
+
+/**
+ * @brief Encode an Auth message as CBOR.
+ *
+ * Produces the same fields as rid_auth_to_json(). Numbers are encoded
+ * as integers or floats, invalid values as null. Objects and arrays
+ * use indefinite length encoding.
+ *
+ * @param auth Pointer to the Auth container structure.
+ * @param buffer Buffer to store the CBOR data or NULL.
+ * @param buffer_size Size of the buffer.
+ * @param needed_size If non-NULL receives the required buffer size.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if @p auth is NULL or if both
+ *         @p buffer and @p needed_size are NULL.
+ * @retval RID_ERROR_BUFFER_TOO_SMALL if @p buffer is too small.
+ */
+int rid_auth_to_cbor(
+    const rid_auth_t *auth, uint8_t *buffer, size_t buffer_size, size_t *needed_size
+);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -0,0 +1,189 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of librid: https://github.com/tuupola/librid
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#ifndef RID_AUTH_CACHE_H
+#define RID_AUTH_CACHE_H
+
+/**
+ * @file auth_cache.h
+ * @brief Cache of signature verification results.
+ *
+ * Aircraft rebroadcast the same signed Message Pack several times a
+ * second. The cache remembers the verification result of each signed
+ * payload and signature pair so the verify callback runs only once per
+ * pair.
+ *
+ * Entries are keyed by a SipHash-2-4 of the verify callback, its
+ * context, the signed payload and the signature. SipHash is keyed, so
+ * with a secret random key an attacker can not craft a forged payload
+ * whose hash matches a cached one. The table is set associative, each
+ * set holds RID_AUTH_CACHE_WAYS entries and the least recently used
+ * entry of a set is replaced. Storage is provided by the caller.
+ *
+ * The callback and context pointers stand for the verifying key, so one
+ * cache can serve several verifiers. Clear the cache if the key behind
+ * a context is changed in place.
+ *
+ * The cache is not thread safe.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rid/auth.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/** @brief Number of entries in each set. */
+#define RID_AUTH_CACHE_WAYS 4
+
+/** @brief Size of the hash key in bytes. */
+#define RID_AUTH_CACHE_KEY_SIZE 16
+
+/** @brief Maximum number of entries a cache can hold. */
+#define RID_AUTH_CACHE_MAX_CAPACITY 0x10000000
+
+/**
+ * @brief Cache entry, internal to the cache.
+ *
+ * Entries with zero stamp are empty.
+ */
+typedef struct rid_auth_cache_entry {
+    uint64_t hash;
+    uint32_t stamp;
+    int32_t result;
+} rid_auth_cache_entry_t;
+
+/**
+ * @brief Verification result cache.
+ */
+typedef struct rid_auth_cache {
+    uint64_t key[2];
+    uint32_t mask;
+    uint32_t clock;
+    uint64_t hits;
+    uint64_t misses;
+    rid_auth_cache_entry_t *entries;
+} rid_auth_cache_t;
+
+/**
+ * @brief Get the storage size needed for a cache of given capacity.
+ *
+ * Capacity is rounded up to a power of two number of sets.
+ *
+ * @param capacity Number of cached results.
+ *
+ * @return Size of the storage in bytes or 0 if capacity is out of range.
+ */
+size_t rid_auth_cache_storage_size(size_t capacity);
+
+/**
+ * @brief Initialize a cache using caller provided storage.
+ *
+ * @param cache Pointer to the cache to initialize.
+ * @param storage Storage for the entries.
+ * @param storage_size Size of the storage in bytes.
+ * @param capacity Number of cached results.
+ * @param key Secret random key of RID_AUTH_CACHE_KEY_SIZE bytes.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if cache, storage or key is NULL.
+ * @retval RID_ERROR_OUT_OF_RANGE if capacity is zero or larger than
+ *         RID_AUTH_CACHE_MAX_CAPACITY.
+ * @retval RID_ERROR_BUFFER_TOO_SMALL if storage is too small.
+ */
+int rid_auth_cache_init(
+    rid_auth_cache_t *cache, void *storage, size_t storage_size, size_t capacity,
+    const uint8_t *key
+);
+
+/**
+ * @brief Drop all cached results and reset the counters.
+ *
+ * @param cache Pointer to the cache.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if cache is NULL.
+ */
+int rid_auth_cache_clear(rid_auth_cache_t *cache);
+
+/**
+ * @brief Verify an authentication signature through the cache.
+ *
+ * Works like rid_auth_verify(). If the same signed payload and signature
+ * have been verified before with the same callback and context the
+ * cached result is returned without calling the callback. Otherwise the
+ * callback is called. Only definitive results are stored, RID_SUCCESS and
+ * RID_ERROR_INVALID_SIGNATURE. Any other error from the callback is
+ * returned without caching it, so the next call verifies again.
+ *
+ * @param cache Pointer to the cache.
+ * @param auth Pointer to the authentication data container.
+ * @param message Pointer to a rid_message_pack_t whose non-AUTH messages
+ *                were signed.
+ * @param callback Callback function used to verify the signature.
+ * @param context Opaque context passed to the callback.
+ *
+ * @retval RID_ERROR_NULL_POINTER if any pointer argument except context
+ *         is NULL.
+ * @retval Any value returned by rid_auth_verify().
+ */
+int rid_auth_cache_verify(
+    rid_auth_cache_t *cache, const rid_auth_t *auth, const void *message,
+    rid_auth_verify_cb_t callback, void *context
+);
+
+/**
+ * @brief Get the number of results served from the cache.
+ *
+ * @param cache Pointer to the cache.
+ *
+ * @return Number of hits or 0 if cache is NULL.
+ */
+uint64_t rid_auth_cache_hits(const rid_auth_cache_t *cache);
+
+/**
+ * @brief Get the number of results which had to be verified.
+ *
+ * @param cache Pointer to the cache.
+ *
+ * @return Number of misses or 0 if cache is NULL.
+ */
+uint64_t rid_auth_cache_misses(const rid_auth_cache_t *cache);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* RID_AUTH_CACHE_H */
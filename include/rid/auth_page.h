@@ -52,6 +52,8 @@ SPDX-License-Identifier: MIT
 #include <stddef.h>
 #include <stdint.h>
 
+#include "rid/json.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
@@ -148,6 +150,26 @@ int rid_auth_page_0_init(rid_auth_page_0_t *message);
  */
 int rid_auth_page_x_init(rid_auth_page_x_t *message, uint8_t page_number);
 
+/**
+ * @brief Validate a single Authentication message page.
+ *
+ * Only checks what can be checked from the page alone. Page 0 must have
+ * a last page index of at most 15 and enough pages for the length, a
+ * Network Remote ID page 0 must have an empty signature.
+ *
+ * @param message Pointer to page 0 or to a page 1-15.
+ *
+ * @retval RID_SUCCESS if all fields are valid.
+ * @retval RID_ERROR_NULL_POINTER if message is NULL.
+ * @retval RID_ERROR_INVALID_PROTOCOL_VERSION if protocol version is invalid.
+ * @retval RID_ERROR_UNKNOWN_MESSAGE_TYPE if message type is not AUTH.
+ * @retval RID_ERROR_INVALID_LAST_PAGE_INDEX if last_page_index exceeds
+ *         maximum or the pages can not hold length bytes.
+ * @retval RID_ERROR_NON_EMPTY_SIGNATURE if auth type is NETWORK_REMOTE_ID
+ *         but signature is not empty.
+ */
+int rid_auth_page_validate(const void *message);
+
 /**
  * @brief Set the authentication type for page 0.
  *
@@ -356,6 +378,39 @@ int rid_auth_page_to_json(
     const void *message, char *buffer, size_t buffer_size, size_t *needed_size
 );
 
+/**
+ * @brief Write an Authentication message page as JSON to a sink.
+ *
+ * @param message Pointer to an AUTH page structure.
+ * @param sink Sink receiving the output.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if @p message or @p sink is NULL.
+ * @retval Other values returned by the sink write callback.
+ */
+int rid_auth_page_to_json_sink(const void *message, const rid_json_sink_t *sink);
+
+/**
+ * @brief Encode a single AUTH page message as CBOR.
+ *
+ * Produces the same fields as rid_auth_page_to_json(). Numbers are encoded
+ * as integers or floats, invalid values as null. Objects and arrays
+ * use indefinite length encoding.
+ *
+ * @param message Pointer to an AUTH page structure.
+ * @param buffer Buffer to store the CBOR data or NULL.
+ * @param buffer_size Size of the buffer.
+ * @param needed_size If non-NULL receives the required buffer size.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if @p message is NULL or if both
+ *         @p buffer and @p needed_size are NULL.
+ * @retval RID_ERROR_BUFFER_TOO_SMALL if @p buffer is too small.
+ */
+int rid_auth_page_to_cbor(
+    const void *message, uint8_t *buffer, size_t buffer_size, size_t *needed_size
+);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
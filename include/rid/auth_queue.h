@@ -0,0 +1,257 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of librid: https://github.com/tuupola/librid
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#ifndef RID_AUTH_QUEUE_H
+#define RID_AUTH_QUEUE_H
+
+/**
+ * @file auth_queue.h
+ * @brief Asynchronous signing and verification.
+ *
+ * Slow signing or verification backends should not stall the broadcast
+ * loop. Submitting a job validates the input and builds the signed
+ * payload right away, then returns without waiting for the crypto. Jobs
+ * are run by worker threads calling rid_auth_queue_work(), which then
+ * call the completion callback.
+ *
+ * The queue is a bounded lock-free ring buffer in caller provided
+ * storage. Submitting never blocks, a full queue is reported to the
+ * caller instead. Any number of threads may submit and work at the same
+ * time. The queue does not create threads, use as many workers as the
+ * backend can keep busy.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rid/auth.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/** @brief Maximum number of jobs in a queue. */
+#define RID_AUTH_QUEUE_MAX_CAPACITY 0x100000
+
+/**
+ * @brief Kind of job.
+ */
+typedef enum {
+    RID_AUTH_JOB_SIGN = 0,
+    RID_AUTH_JOB_VERIFY = 1,
+} rid_auth_job_type_t;
+
+/**
+ * @brief Signing or verification job.
+ *
+ * Auth is a copy of the submitted container. For sign jobs the new
+ * signature is stored in it, ready for rid_message_pack_set_auth().
+ * Result is what rid_auth_sign() or rid_auth_verify() would have
+ * returned. User is the pointer given when submitting.
+ */
+typedef struct rid_auth_job {
+    rid_auth_job_type_t type;
+    int result;
+    void *user;
+    rid_auth_t auth;
+    size_t payload_length;
+    size_t signature_length;
+    uint8_t payload[RID_AUTH_MAX_PAYLOAD_SIZE];
+    uint8_t signature[RID_AUTH_PAGE_MAX_SIGNATURE_SIZE];
+} rid_auth_job_t;
+
+/**
+ * @brief Callback called by the worker when a job is done.
+ *
+ * Called from the worker threads, possibly several at the same time.
+ * The job is only valid during the call.
+ *
+ * @param context User provided context.
+ * @param job Finished job.
+ */
+typedef void (*rid_auth_job_done_cb_t)(void *context, const rid_auth_job_t *job);
+
+struct rid_auth_queue_counters;
+
+/**
+ * @brief Job queue.
+ *
+ * All members are private.
+ */
+typedef struct rid_auth_queue {
+    size_t capacity;
+    size_t slot_size;
+    rid_auth_sign_cb_t sign;
+    rid_auth_verify_cb_t verify;
+    void *crypto_context;
+    rid_auth_job_done_cb_t done;
+    void *done_context;
+    struct rid_auth_queue_counters *counters;
+    uint8_t *slots;
+} rid_auth_queue_t;
+
+/**
+ * @brief Get the storage size needed for a queue.
+ *
+ * @param capacity Maximum number of queued jobs, a power of two.
+ *
+ * @return Size of the storage in bytes or 0 if capacity is invalid.
+ */
+size_t rid_auth_queue_storage_size(size_t capacity);
+
+/**
+ * @brief Initialize a queue using caller provided storage.
+ *
+ * @param queue Pointer to the queue to initialize.
+ * @param storage Storage for the jobs.
+ * @param storage_size Size of the storage in bytes.
+ * @param capacity Maximum number of queued jobs, a power of two.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if queue or storage is NULL.
+ * @retval RID_ERROR_OUT_OF_RANGE if capacity is invalid.
+ * @retval RID_ERROR_BUFFER_TOO_SMALL if storage is too small.
+ */
+int rid_auth_queue_init(rid_auth_queue_t *queue, void *storage, size_t storage_size, size_t capacity);
+
+/**
+ * @brief Set the crypto callbacks used by the workers.
+ *
+ * Call before submitting jobs. The callbacks are called from the
+ * worker threads, possibly several at the same time.
+ *
+ * @param queue Pointer to the queue.
+ * @param sign Callback producing signatures or NULL.
+ * @param verify Callback verifying signatures or NULL.
+ * @param context Opaque context passed to the callbacks.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if queue is NULL.
+ */
+int rid_auth_queue_set_crypto(
+    rid_auth_queue_t *queue, rid_auth_sign_cb_t sign, rid_auth_verify_cb_t verify, void *context
+);
+
+/**
+ * @brief Set the completion callback.
+ *
+ * @param queue Pointer to the queue.
+ * @param done Callback called for every finished job or NULL.
+ * @param context Opaque context passed to the callback.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if queue is NULL.
+ */
+int rid_auth_queue_set_callback(rid_auth_queue_t *queue, rid_auth_job_done_cb_t done, void *context);
+
+/**
+ * @brief Submit a signing job.
+ *
+ * Does the checks of rid_auth_sign() and builds the payload to be signed
+ * before returning. The auth container and message are not referenced
+ * after the call.
+ *
+ * @param queue Pointer to the queue.
+ * @param auth Authentication data, the timestamp must be set.
+ * @param message Pointer to a rid_message_pack_t to sign.
+ * @param user Pointer passed back in the finished job.
+ *
+ * @retval RID_SUCCESS if the job was queued.
+ * @retval RID_ERROR_NULL_POINTER if queue, auth or message is NULL or
+ *         no sign callback is set.
+ * @retval RID_ERROR_BUFFER_TOO_SMALL if the queue is full.
+ * @retval Validation error codes of rid_auth_sign().
+ */
+int rid_auth_queue_submit_sign(
+    rid_auth_queue_t *queue, const rid_auth_t *auth, const void *message, void *user
+);
+
+/**
+ * @brief Submit a verification job.
+ *
+ * Does the checks of rid_auth_verify() and builds the signed payload
+ * before returning. The auth container and message are not referenced
+ * after the call.
+ *
+ * @param queue Pointer to the queue.
+ * @param auth Authentication data holding the signature.
+ * @param message Pointer to a rid_message_pack_t which was signed.
+ * @param user Pointer passed back in the finished job.
+ *
+ * @retval RID_SUCCESS if the job was queued.
+ * @retval RID_ERROR_NULL_POINTER if queue, auth or message is NULL or
+ *         no verify callback is set.
+ * @retval RID_ERROR_BUFFER_TOO_SMALL if the queue is full.
+ * @retval Validation error codes of rid_auth_verify().
+ */
+int rid_auth_queue_submit_verify(
+    rid_auth_queue_t *queue, const rid_auth_t *auth, const void *message, void *user
+);
+
+/**
+ * @brief Signal that no more jobs will be submitted.
+ *
+ * @param queue Pointer to the queue.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if queue is NULL.
+ */
+int rid_auth_queue_close(rid_auth_queue_t *queue);
+
+/**
+ * @brief Run queued jobs.
+ *
+ * Call repeatedly from each worker thread.
+ *
+ * @param queue Pointer to the queue.
+ * @param max Maximum number of jobs to run.
+ *
+ * @return Number of jobs run, 0 if the queue is empty.
+ * @retval RID_ERROR_NULL_POINTER if queue is NULL.
+ * @retval RID_ERROR_NOT_FOUND if the queue is closed and empty.
+ */
+int rid_auth_queue_work(rid_auth_queue_t *queue, size_t max);
+
+/**
+ * @brief Get the number of jobs waiting for a worker.
+ *
+ * @param queue Pointer to the queue.
+ *
+ * @return Number of jobs or 0 if queue is NULL.
+ */
+size_t rid_auth_queue_count(const rid_auth_queue_t *queue);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* RID_AUTH_QUEUE_H */
@@ -0,0 +1,205 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of librid: https://github.com/tuupola/librid
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#ifndef RID_AUTH_REASSEMBLER_H
+#define RID_AUTH_REASSEMBLER_H
+
+/**
+ * @file auth_reassembler.h
+ * @brief Reassembly of Authentication pages received as separate messages.
+ *
+ * With Bluetooth Legacy every Authentication page is broadcast in its
+ * own advertisement. Pages from different aircraft are interleaved and
+ * some of them are lost. The reassembler collects the pages of each
+ * transmitter, keyed by the link layer source address, into a
+ * rid_auth_t and hands it out once page 0 and all pages up to its
+ * last_page_index have been received.
+ *
+ * Partial sets live in a pool carved out of caller provided storage and
+ * are indexed with an open addressing hash table. Updates are constant
+ * time and never allocate.
+ *
+ * Timestamps are opaque to the reassembler. Use any monotonic clock, for
+ * example milliseconds since boot.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rid/auth.h"
+#include "rid/message.h"
+#include "rid/transport.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/** @brief Maximum number of partial sets a reassembler can hold. */
+#define RID_AUTH_REASSEMBLER_MAX_CAPACITY 0x3FFFFFFF
+
+/**
+ * @brief Authentication pages received so far from one transmitter.
+ *
+ * Page n is valid only if bit (1 << n) is set in received.
+ */
+typedef struct rid_auth_partial {
+    rid_address_t address;
+    uint16_t received;
+    uint64_t first_seen;
+    uint64_t last_seen;
+    rid_auth_t auth;
+} rid_auth_partial_t;
+
+/**
+ * @brief Hash table slot, internal to the reassembler.
+ */
+typedef struct rid_auth_reassembler_slot {
+    uint32_t hash;
+    uint32_t index;
+} rid_auth_reassembler_slot_t;
+
+/**
+ * @brief Authentication page reassembler.
+ *
+ * Partial sets are stored densely in partial[0] to partial[count - 1].
+ */
+typedef struct rid_auth_reassembler {
+    size_t capacity;
+    size_t count;
+    uint32_t mask;
+    rid_auth_partial_t *partial;
+    rid_auth_reassembler_slot_t *slots;
+} rid_auth_reassembler_t;
+
+/**
+ * @brief Get the storage size needed for a reassembler of given capacity.
+ *
+ * @param capacity Maximum number of concurrently reassembled sets.
+ *
+ * @return Size of the storage in bytes or 0 if capacity is out of range.
+ */
+size_t rid_auth_reassembler_storage_size(size_t capacity);
+
+/**
+ * @brief Initialize a reassembler using caller provided storage.
+ *
+ * @param reassembler Pointer to the reassembler to initialize.
+ * @param storage Storage for partial sets and the hash table.
+ * @param storage_size Size of the storage in bytes.
+ * @param capacity Maximum number of concurrently reassembled sets.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if reassembler or storage is NULL.
+ * @retval RID_ERROR_OUT_OF_RANGE if capacity is zero or larger than
+ *         RID_AUTH_REASSEMBLER_MAX_CAPACITY.
+ * @retval RID_ERROR_BUFFER_TOO_SMALL if storage is too small.
+ */
+int rid_auth_reassembler_init(
+    rid_auth_reassembler_t *reassembler, void *storage, size_t storage_size, size_t capacity
+);
+
+/**
+ * @brief Drop all partial sets.
+ *
+ * @param reassembler Pointer to the reassembler.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if reassembler is NULL.
+ */
+int rid_auth_reassembler_clear(rid_auth_reassembler_t *reassembler);
+
+/**
+ * @brief Store a received Authentication page.
+ *
+ * Pages are stored by page_number. When the page completes the set of
+ * the transmitter the assembled message is copied to auth and the set
+ * is removed. A page which differs from an already received page with
+ * the same number, or has a different auth type, starts a new set. The
+ * new set is started from the received page alone, so a stale page 0
+ * can not complete it.
+ *
+ * @param reassembler Pointer to the reassembler.
+ * @param address Source address of the page.
+ * @param message Pointer to a single Authentication page.
+ * @param now Reception timestamp.
+ * @param auth Receives the assembled message when the set is complete.
+ *
+ * @return 1 if the set is complete, 0 if more pages are needed or a
+ *         negative error code.
+ * @retval RID_ERROR_NULL_POINTER if any pointer argument is NULL.
+ * @retval RID_ERROR_UNKNOWN_MESSAGE_TYPE if the message is not an
+ *         Authentication page.
+ * @retval RID_ERROR_INVALID_LAST_PAGE_INDEX if page 0 has a last page
+ *         index above 15 or too few pages for its length.
+ * @retval RID_ERROR_BUFFER_TOO_SMALL if the reassembler is full.
+ */
+int rid_auth_reassembler_update(
+    rid_auth_reassembler_t *reassembler, const rid_address_t *address, const void *message,
+    uint64_t now, rid_auth_t *auth
+);
+
+/**
+ * @brief Find the partial set of a transmitter.
+ *
+ * @param reassembler Pointer to the reassembler.
+ * @param address Source address to look up.
+ *
+ * @return Pointer to the partial set or NULL if not found.
+ */
+const rid_auth_partial_t *rid_auth_reassembler_find(
+    const rid_auth_reassembler_t *reassembler, const rid_address_t *address
+);
+
+/**
+ * @brief Drop all partial sets not updated since given time.
+ *
+ * @param reassembler Pointer to the reassembler.
+ * @param older_than Sets with last_seen before this are dropped.
+ *
+ * @return Number of dropped sets.
+ */
+size_t rid_auth_reassembler_expire(rid_auth_reassembler_t *reassembler, uint64_t older_than);
+
+/**
+ * @brief Get the number of partial sets.
+ *
+ * @param reassembler Pointer to the reassembler.
+ *
+ * @return Number of partial sets or 0 if reassembler is NULL.
+ */
+size_t rid_auth_reassembler_count(const rid_auth_reassembler_t *reassembler);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* RID_AUTH_REASSEMBLER_H */
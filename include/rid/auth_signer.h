@@ -0,0 +1,158 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of librid: https://github.com/tuupola/librid
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#ifndef RID_AUTH_SIGNER_H
+#define RID_AUTH_SIGNER_H
+
+/**
+ * @file auth_signer.h
+ * @brief Persistent signing context for repeatedly signed Message Packs.
+ *
+ * rid_auth_sign() assembles the signed payload from scratch on every
+ * call. A transmitter signing the same set of messages once a second
+ * usually changes only the Location message in between. The signer
+ * keeps the Message Pack and the assembled payload side by side, and
+ * the setters update the changed message in both. Signing then only
+ * appends the timestamp.
+ *
+ * The pack of the signer never contains Auth messages. Signatures are
+ * the same rid_auth_sign() produces for the pack.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rid/auth.h"
+#include "rid/message_pack.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * @brief Signing context.
+ *
+ * Payload holds the messages of the pack back to back followed by room
+ * for the timestamp.
+ */
+typedef struct rid_auth_signer {
+    rid_message_pack_t pack;
+    uint8_t payload[RID_AUTH_MAX_PAYLOAD_SIZE];
+} rid_auth_signer_t;
+
+/**
+ * @brief Initialize a signer from a Message Pack.
+ *
+ * Auth messages in the pack are left out.
+ *
+ * @param signer Pointer to the signer.
+ * @param pack Messages to sign or NULL to start empty.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if signer is NULL.
+ * @retval Validation error codes from rid_message_pack_validate().
+ */
+int rid_auth_signer_init(rid_auth_signer_t *signer, const rid_message_pack_t *pack);
+
+/**
+ * @brief Replace the message of the same type or add it.
+ *
+ * The first message with the same type is replaced, Basic ID messages
+ * only when the ID type is also the same. If there is none the message
+ * is added after the others.
+ *
+ * @param signer Pointer to the signer.
+ * @param message Pointer to the message.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if signer or message is NULL.
+ * @retval RID_ERROR_INVALID_MESSAGE_TYPE if message is an Auth message, a
+ *         Message Pack or of an unknown type.
+ * @retval RID_ERROR_OUT_OF_RANGE if the message is new and the pack is full.
+ */
+int rid_auth_signer_set_message(rid_auth_signer_t *signer, const void *message);
+
+/**
+ * @brief Replace the message at the specified index.
+ *
+ * @param signer Pointer to the signer.
+ * @param index Index of the message.
+ * @param message Pointer to the new message.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if signer or message is NULL.
+ * @retval RID_ERROR_INVALID_MESSAGE_TYPE if message is an Auth message, a
+ *         Message Pack or of an unknown type.
+ * @retval RID_ERROR_OUT_OF_RANGE if index is out of range.
+ */
+int rid_auth_signer_set_message_at(rid_auth_signer_t *signer, uint8_t index, const void *message);
+
+/**
+ * @brief Get the Message Pack of the signer.
+ *
+ * Copy it and add the signed Auth message with rid_message_pack_set_auth()
+ * before sending.
+ *
+ * @param signer Pointer to the signer.
+ *
+ * @return Pointer to the pack or NULL if signer is NULL.
+ */
+const rid_message_pack_t *rid_auth_signer_get_pack(const rid_auth_signer_t *signer);
+
+/**
+ * @brief Sign the messages of the signer.
+ *
+ * Same as rid_auth_sign() on the pack of the signer. The caller must
+ * set the timestamp of auth before calling this function.
+ *
+ * @param signer Pointer to the signer.
+ * @param auth Pointer to the authentication data container. The signature
+ *             produced by the callback is stored here.
+ * @param callback Callback function used to produce the signature.
+ * @param context Opaque context passed to the callback.
+ *
+ * @retval RID_SUCCESS if signing succeeded.
+ * @retval RID_ERROR_NULL_POINTER if signer, auth or callback is NULL.
+ * @retval RID_ERROR_OUT_OF_RANGE if the callback produced a zero-length
+ *         signature.
+ * @retval Validation error codes from rid_auth_validate().
+ * @retval Any non-zero value returned by the callback on signing failure.
+ */
+int rid_auth_signer_sign(
+    rid_auth_signer_t *signer, rid_auth_t *auth, rid_auth_sign_cb_t callback, void *context
+);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* RID_AUTH_SIGNER_H */
@@ -0,0 +1,172 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of librid: https://github.com/tuupola/librid
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#ifndef RID_BEACON_H
+#define RID_BEACON_H
+
+/**
+ * @file beacon.h
+ * @brief Wi-Fi Beacon vendor specific information element.
+ *
+ * Remote ID is broadcast in Wi-Fi Beacon frames as a vendor specific
+ * information element with the ASD-STAN OUI FA:0B:BC and vendor type
+ * 0x0D. The element contains a message counter followed by a Message
+ * Pack. See ASTM F3411-22a Section 5.4.
+ *
+ *     0xDD | length | 0xFA 0x0B 0xBC | 0x0D | counter | Message Pack
+ *
+ * The parsers return pointers into the given frame, nothing is copied.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rid/message_pack.h"
+#include "rid/transport.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/** @brief Element ID of a vendor specific information element. */
+#define RID_BEACON_ELEMENT_ID_VENDOR_SPECIFIC 0xDD
+
+/** @brief Timestamp, beacon interval and capability before the elements. */
+#define RID_BEACON_FIXED_SIZE 12
+
+/** @brief Bytes before the Message Pack: element ID, length, OUI, vendor type and counter. */
+#define RID_BEACON_HEADER_SIZE 7
+
+/** @brief Size of an element carrying the largest Message Pack. */
+#define RID_BEACON_MAX_SIZE (RID_BEACON_HEADER_SIZE + RID_MESSAGE_PACK_MAX_SIZE)
+
+/**
+ * @brief Remote ID Message Pack found in a Beacon frame.
+ *
+ * Message points into the parsed frame. Message size is the size of the
+ * packed messages.
+ */
+typedef struct rid_beacon_frame {
+    const uint8_t *message;
+    size_t message_size;
+    uint8_t counter;
+} rid_beacon_frame_t;
+
+/**
+ * @brief Find Remote ID in a Beacon frame body.
+ *
+ * Skips the fixed fields and walks the information elements until the
+ * Remote ID vendor specific element. Other elements are skipped after
+ * checking the element ID only.
+ *
+ * @param body Beacon frame body following the 802.11 header.
+ * @param size Size of the body in bytes, a trailing FCS is allowed.
+ * @param frame Receives the counter and Message Pack.
+ *
+ * @retval RID_SUCCESS if a Remote ID Message Pack was found.
+ * @retval RID_ERROR_NULL_POINTER if body or frame is NULL.
+ * @retval RID_ERROR_NOT_FOUND if there is no Remote ID element.
+ * @retval RID_ERROR_INVALID_MESSAGE_TYPE if the element does not contain
+ *         a Message Pack.
+ * @retval RID_ERROR_INVALID_MESSAGE_COUNT if the Message Pack has too
+ *         many messages.
+ * @retval RID_ERROR_INVALID_MESSAGE_SIZE if the element is too short for
+ *         the Message Pack it contains.
+ */
+int rid_beacon_parse(const uint8_t *body, size_t size, rid_beacon_frame_t *frame);
+
+/**
+ * @brief Find Remote ID in a list of information elements.
+ *
+ * Same as rid_beacon_parse() but starting from the first element. Can be
+ * used with Probe Response frames or elements reported by a driver.
+ *
+ * @param elements Information elements.
+ * @param size Size of the elements in bytes.
+ * @param frame Receives the counter and Message Pack.
+ *
+ * @return Same values as rid_beacon_parse().
+ */
+int rid_beacon_parse_elements(const uint8_t *elements, size_t size, rid_beacon_frame_t *frame);
+
+/**
+ * @brief Build a Remote ID vendor specific element.
+ *
+ * @param pack Message Pack to broadcast.
+ * @param counter Message counter, incremented for each new Message Pack.
+ * @param buffer Buffer receiving the element.
+ * @param buffer_size Size of the buffer, at most RID_BEACON_MAX_SIZE
+ *        bytes are needed.
+ * @param written Optional pointer receiving the number of bytes written.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if pack or buffer is NULL.
+ * @retval RID_ERROR_INVALID_MESSAGE_COUNT if the Message Pack has too
+ *         many messages.
+ * @retval RID_ERROR_BUFFER_TOO_SMALL if buffer is too small.
+ */
+int rid_beacon_build(
+    const rid_message_pack_t *pack, uint8_t counter, uint8_t *buffer, size_t buffer_size, size_t *written
+);
+
+/**
+ * @brief Update the Remote ID element of a Beacon template in place.
+ *
+ * Replaces the Remote ID element in a Beacon frame body, or appends one
+ * if the body does not have it yet. When the Message Pack size stays the
+ * same only the counter and the messages are overwritten. Otherwise the
+ * elements following it are moved.
+ *
+ * @param body Beacon frame body following the 802.11 header.
+ * @param size Size of the body, receives the new size.
+ * @param capacity Size of the buffer holding the body.
+ * @param pack Message Pack to broadcast.
+ * @param counter Message counter, incremented for each new Message Pack.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if any pointer is NULL.
+ * @retval RID_ERROR_INVALID_MESSAGE_SIZE if the body is shorter than
+ *         the fixed fields.
+ * @retval RID_ERROR_INVALID_MESSAGE_COUNT if the Message Pack has too
+ *         many messages.
+ * @retval RID_ERROR_BUFFER_TOO_SMALL if the result does not fit the
+ *         capacity. The body is not modified.
+ */
+int rid_beacon_update(
+    uint8_t *body, size_t *size, size_t capacity, const rid_message_pack_t *pack, uint8_t counter
+);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* RID_BEACON_H */
@@ -0,0 +1,154 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of librid: https://github.com/tuupola/librid
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#ifndef RID_BLUETOOTH_H
+#define RID_BLUETOOTH_H
+
+/**
+ * @file bluetooth.h
+ * @brief Bluetooth Legacy and Long Range advertising payloads.
+ *
+ * Remote ID is broadcast as an AD structure of type Service Data with
+ * the 16-bit UUID 0xFFFA. The service data starts with the application
+ * code 0x0D and a message counter followed by a single message, or a
+ * Message Pack when using Long Range. See ASTM F3411-22a Section 5.4.
+ *
+ *     length | 0x16 | 0xFA 0xFF | 0x0D | counter | message or pack
+ *
+ * The parsers return pointers into the given payload, nothing is copied.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rid/transport.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/** @brief AD type of Service Data with a 16-bit UUID. */
+#define RID_BLUETOOTH_AD_TYPE_SERVICE_DATA 0x16
+
+/** @brief Bytes before the message: length, AD type, UUID, app code and counter. */
+#define RID_BLUETOOTH_HEADER_SIZE 6
+
+/** @brief Size of an AD structure carrying a single message. */
+#define RID_BLUETOOTH_LEGACY_SIZE 31
+
+/** @brief Size of an AD structure carrying the largest Message Pack. */
+#define RID_BLUETOOTH_MAX_SIZE 234
+
+/**
+ * @brief Remote ID message found in an advertising payload.
+ *
+ * Message points into the parsed payload and is either a single message
+ * or a Message Pack. Message size is RID_MESSAGE_SIZE for a single
+ * message and the size of the packed messages for a Message Pack.
+ */
+typedef struct rid_bluetooth_frame {
+    const uint8_t *message;
+    size_t message_size;
+    uint8_t counter;
+} rid_bluetooth_frame_t;
+
+/**
+ * @brief Find Remote ID service data in an advertising payload.
+ *
+ * Walks the AD structures of a raw advertising or scan response payload
+ * and stops at the first Remote ID service data. Other structures are
+ * skipped after checking their type so payloads which are not Remote ID
+ * are rejected quickly.
+ *
+ * @param payload Advertising payload.
+ * @param size Size of the payload in bytes.
+ * @param frame Receives pointers to the counter and message.
+ *
+ * @retval RID_SUCCESS if Remote ID service data was found.
+ * @retval RID_ERROR_NULL_POINTER if payload or frame is NULL.
+ * @retval RID_ERROR_NOT_FOUND if there is no Remote ID service data.
+ * @retval Error codes from rid_bluetooth_parse_service_data() if the
+ *         service data is malformed.
+ */
+int rid_bluetooth_parse(const uint8_t *payload, size_t size, rid_bluetooth_frame_t *frame);
+
+/**
+ * @brief Parse Remote ID service data.
+ *
+ * Same as rid_bluetooth_parse() but for the service data only, starting
+ * from the application code. This is what btmon prints and what most
+ * platform scanning APIs return for the 0xFFFA UUID.
+ *
+ * @param data Service data starting with the application code.
+ * @param size Size of the service data in bytes.
+ * @param frame Receives pointers to the counter and message.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if data or frame is NULL.
+ * @retval RID_ERROR_NOT_FOUND if the application code is not 0x0D.
+ * @retval RID_ERROR_INVALID_MESSAGE_COUNT if the Message Pack has too
+ *         many messages.
+ * @retval RID_ERROR_INVALID_MESSAGE_SIZE if the data is too short for
+ *         the message it contains or the Message Pack header has the
+ *         wrong message size.
+ */
+int rid_bluetooth_parse_service_data(const uint8_t *data, size_t size, rid_bluetooth_frame_t *frame);
+
+/**
+ * @brief Build a Remote ID AD structure.
+ *
+ * Writes a complete AD structure which can be used as the advertising
+ * payload. A single message needs RID_BLUETOOTH_LEGACY_SIZE bytes and
+ * fits a legacy advertisement. A Message Pack needs Long Range
+ * extended advertising.
+ *
+ * @param message Pointer to a message or a Message Pack.
+ * @param counter Message counter, incremented for each new message.
+ * @param buffer Buffer receiving the AD structure.
+ * @param buffer_size Size of the buffer.
+ * @param written Optional pointer receiving the number of bytes written.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if message or buffer is NULL.
+ * @retval RID_ERROR_INVALID_MESSAGE_COUNT if a Message Pack has too many
+ *         messages.
+ * @retval RID_ERROR_BUFFER_TOO_SMALL if buffer is too small.
+ */
+int rid_bluetooth_build(
+    const void *message, uint8_t counter, uint8_t *buffer, size_t buffer_size, size_t *written
+);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* RID_BLUETOOTH_H */
@@ -0,0 +1,206 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of librid: https://github.com/tuupola/librid
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#ifndef RID_DECODE_H
+#define RID_DECODE_H
+
+/**
+ * @file decode.h
+ * @brief Batch decoding of Remote ID messages.
+ *
+ * Decodes raw 25 byte messages into plain C structures in a single pass.
+ * Each decoded field holds the same value the corresponding getter would
+ * return, including the RID_XXX_INVALID sentinels.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rid/auth_page.h"
+#include "rid/basic_id.h"
+#include "rid/location.h"
+#include "rid/message.h"
+#include "rid/operator_id.h"
+#include "rid/self_id.h"
+#include "rid/system.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * @brief Decoded Basic ID message.
+ */
+typedef struct rid_decoded_basic_id {
+    rid_basic_id_type_t id_type;
+    rid_ua_type_t ua_type;
+    char uas_id[RID_UAS_ID_SIZE + 1];
+} rid_decoded_basic_id_t;
+
+/**
+ * @brief Decoded Location message.
+ */
+typedef struct rid_decoded_location {
+    rid_operational_status_t operational_status;
+    rid_height_type_t height_type;
+    uint16_t track_direction;
+    float speed;
+    float vertical_speed;
+    double latitude;
+    double longitude;
+    float pressure_altitude;
+    float geodetic_altitude;
+    float height;
+    rid_horizontal_accuracy_t horizontal_accuracy;
+    rid_vertical_accuracy_t vertical_accuracy;
+    rid_speed_accuracy_t speed_accuracy;
+    rid_vertical_accuracy_t baro_altitude_accuracy;
+    uint16_t timestamp;
+    rid_timestamp_accuracy_t timestamp_accuracy;
+} rid_decoded_location_t;
+
+/**
+ * @brief Decoded Auth message page.
+ *
+ * The last_page_index, length and timestamp fields are only set for
+ * page 0 and are zero for pages 1-15.
+ */
+typedef struct rid_decoded_auth_page {
+    uint8_t page_number;
+    rid_auth_type_t auth_type;
+    uint8_t last_page_index;
+    uint8_t length;
+    uint32_t timestamp;
+    uint8_t data_size;
+    uint8_t data[RID_AUTH_PAGE_DATA_SIZE];
+} rid_decoded_auth_page_t;
+
+/**
+ * @brief Decoded Self ID message.
+ */
+typedef struct rid_decoded_self_id {
+    rid_description_type_t description_type;
+    char description[RID_DESCRIPTION_SIZE + 1];
+} rid_decoded_self_id_t;
+
+/**
+ * @brief Decoded System message.
+ */
+typedef struct rid_decoded_system {
+    rid_operator_location_type_t operator_location_type;
+    rid_classification_type_t classification_type;
+    rid_ua_classification_category_t ua_classification_category;
+    rid_ua_classification_class_t ua_classification_class;
+    double operator_latitude;
+    double operator_longitude;
+    float operator_altitude;
+    uint16_t area_count;
+    uint16_t area_radius;
+    float area_ceiling;
+    float area_floor;
+    uint32_t timestamp;
+} rid_decoded_system_t;
+
+/**
+ * @brief Decoded Operator ID message.
+ */
+typedef struct rid_decoded_operator_id {
+    rid_operator_id_type_t id_type;
+    char operator_id[RID_OPERATOR_ID_SIZE + 1];
+} rid_decoded_operator_id_t;
+
+/**
+ * @brief Fully decoded Remote ID message.
+ *
+ * Tagged union where message_type tells which member of the message
+ * union is valid.
+ */
+typedef struct rid_decoded {
+    rid_protocol_version_t protocol_version;
+    rid_message_type_t message_type;
+    union {
+        rid_decoded_basic_id_t basic_id;
+        rid_decoded_location_t location;
+        rid_decoded_auth_page_t auth;
+        rid_decoded_self_id_t self_id;
+        rid_decoded_system_t system;
+        rid_decoded_operator_id_t operator_id;
+    } message;
+} rid_decoded_t;
+
+/**
+ * @brief Validate and decode a single Remote ID message.
+ *
+ * Known message types are decoded even when validation fails so that
+ * callers can still inspect malformed messages.
+ *
+ * @param message Pointer to a 25 byte Remote ID message.
+ * @param decoded Pointer to the structure receiving the decoded message.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if message or decoded is NULL.
+ * @retval RID_ERROR_INVALID_MESSAGE_TYPE if message is a Message Pack.
+ * @retval RID_ERROR_UNKNOWN_MESSAGE_TYPE if message type is not recognized.
+ * @retval Other error codes from rid_message_validate().
+ */
+int rid_decode_message(const void *message, rid_decoded_t *decoded);
+
+/**
+ * @brief Validate and decode an array of Remote ID messages.
+ *
+ * Messages are read sequentially from a strided buffer. Message n starts
+ * at byte offset n * stride. Pass a stride of 0 or RID_MESSAGE_SIZE for
+ * a contiguous array of rid_message_t.
+ *
+ * Message Packs must be unpacked before decoding, they are reported
+ * with RID_ERROR_INVALID_MESSAGE_TYPE.
+ *
+ * @param messages Pointer to the first message.
+ * @param stride Distance in bytes between two messages or 0.
+ * @param count Number of messages to decode.
+ * @param decoded Array of at least count decoded messages.
+ * @param errors Array of at least count error codes. Each entry receives
+ *               the same value rid_decode_message() would return.
+ *
+ * @retval RID_SUCCESS if the whole batch was processed.
+ * @retval RID_ERROR_NULL_POINTER if any of the arrays is NULL.
+ * @retval RID_ERROR_OUT_OF_RANGE if stride is smaller than RID_MESSAGE_SIZE.
+ */
+int rid_decode_batch(
+    const void *messages, size_t stride, size_t count, rid_decoded_t *decoded, int *errors
+);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* RID_DECODE_H */
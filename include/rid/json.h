@@ -0,0 +1,100 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of librid: https://github.com/tuupola/librid
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#ifndef RID_JSON_H
+#define RID_JSON_H
+
+/**
+ * @file json.h
+ * @brief Streaming JSON output.
+ *
+ * Every rid_xxx_to_json() function has a rid_xxx_to_json_sink()
+ * counterpart which writes to a sink instead of a fixed size buffer.
+ * Output is staged internally and passed to the sink in chunks, so
+ * there is no sizing pass and output is never truncated.
+ */
+
+#include <stddef.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * @brief Sink write callback.
+ *
+ * @param context User context given when creating the sink.
+ * @param data Output to write. Not NUL terminated.
+ * @param length Number of bytes to write.
+ *
+ * @return 0 on success. Any other value aborts writing and is returned
+ *         from the rid_xxx_to_json_sink() call.
+ */
+typedef int (*rid_json_write_t)(void *context, const char *data, size_t length);
+
+/**
+ * @brief Destination for streamed JSON output.
+ */
+typedef struct rid_json_sink {
+    rid_json_write_t write;
+    void *context;
+} rid_json_sink_t;
+
+/**
+ * @brief Initialize a sink with a write callback.
+ *
+ * @param sink Pointer to the sink to initialize.
+ * @param write Callback receiving the output.
+ * @param context User context passed to the callback.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if sink or write is NULL.
+ */
+int rid_json_sink_init(rid_json_sink_t *sink, rid_json_write_t write, void *context);
+
+/**
+ * @brief Initialize a sink writing to a stdio stream.
+ *
+ * @param sink Pointer to the sink to initialize.
+ * @param file Stream to write to, for example stdout.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if sink or file is NULL.
+ */
+int rid_json_sink_file(rid_json_sink_t *sink, FILE *file);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* RID_JSON_H */
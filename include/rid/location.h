@@ -44,6 +44,7 @@ SPDX-License-Identifier: MIT
 #include <float.h>
 #include <stdint.h>
 
+#include "rid/json.h"
 #include "rid/message.h"
 
 #ifdef __cplusplus
@@ -728,6 +729,39 @@ int rid_location_to_json(
     const rid_location_t *location, char *buffer, size_t buffer_size, size_t *needed_size
 );
 
+/**
+ * @brief Write a Location message as JSON to a sink.
+ *
+ * @param location Pointer to the Location message structure.
+ * @param sink Sink receiving the output.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if @p location or @p sink is NULL.
+ * @retval Other values returned by the sink write callback.
+ */
+int rid_location_to_json_sink(const rid_location_t *location, const rid_json_sink_t *sink);
+
+/**
+ * @brief Encode a Location message as CBOR.
+ *
+ * Produces the same fields as rid_location_to_json(). Numbers are encoded
+ * as integers or floats, invalid values as null. Objects and arrays
+ * use indefinite length encoding.
+ *
+ * @param location Pointer to the Location message structure.
+ * @param buffer Buffer to store the CBOR data or NULL.
+ * @param buffer_size Size of the buffer.
+ * @param needed_size If non-NULL receives the required buffer size.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if @p location is NULL or if both
+ *         @p buffer and @p needed_size are NULL.
+ * @retval RID_ERROR_BUFFER_TOO_SMALL if @p buffer is too small.
+ */
+int rid_location_to_cbor(
+    const rid_location_t *location, uint8_t *buffer, size_t buffer_size, size_t *needed_size
+);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
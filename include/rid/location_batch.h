@@ -0,0 +1,139 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of librid: https://github.com/tuupola/librid
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#ifndef RID_LOCATION_BATCH_H
+#define RID_LOCATION_BATCH_H
+
+/**
+ * @file location_batch.h
+ * @brief Columnar decoding of Location messages.
+ *
+ * Decodes many packed Location messages into a structure of arrays
+ * layout suitable for bulk analytics. Decoded values are identical to
+ * what the rid_location_get_*() getters return, including the
+ * RID_XXX_INVALID sentinels.
+ *
+ * The decoder uses SSE2 or AVX2 kernels when the library is compiled
+ * for a target which supports them and a portable scalar kernel
+ * otherwise.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * @brief Structure of arrays holding decoded Location messages.
+ *
+ * Element i of every array belongs to the same message. The arrays
+ * are carved out of caller provided storage by rid_location_batch_init().
+ */
+typedef struct rid_location_batch {
+    size_t capacity;
+    size_t count;
+    double *latitude;
+    double *longitude;
+    float *geodetic_altitude;
+    float *pressure_altitude;
+    float *height;
+    float *speed;
+    float *vertical_speed;
+    uint16_t *track_direction;
+    uint16_t *timestamp;
+} rid_location_batch_t;
+
+/**
+ * @brief Get the storage size needed for a batch of given capacity.
+ *
+ * @param capacity Number of messages the batch should hold.
+ *
+ * @return Size of the storage in bytes.
+ */
+size_t rid_location_batch_storage_size(size_t capacity);
+
+/**
+ * @brief Initialize a batch on top of caller provided storage.
+ *
+ * The storage must stay valid for the lifetime of the batch. No memory
+ * is allocated by the library.
+ *
+ * @param batch Pointer to the batch structure.
+ * @param storage Pointer to the storage.
+ * @param storage_size Size of the storage in bytes.
+ * @param capacity Number of messages the batch should hold.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if batch or storage is NULL.
+ * @retval RID_ERROR_BUFFER_TOO_SMALL if storage_size is less than
+ *         rid_location_batch_storage_size(capacity).
+ */
+int rid_location_batch_init(
+    rid_location_batch_t *batch, void *storage, size_t storage_size, size_t capacity
+);
+
+/**
+ * @brief Decode packed Location messages into a batch.
+ *
+ * Message n starts at byte offset n * stride. Pass a stride of 0 or
+ * RID_MESSAGE_SIZE for a contiguous array of rid_location_t. Messages
+ * which are not Location messages are decoded as if every field was
+ * invalid. Previous contents of the batch are replaced.
+ *
+ * @param batch Pointer to an initialized batch.
+ * @param messages Pointer to the first message.
+ * @param stride Distance in bytes between two messages or 0.
+ * @param count Number of messages to decode.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if batch or messages is NULL.
+ * @retval RID_ERROR_OUT_OF_RANGE if stride is smaller than RID_MESSAGE_SIZE.
+ * @retval RID_ERROR_BUFFER_TOO_SMALL if count exceeds batch capacity.
+ */
+int rid_location_batch_decode(
+    rid_location_batch_t *batch, const void *messages, size_t stride, size_t count
+);
+
+/**
+ * @brief Get the name of the kernel used by rid_location_batch_decode().
+ *
+ * @return "avx2", "sse2" or "scalar".
+ */
+const char *rid_location_batch_kernel(void);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* RID_LOCATION_BATCH_H */
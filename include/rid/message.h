@@ -44,6 +44,8 @@ SPDX-License-Identifier: MIT
 #include <stddef.h>
 #include <stdint.h>
 
+#include "rid/json.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
@@ -77,6 +79,11 @@ typedef enum {
     RID_ERROR_NOT_FOUND = -22,
     RID_ERROR_INVALID_MESSAGE_TYPE = -23,
     RID_ERROR_NOT_IMPLEMENTED = -24,
+    RID_ERROR_WRITE_FAILED = -25,
+    RID_ERROR_INVALID_JSON = -26,
+    RID_ERROR_INVALID_CAPTURE = -27,
+    RID_ERROR_READ_FAILED = -28,
+    RID_ERROR_INVALID_SIGNATURE = -29,
 } rid_error_t;
 
 /**
@@ -160,7 +167,8 @@ const char *rid_error_to_string(rid_error_t error);
  * @brief Validate any Remote ID message.
  *
  * Dispatches to the appropriate type-specific validation function
- * based on the message type field.
+ * based on the message type field. Authentication pages are checked
+ * with rid_auth_page_validate().
  *
  * @param message Pointer to the message structure to validate.
  *
@@ -189,6 +197,60 @@ int rid_message_validate(const void *message);
  */
 int rid_message_to_json(const void *message, char *buffer, size_t buffer_size, size_t *needed_size);
 
+/**
+ * @brief Write any Remote ID message as JSON to a sink.
+ *
+ * @param message Pointer to any Remote ID message structure.
+ * @param sink Sink receiving the output.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if @p message or @p sink is NULL.
+ * @retval Other values returned by the sink write callback.
+ */
+int rid_message_to_json_sink(const void *message, const rid_json_sink_t *sink);
+
+/**
+ * @brief Encode any Remote ID message as CBOR.
+ *
+ * Produces the same fields as rid_message_to_json(). Numbers are encoded
+ * as integers or floats, invalid values as null. Objects and arrays
+ * use indefinite length encoding.
+ *
+ * @param message Pointer to any Remote ID message structure.
+ * @param buffer Buffer to store the CBOR data or NULL.
+ * @param buffer_size Size of the buffer.
+ * @param needed_size If non-NULL receives the required buffer size.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if @p message is NULL or if both
+ *         @p buffer and @p needed_size are NULL.
+ * @retval RID_ERROR_BUFFER_TOO_SMALL if @p buffer is too small.
+ */
+int rid_message_to_cbor(const void *message, uint8_t *buffer, size_t buffer_size, size_t *needed_size);
+
+/**
+ * @brief Parse JSON written by rid_message_to_json() back into a message.
+ *
+ * Reads the object at the start of @p json in place without allocating.
+ * Values go through the setters so the result encodes the same as the
+ * original message. A null value is read as invalid or unknown. Combined
+ * authentication in a Message Pack is split back into pages.
+ *
+ * @param json JSON text, does not need to be NUL terminated.
+ * @param length Length of the JSON text.
+ * @param message Pointer to the message to fill.
+ * @param message_size Size of @p message. At least RID_MESSAGE_SIZE,
+ *        or sizeof(rid_message_pack_t) for a Message Pack.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if @p json or @p message is NULL.
+ * @retval RID_ERROR_INVALID_JSON if the text is not a message object.
+ * @retval RID_ERROR_UNKNOWN_MESSAGE_TYPE if the message type is unknown.
+ * @retval RID_ERROR_BUFFER_TOO_SMALL if @p message_size is too small.
+ * @retval Other values returned by the setters for out of range values.
+ */
+int rid_message_from_json(const char *json, size_t length, void *message, size_t message_size);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -45,6 +45,7 @@ SPDX-License-Identifier: MIT
 #include <stdint.h>
 
 #include "rid/auth.h"
+#include "rid/json.h"
 #include "rid/message.h"
 
 #ifdef __cplusplus
@@ -76,6 +77,37 @@ typedef struct __attribute__((__packed__)) rid_message_pack {
     uint8_t messages[225];
 } rid_message_pack_t;
 
+/** @brief Index value marking no message in rid_message_pack_index_t. */
+#define RID_MESSAGE_PACK_INDEX_NONE 0xFF
+
+/**
+ * @brief Per type index of the messages in a Message Pack.
+ *
+ * Built in one pass with rid_message_pack_index_build(). The messages
+ * of each type form a chain starting at first[type] and following
+ * next[] until RID_MESSAGE_PACK_INDEX_NONE. Bit (1 << type) is set in
+ * present for each type found. The index is not updated when the pack
+ * changes, build it again after modifying the pack.
+ */
+typedef struct rid_message_pack_index {
+    uint16_t present;
+    uint8_t first[16];
+    uint8_t next[RID_MESSAGE_PACK_MAX_MESSAGES];
+} rid_message_pack_index_t;
+
+/**
+ * @brief Read-only view of a Message Pack inside a received buffer.
+ *
+ * The header has been checked against the buffer length, so pack can
+ * be passed to any function taking a const rid_message_pack_t pointer.
+ * Only size bytes of pack are readable, never copy
+ * sizeof(rid_message_pack_t) from it.
+ */
+typedef struct rid_message_pack_view {
+    const rid_message_pack_t *pack;
+    size_t size;
+} rid_message_pack_view_t;
+
 /**
  * @brief Initialize a Message Pack structure.
  *
@@ -133,6 +165,38 @@ size_t rid_message_pack_size(const rid_message_pack_t *pack);
  */
 size_t rid_message_pack_messages_size(const rid_message_pack_t *pack);
 
+/**
+ * @brief Initialize a view over a Message Pack in a buffer.
+ *
+ * Checks the message type, message size and that all messages fit in
+ * the buffer. Nothing is copied, the view points into data which must
+ * outlive it. Bytes after the last message are ignored.
+ *
+ * @param view Pointer to the view to initialize.
+ * @param data Pointer to the start of the Message Pack.
+ * @param size Number of bytes available at data.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if view or data is NULL.
+ * @retval RID_ERROR_INVALID_MESSAGE_TYPE if data is not a Message Pack.
+ * @retval RID_ERROR_INVALID_MESSAGE_SIZE if the buffer is shorter than
+ *         the header and the messages, or message size is not
+ *         RID_MESSAGE_SIZE.
+ * @retval RID_ERROR_INVALID_MESSAGE_COUNT if there are too many messages.
+ */
+int rid_message_pack_view_init(rid_message_pack_view_t *view, const uint8_t *data, size_t size);
+
+/**
+ * @brief Get a pointer to the message at the specified index of a view.
+ *
+ * @param view Pointer to the view.
+ * @param index Index of the message.
+ *
+ * @return Pointer into the viewed buffer, or NULL if view is NULL or
+ *         index is out of range.
+ */
+const void *rid_message_pack_view_get_message_at(const rid_message_pack_view_t *view, uint8_t index);
+
 /**
  * @brief Get a pointer to the messages array in a Message Pack.
  *
@@ -196,6 +260,60 @@ int rid_message_pack_find_message_index_by_type(
     const rid_message_pack_t *pack, rid_message_type_t type, uint8_t start_index, uint8_t *index
 );
 
+/**
+ * @brief Build the per type index of a Message Pack.
+ *
+ * Worth it when several types are looked up in the same pack, a single
+ * lookup is cheaper with rid_message_pack_find_message_index_by_type().
+ *
+ * @param index Pointer to the index to build.
+ * @param pack Pointer to the Message Pack structure.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if index or pack is NULL.
+ * @retval RID_ERROR_INVALID_MESSAGE_COUNT if the pack has too many messages.
+ */
+int rid_message_pack_index_build(rid_message_pack_index_t *index, const rid_message_pack_t *pack);
+
+/**
+ * @brief Get the index of the first message of a type.
+ *
+ * @param index Pointer to the index.
+ * @param type The message type.
+ *
+ * @return Index of the message or RID_MESSAGE_PACK_INDEX_NONE if there is
+ *         no message of the type or index is NULL.
+ */
+uint8_t rid_message_pack_index_first(const rid_message_pack_index_t *index, rid_message_type_t type);
+
+/**
+ * @brief Get the index of the next message of the same type.
+ *
+ * @param index Pointer to the index.
+ * @param position Index of the current message.
+ *
+ * @return Index of the next message of the same type or
+ *         RID_MESSAGE_PACK_INDEX_NONE if there is none or index is NULL.
+ */
+uint8_t rid_message_pack_index_next(const rid_message_pack_index_t *index, uint8_t position);
+
+/**
+ * @brief Get Auth message from an indexed Message Pack.
+ *
+ * Same as rid_message_pack_get_auth() but only visits the Auth pages.
+ *
+ * @param pack Pointer to the Message Pack structure.
+ * @param index Index built from the pack.
+ * @param auth Pointer to the Auth structure to populate.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if any argument is NULL.
+ * @retval RID_ERROR_NOT_FOUND if no Auth message is found in the pack.
+ */
+int rid_message_pack_get_auth_indexed(
+    const rid_message_pack_t *pack, const rid_message_pack_index_t *index, rid_auth_t *auth
+);
+
 /**
  * @brief Get Auth message from a Message Pack.
  *
@@ -299,6 +417,37 @@ int rid_message_pack_sort(rid_message_pack_t *pack);
  */
 int rid_message_pack_to_json(const rid_message_pack_t *pack, char *buffer, size_t buffer_size, size_t *needed_size);
 
+/**
+ * @brief Write a Message Pack as JSON to a sink.
+ *
+ * @param pack Pointer to the Message Pack structure.
+ * @param sink Sink receiving the output.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if @p pack or @p sink is NULL.
+ * @retval Other values returned by the sink write callback.
+ */
+int rid_message_pack_to_json_sink(const rid_message_pack_t *pack, const rid_json_sink_t *sink);
+
+/**
+ * @brief Encode a Message Pack as CBOR.
+ *
+ * Produces the same fields as rid_message_pack_to_json(). Numbers are encoded
+ * as integers or floats, invalid values as null. Objects and arrays
+ * use indefinite length encoding.
+ *
+ * @param pack Pointer to the Message Pack structure.
+ * @param buffer Buffer to store the CBOR data or NULL.
+ * @param buffer_size Size of the buffer.
+ * @param needed_size If non-NULL receives the required buffer size.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if @p pack is NULL or if both
+ *         @p buffer and @p needed_size are NULL.
+ * @retval RID_ERROR_BUFFER_TOO_SMALL if @p buffer is too small.
+ */
+int rid_message_pack_to_cbor(const rid_message_pack_t *pack, uint8_t *buffer, size_t buffer_size, size_t *needed_size);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -0,0 +1,163 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of librid: https://github.com/tuupola/librid
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#ifndef RID_NAN_H
+#define RID_NAN_H
+
+/**
+ * @file nan.h
+ * @brief Wi-Fi Neighbor Awareness Networking Service Discovery Frames.
+ *
+ * Remote ID is broadcast over Wi-Fi NAN as a Message Pack inside the
+ * service specific info of a Service Descriptor Attribute. The frame is
+ * an 802.11 public action frame sent to the NAN Network ID with the NAN
+ * cluster ID as BSSID. See ASTM F3411-22a Section 5.4.
+ *
+ *     802.11 header | 0x04 0x09 | 0x50 0x6F 0x9A 0x13 |
+ *     0x03 | length | service ID | 0x01 0x00 0x10 | info length |
+ *     counter | Message Pack |
+ *     0x0E | 0x04 0x00 | 0x01 | 0x00 0x02 | counter
+ *
+ * The service ID is the first six bytes of the SHA-256 hash of the
+ * service name "org.opendroneid.remoteid". The parsers return pointers
+ * into the given frame, nothing is copied.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rid/message_pack.h"
+#include "rid/transport.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/** @brief Bytes before the Message Pack: 802.11 header, action header, attribute header and counter. */
+#define RID_NAN_HEADER_SIZE 44
+
+/** @brief Bytes after the Message Pack: Service Descriptor Extension Attribute. */
+#define RID_NAN_TRAILER_SIZE 7
+
+/** @brief Size of a frame carrying the largest Message Pack. */
+#define RID_NAN_MAX_SIZE (RID_NAN_HEADER_SIZE + RID_MESSAGE_PACK_MAX_SIZE + RID_NAN_TRAILER_SIZE)
+
+/**
+ * @brief Remote ID Message Pack found in a Service Discovery Frame.
+ *
+ * Message points into the parsed frame. Message size is the size of the
+ * packed messages. Source is the transmitter address of the frame.
+ */
+typedef struct rid_nan_frame {
+    const uint8_t *message;
+    size_t message_size;
+    rid_address_t source;
+    uint8_t counter;
+} rid_nan_frame_t;
+
+/**
+ * @brief Find Remote ID in a NAN Service Discovery Frame.
+ *
+ * Parses an 802.11 management frame starting from the frame control
+ * field, without radiotap or other capture headers. The fixed header
+ * fields are checked first so frames which are not NAN are rejected
+ * without looking further. NAN attributes are then walked until the
+ * Service Descriptor Attribute with the Remote ID service ID.
+ *
+ * @param data 802.11 frame.
+ * @param size Size of the frame in bytes, a trailing FCS is allowed.
+ * @param frame Receives the counter, source address and Message Pack.
+ *
+ * @retval RID_SUCCESS if a Remote ID Message Pack was found.
+ * @retval RID_ERROR_NULL_POINTER if data or frame is NULL.
+ * @retval RID_ERROR_NOT_FOUND if the frame is not a NAN Service
+ *         Discovery Frame or has no Remote ID service.
+ * @retval RID_ERROR_INVALID_MESSAGE_TYPE if the service info does not
+ *         contain a Message Pack.
+ * @retval RID_ERROR_INVALID_MESSAGE_COUNT if the Message Pack has too
+ *         many messages.
+ * @retval RID_ERROR_INVALID_MESSAGE_SIZE if the service info is too short
+ *         for the Message Pack it contains.
+ */
+int rid_nan_parse(const uint8_t *data, size_t size, rid_nan_frame_t *frame);
+
+/**
+ * @brief Parse Remote ID service specific info.
+ *
+ * Same as rid_nan_parse() but for the service specific info only,
+ * starting from the counter. This is what platform NAN APIs return
+ * when subscribing to the Remote ID service. Source is not touched.
+ *
+ * @param data Service specific info starting with the counter.
+ * @param size Size of the service specific info in bytes.
+ * @param frame Receives the counter and Message Pack.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if data or frame is NULL.
+ * @retval RID_ERROR_INVALID_MESSAGE_TYPE if there is no Message Pack.
+ * @retval RID_ERROR_INVALID_MESSAGE_COUNT if the Message Pack has too
+ *         many messages.
+ * @retval RID_ERROR_INVALID_MESSAGE_SIZE if the data is too short for
+ *         the Message Pack it contains.
+ */
+int rid_nan_parse_service_info(const uint8_t *data, size_t size, rid_nan_frame_t *frame);
+
+/**
+ * @brief Build a Remote ID NAN Service Discovery Frame.
+ *
+ * Writes a complete 802.11 action frame without FCS, ready to be
+ * injected. Sequence number is left zero for the driver to fill in.
+ *
+ * @param pack Message Pack to broadcast.
+ * @param counter Message counter, incremented for each new Message Pack.
+ * @param source Transmitter address.
+ * @param buffer Buffer receiving the frame.
+ * @param buffer_size Size of the buffer, at most RID_NAN_MAX_SIZE bytes
+ *        are needed.
+ * @param written Optional pointer receiving the number of bytes written.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if pack, source or buffer is NULL.
+ * @retval RID_ERROR_INVALID_MESSAGE_COUNT if the Message Pack has too
+ *         many messages.
+ * @retval RID_ERROR_BUFFER_TOO_SMALL if buffer is too small.
+ */
+int rid_nan_build(
+    const rid_message_pack_t *pack, uint8_t counter, const rid_address_t *source,
+    uint8_t *buffer, size_t buffer_size, size_t *written
+);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* RID_NAN_H */
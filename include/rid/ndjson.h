@@ -0,0 +1,178 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of librid: https://github.com/tuupola/librid
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#ifndef RID_NDJSON_H
+#define RID_NDJSON_H
+
+/**
+ * @file ndjson.h
+ * @brief Newline delimited JSON export of message streams.
+ *
+ * Writes an array of messages as one JSON object per line. Each line is
+ * the same object rid_message_to_json() would produce. When receive
+ * timestamps or source addresses are given the message is wrapped as
+ * {"received":...,"source":"...","message":{...}}.
+ *
+ * The reader goes the other way and replays such a stream back into
+ * messages one line at a time without allocating.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rid/json.h"
+#include "rid/transport.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * @brief Write an array of messages as newline delimited JSON.
+ *
+ * Message n starts at byte offset n * stride. Pass a stride of 0 or
+ * RID_MESSAGE_SIZE for a contiguous array of rid_message_t. A Message
+ * Pack is written in full only if it fits in the stride, otherwise only
+ * its protocol version and message type are written.
+ *
+ * Every line, including the last one, ends with a newline. Output is
+ * truncated if the buffer is too small. Pass NULL buffer to only query
+ * the needed size.
+ *
+ * @param messages Pointer to the first message.
+ * @param stride Distance in bytes between two messages or 0.
+ * @param count Number of messages to write.
+ * @param timestamps Optional array of count receive times, for example
+ *                   milliseconds since epoch, or NULL.
+ * @param sources Optional array of count source addresses, or NULL.
+ * @param buffer Output buffer or NULL.
+ * @param buffer_size Size of the output buffer.
+ * @param needed_size Optional pointer receiving the size needed for the
+ *                    whole output including the terminating NUL.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if messages is NULL, or both buffer and
+ *         needed_size are NULL.
+ * @retval RID_ERROR_OUT_OF_RANGE if stride is smaller than RID_MESSAGE_SIZE.
+ * @retval RID_ERROR_BUFFER_TOO_SMALL if output was truncated.
+ */
+int rid_messages_to_ndjson(
+    const void *messages, size_t stride, size_t count,
+    const uint64_t *timestamps, const rid_address_t *sources,
+    char *buffer, size_t buffer_size, size_t *needed_size
+);
+
+/**
+ * @brief Write an array of messages as newline delimited JSON to a sink.
+ *
+ * Same as rid_messages_to_ndjson() but output is streamed to a sink,
+ * for example a file or a callback appending to a growing buffer.
+ *
+ * @param messages Pointer to the first message.
+ * @param stride Distance in bytes between two messages or 0.
+ * @param count Number of messages to write.
+ * @param timestamps Optional array of count receive times or NULL.
+ * @param sources Optional array of count source addresses or NULL.
+ * @param sink Sink receiving the output.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if messages or sink is NULL.
+ * @retval RID_ERROR_OUT_OF_RANGE if stride is smaller than RID_MESSAGE_SIZE.
+ * @retval Other values returned by the sink write callback.
+ */
+int rid_messages_to_ndjson_sink(
+    const void *messages, size_t stride, size_t count,
+    const uint64_t *timestamps, const rid_address_t *sources,
+    const rid_json_sink_t *sink
+);
+
+/**
+ * @brief Reader state for replaying newline delimited JSON.
+ *
+ * Points into data owned by the caller, for example a memory mapped
+ * capture file. Nothing is copied.
+ */
+typedef struct rid_ndjson_reader {
+    const char *data;
+    size_t length;
+    size_t position;
+    size_t line;
+} rid_ndjson_reader_t;
+
+/**
+ * @brief Initialize a reader over a block of newline delimited JSON.
+ *
+ * The block should end at a line boundary. When feeding a large file in
+ * chunks pass the data up to and including the last newline and carry
+ * the rest over to the next chunk.
+ *
+ * @param reader Pointer to the reader.
+ * @param data Newline delimited JSON, does not need to be NUL terminated.
+ * @param length Length of the data.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if reader or data is NULL.
+ */
+int rid_ndjson_reader_init(rid_ndjson_reader_t *reader, const char *data, size_t length);
+
+/**
+ * @brief Read the next message from newline delimited JSON.
+ *
+ * Accepts both plain lines and lines wrapped with receive time and
+ * source address as written by rid_messages_to_ndjson(). Missing receive
+ * time and source are returned as zero. Blank lines are skipped. After
+ * an error the reader is positioned at the next line so reading can
+ * continue, reader->line holds the number of the offending line.
+ *
+ * @param reader Pointer to the reader.
+ * @param message Pointer to the message to fill.
+ * @param message_size Size of message. At least RID_MESSAGE_SIZE, or
+ *                     sizeof(rid_message_pack_t) to accept Message Packs.
+ * @param received Optional pointer receiving the receive time or NULL.
+ * @param source Optional pointer receiving the source address or NULL.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if reader or message is NULL.
+ * @retval RID_ERROR_NOT_FOUND if there are no more lines.
+ * @retval RID_ERROR_INVALID_JSON if the line is not a message object.
+ * @retval Other values returned by rid_message_from_json().
+ */
+int rid_ndjson_reader_next(
+    rid_ndjson_reader_t *reader, void *message, size_t message_size,
+    uint64_t *received, rid_address_t *source
+);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* RID_NDJSON_H */
@@ -44,6 +44,7 @@ SPDX-License-Identifier: MIT
 #include <stddef.h>
 #include <stdint.h>
 
+#include "rid/json.h"
 #include "rid/message.h"
 
 #ifdef __cplusplus
@@ -176,6 +177,37 @@ const char *rid_operator_id_type_to_string(rid_operator_id_type_t type);
  */
 int rid_operator_id_to_json(const rid_operator_id_t *message, char *buffer, size_t buffer_size, size_t *needed_size);
 
+/**
+ * @brief Write an Operator ID message as JSON to a sink.
+ *
+ * @param message Pointer to the Operator ID message structure.
+ * @param sink Sink receiving the output.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if @p message or @p sink is NULL.
+ * @retval Other values returned by the sink write callback.
+ */
+int rid_operator_id_to_json_sink(const rid_operator_id_t *message, const rid_json_sink_t *sink);
+
+/**
+ * @brief Encode an Operator ID message as CBOR.
+ *
+ * Produces the same fields as rid_operator_id_to_json(). Numbers are encoded
+ * as integers or floats, invalid values as null. Objects and arrays
+ * use indefinite length encoding.
+ *
+ * @param message Pointer to the Operator ID message structure.
+ * @param buffer Buffer to store the CBOR data or NULL.
+ * @param buffer_size Size of the buffer.
+ * @param needed_size If non-NULL receives the required buffer size.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if @p message is NULL or if both
+ *         @p buffer and @p needed_size are NULL.
+ * @retval RID_ERROR_BUFFER_TOO_SMALL if @p buffer is too small.
+ */
+int rid_operator_id_to_cbor(const rid_operator_id_t *message, uint8_t *buffer, size_t buffer_size, size_t *needed_size);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -0,0 +1,193 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of librid: https://github.com/tuupola/librid
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#ifndef RID_PACKER_H
+#define RID_PACKER_H
+
+/**
+ * @file packer.h
+ * @brief Message Pack packing within transport size budgets.
+ *
+ * The packer keeps a small pool of the latest messages of a transmitter
+ * and fills Message Packs from it. Messages updated since they were
+ * last packed go first, ordered by priority. Remaining room is filled
+ * with the other messages, highest priority and longest unsent first,
+ * so every frame is full. Room for the Auth pages can be reserved so
+ * the pack can be signed with rid_message_pack_set_auth() afterwards.
+ *
+ * Timestamps are opaque to the packer. Use any monotonic clock.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rid/message.h"
+#include "rid/message_pack.h"
+#include "rid/transport.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/** @brief Maximum number of messages in the pool. */
+#define RID_PACKER_MAX_MESSAGES 16
+
+/**
+ * @brief Pooled message, internal to the packer.
+ */
+typedef struct rid_packer_entry {
+    rid_message_t message;
+    uint8_t priority;
+    uint8_t pending;
+    uint64_t updated;
+    uint64_t packed;
+} rid_packer_entry_t;
+
+/**
+ * @brief Message Pack packer.
+ */
+typedef struct rid_packer {
+    rid_transport_t transport;
+    uint8_t max_messages;
+    uint8_t auth_pages;
+    uint8_t count;
+    rid_packer_entry_t entries[RID_PACKER_MAX_MESSAGES];
+} rid_packer_t;
+
+/**
+ * @brief Initialize a packer for a transport.
+ *
+ * @param packer Pointer to the packer to initialize.
+ * @param transport Transport the packs are sent on.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if packer is NULL.
+ * @retval RID_ERROR_OUT_OF_RANGE if the transport is unknown or its
+ *         payload cannot hold a Message Pack, ie. Bluetooth Legacy.
+ */
+int rid_packer_init(rid_packer_t *packer, rid_transport_t transport);
+
+/**
+ * @brief Remove all messages from the pool.
+ *
+ * @param packer Pointer to the packer.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if packer is NULL.
+ */
+int rid_packer_clear(rid_packer_t *packer);
+
+/**
+ * @brief Reserve room for Auth pages in every pack.
+ *
+ * @param packer Pointer to the packer.
+ * @param pages Number of pages, 0 when signing is off.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if packer is NULL.
+ * @retval RID_ERROR_OUT_OF_RANGE if no room would be left for other
+ *         messages.
+ */
+int rid_packer_set_auth_pages(rid_packer_t *packer, uint8_t pages);
+
+/**
+ * @brief Get the number of messages which fit in one pack.
+ *
+ * @param packer Pointer to the packer.
+ *
+ * @return Number of messages excluding the reserved Auth pages or 0 if
+ *         packer is NULL.
+ */
+uint8_t rid_packer_get_capacity(const rid_packer_t *packer);
+
+/**
+ * @brief Add or update a message in the pool.
+ *
+ * Replaces the pooled message of the same type. Basic ID messages are
+ * replaced only when the ID type matches, so both a serial number and
+ * a registration ID can be sent. The message is pending until packed.
+ *
+ * @param packer Pointer to the packer.
+ * @param message Pointer to the message, any type except Auth and
+ *                Message Pack.
+ * @param priority Higher priority messages are packed first.
+ * @param now Update timestamp.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if packer or message is NULL.
+ * @retval RID_ERROR_INVALID_MESSAGE_TYPE if the message type is not supported.
+ * @retval RID_ERROR_BUFFER_TOO_SMALL if the pool is full.
+ */
+int rid_packer_add_message(rid_packer_t *packer, const void *message, uint8_t priority, uint64_t now);
+
+/**
+ * @brief Remove messages not updated since given time.
+ *
+ * @param packer Pointer to the packer.
+ * @param older_than Messages updated before this are removed.
+ *
+ * @return Number of removed messages.
+ */
+size_t rid_packer_expire(rid_packer_t *packer, uint64_t older_than);
+
+/**
+ * @brief Get the number of messages not packed since their last update.
+ *
+ * Call rid_packer_build() until this returns 0 to send every update.
+ *
+ * @param packer Pointer to the packer.
+ *
+ * @return Number of pending messages or 0 if packer is NULL.
+ */
+size_t rid_packer_pending(const rid_packer_t *packer);
+
+/**
+ * @brief Build the next Message Pack.
+ *
+ * Fills the pack with up to rid_packer_get_capacity() messages, sorted
+ * by message type, and marks them packed.
+ *
+ * @param packer Pointer to the packer.
+ * @param pack Pointer to the pack to build.
+ * @param now Current time.
+ *
+ * @return Number of messages in the pack, or a negative error code.
+ * @retval RID_ERROR_NULL_POINTER if packer or pack is NULL.
+ * @retval RID_ERROR_NOT_FOUND if the pool is empty.
+ */
+int rid_packer_build(rid_packer_t *packer, rid_message_pack_t *pack, uint64_t now);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* RID_PACKER_H */
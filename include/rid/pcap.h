@@ -0,0 +1,210 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of librid: https://github.com/tuupola/librid
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#ifndef RID_PCAP_H
+#define RID_PCAP_H
+
+/**
+ * @file pcap.h
+ * @brief Remote ID from pcap and pcapng capture files.
+ *
+ * Reads capture files from monitor mode Wi-Fi and Bluetooth LE sniffers
+ * and returns the Remote ID messages found in them. The reader works on
+ * a file mapped to memory or any other buffer and returns pointers into
+ * it, nothing is copied or allocated.
+ *
+ * Supported link types are raw 802.11 (105), 802.11 with radiotap (127),
+ * Bluetooth LE link layer (251) and Bluetooth LE link layer with
+ * pseudo header (256). Remote ID is looked for in Beacon and NAN action
+ * frames and in legacy and extended advertising PDUs.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rid/transport.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/** @brief Maximum number of pcapng interfaces per section. */
+#define RID_PCAP_MAX_INTERFACES 16
+
+/** @name Link Types
+ *  @{
+ */
+#define RID_PCAP_LINKTYPE_IEEE802_11 105
+#define RID_PCAP_LINKTYPE_IEEE802_11_RADIOTAP 127
+#define RID_PCAP_LINKTYPE_BLUETOOTH_LE_LL 251
+#define RID_PCAP_LINKTYPE_BLUETOOTH_LE_LL_WITH_PHDR 256
+/** @} */
+
+/**
+ * @brief Remote ID message found in a captured packet.
+ *
+ * Message points into the capture. It is a single message for Bluetooth
+ * Legacy and a Message Pack for the other transports. Message size is
+ * RID_MESSAGE_SIZE for a single message and the size of the packed
+ * messages for a Message Pack. Timestamp is the capture time in
+ * microseconds since the Unix epoch. Source is the Bluetooth advertiser
+ * address or Wi-Fi transmitter address, all zero if the packet does not
+ * have one.
+ */
+typedef struct rid_pcap_record {
+    const uint8_t *message;
+    size_t message_size;
+    uint64_t timestamp;
+    rid_address_t source;
+    rid_transport_t transport;
+    uint8_t counter;
+} rid_pcap_record_t;
+
+/**
+ * @brief Capture file reader state.
+ *
+ * Reads the range from position to end of the capture. All members are
+ * private, the structure can be copied.
+ */
+typedef struct rid_pcap_reader {
+    const uint8_t *data;
+    size_t position;
+    size_t end;
+    uint8_t pcapng;
+    uint8_t swapped;
+    uint8_t interface_count;
+    uint32_t snaplen;
+    uint32_t link_types[RID_PCAP_MAX_INTERFACES];
+    uint8_t resolutions[RID_PCAP_MAX_INTERFACES];
+} rid_pcap_reader_t;
+
+/**
+ * @brief Capture file mapped to memory.
+ */
+typedef struct rid_pcap_mapping {
+    const uint8_t *data;
+    size_t size;
+} rid_pcap_mapping_t;
+
+/**
+ * @brief Map a capture file to memory.
+ *
+ * The file is mapped read only and the kernel is told it will be read
+ * sequentially. Only available on POSIX systems.
+ *
+ * @param mapping Receives the address and size of the mapping.
+ * @param path Path to the file.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if mapping or path is NULL.
+ * @retval RID_ERROR_READ_FAILED if the file can not be opened or mapped,
+ *         or is empty.
+ * @retval RID_ERROR_NOT_IMPLEMENTED if memory mapping is not supported.
+ */
+int rid_pcap_map(rid_pcap_mapping_t *mapping, const char *path);
+
+/**
+ * @brief Unmap a capture file mapped with rid_pcap_map().
+ *
+ * @param mapping Mapping to release.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if mapping is NULL.
+ * @retval RID_ERROR_NOT_IMPLEMENTED if memory mapping is not supported.
+ */
+int rid_pcap_unmap(rid_pcap_mapping_t *mapping);
+
+/**
+ * @brief Initialize a reader for a capture in memory.
+ *
+ * Detects pcap or pcapng format and byte order from the file header.
+ * For pcapng the interface descriptions at the start of the file are
+ * read as well.
+ *
+ * @param reader Reader to initialize.
+ * @param data Capture file contents.
+ * @param size Size of the capture.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if reader or data is NULL.
+ * @retval RID_ERROR_INVALID_CAPTURE if the data is not a pcap or pcapng
+ *         file.
+ */
+int rid_pcap_reader_init(rid_pcap_reader_t *reader, const uint8_t *data, size_t size);
+
+/**
+ * @brief Return the next Remote ID message.
+ *
+ * Packets without Remote ID and packets of unsupported link types are
+ * skipped.
+ *
+ * @param reader Reader state.
+ * @param record Receives the message, timestamp, source and transport.
+ *
+ * @retval RID_SUCCESS if a message was found.
+ * @retval RID_ERROR_NULL_POINTER if reader or record is NULL.
+ * @retval RID_ERROR_NOT_FOUND at the end of the capture.
+ * @retval RID_ERROR_INVALID_CAPTURE if a record runs past the end of the
+ *         capture or is otherwise corrupt. Reading stops.
+ */
+int rid_pcap_reader_next(rid_pcap_reader_t *reader, rid_pcap_record_t *record);
+
+/**
+ * @brief Split a capture into chunks for scanning in parallel.
+ *
+ * Cuts the remaining capture into about equally sized chunks at record
+ * boundaries. Each chunk is a reader of its own and can be used from a
+ * different thread. Boundaries are found by checking that several
+ * consecutive record headers are consistent, the capture is not read
+ * from the start. Interface descriptions are taken from the given
+ * reader, so a pcapng file where interfaces are described after the
+ * first packet should be read with a single reader.
+ *
+ * @param reader Initialized reader.
+ * @param chunks Array receiving the chunk readers.
+ * @param count Number of chunks wanted.
+ * @param chunk_count Receives the number of chunks created. Can be less
+ *        than count for small captures.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if any pointer is NULL.
+ * @retval RID_ERROR_OUT_OF_RANGE if count is zero.
+ */
+int rid_pcap_reader_split(
+    const rid_pcap_reader_t *reader, rid_pcap_reader_t *chunks, size_t count, size_t *chunk_count
+);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* RID_PCAP_H */
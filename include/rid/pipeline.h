@@ -0,0 +1,282 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of librid: https://github.com/tuupola/librid
+
+SPDX-License-Identifier: MIT
+
+*/
+
+
+#ifndef RID_PIPELINE_H
+#define RID_PIPELINE_H
+
+/**
+ * @file pipeline.h
+ * @brief Multi-threaded processing of captured messages.
+ *
+ * The pipeline has three stages. A single reader pushes captured
+ * messages, N workers process them and a single output stage collects
+ * the results either in the order they were pushed or as soon as they
+ * are ready. Messages are sharded by source address so each worker owns
+ * the tracker of a disjoint set of aircraft and workers never share
+ * state.
+ *
+ * Stages are connected with lock-free single producer single consumer
+ * ring buffers. The pipeline does not create threads. Call
+ * rid_pipeline_push() from the reader thread, rid_pipeline_work() from
+ * one thread per worker and rid_pipeline_collect() from the output
+ * thread. All storage is provided by the caller and nothing is
+ * allocated.
+ *
+ * Messages are not copied, the memory they point to, for example a
+ * mapped capture file, must stay valid until they have been collected.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rid/pcap.h"
+#include "rid/tracker.h"
+#include "rid/transport.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/** @brief Maximum number of workers. */
+#define RID_PIPELINE_MAX_WORKERS 64
+
+/** @brief Maximum number of items in a ring buffer between two stages. */
+#define RID_PIPELINE_MAX_CAPACITY 0x1000000
+
+/**
+ * @brief Order in which the output stage returns items.
+ */
+typedef enum {
+    RID_PIPELINE_UNORDERED = 0,
+    RID_PIPELINE_ORDERED = 1,
+} rid_pipeline_mode_t;
+
+/**
+ * @brief Message passing through the pipeline.
+ *
+ * Sequence is the number of messages pushed before this one. Status is
+ * the result of updating the tracker, or the value returned by the
+ * callback if one is set.
+ */
+typedef struct rid_pipeline_item {
+    rid_pcap_record_t record;
+    uint64_t sequence;
+    int status;
+} rid_pipeline_item_t;
+
+/**
+ * @brief Callback run by the worker for each message.
+ *
+ * Called after the message has been stored to the tracker of the worker.
+ * Use it for work which should run in parallel, for example formatting
+ * JSON. The callback is called from several threads at the same time,
+ * but never for the same tracker.
+ *
+ * @param context User provided context.
+ * @param tracker Tracker of the worker.
+ * @param item Message being processed. Status holds the tracker result.
+ *
+ * @return Value stored as the status of the item.
+ */
+typedef int (*rid_pipeline_callback_t)(void *context, rid_tracker_t *tracker, rid_pipeline_item_t *item);
+
+struct rid_pipeline_worker;
+struct rid_pipeline_shared;
+
+/**
+ * @brief Pipeline state.
+ *
+ * All members are private. Members changing while the pipeline runs
+ * are kept in the storage, each on its own cache line.
+ */
+typedef struct rid_pipeline {
+    size_t worker_count;
+    size_t capacity;
+    rid_pipeline_mode_t mode;
+    rid_pipeline_callback_t callback;
+    void *context;
+    struct rid_pipeline_worker *workers;
+    struct rid_pipeline_shared *shared;
+    uint8_t *order;
+    size_t order_mask;
+} rid_pipeline_t;
+
+/**
+ * @brief Get the storage size needed for a pipeline.
+ *
+ * @param worker_count Number of workers.
+ * @param capacity Number of items in each ring buffer, a power of two.
+ * @param tracker_capacity Maximum number of aircraft per worker.
+ *
+ * @return Size of the storage in bytes or 0 if an argument is out of
+ *         range.
+ */
+size_t rid_pipeline_storage_size(size_t worker_count, size_t capacity, size_t tracker_capacity);
+
+/**
+ * @brief Initialize a pipeline using caller provided storage.
+ *
+ * @param pipeline Pointer to the pipeline to initialize.
+ * @param storage Storage for the ring buffers and trackers.
+ * @param storage_size Size of the storage in bytes.
+ * @param worker_count Number of workers, 1 to RID_PIPELINE_MAX_WORKERS.
+ * @param capacity Number of items in each ring buffer, a power of two
+ *        up to RID_PIPELINE_MAX_CAPACITY.
+ * @param tracker_capacity Maximum number of aircraft per worker.
+ * @param mode Whether items are collected in order.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if pipeline or storage is NULL.
+ * @retval RID_ERROR_OUT_OF_RANGE if an argument is out of range.
+ * @retval RID_ERROR_BUFFER_TOO_SMALL if storage is too small.
+ */
+int rid_pipeline_init(
+    rid_pipeline_t *pipeline, void *storage, size_t storage_size, size_t worker_count, size_t capacity,
+    size_t tracker_capacity, rid_pipeline_mode_t mode
+);
+
+/**
+ * @brief Set the callback run by the workers.
+ *
+ * Must be called before the pipeline is started.
+ *
+ * @param pipeline Pointer to the pipeline.
+ * @param callback Callback or NULL to only update the trackers.
+ * @param context Passed to the callback.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if pipeline is NULL.
+ */
+int rid_pipeline_set_callback(rid_pipeline_t *pipeline, rid_pipeline_callback_t callback, void *context);
+
+/**
+ * @brief Push a message to the worker owning its source address.
+ *
+ * Reader stage, call from a single thread.
+ *
+ * @param pipeline Pointer to the pipeline.
+ * @param record Captured message.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if pipeline or record is NULL.
+ * @retval RID_ERROR_BUFFER_TOO_SMALL if the worker is busy. Try again
+ *         later.
+ */
+int rid_pipeline_push(rid_pipeline_t *pipeline, const rid_pcap_record_t *record);
+
+/**
+ * @brief Tell the other stages no more messages will be pushed.
+ *
+ * Reader stage, call after the last rid_pipeline_push().
+ *
+ * @param pipeline Pointer to the pipeline.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if pipeline is NULL.
+ */
+int rid_pipeline_close(rid_pipeline_t *pipeline);
+
+/**
+ * @brief Process pending messages of a worker.
+ *
+ * Worker stage, call from one thread per worker.
+ *
+ * @param pipeline Pointer to the pipeline.
+ * @param worker Index of the worker.
+ * @param max Maximum number of messages to process.
+ *
+ * @return Number of processed messages, zero if there was nothing to do.
+ * @retval RID_ERROR_NOT_FOUND if the pipeline is closed and the worker
+ *         has processed everything.
+ * @retval RID_ERROR_NULL_POINTER if pipeline is NULL.
+ * @retval RID_ERROR_OUT_OF_RANGE if worker is out of range.
+ */
+int rid_pipeline_work(rid_pipeline_t *pipeline, size_t worker, size_t max);
+
+/**
+ * @brief Collect processed messages.
+ *
+ * Output stage, call from a single thread. In ordered mode items are
+ * returned in the order they were pushed.
+ *
+ * @param pipeline Pointer to the pipeline.
+ * @param items Array receiving the items.
+ * @param count Size of the array.
+ *
+ * @return Number of collected items, zero if none were ready.
+ * @retval RID_ERROR_NOT_FOUND if the pipeline is closed and every item
+ *         has been collected.
+ * @retval RID_ERROR_NULL_POINTER if pipeline or items is NULL.
+ */
+int rid_pipeline_collect(rid_pipeline_t *pipeline, rid_pipeline_item_t *items, size_t count);
+
+/**
+ * @brief Get the worker owning a source address.
+ *
+ * @param pipeline Pointer to the pipeline.
+ * @param address Source address.
+ *
+ * @return Index of the worker or 0 if an argument is NULL.
+ */
+size_t rid_pipeline_worker(const rid_pipeline_t *pipeline, const rid_address_t *address);
+
+/**
+ * @brief Get the tracker of a worker.
+ *
+ * The tracker must only be accessed from the worker thread, or after
+ * the worker has finished.
+ *
+ * @param pipeline Pointer to the pipeline.
+ * @param worker Index of the worker.
+ *
+ * @return Pointer to the tracker or NULL if worker is out of range.
+ */
+rid_tracker_t *rid_pipeline_tracker(rid_pipeline_t *pipeline, size_t worker);
+
+/**
+ * @brief Find an aircraft from the tracker of the worker owning it.
+ *
+ * Same rules apply as for rid_pipeline_tracker().
+ *
+ * @param pipeline Pointer to the pipeline.
+ * @param address Source address.
+ *
+ * @return Pointer to the aircraft or NULL if not found.
+ */
+const rid_aircraft_t *rid_pipeline_find(rid_pipeline_t *pipeline, const rid_address_t *address);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* RID_PIPELINE_H */
@@ -43,14 +43,31 @@ extern "C" {
 #endif /* __cplusplus */
 
 #include "rid/auth.h"
+#include "rid/auth_cache.h"
+#include "rid/auth_queue.h"
 #include "rid/auth_page.h"
+#include "rid/auth_reassembler.h"
+#include "rid/auth_signer.h"
 #include "rid/basic_id.h"
+#include "rid/beacon.h"
+#include "rid/bluetooth.h"
+#include "rid/decode.h"
+#include "rid/json.h"
 #include "rid/location.h"
+#include "rid/location_batch.h"
 #include "rid/message.h"
 #include "rid/message_pack.h"
+#include "rid/nan.h"
+#include "rid/ndjson.h"
 #include "rid/operator_id.h"
+#include "rid/packer.h"
+#include "rid/pcap.h"
+#include "rid/pipeline.h"
+#include "rid/ring.h"
+#include "rid/scheduler.h"
 #include "rid/self_id.h"
 #include "rid/system.h"
+#include "rid/tracker.h"
 #include "rid/transport.h"
 #include "rid/version.h"
 
@@ -0,0 +1,189 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of librid: https://github.com/tuupola/librid
+
+SPDX-License-Identifier: MIT
+
+*/
+
+
+#ifndef RID_RING_H
+#define RID_RING_H
+
+/**
+ * @file ring.h
+ * @brief Lock-free ring buffer for passing messages between threads.
+ *
+ * A bounded queue of either single 25 byte messages or Message Packs,
+ * meant for handing received messages from radio threads to processing
+ * threads. There can be one or several producers and a single consumer.
+ * Storage is provided by the caller and nothing is allocated.
+ *
+ * Each slot starts on a cache line of its own so producers and the
+ * consumer never write to the same cache line unless they work on the
+ * same slot. Pushing and popping copies a message with one fixed size
+ * memcpy.
+ *
+ * Uses C11 atomics. On ESP-IDF, where some targets have no atomic
+ * instructions, shared counters are accessed in a critical section.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/** @brief Alignment of the slots. */
+#define RID_RING_CACHE_LINE 64
+
+/** @brief Size of a slot holding a single message. */
+#define RID_RING_MESSAGE_SLOT_SIZE 64
+
+/** @brief Size of a slot holding a Message Pack. */
+#define RID_RING_MESSAGE_PACK_SLOT_SIZE 256
+
+/** @brief Maximum number of slots in a ring buffer. */
+#define RID_RING_MAX_CAPACITY 0x1000000
+
+/**
+ * @brief What the slots of a ring buffer hold.
+ */
+typedef enum {
+    RID_RING_MESSAGE = 0,
+    RID_RING_MESSAGE_PACK = 1,
+} rid_ring_type_t;
+
+/**
+ * @brief Number of threads pushing to a ring buffer.
+ */
+typedef enum {
+    RID_RING_SINGLE_PRODUCER = 0,
+    RID_RING_MULTI_PRODUCER = 1,
+} rid_ring_producer_t;
+
+struct rid_ring_counters;
+
+/**
+ * @brief Ring buffer state.
+ *
+ * All members are private. Counters are kept in the storage, the
+ * producer and consumer counters on separate cache lines.
+ */
+typedef struct rid_ring {
+    uint8_t *slots;
+    size_t capacity;
+    size_t slot_size;
+    rid_ring_type_t type;
+    rid_ring_producer_t producer;
+    struct rid_ring_counters *counters;
+} rid_ring_t;
+
+/**
+ * @brief Get the storage size needed for a ring buffer.
+ *
+ * @param type Whether slots hold messages or Message Packs.
+ * @param capacity Number of slots, a power of two.
+ *
+ * @return Size of the storage in bytes or 0 if an argument is out of
+ *         range.
+ */
+size_t rid_ring_storage_size(rid_ring_type_t type, size_t capacity);
+
+/**
+ * @brief Initialize a ring buffer using caller provided storage.
+ *
+ * @param ring Pointer to the ring buffer to initialize.
+ * @param storage Storage for the slots and counters.
+ * @param storage_size Size of the storage in bytes.
+ * @param type Whether slots hold messages or Message Packs.
+ * @param capacity Number of slots, a power of two up to
+ *        RID_RING_MAX_CAPACITY.
+ * @param producer Whether more than one thread pushes.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if ring or storage is NULL.
+ * @retval RID_ERROR_OUT_OF_RANGE if an argument is out of range.
+ * @retval RID_ERROR_BUFFER_TOO_SMALL if storage is too small.
+ */
+int rid_ring_init(
+    rid_ring_t *ring, void *storage, size_t storage_size, rid_ring_type_t type, size_t capacity,
+    rid_ring_producer_t producer
+);
+
+/**
+ * @brief Push messages to the ring buffer.
+ *
+ * Pushes as many messages as there are free slots. With
+ * RID_RING_MESSAGE the messages are an array of 25 byte messages, with
+ * RID_RING_MESSAGE_PACK an array of rid_message_pack_t. Pushing stops at
+ * the first Message Pack with too many messages.
+ *
+ * @param ring Pointer to the ring buffer.
+ * @param messages Messages to push.
+ * @param count Number of messages.
+ *
+ * @return Number of pushed messages, zero if the ring buffer is full.
+ * @retval RID_ERROR_NULL_POINTER if ring or messages is NULL.
+ * @retval RID_ERROR_INVALID_MESSAGE_COUNT if the first Message Pack has
+ *         too many messages.
+ */
+int rid_ring_push(rid_ring_t *ring, const void *messages, size_t count);
+
+/**
+ * @brief Pop messages from the ring buffer.
+ *
+ * Call from a single consumer thread. Messages are in the same format as
+ * for rid_ring_push().
+ *
+ * @param ring Pointer to the ring buffer.
+ * @param messages Array receiving the messages.
+ * @param count Size of the array.
+ *
+ * @return Number of popped messages, zero if the ring buffer is empty.
+ * @retval RID_ERROR_NULL_POINTER if ring or messages is NULL.
+ */
+int rid_ring_pop(rid_ring_t *ring, void *messages, size_t count);
+
+/**
+ * @brief Get the number of messages in the ring buffer.
+ *
+ * The count can be out of date by the time it is returned if other
+ * threads are pushing or popping.
+ *
+ * @param ring Pointer to the ring buffer.
+ *
+ * @return Number of messages or 0 if ring is NULL.
+ */
+size_t rid_ring_count(const rid_ring_t *ring);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* RID_RING_H */
@@ -0,0 +1,314 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of librid: https://github.com/tuupola/librid
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#ifndef RID_SCHEDULER_H
+#define RID_SCHEDULER_H
+
+/**
+ * @file scheduler.h
+ * @brief Broadcast scheduling for many transmitted aircraft.
+ *
+ * The scheduler keeps the latest message of each type for every
+ * aircraft and decides which frame is sent next on one transport. Each
+ * aircraft is an index from 0 to capacity - 1 chosen by the caller.
+ *
+ * Bluetooth Legacy sends one message per frame, so every message type
+ * of every aircraft is scheduled separately at its own interval. Other
+ * transports send all messages of an aircraft in a Message Pack at the
+ * Location interval. Auth pages which do not fit the pack are rotated
+ * over consecutive packs.
+ *
+ * Due frames are kept in a binary min-heap carved out of caller
+ * provided storage. Emitting a frame and adding or updating a message
+ * take O(log n) time and never allocate.
+ *
+ * Timestamps are in milliseconds from any monotonic clock.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rid/auth.h"
+#include "rid/message.h"
+#include "rid/message_pack.h"
+#include "rid/transport.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/** @brief Number of message types scheduled per aircraft (Basic ID to Operator ID). */
+#define RID_SCHEDULER_MESSAGE_TYPES 6
+
+/** @brief Number of message slots per aircraft, the message types and a second Basic ID. */
+#define RID_SCHEDULER_MESSAGE_SLOTS 7
+
+/** @brief Slot of a Basic ID whose ID type differs from the one in the Basic ID slot. */
+#define RID_SCHEDULER_SECOND_BASIC_ID 6
+
+/** @brief Maximum number of aircraft a scheduler can hold. */
+#define RID_SCHEDULER_MAX_CAPACITY 0x0FFFFFFF
+
+/** @brief Default Location interval in milliseconds, at least 1 Hz per ASTM F3411-22a. */
+#define RID_SCHEDULER_DYNAMIC_INTERVAL 1000
+
+/** @brief Default interval of the other messages in milliseconds, at least every 3 s. */
+#define RID_SCHEDULER_STATIC_INTERVAL 3000
+
+/**
+ * @brief Messages of a single aircraft.
+ *
+ * The message array is indexed by rid_message_type_t, the AUTH entry is
+ * unused and the pages are kept in auth instead. A Basic ID with another
+ * ID type than the first one is kept in RID_SCHEDULER_SECOND_BASIC_ID.
+ * A message is only valid if the corresponding bit (1 << slot) is set in
+ * present.
+ *
+ * The counter array holds the next message counter of each stream. On
+ * Bluetooth Legacy it is indexed by rid_message_type_t, Auth pages and
+ * both Basic IDs share one counter. On Message Pack transports only
+ * counter[0] is used.
+ */
+typedef struct rid_scheduled_aircraft {
+    uint16_t present;
+    uint8_t counter[RID_SCHEDULER_MESSAGE_TYPES];
+    uint8_t auth_page;
+    rid_message_t message[RID_SCHEDULER_MESSAGE_SLOTS];
+    rid_auth_t auth;
+} rid_scheduled_aircraft_t;
+
+/**
+ * @brief Heap entry, internal to the scheduler.
+ */
+typedef struct rid_scheduler_entry {
+    uint64_t due;
+    uint32_t stream;
+} rid_scheduler_entry_t;
+
+/**
+ * @brief Broadcast scheduler.
+ */
+typedef struct rid_scheduler {
+    size_t capacity;
+    size_t count;
+    rid_transport_t transport;
+    uint8_t streams;
+    uint32_t interval[RID_SCHEDULER_MESSAGE_TYPES];
+    rid_scheduled_aircraft_t *aircraft;
+    rid_scheduler_entry_t *heap;
+    uint32_t *position;
+} rid_scheduler_t;
+
+/**
+ * @brief A frame ready to be sent.
+ *
+ * Data holds a single message on Bluetooth Legacy and a Message Pack
+ * on the other transports. It can be passed as is to
+ * rid_bluetooth_build(), rid_nan_build() or rid_beacon_build().
+ *
+ * Counter steps by one per frame of the same stream and wraps at 255.
+ * On Bluetooth Legacy each message type has its own counter, the same
+ * way receivers track it per type. On the other transports it counts
+ * the Message Packs of the aircraft.
+ */
+typedef struct rid_scheduler_frame {
+    uint32_t aircraft;
+    rid_message_type_t type;
+    uint8_t counter;
+    uint64_t due;
+    size_t size;
+    uint8_t data[RID_MESSAGE_PACK_MAX_SIZE];
+} rid_scheduler_frame_t;
+
+/**
+ * @brief Get the storage size needed for a scheduler.
+ *
+ * @param transport Transport the frames are sent on.
+ * @param capacity Number of aircraft.
+ *
+ * @return Size of the storage in bytes or 0 if an argument is out of range.
+ */
+size_t rid_scheduler_storage_size(rid_transport_t transport, size_t capacity);
+
+/**
+ * @brief Initialize a scheduler using caller provided storage.
+ *
+ * Intervals are set to RID_SCHEDULER_DYNAMIC_INTERVAL for Location and
+ * RID_SCHEDULER_STATIC_INTERVAL for the other messages.
+ *
+ * @param scheduler Pointer to the scheduler to initialize.
+ * @param storage Storage for aircraft records and the heap.
+ * @param storage_size Size of the storage in bytes.
+ * @param transport Transport the frames are sent on.
+ * @param capacity Number of aircraft.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if scheduler or storage is NULL.
+ * @retval RID_ERROR_OUT_OF_RANGE if transport is unknown or capacity is
+ *         zero or larger than RID_SCHEDULER_MAX_CAPACITY.
+ * @retval RID_ERROR_BUFFER_TOO_SMALL if storage is too small.
+ */
+int rid_scheduler_init(
+    rid_scheduler_t *scheduler, void *storage, size_t storage_size, rid_transport_t transport, size_t capacity
+);
+
+/**
+ * @brief Remove all aircraft and pending frames.
+ *
+ * @param scheduler Pointer to the scheduler.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if scheduler is NULL.
+ */
+int rid_scheduler_clear(rid_scheduler_t *scheduler);
+
+/**
+ * @brief Set the broadcast interval of a message type.
+ *
+ * The new interval is used from the next frame of each aircraft on. On
+ * transports using Message Packs the Location interval is the pack
+ * interval. The Auth interval is the time to send all pages.
+ *
+ * @param scheduler Pointer to the scheduler.
+ * @param type Message type from Basic ID to Operator ID.
+ * @param interval Interval in milliseconds.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if scheduler is NULL.
+ * @retval RID_ERROR_OUT_OF_RANGE if type is out of range or interval is zero.
+ */
+int rid_scheduler_set_interval(rid_scheduler_t *scheduler, rid_message_type_t type, uint32_t interval);
+
+/**
+ * @brief Set a message of an aircraft.
+ *
+ * Replaces the previous message of the same type. Basic IDs replace the
+ * one with the same ID type, up to two Basic IDs with different ID types
+ * are broadcast. The first message of a type, or of the aircraft on
+ * Message Pack transports, is due at once.
+ *
+ * @param scheduler Pointer to the scheduler.
+ * @param aircraft Aircraft index.
+ * @param message Pointer to the message, any type except Auth and
+ *                Message Pack.
+ * @param now Current time.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if scheduler or message is NULL.
+ * @retval RID_ERROR_OUT_OF_RANGE if aircraft is not below capacity.
+ * @retval RID_ERROR_INVALID_MESSAGE_TYPE if the message type is not supported.
+ * @retval RID_ERROR_BUFFER_TOO_SMALL if the aircraft already has two Basic
+ *         IDs with other ID types.
+ */
+int rid_scheduler_set_message(rid_scheduler_t *scheduler, uint32_t aircraft, const void *message, uint64_t now);
+
+/**
+ * @brief Set the authentication pages of an aircraft.
+ *
+ * @param scheduler Pointer to the scheduler.
+ * @param aircraft Aircraft index.
+ * @param auth Pointer to the authentication data.
+ * @param now Current time.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if scheduler or auth is NULL.
+ * @retval RID_ERROR_OUT_OF_RANGE if aircraft is not below capacity.
+ * @retval Any return value of rid_auth_validate().
+ */
+int rid_scheduler_set_auth(rid_scheduler_t *scheduler, uint32_t aircraft, const rid_auth_t *auth, uint64_t now);
+
+/**
+ * @brief Stop broadcasting an aircraft and forget its messages.
+ *
+ * @param scheduler Pointer to the scheduler.
+ * @param aircraft Aircraft index.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if scheduler is NULL.
+ * @retval RID_ERROR_OUT_OF_RANGE if aircraft is not below capacity.
+ * @retval RID_ERROR_NOT_FOUND if the aircraft has no messages.
+ */
+int rid_scheduler_remove(rid_scheduler_t *scheduler, uint32_t aircraft);
+
+/**
+ * @brief Get the next due frame.
+ *
+ * The earliest frame due at or before now is written to frame and
+ * scheduled again one interval later. When the caller has fallen more
+ * than one interval behind the next frame is scheduled one interval
+ * from now instead of sending the missed frames in a burst.
+ *
+ * @param scheduler Pointer to the scheduler.
+ * @param now Current time.
+ * @param frame Pointer receiving the frame.
+ *
+ * @retval RID_SUCCESS if a frame was written.
+ * @retval RID_ERROR_NULL_POINTER if scheduler or frame is NULL.
+ * @retval RID_ERROR_NOT_FOUND if no frame is due.
+ */
+int rid_scheduler_next(rid_scheduler_t *scheduler, uint64_t now, rid_scheduler_frame_t *frame);
+
+/**
+ * @brief Get the time the next frame is due.
+ *
+ * @param scheduler Pointer to the scheduler.
+ *
+ * @return Due time of the earliest frame or UINT64_MAX if nothing is
+ *         scheduled or scheduler is NULL.
+ */
+uint64_t rid_scheduler_next_due(const rid_scheduler_t *scheduler);
+
+/**
+ * @brief Get the number of scheduled frames, one per message type and
+ *        aircraft on Bluetooth Legacy and one per aircraft otherwise.
+ *
+ * @param scheduler Pointer to the scheduler.
+ *
+ * @return Number of scheduled frames or 0 if scheduler is NULL.
+ */
+size_t rid_scheduler_count(const rid_scheduler_t *scheduler);
+
+/**
+ * @brief Get the messages of an aircraft.
+ *
+ * @param scheduler Pointer to the scheduler.
+ * @param aircraft Aircraft index.
+ *
+ * @return Pointer to the aircraft or NULL if aircraft is out of range.
+ */
+const rid_scheduled_aircraft_t *rid_scheduler_get_aircraft(const rid_scheduler_t *scheduler, uint32_t aircraft);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* RID_SCHEDULER_H */
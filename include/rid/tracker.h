@@ -0,0 +1,226 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of librid: https://github.com/tuupola/librid
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#ifndef RID_TRACKER_H
+#define RID_TRACKER_H
+
+/**
+ * @file tracker.h
+ * @brief Per aircraft state assembled from received messages.
+ *
+ * The tracker keeps the latest message of each type for every
+ * transmitter, keyed by the link layer source address. Aircraft records
+ * live in a pool carved out of caller provided storage and are indexed
+ * with an open addressing hash table. Updates and lookups are constant
+ * time and never allocate.
+ *
+ * Timestamps are opaque to the tracker. Use any monotonic clock, for
+ * example milliseconds since boot.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rid/message.h"
+#include "rid/transport.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/** @brief Number of message types stored per aircraft (Basic ID to Operator ID). */
+#define RID_TRACKER_MESSAGE_TYPES 6
+
+/** @brief Maximum number of aircraft a tracker can hold. */
+#define RID_TRACKER_MAX_CAPACITY 0x3FFFFFFF
+
+/**
+ * @brief State of a single aircraft.
+ *
+ * The message array is indexed by rid_message_type_t. A message is only
+ * valid if the corresponding bit (1 << type) is set in seen.
+ */
+typedef struct rid_aircraft {
+    rid_address_t address;
+    uint16_t seen;
+    uint64_t first_seen;
+    uint64_t last_seen;
+    uint32_t message_count[RID_TRACKER_MESSAGE_TYPES];
+    rid_message_t message[RID_TRACKER_MESSAGE_TYPES];
+} rid_aircraft_t;
+
+/**
+ * @brief Hash table slot, internal to the tracker.
+ */
+typedef struct rid_tracker_slot {
+    uint32_t hash;
+    uint32_t index;
+} rid_tracker_slot_t;
+
+/**
+ * @brief Aircraft tracker.
+ *
+ * Aircraft are stored densely in aircraft[0] to aircraft[count - 1].
+ * Removing an aircraft moves the last one into its place, so pointers
+ * and indexes are only stable until the next removal.
+ */
+typedef struct rid_tracker {
+    size_t capacity;
+    size_t count;
+    uint32_t mask;
+    rid_aircraft_t *aircraft;
+    rid_tracker_slot_t *slots;
+} rid_tracker_t;
+
+/**
+ * @brief Get the storage size needed for a tracker of given capacity.
+ *
+ * @param capacity Maximum number of concurrently tracked aircraft.
+ *
+ * @return Size of the storage in bytes.
+ */
+size_t rid_tracker_storage_size(size_t capacity);
+
+/**
+ * @brief Initialize a tracker using caller provided storage.
+ *
+ * @param tracker Pointer to the tracker to initialize.
+ * @param storage Storage for aircraft records and the hash table.
+ * @param storage_size Size of the storage in bytes.
+ * @param capacity Maximum number of concurrently tracked aircraft.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if tracker or storage is NULL.
+ * @retval RID_ERROR_OUT_OF_RANGE if capacity is zero or larger than
+ *         RID_TRACKER_MAX_CAPACITY.
+ * @retval RID_ERROR_BUFFER_TOO_SMALL if storage is too small.
+ */
+int rid_tracker_init(rid_tracker_t *tracker, void *storage, size_t storage_size, size_t capacity);
+
+/**
+ * @brief Remove all aircraft from the tracker.
+ *
+ * @param tracker Pointer to the tracker.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if tracker is NULL.
+ */
+int rid_tracker_clear(rid_tracker_t *tracker);
+
+/**
+ * @brief Store a received message.
+ *
+ * Creates the aircraft record if this is the first message from the
+ * address. Message Packs are unpacked and each contained message is
+ * stored separately. The message is not validated, call
+ * rid_message_validate() first if needed.
+ *
+ * @param tracker Pointer to the tracker.
+ * @param address Source address of the message.
+ * @param message Pointer to the message.
+ * @param now Reception timestamp.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if any argument is NULL.
+ * @retval RID_ERROR_UNKNOWN_MESSAGE_TYPE if the message type is unknown.
+ * @retval RID_ERROR_INVALID_MESSAGE_SIZE if a Message Pack has invalid message size.
+ * @retval RID_ERROR_INVALID_MESSAGE_COUNT if a Message Pack has too many messages.
+ * @retval RID_ERROR_BUFFER_TOO_SMALL if the tracker is full.
+ */
+int rid_tracker_update(rid_tracker_t *tracker, const rid_address_t *address, const void *message, uint64_t now);
+
+/**
+ * @brief Find an aircraft by source address.
+ *
+ * @param tracker Pointer to the tracker.
+ * @param address Source address to look up.
+ *
+ * @return Pointer to the aircraft or NULL if not found.
+ */
+const rid_aircraft_t *rid_tracker_find(const rid_tracker_t *tracker, const rid_address_t *address);
+
+/**
+ * @brief Remove an aircraft by source address.
+ *
+ * @param tracker Pointer to the tracker.
+ * @param address Source address of the aircraft.
+ *
+ * @retval RID_SUCCESS on success.
+ * @retval RID_ERROR_NULL_POINTER if tracker or address is NULL.
+ * @retval RID_ERROR_NOT_FOUND if the aircraft is not tracked.
+ */
+int rid_tracker_remove(rid_tracker_t *tracker, const rid_address_t *address);
+
+/**
+ * @brief Remove all aircraft not heard since given time.
+ *
+ * @param tracker Pointer to the tracker.
+ * @param older_than Aircraft with last_seen before this are removed.
+ *
+ * @return Number of removed aircraft.
+ */
+size_t rid_tracker_expire(rid_tracker_t *tracker, uint64_t older_than);
+
+/**
+ * @brief Get the number of tracked aircraft.
+ *
+ * @param tracker Pointer to the tracker.
+ *
+ * @return Number of aircraft or 0 if tracker is NULL.
+ */
+size_t rid_tracker_count(const rid_tracker_t *tracker);
+
+/**
+ * @brief Get aircraft at given index.
+ *
+ * @param tracker Pointer to the tracker.
+ * @param index Index from 0 to rid_tracker_count() - 1.
+ *
+ * @return Pointer to the aircraft or NULL if index is out of range.
+ */
+const rid_aircraft_t *rid_tracker_get_at(const rid_tracker_t *tracker, size_t index);
+
+/**
+ * @brief Get the latest message of given type.
+ *
+ * @param aircraft Pointer to the aircraft.
+ * @param type Message type from Basic ID to Operator ID.
+ *
+ * @return Pointer to the message or NULL if none has been received.
+ */
+const void *rid_aircraft_get_message(const rid_aircraft_t *aircraft, rid_message_type_t type);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* RID_TRACKER_H */
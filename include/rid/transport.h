@@ -38,6 +38,9 @@ SPDX-License-Identifier: MIT
 #ifndef RID_TRANSPORT_H
 #define RID_TRANSPORT_H
 
+#include <stddef.h>
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -86,6 +89,19 @@ extern "C" {
 #define RID_TRANSPORT_WIFI_BEACON_VENDOR_TYPE 0x0D
 /** @} */
 
+/** @brief Size of a link layer address in bytes. */
+#define RID_ADDRESS_SIZE 6
+
+/**
+ * @brief Link layer source address of a received broadcast.
+ *
+ * Bluetooth advertiser address or Wi-Fi transmitter address (BSSID)
+ * in transmission order.
+ */
+typedef struct rid_address {
+    uint8_t octets[RID_ADDRESS_SIZE];
+} rid_address_t;
+
 /**
  * @brief Transport methods for broadcasting Remote ID messages
  *
@@ -109,6 +125,15 @@ typedef enum rid_transport {
  */
 const char *rid_transport_to_string(rid_transport_t transport);
 
+/**
+ * @brief Get the maximum payload size of a transport.
+ *
+ * @param transport The transport type.
+ *
+ * @return Maximum payload size in bytes or 0 for invalid values.
+ */
+size_t rid_transport_get_max_payload(rid_transport_t transport);
+
 #ifdef __cplusplus
 }
 #endif
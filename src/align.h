@@ -0,0 +1,59 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Mika Tuupola
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * -cut-
+ *
+ * This file is part of librid: https://github.com/tuupola/librid
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#ifndef RID_ALIGN_PRIVATE_H
+#define RID_ALIGN_PRIVATE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Round value up to a multiple of alignment, which is a power of two. */
+static inline size_t rid_align_up(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+/*
+ * Caller provided storage can start at any address. Storage sizes leave
+ * room for moving the start to the next aligned address.
+ */
+static inline size_t rid_align_storage_size(size_t size, size_t alignment) {
+    return size + alignment;
+}
+
+/* First address in storage aligned to alignment. */
+static inline uint8_t *rid_align_storage(void *storage, size_t alignment) {
+    uintptr_t address = (uintptr_t)storage;
+
+    return (uint8_t *)storage + (rid_align_up((size_t)address, alignment) - (size_t)address);
+}
+
+#endif /* RID_ALIGN_PRIVATE_H */
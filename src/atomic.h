@@ -0,0 +1,112 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Mika Tuupola
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * -cut-
+ *
+ * This file is part of librid: https://github.com/tuupola/librid
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#ifndef RID_ATOMIC_PRIVATE_H
+#define RID_ATOMIC_PRIVATE_H
+
+#include <stddef.h>
+
+/*
+ * Counters shared between threads. C11 atomics are used everywhere
+ * except ESP-IDF where some targets have no atomic instructions, there
+ * every access is done inside a critical section instead. GCC and Clang
+ * also provide <stdatomic.h> when compiling as C99.
+ */
+#if defined(ESP_PLATFORM)
+
+#include "freertos/FreeRTOS.h"
+
+typedef volatile size_t rid_atomic_size_t;
+
+/* Defined in ring.c. */
+extern portMUX_TYPE rid_atomic_mux;
+
+static inline void rid_atomic_init(rid_atomic_size_t *atomic, size_t value) {
+    *atomic = value;
+}
+
+static inline size_t rid_atomic_load(rid_atomic_size_t *atomic) {
+    size_t value;
+
+    portENTER_CRITICAL_SAFE(&rid_atomic_mux);
+    value = *atomic;
+    portEXIT_CRITICAL_SAFE(&rid_atomic_mux);
+    return value;
+}
+
+static inline void rid_atomic_store(rid_atomic_size_t *atomic, size_t value) {
+    portENTER_CRITICAL_SAFE(&rid_atomic_mux);
+    *atomic = value;
+    portEXIT_CRITICAL_SAFE(&rid_atomic_mux);
+}
+
+static inline int rid_atomic_compare_exchange(rid_atomic_size_t *atomic, size_t *expected, size_t desired) {
+    int exchanged;
+
+    portENTER_CRITICAL_SAFE(&rid_atomic_mux);
+    exchanged = *atomic == *expected;
+    if (exchanged) {
+        *atomic = desired;
+    } else {
+        *expected = *atomic;
+    }
+    portEXIT_CRITICAL_SAFE(&rid_atomic_mux);
+    return exchanged;
+}
+
+#else
+
+#include <stdatomic.h>
+
+typedef _Atomic size_t rid_atomic_size_t;
+
+static inline void rid_atomic_init(rid_atomic_size_t *atomic, size_t value) {
+    atomic_init(atomic, value);
+}
+
+static inline size_t rid_atomic_load(rid_atomic_size_t *atomic) {
+    return atomic_load_explicit(atomic, memory_order_acquire);
+}
+
+static inline void rid_atomic_store(rid_atomic_size_t *atomic, size_t value) {
+    atomic_store_explicit(atomic, value, memory_order_release);
+}
+
+static inline int rid_atomic_compare_exchange(rid_atomic_size_t *atomic, size_t *expected, size_t desired) {
+    return atomic_compare_exchange_weak_explicit(
+        atomic, expected, desired, memory_order_acq_rel, memory_order_acquire
+    );
+}
+
+#endif
+
+#endif /* RID_ATOMIC_PRIVATE_H */
@@ -41,6 +41,8 @@ SPDX-License-Identifier: MIT
 #include "rid/message.h"
 #include "rid/message_pack.h"
 
+#include "align.h"
+#include "auth.h"
 #include "json.h"
 
 int rid_auth_init(rid_auth_t *auth) {
@@ -239,14 +241,28 @@ int rid_auth_get_signature(const rid_auth_t *auth, uint8_t *buffer, size_t buffe
     return RID_SUCCESS;
 }
 
-int rid_auth_verify(
-    const rid_auth_t *auth, const void *message, rid_auth_verify_cb_t callback,
-    void *context
-) {
-    if (NULL == auth || NULL == message || NULL == callback) {
-        return RID_ERROR_NULL_POINTER;
+/* Payload is concatenation of non Auth messages + timestamp */
+size_t rid_auth_build_payload(const rid_message_pack_t *pack, uint32_t timestamp, uint8_t *payload) {
+    size_t payload_length = 0;
+
+    uint8_t count = rid_message_pack_message_count(pack);
+    for (uint8_t i = 0; i < count; ++i) {
+        const void *tmp = rid_message_pack_get_message_at(pack, i);
+        if (RID_MESSAGE_TYPE_AUTH == rid_message_get_type(tmp)) {
+            continue;
+        }
+        memcpy(payload + payload_length, tmp, RID_MESSAGE_SIZE);
+        payload_length += RID_MESSAGE_SIZE;
     }
 
+    memcpy(payload + payload_length, &timestamp, sizeof(timestamp));
+    payload_length += sizeof(timestamp);
+
+    return payload_length;
+}
+
+/* Checks done before verifying. */
+static int check_verify(const rid_auth_t *auth, const void *message) {
     int rc = 0;
 
     rc = rid_auth_validate(auth);
@@ -259,8 +275,7 @@ int rid_auth_verify(
         return RID_ERROR_NOT_IMPLEMENTED;
     }
 
-    const rid_message_pack_t *pack = (const rid_message_pack_t *)message;
-    rc = rid_message_pack_validate(pack);
+    rc = rid_message_pack_validate((const rid_message_pack_t *)message);
     if (RID_SUCCESS != rc) {
         return rc;
     }
@@ -270,14 +285,45 @@ int rid_auth_verify(
         return RID_ERROR_NOT_IMPLEMENTED;
     }
 
-    uint8_t signature_length = rid_auth_get_length(auth);
-    if (0 == signature_length) {
+    if (0 == rid_auth_get_length(auth)) {
         return RID_ERROR_OUT_OF_RANGE;
     }
 
-    /* Build signed payload to be verified */
-    uint8_t payload[RID_MESSAGE_PACK_MAX_MESSAGES * RID_MESSAGE_SIZE + sizeof(uint32_t)];
-    size_t payload_length = 0;
+    return RID_SUCCESS;
+}
+
+/* Checks done before signing, sets the auth type. */
+static int check_sign(rid_auth_t *auth, const void *message) {
+    int rc = 0;
+
+    rc = rid_auth_validate(auth);
+    if (RID_SUCCESS != rc) {
+        return rc;
+    }
+
+    /* Only message pack is supported atm */
+    if (RID_MESSAGE_TYPE_MESSAGE_PACK != rid_message_get_type(message)) {
+        return RID_ERROR_NOT_IMPLEMENTED;
+    }
+
+    rc = rid_message_pack_validate((const rid_message_pack_t *)message);
+    if (RID_SUCCESS != rc) {
+        return rc;
+    }
+
+    /* Automatically set auth type */
+    return rid_auth_set_type(auth, RID_AUTH_TYPE_MESSAGE_SET_SIGNATURE);
+}
+
+/* Same bytes as rid_auth_build_payload() fed to the hash one message at a time. */
+static int hash_payload(
+    const rid_auth_hash_t *hash, const rid_message_pack_t *pack, uint32_t timestamp,
+    uint8_t *digest, size_t *digest_length
+) {
+    int rc = hash->init(hash->context);
+    if (0 != rc) {
+        return rc;
+    }
 
     uint8_t count = rid_message_pack_message_count(pack);
     for (uint8_t i = 0; i < count; ++i) {
@@ -285,75 +331,182 @@ int rid_auth_verify(
         if (RID_MESSAGE_TYPE_AUTH == rid_message_get_type(tmp)) {
             continue;
         }
-        memcpy(payload + payload_length, tmp, RID_MESSAGE_SIZE);
-        payload_length += RID_MESSAGE_SIZE;
+        rc = hash->update(hash->context, (const uint8_t *)tmp, RID_MESSAGE_SIZE);
+        if (0 != rc) {
+            return rc;
+        }
     }
 
-    uint32_t timestamp = rid_auth_get_timestamp(auth);
-    memcpy(payload + payload_length, &timestamp, sizeof(timestamp));
-    payload_length += sizeof(timestamp);
+    rc = hash->update(hash->context, (const uint8_t *)&timestamp, sizeof(timestamp));
+    if (0 != rc) {
+        return rc;
+    }
 
-    uint8_t signature[255];
-    rc = rid_auth_get_signature(auth, signature, sizeof(signature));
+    *digest_length = 0;
+    rc = hash->final(hash->context, digest, RID_AUTH_MAX_DIGEST_SIZE, digest_length);
+    if (0 != rc) {
+        return rc;
+    }
+
+    if (*digest_length > RID_AUTH_MAX_DIGEST_SIZE) {
+        return RID_ERROR_BUFFER_TOO_LARGE;
+    }
+
+    return RID_SUCCESS;
+}
+
+int rid_auth_prepare_verify(
+    const rid_auth_t *auth, const void *message, uint8_t *payload, size_t *payload_length,
+    uint8_t *signature
+) {
+    int rc = check_verify(auth, message);
     if (RID_SUCCESS != rc) {
         return rc;
     }
 
-    return callback(context, payload, payload_length, signature, signature_length);
+    const rid_message_pack_t *pack = (const rid_message_pack_t *)message;
+    *payload_length = rid_auth_build_payload(pack, rid_auth_get_timestamp(auth), payload);
+
+    return rid_auth_get_signature(auth, signature, RID_AUTH_PAGE_MAX_SIGNATURE_SIZE);
 }
 
-int rid_auth_sign(
-    rid_auth_t *auth, const void *message, rid_auth_sign_cb_t callback,
+int rid_auth_verify(
+    const rid_auth_t *auth, const void *message, rid_auth_verify_cb_t callback,
     void *context
 ) {
     if (NULL == auth || NULL == message || NULL == callback) {
         return RID_ERROR_NULL_POINTER;
     }
 
-    int rc = 0;
+    /* Build signed payload to be verified */
+    uint8_t payload[RID_AUTH_MAX_PAYLOAD_SIZE];
+    uint8_t signature[RID_AUTH_PAGE_MAX_SIGNATURE_SIZE];
+    size_t payload_length = 0;
 
-    rc = rid_auth_validate(auth);
+    int rc = rid_auth_prepare_verify(auth, message, payload, &payload_length, signature);
     if (RID_SUCCESS != rc) {
         return rc;
     }
 
-    /* Only message pack is supported atm */
-    if (RID_MESSAGE_TYPE_MESSAGE_PACK != rid_message_get_type(message)) {
-        return RID_ERROR_NOT_IMPLEMENTED;
+    return callback(context, payload, payload_length, signature, rid_auth_get_length(auth));
+}
+
+static size_t batch_item_size(void) {
+    return sizeof(rid_auth_verify_item_t) + RID_AUTH_MAX_PAYLOAD_SIZE + RID_AUTH_PAGE_MAX_SIGNATURE_SIZE;
+}
+
+size_t rid_auth_verify_batch_scratch_size(size_t count) {
+    if (count > (SIZE_MAX - sizeof(uint64_t)) / batch_item_size()) {
+        return 0;
     }
 
-    const rid_message_pack_t *pack = (const rid_message_pack_t *)message;
-    rc = rid_message_pack_validate(pack);
-    if (RID_SUCCESS != rc) {
-        return rc;
+    return rid_align_storage_size(count * batch_item_size(), sizeof(uint64_t));
+}
+
+int rid_auth_verify_batch(
+    const rid_auth_t *const *auths, const void *const *messages, size_t count, void *scratch,
+    size_t scratch_size, rid_auth_verify_batch_cb_t batch_callback, rid_auth_verify_cb_t callback,
+    void *context, int *results
+) {
+    if (NULL == auths || NULL == messages || NULL == scratch || NULL == results) {
+        return RID_ERROR_NULL_POINTER;
     }
 
-    /* Automatically set auth type */
-    rc = rid_auth_set_type(auth, RID_AUTH_TYPE_MESSAGE_SET_SIGNATURE);
+    if (NULL == batch_callback && NULL == callback) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    size_t size = rid_auth_verify_batch_scratch_size(count);
+    if (0 == size || scratch_size < size) {
+        return RID_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    uint8_t *p = rid_align_storage(scratch, sizeof(uint64_t));
+
+    /* Items first, then the payloads back to back, then the signatures. */
+    rid_auth_verify_item_t *items = (rid_auth_verify_item_t *)p;
+    uint8_t *payload = p + count * sizeof(rid_auth_verify_item_t);
+    uint8_t *signature = payload + count * RID_AUTH_MAX_PAYLOAD_SIZE;
+    size_t prepared = 0;
+
+    for (size_t i = 0; i < count; ++i) {
+        rid_auth_verify_item_t *item = &items[prepared];
+
+        if (NULL == auths[i] || NULL == messages[i]) {
+            results[i] = RID_ERROR_NULL_POINTER;
+            continue;
+        }
+
+        results[i] = rid_auth_prepare_verify(auths[i], messages[i], payload, &item->input_length, signature);
+        if (RID_SUCCESS != results[i]) {
+            continue;
+        }
+
+        item->input = payload;
+        item->signature = signature;
+        item->signature_length = rid_auth_get_length(auths[i]);
+        item->index = i;
+        item->result = 0;
+
+        payload += item->input_length;
+        signature += item->signature_length;
+        prepared++;
+    }
+
+    if (0 == prepared) {
+        return RID_SUCCESS;
+    }
+
+    if (NULL == batch_callback) {
+        for (size_t i = 0; i < prepared; ++i) {
+            rid_auth_verify_item_t *item = &items[i];
+
+            results[item->index] = callback(
+                context, item->input, item->input_length, item->signature, item->signature_length
+            );
+        }
+        return RID_SUCCESS;
+    }
+
+    int rc = batch_callback(context, items, prepared);
+
+    for (size_t i = 0; i < prepared; ++i) {
+        results[items[i].index] = (0 != rc) ? rc : items[i].result;
+    }
+
+    return RID_SUCCESS;
+}
+
+int rid_auth_prepare_sign(rid_auth_t *auth, const void *message, uint8_t *payload, size_t *payload_length) {
+    int rc = check_sign(auth, message);
     if (RID_SUCCESS != rc) {
         return rc;
     }
 
+    const rid_message_pack_t *pack = (const rid_message_pack_t *)message;
+    *payload_length = rid_auth_build_payload(pack, rid_auth_get_timestamp(auth), payload);
+
+    return RID_SUCCESS;
+}
+
+int rid_auth_sign(
+    rid_auth_t *auth, const void *message, rid_auth_sign_cb_t callback,
+    void *context
+) {
+    if (NULL == auth || NULL == message || NULL == callback) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
     /* Build payload to be signed */
-    uint8_t payload[RID_MESSAGE_PACK_MAX_MESSAGES * RID_MESSAGE_SIZE + sizeof(uint32_t)];
+    uint8_t payload[RID_AUTH_MAX_PAYLOAD_SIZE];
     size_t payload_length = 0;
 
-    /* Payload is concatenation of non Auth messages + timestamp */
-    uint8_t count = rid_message_pack_message_count(pack);
-    for (uint8_t i = 0; i < count; ++i) {
-        const void *tmp = rid_message_pack_get_message_at(pack, i);
-        if (RID_MESSAGE_TYPE_AUTH == rid_message_get_type(tmp)) {
-            continue;
-        }
-        memcpy(payload + payload_length, tmp, RID_MESSAGE_SIZE);
-        payload_length += RID_MESSAGE_SIZE;
+    int rc = rid_auth_prepare_sign(auth, message, payload, &payload_length);
+    if (RID_SUCCESS != rc) {
+        return rc;
     }
 
-    uint32_t timestamp = rid_auth_get_timestamp(auth);
-    memcpy(payload + payload_length, &timestamp, sizeof(timestamp));
-    payload_length += sizeof(timestamp);
-
-    uint8_t signature[255];
+    uint8_t signature[RID_AUTH_PAGE_MAX_SIGNATURE_SIZE];
     size_t signature_length = 0;
 
     rc = callback(context, payload, payload_length, signature, sizeof(signature), &signature_length);
@@ -368,8 +521,91 @@ int rid_auth_sign(
     return rid_auth_set_signature(auth, signature, signature_length);
 }
 
+int rid_auth_sign_hashed(
+    rid_auth_t *auth, const void *message, const rid_auth_hash_t *hash,
+    rid_auth_sign_cb_t callback, void *context
+) {
+    if (NULL == auth || NULL == message || NULL == hash || NULL == callback) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    if (NULL == hash->init || NULL == hash->update || NULL == hash->final) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    int rc = check_sign(auth, message);
+    if (RID_SUCCESS != rc) {
+        return rc;
+    }
+
+    uint8_t digest[RID_AUTH_MAX_DIGEST_SIZE];
+    size_t digest_length = 0;
+
+    rc = hash_payload(
+        hash, (const rid_message_pack_t *)message, rid_auth_get_timestamp(auth), digest, &digest_length
+    );
+    if (0 != rc) {
+        return rc;
+    }
+
+    uint8_t signature[RID_AUTH_PAGE_MAX_SIGNATURE_SIZE];
+    size_t signature_length = 0;
+
+    rc = callback(context, digest, digest_length, signature, sizeof(signature), &signature_length);
+    if (0 != rc) {
+        return rc;
+    }
+
+    if (0 == signature_length) {
+        return RID_ERROR_OUT_OF_RANGE;
+    }
+
+    return rid_auth_set_signature(auth, signature, signature_length);
+}
+
+int rid_auth_verify_hashed(
+    const rid_auth_t *auth, const void *message, const rid_auth_hash_t *hash,
+    rid_auth_verify_cb_t callback, void *context
+) {
+    if (NULL == auth || NULL == message || NULL == hash || NULL == callback) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    if (NULL == hash->init || NULL == hash->update || NULL == hash->final) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    int rc = check_verify(auth, message);
+    if (RID_SUCCESS != rc) {
+        return rc;
+    }
+
+    uint8_t digest[RID_AUTH_MAX_DIGEST_SIZE];
+    size_t digest_length = 0;
+
+    rc = hash_payload(
+        hash, (const rid_message_pack_t *)message, rid_auth_get_timestamp(auth), digest, &digest_length
+    );
+    if (0 != rc) {
+        return rc;
+    }
+
+    uint8_t signature[RID_AUTH_PAGE_MAX_SIGNATURE_SIZE];
+    rc = rid_auth_get_signature(auth, signature, sizeof(signature));
+    if (RID_SUCCESS != rc) {
+        return rc;
+    }
+
+    return callback(context, digest, digest_length, signature, rid_auth_get_length(auth));
+}
+
 static size_t buffer_to_hex(const uint8_t *data, size_t data_size, char *hex, size_t hex_size) {
     size_t pos = 0;
+
+    /* Empty signature is an empty string. */
+    if (hex_size > 0) {
+        hex[0] = '\0';
+    }
     for (size_t i = 0; i < data_size && pos + 2 < hex_size; ++i) {
         int written = snprintf(hex + pos, hex_size - pos, "%02x", data[i]);
         if (written > 0) {
@@ -379,53 +615,119 @@ static size_t buffer_to_hex(const uint8_t *data, size_t data_size, char *hex, si
     return pos;
 }
 
-int rid_auth_to_json(const rid_auth_t *auth, char *buffer, size_t buffer_size, size_t *needed_size) {
-    rid_json_t json;
+void rid_auth_json_write(rid_json_t *json, const rid_auth_t *auth) {
     char hex[RID_AUTH_PAGE_MAX_SIGNATURE_SIZE * 2 + 1];
     uint8_t signature[RID_AUTH_PAGE_MAX_SIGNATURE_SIZE];
     rid_auth_type_t type;
     uint8_t length;
 
-    if (auth == NULL || (buffer == NULL && needed_size == NULL)) {
-        return RID_ERROR_NULL_POINTER;
-    }
-
     type = rid_auth_get_type(auth);
     length = rid_auth_get_length(auth);
 
-    rid_json_start(&json, buffer, buffer_size);
-    rid_json_key(&json, "protocol_version");
-    rid_json_uint(&json, rid_message_get_protocol_version(&auth->page_0));
-    rid_json_key(&json, "message_type");
-    rid_json_uint(&json, rid_message_get_type(&auth->page_0));
-    rid_json_key(&json, "auth_type");
-    rid_json_uint(&json, type);
-    rid_json_key(&json, "page_count");
-    rid_json_uint(&json, rid_auth_get_page_count(auth));
-    rid_json_key(&json, "timestamp");
-    rid_json_uint(&json, rid_auth_get_timestamp(auth));
-    rid_json_key(&json, "length");
-    rid_json_uint(&json, length);
-    rid_json_key(&json, "signature");
+    rid_json_object_start(json);
+    rid_json_key(json, "protocol_version");
+    rid_json_uint(json, rid_message_get_protocol_version(&auth->page_0));
+    rid_json_key(json, "message_type");
+    rid_json_uint(json, rid_message_get_type(&auth->page_0));
+    rid_json_key(json, "auth_type");
+    rid_json_uint(json, type);
+    rid_json_key(json, "page_count");
+    rid_json_uint(json, rid_auth_get_page_count(auth));
+    rid_json_key(json, "timestamp");
+    rid_json_uint(json, rid_auth_get_timestamp(auth));
+    rid_json_key(json, "length");
+    rid_json_uint(json, length);
+    rid_json_key(json, "signature");
     if (type == RID_AUTH_TYPE_NONE || type == RID_AUTH_TYPE_NETWORK_REMOTE_ID) {
-        rid_json_null(&json);
+        rid_json_null(json);
     } else {
         rid_auth_get_signature(auth, signature, sizeof(signature));
         buffer_to_hex(signature, length, hex, sizeof(hex));
-        rid_json_string(&json, hex);
+        rid_json_string(json, hex);
     }
-    rid_json_end(&json);
+    rid_json_object_end(json);
+}
+
+int rid_auth_to_json(const rid_auth_t *auth, char *buffer, size_t buffer_size, size_t *needed_size) {
+    rid_json_t json;
 
-    if (needed_size != NULL) {
-        *needed_size = json.position + 1;
+    if (auth == NULL || (buffer == NULL && needed_size == NULL)) {
+        return RID_ERROR_NULL_POINTER;
     }
 
-    if (buffer == NULL) {
-        return RID_SUCCESS;
+    rid_json_start(&json, buffer, buffer_size);
+    rid_auth_json_write(&json, auth);
+
+    return rid_json_end(&json, needed_size);
+}
+
+int rid_auth_to_json_sink(const rid_auth_t *auth, const rid_json_sink_t *sink) {
+    rid_json_t json;
+
+    if (auth == NULL || sink == NULL || sink->write == NULL) {
+        return RID_ERROR_NULL_POINTER;
     }
 
-    if (json.position + 1 > buffer_size) {
-        return RID_ERROR_BUFFER_TOO_SMALL;
+    rid_json_start_sink(&json, sink);
+    rid_auth_json_write(&json, auth);
+
+    return rid_json_end(&json, NULL);
+}
+
+int rid_auth_to_cbor(const rid_auth_t *auth, uint8_t *buffer, size_t buffer_size, size_t *needed_size) {
+    rid_json_t json;
+
+    if (auth == NULL || (buffer == NULL && needed_size == NULL)) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    rid_cbor_start(&json, buffer, buffer_size);
+    rid_auth_json_write(&json, auth);
+
+    return rid_json_end(&json, needed_size);
+}
+
+int rid_auth_json_read(rid_json_object_t *object, rid_auth_t *auth) {
+    uint8_t signature[RID_AUTH_PAGE_MAX_SIGNATURE_SIZE];
+    uint32_t value;
+    size_t length;
+    int status;
+
+    rid_auth_init(auth);
+
+    status = rid_json_get_uint(object, "auth_type", UINT8_MAX, &value);
+    if (status == RID_SUCCESS) {
+        status = rid_auth_set_type(auth, (rid_auth_type_t)value);
+    }
+    if (status < RID_SUCCESS) {
+        return status;
+    }
+
+    status = rid_json_get_uint(object, "timestamp", UINT32_MAX, &value);
+    if (status == RID_SUCCESS) {
+        status = rid_auth_set_timestamp(auth, value);
+    }
+    if (status < RID_SUCCESS) {
+        return status;
+    }
+
+    /*
+     * Page count follows from the signature length. Signature is written
+     * as null for some auth types, keep its length with zeroed data.
+     */
+    status = rid_json_get_hex(object, "signature", signature, sizeof(signature), &length);
+    if (status == RID_JSON_NULL) {
+        status = rid_json_get_uint(object, "length", RID_AUTH_PAGE_MAX_SIGNATURE_SIZE, &value);
+        if (status == RID_SUCCESS) {
+            length = value;
+            memset(signature, 0, length);
+        }
+    }
+    if (status == RID_SUCCESS) {
+        status = rid_auth_set_signature(auth, signature, length);
+    }
+    if (status < RID_SUCCESS) {
+        return status;
     }
 
     return RID_SUCCESS;
@@ -0,0 +1,54 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Mika Tuupola
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * -cut-
+ *
+ * This file is part of librid: https://github.com/tuupola/librid
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#ifndef RID_AUTH_PRIVATE_H
+#define RID_AUTH_PRIVATE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rid/auth.h"
+#include "rid/message_pack.h"
+
+/* Concatenation of the non Auth messages and the timestamp, returns the length. */
+size_t rid_auth_build_payload(const rid_message_pack_t *pack, uint32_t timestamp, uint8_t *payload);
+
+/* Checks done by rid_auth_sign(), sets the auth type and builds the payload. */
+int rid_auth_prepare_sign(rid_auth_t *auth, const void *message, uint8_t *payload, size_t *payload_length);
+
+/* Checks done by rid_auth_verify(), builds the payload and extracts the signature. */
+int rid_auth_prepare_verify(
+    const rid_auth_t *auth, const void *message, uint8_t *payload, size_t *payload_length,
+    uint8_t *signature
+);
+
+#endif /* RID_AUTH_PRIVATE_H */
@@ -0,0 +1,274 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of librid: https://github.com/tuupola/librid
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "rid/auth.h"
+#include "rid/auth_cache.h"
+#include "rid/message.h"
+
+#include "align.h"
+
+typedef struct {
+    rid_auth_cache_t *cache;
+    rid_auth_verify_cb_t callback;
+    void *context;
+} verify_context_t;
+
+static uint64_t load_le64(const uint8_t *p) {
+    uint64_t value = 0;
+
+    for (int i = 7; i >= 0; --i) {
+        value = (value << 8) | p[i];
+    }
+    return value;
+}
+
+static uint64_t rotl(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+#define SIPROUND(v0, v1, v2, v3) \
+    do { \
+        v0 += v1; v1 = rotl(v1, 13); v1 ^= v0; v0 = rotl(v0, 32); \
+        v2 += v3; v3 = rotl(v3, 16); v3 ^= v2; \
+        v0 += v3; v3 = rotl(v3, 21); v3 ^= v0; \
+        v2 += v1; v1 = rotl(v1, 17); v1 ^= v2; v2 = rotl(v2, 32); \
+    } while (0)
+
+/* SipHash-2-4 */
+static uint64_t siphash(const uint64_t key[2], const uint8_t *data, size_t size) {
+    uint64_t v0 = key[0] ^ 0x736f6d6570736575ULL;
+    uint64_t v1 = key[1] ^ 0x646f72616e646f6dULL;
+    uint64_t v2 = key[0] ^ 0x6c7967656e657261ULL;
+    uint64_t v3 = key[1] ^ 0x7465646279746573ULL;
+    size_t end = size & ~(size_t)7;
+    uint64_t m;
+
+    for (size_t i = 0; i < end; i += 8) {
+        m = load_le64(data + i);
+        v3 ^= m;
+        SIPROUND(v0, v1, v2, v3);
+        SIPROUND(v0, v1, v2, v3);
+        v0 ^= m;
+    }
+
+    /* Last block holds the remaining bytes and the low byte of the size. */
+    m = (uint64_t)size << 56;
+    for (size_t i = end; i < size; ++i) {
+        m |= (uint64_t)data[i] << (8 * (i - end));
+    }
+
+    v3 ^= m;
+    SIPROUND(v0, v1, v2, v3);
+    SIPROUND(v0, v1, v2, v3);
+    v0 ^= m;
+
+    v2 ^= 0xff;
+    SIPROUND(v0, v1, v2, v3);
+    SIPROUND(v0, v1, v2, v3);
+    SIPROUND(v0, v1, v2, v3);
+    SIPROUND(v0, v1, v2, v3);
+
+    return v0 ^ v1 ^ v2 ^ v3;
+}
+
+/* Number of sets, a power of two. */
+static size_t set_count(size_t capacity) {
+    size_t sets = 1;
+
+    while (sets * RID_AUTH_CACHE_WAYS < capacity) {
+        sets <<= 1;
+    }
+    return sets;
+}
+
+size_t rid_auth_cache_storage_size(size_t capacity) {
+    if (capacity == 0 || capacity > RID_AUTH_CACHE_MAX_CAPACITY) {
+        return 0;
+    }
+    return rid_align_storage_size(
+        set_count(capacity) * RID_AUTH_CACHE_WAYS * sizeof(rid_auth_cache_entry_t), sizeof(uint64_t)
+    );
+}
+
+int rid_auth_cache_init(
+    rid_auth_cache_t *cache, void *storage, size_t storage_size, size_t capacity,
+    const uint8_t *key
+) {
+    if (cache == NULL || storage == NULL || key == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    if (capacity == 0 || capacity > RID_AUTH_CACHE_MAX_CAPACITY) {
+        return RID_ERROR_OUT_OF_RANGE;
+    }
+
+    if (storage_size < rid_auth_cache_storage_size(capacity)) {
+        return RID_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    uint8_t *p = rid_align_storage(storage, sizeof(uint64_t));
+
+    cache->key[0] = load_le64(key);
+    cache->key[1] = load_le64(key + 8);
+    cache->mask = (uint32_t)(set_count(capacity) - 1);
+    cache->entries = (rid_auth_cache_entry_t *)p;
+
+    return rid_auth_cache_clear(cache);
+}
+
+int rid_auth_cache_clear(rid_auth_cache_t *cache) {
+    if (cache == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    cache->clock = 0;
+    cache->hits = 0;
+    cache->misses = 0;
+    memset(cache->entries, 0, ((size_t)cache->mask + 1) * RID_AUTH_CACHE_WAYS * sizeof(rid_auth_cache_entry_t));
+
+    return RID_SUCCESS;
+}
+
+/* Returns the entry holding the hash or the least recently used one. */
+static rid_auth_cache_entry_t *lookup(rid_auth_cache_t *cache, uint64_t hash) {
+    rid_auth_cache_entry_t *set = &cache->entries[(size_t)(hash & cache->mask) * RID_AUTH_CACHE_WAYS];
+    rid_auth_cache_entry_t *oldest = &set[0];
+
+    for (size_t i = 0; i < RID_AUTH_CACHE_WAYS; ++i) {
+        if (set[i].stamp != 0 && set[i].hash == hash) {
+            return &set[i];
+        }
+        if (set[i].stamp < oldest->stamp) {
+            oldest = &set[i];
+        }
+    }
+    return oldest;
+}
+
+/* Stamps only grow, start over before the clock wraps. */
+static uint32_t tick(rid_auth_cache_t *cache) {
+    if (cache->clock == UINT32_MAX) {
+        uint64_t hits = cache->hits;
+        uint64_t misses = cache->misses;
+
+        rid_auth_cache_clear(cache);
+        cache->hits = hits;
+        cache->misses = misses;
+    }
+    return ++cache->clock;
+}
+
+/* Called by rid_auth_verify() with the signed payload. */
+static int verify_cached(
+    void *context, const uint8_t *input, size_t input_length,
+    const uint8_t *signature, size_t signature_length
+) {
+    verify_context_t *verify = (verify_context_t *)context;
+    rid_auth_cache_t *cache = verify->cache;
+    uint8_t key[
+        sizeof(rid_auth_verify_cb_t) + sizeof(void *) + RID_AUTH_MAX_PAYLOAD_SIZE +
+        RID_AUTH_PAGE_MAX_SIGNATURE_SIZE + 1
+    ];
+    size_t key_length = 0;
+
+    /* The callback and context select the verifying key, results of other verifiers must not match. */
+    memcpy(key, &verify->callback, sizeof(rid_auth_verify_cb_t));
+    key_length += sizeof(rid_auth_verify_cb_t);
+    memcpy(key + key_length, &verify->context, sizeof(void *));
+    key_length += sizeof(void *);
+
+    /* Signature length ends the key so payload and signature can not shift. */
+    memcpy(key + key_length, input, input_length);
+    key_length += input_length;
+    memcpy(key + key_length, signature, signature_length);
+    key_length += signature_length;
+    key[key_length++] = (uint8_t)signature_length;
+
+    uint64_t hash = siphash(cache->key, key, key_length);
+    rid_auth_cache_entry_t *entry = lookup(cache, hash);
+
+    if (entry->stamp != 0 && entry->hash == hash) {
+        entry->stamp = tick(cache);
+        cache->hits++;
+        return entry->result;
+    }
+
+    cache->misses++;
+
+    int result = verify->callback(verify->context, input, input_length, signature, signature_length);
+
+    /* Other errors, such as an unavailable backend, are retried on the next call. */
+    if (result != RID_SUCCESS && result != RID_ERROR_INVALID_SIGNATURE) {
+        return result;
+    }
+
+    /* The clock may have started over, look up the entry again. */
+    uint32_t stamp = tick(cache);
+
+    entry = lookup(cache, hash);
+    entry->hash = hash;
+    entry->stamp = stamp;
+    entry->result = result;
+
+    return result;
+}
+
+int rid_auth_cache_verify(
+    rid_auth_cache_t *cache, const rid_auth_t *auth, const void *message,
+    rid_auth_verify_cb_t callback, void *context
+) {
+    if (cache == NULL || auth == NULL || message == NULL || callback == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    verify_context_t verify = {cache, callback, context};
+
+    return rid_auth_verify(auth, message, verify_cached, &verify);
+}
+
+uint64_t rid_auth_cache_hits(const rid_auth_cache_t *cache) {
+    if (cache == NULL) {
+        return 0;
+    }
+    return cache->hits;
+}
+
+uint64_t rid_auth_cache_misses(const rid_auth_cache_t *cache) {
+    if (cache == NULL) {
+        return 0;
+    }
+    return cache->misses;
+}
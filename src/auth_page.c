@@ -72,6 +72,41 @@ int rid_auth_page_x_init(rid_auth_page_x_t *message, uint8_t page_number) {
     return RID_SUCCESS;
 }
 
+int rid_auth_page_validate(const void *message) {
+    const rid_auth_page_0_t *page_0 = (const rid_auth_page_0_t *)message;
+
+    if (NULL == message) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    /* Valid protocol versions: 0, 1, 2, or 0x0F (private use) */
+    if (page_0->protocol_version > RID_PROTOCOL_VERSION_2 &&
+        page_0->protocol_version != RID_PROTOCOL_PRIVATE_USE) {
+        return RID_ERROR_INVALID_PROTOCOL_VERSION;
+    }
+
+    if (page_0->message_type != RID_MESSAGE_TYPE_AUTH) {
+        return RID_ERROR_UNKNOWN_MESSAGE_TYPE;
+    }
+
+    /* Page number is four bits, pages 1-15 have nothing more to check. */
+    if (page_0->page_number != 0) {
+        return RID_SUCCESS;
+    }
+
+    if (page_0->last_page_index > RID_AUTH_MAX_PAGE_INDEX ||
+        page_0->length > RID_AUTH_PAGE_0_DATA_SIZE + page_0->last_page_index * RID_AUTH_PAGE_DATA_SIZE) {
+        return RID_ERROR_INVALID_LAST_PAGE_INDEX;
+    }
+
+    /* BMG0180: Network Remote ID requires an empty signature */
+    if (page_0->auth_type == RID_AUTH_TYPE_NETWORK_REMOTE_ID && page_0->length != 0) {
+        return RID_ERROR_NON_EMPTY_SIGNATURE;
+    }
+
+    return RID_SUCCESS;
+}
+
 int rid_auth_page_0_set_type(rid_auth_page_0_t *message, rid_auth_type_t type) {
     if (NULL == message) {
         return RID_ERROR_NULL_POINTER;
@@ -285,20 +320,15 @@ static size_t auth_data_to_hex(const uint8_t *data, size_t data_size, char *hex,
     return pos;
 }
 
-int rid_auth_page_to_json(const void *message, char *buffer, size_t buffer_size, size_t *needed_size) {
-    rid_json_t json;
+void rid_auth_page_json_write(rid_json_t *json, const void *message) {
     rid_auth_type_t auth_type;
 
-    if (NULL == message || (NULL == buffer && NULL == needed_size)) {
-        return RID_ERROR_NULL_POINTER;
-    }
-
-    rid_json_start(&json, buffer, buffer_size);
+    rid_json_object_start(json);
 
-    rid_json_key(&json, "protocol_version");
-    rid_json_uint(&json, rid_message_get_protocol_version(message));
-    rid_json_key(&json, "message_type");
-    rid_json_uint(&json, rid_message_get_type(message));
+    rid_json_key(json, "protocol_version");
+    rid_json_uint(json, rid_message_get_protocol_version(message));
+    rid_json_key(json, "message_type");
+    rid_json_uint(json, rid_message_get_type(message));
 
     if (0 == ((const rid_auth_page_0_t *)message)->page_number) {
         const rid_auth_page_0_t *page_0 = (const rid_auth_page_0_t *)message;
@@ -306,22 +336,22 @@ int rid_auth_page_to_json(const void *message, char *buffer, size_t buffer_size,
 
         auth_type = rid_auth_page_0_get_type(page_0);
 
-        rid_json_key(&json, "page_number");
-        rid_json_uint(&json, page_0->page_number);
-        rid_json_key(&json, "auth_type");
-        rid_json_uint(&json, auth_type);
-        rid_json_key(&json, "last_page_index");
-        rid_json_uint(&json, rid_auth_page_0_get_last_page_index(page_0));
-        rid_json_key(&json, "length");
-        rid_json_uint(&json, rid_auth_page_0_get_length(page_0));
-        rid_json_key(&json, "timestamp");
-        rid_json_uint(&json, rid_auth_page_0_get_timestamp(page_0));
-        rid_json_key(&json, "auth_data");
+        rid_json_key(json, "page_number");
+        rid_json_uint(json, page_0->page_number);
+        rid_json_key(json, "auth_type");
+        rid_json_uint(json, auth_type);
+        rid_json_key(json, "last_page_index");
+        rid_json_uint(json, rid_auth_page_0_get_last_page_index(page_0));
+        rid_json_key(json, "length");
+        rid_json_uint(json, rid_auth_page_0_get_length(page_0));
+        rid_json_key(json, "timestamp");
+        rid_json_uint(json, rid_auth_page_0_get_timestamp(page_0));
+        rid_json_key(json, "auth_data");
         if (auth_type == RID_AUTH_TYPE_NONE || auth_type == RID_AUTH_TYPE_NETWORK_REMOTE_ID) {
-            rid_json_null(&json);
+            rid_json_null(json);
         } else {
             auth_data_to_hex(page_0->auth_data, RID_AUTH_PAGE_0_DATA_SIZE, hex_buf, sizeof(hex_buf));
-            rid_json_string(&json, hex_buf);
+            rid_json_string(json, hex_buf);
         }
     } else {
         const rid_auth_page_x_t *page_x = (const rid_auth_page_x_t *)message;
@@ -329,31 +359,139 @@ int rid_auth_page_to_json(const void *message, char *buffer, size_t buffer_size,
 
         auth_type = rid_auth_page_x_get_type(page_x);
 
-        rid_json_key(&json, "page_number");
-        rid_json_uint(&json, rid_auth_page_x_get_number(page_x));
-        rid_json_key(&json, "auth_type");
-        rid_json_uint(&json, auth_type);
-        rid_json_key(&json, "auth_data");
+        rid_json_key(json, "page_number");
+        rid_json_uint(json, rid_auth_page_x_get_number(page_x));
+        rid_json_key(json, "auth_type");
+        rid_json_uint(json, auth_type);
+        rid_json_key(json, "auth_data");
         if (auth_type == RID_AUTH_TYPE_NONE || auth_type == RID_AUTH_TYPE_NETWORK_REMOTE_ID) {
-            rid_json_null(&json);
+            rid_json_null(json);
         } else {
             auth_data_to_hex(page_x->auth_data, RID_AUTH_PAGE_DATA_SIZE, hex_buf, sizeof(hex_buf));
-            rid_json_string(&json, hex_buf);
+            rid_json_string(json, hex_buf);
         }
     }
+    rid_json_object_end(json);
+}
 
-    rid_json_end(&json);
+int rid_auth_page_to_json(const void *message, char *buffer, size_t buffer_size, size_t *needed_size) {
+    rid_json_t json;
 
-    if (needed_size != NULL) {
-        *needed_size = json.position + 1;
+    if (NULL == message || (NULL == buffer && NULL == needed_size)) {
+        return RID_ERROR_NULL_POINTER;
     }
 
-    if (buffer == NULL) {
-        return RID_SUCCESS;
+    rid_json_start(&json, buffer, buffer_size);
+    rid_auth_page_json_write(&json, message);
+
+    return rid_json_end(&json, needed_size);
+}
+
+int rid_auth_page_to_json_sink(const void *message, const rid_json_sink_t *sink) {
+    rid_json_t json;
+
+    if (message == NULL || sink == NULL || sink->write == NULL) {
+        return RID_ERROR_NULL_POINTER;
     }
 
-    if (json.position + 1 > buffer_size) {
-        return RID_ERROR_BUFFER_TOO_SMALL;
+    rid_json_start_sink(&json, sink);
+    rid_auth_page_json_write(&json, message);
+
+    return rid_json_end(&json, NULL);
+}
+
+int rid_auth_page_to_cbor(const void *message, uint8_t *buffer, size_t buffer_size, size_t *needed_size) {
+    rid_json_t json;
+
+    if (NULL == message || (NULL == buffer && NULL == needed_size)) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    rid_cbor_start(&json, buffer, buffer_size);
+    rid_auth_page_json_write(&json, message);
+
+    return rid_json_end(&json, needed_size);
+}
+
+int rid_auth_page_json_read(rid_json_object_t *object, void *message) {
+    uint8_t data[RID_AUTH_PAGE_DATA_SIZE];
+    uint32_t page_number;
+    uint32_t value;
+    size_t length;
+    int status;
+
+    status = rid_json_get_uint(object, "page_number", RID_AUTH_MAX_PAGE_INDEX, &page_number);
+    if (status == RID_JSON_NULL) {
+        return RID_ERROR_INVALID_JSON;
+    }
+    if (status < RID_SUCCESS) {
+        return status;
+    }
+
+    if (0 == page_number) {
+        rid_auth_page_0_t *page_0 = (rid_auth_page_0_t *)message;
+
+        rid_auth_page_0_init(page_0);
+
+        status = rid_json_get_uint(object, "auth_type", UINT8_MAX, &value);
+        if (status == RID_SUCCESS) {
+            status = rid_auth_page_0_set_type(page_0, (rid_auth_type_t)value);
+        }
+        if (status < RID_SUCCESS) {
+            return status;
+        }
+
+        status = rid_json_get_uint(object, "last_page_index", UINT8_MAX, &value);
+        if (status == RID_SUCCESS) {
+            status = rid_auth_page_0_set_last_page_index(page_0, (uint8_t)value);
+        }
+        if (status < RID_SUCCESS) {
+            return status;
+        }
+
+        status = rid_json_get_uint(object, "length", UINT8_MAX, &value);
+        if (status == RID_SUCCESS) {
+            status = rid_auth_page_0_set_length(page_0, (uint8_t)value);
+        }
+        if (status < RID_SUCCESS) {
+            return status;
+        }
+
+        status = rid_json_get_uint(object, "timestamp", UINT32_MAX, &value);
+        if (status == RID_SUCCESS) {
+            status = rid_auth_page_0_set_timestamp(page_0, value);
+        }
+        if (status < RID_SUCCESS) {
+            return status;
+        }
+
+        status = rid_json_get_hex(object, "auth_data", data, RID_AUTH_PAGE_0_DATA_SIZE, &length);
+        if (status == RID_SUCCESS) {
+            status = rid_auth_page_0_set_data(page_0, data, length);
+        }
+        if (status < RID_SUCCESS) {
+            return status;
+        }
+    } else {
+        rid_auth_page_x_t *page_x = (rid_auth_page_x_t *)message;
+
+        rid_auth_page_x_init(page_x, (uint8_t)page_number);
+
+        status = rid_json_get_uint(object, "auth_type", UINT8_MAX, &value);
+        if (status == RID_SUCCESS) {
+            status = rid_auth_page_x_set_type(page_x, (rid_auth_type_t)value);
+        }
+        if (status < RID_SUCCESS) {
+            return status;
+        }
+
+        status = rid_json_get_hex(object, "auth_data", data, RID_AUTH_PAGE_DATA_SIZE, &length);
+        if (status == RID_SUCCESS) {
+            status = rid_auth_page_x_set_data(page_x, data, length);
+        }
+        if (status < RID_SUCCESS) {
+            return status;
+        }
     }
 
     return RID_SUCCESS;
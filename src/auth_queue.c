@@ -0,0 +1,317 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of librid: https://github.com/tuupola/librid
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "align.h"
+#include "atomic.h"
+#include "auth.h"
+#include "rid/auth.h"
+#include "rid/auth_queue.h"
+#include "rid/message.h"
+
+#define RID_AUTH_QUEUE_CACHE_LINE 64
+
+struct rid_auth_queue_counters {
+    /* Written by the submitters. */
+    rid_atomic_size_t head;
+    uint8_t head_padding[RID_AUTH_QUEUE_CACHE_LINE - sizeof(rid_atomic_size_t)];
+
+    /* Written by the workers. */
+    rid_atomic_size_t tail;
+    uint8_t tail_padding[RID_AUTH_QUEUE_CACHE_LINE - sizeof(rid_atomic_size_t)];
+
+    rid_atomic_size_t closed;
+    uint8_t closed_padding[RID_AUTH_QUEUE_CACHE_LINE - sizeof(rid_atomic_size_t)];
+};
+
+/*
+ * Each slot starts with a sequence number like in the ring buffer. The
+ * slot for position p is free when the sequence is p and holds a job
+ * when it is p + 1. Both ends claim positions with compare and exchange
+ * so there can be several submitters and workers. A worker runs the job
+ * in place and frees the slot only when it is done.
+ */
+static size_t align_up(size_t value) {
+    return rid_align_up(value, RID_AUTH_QUEUE_CACHE_LINE);
+}
+
+static size_t slot_size(void) {
+    return align_up(sizeof(rid_atomic_size_t) + sizeof(rid_auth_job_t));
+}
+
+static rid_atomic_size_t *sequence_at(const rid_auth_queue_t *queue, size_t position) {
+    return (rid_atomic_size_t *)(queue->slots + (position & (queue->capacity - 1)) * queue->slot_size);
+}
+
+static rid_auth_job_t *job_at(const rid_auth_queue_t *queue, size_t position) {
+    return (rid_auth_job_t *)(queue->slots + (position & (queue->capacity - 1)) * queue->slot_size + sizeof(rid_atomic_size_t));
+}
+
+/* Sequence relative to position, negative when the slot lags behind. */
+static ptrdiff_t distance(size_t sequence, size_t position) {
+    return (ptrdiff_t)(sequence - position);
+}
+
+size_t rid_auth_queue_storage_size(size_t capacity) {
+    if (capacity == 0 || capacity > RID_AUTH_QUEUE_MAX_CAPACITY || (capacity & (capacity - 1)) != 0) {
+        return 0;
+    }
+
+    return rid_align_storage_size(sizeof(struct rid_auth_queue_counters) + capacity * slot_size(), RID_AUTH_QUEUE_CACHE_LINE);
+}
+
+int rid_auth_queue_init(rid_auth_queue_t *queue, void *storage, size_t storage_size, size_t capacity) {
+    if (queue == NULL || storage == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    size_t size = rid_auth_queue_storage_size(capacity);
+
+    if (size == 0) {
+        return RID_ERROR_OUT_OF_RANGE;
+    }
+
+    if (storage_size < size) {
+        return RID_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    uint8_t *p = rid_align_storage(storage, RID_AUTH_QUEUE_CACHE_LINE);
+
+    memset(queue, 0, sizeof(rid_auth_queue_t));
+    queue->capacity = capacity;
+    queue->slot_size = slot_size();
+    queue->counters = (struct rid_auth_queue_counters *)p;
+    queue->slots = p + sizeof(struct rid_auth_queue_counters);
+
+    memset(queue->counters, 0, sizeof(struct rid_auth_queue_counters));
+    rid_atomic_init(&queue->counters->head, 0);
+    rid_atomic_init(&queue->counters->tail, 0);
+    rid_atomic_init(&queue->counters->closed, 0);
+
+    for (size_t i = 0; i < capacity; ++i) {
+        rid_atomic_init(sequence_at(queue, i), i);
+    }
+
+    return RID_SUCCESS;
+}
+
+int rid_auth_queue_set_crypto(
+    rid_auth_queue_t *queue, rid_auth_sign_cb_t sign, rid_auth_verify_cb_t verify, void *context
+) {
+    if (queue == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    queue->sign = sign;
+    queue->verify = verify;
+    queue->crypto_context = context;
+
+    return RID_SUCCESS;
+}
+
+int rid_auth_queue_set_callback(rid_auth_queue_t *queue, rid_auth_job_done_cb_t done, void *context) {
+    if (queue == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    queue->done = done;
+    queue->done_context = context;
+
+    return RID_SUCCESS;
+}
+
+/* Copy a prepared job to a free slot. */
+static int push(rid_auth_queue_t *queue, const rid_auth_job_t *job) {
+    size_t position = rid_atomic_load(&queue->counters->head);
+
+    for (;;) {
+        ptrdiff_t difference = distance(rid_atomic_load(sequence_at(queue, position)), position);
+
+        if (difference == 0) {
+            if (rid_atomic_compare_exchange(&queue->counters->head, &position, position + 1)) {
+                break;
+            }
+        } else if (difference < 0) {
+            return RID_ERROR_BUFFER_TOO_SMALL;
+        } else {
+            position = rid_atomic_load(&queue->counters->head);
+        }
+    }
+
+    memcpy(job_at(queue, position), job, sizeof(rid_auth_job_t));
+    rid_atomic_store(sequence_at(queue, position), position + 1);
+
+    return RID_SUCCESS;
+}
+
+int rid_auth_queue_submit_sign(
+    rid_auth_queue_t *queue, const rid_auth_t *auth, const void *message, void *user
+) {
+    if (queue == NULL || auth == NULL || message == NULL || queue->sign == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    rid_auth_job_t job;
+
+    job.type = RID_AUTH_JOB_SIGN;
+    job.result = 0;
+    job.user = user;
+    job.auth = *auth;
+    job.signature_length = 0;
+
+    int rc = rid_auth_prepare_sign(&job.auth, message, job.payload, &job.payload_length);
+    if (rc != RID_SUCCESS) {
+        return rc;
+    }
+
+    return push(queue, &job);
+}
+
+int rid_auth_queue_submit_verify(
+    rid_auth_queue_t *queue, const rid_auth_t *auth, const void *message, void *user
+) {
+    if (queue == NULL || auth == NULL || message == NULL || queue->verify == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    rid_auth_job_t job;
+
+    job.type = RID_AUTH_JOB_VERIFY;
+    job.result = 0;
+    job.user = user;
+    job.auth = *auth;
+    job.signature_length = rid_auth_get_length(auth);
+
+    int rc = rid_auth_prepare_verify(auth, message, job.payload, &job.payload_length, job.signature);
+    if (rc != RID_SUCCESS) {
+        return rc;
+    }
+
+    return push(queue, &job);
+}
+
+int rid_auth_queue_close(rid_auth_queue_t *queue) {
+    if (queue == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    rid_atomic_store(&queue->counters->closed, 1);
+
+    return RID_SUCCESS;
+}
+
+static void run(rid_auth_queue_t *queue, rid_auth_job_t *job) {
+    if (job->type == RID_AUTH_JOB_SIGN) {
+        job->result = queue->sign(
+            queue->crypto_context, job->payload, job->payload_length, job->signature,
+            sizeof(job->signature), &job->signature_length
+        );
+
+        if (job->result == 0 && job->signature_length == 0) {
+            job->result = RID_ERROR_OUT_OF_RANGE;
+        }
+
+        if (job->result == 0) {
+            job->result = rid_auth_set_signature(&job->auth, job->signature, job->signature_length);
+        }
+    } else {
+        job->result = queue->verify(
+            queue->crypto_context, job->payload, job->payload_length, job->signature,
+            job->signature_length
+        );
+    }
+
+    if (queue->done != NULL) {
+        queue->done(queue->done_context, job);
+    }
+}
+
+/* Claim the oldest queued job, returns 0 if there is none. */
+static int pop(rid_auth_queue_t *queue, size_t *position) {
+    *position = rid_atomic_load(&queue->counters->tail);
+
+    for (;;) {
+        ptrdiff_t difference = distance(rid_atomic_load(sequence_at(queue, *position)), *position + 1);
+
+        if (difference == 0) {
+            if (rid_atomic_compare_exchange(&queue->counters->tail, position, *position + 1)) {
+                return 1;
+            }
+        } else if (difference < 0) {
+            return 0;
+        } else {
+            *position = rid_atomic_load(&queue->counters->tail);
+        }
+    }
+}
+
+int rid_auth_queue_work(rid_auth_queue_t *queue, size_t max) {
+    if (queue == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    /* Closed is read first, jobs submitted before closing are then visible. */
+    int closed = rid_atomic_load(&queue->counters->closed) != 0;
+    size_t count = 0;
+    size_t position;
+
+    if (max > (size_t)INT32_MAX) {
+        max = INT32_MAX;
+    }
+
+    while (count < max && pop(queue, &position)) {
+        run(queue, job_at(queue, position));
+        rid_atomic_store(sequence_at(queue, position), position + queue->capacity);
+        count++;
+    }
+
+    if (count == 0 && closed && rid_auth_queue_count(queue) == 0) {
+        return RID_ERROR_NOT_FOUND;
+    }
+
+    return (int)count;
+}
+
+size_t rid_auth_queue_count(const rid_auth_queue_t *queue) {
+    if (queue == NULL) {
+        return 0;
+    }
+
+    /* Tail first, it never passes head. */
+    size_t tail = rid_atomic_load(&queue->counters->tail);
+    size_t head = rid_atomic_load(&queue->counters->head);
+
+    return head - tail;
+}
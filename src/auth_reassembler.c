@@ -0,0 +1,335 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of librid: https://github.com/tuupola/librid
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "rid/auth.h"
+#include "rid/auth_page.h"
+#include "rid/auth_reassembler.h"
+#include "rid/message.h"
+#include "rid/transport.h"
+
+#include "align.h"
+
+/* Slot index value marking an empty slot. Set indexes are stored +1. */
+#define RID_AUTH_REASSEMBLER_SLOT_EMPTY 0
+
+/* Keep the load factor at or below one half. */
+static uint32_t table_size(size_t capacity) {
+    uint32_t size = 2;
+
+    while (size < capacity * 2) {
+        size <<= 1;
+    }
+    return size;
+}
+
+static size_t partial_size(size_t capacity) {
+    return rid_align_up(capacity * sizeof(rid_auth_partial_t), sizeof(uint64_t));
+}
+
+static uint32_t hash_address(const rid_address_t *address) {
+    uint64_t key = 0;
+
+    for (size_t i = 0; i < RID_ADDRESS_SIZE; ++i) {
+        key = (key << 8) | address->octets[i];
+    }
+
+    /* Fibonacci hashing, the high bits are well mixed. */
+    return (uint32_t)((key * 0x9E3779B97F4A7C15ULL) >> 32);
+}
+
+static int address_equal(const rid_address_t *a, const rid_address_t *b) {
+    return memcmp(a->octets, b->octets, RID_ADDRESS_SIZE) == 0;
+}
+
+/* Returns the slot holding the address or the empty slot ending the probe. */
+static uint32_t probe(const rid_auth_reassembler_t *reassembler, const rid_address_t *address, uint32_t hash) {
+    uint32_t i = hash & reassembler->mask;
+
+    while (reassembler->slots[i].index != RID_AUTH_REASSEMBLER_SLOT_EMPTY) {
+        if (reassembler->slots[i].hash == hash &&
+            address_equal(&reassembler->partial[reassembler->slots[i].index - 1].address, address)) {
+            return i;
+        }
+        i = (i + 1) & reassembler->mask;
+    }
+    return i;
+}
+
+/* Backward shift deletion keeps probe sequences intact without tombstones. */
+static void delete_slot(rid_auth_reassembler_t *reassembler, uint32_t i) {
+    uint32_t j = i;
+
+    for (;;) {
+        j = (j + 1) & reassembler->mask;
+        if (reassembler->slots[j].index == RID_AUTH_REASSEMBLER_SLOT_EMPTY) {
+            break;
+        }
+
+        uint32_t home = reassembler->slots[j].hash & reassembler->mask;
+        if (((j - home) & reassembler->mask) >= ((j - i) & reassembler->mask)) {
+            reassembler->slots[i] = reassembler->slots[j];
+            i = j;
+        }
+    }
+    reassembler->slots[i].index = RID_AUTH_REASSEMBLER_SLOT_EMPTY;
+}
+
+/* Remove the set whose slot is known and fill the hole with the last one. */
+static void remove_at(rid_auth_reassembler_t *reassembler, uint32_t slot) {
+    size_t index = reassembler->slots[slot].index - 1;
+    size_t last = reassembler->count - 1;
+
+    delete_slot(reassembler, slot);
+
+    if (index != last) {
+        const rid_auth_partial_t *moved = &reassembler->partial[last];
+        uint32_t moved_slot = probe(reassembler, &moved->address, hash_address(&moved->address));
+
+        reassembler->partial[index] = *moved;
+        reassembler->slots[moved_slot].index = (uint32_t)index + 1;
+    }
+    reassembler->count = last;
+}
+
+size_t rid_auth_reassembler_storage_size(size_t capacity) {
+    if (capacity == 0 || capacity > RID_AUTH_REASSEMBLER_MAX_CAPACITY) {
+        return 0;
+    }
+    return rid_align_storage_size(
+        partial_size(capacity) + table_size(capacity) * sizeof(rid_auth_reassembler_slot_t), sizeof(uint64_t)
+    );
+}
+
+int rid_auth_reassembler_init(
+    rid_auth_reassembler_t *reassembler, void *storage, size_t storage_size, size_t capacity
+) {
+    if (reassembler == NULL || storage == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    if (capacity == 0 || capacity > RID_AUTH_REASSEMBLER_MAX_CAPACITY) {
+        return RID_ERROR_OUT_OF_RANGE;
+    }
+
+    if (storage_size < rid_auth_reassembler_storage_size(capacity)) {
+        return RID_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    uint8_t *p = rid_align_storage(storage, sizeof(uint64_t));
+
+    reassembler->capacity = capacity;
+    reassembler->mask = table_size(capacity) - 1;
+    reassembler->partial = (rid_auth_partial_t *)p;
+    reassembler->slots = (rid_auth_reassembler_slot_t *)(p + partial_size(capacity));
+
+    return rid_auth_reassembler_clear(reassembler);
+}
+
+int rid_auth_reassembler_clear(rid_auth_reassembler_t *reassembler) {
+    if (reassembler == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    reassembler->count = 0;
+    memset(reassembler->slots, 0, ((size_t)reassembler->mask + 1) * sizeof(rid_auth_reassembler_slot_t));
+
+    return RID_SUCCESS;
+}
+
+static void *page_at(rid_auth_t *auth, uint8_t page_number) {
+    if (page_number == 0) {
+        return &auth->page_0;
+    }
+    return &auth->page_x[page_number - 1];
+}
+
+/* Page 0 must announce enough pages to hold the signature. */
+static int validate_page_0(const rid_auth_page_0_t *page) {
+    if (page->last_page_index > RID_AUTH_MAX_PAGE_INDEX) {
+        return RID_ERROR_INVALID_LAST_PAGE_INDEX;
+    }
+
+    if (page->length > RID_AUTH_PAGE_0_DATA_SIZE + page->last_page_index * RID_AUTH_PAGE_DATA_SIZE) {
+        return RID_ERROR_INVALID_LAST_PAGE_INDEX;
+    }
+
+    return RID_SUCCESS;
+}
+
+/* Pages belong to the current set unless they contradict it. */
+static int same_set(const rid_auth_partial_t *partial, const void *message, uint8_t page_number) {
+    const rid_auth_page_x_t *page = (const rid_auth_page_x_t *)message;
+
+    if (partial->received == 0) {
+        return 1;
+    }
+
+    if (page->auth_type != partial->auth.page_0.auth_type) {
+        return 0;
+    }
+
+    if (partial->received & (1 << page_number)) {
+        const void *stored = page_number == 0
+            ? (const void *)&partial->auth.page_0
+            : (const void *)&partial->auth.page_x[page_number - 1];
+
+        return memcmp(stored, message, RID_MESSAGE_SIZE) == 0;
+    }
+
+    return 1;
+}
+
+static int complete(const rid_auth_partial_t *partial) {
+    if ((partial->received & 1) == 0) {
+        return 0;
+    }
+
+    uint16_t needed = (uint16_t)((2U << partial->auth.page_0.last_page_index) - 1);
+
+    return (partial->received & needed) == needed;
+}
+
+int rid_auth_reassembler_update(
+    rid_auth_reassembler_t *reassembler, const rid_address_t *address, const void *message,
+    uint64_t now, rid_auth_t *auth
+) {
+    if (reassembler == NULL || address == NULL || message == NULL || auth == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    if (rid_message_get_type(message) != RID_MESSAGE_TYPE_AUTH) {
+        return RID_ERROR_UNKNOWN_MESSAGE_TYPE;
+    }
+
+    uint8_t page_number = ((const rid_auth_page_x_t *)message)->page_number;
+
+    if (page_number == 0) {
+        int status = validate_page_0((const rid_auth_page_0_t *)message);
+        if (status != RID_SUCCESS) {
+            return status;
+        }
+    }
+
+    uint32_t hash = hash_address(address);
+    uint32_t slot = probe(reassembler, address, hash);
+    rid_auth_partial_t *partial;
+
+    if (reassembler->slots[slot].index == RID_AUTH_REASSEMBLER_SLOT_EMPTY) {
+        if (reassembler->count == reassembler->capacity) {
+            return RID_ERROR_BUFFER_TOO_SMALL;
+        }
+
+        partial = &reassembler->partial[reassembler->count];
+        partial->address = *address;
+        partial->received = 0;
+        partial->first_seen = now;
+
+        reassembler->count++;
+        reassembler->slots[slot].hash = hash;
+        reassembler->slots[slot].index = (uint32_t)reassembler->count;
+    } else {
+        partial = &reassembler->partial[reassembler->slots[slot].index - 1];
+    }
+
+    if (!same_set(partial, message, page_number)) {
+        partial->received = 0;
+        partial->first_seen = now;
+    }
+
+    /* Auth type of page 0 is used to match the pages of the set. */
+    if (partial->received == 0) {
+        memset(&partial->auth, 0, sizeof(rid_auth_t));
+        partial->auth.page_0.auth_type = ((const rid_auth_page_x_t *)message)->auth_type;
+    }
+
+    memcpy(page_at(&partial->auth, page_number), message, RID_MESSAGE_SIZE);
+    partial->received |= (uint16_t)(1 << page_number);
+    partial->last_seen = now;
+
+    if (!complete(partial)) {
+        return 0;
+    }
+
+    memcpy(auth, &partial->auth, sizeof(rid_auth_t));
+    remove_at(reassembler, slot);
+
+    return 1;
+}
+
+const rid_auth_partial_t *rid_auth_reassembler_find(
+    const rid_auth_reassembler_t *reassembler, const rid_address_t *address
+) {
+    if (reassembler == NULL || address == NULL) {
+        return NULL;
+    }
+
+    uint32_t slot = probe(reassembler, address, hash_address(address));
+
+    if (reassembler->slots[slot].index == RID_AUTH_REASSEMBLER_SLOT_EMPTY) {
+        return NULL;
+    }
+    return &reassembler->partial[reassembler->slots[slot].index - 1];
+}
+
+size_t rid_auth_reassembler_expire(rid_auth_reassembler_t *reassembler, uint64_t older_than) {
+    if (reassembler == NULL) {
+        return 0;
+    }
+
+    size_t removed = 0;
+    size_t i = 0;
+
+    /* A removal moves the last set to i so do not advance then. */
+    while (i < reassembler->count) {
+        const rid_auth_partial_t *partial = &reassembler->partial[i];
+
+        if (partial->last_seen < older_than) {
+            remove_at(reassembler, probe(reassembler, &partial->address, hash_address(&partial->address)));
+            removed++;
+        } else {
+            i++;
+        }
+    }
+
+    return removed;
+}
+
+size_t rid_auth_reassembler_count(const rid_auth_reassembler_t *reassembler) {
+    if (reassembler == NULL) {
+        return 0;
+    }
+    return reassembler->count;
+}
@@ -0,0 +1,188 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of librid: https://github.com/tuupola/librid
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "rid/auth.h"
+#include "rid/auth_signer.h"
+#include "rid/basic_id.h"
+#include "rid/message.h"
+#include "rid/message_pack.h"
+
+/* Only the known message types other than Auth can be signed. */
+static int signable(const void *message) {
+    rid_message_type_t type = rid_message_get_type(message);
+
+    return type <= RID_MESSAGE_TYPE_OPERATOR_ID && type != RID_MESSAGE_TYPE_AUTH;
+}
+
+/* Basic ID messages of different ID types are separate messages. */
+static int same_slot(const rid_message_t *a, const rid_message_t *b) {
+    if (a->message_type != b->message_type) {
+        return 0;
+    }
+
+    if (a->message_type == RID_MESSAGE_TYPE_BASIC_ID) {
+        return ((const rid_basic_id_t *)a)->id_type == ((const rid_basic_id_t *)b)->id_type;
+    }
+
+    return 1;
+}
+
+/* Keep the pack and the payload in sync, only the given slot is copied. */
+static void store(rid_auth_signer_t *signer, uint8_t index, const void *message) {
+    memcpy(&signer->pack.messages[index * RID_MESSAGE_SIZE], message, RID_MESSAGE_SIZE);
+    memcpy(&signer->payload[index * RID_MESSAGE_SIZE], message, RID_MESSAGE_SIZE);
+}
+
+int rid_auth_signer_init(rid_auth_signer_t *signer, const rid_message_pack_t *pack) {
+    if (signer == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    if (pack != NULL) {
+        int status = rid_message_pack_validate(pack);
+        if (status != RID_SUCCESS) {
+            return status;
+        }
+    }
+
+    rid_message_pack_init(&signer->pack);
+    memset(signer->payload, 0, sizeof(signer->payload));
+
+    if (pack == NULL) {
+        return RID_SUCCESS;
+    }
+
+    signer->pack.protocol_version = pack->protocol_version;
+
+    for (uint8_t i = 0; i < pack->message_count; ++i) {
+        const void *message = rid_message_pack_get_message_at(pack, i);
+
+        if (rid_message_get_type(message) != RID_MESSAGE_TYPE_AUTH) {
+            store(signer, signer->pack.message_count++, message);
+        }
+    }
+
+    return RID_SUCCESS;
+}
+
+int rid_auth_signer_set_message(rid_auth_signer_t *signer, const void *message) {
+    if (signer == NULL || message == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    if (!signable(message)) {
+        return RID_ERROR_INVALID_MESSAGE_TYPE;
+    }
+
+    for (uint8_t i = 0; i < signer->pack.message_count; ++i) {
+        if (same_slot((const rid_message_t *)&signer->pack.messages[i * RID_MESSAGE_SIZE], (const rid_message_t *)message)) {
+            store(signer, i, message);
+            return RID_SUCCESS;
+        }
+    }
+
+    if (signer->pack.message_count >= RID_MESSAGE_PACK_MAX_MESSAGES) {
+        return RID_ERROR_OUT_OF_RANGE;
+    }
+
+    store(signer, signer->pack.message_count++, message);
+
+    return RID_SUCCESS;
+}
+
+int rid_auth_signer_set_message_at(rid_auth_signer_t *signer, uint8_t index, const void *message) {
+    if (signer == NULL || message == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    if (!signable(message)) {
+        return RID_ERROR_INVALID_MESSAGE_TYPE;
+    }
+
+    if (index >= signer->pack.message_count) {
+        return RID_ERROR_OUT_OF_RANGE;
+    }
+
+    store(signer, index, message);
+
+    return RID_SUCCESS;
+}
+
+const rid_message_pack_t *rid_auth_signer_get_pack(const rid_auth_signer_t *signer) {
+    if (signer == NULL) {
+        return NULL;
+    }
+    return &signer->pack;
+}
+
+int rid_auth_signer_sign(
+    rid_auth_signer_t *signer, rid_auth_t *auth, rid_auth_sign_cb_t callback, void *context
+) {
+    if (signer == NULL || auth == NULL || callback == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    int rc = rid_auth_validate(auth);
+    if (rc != RID_SUCCESS) {
+        return rc;
+    }
+
+    rc = rid_auth_set_type(auth, RID_AUTH_TYPE_MESSAGE_SET_SIGNATURE);
+    if (rc != RID_SUCCESS) {
+        return rc;
+    }
+
+    /* Only the timestamp after the messages changes between signatures. */
+    size_t payload_length = signer->pack.message_count * RID_MESSAGE_SIZE;
+    uint32_t timestamp = rid_auth_get_timestamp(auth);
+
+    memcpy(&signer->payload[payload_length], &timestamp, sizeof(timestamp));
+    payload_length += sizeof(timestamp);
+
+    uint8_t signature[RID_AUTH_PAGE_MAX_SIGNATURE_SIZE];
+    size_t signature_length = 0;
+
+    rc = callback(context, signer->payload, payload_length, signature, sizeof(signature), &signature_length);
+    if (rc != 0) {
+        return rc;
+    }
+
+    if (signature_length == 0) {
+        return RID_ERROR_OUT_OF_RANGE;
+    }
+
+    return rid_auth_set_signature(auth, signature, signature_length);
+}
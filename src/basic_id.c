@@ -286,14 +286,9 @@ static size_t session_id_to_hex(const uint8_t *data, size_t data_size, char *hex
     return pos;
 }
 
-int rid_basic_id_to_json(const rid_basic_id_t *message, char *buffer, size_t buffer_size, size_t *needed_size) {
-    rid_json_t json;
+void rid_basic_id_json_write(rid_json_t *json, const rid_basic_id_t *message) {
     char uas_id[RID_UAS_ID_SIZE * 2 + 1];
 
-    if (message == NULL || (buffer == NULL && needed_size == NULL)) {
-        return RID_ERROR_NULL_POINTER;
-    }
-
     if (rid_basic_id_get_type(message) == RID_ID_TYPE_UTM_ASSIGNED_UUID) {
         char raw[RID_UAS_ID_SIZE + 1];
         rid_basic_id_get_uas_id(message, raw, sizeof(raw));
@@ -306,29 +301,97 @@ int rid_basic_id_to_json(const rid_basic_id_t *message, char *buffer, size_t buf
         rid_basic_id_get_uas_id(message, uas_id, sizeof(uas_id));
     }
 
+    rid_json_object_start(json);
+    rid_json_key(json, "protocol_version");
+    rid_json_uint(json, rid_message_get_protocol_version(message));
+    rid_json_key(json, "message_type");
+    rid_json_uint(json, rid_message_get_type(message));
+    rid_json_key(json, "id_type");
+    rid_json_uint(json, rid_basic_id_get_type(message));
+    rid_json_key(json, "ua_type");
+    rid_json_uint(json, rid_basic_id_get_ua_type(message));
+    rid_json_key(json, "uas_id");
+    rid_json_string(json, uas_id);
+    rid_json_object_end(json);
+}
+
+int rid_basic_id_to_json(const rid_basic_id_t *message, char *buffer, size_t buffer_size, size_t *needed_size) {
+    rid_json_t json;
+
+    if (message == NULL || (buffer == NULL && needed_size == NULL)) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
     rid_json_start(&json, buffer, buffer_size);
-    rid_json_key(&json, "protocol_version");
-    rid_json_uint(&json, rid_message_get_protocol_version(message));
-    rid_json_key(&json, "message_type");
-    rid_json_uint(&json, rid_message_get_type(message));
-    rid_json_key(&json, "id_type");
-    rid_json_uint(&json, rid_basic_id_get_type(message));
-    rid_json_key(&json, "ua_type");
-    rid_json_uint(&json, rid_basic_id_get_ua_type(message));
-    rid_json_key(&json, "uas_id");
-    rid_json_string(&json, uas_id);
-    rid_json_end(&json);
-
-    if (needed_size != NULL) {
-        *needed_size = json.position + 1;
+    rid_basic_id_json_write(&json, message);
+
+    return rid_json_end(&json, needed_size);
+}
+
+int rid_basic_id_to_json_sink(const rid_basic_id_t *message, const rid_json_sink_t *sink) {
+    rid_json_t json;
+
+    if (message == NULL || sink == NULL || sink->write == NULL) {
+        return RID_ERROR_NULL_POINTER;
     }
 
-    if (buffer == NULL) {
-        return RID_SUCCESS;
+    rid_json_start_sink(&json, sink);
+    rid_basic_id_json_write(&json, message);
+
+    return rid_json_end(&json, NULL);
+}
+
+int rid_basic_id_to_cbor(const rid_basic_id_t *message, uint8_t *buffer, size_t buffer_size, size_t *needed_size) {
+    rid_json_t json;
+
+    if (message == NULL || (buffer == NULL && needed_size == NULL)) {
+        return RID_ERROR_NULL_POINTER;
     }
 
-    if (json.position + 1 > buffer_size) {
-        return RID_ERROR_BUFFER_TOO_SMALL;
+    rid_cbor_start(&json, buffer, buffer_size);
+    rid_basic_id_json_write(&json, message);
+
+    return rid_json_end(&json, needed_size);
+}
+
+int rid_basic_id_json_read(rid_json_object_t *object, rid_basic_id_t *message) {
+    uint32_t value;
+    int status;
+
+    rid_basic_id_init(message);
+
+    status = rid_json_get_uint(object, "id_type", UINT8_MAX, &value);
+    if (status == RID_SUCCESS) {
+        status = rid_basic_id_set_type(message, (rid_basic_id_type_t)value);
+    }
+    if (status < RID_SUCCESS) {
+        return status;
+    }
+
+    status = rid_json_get_uint(object, "ua_type", UINT8_MAX, &value);
+    if (status == RID_SUCCESS) {
+        status = rid_basic_id_set_ua_type(message, (rid_ua_type_t)value);
+    }
+    if (status < RID_SUCCESS) {
+        return status;
+    }
+
+    /* UUID and session ID were written as hex, see above. */
+    if (rid_basic_id_get_type(message) == RID_ID_TYPE_UTM_ASSIGNED_UUID ||
+        rid_basic_id_get_type(message) == RID_ID_TYPE_SPECIFIC_SESSION_ID) {
+        size_t length;
+
+        status = rid_json_get_hex(object, "uas_id", (uint8_t *)message->uas_id, RID_UAS_ID_SIZE, &length);
+    } else {
+        char uas_id[RID_UAS_ID_SIZE + 1];
+
+        status = rid_json_get_string(object, "uas_id", uas_id, sizeof(uas_id));
+        if (status == RID_SUCCESS) {
+            status = rid_basic_id_set_uas_id(message, uas_id);
+        }
+    }
+    if (status < RID_SUCCESS) {
+        return status;
     }
 
     return RID_SUCCESS;
@@ -0,0 +1,207 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of librid: https://github.com/tuupola/librid
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "rid/beacon.h"
+#include "rid/message.h"
+#include "rid/message_pack.h"
+#include "rid/transport.h"
+
+/* OUI and vendor type following the element ID and length. */
+static const uint8_t rid_beacon_vendor[4] = {
+    (RID_TRANSPORT_WIFI_BEACON_OUI >> 16) & 0xFF,
+    (RID_TRANSPORT_WIFI_BEACON_OUI >> 8) & 0xFF,
+    RID_TRANSPORT_WIFI_BEACON_OUI & 0xFF,
+    RID_TRANSPORT_WIFI_BEACON_VENDOR_TYPE,
+};
+
+/*
+ * Offset of the Remote ID element or size if there is none. Offsets are
+ * used instead of pointers so stepping past the end is harmless and the
+ * loop needs no separate bounds check for skipped elements.
+ */
+static size_t rid_beacon_find(const uint8_t *elements, size_t size) {
+    size_t offset = 0;
+
+    while (offset + 2 + sizeof(rid_beacon_vendor) <= size) {
+        if (elements[offset] == RID_BEACON_ELEMENT_ID_VENDOR_SPECIFIC &&
+            elements[offset + 1] >= sizeof(rid_beacon_vendor) &&
+            memcmp(&elements[offset + 2], rid_beacon_vendor, sizeof(rid_beacon_vendor)) == 0) {
+            return offset;
+        }
+        offset += 2 + (size_t)elements[offset + 1];
+    }
+
+    return size;
+}
+
+/* Counter followed by a Message Pack. */
+static int rid_beacon_parse_service_info(const uint8_t *data, size_t size, rid_beacon_frame_t *frame) {
+    rid_message_pack_view_t view;
+
+    if (size < 1 + RID_MESSAGE_PACK_HEADER_SIZE) {
+        return RID_ERROR_INVALID_MESSAGE_SIZE;
+    }
+
+    int status = rid_message_pack_view_init(&view, data + 1, size - 1);
+    if (status != RID_SUCCESS) {
+        return status;
+    }
+
+    frame->message_size = view.size;
+
+    frame->counter = data[0];
+    frame->message = data + 1;
+
+    return RID_SUCCESS;
+}
+
+int rid_beacon_parse_elements(const uint8_t *elements, size_t size, rid_beacon_frame_t *frame) {
+    size_t offset;
+    size_t length;
+
+    if (NULL == elements || NULL == frame) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    offset = rid_beacon_find(elements, size);
+    if (offset == size) {
+        return RID_ERROR_NOT_FOUND;
+    }
+
+    /* Truncated element, parse only what was received. */
+    length = elements[offset + 1];
+    if (length > size - offset - 2) {
+        length = size - offset - 2;
+    }
+
+    return rid_beacon_parse_service_info(
+        &elements[offset + 2 + sizeof(rid_beacon_vendor)], length - sizeof(rid_beacon_vendor), frame
+    );
+}
+
+int rid_beacon_parse(const uint8_t *body, size_t size, rid_beacon_frame_t *frame) {
+    if (NULL == body || NULL == frame) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    if (size < RID_BEACON_FIXED_SIZE) {
+        return RID_ERROR_NOT_FOUND;
+    }
+
+    return rid_beacon_parse_elements(body + RID_BEACON_FIXED_SIZE, size - RID_BEACON_FIXED_SIZE, frame);
+}
+
+int rid_beacon_build(
+    const rid_message_pack_t *pack, uint8_t counter, uint8_t *buffer, size_t buffer_size, size_t *written
+) {
+    size_t size;
+
+    if (NULL == pack || NULL == buffer) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    if (pack->message_count > RID_MESSAGE_PACK_MAX_MESSAGES) {
+        return RID_ERROR_INVALID_MESSAGE_COUNT;
+    }
+    size = rid_message_pack_size(pack);
+
+    if (buffer_size < RID_BEACON_HEADER_SIZE + size) {
+        return RID_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    /* Length counts the bytes after the length byte itself. */
+    buffer[0] = RID_BEACON_ELEMENT_ID_VENDOR_SPECIFIC;
+    buffer[1] = (uint8_t)(RID_BEACON_HEADER_SIZE - 2 + size);
+    memcpy(&buffer[2], rid_beacon_vendor, sizeof(rid_beacon_vendor));
+    buffer[6] = counter;
+    memcpy(&buffer[RID_BEACON_HEADER_SIZE], pack, size);
+
+    if (written != NULL) {
+        *written = RID_BEACON_HEADER_SIZE + size;
+    }
+
+    return RID_SUCCESS;
+}
+
+int rid_beacon_update(
+    uint8_t *body, size_t *size, size_t capacity, const rid_message_pack_t *pack, uint8_t counter
+) {
+    uint8_t *elements;
+    size_t elements_size;
+    size_t offset;
+    size_t old_size = 0;
+    size_t new_size;
+
+    if (NULL == body || NULL == size || NULL == pack) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    if (*size < RID_BEACON_FIXED_SIZE || *size > capacity) {
+        return RID_ERROR_INVALID_MESSAGE_SIZE;
+    }
+
+    if (pack->message_count > RID_MESSAGE_PACK_MAX_MESSAGES) {
+        return RID_ERROR_INVALID_MESSAGE_COUNT;
+    }
+    new_size = RID_BEACON_HEADER_SIZE + rid_message_pack_size(pack);
+
+    elements = body + RID_BEACON_FIXED_SIZE;
+    elements_size = *size - RID_BEACON_FIXED_SIZE;
+    offset = rid_beacon_find(elements, elements_size);
+
+    if (offset < elements_size) {
+        old_size = 2 + (size_t)elements[offset + 1];
+        if (old_size > elements_size - offset) {
+            old_size = elements_size - offset;
+        }
+    }
+
+    if (*size - old_size + new_size > capacity) {
+        return RID_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    /* Move the following elements when the element changes size. */
+    if (old_size != new_size && offset < elements_size) {
+        memmove(
+            &elements[offset + new_size], &elements[offset + old_size], elements_size - offset - old_size
+        );
+    }
+
+    rid_beacon_build(pack, counter, &elements[offset], new_size, NULL);
+    *size = *size - old_size + new_size;
+
+    return RID_SUCCESS;
+}
@@ -0,0 +1,149 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of librid: https://github.com/tuupola/librid
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "rid/bluetooth.h"
+#include "rid/message.h"
+#include "rid/message_pack.h"
+#include "rid/transport.h"
+
+int rid_bluetooth_parse_service_data(const uint8_t *data, size_t size, rid_bluetooth_frame_t *frame) {
+    if (NULL == data || NULL == frame) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    if (size < 1 || data[0] != RID_TRANSPORT_BLUETOOTH_APP_CODE) {
+        return RID_ERROR_NOT_FOUND;
+    }
+
+    if (size < 2 + RID_MESSAGE_SIZE) {
+        return RID_ERROR_INVALID_MESSAGE_SIZE;
+    }
+
+    /* Long range advertisements carry a Message Pack, legacy ones a single message. */
+    if (rid_message_get_type(data + 2) == RID_MESSAGE_TYPE_MESSAGE_PACK) {
+        rid_message_pack_view_t view;
+
+        int status = rid_message_pack_view_init(&view, data + 2, size - 2);
+        if (status != RID_SUCCESS) {
+            return status;
+        }
+        frame->message_size = view.size;
+    } else {
+        frame->message_size = RID_MESSAGE_SIZE;
+    }
+
+    frame->counter = data[1];
+    frame->message = data + 2;
+
+    return RID_SUCCESS;
+}
+
+int rid_bluetooth_parse(const uint8_t *payload, size_t size, rid_bluetooth_frame_t *frame) {
+    if (NULL == payload || NULL == frame) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    const uint8_t *end = payload + size;
+    const uint8_t *p = payload;
+
+    /* Each AD structure is a length byte followed by type and data. */
+    while (end - p >= 4) {
+        size_t length = p[0];
+
+        /* Zero length marks the end of significant data. */
+        if (length == 0) {
+            break;
+        }
+
+        if (p[1] == RID_BLUETOOTH_AD_TYPE_SERVICE_DATA &&
+            p[2] == (RID_TRANSPORT_BLUETOOTH_OUI & 0xFF) &&
+            p[3] == (RID_TRANSPORT_BLUETOOTH_OUI >> 8)) {
+            /* Truncated structure, parse only what was received. */
+            if (length + 1 > (size_t)(end - p)) {
+                length = (size_t)(end - p) - 1;
+            }
+            if (length < 4) {
+                return RID_ERROR_INVALID_MESSAGE_SIZE;
+            }
+            return rid_bluetooth_parse_service_data(p + 4, length - 3, frame);
+        }
+
+        if (length >= (size_t)(end - p)) {
+            break;
+        }
+        p += length + 1;
+    }
+
+    return RID_ERROR_NOT_FOUND;
+}
+
+int rid_bluetooth_build(
+    const void *message, uint8_t counter, uint8_t *buffer, size_t buffer_size, size_t *written
+) {
+    size_t size = RID_MESSAGE_SIZE;
+
+    if (NULL == message || NULL == buffer) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    if (rid_message_get_type(message) == RID_MESSAGE_TYPE_MESSAGE_PACK) {
+        const rid_message_pack_t *pack = (const rid_message_pack_t *)message;
+
+        if (pack->message_count > RID_MESSAGE_PACK_MAX_MESSAGES) {
+            return RID_ERROR_INVALID_MESSAGE_COUNT;
+        }
+        size = rid_message_pack_size(pack);
+    }
+
+    if (buffer_size < RID_BLUETOOTH_HEADER_SIZE + size) {
+        return RID_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    /* Length counts the bytes after the length byte itself. */
+    buffer[0] = (uint8_t)(RID_BLUETOOTH_HEADER_SIZE - 1 + size);
+    buffer[1] = RID_BLUETOOTH_AD_TYPE_SERVICE_DATA;
+    buffer[2] = RID_TRANSPORT_BLUETOOTH_OUI & 0xFF;
+    buffer[3] = RID_TRANSPORT_BLUETOOTH_OUI >> 8;
+    buffer[4] = RID_TRANSPORT_BLUETOOTH_APP_CODE;
+    buffer[5] = counter;
+    memcpy(&buffer[RID_BLUETOOTH_HEADER_SIZE], message, size);
+
+    if (written != NULL) {
+        *written = RID_BLUETOOTH_HEADER_SIZE + size;
+    }
+
+    return RID_SUCCESS;
+}
@@ -0,0 +1,245 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of librid: https://github.com/tuupola/librid
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "rid/auth_page.h"
+#include "rid/basic_id.h"
+#include "rid/decode.h"
+#include "rid/location.h"
+#include "rid/message.h"
+#include "rid/operator_id.h"
+#include "rid/self_id.h"
+#include "rid/system.h"
+
+/*
+ * The decoders below read the packed fields directly instead of going
+ * through the getters. Conversions must stay in sync with the getters,
+ * tests compare both.
+ */
+
+static void decode_basic_id(const rid_basic_id_t *message, rid_decoded_basic_id_t *decoded) {
+    decoded->id_type = (rid_basic_id_type_t)message->id_type;
+    decoded->ua_type = (rid_ua_type_t)message->ua_type;
+    memcpy(decoded->uas_id, message->uas_id, RID_UAS_ID_SIZE);
+    decoded->uas_id[RID_UAS_ID_SIZE] = '\0';
+}
+
+static void decode_location(const rid_location_t *message, rid_decoded_location_t *decoded) {
+    decoded->operational_status = (rid_operational_status_t)message->operational_status;
+    decoded->height_type = (rid_height_type_t)message->height_type;
+
+    if (message->track_direction == RID_TRACK_DIRECTION_UNKNOWN_ENCODED) {
+        decoded->track_direction = RID_TRACK_DIRECTION_UNKNOWN;
+    } else if (message->ew_direction == RID_EW_DIRECTION_EAST) {
+        decoded->track_direction = (uint16_t)message->track_direction;
+    } else {
+        decoded->track_direction = (uint16_t)(message->track_direction + 180);
+    }
+
+    if (message->speed == RID_SPEED_INVALID_ENCODED && message->speed_multiplier == 1) {
+        decoded->speed = RID_SPEED_INVALID;
+    } else if (message->speed_multiplier == 0) {
+        decoded->speed = (float)message->speed * 0.25f;
+    } else {
+        decoded->speed = ((float)message->speed * 0.75f) + (255.0f * 0.25f);
+    }
+
+    if (message->vertical_speed == RID_VERTICAL_SPEED_INVALID_ENCODED) {
+        decoded->vertical_speed = RID_VERTICAL_SPEED_INVALID;
+    } else {
+        decoded->vertical_speed = (float)message->vertical_speed * 0.5f;
+    }
+
+    if (message->latitude == 0 && message->longitude == 0) {
+        decoded->latitude = RID_LATITUDE_INVALID;
+        decoded->longitude = RID_LONGITUDE_INVALID;
+    } else {
+        decoded->latitude = (double)message->latitude / 10000000.0;
+        decoded->longitude = (double)message->longitude / 10000000.0;
+    }
+
+    if (message->pressure_altitude == RID_PRESSURE_ALTITUDE_INVALID_ENCODED) {
+        decoded->pressure_altitude = RID_PRESSURE_ALTITUDE_INVALID;
+    } else {
+        decoded->pressure_altitude = ((float)message->pressure_altitude * 0.5f) - 1000.0f;
+    }
+
+    if (message->geodetic_altitude == RID_GEODETIC_ALTITUDE_INVALID_ENCODED) {
+        decoded->geodetic_altitude = RID_GEODETIC_ALTITUDE_INVALID;
+    } else {
+        decoded->geodetic_altitude = ((float)message->geodetic_altitude * 0.5f) - 1000.0f;
+    }
+
+    if (message->height == RID_HEIGHT_INVALID_ENCODED) {
+        decoded->height = RID_HEIGHT_INVALID;
+    } else {
+        decoded->height = ((float)message->height * 0.5f) - 1000.0f;
+    }
+
+    decoded->horizontal_accuracy = (rid_horizontal_accuracy_t)message->horizontal_accuracy;
+    decoded->vertical_accuracy = (rid_vertical_accuracy_t)message->vertical_accuracy;
+    decoded->speed_accuracy = (rid_speed_accuracy_t)message->speed_accuracy;
+    decoded->baro_altitude_accuracy = (rid_vertical_accuracy_t)message->baro_altitude_accuracy;
+    decoded->timestamp = message->timestamp;
+    decoded->timestamp_accuracy = (rid_timestamp_accuracy_t)message->timestamp_accuracy;
+}
+
+static void decode_auth(const void *message, rid_decoded_auth_page_t *decoded) {
+    const rid_auth_page_0_t *page_0 = (const rid_auth_page_0_t *)message;
+    const rid_auth_page_x_t *page_x = (const rid_auth_page_x_t *)message;
+
+    decoded->page_number = page_0->page_number;
+    decoded->auth_type = (rid_auth_type_t)page_0->auth_type;
+
+    if (page_0->page_number == 0) {
+        /* Mask reserved bits [7..4] per ASTM F3411-22a Table 8 */
+        decoded->last_page_index = page_0->last_page_index & 0x0F;
+        decoded->length = page_0->length;
+        decoded->timestamp = page_0->timestamp;
+        decoded->data_size = RID_AUTH_PAGE_0_DATA_SIZE;
+        memcpy(decoded->data, page_0->auth_data, RID_AUTH_PAGE_0_DATA_SIZE);
+        memset(
+            decoded->data + RID_AUTH_PAGE_0_DATA_SIZE,
+            0,
+            RID_AUTH_PAGE_DATA_SIZE - RID_AUTH_PAGE_0_DATA_SIZE
+        );
+    } else {
+        decoded->last_page_index = 0;
+        decoded->length = 0;
+        decoded->timestamp = 0;
+        decoded->data_size = RID_AUTH_PAGE_DATA_SIZE;
+        memcpy(decoded->data, page_x->auth_data, RID_AUTH_PAGE_DATA_SIZE);
+    }
+}
+
+static void decode_self_id(const rid_self_id_t *message, rid_decoded_self_id_t *decoded) {
+    decoded->description_type = (rid_description_type_t)message->description_type;
+    memcpy(decoded->description, message->description, RID_DESCRIPTION_SIZE);
+    decoded->description[RID_DESCRIPTION_SIZE] = '\0';
+}
+
+static void decode_system(const rid_system_t *message, rid_decoded_system_t *decoded) {
+    decoded->operator_location_type = (rid_operator_location_type_t)message->operator_location_type;
+    decoded->classification_type = (rid_classification_type_t)message->classification_type;
+    decoded->ua_classification_category = (rid_ua_classification_category_t)message->ua_classification_category;
+    decoded->ua_classification_class = (rid_ua_classification_class_t)message->ua_classification_class;
+
+    if (message->operator_latitude == 0 && message->operator_longitude == 0) {
+        decoded->operator_latitude = RID_OPERATOR_LATITUDE_INVALID;
+        decoded->operator_longitude = RID_OPERATOR_LONGITUDE_INVALID;
+    } else {
+        decoded->operator_latitude = (double)message->operator_latitude / 10000000.0;
+        decoded->operator_longitude = (double)message->operator_longitude / 10000000.0;
+    }
+
+    decoded->operator_altitude = ((float)message->operator_altitude * 0.5f) - 1000.0f;
+    decoded->area_count = message->area_count;
+    decoded->area_radius = (uint16_t)message->area_radius * 10;
+    decoded->area_ceiling = ((float)message->area_ceiling * 0.5f) - 1000.0f;
+    decoded->area_floor = ((float)message->area_floor * 0.5f) - 1000.0f;
+    decoded->timestamp = message->timestamp;
+}
+
+static void decode_operator_id(const rid_operator_id_t *message, rid_decoded_operator_id_t *decoded) {
+    decoded->id_type = (rid_operator_id_type_t)message->id_type;
+    memcpy(decoded->operator_id, message->operator_id, RID_OPERATOR_ID_SIZE);
+    decoded->operator_id[RID_OPERATOR_ID_SIZE] = '\0';
+}
+
+/* Validate and decode with a single dispatch on the message type. */
+static int decode(const void *message, rid_decoded_t *decoded) {
+    const rid_message_t *header = (const rid_message_t *)message;
+
+    decoded->protocol_version = (rid_protocol_version_t)header->protocol_version;
+    decoded->message_type = (rid_message_type_t)header->message_type;
+
+    switch (decoded->message_type) {
+        case RID_MESSAGE_TYPE_BASIC_ID:
+            decode_basic_id((const rid_basic_id_t *)message, &decoded->message.basic_id);
+            return rid_basic_id_validate((const rid_basic_id_t *)message);
+        case RID_MESSAGE_TYPE_LOCATION:
+            decode_location((const rid_location_t *)message, &decoded->message.location);
+            return rid_location_validate((const rid_location_t *)message);
+        case RID_MESSAGE_TYPE_AUTH:
+            decode_auth(message, &decoded->message.auth);
+            return rid_auth_page_validate(message);
+        case RID_MESSAGE_TYPE_SELF_ID:
+            decode_self_id((const rid_self_id_t *)message, &decoded->message.self_id);
+            return rid_self_id_validate((const rid_self_id_t *)message);
+        case RID_MESSAGE_TYPE_SYSTEM:
+            decode_system((const rid_system_t *)message, &decoded->message.system);
+            return rid_system_validate((const rid_system_t *)message);
+        case RID_MESSAGE_TYPE_OPERATOR_ID:
+            decode_operator_id((const rid_operator_id_t *)message, &decoded->message.operator_id);
+            return rid_operator_id_validate((const rid_operator_id_t *)message);
+        case RID_MESSAGE_TYPE_MESSAGE_PACK:
+            return RID_ERROR_INVALID_MESSAGE_TYPE;
+        default:
+            return RID_ERROR_UNKNOWN_MESSAGE_TYPE;
+    }
+}
+
+int rid_decode_message(const void *message, rid_decoded_t *decoded) {
+    if (message == NULL || decoded == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    return decode(message, decoded);
+}
+
+int rid_decode_batch(
+    const void *messages, size_t stride, size_t count, rid_decoded_t *decoded, int *errors
+) {
+    if (messages == NULL || decoded == NULL || errors == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    if (stride == 0) {
+        stride = RID_MESSAGE_SIZE;
+    }
+
+    if (stride < RID_MESSAGE_SIZE) {
+        return RID_ERROR_OUT_OF_RANGE;
+    }
+
+    const uint8_t *message = (const uint8_t *)messages;
+
+    for (size_t i = 0; i < count; ++i) {
+        errors[i] = decode(message, &decoded[i]);
+        message += stride;
+    }
+
+    return RID_SUCCESS;
+}
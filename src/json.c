@@ -30,68 +30,330 @@
  *
  */
 
+#include <stdint.h>
 #include <stdio.h>
+#include <string.h>
+
+#include "rid/json.h"
+#include "rid/message.h"
 
 #include "json.h"
 
-static void rid_json_putc(rid_json_t *json, char c) {
-    if (json->buffer != NULL && json->buffer_size > 0) {
-        if (json->position + 1 < json->buffer_size) {
-            json->buffer[json->position] = c;
-            json->buffer[json->position + 1] = '\0';
-        } else {
-            json->buffer[json->buffer_size - 1] = '\0';
+static const char rid_json_digits[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+/*
+ * Write decimal digits of value so that they end just before end.
+ * Two digits are produced per division. Returns the number of digits.
+ */
+static size_t rid_json_format_uint(char *end, uint32_t value) {
+    char *p = end;
+
+    while (value >= 100) {
+        unsigned pair = (unsigned)(value % 100) * 2;
+        value /= 100;
+        *--p = rid_json_digits[pair + 1];
+        *--p = rid_json_digits[pair];
+    }
+    if (value >= 10) {
+        unsigned pair = (unsigned)value * 2;
+        *--p = rid_json_digits[pair + 1];
+        *--p = rid_json_digits[pair];
+    } else {
+        *--p = (char)('0' + value);
+    }
+
+    return (size_t)(end - p);
+}
+
+/* Pass staged output to the sink. After the first error output is discarded. */
+static void rid_json_flush(rid_json_t *json) {
+    size_t staged = json->position - json->flushed;
+
+    if (staged > 0 && json->status == RID_SUCCESS) {
+        json->status = json->sink->write(json->sink->context, json->staging, staged);
+    }
+    json->flushed = json->position;
+}
+
+static void rid_json_sink_puts(rid_json_t *json, const char *s, size_t length) {
+    if (json->position - json->flushed + length > RID_JSON_STAGING_SIZE) {
+        rid_json_flush(json);
+    }
+
+    if (length >= RID_JSON_STAGING_SIZE) {
+        /* Too large to stage, write through. */
+        if (json->status == RID_SUCCESS) {
+            json->status = json->sink->write(json->sink->context, s, length);
         }
+        json->position += length;
+        json->flushed = json->position;
+        return;
     }
-    ++json->position;
+
+    memcpy(json->staging + (json->position - json->flushed), s, length);
+    json->position += length;
 }
 
+/* Copy as much as fits. JSON output always leaves room for the terminating NUL. */
 static void rid_json_puts(rid_json_t *json, const char *s, size_t length) {
-    size_t i;
+    if (json->sink != NULL) {
+        rid_json_sink_puts(json, s, length);
+        return;
+    }
+
+    if (json->buffer != NULL && json->position < json->capacity) {
+        size_t available = json->capacity - json->position;
+        memcpy(json->buffer + json->position, s, length < available ? length : available);
+    }
+    json->position += length;
+}
+
+static void rid_json_putc(rid_json_t *json, char c) {
+    if (json->sink != NULL) {
+        rid_json_sink_puts(json, &c, 1);
+        return;
+    }
 
-    for (i = 0; i < length; ++i) {
-        rid_json_putc(json, s[i]);
+    if (json->buffer != NULL && json->position < json->capacity) {
+        json->buffer[json->position] = c;
     }
+    ++json->position;
+}
+
+#define RID_JSON_ONES 0x0101010101010101ULL
+#define RID_JSON_HIGHS 0x8080808080808080ULL
+
+/*
+ * Nonzero if any byte in word is a quote, a backslash or below 0x20.
+ * Classic SWAR zero byte test, exact for bytes below 0x80 which is all
+ * that can match.
+ */
+static uint64_t rid_json_needs_escape(uint64_t word) {
+    uint64_t quote = word ^ (RID_JSON_ONES * '"');
+    uint64_t backslash = word ^ (RID_JSON_ONES * '\\');
+    uint64_t control = word;
+
+    quote = (quote - RID_JSON_ONES) & ~quote;
+    backslash = (backslash - RID_JSON_ONES) & ~backslash;
+    control = (control - RID_JSON_ONES * 0x20) & ~control;
+
+    return (quote | backslash | control) & RID_JSON_HIGHS;
+}
+
+static int rid_json_is_special(unsigned char c) {
+    return c == '"' || c == '\\' || c < 0x20;
 }
 
 static void rid_json_escape(rid_json_t *json, const char *s) {
     static const char hex[] = "0123456789abcdef";
-    const unsigned char *p;
-
-    for (p = (const unsigned char *)s; *p != '\0'; ++p) {
-        if (*p == '"' || *p == '\\') {
-            rid_json_putc(json, '\\');
-            rid_json_putc(json, (char)*p);
-        } else if (*p < 0x20) {
-            rid_json_putc(json, '\\');
-            rid_json_putc(json, 'u');
-            rid_json_putc(json, '0');
-            rid_json_putc(json, '0');
-            rid_json_putc(json, hex[*p >> 4]);
-            rid_json_putc(json, hex[*p & 0x0FU]);
-        } else {
-            rid_json_putc(json, (char)*p);
+    size_t length = strlen(s);
+    size_t run = 0;
+    size_t i = 0;
+
+    while (i < length) {
+        /* Skip clean words eight bytes at a time. */
+        while (i + sizeof(uint64_t) <= length) {
+            uint64_t word;
+
+            memcpy(&word, s + i, sizeof(word));
+            if (rid_json_needs_escape(word)) {
+                break;
+            }
+            i += sizeof(uint64_t);
+        }
+
+        while (i < length && !rid_json_is_special((unsigned char)s[i])) {
+            ++i;
+        }
+
+        rid_json_puts(json, s + run, i - run);
+
+        if (i < length) {
+            unsigned char c = (unsigned char)s[i];
+
+            if (c == '"' || c == '\\') {
+                char token[2] = {'\\', (char)c};
+                rid_json_puts(json, token, sizeof(token));
+            } else {
+                char token[6] = {'\\', 'u', '0', '0', hex[c >> 4], hex[c & 0x0FU]};
+                rid_json_puts(json, token, sizeof(token));
+            }
+            run = ++i;
+        }
+    }
+}
+
+/* CBOR initial bytes, RFC 8949 section 3. */
+#define RID_CBOR_UNSIGNED 0x00
+#define RID_CBOR_TEXT 0x60
+#define RID_CBOR_ARRAY_START 0x9F
+#define RID_CBOR_MAP_START 0xBF
+#define RID_CBOR_NULL 0xF6
+#define RID_CBOR_FLOAT32 0xFA
+#define RID_CBOR_FLOAT64 0xFB
+#define RID_CBOR_BREAK 0xFF
+
+/* Write a CBOR head, the argument in the shortest big endian form. */
+static void rid_cbor_head(rid_json_t *json, uint8_t major, uint64_t value) {
+    char head[9];
+    size_t size;
+
+    if (value < 24) {
+        head[0] = (char)(major | value);
+        rid_json_puts(json, head, 1);
+        return;
+    }
+
+    if (value <= 0xFF) {
+        size = 1;
+        head[0] = (char)(major | 24);
+    } else if (value <= 0xFFFF) {
+        size = 2;
+        head[0] = (char)(major | 25);
+    } else if (value <= 0xFFFFFFFF) {
+        size = 4;
+        head[0] = (char)(major | 26);
+    } else {
+        size = 8;
+        head[0] = (char)(major | 27);
+    }
+    for (size_t i = 0; i < size; ++i) {
+        head[size - i] = (char)(value >> (8 * i));
+    }
+
+    rid_json_puts(json, head, size + 1);
+}
+
+static void rid_cbor_float(rid_json_t *json, double value) {
+    float single = (float)value;
+    char token[9];
+
+    if ((double)single == value) {
+        uint32_t bits;
+        memcpy(&bits, &single, sizeof(bits));
+        token[0] = (char)RID_CBOR_FLOAT32;
+        for (size_t i = 0; i < 4; ++i) {
+            token[4 - i] = (char)(bits >> (8 * i));
         }
+        rid_json_puts(json, token, 5);
+    } else {
+        uint64_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        token[0] = (char)RID_CBOR_FLOAT64;
+        for (size_t i = 0; i < 8; ++i) {
+            token[8 - i] = (char)(bits >> (8 * i));
+        }
+        rid_json_puts(json, token, 9);
     }
 }
 
 void rid_json_start(rid_json_t *json, char *buffer, size_t buffer_size) {
     json->buffer = buffer;
     json->buffer_size = buffer_size;
+    json->capacity = buffer_size > 0 ? buffer_size - 1 : 0;
     json->position = 0;
     json->need_comma = 0;
+    json->format = RID_JSON_FORMAT_JSON;
+    json->sink = NULL;
+    json->flushed = 0;
+    json->status = RID_SUCCESS;
     if (buffer != NULL && buffer_size > 0) {
         buffer[0] = '\0';
     }
+}
+
+void rid_json_start_sink(rid_json_t *json, const rid_json_sink_t *sink) {
+    rid_json_start(json, NULL, 0);
+    json->sink = sink;
+}
+
+void rid_cbor_start(rid_json_t *json, uint8_t *buffer, size_t buffer_size) {
+    rid_json_start(json, NULL, 0);
+    json->buffer = (char *)buffer;
+    json->buffer_size = buffer_size;
+    json->capacity = buffer_size;
+    json->format = RID_JSON_FORMAT_CBOR;
+}
+
+int rid_json_end(rid_json_t *json, size_t *needed_size) {
+    if (json->sink != NULL) {
+        rid_json_flush(json);
+        return json->status;
+    }
+
+    if (json->format == RID_JSON_FORMAT_CBOR) {
+        if (needed_size != NULL) {
+            *needed_size = json->position;
+        }
+        if (json->buffer != NULL && json->position > json->buffer_size) {
+            return RID_ERROR_BUFFER_TOO_SMALL;
+        }
+        return RID_SUCCESS;
+    }
+
+    /* Output is terminated only once, truncated output at the last byte. */
+    if (json->buffer != NULL && json->buffer_size > 0) {
+        if (json->position < json->buffer_size) {
+            json->buffer[json->position] = '\0';
+        } else {
+            json->buffer[json->buffer_size - 1] = '\0';
+        }
+    }
+
+    if (needed_size != NULL) {
+        *needed_size = json->position + 1;
+    }
+
+    if (json->buffer == NULL) {
+        return RID_SUCCESS;
+    }
+
+    if (json->position + 1 > json->buffer_size) {
+        return RID_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    return RID_SUCCESS;
+}
+
+void rid_json_object_start(rid_json_t *json) {
+    if (json->format == RID_JSON_FORMAT_CBOR) {
+        rid_json_putc(json, (char)RID_CBOR_MAP_START);
+        return;
+    }
+
+    if (json->need_comma) {
+        rid_json_putc(json, ',');
+    }
     rid_json_putc(json, '{');
+    json->need_comma = 0;
 }
 
-int rid_json_end(rid_json_t *json) {
+void rid_json_object_end(rid_json_t *json) {
+    if (json->format == RID_JSON_FORMAT_CBOR) {
+        rid_json_putc(json, (char)RID_CBOR_BREAK);
+        return;
+    }
+
     rid_json_putc(json, '}');
-    return (int)json->position;
+    json->need_comma = 1;
 }
 
 void rid_json_array_start(rid_json_t *json) {
+    if (json->format == RID_JSON_FORMAT_CBOR) {
+        rid_json_putc(json, (char)RID_CBOR_ARRAY_START);
+        return;
+    }
+
     if (json->need_comma) {
         rid_json_putc(json, ',');
     }
@@ -100,33 +362,110 @@ void rid_json_array_start(rid_json_t *json) {
 }
 
 void rid_json_array_end(rid_json_t *json) {
+    if (json->format == RID_JSON_FORMAT_CBOR) {
+        rid_json_putc(json, (char)RID_CBOR_BREAK);
+        return;
+    }
+
     rid_json_putc(json, ']');
     json->need_comma = 1;
 }
 
 void rid_json_key(rid_json_t *json, const char *key) {
+    if (json->format == RID_JSON_FORMAT_CBOR) {
+        size_t length = strlen(key);
+        rid_cbor_head(json, RID_CBOR_TEXT, length);
+        rid_json_puts(json, key, length);
+        return;
+    }
+
     if (json->need_comma) {
         rid_json_putc(json, ',');
     }
+    /* Keys are string literals which never need escaping. */
     rid_json_putc(json, '"');
-    rid_json_escape(json, key);
-    rid_json_putc(json, '"');
-    rid_json_putc(json, ':');
+    rid_json_puts(json, key, strlen(key));
+    rid_json_puts(json, "\":", 2);
     json->need_comma = 0;
 }
 
 void rid_json_uint(rid_json_t *json, unsigned value) {
     char token[16];
-    int length;
+    size_t length;
 
-    length = snprintf(token, sizeof(token), "%u", value);
-    if (length > 0) {
-        rid_json_puts(json, token, (size_t)length);
+    if (json->format == RID_JSON_FORMAT_CBOR) {
+        rid_cbor_head(json, RID_CBOR_UNSIGNED, value);
+        return;
     }
+
+    length = rid_json_format_uint(token + sizeof(token), value);
+    rid_json_puts(json, token + sizeof(token) - length, length);
+    json->need_comma = 1;
+}
+
+void rid_json_uint64(rid_json_t *json, uint64_t value) {
+    char token[24];
+    char *end = token + sizeof(token);
+    char *p = end;
+
+    if (json->format == RID_JSON_FORMAT_CBOR) {
+        rid_cbor_head(json, RID_CBOR_UNSIGNED, value);
+        return;
+    }
+
+    /* Nine digit groups while the value does not fit in 32 bits. */
+    while (value > UINT32_MAX) {
+        uint32_t group = (uint32_t)(value % 1000000000U);
+        value /= 1000000000U;
+        for (unsigned i = 0; i < 9; ++i) {
+            *--p = (char)('0' + group % 10);
+            group /= 10;
+        }
+    }
+    p -= rid_json_format_uint(p, (uint32_t)value);
+
+    rid_json_puts(json, p, (size_t)(end - p));
+    json->need_comma = 1;
+}
+
+void rid_json_fixed(rid_json_t *json, int32_t value, unsigned decimals) {
+    char token[24];
+    char *end = token + sizeof(token);
+    char *p = end;
+    uint32_t magnitude = value < 0 ? 0U - (uint32_t)value : (uint32_t)value;
+    unsigned i;
+
+    if (json->format == RID_JSON_FORMAT_CBOR) {
+        static const double scale[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9};
+        rid_cbor_float(json, (double)value / scale[decimals]);
+        return;
+    }
+
+    /* Fraction digits right to left, then at least one integer digit. */
+    for (i = 0; i < decimals; ++i) {
+        *--p = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    }
+    if (decimals > 0) {
+        *--p = '.';
+    }
+    p -= rid_json_format_uint(p, magnitude);
+    if (value < 0) {
+        *--p = '-';
+    }
+
+    rid_json_puts(json, p, (size_t)(end - p));
     json->need_comma = 1;
 }
 
 void rid_json_string(rid_json_t *json, const char *string) {
+    if (json->format == RID_JSON_FORMAT_CBOR) {
+        size_t length = strlen(string);
+        rid_cbor_head(json, RID_CBOR_TEXT, length);
+        rid_json_puts(json, string, length);
+        return;
+    }
+
     rid_json_putc(json, '"');
     rid_json_escape(json, string);
     rid_json_putc(json, '"');
@@ -134,6 +473,11 @@ void rid_json_string(rid_json_t *json, const char *string) {
 }
 
 void rid_json_null(rid_json_t *json) {
+    if (json->format == RID_JSON_FORMAT_CBOR) {
+        rid_json_putc(json, (char)RID_CBOR_NULL);
+        return;
+    }
+
     rid_json_puts(json, "null", 4);
     json->need_comma = 1;
 }
@@ -142,3 +486,38 @@ void rid_json_raw(rid_json_t *json, const char *token, size_t length) {
     rid_json_puts(json, token, length);
     json->need_comma = 1;
 }
+
+void rid_json_newline(rid_json_t *json) {
+    /* CBOR items are self delimiting. */
+    if (json->format == RID_JSON_FORMAT_CBOR) {
+        return;
+    }
+
+    rid_json_putc(json, '\n');
+    json->need_comma = 0;
+}
+
+static int rid_json_file_write(void *context, const char *data, size_t length) {
+    if (fwrite(data, 1, length, (FILE *)context) != length) {
+        return RID_ERROR_WRITE_FAILED;
+    }
+    return RID_SUCCESS;
+}
+
+int rid_json_sink_init(rid_json_sink_t *sink, rid_json_write_t write, void *context) {
+    if (sink == NULL || write == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    sink->write = write;
+    sink->context = context;
+
+    return RID_SUCCESS;
+}
+
+int rid_json_sink_file(rid_json_sink_t *sink, FILE *file) {
+    if (file == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+    return rid_json_sink_init(sink, rid_json_file_write, file);
+}
@@ -30,27 +30,188 @@
  *
  */
 
-#ifndef RID_JSON_H
-#define RID_JSON_H
+#ifndef RID_JSON_PRIVATE_H
+#define RID_JSON_PRIVATE_H
 
 #include <stddef.h>
 #include <stdint.h>
 
+#include "rid/auth.h"
+#include "rid/basic_id.h"
+#include "rid/json.h"
+#include "rid/location.h"
+#include "rid/message_pack.h"
+#include "rid/operator_id.h"
+#include "rid/self_id.h"
+#include "rid/system.h"
+
+/* Output written to a sink is staged here and passed on in chunks. */
+#define RID_JSON_STAGING_SIZE 256
+
+/* Encoding produced by the writer. */
+typedef enum rid_json_format {
+    RID_JSON_FORMAT_JSON = 0,
+    RID_JSON_FORMAT_CBOR = 1,
+} rid_json_format_t;
+
+/*
+ * Writer state. With a buffer output is truncated to fit and position
+ * keeps counting so the needed size is known. With a sink output is
+ * staged and flushed to the sink, nothing is ever truncated.
+ *
+ * The same value writers produce CBOR when started with rid_cbor_start().
+ * Objects and arrays are then encoded as indefinite length maps and
+ * arrays so nothing needs to be counted in advance.
+ */
 typedef struct rid_json {
     char *buffer;
     size_t buffer_size;
+    size_t capacity;
     size_t position;
     uint8_t need_comma;
+    rid_json_format_t format;
+    const rid_json_sink_t *sink;
+    size_t flushed;
+    int status;
+    char staging[RID_JSON_STAGING_SIZE];
 } rid_json_t;
 
 void rid_json_start(rid_json_t *json, char *buffer, size_t buffer_size);
-int rid_json_end(rid_json_t *json);
+void rid_json_start_sink(rid_json_t *json, const rid_json_sink_t *sink);
+void rid_cbor_start(rid_json_t *json, uint8_t *buffer, size_t buffer_size);
+
+/*
+ * Terminate buffer output or flush sink output. Returns RID_SUCCESS,
+ * RID_ERROR_BUFFER_TOO_SMALL if buffer output was truncated or the
+ * first error returned by the sink. CBOR output is not terminated and
+ * the needed size does not include a terminator.
+ */
+int rid_json_end(rid_json_t *json, size_t *needed_size);
+
+void rid_json_object_start(rid_json_t *json);
+void rid_json_object_end(rid_json_t *json);
 void rid_json_array_start(rid_json_t *json);
 void rid_json_array_end(rid_json_t *json);
 void rid_json_key(rid_json_t *json, const char *key);
 void rid_json_uint(rid_json_t *json, unsigned value);
+void rid_json_uint64(rid_json_t *json, uint64_t value);
+
+/*
+ * Write a fixed point number as value / 10^decimals with exactly given
+ * number of decimals, matching printf("%.Nf") for exact inputs. CBOR
+ * output is the nearest float, single precision when that is exact.
+ */
+void rid_json_fixed(rid_json_t *json, int32_t value, unsigned decimals);
 void rid_json_string(rid_json_t *json, const char *string);
 void rid_json_null(rid_json_t *json);
 void rid_json_raw(rid_json_t *json, const char *token, size_t length);
 
-#endif /* RID_JSON_H */
+/* End a line of newline delimited output, the next value needs no comma. */
+void rid_json_newline(rid_json_t *json);
+
+/* Write a message as a JSON object, shared by the buffer and sink APIs. */
+void rid_basic_id_json_write(rid_json_t *json, const rid_basic_id_t *message);
+void rid_location_json_write(rid_json_t *json, const rid_location_t *location);
+void rid_auth_page_json_write(rid_json_t *json, const void *message);
+void rid_self_id_json_write(rid_json_t *json, const rid_self_id_t *message);
+void rid_system_json_write(rid_json_t *json, const rid_system_t *system);
+void rid_operator_id_json_write(rid_json_t *json, const rid_operator_id_t *message);
+void rid_message_pack_json_write(rid_json_t *json, const rid_message_pack_t *pack);
+void rid_auth_json_write(rid_json_t *json, const rid_auth_t *auth);
+void rid_message_json_write(rid_json_t *json, const void *message);
+
+/* Kind of a value found by the reader. */
+typedef enum rid_json_kind {
+    RID_JSON_KIND_NULL = 0,
+    RID_JSON_KIND_BOOLEAN = 1,
+    RID_JSON_KIND_NUMBER = 2,
+    RID_JSON_KIND_STRING = 3,
+    RID_JSON_KIND_OBJECT = 4,
+    RID_JSON_KIND_ARRAY = 5,
+} rid_json_kind_t;
+
+/*
+ * Value as a span of the input, nothing is copied. Strings exclude the
+ * quotes and are still escaped. Objects and arrays include brackets.
+ */
+typedef struct rid_json_value {
+    rid_json_kind_t kind;
+    const char *start;
+    size_t length;
+} rid_json_value_t;
+
+typedef struct rid_json_member {
+    const char *key;
+    size_t key_length;
+    rid_json_value_t value;
+} rid_json_member_t;
+
+/* Members of one object. Nested objects and arrays are kept as spans. */
+#define RID_JSON_MAX_MEMBERS 24
+
+typedef struct rid_json_object {
+    size_t count;
+    size_t cursor;
+    rid_json_member_t members[RID_JSON_MAX_MEMBERS];
+} rid_json_object_t;
+
+/*
+ * Split the object at the start of json into members. Leading white
+ * space is skipped. Consumed receives the offset just past the closing
+ * brace. Returns RID_SUCCESS or RID_ERROR_INVALID_JSON.
+ */
+int rid_json_parse_object(rid_json_object_t *object, const char *json, size_t length, size_t *consumed);
+
+/*
+ * Find a member value by key or NULL. Search starts after the previous
+ * match so members in the order they were written are found at once.
+ */
+const rid_json_value_t *rid_json_find(rid_json_object_t *object, const char *key);
+
+/*
+ * Next element of an array value. Offset must start at 0 and is updated
+ * on each call. Returns RID_SUCCESS, RID_ERROR_NOT_FOUND after the last
+ * element or RID_ERROR_INVALID_JSON.
+ */
+int rid_json_array_next(const rid_json_value_t *array, size_t *offset, rid_json_value_t *element);
+
+/*
+ * Typed member getters. Each returns RID_SUCCESS, RID_JSON_NULL if the
+ * value is null, RID_ERROR_INVALID_JSON if the member is missing or of
+ * wrong kind, or RID_ERROR_OUT_OF_RANGE if the value does not fit.
+ */
+#define RID_JSON_NULL 1
+
+int rid_json_get_uint(rid_json_object_t *object, const char *key, uint32_t max, uint32_t *result);
+int rid_json_get_uint64(rid_json_object_t *object, const char *key, uint64_t *result);
+
+/* Number scaled by 10^decimals and rounded, so "60.1699" with 7 gives 601699000. */
+int rid_json_get_fixed(rid_json_object_t *object, const char *key, unsigned decimals, int32_t *result);
+
+/* Unescaped string, NUL terminated. RID_ERROR_BUFFER_TOO_LARGE if it does not fit. */
+int rid_json_get_string(rid_json_object_t *object, const char *key, char *buffer, size_t buffer_size);
+
+/* Hex string into bytes, dash and colon separators are ignored. Length receives the byte count. */
+int rid_json_get_hex(rid_json_object_t *object, const char *key, uint8_t *buffer, size_t buffer_size, size_t *length);
+
+/*
+ * Read a message object back into a message, shared by the JSON readers.
+ * Message is initialized first and a null value leaves the value set by
+ * init, which for nullable fields is the invalid or unknown value.
+ */
+int rid_basic_id_json_read(rid_json_object_t *object, rid_basic_id_t *message);
+int rid_location_json_read(rid_json_object_t *object, rid_location_t *location);
+int rid_auth_page_json_read(rid_json_object_t *object, void *message);
+int rid_self_id_json_read(rid_json_object_t *object, rid_self_id_t *message);
+int rid_system_json_read(rid_json_object_t *object, rid_system_t *system);
+int rid_operator_id_json_read(rid_json_object_t *object, rid_operator_id_t *message);
+int rid_auth_json_read(rid_json_object_t *object, rid_auth_t *auth);
+int rid_message_pack_json_read(rid_json_object_t *object, rid_message_pack_t *pack);
+
+/*
+ * Parse one message or Message Pack object. Message must have room for
+ * message_size bytes, a Message Pack needs sizeof(rid_message_pack_t).
+ */
+int rid_message_json_read(rid_json_object_t *object, void *message, size_t message_size);
+
+#endif /* RID_JSON_PRIVATE_H */
@@ -0,0 +1,563 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of librid: https://github.com/tuupola/librid
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "rid/message.h"
+
+#include "json.h"
+
+/* Character classes, the scanners skip runs of uninteresting bytes. */
+#define RID_JSON_SPACE 0x01
+#define RID_JSON_NUMBER 0x02
+#define RID_JSON_STRING 0x04
+#define RID_JSON_NESTED 0x08
+
+/* Deepest nesting skipped inside a value, messages are flat objects. */
+#define RID_JSON_MAX_DEPTH 32
+
+static const uint8_t rid_json_class[256] = {
+    [' '] = RID_JSON_SPACE,
+    ['\t'] = RID_JSON_SPACE,
+    ['\r'] = RID_JSON_SPACE,
+    ['\n'] = RID_JSON_SPACE,
+    ['0'] = RID_JSON_NUMBER,
+    ['1'] = RID_JSON_NUMBER,
+    ['2'] = RID_JSON_NUMBER,
+    ['3'] = RID_JSON_NUMBER,
+    ['4'] = RID_JSON_NUMBER,
+    ['5'] = RID_JSON_NUMBER,
+    ['6'] = RID_JSON_NUMBER,
+    ['7'] = RID_JSON_NUMBER,
+    ['8'] = RID_JSON_NUMBER,
+    ['9'] = RID_JSON_NUMBER,
+    ['-'] = RID_JSON_NUMBER,
+    ['+'] = RID_JSON_NUMBER,
+    ['.'] = RID_JSON_NUMBER,
+    ['e'] = RID_JSON_NUMBER,
+    ['E'] = RID_JSON_NUMBER,
+    ['"'] = RID_JSON_STRING | RID_JSON_NESTED,
+    ['\\'] = RID_JSON_STRING,
+    ['{'] = RID_JSON_NESTED,
+    ['}'] = RID_JSON_NESTED,
+    ['['] = RID_JSON_NESTED,
+    [']'] = RID_JSON_NESTED,
+};
+
+#define RID_JSON_IS(c, class) (rid_json_class[(uint8_t)(c)] & (class))
+
+static const char *rid_json_skip_space(const char *p, const char *end) {
+    while (p < end && RID_JSON_IS(*p, RID_JSON_SPACE)) {
+        ++p;
+    }
+    return p;
+}
+
+/* Scan a string starting at the opening quote. */
+static const char *rid_json_scan_string(const char *p, const char *end, rid_json_value_t *value) {
+    const char *start = ++p;
+
+    while (p < end) {
+        if (!RID_JSON_IS(*p, RID_JSON_STRING)) {
+            ++p;
+            continue;
+        }
+        if (*p == '"') {
+            value->kind = RID_JSON_KIND_STRING;
+            value->start = start;
+            value->length = (size_t)(p - start);
+            return p + 1;
+        }
+        /* Skip the escaped character, a trailing backslash is truncated input. */
+        if (end - p < 2) {
+            return NULL;
+        }
+        p += 2;
+    }
+
+    return NULL;
+}
+
+/* Skip a nested object or array, keeping track of strings and that closers match. */
+static const char *rid_json_skip_container(const char *p, const char *end) {
+    char closer[RID_JSON_MAX_DEPTH];
+    size_t depth = 0;
+
+    while (p < end) {
+        if (!RID_JSON_IS(*p, RID_JSON_NESTED)) {
+            ++p;
+            continue;
+        }
+        switch (*p) {
+            case '{':
+            case '[':
+                if (depth == RID_JSON_MAX_DEPTH) {
+                    return NULL;
+                }
+                closer[depth++] = *p == '{' ? '}' : ']';
+                break;
+            case '}':
+            case ']':
+                if (depth == 0 || closer[--depth] != *p) {
+                    return NULL;
+                }
+                if (depth == 0) {
+                    return p + 1;
+                }
+                break;
+            default: {
+                rid_json_value_t string;
+                p = rid_json_scan_string(p, end, &string);
+                if (p == NULL) {
+                    return NULL;
+                }
+                continue;
+            }
+        }
+        ++p;
+    }
+
+    return NULL;
+}
+
+static const char *rid_json_scan_value(const char *p, const char *end, rid_json_value_t *value) {
+    const char *start = p;
+
+    if (p >= end) {
+        return NULL;
+    }
+
+    switch (*p) {
+        case '"':
+            return rid_json_scan_string(p, end, value);
+        case '{':
+        case '[':
+            p = rid_json_skip_container(p, end);
+            if (p == NULL) {
+                return NULL;
+            }
+            value->kind = *start == '{' ? RID_JSON_KIND_OBJECT : RID_JSON_KIND_ARRAY;
+            break;
+        case 'n':
+            if (end - p < 4 || memcmp(p, "null", 4) != 0) {
+                return NULL;
+            }
+            p += 4;
+            value->kind = RID_JSON_KIND_NULL;
+            break;
+        case 't':
+            if (end - p < 4 || memcmp(p, "true", 4) != 0) {
+                return NULL;
+            }
+            p += 4;
+            value->kind = RID_JSON_KIND_BOOLEAN;
+            break;
+        case 'f':
+            if (end - p < 5 || memcmp(p, "false", 5) != 0) {
+                return NULL;
+            }
+            p += 5;
+            value->kind = RID_JSON_KIND_BOOLEAN;
+            break;
+        default:
+            while (p < end && RID_JSON_IS(*p, RID_JSON_NUMBER)) {
+                ++p;
+            }
+            if (p == start) {
+                return NULL;
+            }
+            value->kind = RID_JSON_KIND_NUMBER;
+            break;
+    }
+
+    value->start = start;
+    value->length = (size_t)(p - start);
+
+    return p;
+}
+
+int rid_json_parse_object(rid_json_object_t *object, const char *json, size_t length, size_t *consumed) {
+    const char *end = json + length;
+    const char *p = rid_json_skip_space(json, end);
+
+    object->count = 0;
+    object->cursor = 0;
+
+    if (p >= end || *p != '{') {
+        return RID_ERROR_INVALID_JSON;
+    }
+    p = rid_json_skip_space(p + 1, end);
+
+    if (p < end && *p == '}') {
+        *consumed = (size_t)(p + 1 - json);
+        return RID_SUCCESS;
+    }
+
+    while (p < end) {
+        rid_json_member_t *member;
+        rid_json_value_t key;
+
+        if (object->count == RID_JSON_MAX_MEMBERS || *p != '"') {
+            return RID_ERROR_INVALID_JSON;
+        }
+
+        member = &object->members[object->count++];
+
+        p = rid_json_scan_string(p, end, &key);
+        if (p == NULL) {
+            return RID_ERROR_INVALID_JSON;
+        }
+        member->key = key.start;
+        member->key_length = key.length;
+
+        p = rid_json_skip_space(p, end);
+        if (p >= end || *p != ':') {
+            return RID_ERROR_INVALID_JSON;
+        }
+        p = rid_json_skip_space(p + 1, end);
+
+        p = rid_json_scan_value(p, end, &member->value);
+        if (p == NULL) {
+            return RID_ERROR_INVALID_JSON;
+        }
+
+        p = rid_json_skip_space(p, end);
+        if (p < end && *p == ',') {
+            p = rid_json_skip_space(p + 1, end);
+            continue;
+        }
+        if (p < end && *p == '}') {
+            *consumed = (size_t)(p + 1 - json);
+            return RID_SUCCESS;
+        }
+        break;
+    }
+
+    return RID_ERROR_INVALID_JSON;
+}
+
+const rid_json_value_t *rid_json_find(rid_json_object_t *object, const char *key) {
+    size_t length = strlen(key);
+    size_t i = object->cursor;
+
+    for (size_t n = 0; n < object->count; ++n, ++i) {
+        const rid_json_member_t *member;
+
+        if (i >= object->count) {
+            i = 0;
+        }
+        member = &object->members[i];
+        if (member->key_length == length && memcmp(member->key, key, length) == 0) {
+            object->cursor = i + 1;
+            return &member->value;
+        }
+    }
+
+    return NULL;
+}
+
+/* Find a member which is either null or of given kind. */
+static int rid_json_get(rid_json_object_t *object, const char *key, rid_json_kind_t kind, const rid_json_value_t **value) {
+    *value = rid_json_find(object, key);
+
+    if (*value == NULL) {
+        return RID_ERROR_INVALID_JSON;
+    }
+    if ((*value)->kind == RID_JSON_KIND_NULL) {
+        return RID_JSON_NULL;
+    }
+    if ((*value)->kind != kind) {
+        return RID_ERROR_INVALID_JSON;
+    }
+
+    return RID_SUCCESS;
+}
+
+int rid_json_get_uint64(rid_json_object_t *object, const char *key, uint64_t *result) {
+    const rid_json_value_t *value;
+    uint64_t number = 0;
+    int status;
+
+    status = rid_json_get(object, key, RID_JSON_KIND_NUMBER, &value);
+    if (status != RID_SUCCESS) {
+        return status;
+    }
+
+    for (size_t i = 0; i < value->length; ++i) {
+        unsigned digit = (unsigned)(value->start[i] - '0');
+
+        if (digit > 9) {
+            return RID_ERROR_INVALID_JSON;
+        }
+        if (number > (UINT64_MAX - digit) / 10) {
+            return RID_ERROR_OUT_OF_RANGE;
+        }
+        number = number * 10 + digit;
+    }
+
+    *result = number;
+
+    return RID_SUCCESS;
+}
+
+int rid_json_get_uint(rid_json_object_t *object, const char *key, uint32_t max, uint32_t *result) {
+    uint64_t number;
+    int status;
+
+    status = rid_json_get_uint64(object, key, &number);
+    if (status != RID_SUCCESS) {
+        return status;
+    }
+    if (number > max) {
+        return RID_ERROR_OUT_OF_RANGE;
+    }
+
+    *result = (uint32_t)number;
+
+    return RID_SUCCESS;
+}
+
+int rid_json_get_fixed(rid_json_object_t *object, const char *key, unsigned decimals, int32_t *result) {
+    const rid_json_value_t *value;
+    const char *p;
+    const char *end;
+    int64_t number = 0;
+    unsigned fraction = 0;
+    int negative = 0;
+    int digits = 0;
+    int status;
+
+    status = rid_json_get(object, key, RID_JSON_KIND_NUMBER, &value);
+    if (status != RID_SUCCESS) {
+        return status;
+    }
+
+    p = value->start;
+    end = p + value->length;
+
+    if (p < end && *p == '-') {
+        negative = 1;
+        ++p;
+    }
+
+    for (; p < end && *p >= '0' && *p <= '9'; ++p, ++digits) {
+        number = number * 10 + (*p - '0');
+        if (number > INT32_MAX) {
+            return RID_ERROR_OUT_OF_RANGE;
+        }
+    }
+
+    if (p < end && *p == '.') {
+        for (++p; p < end && *p >= '0' && *p <= '9'; ++p, ++digits) {
+            if (fraction < decimals) {
+                number = number * 10 + (*p - '0');
+                ++fraction;
+            } else if (fraction == decimals) {
+                /* First dropped digit decides rounding. */
+                number += *p >= '5';
+                ++fraction;
+            }
+        }
+    }
+
+    if (p != end || digits == 0) {
+        return RID_ERROR_INVALID_JSON;
+    }
+
+    for (; fraction < decimals; ++fraction) {
+        number *= 10;
+    }
+    if (number > INT32_MAX) {
+        return RID_ERROR_OUT_OF_RANGE;
+    }
+
+    *result = negative ? (int32_t)-number : (int32_t)number;
+
+    return RID_SUCCESS;
+}
+
+static int rid_json_hex_digit(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+int rid_json_get_string(rid_json_object_t *object, const char *key, char *buffer, size_t buffer_size) {
+    const rid_json_value_t *value;
+    size_t position = 0;
+    int status;
+
+    status = rid_json_get(object, key, RID_JSON_KIND_STRING, &value);
+    if (status != RID_SUCCESS) {
+        return status;
+    }
+
+    for (size_t i = 0; i < value->length; ++i) {
+        char c = value->start[i];
+
+        if (c == '\\') {
+            if (++i >= value->length) {
+                return RID_ERROR_INVALID_JSON;
+            }
+            switch (value->start[i]) {
+                case 'b':
+                    c = '\b';
+                    break;
+                case 'f':
+                    c = '\f';
+                    break;
+                case 'n':
+                    c = '\n';
+                    break;
+                case 'r':
+                    c = '\r';
+                    break;
+                case 't':
+                    c = '\t';
+                    break;
+                case 'u': {
+                    unsigned code = 0;
+
+                    if (i + 4 >= value->length) {
+                        return RID_ERROR_INVALID_JSON;
+                    }
+                    for (size_t n = 1; n <= 4; ++n) {
+                        int digit = rid_json_hex_digit(value->start[i + n]);
+                        if (digit < 0) {
+                            return RID_ERROR_INVALID_JSON;
+                        }
+                        code = (code << 4) | (unsigned)digit;
+                    }
+                    i += 4;
+
+                    /* Remote ID strings are ASCII, wider code points are not expected. */
+                    if (code > 0xFF) {
+                        return RID_ERROR_INVALID_CHARACTER;
+                    }
+                    c = (char)code;
+                    break;
+                }
+                default:
+                    c = value->start[i];
+                    break;
+            }
+        }
+
+        if (position + 1 >= buffer_size) {
+            return RID_ERROR_BUFFER_TOO_LARGE;
+        }
+        buffer[position++] = c;
+    }
+
+    buffer[position] = '\0';
+
+    return RID_SUCCESS;
+}
+
+int rid_json_get_hex(rid_json_object_t *object, const char *key, uint8_t *buffer, size_t buffer_size, size_t *length) {
+    const rid_json_value_t *value;
+    size_t count = 0;
+    int high = -1;
+    int status;
+
+    status = rid_json_get(object, key, RID_JSON_KIND_STRING, &value);
+    if (status != RID_SUCCESS) {
+        return status;
+    }
+
+    for (size_t i = 0; i < value->length; ++i) {
+        int digit;
+
+        if (value->start[i] == '-' || value->start[i] == ':') {
+            continue;
+        }
+        digit = rid_json_hex_digit(value->start[i]);
+        if (digit < 0) {
+            return RID_ERROR_INVALID_CHARACTER;
+        }
+        if (high < 0) {
+            high = digit;
+            continue;
+        }
+        if (count == buffer_size) {
+            return RID_ERROR_BUFFER_TOO_LARGE;
+        }
+        buffer[count++] = (uint8_t)((high << 4) | digit);
+        high = -1;
+    }
+
+    if (high >= 0) {
+        return RID_ERROR_INVALID_JSON;
+    }
+
+    *length = count;
+
+    return RID_SUCCESS;
+}
+
+int rid_json_array_next(const rid_json_value_t *array, size_t *offset, rid_json_value_t *element) {
+    const char *end = array->start + array->length;
+    const char *p;
+
+    if (*offset == 0) {
+        p = rid_json_skip_space(array->start + 1, end);
+        if (p < end && *p == ']') {
+            return RID_ERROR_NOT_FOUND;
+        }
+    } else {
+        p = rid_json_skip_space(array->start + *offset, end);
+        if (p < end && *p == ']') {
+            return RID_ERROR_NOT_FOUND;
+        }
+        if (p >= end || *p != ',') {
+            return RID_ERROR_INVALID_JSON;
+        }
+        p = rid_json_skip_space(p + 1, end);
+    }
+
+    p = rid_json_scan_value(p, end, element);
+    if (p == NULL) {
+        return RID_ERROR_INVALID_JSON;
+    }
+    *offset = (size_t)(p - array->start);
+
+    return RID_SUCCESS;
+}
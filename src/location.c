@@ -32,7 +32,6 @@ SPDX-License-Identifier: MIT
 
 #include <stddef.h>
 #include <stdint.h>
-#include <stdio.h>
 #include <string.h>
 
 #include "rid/location.h"
@@ -772,133 +771,297 @@ const char *rid_timestamp_accuracy_to_string(rid_timestamp_accuracy_t accuracy)
     }
 }
 
-int rid_location_to_json(const rid_location_t *location, char *buffer, size_t buffer_size, size_t *needed_size) {
-    rid_json_t json;
-    char token[32];
-    int token_length;
+/*
+ * The JSON writer formats decoded values straight from the encoded
+ * integers. Both are exact in hundredths so the output is the same as
+ * printing the float getter value with two decimals.
+ */
+static int32_t altitude_hundredths(uint16_t encoded) {
+    return (int32_t)encoded * 50 - 100000;
+}
+
+static int32_t speed_hundredths(const rid_location_t *location) {
+    if (location->speed_multiplier == 0) {
+        return (int32_t)location->speed * 25;
+    }
+    return (int32_t)location->speed * 75 + 6375;
+}
+
+void rid_location_json_write(rid_json_t *json, const rid_location_t *location) {
     double latitude, longitude;
     float speed, vertical_speed, height, pressure_altitude, geodetic_altitude;
     uint16_t timestamp, track_direction;
 
-    if (location == NULL || (buffer == NULL && needed_size == NULL)) {
-        return RID_ERROR_NULL_POINTER;
-    }
-
-    rid_json_start(&json, buffer, buffer_size);
+    rid_json_object_start(json);
 
-    rid_json_key(&json, "protocol_version");
-    rid_json_uint(&json, rid_message_get_protocol_version(location));
-    rid_json_key(&json, "message_type");
-    rid_json_uint(&json, rid_message_get_type(location));
+    rid_json_key(json, "protocol_version");
+    rid_json_uint(json, rid_message_get_protocol_version(location));
+    rid_json_key(json, "message_type");
+    rid_json_uint(json, rid_message_get_type(location));
 
-    rid_json_key(&json, "latitude");
+    rid_json_key(json, "latitude");
     latitude = rid_location_get_latitude(location);
     if (latitude == RID_LATITUDE_INVALID) {
-        rid_json_null(&json);
+        rid_json_null(json);
     } else {
-        token_length = snprintf(token, sizeof(token), "%.7f", latitude);
-        rid_json_raw(&json, token, (size_t)token_length);
+        rid_json_fixed(json, location->latitude, 7);
     }
 
-    rid_json_key(&json, "longitude");
+    rid_json_key(json, "longitude");
     longitude = rid_location_get_longitude(location);
     if (longitude == RID_LONGITUDE_INVALID) {
-        rid_json_null(&json);
+        rid_json_null(json);
     } else {
-        token_length = snprintf(token, sizeof(token), "%.7f", longitude);
-        rid_json_raw(&json, token, (size_t)token_length);
+        rid_json_fixed(json, location->longitude, 7);
     }
 
-    rid_json_key(&json, "geodetic_altitude");
+    rid_json_key(json, "geodetic_altitude");
     geodetic_altitude = rid_location_get_geodetic_altitude(location);
     if (geodetic_altitude == RID_GEODETIC_ALTITUDE_INVALID) {
-        rid_json_null(&json);
+        rid_json_null(json);
     } else {
-        token_length = snprintf(token, sizeof(token), "%.2f", (double)geodetic_altitude);
-        rid_json_raw(&json, token, (size_t)token_length);
+        rid_json_fixed(json, altitude_hundredths(location->geodetic_altitude), 2);
     }
 
-    rid_json_key(&json, "pressure_altitude");
+    rid_json_key(json, "pressure_altitude");
     pressure_altitude = rid_location_get_pressure_altitude(location);
     if (pressure_altitude == RID_PRESSURE_ALTITUDE_INVALID) {
-        rid_json_null(&json);
+        rid_json_null(json);
     } else {
-        token_length = snprintf(token, sizeof(token), "%.2f", (double)pressure_altitude);
-        rid_json_raw(&json, token, (size_t)token_length);
+        rid_json_fixed(json, altitude_hundredths(location->pressure_altitude), 2);
     }
 
-    rid_json_key(&json, "height");
+    rid_json_key(json, "height");
     height = rid_location_get_height(location);
     if (height == RID_HEIGHT_INVALID) {
-        rid_json_null(&json);
+        rid_json_null(json);
     } else {
-        token_length = snprintf(token, sizeof(token), "%.2f", (double)height);
-        rid_json_raw(&json, token, (size_t)token_length);
+        rid_json_fixed(json, altitude_hundredths(location->height), 2);
     }
 
-    rid_json_key(&json, "height_type");
-    rid_json_uint(&json, rid_location_get_height_type(location));
+    rid_json_key(json, "height_type");
+    rid_json_uint(json, rid_location_get_height_type(location));
 
-    rid_json_key(&json, "speed");
+    rid_json_key(json, "speed");
     speed = rid_location_get_speed(location);
     if (speed == RID_SPEED_INVALID) {
-        rid_json_null(&json);
+        rid_json_null(json);
     } else {
-        token_length = snprintf(token, sizeof(token), "%.2f", (double)speed);
-        rid_json_raw(&json, token, (size_t)token_length);
+        rid_json_fixed(json, speed_hundredths(location), 2);
     }
 
-    rid_json_key(&json, "vertical_speed");
+    rid_json_key(json, "vertical_speed");
     vertical_speed = rid_location_get_vertical_speed(location);
     if (vertical_speed == RID_VERTICAL_SPEED_INVALID) {
-        rid_json_null(&json);
+        rid_json_null(json);
     } else {
-        token_length = snprintf(token, sizeof(token), "%.2f", (double)vertical_speed);
-        rid_json_raw(&json, token, (size_t)token_length);
+        rid_json_fixed(json, (int32_t)location->vertical_speed * 50, 2);
     }
 
-    rid_json_key(&json, "track_direction");
+    rid_json_key(json, "track_direction");
     track_direction = rid_location_get_track_direction(location);
     if (track_direction == RID_TRACK_DIRECTION_UNKNOWN) {
-        rid_json_null(&json);
+        rid_json_null(json);
     } else {
-        rid_json_uint(&json, track_direction);
+        rid_json_uint(json, track_direction);
     }
 
-    rid_json_key(&json, "operational_status");
-    rid_json_uint(&json, rid_location_get_operational_status(location));
-    rid_json_key(&json, "horizontal_accuracy");
-    rid_json_uint(&json, rid_location_get_horizontal_accuracy(location));
-    rid_json_key(&json, "vertical_accuracy");
-    rid_json_uint(&json, rid_location_get_vertical_accuracy(location));
-    rid_json_key(&json, "speed_accuracy");
-    rid_json_uint(&json, rid_location_get_speed_accuracy(location));
-    rid_json_key(&json, "baro_altitude_accuracy");
-    rid_json_uint(&json, rid_location_get_baro_altitude_accuracy(location));
+    rid_json_key(json, "operational_status");
+    rid_json_uint(json, rid_location_get_operational_status(location));
+    rid_json_key(json, "horizontal_accuracy");
+    rid_json_uint(json, rid_location_get_horizontal_accuracy(location));
+    rid_json_key(json, "vertical_accuracy");
+    rid_json_uint(json, rid_location_get_vertical_accuracy(location));
+    rid_json_key(json, "speed_accuracy");
+    rid_json_uint(json, rid_location_get_speed_accuracy(location));
+    rid_json_key(json, "baro_altitude_accuracy");
+    rid_json_uint(json, rid_location_get_baro_altitude_accuracy(location));
 
-    rid_json_key(&json, "timestamp");
+    rid_json_key(json, "timestamp");
     timestamp = rid_location_get_timestamp(location);
     if (timestamp == RID_TIMESTAMP_INVALID) {
-        rid_json_null(&json);
+        rid_json_null(json);
     } else {
-        rid_json_uint(&json, timestamp);
+        rid_json_uint(json, timestamp);
     }
 
-    rid_json_key(&json, "timestamp_accuracy");
-    rid_json_uint(&json, rid_location_get_timestamp_accuracy(location));
+    rid_json_key(json, "timestamp_accuracy");
+    rid_json_uint(json, rid_location_get_timestamp_accuracy(location));
+    rid_json_object_end(json);
+}
 
-    rid_json_end(&json);
+int rid_location_to_json(const rid_location_t *location, char *buffer, size_t buffer_size, size_t *needed_size) {
+    rid_json_t json;
 
-    if (needed_size != NULL) {
-        *needed_size = json.position + 1;
+    if (location == NULL || (buffer == NULL && needed_size == NULL)) {
+        return RID_ERROR_NULL_POINTER;
     }
 
-    if (buffer == NULL) {
-        return RID_SUCCESS;
+    rid_json_start(&json, buffer, buffer_size);
+    rid_location_json_write(&json, location);
+
+    return rid_json_end(&json, needed_size);
+}
+
+int rid_location_to_json_sink(const rid_location_t *location, const rid_json_sink_t *sink) {
+    rid_json_t json;
+
+    if (location == NULL || sink == NULL || sink->write == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    rid_json_start_sink(&json, sink);
+    rid_location_json_write(&json, location);
+
+    return rid_json_end(&json, NULL);
+}
+
+int rid_location_to_cbor(const rid_location_t *location, uint8_t *buffer, size_t buffer_size, size_t *needed_size) {
+    rid_json_t json;
+
+    if (location == NULL || (buffer == NULL && needed_size == NULL)) {
+        return RID_ERROR_NULL_POINTER;
     }
 
-    if (json.position + 1 > buffer_size) {
-        return RID_ERROR_BUFFER_TOO_SMALL;
+    rid_cbor_start(&json, buffer, buffer_size);
+    rid_location_json_write(&json, location);
+
+    return rid_json_end(&json, needed_size);
+}
+
+/* Nullable value in hundredths, null leaves the invalid value from init. */
+static int location_read_hundredths(
+    rid_json_object_t *object, const char *key, rid_location_t *location, int (*set)(rid_location_t *, float)
+) {
+    int32_t value;
+    int status;
+
+    status = rid_json_get_fixed(object, key, 2, &value);
+    if (status == RID_SUCCESS) {
+        status = set(location, (float)value / 100.0f);
+    }
+
+    return status;
+}
+
+int rid_location_json_read(rid_json_object_t *object, rid_location_t *location) {
+    int32_t degrees;
+    uint32_t value;
+    int status;
+
+    rid_location_init(location);
+
+    status = rid_json_get_fixed(object, "latitude", 7, &degrees);
+    if (status == RID_SUCCESS) {
+        status = rid_location_set_latitude(location, (double)degrees / 10000000.0);
+    }
+    if (status < RID_SUCCESS) {
+        return status;
+    }
+
+    status = rid_json_get_fixed(object, "longitude", 7, &degrees);
+    if (status == RID_SUCCESS) {
+        status = rid_location_set_longitude(location, (double)degrees / 10000000.0);
+    }
+    if (status < RID_SUCCESS) {
+        return status;
+    }
+
+    status = location_read_hundredths(object, "geodetic_altitude", location, rid_location_set_geodetic_altitude);
+    if (status < RID_SUCCESS) {
+        return status;
+    }
+
+    status = location_read_hundredths(object, "pressure_altitude", location, rid_location_set_pressure_altitude);
+    if (status < RID_SUCCESS) {
+        return status;
+    }
+
+    status = location_read_hundredths(object, "height", location, rid_location_set_height);
+    if (status < RID_SUCCESS) {
+        return status;
+    }
+
+    status = rid_json_get_uint(object, "height_type", UINT8_MAX, &value);
+    if (status == RID_SUCCESS) {
+        status = rid_location_set_height_type(location, (rid_height_type_t)value);
+    }
+    if (status < RID_SUCCESS) {
+        return status;
+    }
+
+    status = location_read_hundredths(object, "speed", location, rid_location_set_speed);
+    if (status < RID_SUCCESS) {
+        return status;
+    }
+
+    status = location_read_hundredths(object, "vertical_speed", location, rid_location_set_vertical_speed);
+    if (status < RID_SUCCESS) {
+        return status;
+    }
+
+    status = rid_json_get_uint(object, "track_direction", UINT16_MAX, &value);
+    if (status == RID_SUCCESS) {
+        status = rid_location_set_track_direction(location, (uint16_t)value);
+    }
+    if (status < RID_SUCCESS) {
+        return status;
+    }
+
+    status = rid_json_get_uint(object, "operational_status", UINT8_MAX, &value);
+    if (status == RID_SUCCESS) {
+        status = rid_location_set_operational_status(location, (rid_operational_status_t)value);
+    }
+    if (status < RID_SUCCESS) {
+        return status;
+    }
+
+    status = rid_json_get_uint(object, "horizontal_accuracy", UINT8_MAX, &value);
+    if (status == RID_SUCCESS) {
+        status = rid_location_set_horizontal_accuracy(location, (rid_horizontal_accuracy_t)value);
+    }
+    if (status < RID_SUCCESS) {
+        return status;
+    }
+
+    status = rid_json_get_uint(object, "vertical_accuracy", UINT8_MAX, &value);
+    if (status == RID_SUCCESS) {
+        status = rid_location_set_vertical_accuracy(location, (rid_vertical_accuracy_t)value);
+    }
+    if (status < RID_SUCCESS) {
+        return status;
+    }
+
+    status = rid_json_get_uint(object, "speed_accuracy", UINT8_MAX, &value);
+    if (status == RID_SUCCESS) {
+        status = rid_location_set_speed_accuracy(location, (rid_speed_accuracy_t)value);
+    }
+    if (status < RID_SUCCESS) {
+        return status;
+    }
+
+    status = rid_json_get_uint(object, "baro_altitude_accuracy", UINT8_MAX, &value);
+    if (status == RID_SUCCESS) {
+        status = rid_location_set_baro_altitude_accuracy(location, (rid_vertical_accuracy_t)value);
+    }
+    if (status < RID_SUCCESS) {
+        return status;
+    }
+
+    status = rid_json_get_uint(object, "timestamp", UINT16_MAX, &value);
+    if (status == RID_SUCCESS) {
+        status = rid_location_set_timestamp(location, (uint16_t)value);
+    }
+    if (status < RID_SUCCESS) {
+        return status;
+    }
+
+    status = rid_json_get_uint(object, "timestamp_accuracy", UINT8_MAX, &value);
+    if (status == RID_SUCCESS) {
+        status = rid_location_set_timestamp_accuracy(location, (rid_timestamp_accuracy_t)value);
+    }
+    if (status < RID_SUCCESS) {
+        return status;
     }
 
     return RID_SUCCESS;
@@ -0,0 +1,376 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of librid: https://github.com/tuupola/librid
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#include <float.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define RID_LOCATION_BATCH_BLOCK 8
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define RID_LOCATION_BATCH_BLOCK 4
+#else
+#define RID_LOCATION_BATCH_BLOCK 1
+#endif
+
+#include "rid/location.h"
+#include "rid/location_batch.h"
+#include "rid/message.h"
+
+#include "align.h"
+
+/* Array alignment inside the storage, enough for AVX2 loads. */
+#define RID_LOCATION_BATCH_ALIGN 32
+
+/* Encoded fields of one block of messages widened to 32 bits. */
+typedef struct {
+    int32_t latitude[RID_LOCATION_BATCH_BLOCK];
+    int32_t longitude[RID_LOCATION_BATCH_BLOCK];
+    int32_t geodetic_altitude[RID_LOCATION_BATCH_BLOCK];
+    int32_t pressure_altitude[RID_LOCATION_BATCH_BLOCK];
+    int32_t height[RID_LOCATION_BATCH_BLOCK];
+    int32_t speed[RID_LOCATION_BATCH_BLOCK];
+    int32_t speed_multiplier[RID_LOCATION_BATCH_BLOCK];
+    int32_t vertical_speed[RID_LOCATION_BATCH_BLOCK];
+    int32_t track_direction[RID_LOCATION_BATCH_BLOCK];
+    int32_t ew_direction[RID_LOCATION_BATCH_BLOCK];
+} raw_block_t;
+
+static size_t align_up(size_t value) {
+    return rid_align_up(value, RID_LOCATION_BATCH_ALIGN);
+}
+
+size_t rid_location_batch_storage_size(size_t capacity) {
+    size_t size = 0;
+
+    size += align_up(capacity * sizeof(double)) * 2;
+    size += align_up(capacity * sizeof(float)) * 5;
+    size += align_up(capacity * sizeof(uint16_t)) * 2;
+
+    return rid_align_storage_size(size, RID_LOCATION_BATCH_ALIGN);
+}
+
+int rid_location_batch_init(
+    rid_location_batch_t *batch, void *storage, size_t storage_size, size_t capacity
+) {
+    if (batch == NULL || storage == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    if (storage_size < rid_location_batch_storage_size(capacity)) {
+        return RID_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    uint8_t *p = rid_align_storage(storage, RID_LOCATION_BATCH_ALIGN);
+
+    batch->capacity = capacity;
+    batch->count = 0;
+
+    batch->latitude = (double *)p;
+    p += align_up(capacity * sizeof(double));
+    batch->longitude = (double *)p;
+    p += align_up(capacity * sizeof(double));
+    batch->geodetic_altitude = (float *)p;
+    p += align_up(capacity * sizeof(float));
+    batch->pressure_altitude = (float *)p;
+    p += align_up(capacity * sizeof(float));
+    batch->height = (float *)p;
+    p += align_up(capacity * sizeof(float));
+    batch->speed = (float *)p;
+    p += align_up(capacity * sizeof(float));
+    batch->vertical_speed = (float *)p;
+    p += align_up(capacity * sizeof(float));
+    batch->track_direction = (uint16_t *)p;
+    p += align_up(capacity * sizeof(uint16_t));
+    batch->timestamp = (uint16_t *)p;
+
+    return RID_SUCCESS;
+}
+
+/*
+ * Widen the packed fields of one message. Anything which is not a
+ * Location message is replaced with the invalid encodings so that the
+ * kernels below never need to look at the message type.
+ */
+static void gather(const rid_location_t *location, raw_block_t *raw, size_t lane, uint16_t *timestamp) {
+    int valid = location->message_type == RID_MESSAGE_TYPE_LOCATION;
+
+    raw->latitude[lane] = valid ? location->latitude : 0;
+    raw->longitude[lane] = valid ? location->longitude : 0;
+    raw->geodetic_altitude[lane] = valid ? location->geodetic_altitude : RID_GEODETIC_ALTITUDE_INVALID_ENCODED;
+    raw->pressure_altitude[lane] = valid ? location->pressure_altitude : RID_PRESSURE_ALTITUDE_INVALID_ENCODED;
+    raw->height[lane] = valid ? location->height : RID_HEIGHT_INVALID_ENCODED;
+    raw->speed[lane] = valid ? location->speed : RID_SPEED_INVALID_ENCODED;
+    raw->speed_multiplier[lane] = valid ? location->speed_multiplier : 1;
+    raw->vertical_speed[lane] = valid ? location->vertical_speed : RID_VERTICAL_SPEED_INVALID_ENCODED;
+    raw->track_direction[lane] = valid ? location->track_direction : RID_TRACK_DIRECTION_UNKNOWN_ENCODED;
+    raw->ew_direction[lane] = location->ew_direction;
+    *timestamp = valid ? location->timestamp : RID_TIMESTAMP_INVALID;
+}
+
+static float decode_altitude_scalar(int32_t encoded) {
+    float value = ((float)encoded * 0.5f) - 1000.0f;
+    return encoded == 0 ? FLT_MAX : value;
+}
+
+/* Scalar kernel, also used for the tail of a batch. */
+static void kernel_scalar(const raw_block_t *raw, size_t lanes, rid_location_batch_t *batch, size_t offset) {
+    for (size_t i = 0; i < lanes; ++i) {
+        size_t n = offset + i;
+        int no_position = raw->latitude[i] == 0 && raw->longitude[i] == 0;
+        double latitude = (double)raw->latitude[i] / 10000000.0;
+        double longitude = (double)raw->longitude[i] / 10000000.0;
+
+        batch->latitude[n] = no_position ? RID_LATITUDE_INVALID : latitude;
+        batch->longitude[n] = no_position ? RID_LONGITUDE_INVALID : longitude;
+
+        batch->geodetic_altitude[n] = decode_altitude_scalar(raw->geodetic_altitude[i]);
+        batch->pressure_altitude[n] = decode_altitude_scalar(raw->pressure_altitude[i]);
+        batch->height[n] = decode_altitude_scalar(raw->height[i]);
+
+        float slow = (float)raw->speed[i] * 0.25f;
+        float fast = ((float)raw->speed[i] * 0.75f) + (255.0f * 0.25f);
+        int fast_mode = raw->speed_multiplier[i] == 1;
+        int speed_invalid = fast_mode && raw->speed[i] == RID_SPEED_INVALID_ENCODED;
+        batch->speed[n] = speed_invalid ? RID_SPEED_INVALID : (fast_mode ? fast : slow);
+
+        float vertical_speed = (float)raw->vertical_speed[i] * 0.5f;
+        int vertical_invalid = raw->vertical_speed[i] == RID_VERTICAL_SPEED_INVALID_ENCODED;
+        batch->vertical_speed[n] = vertical_invalid ? RID_VERTICAL_SPEED_INVALID : vertical_speed;
+
+        int track_unknown = raw->track_direction[i] == RID_TRACK_DIRECTION_UNKNOWN_ENCODED;
+        int track = raw->track_direction[i] + (raw->ew_direction[i] == RID_EW_DIRECTION_WEST ? 180 : 0);
+        batch->track_direction[n] = (uint16_t)(track_unknown ? RID_TRACK_DIRECTION_UNKNOWN : track);
+    }
+}
+
+#if defined(__AVX2__)
+
+static __m256 decode_altitude_avx2(__m256i encoded) {
+    __m256 value = _mm256_sub_ps(
+        _mm256_mul_ps(_mm256_cvtepi32_ps(encoded), _mm256_set1_ps(0.5f)),
+        _mm256_set1_ps(1000.0f)
+    );
+    __m256 invalid = _mm256_castsi256_ps(_mm256_cmpeq_epi32(encoded, _mm256_setzero_si256()));
+    return _mm256_blendv_ps(value, _mm256_set1_ps(FLT_MAX), invalid);
+}
+
+static void decode_degrees_avx2(__m128i encoded, __m128i invalid, double *out) {
+    __m256d value = _mm256_div_pd(_mm256_cvtepi32_pd(encoded), _mm256_set1_pd(10000000.0));
+    __m256d mask = _mm256_castsi256_pd(_mm256_cvtepi32_epi64(invalid));
+    _mm256_storeu_pd(out, _mm256_blendv_pd(value, _mm256_set1_pd(DBL_MAX), mask));
+}
+
+static void kernel_simd(const raw_block_t *raw, rid_location_batch_t *batch, size_t offset) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi32(1);
+
+    __m256i latitude = _mm256_load_si256((const __m256i *)raw->latitude);
+    __m256i longitude = _mm256_load_si256((const __m256i *)raw->longitude);
+    __m256i no_position = _mm256_and_si256(
+        _mm256_cmpeq_epi32(latitude, zero),
+        _mm256_cmpeq_epi32(longitude, zero)
+    );
+
+    decode_degrees_avx2(_mm256_castsi256_si128(latitude), _mm256_castsi256_si128(no_position), &batch->latitude[offset]);
+    decode_degrees_avx2(_mm256_extracti128_si256(latitude, 1), _mm256_extracti128_si256(no_position, 1), &batch->latitude[offset + 4]);
+    decode_degrees_avx2(_mm256_castsi256_si128(longitude), _mm256_castsi256_si128(no_position), &batch->longitude[offset]);
+    decode_degrees_avx2(_mm256_extracti128_si256(longitude, 1), _mm256_extracti128_si256(no_position, 1), &batch->longitude[offset + 4]);
+
+    _mm256_storeu_ps(&batch->geodetic_altitude[offset], decode_altitude_avx2(_mm256_load_si256((const __m256i *)raw->geodetic_altitude)));
+    _mm256_storeu_ps(&batch->pressure_altitude[offset], decode_altitude_avx2(_mm256_load_si256((const __m256i *)raw->pressure_altitude)));
+    _mm256_storeu_ps(&batch->height[offset], decode_altitude_avx2(_mm256_load_si256((const __m256i *)raw->height)));
+
+    __m256i speed = _mm256_load_si256((const __m256i *)raw->speed);
+    __m256 speed_f = _mm256_cvtepi32_ps(speed);
+    __m256 slow = _mm256_mul_ps(speed_f, _mm256_set1_ps(0.25f));
+    __m256 fast = _mm256_add_ps(_mm256_mul_ps(speed_f, _mm256_set1_ps(0.75f)), _mm256_set1_ps(255.0f * 0.25f));
+    __m256i fast_mode = _mm256_cmpeq_epi32(_mm256_load_si256((const __m256i *)raw->speed_multiplier), one);
+    __m256i speed_invalid = _mm256_and_si256(fast_mode, _mm256_cmpeq_epi32(speed, _mm256_set1_epi32(RID_SPEED_INVALID_ENCODED)));
+    __m256 speed_value = _mm256_blendv_ps(slow, fast, _mm256_castsi256_ps(fast_mode));
+    speed_value = _mm256_blendv_ps(speed_value, _mm256_set1_ps(RID_SPEED_INVALID), _mm256_castsi256_ps(speed_invalid));
+    _mm256_storeu_ps(&batch->speed[offset], speed_value);
+
+    __m256i vertical_speed = _mm256_load_si256((const __m256i *)raw->vertical_speed);
+    __m256 vertical_value = _mm256_mul_ps(_mm256_cvtepi32_ps(vertical_speed), _mm256_set1_ps(0.5f));
+    __m256i vertical_invalid = _mm256_cmpeq_epi32(vertical_speed, _mm256_set1_epi32(RID_VERTICAL_SPEED_INVALID_ENCODED));
+    vertical_value = _mm256_blendv_ps(vertical_value, _mm256_set1_ps(RID_VERTICAL_SPEED_INVALID), _mm256_castsi256_ps(vertical_invalid));
+    _mm256_storeu_ps(&batch->vertical_speed[offset], vertical_value);
+
+    __m256i track = _mm256_load_si256((const __m256i *)raw->track_direction);
+    __m256i west = _mm256_cmpeq_epi32(_mm256_load_si256((const __m256i *)raw->ew_direction), one);
+    __m256i track_unknown = _mm256_cmpeq_epi32(track, _mm256_set1_epi32(RID_TRACK_DIRECTION_UNKNOWN_ENCODED));
+    track = _mm256_add_epi32(track, _mm256_and_si256(west, _mm256_set1_epi32(180)));
+    track = _mm256_blendv_epi8(track, _mm256_set1_epi32(RID_TRACK_DIRECTION_UNKNOWN), track_unknown);
+    __m128i track_16 = _mm_packs_epi32(_mm256_castsi256_si128(track), _mm256_extracti128_si256(track, 1));
+    _mm_storeu_si128((__m128i *)&batch->track_direction[offset], track_16);
+}
+
+#elif defined(__SSE2__)
+
+static __m128 select_ps(__m128 a, __m128 b, __m128 mask) {
+    return _mm_or_ps(_mm_and_ps(mask, b), _mm_andnot_ps(mask, a));
+}
+
+static __m128d select_pd(__m128d a, __m128d b, __m128d mask) {
+    return _mm_or_pd(_mm_and_pd(mask, b), _mm_andnot_pd(mask, a));
+}
+
+static __m128 decode_altitude_sse2(__m128i encoded) {
+    __m128 value = _mm_sub_ps(
+        _mm_mul_ps(_mm_cvtepi32_ps(encoded), _mm_set1_ps(0.5f)),
+        _mm_set1_ps(1000.0f)
+    );
+    __m128 invalid = _mm_castsi128_ps(_mm_cmpeq_epi32(encoded, _mm_setzero_si128()));
+    return select_ps(value, _mm_set1_ps(FLT_MAX), invalid);
+}
+
+static void decode_degrees_sse2(__m128i encoded, __m128i invalid, double *out) {
+    const __m128d scale = _mm_set1_pd(10000000.0);
+    const __m128d sentinel = _mm_set1_pd(DBL_MAX);
+
+    __m128d low = _mm_div_pd(_mm_cvtepi32_pd(encoded), scale);
+    __m128d high = _mm_div_pd(_mm_cvtepi32_pd(_mm_shuffle_epi32(encoded, _MM_SHUFFLE(1, 0, 3, 2))), scale);
+
+    /* Widen 32 bit lane masks to 64 bit lane masks. */
+    __m128d low_mask = _mm_castsi128_pd(_mm_unpacklo_epi32(invalid, invalid));
+    __m128d high_mask = _mm_castsi128_pd(_mm_unpackhi_epi32(invalid, invalid));
+
+    _mm_storeu_pd(out, select_pd(low, sentinel, low_mask));
+    _mm_storeu_pd(out + 2, select_pd(high, sentinel, high_mask));
+}
+
+static void kernel_simd(const raw_block_t *raw, rid_location_batch_t *batch, size_t offset) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi32(1);
+
+    __m128i latitude = _mm_load_si128((const __m128i *)raw->latitude);
+    __m128i longitude = _mm_load_si128((const __m128i *)raw->longitude);
+    __m128i no_position = _mm_and_si128(_mm_cmpeq_epi32(latitude, zero), _mm_cmpeq_epi32(longitude, zero));
+
+    decode_degrees_sse2(latitude, no_position, &batch->latitude[offset]);
+    decode_degrees_sse2(longitude, no_position, &batch->longitude[offset]);
+
+    _mm_storeu_ps(&batch->geodetic_altitude[offset], decode_altitude_sse2(_mm_load_si128((const __m128i *)raw->geodetic_altitude)));
+    _mm_storeu_ps(&batch->pressure_altitude[offset], decode_altitude_sse2(_mm_load_si128((const __m128i *)raw->pressure_altitude)));
+    _mm_storeu_ps(&batch->height[offset], decode_altitude_sse2(_mm_load_si128((const __m128i *)raw->height)));
+
+    __m128i speed = _mm_load_si128((const __m128i *)raw->speed);
+    __m128 speed_f = _mm_cvtepi32_ps(speed);
+    __m128 slow = _mm_mul_ps(speed_f, _mm_set1_ps(0.25f));
+    __m128 fast = _mm_add_ps(_mm_mul_ps(speed_f, _mm_set1_ps(0.75f)), _mm_set1_ps(255.0f * 0.25f));
+    __m128i fast_mode = _mm_cmpeq_epi32(_mm_load_si128((const __m128i *)raw->speed_multiplier), one);
+    __m128i speed_invalid = _mm_and_si128(fast_mode, _mm_cmpeq_epi32(speed, _mm_set1_epi32(RID_SPEED_INVALID_ENCODED)));
+    __m128 speed_value = select_ps(slow, fast, _mm_castsi128_ps(fast_mode));
+    speed_value = select_ps(speed_value, _mm_set1_ps(RID_SPEED_INVALID), _mm_castsi128_ps(speed_invalid));
+    _mm_storeu_ps(&batch->speed[offset], speed_value);
+
+    __m128i vertical_speed = _mm_load_si128((const __m128i *)raw->vertical_speed);
+    __m128 vertical_value = _mm_mul_ps(_mm_cvtepi32_ps(vertical_speed), _mm_set1_ps(0.5f));
+    __m128i vertical_invalid = _mm_cmpeq_epi32(vertical_speed, _mm_set1_epi32(RID_VERTICAL_SPEED_INVALID_ENCODED));
+    vertical_value = select_ps(vertical_value, _mm_set1_ps(RID_VERTICAL_SPEED_INVALID), _mm_castsi128_ps(vertical_invalid));
+    _mm_storeu_ps(&batch->vertical_speed[offset], vertical_value);
+
+    __m128i track = _mm_load_si128((const __m128i *)raw->track_direction);
+    __m128i west = _mm_cmpeq_epi32(_mm_load_si128((const __m128i *)raw->ew_direction), one);
+    __m128i track_unknown = _mm_cmpeq_epi32(track, _mm_set1_epi32(RID_TRACK_DIRECTION_UNKNOWN_ENCODED));
+    track = _mm_add_epi32(track, _mm_and_si128(west, _mm_set1_epi32(180)));
+    track = _mm_or_si128(
+        _mm_and_si128(track_unknown, _mm_set1_epi32(RID_TRACK_DIRECTION_UNKNOWN)),
+        _mm_andnot_si128(track_unknown, track)
+    );
+    _mm_storel_epi64((__m128i *)&batch->track_direction[offset], _mm_packs_epi32(track, track));
+}
+
+#endif
+
+int rid_location_batch_decode(
+    rid_location_batch_t *batch, const void *messages, size_t stride, size_t count
+) {
+    if (batch == NULL || messages == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    if (stride == 0) {
+        stride = RID_MESSAGE_SIZE;
+    }
+
+    if (stride < RID_MESSAGE_SIZE) {
+        return RID_ERROR_OUT_OF_RANGE;
+    }
+
+    if (count > batch->capacity) {
+        return RID_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    /* Aligned so the SIMD kernels can use aligned loads. */
+    union {
+        raw_block_t raw;
+        double align[RID_LOCATION_BATCH_ALIGN / sizeof(double)];
+    } block __attribute__((aligned(RID_LOCATION_BATCH_ALIGN)));
+
+    const uint8_t *message = (const uint8_t *)messages;
+    size_t offset = 0;
+
+#if RID_LOCATION_BATCH_BLOCK > 1
+    for (; offset + RID_LOCATION_BATCH_BLOCK <= count; offset += RID_LOCATION_BATCH_BLOCK) {
+        for (size_t lane = 0; lane < RID_LOCATION_BATCH_BLOCK; ++lane) {
+            gather((const rid_location_t *)message, &block.raw, lane, &batch->timestamp[offset + lane]);
+            message += stride;
+        }
+        kernel_simd(&block.raw, batch, offset);
+    }
+#endif
+
+    for (; offset < count; ++offset) {
+        gather((const rid_location_t *)message, &block.raw, 0, &batch->timestamp[offset]);
+        kernel_scalar(&block.raw, 1, batch, offset);
+        message += stride;
+    }
+
+    batch->count = count;
+
+    return RID_SUCCESS;
+}
+
+const char *rid_location_batch_kernel(void) {
+#if defined(__AVX2__)
+    return "avx2";
+#elif defined(__SSE2__)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
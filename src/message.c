@@ -147,6 +147,16 @@ const char *rid_error_to_string(rid_error_t error) {
             return "RID_ERROR_INVALID_MESSAGE_TYPE";
         case RID_ERROR_NOT_IMPLEMENTED:
             return "RID_ERROR_NOT_IMPLEMENTED";
+        case RID_ERROR_WRITE_FAILED:
+            return "RID_ERROR_WRITE_FAILED";
+        case RID_ERROR_INVALID_JSON:
+            return "RID_ERROR_INVALID_JSON";
+        case RID_ERROR_INVALID_CAPTURE:
+            return "RID_ERROR_INVALID_CAPTURE";
+        case RID_ERROR_READ_FAILED:
+            return "RID_ERROR_READ_FAILED";
+        case RID_ERROR_INVALID_SIGNATURE:
+            return "RID_ERROR_INVALID_SIGNATURE";
         default:
             return "UNKNOWN";
     }
@@ -165,8 +175,7 @@ int rid_message_validate(const void *message) {
         case RID_MESSAGE_TYPE_LOCATION:
             return rid_location_validate((const rid_location_t *)message);
         case RID_MESSAGE_TYPE_AUTH:
-            /* TODO: No page-level validator yet */
-            return RID_SUCCESS;
+            return rid_auth_page_validate(message);
         case RID_MESSAGE_TYPE_SELF_ID:
             return rid_self_id_validate((const rid_self_id_t *)message);
         case RID_MESSAGE_TYPE_SYSTEM:
@@ -180,86 +189,154 @@ int rid_message_validate(const void *message) {
     }
 }
 
+void rid_message_json_write(rid_json_t *json, const void *message) {
+    rid_message_type_t type = rid_message_get_type(message);
+
+    switch (type) {
+        case RID_MESSAGE_TYPE_BASIC_ID:
+            rid_basic_id_json_write(json, (const rid_basic_id_t *)message);
+            break;
+        case RID_MESSAGE_TYPE_LOCATION:
+            rid_location_json_write(json, (const rid_location_t *)message);
+            break;
+        case RID_MESSAGE_TYPE_AUTH:
+            rid_auth_page_json_write(json, message);
+            break;
+        case RID_MESSAGE_TYPE_SELF_ID:
+            rid_self_id_json_write(json, (const rid_self_id_t *)message);
+            break;
+        case RID_MESSAGE_TYPE_SYSTEM:
+            rid_system_json_write(json, (const rid_system_t *)message);
+            break;
+        case RID_MESSAGE_TYPE_OPERATOR_ID:
+            rid_operator_id_json_write(json, (const rid_operator_id_t *)message);
+            break;
+        case RID_MESSAGE_TYPE_MESSAGE_PACK:
+            rid_message_pack_json_write(json, (const rid_message_pack_t *)message);
+            break;
+        default:
+            rid_json_object_start(json);
+            rid_json_key(json, "protocol_version");
+            rid_json_uint(json, rid_message_get_protocol_version(message));
+            rid_json_key(json, "message_type");
+            rid_json_uint(json, type);
+            rid_json_object_end(json);
+            break;
+    }
+}
+
 int rid_message_to_json(const void *message, char *buffer, size_t buffer_size, size_t *needed_size) {
+    rid_json_t json;
+
     if (NULL == message || (NULL == buffer && NULL == needed_size)) {
         return RID_ERROR_NULL_POINTER;
     }
 
-    rid_message_type_t type = rid_message_get_type(message);
+    rid_json_start(&json, buffer, buffer_size);
+    rid_message_json_write(&json, message);
+
+    return rid_json_end(&json, needed_size);
+}
+
+int rid_message_to_json_sink(const void *message, const rid_json_sink_t *sink) {
+    rid_json_t json;
+
+    if (NULL == message || NULL == sink || NULL == sink->write) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    rid_json_start_sink(&json, sink);
+    rid_message_json_write(&json, message);
+
+    return rid_json_end(&json, NULL);
+}
+
+int rid_message_to_cbor(const void *message, uint8_t *buffer, size_t buffer_size, size_t *needed_size) {
+    rid_json_t json;
+
+    if (NULL == message || (NULL == buffer && NULL == needed_size)) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    rid_cbor_start(&json, buffer, buffer_size);
+    rid_message_json_write(&json, message);
+
+    return rid_json_end(&json, needed_size);
+}
+
+int rid_message_json_read(rid_json_object_t *object, void *message, size_t message_size) {
+    uint32_t version;
+    uint32_t type;
+    int status;
+
+    status = rid_json_get_uint(object, "protocol_version", RID_PROTOCOL_PRIVATE_USE, &version);
+    if (status == RID_SUCCESS) {
+        status = rid_json_get_uint(object, "message_type", RID_MESSAGE_TYPE_MESSAGE_PACK, &type);
+    }
+    if (status == RID_JSON_NULL) {
+        return RID_ERROR_INVALID_JSON;
+    }
+    if (status == RID_ERROR_OUT_OF_RANGE) {
+        return RID_ERROR_UNKNOWN_MESSAGE_TYPE;
+    }
+    if (status != RID_SUCCESS) {
+        return status;
+    }
+
+    if (message_size < RID_MESSAGE_SIZE ||
+        (type == RID_MESSAGE_TYPE_MESSAGE_PACK && message_size < sizeof(rid_message_pack_t))) {
+        return RID_ERROR_BUFFER_TOO_SMALL;
+    }
 
     switch (type) {
         case RID_MESSAGE_TYPE_BASIC_ID:
-            return rid_basic_id_to_json(
-                (const rid_basic_id_t *)message,
-                buffer,
-                buffer_size,
-                needed_size
-            );
+            status = rid_basic_id_json_read(object, (rid_basic_id_t *)message);
+            break;
         case RID_MESSAGE_TYPE_LOCATION:
-            return rid_location_to_json(
-                (const rid_location_t *)message,
-                buffer,
-                buffer_size,
-                needed_size
-            );
+            status = rid_location_json_read(object, (rid_location_t *)message);
+            break;
         case RID_MESSAGE_TYPE_AUTH:
-            return rid_auth_page_to_json(
-                message,
-                buffer,
-                buffer_size,
-                needed_size
-            );
+            status = rid_auth_page_json_read(object, message);
+            break;
         case RID_MESSAGE_TYPE_SELF_ID:
-            return rid_self_id_to_json(
-                (const rid_self_id_t *)message,
-                buffer,
-                buffer_size,
-                needed_size
-            );
+            status = rid_self_id_json_read(object, (rid_self_id_t *)message);
+            break;
         case RID_MESSAGE_TYPE_SYSTEM:
-            return rid_system_to_json(
-                (const rid_system_t *)message,
-                buffer,
-                buffer_size,
-                needed_size
-            );
+            status = rid_system_json_read(object, (rid_system_t *)message);
+            break;
         case RID_MESSAGE_TYPE_OPERATOR_ID:
-            return rid_operator_id_to_json(
-                (const rid_operator_id_t *)message,
-                buffer,
-                buffer_size,
-                needed_size
-            );
+            status = rid_operator_id_json_read(object, (rid_operator_id_t *)message);
+            break;
         case RID_MESSAGE_TYPE_MESSAGE_PACK:
-            return rid_message_pack_to_json(
-                (const rid_message_pack_t *)message,
-                buffer,
-                buffer_size,
-                needed_size
-            );
-        default: {
-            rid_json_t json;
-
-            rid_json_start(&json, buffer, buffer_size);
-            rid_json_key(&json, "protocol_version");
-            rid_json_uint(&json, rid_message_get_protocol_version(message));
-            rid_json_key(&json, "message_type");
-            rid_json_uint(&json, type);
-            rid_json_end(&json);
-
-            if (needed_size != NULL) {
-                *needed_size = json.position + 1;
-            }
-
-            if (buffer == NULL) {
-                return RID_SUCCESS;
-            }
-
-            if (json.position + 1 > buffer_size) {
-                return RID_ERROR_BUFFER_TOO_SMALL;
-            }
-
-            return RID_SUCCESS;
-        }
+            status = rid_message_pack_json_read(object, (rid_message_pack_t *)message);
+            break;
+        default:
+            return RID_ERROR_UNKNOWN_MESSAGE_TYPE;
+    }
+
+    if (status != RID_SUCCESS) {
+        return status;
     }
+
+    /* Init sets version 2, keep the one that was written. */
+    ((rid_message_t *)message)->protocol_version = (uint8_t)version;
+
+    return RID_SUCCESS;
+}
+
+int rid_message_from_json(const char *json, size_t length, void *message, size_t message_size) {
+    rid_json_object_t object;
+    size_t consumed;
+    int status;
+
+    if (NULL == json || NULL == message) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    status = rid_json_parse_object(&object, json, length, &consumed);
+    if (status != RID_SUCCESS) {
+        return status;
+    }
+
+    return rid_message_json_read(&object, message, message_size);
 }
@@ -40,6 +40,14 @@ SPDX-License-Identifier: MIT
 
 #include "json.h"
 
+static void store_auth_page(rid_auth_t *auth, uint8_t page, const void *message) {
+    if (page == 0) {
+        memcpy(&auth->page_0, message, RID_MESSAGE_SIZE);
+    } else {
+        memcpy(&auth->page_x[page - 1], message, RID_MESSAGE_SIZE);
+    }
+}
+
 int rid_message_pack_init(rid_message_pack_t *pack) {
     if (pack == NULL) {
         return RID_ERROR_NULL_POINTER;
@@ -101,6 +109,46 @@ size_t rid_message_pack_messages_size(const rid_message_pack_t *pack) {
     return pack->message_count * RID_MESSAGE_SIZE;
 }
 
+int rid_message_pack_view_init(rid_message_pack_view_t *view, const uint8_t *data, size_t size) {
+    if (view == NULL || data == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    if (size < RID_MESSAGE_PACK_HEADER_SIZE) {
+        return RID_ERROR_INVALID_MESSAGE_SIZE;
+    }
+
+    const rid_message_pack_t *pack = (const rid_message_pack_t *)data;
+
+    if (pack->message_type != RID_MESSAGE_TYPE_MESSAGE_PACK) {
+        return RID_ERROR_INVALID_MESSAGE_TYPE;
+    }
+
+    if (pack->message_size != RID_MESSAGE_SIZE) {
+        return RID_ERROR_INVALID_MESSAGE_SIZE;
+    }
+
+    if (pack->message_count > RID_MESSAGE_PACK_MAX_MESSAGES) {
+        return RID_ERROR_INVALID_MESSAGE_COUNT;
+    }
+
+    if (rid_message_pack_size(pack) > size) {
+        return RID_ERROR_INVALID_MESSAGE_SIZE;
+    }
+
+    view->pack = pack;
+    view->size = rid_message_pack_size(pack);
+
+    return RID_SUCCESS;
+}
+
+const void *rid_message_pack_view_get_message_at(const rid_message_pack_view_t *view, uint8_t index) {
+    if (view == NULL) {
+        return NULL;
+    }
+    return rid_message_pack_get_message_at(view->pack, index);
+}
+
 const void *rid_message_pack_get_messages(const rid_message_pack_t *pack) {
     if (pack == NULL) {
         return NULL;
@@ -191,12 +239,7 @@ int rid_message_pack_get_auth(const rid_message_pack_t *pack, rid_auth_t *auth)
         const void *message = rid_message_pack_get_message_at(pack, i);
 
         if (rid_message_get_type(message) == RID_MESSAGE_TYPE_AUTH) {
-            if (index == 0) {
-                memcpy(&auth->page_0, message, RID_MESSAGE_SIZE);
-            } else {
-                memcpy(&auth->page_x[index - 1], message, RID_MESSAGE_SIZE);
-            }
-            ++index;
+            store_auth_page(auth, index++, message);
         }
     }
 
@@ -207,19 +250,92 @@ int rid_message_pack_get_auth(const rid_message_pack_t *pack, rid_auth_t *auth)
     return RID_SUCCESS;
 }
 
+int rid_message_pack_index_build(rid_message_pack_index_t *index, const rid_message_pack_t *pack) {
+    if (index == NULL || pack == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    if (pack->message_count > RID_MESSAGE_PACK_MAX_MESSAGES) {
+        return RID_ERROR_INVALID_MESSAGE_COUNT;
+    }
+
+    uint8_t last[16];
+
+    index->present = 0;
+    memset(index->first, RID_MESSAGE_PACK_INDEX_NONE, sizeof(index->first));
+    memset(index->next, RID_MESSAGE_PACK_INDEX_NONE, sizeof(index->next));
+
+    for (uint8_t i = 0; i < pack->message_count; ++i) {
+        uint8_t type = rid_message_get_type(&pack->messages[i * RID_MESSAGE_SIZE]);
+
+        if (index->present & (1 << type)) {
+            index->next[last[type]] = i;
+        } else {
+            index->first[type] = i;
+            index->present |= (uint16_t)(1 << type);
+        }
+        last[type] = i;
+    }
+
+    return RID_SUCCESS;
+}
+
+uint8_t rid_message_pack_index_first(const rid_message_pack_index_t *index, rid_message_type_t type) {
+    if (index == NULL || (unsigned)type >= sizeof(index->first)) {
+        return RID_MESSAGE_PACK_INDEX_NONE;
+    }
+    return index->first[type];
+}
+
+uint8_t rid_message_pack_index_next(const rid_message_pack_index_t *index, uint8_t position) {
+    if (index == NULL || position >= RID_MESSAGE_PACK_MAX_MESSAGES) {
+        return RID_MESSAGE_PACK_INDEX_NONE;
+    }
+    return index->next[position];
+}
+
+int rid_message_pack_get_auth_indexed(
+    const rid_message_pack_t *pack, const rid_message_pack_index_t *index, rid_auth_t *auth
+) {
+    if (pack == NULL || index == NULL || auth == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    rid_auth_init(auth);
+
+    uint8_t i = index->first[RID_MESSAGE_TYPE_AUTH];
+    uint8_t page = 0;
+
+    if (i == RID_MESSAGE_PACK_INDEX_NONE) {
+        return RID_ERROR_NOT_FOUND;
+    }
+
+    for (; i != RID_MESSAGE_PACK_INDEX_NONE; i = index->next[i]) {
+        store_auth_page(auth, page++, &pack->messages[i * RID_MESSAGE_SIZE]);
+    }
+
+    return RID_SUCCESS;
+}
+
 int rid_message_pack_set_auth(rid_message_pack_t *pack, const rid_auth_t *auth) {
     if (pack == NULL || auth == NULL) {
         return RID_ERROR_NULL_POINTER;
     }
 
-    uint8_t i = pack->message_count;
-    while (i > 0) {
-        --i;
-        const void *message = rid_message_pack_get_message_at(pack, i);
-        if (rid_message_get_type(message) == RID_MESSAGE_TYPE_AUTH) {
-            rid_message_pack_delete_message_at(pack, i);
+    /* Drop the old pages in a single pass, the other messages keep their order. */
+    uint8_t kept = 0;
+
+    for (uint8_t i = 0; i < pack->message_count; ++i) {
+        uint8_t *message = &pack->messages[i * RID_MESSAGE_SIZE];
+
+        if (rid_message_get_type(message) != RID_MESSAGE_TYPE_AUTH) {
+            if (kept != i) {
+                memcpy(&pack->messages[kept * RID_MESSAGE_SIZE], message, RID_MESSAGE_SIZE);
+            }
+            ++kept;
         }
     }
+    pack->message_count = kept;
 
     uint8_t page_count = rid_auth_get_page_count(auth);
 
@@ -319,82 +435,128 @@ int rid_message_pack_sort(rid_message_pack_t *pack) {
     return RID_SUCCESS;
 }
 
-int rid_message_pack_to_json(const rid_message_pack_t *pack, char *buffer, size_t buffer_size, size_t *needed_size) {
-    rid_json_t json;
+void rid_message_pack_json_write(rid_json_t *json, const rid_message_pack_t *pack) {
     rid_auth_t auth;
     uint8_t count;
 
-    if (pack == NULL || (buffer == NULL && needed_size == NULL)) {
-        return RID_ERROR_NULL_POINTER;
-    }
-
-    rid_json_start(&json, buffer, buffer_size);
-    rid_json_key(&json, "protocol_version");
-    rid_json_uint(&json, rid_message_get_protocol_version(pack));
-    rid_json_key(&json, "message_type");
-    rid_json_uint(&json, rid_message_get_type(pack));
-    rid_json_key(&json, "message_count");
-    rid_json_uint(&json, rid_message_pack_message_count(pack));
-    rid_json_key(&json, "messages");
-    rid_json_array_start(&json);
+    rid_json_object_start(json);
+    rid_json_key(json, "protocol_version");
+    rid_json_uint(json, rid_message_get_protocol_version(pack));
+    rid_json_key(json, "message_type");
+    rid_json_uint(json, rid_message_get_type(pack));
+    rid_json_key(json, "message_count");
+    rid_json_uint(json, rid_message_pack_message_count(pack));
+    rid_json_key(json, "messages");
+    rid_json_array_start(json);
 
     count = rid_message_pack_message_count(pack);
     for (uint8_t i = 0; i < count; ++i) {
         const void *msg = rid_message_pack_get_message_at(pack, i);
-        char *dest = NULL;
-        size_t remaining = 0;
-        size_t needed = 0;
 
+        /* Auth pages are combined into one message below. */
         if (rid_message_get_type(msg) == RID_MESSAGE_TYPE_AUTH) {
             continue;
         }
-
-        if (json.need_comma) {
-            rid_json_raw(&json, ",", 1);
-        }
-        if (json.buffer != NULL && json.buffer_size > json.position) {
-            dest = json.buffer + json.position;
-            remaining = json.buffer_size - json.position;
-        }
-        rid_message_to_json(msg, dest, remaining, &needed);
-        if (needed > 0) {
-            json.position += needed - 1;
-            json.need_comma = 1;
-        }
+        rid_message_json_write(json, msg);
     }
 
     if (rid_message_pack_get_auth(pack, &auth) == RID_SUCCESS) {
-        char *dest = NULL;
-        size_t remaining = 0;
-        size_t needed = 0;
+        rid_auth_json_write(json, &auth);
+    }
 
-        if (json.need_comma) {
-            rid_json_raw(&json, ",", 1);
-        }
-        if (json.buffer != NULL && json.buffer_size > json.position) {
-            dest = json.buffer + json.position;
-            remaining = json.buffer_size - json.position;
-        }
-        rid_auth_to_json(&auth, dest, remaining, &needed);
-        if (needed > 0) {
-            json.position += needed - 1;
-            json.need_comma = 1;
-        }
+    rid_json_array_end(json);
+    rid_json_object_end(json);
+}
+
+int rid_message_pack_to_json(const rid_message_pack_t *pack, char *buffer, size_t buffer_size, size_t *needed_size) {
+    rid_json_t json;
+
+    if (pack == NULL || (buffer == NULL && needed_size == NULL)) {
+        return RID_ERROR_NULL_POINTER;
     }
 
-    rid_json_array_end(&json);
-    rid_json_end(&json);
+    rid_json_start(&json, buffer, buffer_size);
+    rid_message_pack_json_write(&json, pack);
 
-    if (needed_size != NULL) {
-        *needed_size = json.position + 1;
+    return rid_json_end(&json, needed_size);
+}
+
+int rid_message_pack_to_json_sink(const rid_message_pack_t *pack, const rid_json_sink_t *sink) {
+    rid_json_t json;
+
+    if (pack == NULL || sink == NULL || sink->write == NULL) {
+        return RID_ERROR_NULL_POINTER;
     }
 
-    if (buffer == NULL) {
-        return RID_SUCCESS;
+    rid_json_start_sink(&json, sink);
+    rid_message_pack_json_write(&json, pack);
+
+    return rid_json_end(&json, NULL);
+}
+
+int rid_message_pack_to_cbor(const rid_message_pack_t *pack, uint8_t *buffer, size_t buffer_size, size_t *needed_size) {
+    rid_json_t json;
+
+    if (pack == NULL || (buffer == NULL && needed_size == NULL)) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    rid_cbor_start(&json, buffer, buffer_size);
+    rid_message_pack_json_write(&json, pack);
+
+    return rid_json_end(&json, needed_size);
+}
+
+int rid_message_pack_json_read(rid_json_object_t *object, rid_message_pack_t *pack) {
+    const rid_json_value_t *messages;
+    rid_json_object_t element;
+    rid_json_value_t value;
+    size_t offset = 0;
+    int status;
+
+    rid_message_pack_init(pack);
+
+    /* Message count follows from the array. */
+    messages = rid_json_find(object, "messages");
+    if (messages == NULL || messages->kind != RID_JSON_KIND_ARRAY) {
+        return RID_ERROR_INVALID_JSON;
+    }
+
+    while ((status = rid_json_array_next(messages, &offset, &value)) == RID_SUCCESS) {
+        size_t consumed;
+
+        if (value.kind != RID_JSON_KIND_OBJECT) {
+            return RID_ERROR_INVALID_JSON;
+        }
+
+        status = rid_json_parse_object(&element, value.start, value.length, &consumed);
+        if (status != RID_SUCCESS) {
+            return status;
+        }
+
+        /* Auth pages were combined into one message when written. */
+        if (rid_json_find(&element, "page_count") != NULL) {
+            rid_auth_t auth;
+
+            status = rid_auth_json_read(&element, &auth);
+            if (status == RID_SUCCESS) {
+                status = rid_message_pack_set_auth(pack, &auth);
+            }
+        } else {
+            rid_message_t message;
+
+            status = rid_message_json_read(&element, &message, sizeof(message));
+            if (status == RID_SUCCESS) {
+                status = rid_message_pack_add_message(pack, &message);
+            }
+        }
+        if (status != RID_SUCCESS) {
+            return status;
+        }
     }
 
-    if (json.position + 1 > buffer_size) {
-        return RID_ERROR_BUFFER_TOO_SMALL;
+    if (status != RID_ERROR_NOT_FOUND) {
+        return status;
     }
 
     return RID_SUCCESS;
@@ -0,0 +1,214 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of librid: https://github.com/tuupola/librid
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "rid/message.h"
+#include "rid/message_pack.h"
+#include "rid/nan.h"
+#include "rid/transport.h"
+
+#define RID_NAN_FRAME_CONTROL_ACTION 0xD0
+#define RID_NAN_CATEGORY_PUBLIC_ACTION 0x04
+#define RID_NAN_ACTION_VENDOR_SPECIFIC 0x09
+#define RID_NAN_OUI_TYPE 0x13
+#define RID_NAN_ATTRIBUTE_SERVICE_DESCRIPTOR 0x03
+#define RID_NAN_ATTRIBUTE_SERVICE_DESCRIPTOR_EXTENSION 0x0E
+#define RID_NAN_SERVICE_CONTROL_INFO_PRESENT 0x10
+
+/* Offsets into the frame. */
+#define RID_NAN_SOURCE_OFFSET 10
+#define RID_NAN_ACTION_OFFSET 24
+#define RID_NAN_ATTRIBUTES_OFFSET 30
+
+/* Attribute ID and two byte length. */
+#define RID_NAN_ATTRIBUTE_HEADER_SIZE 3
+
+/* Service ID, instance IDs, service control and info length. */
+#define RID_NAN_SERVICE_DESCRIPTOR_SIZE 10
+
+#define RID_NAN_SERVICE_ID_SIZE 6
+
+/* First six bytes of SHA-256("org.opendroneid.remoteid"). */
+static const uint8_t rid_nan_service_id[RID_NAN_SERVICE_ID_SIZE] = {
+    0x88, 0x69, 0x19, 0x9D, 0x92, 0x09
+};
+
+/* Everything up to the attributes, source address is filled in when building. */
+static const uint8_t rid_nan_header[RID_NAN_ATTRIBUTES_OFFSET] = {
+    RID_NAN_FRAME_CONTROL_ACTION, 0x00,
+    0x00, 0x00,
+    0x51, 0x6F, 0x9A, 0x01, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    (RID_TRANSPORT_WIFI_NAN_CLUSTER_ID >> 40) & 0xFF,
+    (RID_TRANSPORT_WIFI_NAN_CLUSTER_ID >> 32) & 0xFF,
+    (RID_TRANSPORT_WIFI_NAN_CLUSTER_ID >> 24) & 0xFF,
+    (RID_TRANSPORT_WIFI_NAN_CLUSTER_ID >> 16) & 0xFF,
+    (RID_TRANSPORT_WIFI_NAN_CLUSTER_ID >> 8) & 0xFF,
+    RID_TRANSPORT_WIFI_NAN_CLUSTER_ID & 0xFF,
+    0x00, 0x00,
+    RID_NAN_CATEGORY_PUBLIC_ACTION,
+    RID_NAN_ACTION_VENDOR_SPECIFIC,
+    (RID_TRANSPORT_WIFI_NAN_OUI >> 16) & 0xFF,
+    (RID_TRANSPORT_WIFI_NAN_OUI >> 8) & 0xFF,
+    RID_TRANSPORT_WIFI_NAN_OUI & 0xFF,
+    RID_NAN_OUI_TYPE,
+};
+
+int rid_nan_parse_service_info(const uint8_t *data, size_t size, rid_nan_frame_t *frame) {
+    rid_message_pack_view_t view;
+
+    if (NULL == data || NULL == frame) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    if (size < 1 + RID_MESSAGE_PACK_HEADER_SIZE) {
+        return RID_ERROR_INVALID_MESSAGE_SIZE;
+    }
+
+    int status = rid_message_pack_view_init(&view, data + 1, size - 1);
+    if (status != RID_SUCCESS) {
+        return status;
+    }
+
+    frame->message_size = view.size;
+
+    frame->counter = data[0];
+    frame->message = data + 1;
+
+    return RID_SUCCESS;
+}
+
+int rid_nan_parse(const uint8_t *data, size_t size, rid_nan_frame_t *frame) {
+    const uint8_t *end = data + size;
+    const uint8_t *p;
+
+    if (NULL == data || NULL == frame) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    /* Reject everything which is not a NAN public action frame. */
+    if (size < RID_NAN_ATTRIBUTES_OFFSET ||
+        data[0] != RID_NAN_FRAME_CONTROL_ACTION ||
+        memcmp(&data[RID_NAN_ACTION_OFFSET], &rid_nan_header[RID_NAN_ACTION_OFFSET],
+               RID_NAN_ATTRIBUTES_OFFSET - RID_NAN_ACTION_OFFSET) != 0) {
+        return RID_ERROR_NOT_FOUND;
+    }
+
+    /* Each attribute is an ID and a little endian length followed by the body. */
+    p = data + RID_NAN_ATTRIBUTES_OFFSET;
+    while (end - p >= RID_NAN_ATTRIBUTE_HEADER_SIZE) {
+        size_t length = (size_t)p[1] | ((size_t)p[2] << 8);
+        const uint8_t *body = p + RID_NAN_ATTRIBUTE_HEADER_SIZE;
+
+        if (length > (size_t)(end - body)) {
+            break;
+        }
+
+        if (p[0] == RID_NAN_ATTRIBUTE_SERVICE_DESCRIPTOR &&
+            length >= RID_NAN_SERVICE_DESCRIPTOR_SIZE &&
+            memcmp(body, rid_nan_service_id, RID_NAN_SERVICE_ID_SIZE) == 0 &&
+            (body[8] & RID_NAN_SERVICE_CONTROL_INFO_PRESENT)) {
+            size_t info_length = body[9];
+            int status;
+
+            if (info_length > length - RID_NAN_SERVICE_DESCRIPTOR_SIZE) {
+                return RID_ERROR_INVALID_MESSAGE_SIZE;
+            }
+
+            status = rid_nan_parse_service_info(body + RID_NAN_SERVICE_DESCRIPTOR_SIZE, info_length, frame);
+            if (status == RID_SUCCESS) {
+                memcpy(frame->source.octets, &data[RID_NAN_SOURCE_OFFSET], RID_ADDRESS_SIZE);
+            }
+            return status;
+        }
+
+        p = body + length;
+    }
+
+    return RID_ERROR_NOT_FOUND;
+}
+
+int rid_nan_build(
+    const rid_message_pack_t *pack, uint8_t counter, const rid_address_t *source,
+    uint8_t *buffer, size_t buffer_size, size_t *written
+) {
+    uint8_t *p = buffer;
+    size_t size;
+
+    if (NULL == pack || NULL == source || NULL == buffer) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    if (pack->message_count > RID_MESSAGE_PACK_MAX_MESSAGES) {
+        return RID_ERROR_INVALID_MESSAGE_COUNT;
+    }
+    size = rid_message_pack_size(pack);
+
+    if (buffer_size < RID_NAN_HEADER_SIZE + size + RID_NAN_TRAILER_SIZE) {
+        return RID_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    memcpy(p, rid_nan_header, sizeof(rid_nan_header));
+    memcpy(&p[RID_NAN_SOURCE_OFFSET], source->octets, RID_ADDRESS_SIZE);
+    p += sizeof(rid_nan_header);
+
+    /* Service Descriptor Attribute, published with service info. */
+    p[0] = RID_NAN_ATTRIBUTE_SERVICE_DESCRIPTOR;
+    p[1] = (uint8_t)(RID_NAN_SERVICE_DESCRIPTOR_SIZE + 1 + size);
+    p[2] = 0x00;
+    memcpy(&p[3], rid_nan_service_id, RID_NAN_SERVICE_ID_SIZE);
+    p[9] = 0x01;
+    p[10] = 0x00;
+    p[11] = RID_NAN_SERVICE_CONTROL_INFO_PRESENT;
+    p[12] = (uint8_t)(1 + size);
+    p[13] = counter;
+    memcpy(&p[14], pack, size);
+    p += 14 + size;
+
+    /* Service Descriptor Extension Attribute, counter is the update indicator. */
+    p[0] = RID_NAN_ATTRIBUTE_SERVICE_DESCRIPTOR_EXTENSION;
+    p[1] = 0x04;
+    p[2] = 0x00;
+    p[3] = 0x01;
+    p[4] = 0x00;
+    p[5] = 0x02;
+    p[6] = counter;
+
+    if (written != NULL) {
+        *written = RID_NAN_HEADER_SIZE + size + RID_NAN_TRAILER_SIZE;
+    }
+
+    return RID_SUCCESS;
+}
@@ -0,0 +1,256 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of librid: https://github.com/tuupola/librid
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "rid/message.h"
+#include "rid/message_pack.h"
+#include "rid/ndjson.h"
+#include "rid/transport.h"
+
+#include "json.h"
+
+static void rid_ndjson_address(rid_json_t *json, const rid_address_t *address) {
+    static const char hex[] = "0123456789abcdef";
+    char token[RID_ADDRESS_SIZE * 3 + 1];
+    char *p = token;
+
+    *p++ = '"';
+    for (size_t i = 0; i < RID_ADDRESS_SIZE; ++i) {
+        *p++ = hex[address->octets[i] >> 4];
+        *p++ = hex[address->octets[i] & 0x0F];
+        *p++ = ':';
+    }
+    /* Closing quote replaces the trailing colon. */
+    p[-1] = '"';
+
+    rid_json_raw(json, token, (size_t)(p - token));
+}
+
+static void rid_ndjson_message(rid_json_t *json, const void *message, size_t stride) {
+    /* A Message Pack which does not fit in the stride would be read past its end. */
+    if (rid_message_get_type(message) == RID_MESSAGE_TYPE_MESSAGE_PACK &&
+        rid_message_pack_size((const rid_message_pack_t *)message) > stride) {
+        rid_json_object_start(json);
+        rid_json_key(json, "protocol_version");
+        rid_json_uint(json, rid_message_get_protocol_version(message));
+        rid_json_key(json, "message_type");
+        rid_json_uint(json, RID_MESSAGE_TYPE_MESSAGE_PACK);
+        rid_json_object_end(json);
+        return;
+    }
+
+    rid_message_json_write(json, message);
+}
+
+static void rid_ndjson_write(
+    rid_json_t *json, const uint8_t *message, size_t stride, size_t count,
+    const uint64_t *timestamps, const rid_address_t *sources
+) {
+    int wrap = timestamps != NULL || sources != NULL;
+
+    for (size_t i = 0; i < count; ++i) {
+        if (wrap) {
+            rid_json_object_start(json);
+            if (timestamps != NULL) {
+                rid_json_key(json, "received");
+                rid_json_uint64(json, timestamps[i]);
+            }
+            if (sources != NULL) {
+                rid_json_key(json, "source");
+                rid_ndjson_address(json, &sources[i]);
+            }
+            rid_json_key(json, "message");
+            rid_ndjson_message(json, message, stride);
+            rid_json_object_end(json);
+        } else {
+            rid_ndjson_message(json, message, stride);
+        }
+        rid_json_newline(json);
+        message += stride;
+    }
+}
+
+int rid_messages_to_ndjson(
+    const void *messages, size_t stride, size_t count,
+    const uint64_t *timestamps, const rid_address_t *sources,
+    char *buffer, size_t buffer_size, size_t *needed_size
+) {
+    rid_json_t json;
+
+    if (NULL == messages || (NULL == buffer && NULL == needed_size)) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    if (stride == 0) {
+        stride = RID_MESSAGE_SIZE;
+    }
+
+    if (stride < RID_MESSAGE_SIZE) {
+        return RID_ERROR_OUT_OF_RANGE;
+    }
+
+    rid_json_start(&json, buffer, buffer_size);
+    rid_ndjson_write(&json, messages, stride, count, timestamps, sources);
+
+    return rid_json_end(&json, needed_size);
+}
+
+int rid_messages_to_ndjson_sink(
+    const void *messages, size_t stride, size_t count,
+    const uint64_t *timestamps, const rid_address_t *sources,
+    const rid_json_sink_t *sink
+) {
+    rid_json_t json;
+
+    if (NULL == messages || NULL == sink || NULL == sink->write) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    if (stride == 0) {
+        stride = RID_MESSAGE_SIZE;
+    }
+
+    if (stride < RID_MESSAGE_SIZE) {
+        return RID_ERROR_OUT_OF_RANGE;
+    }
+
+    rid_json_start_sink(&json, sink);
+    rid_ndjson_write(&json, messages, stride, count, timestamps, sources);
+
+    return rid_json_end(&json, NULL);
+}
+
+int rid_ndjson_reader_init(rid_ndjson_reader_t *reader, const char *data, size_t length) {
+    if (NULL == reader || NULL == data) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    reader->data = data;
+    reader->length = length;
+    reader->position = 0;
+    reader->line = 0;
+
+    return RID_SUCCESS;
+}
+
+static int rid_ndjson_is_blank(const char *line, size_t length) {
+    for (size_t i = 0; i < length; ++i) {
+        if (line[i] != ' ' && line[i] != '\t' && line[i] != '\r') {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static int rid_ndjson_read_line(
+    const char *line, size_t length, void *message, size_t message_size,
+    uint64_t *received, rid_address_t *source
+) {
+    rid_json_object_t object;
+    const rid_json_value_t *wrapped;
+    size_t consumed;
+    size_t size;
+    int status;
+
+    status = rid_json_parse_object(&object, line, length, &consumed);
+    if (status != RID_SUCCESS) {
+        return status;
+    }
+    if (!rid_ndjson_is_blank(line + consumed, length - consumed)) {
+        return RID_ERROR_INVALID_JSON;
+    }
+
+    wrapped = rid_json_find(&object, "message");
+    if (wrapped == NULL) {
+        return rid_message_json_read(&object, message, message_size);
+    }
+    if (wrapped->kind != RID_JSON_KIND_OBJECT) {
+        return RID_ERROR_INVALID_JSON;
+    }
+
+    if (received != NULL && rid_json_find(&object, "received") != NULL) {
+        status = rid_json_get_uint64(&object, "received", received);
+        if (status != RID_SUCCESS) {
+            return status < RID_SUCCESS ? status : RID_ERROR_INVALID_JSON;
+        }
+    }
+
+    if (source != NULL && rid_json_find(&object, "source") != NULL) {
+        status = rid_json_get_hex(&object, "source", source->octets, RID_ADDRESS_SIZE, &size);
+        if (status != RID_SUCCESS || size != RID_ADDRESS_SIZE) {
+            return status < RID_SUCCESS ? status : RID_ERROR_INVALID_JSON;
+        }
+    }
+
+    /* Members of the outer object are not needed anymore. */
+    status = rid_json_parse_object(&object, wrapped->start, wrapped->length, &consumed);
+    if (status != RID_SUCCESS) {
+        return status;
+    }
+
+    return rid_message_json_read(&object, message, message_size);
+}
+
+int rid_ndjson_reader_next(
+    rid_ndjson_reader_t *reader, void *message, size_t message_size,
+    uint64_t *received, rid_address_t *source
+) {
+    if (NULL == reader || NULL == message) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    if (received != NULL) {
+        *received = 0;
+    }
+    if (source != NULL) {
+        memset(source, 0, sizeof(*source));
+    }
+
+    while (reader->position < reader->length) {
+        const char *line = reader->data + reader->position;
+        size_t remaining = reader->length - reader->position;
+        const char *end = memchr(line, '\n', remaining);
+        size_t length = end != NULL ? (size_t)(end - line) : remaining;
+
+        reader->position += end != NULL ? length + 1 : length;
+        reader->line++;
+
+        if (!rid_ndjson_is_blank(line, length)) {
+            return rid_ndjson_read_line(line, length, message, message_size, received, source);
+        }
+    }
+
+    return RID_ERROR_NOT_FOUND;
+}
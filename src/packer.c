@@ -0,0 +1,231 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of librid: https://github.com/tuupola/librid
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "rid/basic_id.h"
+#include "rid/message.h"
+#include "rid/message_pack.h"
+#include "rid/packer.h"
+#include "rid/transport.h"
+
+static int same_slot(const rid_message_t *a, const rid_message_t *b) {
+    if (a->message_type != b->message_type) {
+        return 0;
+    }
+
+    if (a->message_type == RID_MESSAGE_TYPE_BASIC_ID) {
+        return ((const rid_basic_id_t *)a)->id_type == ((const rid_basic_id_t *)b)->id_type;
+    }
+
+    return 1;
+}
+
+/*
+ * Pending messages first by priority and age of the update. Then the
+ * rest by priority and the time they were last packed.
+ */
+static int before(const rid_packer_entry_t *a, const rid_packer_entry_t *b) {
+    if (a->pending != b->pending) {
+        return a->pending > b->pending;
+    }
+    if (a->priority != b->priority) {
+        return a->priority > b->priority;
+    }
+    if (a->pending) {
+        return a->updated < b->updated;
+    }
+    return a->packed < b->packed;
+}
+
+int rid_packer_init(rid_packer_t *packer, rid_transport_t transport) {
+    if (packer == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    size_t payload = rid_transport_get_max_payload(transport);
+
+    if (payload < RID_MESSAGE_PACK_MIN_SIZE) {
+        return RID_ERROR_OUT_OF_RANGE;
+    }
+
+    size_t max_messages = (payload - RID_MESSAGE_PACK_HEADER_SIZE) / RID_MESSAGE_SIZE;
+
+    packer->transport = transport;
+    packer->max_messages = max_messages > RID_MESSAGE_PACK_MAX_MESSAGES ? RID_MESSAGE_PACK_MAX_MESSAGES : (uint8_t)max_messages;
+    packer->auth_pages = 0;
+
+    return rid_packer_clear(packer);
+}
+
+int rid_packer_clear(rid_packer_t *packer) {
+    if (packer == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    packer->count = 0;
+
+    return RID_SUCCESS;
+}
+
+int rid_packer_set_auth_pages(rid_packer_t *packer, uint8_t pages) {
+    if (packer == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    if (pages >= packer->max_messages) {
+        return RID_ERROR_OUT_OF_RANGE;
+    }
+
+    packer->auth_pages = pages;
+
+    return RID_SUCCESS;
+}
+
+uint8_t rid_packer_get_capacity(const rid_packer_t *packer) {
+    if (packer == NULL) {
+        return 0;
+    }
+    return packer->max_messages - packer->auth_pages;
+}
+
+int rid_packer_add_message(rid_packer_t *packer, const void *message, uint8_t priority, uint64_t now) {
+    if (packer == NULL || message == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    rid_message_type_t type = rid_message_get_type(message);
+
+    if (type > RID_MESSAGE_TYPE_OPERATOR_ID || type == RID_MESSAGE_TYPE_AUTH) {
+        return RID_ERROR_INVALID_MESSAGE_TYPE;
+    }
+
+    rid_packer_entry_t *entry = NULL;
+
+    for (uint8_t i = 0; i < packer->count; ++i) {
+        if (same_slot(&packer->entries[i].message, (const rid_message_t *)message)) {
+            entry = &packer->entries[i];
+            break;
+        }
+    }
+
+    if (entry == NULL) {
+        if (packer->count >= RID_PACKER_MAX_MESSAGES) {
+            return RID_ERROR_BUFFER_TOO_SMALL;
+        }
+        entry = &packer->entries[packer->count++];
+        entry->packed = 0;
+    }
+
+    memcpy(&entry->message, message, RID_MESSAGE_SIZE);
+    entry->priority = priority;
+    entry->pending = 1;
+    entry->updated = now;
+
+    return RID_SUCCESS;
+}
+
+size_t rid_packer_expire(rid_packer_t *packer, uint64_t older_than) {
+    if (packer == NULL) {
+        return 0;
+    }
+
+    uint8_t kept = 0;
+
+    for (uint8_t i = 0; i < packer->count; ++i) {
+        if (packer->entries[i].updated >= older_than) {
+            packer->entries[kept++] = packer->entries[i];
+        }
+    }
+
+    size_t removed = packer->count - kept;
+    packer->count = kept;
+
+    return removed;
+}
+
+size_t rid_packer_pending(const rid_packer_t *packer) {
+    if (packer == NULL) {
+        return 0;
+    }
+
+    size_t pending = 0;
+
+    for (uint8_t i = 0; i < packer->count; ++i) {
+        pending += packer->entries[i].pending;
+    }
+    return pending;
+}
+
+int rid_packer_build(rid_packer_t *packer, rid_message_pack_t *pack, uint64_t now) {
+    if (packer == NULL || pack == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    if (packer->count == 0) {
+        return RID_ERROR_NOT_FOUND;
+    }
+
+    uint8_t order[RID_PACKER_MAX_MESSAGES];
+    uint8_t capacity = rid_packer_get_capacity(packer);
+
+    /* Insertion sort of the indexes, the pool is small. */
+    for (uint8_t i = 0; i < packer->count; ++i) {
+        uint8_t j = i;
+
+        while (j > 0 && before(&packer->entries[i], &packer->entries[order[j - 1]])) {
+            order[j] = order[j - 1];
+            --j;
+        }
+        order[j] = i;
+    }
+
+    if (capacity > packer->count) {
+        capacity = packer->count;
+    }
+
+    rid_message_pack_init(pack);
+
+    for (uint8_t i = 0; i < capacity; ++i) {
+        rid_packer_entry_t *entry = &packer->entries[order[i]];
+
+        memcpy(&pack->messages[i * RID_MESSAGE_SIZE], &entry->message, RID_MESSAGE_SIZE);
+        entry->pending = 0;
+        entry->packed = now;
+    }
+    pack->message_count = capacity;
+    rid_message_pack_sort(pack);
+
+    return capacity;
+}
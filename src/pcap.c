@@ -0,0 +1,724 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of librid: https://github.com/tuupola/librid
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#if defined(__unix__) || defined(__APPLE__)
+#define _POSIX_C_SOURCE 200112L
+#define RID_PCAP_MMAP 1
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(RID_PCAP_MMAP)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "rid/beacon.h"
+#include "rid/bluetooth.h"
+#include "rid/message.h"
+#include "rid/nan.h"
+#include "rid/pcap.h"
+#include "rid/transport.h"
+
+#define RID_PCAP_MAGIC_MICROSECONDS 0xA1B2C3D4
+#define RID_PCAP_MAGIC_NANOSECONDS 0xA1B23C4D
+#define RID_PCAP_FILE_HEADER_SIZE 24
+#define RID_PCAP_RECORD_HEADER_SIZE 16
+
+#define RID_PCAPNG_BYTE_ORDER_MAGIC 0x1A2B3C4D
+#define RID_PCAPNG_SECTION_HEADER 0x0A0D0D0A
+#define RID_PCAPNG_INTERFACE_DESCRIPTION 0x00000001
+#define RID_PCAPNG_PACKET 0x00000002
+#define RID_PCAPNG_SIMPLE_PACKET 0x00000003
+#define RID_PCAPNG_NAME_RESOLUTION 0x00000004
+#define RID_PCAPNG_INTERFACE_STATISTICS 0x00000005
+#define RID_PCAPNG_ENHANCED_PACKET 0x00000006
+#define RID_PCAPNG_DECRYPTION_SECRETS 0x0000000A
+#define RID_PCAPNG_MIN_BLOCK_SIZE 12
+#define RID_PCAPNG_MIN_SECTION_HEADER_SIZE 28
+#define RID_PCAPNG_OPTION_TSRESOL 9
+
+/* Default timestamp resolution is microseconds, 10^-6. */
+#define RID_PCAP_RESOLUTION_MICROSECONDS 6
+#define RID_PCAP_RESOLUTION_NANOSECONDS 9
+
+/* Largest snapshot length used by libpcap. */
+#define RID_PCAP_MAX_SNAPLEN 262144
+
+/* Number of consecutive records which must look valid when splitting. */
+#define RID_PCAP_SYNC_RECORDS 4
+
+/* Records must be from a day before to a year after the first one when splitting. */
+#define RID_PCAP_SYNC_SLACK 86400
+#define RID_PCAP_SYNC_WINDOW (367 * 86400)
+
+#define RID_PCAP_BLE_ADVERTISING_ACCESS_ADDRESS 0x8E89BED6
+#define RID_PCAP_BLE_ACCESS_ADDRESS_SIZE 4
+#define RID_PCAP_BLE_PSEUDO_HEADER_SIZE 10
+#define RID_PCAP_BLE_PDU_HEADER_SIZE 2
+#define RID_PCAP_BLE_ADV_IND 0x00
+#define RID_PCAP_BLE_ADV_NONCONN_IND 0x02
+#define RID_PCAP_BLE_SCAN_RSP 0x04
+#define RID_PCAP_BLE_ADV_SCAN_IND 0x06
+#define RID_PCAP_BLE_ADV_EXT_IND 0x07
+#define RID_PCAP_BLE_EXT_HEADER_ADVA 0x01
+
+#define RID_PCAP_IEEE802_11_HEADER_SIZE 24
+#define RID_PCAP_IEEE802_11_SOURCE_OFFSET 10
+#define RID_PCAP_IEEE802_11_BEACON 0x80
+#define RID_PCAP_IEEE802_11_ACTION 0xD0
+#define RID_PCAP_IEEE802_11_ORDER 0x80
+#define RID_PCAP_IEEE802_11_HT_CONTROL_SIZE 4
+
+typedef struct rid_pcap_packet {
+    const uint8_t *data;
+    size_t length;
+    uint64_t timestamp;
+    uint32_t link_type;
+} rid_pcap_packet_t;
+
+static uint16_t rid_pcap_le16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t rid_pcap_le32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint32_t rid_pcap_be32(const uint8_t *p) {
+    return (uint32_t)p[3] | ((uint32_t)p[2] << 8) | ((uint32_t)p[1] << 16) | ((uint32_t)p[0] << 24);
+}
+
+/* Capture files are written in the byte order of the capturing host. */
+static uint32_t rid_pcap_u32(const rid_pcap_reader_t *reader, const uint8_t *p) {
+    return reader->swapped ? rid_pcap_be32(p) : rid_pcap_le32(p);
+}
+
+static uint16_t rid_pcap_u16(const rid_pcap_reader_t *reader, const uint8_t *p) {
+    return reader->swapped ? (uint16_t)((p[0] << 8) | p[1]) : rid_pcap_le16(p);
+}
+
+/* Convert ticks of 10^-n or 2^-n seconds as given by if_tsresol to microseconds. */
+static uint64_t rid_pcap_microseconds(uint64_t ticks, uint8_t resolution) {
+    uint8_t exponent = resolution & 0x7F;
+    uint64_t scale = 1;
+
+    if (resolution & 0x80) {
+        if (exponent > 32) {
+            ticks >>= exponent - 32;
+            exponent = 32;
+        }
+        return (ticks >> exponent) * 1000000 + (((ticks & ((1ULL << exponent) - 1)) * 1000000) >> exponent);
+    }
+
+    if (exponent == RID_PCAP_RESOLUTION_MICROSECONDS) {
+        return ticks;
+    }
+
+    if (exponent > RID_PCAP_RESOLUTION_MICROSECONDS + 19) {
+        return 0;
+    }
+
+    if (exponent > RID_PCAP_RESOLUTION_MICROSECONDS) {
+        for (uint8_t i = RID_PCAP_RESOLUTION_MICROSECONDS; i < exponent; ++i) {
+            scale *= 10;
+        }
+        return ticks / scale;
+    }
+
+    for (uint8_t i = exponent; i < RID_PCAP_RESOLUTION_MICROSECONDS; ++i) {
+        scale *= 10;
+    }
+    return ticks * scale;
+}
+
+static void rid_pcap_read_interface(rid_pcap_reader_t *reader, const uint8_t *block, size_t size) {
+    size_t offset = 16;
+    uint8_t index = reader->interface_count;
+
+    if (index >= RID_PCAP_MAX_INTERFACES) {
+        return;
+    }
+
+    reader->link_types[index] = rid_pcap_u16(reader, &block[8]);
+    reader->resolutions[index] = RID_PCAP_RESOLUTION_MICROSECONDS;
+
+    /* Options are a code and length followed by the value padded to 32 bits. */
+    while (offset + 4 <= size - 4) {
+        uint16_t code = rid_pcap_u16(reader, &block[offset]);
+        uint16_t length = rid_pcap_u16(reader, &block[offset + 2]);
+
+        if (code == 0 || length > size - 4 - offset - 4) {
+            break;
+        }
+        if (code == RID_PCAPNG_OPTION_TSRESOL && length >= 1) {
+            reader->resolutions[index] = block[offset + 4];
+        }
+        offset += 4 + (((size_t)length + 3) & ~(size_t)3);
+    }
+
+    reader->interface_count++;
+}
+
+/*
+ * Read one record and advance. Returns 1 for a packet, 0 for a pcapng
+ * block which is not a packet, or an error.
+ */
+static int rid_pcap_read(rid_pcap_reader_t *reader, rid_pcap_packet_t *packet) {
+    const uint8_t *p = reader->data + reader->position;
+    size_t remaining = reader->end - reader->position;
+    uint32_t type;
+    uint32_t size;
+    uint32_t interface;
+    uint32_t captured;
+
+    if (remaining == 0) {
+        return RID_ERROR_NOT_FOUND;
+    }
+
+    if (!reader->pcapng) {
+        if (remaining < RID_PCAP_RECORD_HEADER_SIZE) {
+            return RID_ERROR_INVALID_CAPTURE;
+        }
+        captured = rid_pcap_u32(reader, &p[8]);
+        if (captured > remaining - RID_PCAP_RECORD_HEADER_SIZE) {
+            return RID_ERROR_INVALID_CAPTURE;
+        }
+        packet->data = p + RID_PCAP_RECORD_HEADER_SIZE;
+        packet->length = captured;
+        packet->link_type = reader->link_types[0];
+        packet->timestamp = (uint64_t)rid_pcap_u32(reader, p) * 1000000 +
+            rid_pcap_microseconds(rid_pcap_u32(reader, &p[4]), reader->resolutions[0]);
+        reader->position += RID_PCAP_RECORD_HEADER_SIZE + captured;
+        return 1;
+    }
+
+    if (remaining < RID_PCAPNG_MIN_BLOCK_SIZE) {
+        return RID_ERROR_INVALID_CAPTURE;
+    }
+
+    /* Section header type reads the same in both byte orders and sets the order. */
+    type = rid_pcap_le32(p);
+    if (type == RID_PCAPNG_SECTION_HEADER) {
+        if (remaining < RID_PCAPNG_MIN_SECTION_HEADER_SIZE) {
+            return RID_ERROR_INVALID_CAPTURE;
+        }
+        if (rid_pcap_le32(&p[8]) == RID_PCAPNG_BYTE_ORDER_MAGIC) {
+            reader->swapped = 0;
+        } else if (rid_pcap_be32(&p[8]) == RID_PCAPNG_BYTE_ORDER_MAGIC) {
+            reader->swapped = 1;
+        } else {
+            return RID_ERROR_INVALID_CAPTURE;
+        }
+        reader->interface_count = 0;
+    } else {
+        type = rid_pcap_u32(reader, p);
+    }
+
+    size = rid_pcap_u32(reader, &p[4]);
+    if (size < RID_PCAPNG_MIN_BLOCK_SIZE || size % 4 != 0 || size > remaining) {
+        return RID_ERROR_INVALID_CAPTURE;
+    }
+    reader->position += size;
+
+    switch (type) {
+        case RID_PCAPNG_INTERFACE_DESCRIPTION:
+            if (size >= 20) {
+                rid_pcap_read_interface(reader, p, size);
+            }
+            return 0;
+
+        case RID_PCAPNG_ENHANCED_PACKET:
+        case RID_PCAPNG_PACKET:
+            if (size < 32) {
+                return 0;
+            }
+            if (type == RID_PCAPNG_PACKET) {
+                interface = rid_pcap_u16(reader, &p[8]);
+            } else {
+                interface = rid_pcap_u32(reader, &p[8]);
+            }
+            captured = rid_pcap_u32(reader, &p[20]);
+            if (interface >= reader->interface_count || interface >= RID_PCAP_MAX_INTERFACES ||
+                captured > size - 32) {
+                return 0;
+            }
+            packet->data = p + 28;
+            packet->length = captured;
+            packet->link_type = reader->link_types[interface];
+            packet->timestamp = rid_pcap_microseconds(
+                ((uint64_t)rid_pcap_u32(reader, &p[12]) << 32) | rid_pcap_u32(reader, &p[16]),
+                reader->resolutions[interface]
+            );
+            return 1;
+
+        case RID_PCAPNG_SIMPLE_PACKET:
+            if (size < 16 || reader->interface_count == 0) {
+                return 0;
+            }
+            captured = rid_pcap_u32(reader, &p[8]);
+            packet->data = p + 12;
+            packet->length = captured < size - 16 ? captured : size - 16;
+            packet->link_type = reader->link_types[0];
+            packet->timestamp = 0;
+            return 1;
+
+        default:
+            return 0;
+    }
+}
+
+static int rid_pcap_decode_ieee802_11(const uint8_t *data, size_t length, rid_pcap_record_t *record) {
+    size_t header = RID_PCAP_IEEE802_11_HEADER_SIZE;
+    int status;
+
+    if (length < header) {
+        return RID_ERROR_NOT_FOUND;
+    }
+
+    if (data[0] == RID_PCAP_IEEE802_11_BEACON) {
+        rid_beacon_frame_t frame;
+
+        if (data[1] & RID_PCAP_IEEE802_11_ORDER) {
+            header += RID_PCAP_IEEE802_11_HT_CONTROL_SIZE;
+            if (length < header) {
+                return RID_ERROR_NOT_FOUND;
+            }
+        }
+        status = rid_beacon_parse(data + header, length - header, &frame);
+        if (status == RID_SUCCESS) {
+            record->message = frame.message;
+            record->message_size = frame.message_size;
+            record->counter = frame.counter;
+            record->transport = RID_TRANSPORT_WIFI_BEACON;
+            memcpy(record->source.octets, &data[RID_PCAP_IEEE802_11_SOURCE_OFFSET], RID_ADDRESS_SIZE);
+        }
+        return status;
+    }
+
+    if (data[0] == RID_PCAP_IEEE802_11_ACTION) {
+        rid_nan_frame_t frame;
+
+        status = rid_nan_parse(data, length, &frame);
+        if (status == RID_SUCCESS) {
+            record->message = frame.message;
+            record->message_size = frame.message_size;
+            record->counter = frame.counter;
+            record->transport = RID_TRANSPORT_WIFI_NAN;
+            record->source = frame.source;
+        }
+        return status;
+    }
+
+    return RID_ERROR_NOT_FOUND;
+}
+
+static int rid_pcap_decode_radiotap(const uint8_t *data, size_t length, rid_pcap_record_t *record) {
+    size_t header;
+
+    /* Radiotap is always little endian regardless of the capture. */
+    if (length < 8 || data[0] != 0) {
+        return RID_ERROR_NOT_FOUND;
+    }
+
+    header = rid_pcap_le16(&data[2]);
+    if (header > length) {
+        return RID_ERROR_NOT_FOUND;
+    }
+
+    return rid_pcap_decode_ieee802_11(data + header, length - header, record);
+}
+
+static int rid_pcap_decode_bluetooth(const uint8_t *data, size_t length, rid_pcap_record_t *record) {
+    const uint8_t *pdu = data + RID_PCAP_BLE_ACCESS_ADDRESS_SIZE;
+    const uint8_t *payload = pdu + RID_PCAP_BLE_PDU_HEADER_SIZE;
+    const uint8_t *address = NULL;
+    const uint8_t *advertising;
+    size_t payload_length;
+    size_t advertising_length;
+    rid_bluetooth_frame_t frame;
+    int status;
+
+    if (length < RID_PCAP_BLE_ACCESS_ADDRESS_SIZE + RID_PCAP_BLE_PDU_HEADER_SIZE ||
+        rid_pcap_le32(data) != RID_PCAP_BLE_ADVERTISING_ACCESS_ADDRESS) {
+        return RID_ERROR_NOT_FOUND;
+    }
+
+    /* Length from the PDU header so the CRC is not included. */
+    payload_length = pdu[1];
+    if (payload_length > length - RID_PCAP_BLE_ACCESS_ADDRESS_SIZE - RID_PCAP_BLE_PDU_HEADER_SIZE) {
+        payload_length = length - RID_PCAP_BLE_ACCESS_ADDRESS_SIZE - RID_PCAP_BLE_PDU_HEADER_SIZE;
+    }
+
+    switch (pdu[0] & 0x0F) {
+        case RID_PCAP_BLE_ADV_IND:
+        case RID_PCAP_BLE_ADV_NONCONN_IND:
+        case RID_PCAP_BLE_SCAN_RSP:
+        case RID_PCAP_BLE_ADV_SCAN_IND:
+            if (payload_length < RID_ADDRESS_SIZE) {
+                return RID_ERROR_NOT_FOUND;
+            }
+            address = payload;
+            advertising = payload + RID_ADDRESS_SIZE;
+            advertising_length = payload_length - RID_ADDRESS_SIZE;
+            record->transport = RID_TRANSPORT_BLUETOOTH_LEGACY;
+            break;
+
+        case RID_PCAP_BLE_ADV_EXT_IND: {
+            /* Extended header length and flags, AdvA is the first optional field. */
+            size_t header;
+
+            if (payload_length < 1) {
+                return RID_ERROR_NOT_FOUND;
+            }
+            header = payload[0] & 0x3F;
+            if (header + 1 > payload_length) {
+                return RID_ERROR_NOT_FOUND;
+            }
+            if (header >= 1 + RID_ADDRESS_SIZE && (payload[1] & RID_PCAP_BLE_EXT_HEADER_ADVA)) {
+                address = payload + 2;
+            }
+            advertising = payload + 1 + header;
+            advertising_length = payload_length - 1 - header;
+            record->transport = RID_TRANSPORT_BLUETOOTH_LONG_RANGE;
+            break;
+        }
+
+        default:
+            return RID_ERROR_NOT_FOUND;
+    }
+
+    status = rid_bluetooth_parse(advertising, advertising_length, &frame);
+    if (status != RID_SUCCESS) {
+        return status;
+    }
+
+    record->message = frame.message;
+    record->message_size = frame.message_size;
+    record->counter = frame.counter;
+    if (address != NULL) {
+        memcpy(record->source.octets, address, RID_ADDRESS_SIZE);
+    } else {
+        memset(record->source.octets, 0, RID_ADDRESS_SIZE);
+    }
+
+    return RID_SUCCESS;
+}
+
+static int rid_pcap_decode(const rid_pcap_packet_t *packet, rid_pcap_record_t *record) {
+    switch (packet->link_type) {
+        case RID_PCAP_LINKTYPE_IEEE802_11_RADIOTAP:
+            return rid_pcap_decode_radiotap(packet->data, packet->length, record);
+        case RID_PCAP_LINKTYPE_IEEE802_11:
+            return rid_pcap_decode_ieee802_11(packet->data, packet->length, record);
+        case RID_PCAP_LINKTYPE_BLUETOOTH_LE_LL:
+            return rid_pcap_decode_bluetooth(packet->data, packet->length, record);
+        case RID_PCAP_LINKTYPE_BLUETOOTH_LE_LL_WITH_PHDR:
+            if (packet->length < RID_PCAP_BLE_PSEUDO_HEADER_SIZE) {
+                return RID_ERROR_NOT_FOUND;
+            }
+            return rid_pcap_decode_bluetooth(
+                packet->data + RID_PCAP_BLE_PSEUDO_HEADER_SIZE,
+                packet->length - RID_PCAP_BLE_PSEUDO_HEADER_SIZE, record
+            );
+        default:
+            return RID_ERROR_NOT_FOUND;
+    }
+}
+
+int rid_pcap_map(rid_pcap_mapping_t *mapping, const char *path) {
+    if (NULL == mapping || NULL == path) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+#if defined(RID_PCAP_MMAP)
+    struct stat status;
+    void *address;
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0) {
+        return RID_ERROR_READ_FAILED;
+    }
+
+    if (fstat(fd, &status) != 0 || status.st_size <= 0) {
+        close(fd);
+        return RID_ERROR_READ_FAILED;
+    }
+
+    address = mmap(NULL, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED) {
+        return RID_ERROR_READ_FAILED;
+    }
+
+    posix_madvise(address, (size_t)status.st_size, POSIX_MADV_SEQUENTIAL);
+
+    mapping->data = (const uint8_t *)address;
+    mapping->size = (size_t)status.st_size;
+
+    return RID_SUCCESS;
+#else
+    return RID_ERROR_NOT_IMPLEMENTED;
+#endif
+}
+
+int rid_pcap_unmap(rid_pcap_mapping_t *mapping) {
+    if (NULL == mapping) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+#if defined(RID_PCAP_MMAP)
+    if (mapping->data != NULL) {
+        munmap((void *)mapping->data, mapping->size);
+    }
+    mapping->data = NULL;
+    mapping->size = 0;
+
+    return RID_SUCCESS;
+#else
+    return RID_ERROR_NOT_IMPLEMENTED;
+#endif
+}
+
+int rid_pcap_reader_init(rid_pcap_reader_t *reader, const uint8_t *data, size_t size) {
+    rid_pcap_packet_t packet;
+
+    if (NULL == reader || NULL == data) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    memset(reader, 0, sizeof(*reader));
+    reader->data = data;
+    reader->end = size;
+
+    if (size >= RID_PCAP_FILE_HEADER_SIZE) {
+        uint32_t magic = rid_pcap_le32(data);
+
+        if (magic != RID_PCAP_MAGIC_MICROSECONDS && magic != RID_PCAP_MAGIC_NANOSECONDS) {
+            magic = rid_pcap_be32(data);
+            reader->swapped = 1;
+        }
+
+        if (magic == RID_PCAP_MAGIC_MICROSECONDS || magic == RID_PCAP_MAGIC_NANOSECONDS) {
+            reader->resolutions[0] = magic == RID_PCAP_MAGIC_NANOSECONDS ?
+                RID_PCAP_RESOLUTION_NANOSECONDS : RID_PCAP_RESOLUTION_MICROSECONDS;
+            reader->snaplen = rid_pcap_u32(reader, &data[16]);
+            /* Upper bits hold FCS information. */
+            reader->link_types[0] = rid_pcap_u32(reader, &data[20]) & 0xFFFF;
+            reader->interface_count = 1;
+            reader->position = RID_PCAP_FILE_HEADER_SIZE;
+            return RID_SUCCESS;
+        }
+        reader->swapped = 0;
+    }
+
+    if (size < RID_PCAPNG_MIN_SECTION_HEADER_SIZE || rid_pcap_le32(data) != RID_PCAPNG_SECTION_HEADER) {
+        return RID_ERROR_INVALID_CAPTURE;
+    }
+
+    /* Read the section header and the interface descriptions following it. */
+    reader->pcapng = 1;
+    do {
+        if (rid_pcap_read(reader, &packet) != 0) {
+            return RID_ERROR_INVALID_CAPTURE;
+        }
+    } while (reader->end - reader->position >= 4 &&
+             rid_pcap_u32(reader, &data[reader->position]) == RID_PCAPNG_INTERFACE_DESCRIPTION);
+
+    return RID_SUCCESS;
+}
+
+int rid_pcap_reader_next(rid_pcap_reader_t *reader, rid_pcap_record_t *record) {
+    rid_pcap_packet_t packet;
+    int status;
+
+    if (NULL == reader || NULL == record) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    for (;;) {
+        status = rid_pcap_read(reader, &packet);
+        if (status < 0) {
+            /* Do not try to resynchronize after a corrupt record. */
+            reader->position = reader->end;
+            return status;
+        }
+        if (status == 1 && rid_pcap_decode(&packet, record) == RID_SUCCESS) {
+            record->timestamp = packet.timestamp;
+            return RID_SUCCESS;
+        }
+    }
+}
+
+/*
+ * Check whether a plausible pcap record header starts at offset. Packet
+ * data easily looks like a header, especially runs of zeros, so the time
+ * must also be close to the time of the first record.
+ */
+static int rid_pcap_record_at(const rid_pcap_reader_t *reader, size_t offset, uint32_t first, size_t *next) {
+    const uint8_t *p = reader->data + offset;
+    uint32_t seconds;
+    uint32_t captured;
+    uint32_t original;
+    uint32_t fraction;
+    uint32_t limit = reader->resolutions[0] == RID_PCAP_RESOLUTION_NANOSECONDS ? 1000000000 : 1000000;
+
+    if (reader->end - offset < RID_PCAP_RECORD_HEADER_SIZE) {
+        return 0;
+    }
+
+    seconds = rid_pcap_u32(reader, p);
+    fraction = rid_pcap_u32(reader, &p[4]);
+    captured = rid_pcap_u32(reader, &p[8]);
+    original = rid_pcap_u32(reader, &p[12]);
+
+    if (seconds + RID_PCAP_SYNC_SLACK - first > RID_PCAP_SYNC_WINDOW || fraction >= limit || captured == 0 || captured > original || captured > RID_PCAP_MAX_SNAPLEN ||
+        (reader->snaplen != 0 && captured > reader->snaplen) ||
+        captured > reader->end - offset - RID_PCAP_RECORD_HEADER_SIZE) {
+        return 0;
+    }
+
+    *next = offset + RID_PCAP_RECORD_HEADER_SIZE + captured;
+    return 1;
+}
+
+/* Check whether a plausible pcapng block starts at offset. */
+static int rid_pcapng_block_at(const rid_pcap_reader_t *reader, size_t offset, size_t *next) {
+    const uint8_t *p = reader->data + offset;
+    uint32_t type;
+    uint32_t size;
+
+    if (reader->end - offset < RID_PCAPNG_MIN_BLOCK_SIZE) {
+        return 0;
+    }
+
+    type = rid_pcap_u32(reader, p);
+    if (type != RID_PCAPNG_SECTION_HEADER && type != RID_PCAPNG_DECRYPTION_SECRETS &&
+        (type < RID_PCAPNG_INTERFACE_DESCRIPTION || type > RID_PCAPNG_ENHANCED_PACKET)) {
+        return 0;
+    }
+
+    size = rid_pcap_u32(reader, &p[4]);
+    if (size < RID_PCAPNG_MIN_BLOCK_SIZE || size % 4 != 0 || size > reader->end - offset ||
+        rid_pcap_u32(reader, &p[size - 4]) != size) {
+        return 0;
+    }
+
+    *next = offset + size;
+    return 1;
+}
+
+/* First offset at or after start where several consecutive records are valid. */
+static size_t rid_pcap_sync(const rid_pcap_reader_t *reader, size_t start, uint32_t first) {
+    size_t step = 1;
+
+    /* Blocks are padded to 32 bits so pcapng records are aligned. */
+    if (reader->pcapng) {
+        step = 4;
+        start = (start + 3) & ~(size_t)3;
+    }
+
+    for (size_t offset = start; offset < reader->end; offset += step) {
+        size_t position = offset;
+        size_t records = 0;
+
+        while (records < RID_PCAP_SYNC_RECORDS && position < reader->end) {
+            int valid = reader->pcapng ? rid_pcapng_block_at(reader, position, &position)
+                                       : rid_pcap_record_at(reader, position, first, &position);
+            if (!valid) {
+                break;
+            }
+            records++;
+        }
+
+        if (records == RID_PCAP_SYNC_RECORDS || (records > 0 && position == reader->end)) {
+            return offset;
+        }
+    }
+
+    return reader->end;
+}
+
+int rid_pcap_reader_split(
+    const rid_pcap_reader_t *reader, rid_pcap_reader_t *chunks, size_t count, size_t *chunk_count
+) {
+    size_t start;
+    size_t span;
+    size_t previous;
+    size_t created = 0;
+    uint32_t first = 0;
+
+    if (NULL == reader || NULL == chunks || NULL == chunk_count) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    if (count == 0) {
+        return RID_ERROR_OUT_OF_RANGE;
+    }
+
+    start = reader->position;
+    span = reader->end - start;
+    previous = start;
+
+    if (!reader->pcapng && span >= RID_PCAP_RECORD_HEADER_SIZE) {
+        first = rid_pcap_u32(reader, &reader->data[start]);
+    }
+
+    for (size_t i = 1; i < count; ++i) {
+        size_t boundary = rid_pcap_sync(reader, start + span / count * i, first);
+
+        if (boundary >= reader->end) {
+            break;
+        }
+        if (boundary <= previous) {
+            continue;
+        }
+
+        chunks[created] = *reader;
+        chunks[created].position = previous;
+        chunks[created].end = boundary;
+        created++;
+        previous = boundary;
+    }
+
+    chunks[created] = *reader;
+    chunks[created].position = previous;
+    created++;
+
+    *chunk_count = created;
+
+    return RID_SUCCESS;
+}
@@ -0,0 +1,446 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of librid: https://github.com/tuupola/librid
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "align.h"
+#include "atomic.h"
+#include "rid/message.h"
+#include "rid/pcap.h"
+#include "rid/pipeline.h"
+#include "rid/tracker.h"
+#include "rid/transport.h"
+
+/* Counters written by different stages are kept on separate cache lines. */
+#define RID_PIPELINE_CACHE_LINE 64
+
+/*
+ * Ring buffer counters run freely and are masked when indexing. Each
+ * side keeps a cached copy of the counter of the other side so the
+ * shared cache line is only read when the ring looks full or empty.
+ */
+struct rid_pipeline_worker {
+    /* Written by the reader. */
+    rid_atomic_size_t input_head;
+    size_t input_cached_tail;
+    uint8_t reader_padding[RID_PIPELINE_CACHE_LINE - sizeof(rid_atomic_size_t) - sizeof(size_t)];
+
+    /* Written by the worker. */
+    rid_atomic_size_t input_tail;
+    size_t input_cached_head;
+    rid_atomic_size_t output_head;
+    size_t output_cached_tail;
+    rid_tracker_t tracker;
+    uint8_t worker_padding[2 * RID_PIPELINE_CACHE_LINE - 2 * sizeof(rid_atomic_size_t) - 2 * sizeof(size_t) - sizeof(rid_tracker_t)];
+
+    /* Written by the output stage. */
+    rid_atomic_size_t output_tail;
+    size_t output_cached_head;
+    uint8_t output_padding[RID_PIPELINE_CACHE_LINE - sizeof(rid_atomic_size_t) - sizeof(size_t)];
+
+    /* Read only after initialization. */
+    rid_pipeline_item_t *input;
+    rid_pipeline_item_t *output;
+    uint8_t padding[RID_PIPELINE_CACHE_LINE - 2 * sizeof(void *)];
+};
+
+/* Order ring telling the output stage which worker has the next item. */
+struct rid_pipeline_shared {
+    /* Written by the reader. */
+    rid_atomic_size_t order_head;
+    size_t order_cached_tail;
+    uint64_t sequence;
+    rid_atomic_size_t closed;
+    uint8_t reader_padding[RID_PIPELINE_CACHE_LINE - 2 * sizeof(rid_atomic_size_t) - sizeof(size_t) - sizeof(uint64_t)];
+
+    /* Written by the output stage. */
+    rid_atomic_size_t order_tail;
+    size_t order_cached_head;
+    size_t next_worker;
+    uint8_t output_padding[RID_PIPELINE_CACHE_LINE - sizeof(rid_atomic_size_t) - 2 * sizeof(size_t)];
+};
+
+static size_t align_up(size_t value) {
+    return rid_align_up(value, RID_PIPELINE_CACHE_LINE);
+}
+
+/* Every item in flight is in an input or output ring, so the order ring never fills up. */
+static size_t order_size(size_t worker_count, size_t capacity) {
+    size_t size = 1;
+
+    while (size < worker_count * capacity * 2) {
+        size <<= 1;
+    }
+    return size;
+}
+
+static size_t worker_size(size_t capacity, size_t tracker_capacity) {
+    return align_up(capacity * sizeof(rid_pipeline_item_t)) * 2 + align_up(rid_tracker_storage_size(tracker_capacity));
+}
+
+static int valid_arguments(size_t worker_count, size_t capacity, size_t tracker_capacity) {
+    if (worker_count == 0 || worker_count > RID_PIPELINE_MAX_WORKERS) {
+        return 0;
+    }
+    if (capacity == 0 || capacity > RID_PIPELINE_MAX_CAPACITY || (capacity & (capacity - 1)) != 0) {
+        return 0;
+    }
+    return rid_tracker_storage_size(tracker_capacity) != 0;
+}
+
+/* Fibonacci hashing, high bits select the worker and low bits the tracker slot. */
+static size_t worker_of(const rid_pipeline_t *pipeline, const rid_address_t *address) {
+    uint64_t key = 0;
+
+    for (size_t i = 0; i < RID_ADDRESS_SIZE; ++i) {
+        key = (key << 8) | address->octets[i];
+    }
+
+    uint32_t hash = (uint32_t)((key * 0x9E3779B97F4A7C15ULL) >> 32);
+    return (size_t)(((uint64_t)hash * pipeline->worker_count) >> 32);
+}
+
+size_t rid_pipeline_storage_size(size_t worker_count, size_t capacity, size_t tracker_capacity) {
+    if (!valid_arguments(worker_count, capacity, tracker_capacity)) {
+        return 0;
+    }
+
+    return rid_align_storage_size(
+        worker_count * sizeof(struct rid_pipeline_worker) + sizeof(struct rid_pipeline_shared) +
+            worker_count * worker_size(capacity, tracker_capacity) + order_size(worker_count, capacity),
+        RID_PIPELINE_CACHE_LINE
+    );
+}
+
+int rid_pipeline_init(
+    rid_pipeline_t *pipeline, void *storage, size_t storage_size, size_t worker_count, size_t capacity,
+    size_t tracker_capacity, rid_pipeline_mode_t mode
+) {
+    if (pipeline == NULL || storage == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    if (!valid_arguments(worker_count, capacity, tracker_capacity) ||
+        (mode != RID_PIPELINE_UNORDERED && mode != RID_PIPELINE_ORDERED)) {
+        return RID_ERROR_OUT_OF_RANGE;
+    }
+
+    if (storage_size < rid_pipeline_storage_size(worker_count, capacity, tracker_capacity)) {
+        return RID_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    uint8_t *p = rid_align_storage(storage, RID_PIPELINE_CACHE_LINE);
+    size_t items = align_up(capacity * sizeof(rid_pipeline_item_t));
+    size_t tracker_size = align_up(rid_tracker_storage_size(tracker_capacity));
+
+    pipeline->worker_count = worker_count;
+    pipeline->capacity = capacity;
+    pipeline->mode = mode;
+    pipeline->callback = NULL;
+    pipeline->context = NULL;
+    pipeline->workers = (struct rid_pipeline_worker *)p;
+    p += worker_count * sizeof(struct rid_pipeline_worker);
+    pipeline->shared = (struct rid_pipeline_shared *)p;
+    p += sizeof(struct rid_pipeline_shared);
+
+    memset(pipeline->workers, 0, worker_count * sizeof(struct rid_pipeline_worker));
+    memset(pipeline->shared, 0, sizeof(struct rid_pipeline_shared));
+    rid_atomic_init(&pipeline->shared->order_head, 0);
+    rid_atomic_init(&pipeline->shared->order_tail, 0);
+    rid_atomic_init(&pipeline->shared->closed, 0);
+
+    for (size_t i = 0; i < worker_count; ++i) {
+        struct rid_pipeline_worker *worker = &pipeline->workers[i];
+
+        rid_atomic_init(&worker->input_head, 0);
+        rid_atomic_init(&worker->input_tail, 0);
+        rid_atomic_init(&worker->output_head, 0);
+        rid_atomic_init(&worker->output_tail, 0);
+        worker->input = (rid_pipeline_item_t *)p;
+        worker->output = (rid_pipeline_item_t *)(p + items);
+        rid_tracker_init(&worker->tracker, p + items * 2, tracker_size, tracker_capacity);
+        p += items * 2 + tracker_size;
+    }
+
+    pipeline->order = p;
+    pipeline->order_mask = order_size(worker_count, capacity) - 1;
+
+    return RID_SUCCESS;
+}
+
+int rid_pipeline_set_callback(rid_pipeline_t *pipeline, rid_pipeline_callback_t callback, void *context) {
+    if (pipeline == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    pipeline->callback = callback;
+    pipeline->context = context;
+
+    return RID_SUCCESS;
+}
+
+int rid_pipeline_push(rid_pipeline_t *pipeline, const rid_pcap_record_t *record) {
+    if (pipeline == NULL || record == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    struct rid_pipeline_shared *shared = pipeline->shared;
+    size_t index = worker_of(pipeline, &record->source);
+    struct rid_pipeline_worker *worker = &pipeline->workers[index];
+    size_t head = rid_atomic_load(&worker->input_head);
+
+    if (head - worker->input_cached_tail == pipeline->capacity) {
+        worker->input_cached_tail = rid_atomic_load(&worker->input_tail);
+        if (head - worker->input_cached_tail == pipeline->capacity) {
+            return RID_ERROR_BUFFER_TOO_SMALL;
+        }
+    }
+
+    rid_pipeline_item_t *item = &worker->input[head & (pipeline->capacity - 1)];
+
+    item->record = *record;
+    item->sequence = shared->sequence++;
+    item->status = RID_SUCCESS;
+    rid_atomic_store(&worker->input_head, head + 1);
+
+    if (pipeline->mode == RID_PIPELINE_ORDERED) {
+        size_t order_head = rid_atomic_load(&shared->order_head);
+
+        pipeline->order[order_head & pipeline->order_mask] = (uint8_t)index;
+        rid_atomic_store(&shared->order_head, order_head + 1);
+    }
+
+    return RID_SUCCESS;
+}
+
+int rid_pipeline_close(rid_pipeline_t *pipeline) {
+    if (pipeline == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    rid_atomic_store(&pipeline->shared->closed, 1);
+
+    return RID_SUCCESS;
+}
+
+int rid_pipeline_work(rid_pipeline_t *pipeline, size_t index, size_t max) {
+    if (pipeline == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    if (index >= pipeline->worker_count) {
+        return RID_ERROR_OUT_OF_RANGE;
+    }
+
+    struct rid_pipeline_worker *worker = &pipeline->workers[index];
+    size_t mask = pipeline->capacity - 1;
+    size_t tail = rid_atomic_load(&worker->input_tail);
+    size_t head = rid_atomic_load(&worker->output_head);
+    size_t available = worker->input_cached_head - tail;
+    size_t space = pipeline->capacity - (head - worker->output_cached_tail);
+
+    if (available < max) {
+        worker->input_cached_head = rid_atomic_load(&worker->input_head);
+        available = worker->input_cached_head - tail;
+    }
+    if (space < available && space < max) {
+        worker->output_cached_tail = rid_atomic_load(&worker->output_tail);
+        space = pipeline->capacity - (head - worker->output_cached_tail);
+    }
+
+    size_t count = available < space ? available : space;
+    if (count > max) {
+        count = max;
+    }
+
+    if (count == 0) {
+        /* Closed is read first so no push can happen after the check. */
+        if (available == 0 && rid_atomic_load(&pipeline->shared->closed) &&
+            rid_atomic_load(&worker->input_head) == tail) {
+            return RID_ERROR_NOT_FOUND;
+        }
+        return 0;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        rid_pipeline_item_t *item = &worker->output[(head + i) & mask];
+
+        *item = worker->input[(tail + i) & mask];
+        item->status = rid_tracker_update(
+            &worker->tracker, &item->record.source, item->record.message, item->record.timestamp
+        );
+        if (pipeline->callback != NULL) {
+            item->status = pipeline->callback(pipeline->context, &worker->tracker, item);
+        }
+    }
+
+    /* Publish the output before freeing the input so an item is always in one of them. */
+    rid_atomic_store(&worker->output_head, head + count);
+    rid_atomic_store(&worker->input_tail, tail + count);
+
+    return (int)count;
+}
+
+/* Pop up to count items from the output ring of a worker. */
+static size_t collect_from(
+    rid_pipeline_t *pipeline, struct rid_pipeline_worker *worker, rid_pipeline_item_t *items, size_t count
+) {
+    size_t mask = pipeline->capacity - 1;
+    size_t tail = rid_atomic_load(&worker->output_tail);
+    size_t available = worker->output_cached_head - tail;
+
+    if (available < count) {
+        worker->output_cached_head = rid_atomic_load(&worker->output_head);
+        available = worker->output_cached_head - tail;
+    }
+    if (count > available) {
+        count = available;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        items[i] = worker->output[(tail + i) & mask];
+    }
+
+    rid_atomic_store(&worker->output_tail, tail + count);
+
+    return count;
+}
+
+static size_t collect_ordered(rid_pipeline_t *pipeline, rid_pipeline_item_t *items, size_t count) {
+    struct rid_pipeline_shared *shared = pipeline->shared;
+    size_t tail = rid_atomic_load(&shared->order_tail);
+    size_t collected = 0;
+
+    while (collected < count) {
+        if (tail == shared->order_cached_head) {
+            shared->order_cached_head = rid_atomic_load(&shared->order_head);
+            if (tail == shared->order_cached_head) {
+                break;
+            }
+        }
+
+        struct rid_pipeline_worker *worker = &pipeline->workers[pipeline->order[tail & pipeline->order_mask]];
+        if (collect_from(pipeline, worker, &items[collected], 1) == 0) {
+            break;
+        }
+        collected++;
+        tail++;
+    }
+
+    rid_atomic_store(&shared->order_tail, tail);
+
+    return collected;
+}
+
+static size_t collect_unordered(rid_pipeline_t *pipeline, rid_pipeline_item_t *items, size_t count) {
+    struct rid_pipeline_shared *shared = pipeline->shared;
+    size_t collected = 0;
+
+    /* Start from a different worker each time so none of them is starved. */
+    for (size_t i = 0; i < pipeline->worker_count && collected < count; ++i) {
+        size_t index = (shared->next_worker + i) % pipeline->worker_count;
+        collected += collect_from(pipeline, &pipeline->workers[index], &items[collected], count - collected);
+    }
+    shared->next_worker = (shared->next_worker + 1) % pipeline->worker_count;
+
+    return collected;
+}
+
+static int finished(rid_pipeline_t *pipeline) {
+    struct rid_pipeline_shared *shared = pipeline->shared;
+
+    if (!rid_atomic_load(&shared->closed)) {
+        return 0;
+    }
+
+    if (pipeline->mode == RID_PIPELINE_ORDERED) {
+        return rid_atomic_load(&shared->order_head) == rid_atomic_load(&shared->order_tail);
+    }
+
+    for (size_t i = 0; i < pipeline->worker_count; ++i) {
+        struct rid_pipeline_worker *worker = &pipeline->workers[i];
+
+        if (rid_atomic_load(&worker->input_tail) != rid_atomic_load(&worker->input_head) ||
+            rid_atomic_load(&worker->output_head) != rid_atomic_load(&worker->output_tail)) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+int rid_pipeline_collect(rid_pipeline_t *pipeline, rid_pipeline_item_t *items, size_t count) {
+    size_t collected;
+
+    if (pipeline == NULL || items == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    if (count > (size_t)INT32_MAX) {
+        count = INT32_MAX;
+    }
+
+    if (pipeline->mode == RID_PIPELINE_ORDERED) {
+        collected = collect_ordered(pipeline, items, count);
+    } else {
+        collected = collect_unordered(pipeline, items, count);
+    }
+
+    if (collected == 0 && count > 0 && finished(pipeline)) {
+        return RID_ERROR_NOT_FOUND;
+    }
+
+    return (int)collected;
+}
+
+size_t rid_pipeline_worker(const rid_pipeline_t *pipeline, const rid_address_t *address) {
+    if (pipeline == NULL || address == NULL) {
+        return 0;
+    }
+    return worker_of(pipeline, address);
+}
+
+rid_tracker_t *rid_pipeline_tracker(rid_pipeline_t *pipeline, size_t worker) {
+    if (pipeline == NULL || worker >= pipeline->worker_count) {
+        return NULL;
+    }
+    return &pipeline->workers[worker].tracker;
+}
+
+const rid_aircraft_t *rid_pipeline_find(rid_pipeline_t *pipeline, const rid_address_t *address) {
+    if (pipeline == NULL || address == NULL) {
+        return NULL;
+    }
+    return rid_tracker_find(&pipeline->workers[worker_of(pipeline, address)].tracker, address);
+}
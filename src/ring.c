@@ -0,0 +1,295 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of librid: https://github.com/tuupola/librid
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "align.h"
+#include "atomic.h"
+#include "rid/message.h"
+#include "rid/message_pack.h"
+#include "rid/ring.h"
+
+#if defined(ESP_PLATFORM)
+portMUX_TYPE rid_atomic_mux = portMUX_INITIALIZER_UNLOCKED;
+#endif
+
+struct rid_ring_counters {
+    /* Written by the producers. */
+    rid_atomic_size_t head;
+    uint8_t producer_padding[RID_RING_CACHE_LINE - sizeof(rid_atomic_size_t)];
+
+    /* Written by the consumer. */
+    rid_atomic_size_t tail;
+    uint8_t consumer_padding[RID_RING_CACHE_LINE - sizeof(rid_atomic_size_t)];
+};
+
+/*
+ * Each slot starts with a sequence number telling who owns it. The slot
+ * for position p is free for the producer when the sequence is p and
+ * holds a message for the consumer when it is p + 1. Producers and the
+ * consumer only touch the slot they work on, the ring never needs to
+ * compare head and tail.
+ */
+#define RID_RING_DATA_OFFSET sizeof(rid_atomic_size_t)
+
+static size_t slot_size(rid_ring_type_t type) {
+    return type == RID_RING_MESSAGE ? RID_RING_MESSAGE_SLOT_SIZE : RID_RING_MESSAGE_PACK_SLOT_SIZE;
+}
+
+/* Stride of the caller arrays. */
+static size_t message_stride(rid_ring_type_t type) {
+    return type == RID_RING_MESSAGE ? RID_MESSAGE_SIZE : sizeof(rid_message_pack_t);
+}
+
+static rid_atomic_size_t *sequence_at(const rid_ring_t *ring, size_t position) {
+    return (rid_atomic_size_t *)(ring->slots + (position & (ring->capacity - 1)) * ring->slot_size);
+}
+
+static uint8_t *data_at(const rid_ring_t *ring, size_t position) {
+    return ring->slots + (position & (ring->capacity - 1)) * ring->slot_size + RID_RING_DATA_OFFSET;
+}
+
+/*
+ * One memcpy per message. Sizes are constants so the copies are inlined,
+ * a variable length copy of only the packed messages is slower.
+ */
+static void copy_message(const rid_ring_t *ring, uint8_t *destination, const uint8_t *source) {
+    if (ring->type == RID_RING_MESSAGE) {
+        memcpy(destination, source, RID_MESSAGE_SIZE);
+    } else {
+        memcpy(destination, source, RID_MESSAGE_PACK_MAX_SIZE);
+    }
+}
+
+/* Number of leading messages which fit in a slot. */
+static size_t valid_count(const rid_ring_t *ring, const uint8_t *messages, size_t count) {
+    if (ring->type == RID_RING_MESSAGE) {
+        return count;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        const rid_message_pack_t *pack = (const rid_message_pack_t *)(messages + i * sizeof(rid_message_pack_t));
+
+        if (pack->message_count > RID_MESSAGE_PACK_MAX_MESSAGES) {
+            return i;
+        }
+    }
+    return count;
+}
+
+size_t rid_ring_storage_size(rid_ring_type_t type, size_t capacity) {
+    if ((type != RID_RING_MESSAGE && type != RID_RING_MESSAGE_PACK) || capacity == 0 ||
+        capacity > RID_RING_MAX_CAPACITY || (capacity & (capacity - 1)) != 0) {
+        return 0;
+    }
+
+    return rid_align_storage_size(sizeof(struct rid_ring_counters) + capacity * slot_size(type), RID_RING_CACHE_LINE);
+}
+
+int rid_ring_init(
+    rid_ring_t *ring, void *storage, size_t storage_size, rid_ring_type_t type, size_t capacity,
+    rid_ring_producer_t producer
+) {
+    if (ring == NULL || storage == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    size_t size = rid_ring_storage_size(type, capacity);
+
+    if (size == 0 || (producer != RID_RING_SINGLE_PRODUCER && producer != RID_RING_MULTI_PRODUCER)) {
+        return RID_ERROR_OUT_OF_RANGE;
+    }
+
+    if (storage_size < size) {
+        return RID_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    uint8_t *p = rid_align_storage(storage, RID_RING_CACHE_LINE);
+
+    ring->counters = (struct rid_ring_counters *)p;
+    ring->slots = p + sizeof(struct rid_ring_counters);
+    ring->capacity = capacity;
+    ring->slot_size = slot_size(type);
+    ring->type = type;
+    ring->producer = producer;
+
+    memset(ring->counters, 0, sizeof(struct rid_ring_counters));
+    rid_atomic_init(&ring->counters->head, 0);
+    rid_atomic_init(&ring->counters->tail, 0);
+
+    for (size_t i = 0; i < capacity; ++i) {
+        rid_atomic_init(sequence_at(ring, i), i);
+    }
+
+    return RID_SUCCESS;
+}
+
+static int slot_free(const rid_ring_t *ring, size_t position) {
+    return rid_atomic_load(sequence_at(ring, position)) == position;
+}
+
+/*
+ * Number of free slots from head, up to count. The consumer frees slots
+ * in order, so when the last slot of a range is free all of them are
+ * and the first used slot can be found with a binary search.
+ */
+static size_t free_slots(const rid_ring_t *ring, size_t head, size_t count) {
+    size_t low = 0;
+    size_t high = count;
+
+    if (count == 0 || slot_free(ring, head + count - 1)) {
+        return count;
+    }
+
+    while (high - low > 1) {
+        size_t middle = low + (high - low) / 2;
+
+        if (slot_free(ring, head + middle - 1)) {
+            low = middle;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+/* Reserve up to count slots, head receives the first one. */
+static size_t reserve(rid_ring_t *ring, size_t count, size_t *head) {
+    *head = rid_atomic_load(&ring->counters->head);
+
+    if (count > ring->capacity) {
+        count = ring->capacity;
+    }
+
+    for (;;) {
+        size_t n = free_slots(ring, *head, count);
+
+        if (ring->producer == RID_RING_SINGLE_PRODUCER) {
+            if (n > 0) {
+                rid_atomic_store(&ring->counters->head, *head + n);
+            }
+            return n;
+        }
+
+        if (n == 0) {
+            /* Full, unless another producer moved head while we looked. */
+            size_t current = rid_atomic_load(&ring->counters->head);
+            if (current == *head) {
+                return 0;
+            }
+            *head = current;
+            continue;
+        }
+
+        if (rid_atomic_compare_exchange(&ring->counters->head, head, *head + n)) {
+            return n;
+        }
+    }
+}
+
+int rid_ring_push(rid_ring_t *ring, const void *messages, size_t count) {
+    if (ring == NULL || messages == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    const uint8_t *source = (const uint8_t *)messages;
+    size_t stride = message_stride(ring->type);
+    size_t valid = valid_count(ring, source, count);
+    size_t head;
+
+    if (valid == 0 && count > 0) {
+        return RID_ERROR_INVALID_MESSAGE_COUNT;
+    }
+
+    if (valid > (size_t)INT32_MAX) {
+        valid = INT32_MAX;
+    }
+
+    size_t reserved = reserve(ring, valid, &head);
+
+    for (size_t i = 0; i < reserved; ++i) {
+        const uint8_t *message = source + i * stride;
+
+        copy_message(ring, data_at(ring, head + i), message);
+        rid_atomic_store(sequence_at(ring, head + i), head + i + 1);
+    }
+
+    return (int)reserved;
+}
+
+int rid_ring_pop(rid_ring_t *ring, void *messages, size_t count) {
+    if (ring == NULL || messages == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    uint8_t *destination = (uint8_t *)messages;
+    size_t stride = message_stride(ring->type);
+    size_t tail = rid_atomic_load(&ring->counters->tail);
+    size_t popped = 0;
+
+    if (count > (size_t)INT32_MAX) {
+        count = INT32_MAX;
+    }
+
+    while (popped < count) {
+        size_t position = tail + popped;
+        const uint8_t *data = data_at(ring, position);
+
+        if (rid_atomic_load(sequence_at(ring, position)) != position + 1) {
+            break;
+        }
+
+        copy_message(ring, destination + popped * stride, data);
+        rid_atomic_store(sequence_at(ring, position), position + ring->capacity);
+        popped++;
+    }
+
+    if (popped > 0) {
+        rid_atomic_store(&ring->counters->tail, tail + popped);
+    }
+
+    return (int)popped;
+}
+
+size_t rid_ring_count(const rid_ring_t *ring) {
+    if (ring == NULL) {
+        return 0;
+    }
+
+    /* Tail first, it never passes head. */
+    size_t tail = rid_atomic_load(&ring->counters->tail);
+    size_t head = rid_atomic_load(&ring->counters->head);
+
+    return head - tail;
+}
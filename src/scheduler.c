@@ -0,0 +1,462 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of librid: https://github.com/tuupola/librid
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "rid/auth.h"
+#include "rid/basic_id.h"
+#include "rid/message.h"
+#include "rid/message_pack.h"
+#include "rid/scheduler.h"
+#include "rid/transport.h"
+
+#include "align.h"
+
+/* Position value of a stream which is not in the heap. Heap indexes are stored +1. */
+#define RID_SCHEDULER_NOT_SCHEDULED 0
+
+/* Stream of an aircraft on transports using Message Packs. */
+#define RID_SCHEDULER_PACK_STREAM 0
+
+static uint8_t streams_per_aircraft(rid_transport_t transport) {
+    return transport == RID_TRANSPORT_BLUETOOTH_LEGACY ? RID_SCHEDULER_MESSAGE_SLOTS : 1;
+}
+
+/* Message type sent from a slot, the second Basic ID is sent as a Basic ID. */
+static uint8_t slot_type(uint8_t slot) {
+    return slot == RID_SCHEDULER_SECOND_BASIC_ID ? RID_MESSAGE_TYPE_BASIC_ID : slot;
+}
+
+static size_t aircraft_size(size_t capacity) {
+    return rid_align_up(capacity * sizeof(rid_scheduled_aircraft_t), sizeof(uint64_t));
+}
+
+static size_t heap_size(rid_transport_t transport, size_t capacity) {
+    return capacity * streams_per_aircraft(transport) * sizeof(rid_scheduler_entry_t);
+}
+
+static const void *auth_page(const rid_auth_t *auth, uint8_t page) {
+    return page == 0 ? (const void *)&auth->page_0 : (const void *)&auth->page_x[page - 1];
+}
+
+/* Ties are broken by stream so the order of frames is deterministic. */
+static int earlier(const rid_scheduler_entry_t *a, const rid_scheduler_entry_t *b) {
+    return a->due < b->due || (a->due == b->due && a->stream < b->stream);
+}
+
+static void place(rid_scheduler_t *scheduler, uint32_t index, rid_scheduler_entry_t entry) {
+    scheduler->heap[index] = entry;
+    scheduler->position[entry.stream] = index + 1;
+}
+
+static void sift_up(rid_scheduler_t *scheduler, uint32_t index) {
+    rid_scheduler_entry_t entry = scheduler->heap[index];
+
+    while (index > 0) {
+        uint32_t parent = (index - 1) / 2;
+
+        if (!earlier(&entry, &scheduler->heap[parent])) {
+            break;
+        }
+        place(scheduler, index, scheduler->heap[parent]);
+        index = parent;
+    }
+    place(scheduler, index, entry);
+}
+
+static void sift_down(rid_scheduler_t *scheduler, uint32_t index) {
+    rid_scheduler_entry_t entry = scheduler->heap[index];
+    uint32_t count = (uint32_t)scheduler->count;
+
+    for (;;) {
+        uint32_t child = index * 2 + 1;
+
+        if (child >= count) {
+            break;
+        }
+        if (child + 1 < count && earlier(&scheduler->heap[child + 1], &scheduler->heap[child])) {
+            child++;
+        }
+        if (!earlier(&scheduler->heap[child], &entry)) {
+            break;
+        }
+        place(scheduler, index, scheduler->heap[child]);
+        index = child;
+    }
+    place(scheduler, index, entry);
+}
+
+/* Add the stream unless it is already scheduled, the existing due time is kept. */
+static void schedule(rid_scheduler_t *scheduler, uint32_t stream, uint64_t due) {
+    if (scheduler->position[stream] != RID_SCHEDULER_NOT_SCHEDULED) {
+        return;
+    }
+
+    uint32_t index = (uint32_t)scheduler->count++;
+
+    scheduler->heap[index].due = due;
+    scheduler->heap[index].stream = stream;
+    sift_up(scheduler, index);
+}
+
+static void unschedule(rid_scheduler_t *scheduler, uint32_t stream) {
+    uint32_t position = scheduler->position[stream];
+
+    if (position == RID_SCHEDULER_NOT_SCHEDULED) {
+        return;
+    }
+
+    uint32_t index = position - 1;
+    uint32_t last = (uint32_t)--scheduler->count;
+
+    scheduler->position[stream] = RID_SCHEDULER_NOT_SCHEDULED;
+
+    /* Fill the hole with the last entry, it may need to move either way. */
+    if (index != last) {
+        rid_scheduler_entry_t moved = scheduler->heap[last];
+
+        place(scheduler, index, moved);
+        sift_up(scheduler, index);
+        sift_down(scheduler, scheduler->position[moved.stream] - 1);
+    }
+}
+
+static uint32_t stream_of(const rid_scheduler_t *scheduler, uint32_t aircraft, uint8_t slot) {
+    uint32_t stream = aircraft * scheduler->streams;
+
+    if (scheduler->streams > 1) {
+        stream += slot;
+    }
+    return stream;
+}
+
+static uint32_t stream_interval(const rid_scheduler_t *scheduler, const rid_scheduled_aircraft_t *aircraft, uint8_t type) {
+    if (scheduler->streams == 1) {
+        return scheduler->interval[RID_MESSAGE_TYPE_LOCATION];
+    }
+
+    if (type == RID_MESSAGE_TYPE_AUTH) {
+        /* All pages are sent within the Auth interval. */
+        uint32_t interval = scheduler->interval[type] / rid_auth_get_page_count(&aircraft->auth);
+        return interval > 0 ? interval : 1;
+    }
+
+    return scheduler->interval[type];
+}
+
+/* Slot with a Basic ID of the same ID type or a free one, RID_SCHEDULER_MESSAGE_SLOTS if neither. */
+static uint8_t basic_id_slot(const rid_scheduled_aircraft_t *aircraft, const void *message) {
+    static const uint8_t slots[] = {RID_MESSAGE_TYPE_BASIC_ID, RID_SCHEDULER_SECOND_BASIC_ID};
+    uint8_t id_type = ((const rid_basic_id_t *)message)->id_type;
+
+    for (size_t i = 0; i < sizeof(slots); ++i) {
+        if ((aircraft->present & (1 << slots[i])) && ((const rid_basic_id_t *)&aircraft->message[slots[i]])->id_type == id_type) {
+            return slots[i];
+        }
+    }
+
+    for (size_t i = 0; i < sizeof(slots); ++i) {
+        if (!(aircraft->present & (1 << slots[i]))) {
+            return slots[i];
+        }
+    }
+
+    return RID_SCHEDULER_MESSAGE_SLOTS;
+}
+
+/* All messages and as many Auth pages as fit, the rest follow in the next packs. */
+static void build_pack(rid_scheduled_aircraft_t *aircraft, rid_message_pack_t *pack) {
+    static const uint8_t slots[] = {
+        RID_MESSAGE_TYPE_BASIC_ID,
+        RID_SCHEDULER_SECOND_BASIC_ID,
+        RID_MESSAGE_TYPE_LOCATION,
+        RID_MESSAGE_TYPE_SELF_ID,
+        RID_MESSAGE_TYPE_SYSTEM,
+        RID_MESSAGE_TYPE_OPERATOR_ID,
+    };
+
+    rid_message_pack_init(pack);
+
+    for (size_t i = 0; i < sizeof(slots); ++i) {
+        if (aircraft->present & (1 << slots[i])) {
+            rid_message_pack_add_message(pack, &aircraft->message[slots[i]]);
+        }
+    }
+
+    if (!(aircraft->present & (1 << RID_MESSAGE_TYPE_AUTH))) {
+        return;
+    }
+
+    uint8_t pages = rid_auth_get_page_count(&aircraft->auth);
+    uint8_t room = RID_MESSAGE_PACK_MAX_MESSAGES - pack->message_count;
+
+    if (pages <= room) {
+        aircraft->auth_page = 0;
+        room = pages;
+    }
+
+    for (uint8_t i = 0; i < room; ++i) {
+        /* Added directly, rid_message_pack_add_message() refuses Auth pages. */
+        memcpy(&pack->messages[pack->message_count * RID_MESSAGE_SIZE], auth_page(&aircraft->auth, aircraft->auth_page), RID_MESSAGE_SIZE);
+        pack->message_count++;
+        aircraft->auth_page = (uint8_t)((aircraft->auth_page + 1) % pages);
+    }
+}
+
+static void build_frame(rid_scheduler_t *scheduler, uint32_t stream, rid_scheduler_frame_t *frame) {
+    uint32_t index = stream / scheduler->streams;
+    uint8_t slot = (uint8_t)(stream % scheduler->streams);
+    uint8_t type = slot_type(slot);
+    rid_scheduled_aircraft_t *aircraft = &scheduler->aircraft[index];
+
+    frame->aircraft = index;
+    frame->counter = aircraft->counter[type]++;
+
+    if (scheduler->streams == 1) {
+        rid_message_pack_t *pack = (rid_message_pack_t *)frame->data;
+
+        build_pack(aircraft, pack);
+        frame->type = RID_MESSAGE_TYPE_MESSAGE_PACK;
+        frame->size = rid_message_pack_size(pack);
+        return;
+    }
+
+    frame->type = (rid_message_type_t)type;
+    frame->size = RID_MESSAGE_SIZE;
+
+    if (type == RID_MESSAGE_TYPE_AUTH) {
+        memcpy(frame->data, auth_page(&aircraft->auth, aircraft->auth_page), RID_MESSAGE_SIZE);
+        aircraft->auth_page = (uint8_t)((aircraft->auth_page + 1) % rid_auth_get_page_count(&aircraft->auth));
+    } else {
+        memcpy(frame->data, &aircraft->message[slot], RID_MESSAGE_SIZE);
+    }
+}
+
+size_t rid_scheduler_storage_size(rid_transport_t transport, size_t capacity) {
+    if ((unsigned)transport > RID_TRANSPORT_MAX || capacity == 0 || capacity > RID_SCHEDULER_MAX_CAPACITY) {
+        return 0;
+    }
+
+    size_t streams = capacity * streams_per_aircraft(transport);
+
+    return rid_align_storage_size(
+        aircraft_size(capacity) + heap_size(transport, capacity) + streams * sizeof(uint32_t), sizeof(uint64_t)
+    );
+}
+
+int rid_scheduler_init(
+    rid_scheduler_t *scheduler, void *storage, size_t storage_size, rid_transport_t transport, size_t capacity
+) {
+    if (scheduler == NULL || storage == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    size_t size = rid_scheduler_storage_size(transport, capacity);
+
+    if (size == 0) {
+        return RID_ERROR_OUT_OF_RANGE;
+    }
+
+    if (storage_size < size) {
+        return RID_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    uint8_t *p = rid_align_storage(storage, sizeof(uint64_t));
+
+    scheduler->capacity = capacity;
+    scheduler->transport = transport;
+    scheduler->streams = streams_per_aircraft(transport);
+    scheduler->aircraft = (rid_scheduled_aircraft_t *)p;
+    scheduler->heap = (rid_scheduler_entry_t *)(p + aircraft_size(capacity));
+    scheduler->position = (uint32_t *)(p + aircraft_size(capacity) + heap_size(transport, capacity));
+
+    for (uint8_t type = 0; type < RID_SCHEDULER_MESSAGE_TYPES; ++type) {
+        scheduler->interval[type] = RID_SCHEDULER_STATIC_INTERVAL;
+    }
+    scheduler->interval[RID_MESSAGE_TYPE_LOCATION] = RID_SCHEDULER_DYNAMIC_INTERVAL;
+
+    return rid_scheduler_clear(scheduler);
+}
+
+int rid_scheduler_clear(rid_scheduler_t *scheduler) {
+    if (scheduler == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    scheduler->count = 0;
+    memset(scheduler->aircraft, 0, scheduler->capacity * sizeof(rid_scheduled_aircraft_t));
+    memset(scheduler->position, 0, scheduler->capacity * scheduler->streams * sizeof(uint32_t));
+
+    return RID_SUCCESS;
+}
+
+int rid_scheduler_set_interval(rid_scheduler_t *scheduler, rid_message_type_t type, uint32_t interval) {
+    if (scheduler == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    if ((unsigned)type >= RID_SCHEDULER_MESSAGE_TYPES || interval == 0) {
+        return RID_ERROR_OUT_OF_RANGE;
+    }
+
+    scheduler->interval[type] = interval;
+
+    return RID_SUCCESS;
+}
+
+int rid_scheduler_set_message(rid_scheduler_t *scheduler, uint32_t aircraft, const void *message, uint64_t now) {
+    if (scheduler == NULL || message == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    if (aircraft >= scheduler->capacity) {
+        return RID_ERROR_OUT_OF_RANGE;
+    }
+
+    rid_message_type_t type = rid_message_get_type(message);
+
+    if ((unsigned)type >= RID_SCHEDULER_MESSAGE_TYPES || type == RID_MESSAGE_TYPE_AUTH) {
+        return RID_ERROR_INVALID_MESSAGE_TYPE;
+    }
+
+    rid_scheduled_aircraft_t *record = &scheduler->aircraft[aircraft];
+    uint8_t slot = (uint8_t)type;
+
+    if (type == RID_MESSAGE_TYPE_BASIC_ID) {
+        slot = basic_id_slot(record, message);
+        if (slot == RID_SCHEDULER_MESSAGE_SLOTS) {
+            return RID_ERROR_BUFFER_TOO_SMALL;
+        }
+    }
+
+    memcpy(&record->message[slot], message, RID_MESSAGE_SIZE);
+    record->present |= (uint16_t)(1 << slot);
+    schedule(scheduler, stream_of(scheduler, aircraft, slot), now);
+
+    return RID_SUCCESS;
+}
+
+int rid_scheduler_set_auth(rid_scheduler_t *scheduler, uint32_t aircraft, const rid_auth_t *auth, uint64_t now) {
+    if (scheduler == NULL || auth == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    if (aircraft >= scheduler->capacity) {
+        return RID_ERROR_OUT_OF_RANGE;
+    }
+
+    int status = rid_auth_validate(auth);
+    if (status != RID_SUCCESS) {
+        return status;
+    }
+
+    rid_scheduled_aircraft_t *record = &scheduler->aircraft[aircraft];
+
+    memcpy(&record->auth, auth, sizeof(rid_auth_t));
+    record->auth_page = 0;
+    record->present |= (uint16_t)(1 << RID_MESSAGE_TYPE_AUTH);
+    schedule(scheduler, stream_of(scheduler, aircraft, RID_MESSAGE_TYPE_AUTH), now);
+
+    return RID_SUCCESS;
+}
+
+int rid_scheduler_remove(rid_scheduler_t *scheduler, uint32_t aircraft) {
+    if (scheduler == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    if (aircraft >= scheduler->capacity) {
+        return RID_ERROR_OUT_OF_RANGE;
+    }
+
+    if (scheduler->aircraft[aircraft].present == 0) {
+        return RID_ERROR_NOT_FOUND;
+    }
+
+    for (uint8_t i = 0; i < scheduler->streams; ++i) {
+        unschedule(scheduler, aircraft * scheduler->streams + i);
+    }
+    memset(&scheduler->aircraft[aircraft], 0, sizeof(rid_scheduled_aircraft_t));
+
+    return RID_SUCCESS;
+}
+
+int rid_scheduler_next(rid_scheduler_t *scheduler, uint64_t now, rid_scheduler_frame_t *frame) {
+    if (scheduler == NULL || frame == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    if (scheduler->count == 0 || scheduler->heap[0].due > now) {
+        return RID_ERROR_NOT_FOUND;
+    }
+
+    rid_scheduler_entry_t *top = &scheduler->heap[0];
+    uint32_t stream = top->stream;
+    uint8_t type = slot_type((uint8_t)(stream % scheduler->streams));
+
+    frame->due = top->due;
+    build_frame(scheduler, stream, frame);
+
+    uint64_t interval = stream_interval(scheduler, &scheduler->aircraft[frame->aircraft], type);
+
+    /* Keep the phase unless a whole interval was missed. */
+    top->due += interval;
+    if (top->due <= now) {
+        top->due = now + interval;
+    }
+    sift_down(scheduler, 0);
+
+    return RID_SUCCESS;
+}
+
+uint64_t rid_scheduler_next_due(const rid_scheduler_t *scheduler) {
+    if (scheduler == NULL || scheduler->count == 0) {
+        return UINT64_MAX;
+    }
+    return scheduler->heap[0].due;
+}
+
+size_t rid_scheduler_count(const rid_scheduler_t *scheduler) {
+    if (scheduler == NULL) {
+        return 0;
+    }
+    return scheduler->count;
+}
+
+const rid_scheduled_aircraft_t *rid_scheduler_get_aircraft(const rid_scheduler_t *scheduler, uint32_t aircraft) {
+    if (scheduler == NULL || aircraft >= scheduler->capacity) {
+        return NULL;
+    }
+    return &scheduler->aircraft[aircraft];
+}
@@ -145,37 +145,83 @@ const char *rid_description_type_to_string(rid_description_type_t type) {
     }
 }
 
+void rid_self_id_json_write(rid_json_t *json, const rid_self_id_t *message) {
+    char description[RID_DESCRIPTION_SIZE + 1];
+
+    rid_self_id_get_description(message, description, sizeof(description));
+
+    rid_json_object_start(json);
+    rid_json_key(json, "protocol_version");
+    rid_json_uint(json, rid_message_get_protocol_version(message));
+    rid_json_key(json, "message_type");
+    rid_json_uint(json, rid_message_get_type(message));
+    rid_json_key(json, "description_type");
+    rid_json_uint(json, rid_self_id_get_description_type(message));
+    rid_json_key(json, "description");
+    rid_json_string(json, description);
+    rid_json_object_end(json);
+}
+
 int rid_self_id_to_json(const rid_self_id_t *message, char *buffer, size_t buffer_size, size_t *needed_size) {
     rid_json_t json;
-    char description[RID_DESCRIPTION_SIZE + 1];
 
     if (message == NULL || (buffer == NULL && needed_size == NULL)) {
         return RID_ERROR_NULL_POINTER;
     }
 
-    rid_self_id_get_description(message, description, sizeof(description));
-
     rid_json_start(&json, buffer, buffer_size);
-    rid_json_key(&json, "protocol_version");
-    rid_json_uint(&json, rid_message_get_protocol_version(message));
-    rid_json_key(&json, "message_type");
-    rid_json_uint(&json, rid_message_get_type(message));
-    rid_json_key(&json, "description_type");
-    rid_json_uint(&json, rid_self_id_get_description_type(message));
-    rid_json_key(&json, "description");
-    rid_json_string(&json, description);
-    rid_json_end(&json);
+    rid_self_id_json_write(&json, message);
+
+    return rid_json_end(&json, needed_size);
+}
+
+int rid_self_id_to_json_sink(const rid_self_id_t *message, const rid_json_sink_t *sink) {
+    rid_json_t json;
+
+    if (message == NULL || sink == NULL || sink->write == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
 
-    if (needed_size != NULL) {
-        *needed_size = json.position + 1;
+    rid_json_start_sink(&json, sink);
+    rid_self_id_json_write(&json, message);
+
+    return rid_json_end(&json, NULL);
+}
+
+int rid_self_id_to_cbor(const rid_self_id_t *message, uint8_t *buffer, size_t buffer_size, size_t *needed_size) {
+    rid_json_t json;
+
+    if (message == NULL || (buffer == NULL && needed_size == NULL)) {
+        return RID_ERROR_NULL_POINTER;
     }
 
-    if (buffer == NULL) {
-        return RID_SUCCESS;
+    rid_cbor_start(&json, buffer, buffer_size);
+    rid_self_id_json_write(&json, message);
+
+    return rid_json_end(&json, needed_size);
+}
+
+int rid_self_id_json_read(rid_json_object_t *object, rid_self_id_t *message) {
+    char description[RID_DESCRIPTION_SIZE + 1];
+    uint32_t value;
+    int status;
+
+    rid_self_id_init(message);
+
+    status = rid_json_get_uint(object, "description_type", UINT8_MAX, &value);
+    if (status == RID_SUCCESS) {
+        status = rid_self_id_set_description_type(message, (rid_description_type_t)value);
+    }
+    if (status < RID_SUCCESS) {
+        return status;
     }
 
-    if (json.position + 1 > buffer_size) {
-        return RID_ERROR_BUFFER_TOO_SMALL;
+    status = rid_json_get_string(object, "description", description, sizeof(description));
+    if (status == RID_SUCCESS) {
+        status = rid_self_id_set_description(message, description);
+    }
+    if (status < RID_SUCCESS) {
+        return status;
     }
 
     return RID_SUCCESS;
@@ -32,7 +32,6 @@ SPDX-License-Identifier: MIT
 
 #include <stddef.h>
 #include <stdint.h>
-#include <stdio.h>
 #include <string.h>
 
 #include "rid/message.h"
@@ -491,98 +490,227 @@ const char *rid_ua_classification_class_to_string(rid_ua_classification_class_t
     }
 }
 
-int rid_system_to_json(const rid_system_t *system, char *buffer, size_t buffer_size, size_t *needed_size) {
-    rid_json_t json;
-    char token[32];
-    int token_length;
+/* Encoded in 0.5 m steps with -1000 m offset, exact in hundredths. */
+static int32_t altitude_hundredths(uint16_t encoded) {
+    return (int32_t)encoded * 50 - 100000;
+}
+
+void rid_system_json_write(rid_json_t *json, const rid_system_t *system) {
     double latitude, longitude;
     float altitude, area_ceiling, area_floor;
 
-    if (system == NULL || (buffer == NULL && needed_size == NULL)) {
-        return RID_ERROR_NULL_POINTER;
-    }
+    rid_json_object_start(json);
 
-    rid_json_start(&json, buffer, buffer_size);
+    rid_json_key(json, "protocol_version");
+    rid_json_uint(json, rid_message_get_protocol_version(system));
+    rid_json_key(json, "message_type");
+    rid_json_uint(json, rid_message_get_type(system));
+
+    rid_json_key(json, "operator_location_type");
+    rid_json_uint(json, rid_system_get_operator_location_type(system));
+    rid_json_key(json, "classification_type");
+    rid_json_uint(json, rid_system_get_classification_type(system));
+    rid_json_key(json, "ua_classification_category");
+    rid_json_uint(json, rid_system_get_ua_classification_category(system));
+    rid_json_key(json, "ua_classification_class");
+    rid_json_uint(json, rid_system_get_ua_classification_class(system));
 
-    rid_json_key(&json, "protocol_version");
-    rid_json_uint(&json, rid_message_get_protocol_version(system));
-    rid_json_key(&json, "message_type");
-    rid_json_uint(&json, rid_message_get_type(system));
-
-    rid_json_key(&json, "operator_location_type");
-    rid_json_uint(&json, rid_system_get_operator_location_type(system));
-    rid_json_key(&json, "classification_type");
-    rid_json_uint(&json, rid_system_get_classification_type(system));
-    rid_json_key(&json, "ua_classification_category");
-    rid_json_uint(&json, rid_system_get_ua_classification_category(system));
-    rid_json_key(&json, "ua_classification_class");
-    rid_json_uint(&json, rid_system_get_ua_classification_class(system));
-
-    rid_json_key(&json, "operator_latitude");
+    rid_json_key(json, "operator_latitude");
     latitude = rid_system_get_operator_latitude(system);
     if (latitude == RID_OPERATOR_LATITUDE_INVALID) {
-        rid_json_null(&json);
+        rid_json_null(json);
     } else {
-        token_length = snprintf(token, sizeof(token), "%.7f", latitude);
-        rid_json_raw(&json, token, (size_t)token_length);
+        rid_json_fixed(json, system->operator_latitude, 7);
     }
 
-    rid_json_key(&json, "operator_longitude");
+    rid_json_key(json, "operator_longitude");
     longitude = rid_system_get_operator_longitude(system);
     if (longitude == RID_OPERATOR_LONGITUDE_INVALID) {
-        rid_json_null(&json);
+        rid_json_null(json);
     } else {
-        token_length = snprintf(token, sizeof(token), "%.7f", longitude);
-        rid_json_raw(&json, token, (size_t)token_length);
+        rid_json_fixed(json, system->operator_longitude, 7);
     }
 
-    rid_json_key(&json, "operator_altitude");
+    rid_json_key(json, "operator_altitude");
     altitude = rid_system_get_operator_altitude(system);
     if (altitude == RID_OPERATOR_ALTITUDE_INVALID) {
-        rid_json_null(&json);
+        rid_json_null(json);
     } else {
-        token_length = snprintf(token, sizeof(token), "%.2f", (double)altitude);
-        rid_json_raw(&json, token, (size_t)token_length);
+        rid_json_fixed(json, altitude_hundredths(system->operator_altitude), 2);
     }
 
-    rid_json_key(&json, "area_count");
-    rid_json_uint(&json, rid_system_get_area_count(system));
-    rid_json_key(&json, "area_radius");
-    rid_json_uint(&json, rid_system_get_area_radius(system));
+    rid_json_key(json, "area_count");
+    rid_json_uint(json, rid_system_get_area_count(system));
+    rid_json_key(json, "area_radius");
+    rid_json_uint(json, rid_system_get_area_radius(system));
 
-    rid_json_key(&json, "area_ceiling");
+    rid_json_key(json, "area_ceiling");
     area_ceiling = rid_system_get_area_ceiling(system);
     if (area_ceiling == RID_AREA_CEILING_INVALID) {
-        rid_json_null(&json);
+        rid_json_null(json);
     } else {
-        token_length = snprintf(token, sizeof(token), "%.2f", (double)area_ceiling);
-        rid_json_raw(&json, token, (size_t)token_length);
+        rid_json_fixed(json, altitude_hundredths(system->area_ceiling), 2);
     }
 
-    rid_json_key(&json, "area_floor");
+    rid_json_key(json, "area_floor");
     area_floor = rid_system_get_area_floor(system);
     if (area_floor == RID_AREA_FLOOR_INVALID) {
-        rid_json_null(&json);
+        rid_json_null(json);
     } else {
-        token_length = snprintf(token, sizeof(token), "%.2f", (double)area_floor);
-        rid_json_raw(&json, token, (size_t)token_length);
+        rid_json_fixed(json, altitude_hundredths(system->area_floor), 2);
     }
 
-    rid_json_key(&json, "timestamp");
-    rid_json_uint(&json, rid_system_get_timestamp(system));
+    rid_json_key(json, "timestamp");
+    rid_json_uint(json, rid_system_get_timestamp(system));
+    rid_json_object_end(json);
+}
 
-    rid_json_end(&json);
+int rid_system_to_json(const rid_system_t *system, char *buffer, size_t buffer_size, size_t *needed_size) {
+    rid_json_t json;
 
-    if (needed_size != NULL) {
-        *needed_size = json.position + 1;
+    if (system == NULL || (buffer == NULL && needed_size == NULL)) {
+        return RID_ERROR_NULL_POINTER;
     }
 
-    if (buffer == NULL) {
-        return RID_SUCCESS;
+    rid_json_start(&json, buffer, buffer_size);
+    rid_system_json_write(&json, system);
+
+    return rid_json_end(&json, needed_size);
+}
+
+int rid_system_to_json_sink(const rid_system_t *system, const rid_json_sink_t *sink) {
+    rid_json_t json;
+
+    if (system == NULL || sink == NULL || sink->write == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    rid_json_start_sink(&json, sink);
+    rid_system_json_write(&json, system);
+
+    return rid_json_end(&json, NULL);
+}
+
+int rid_system_to_cbor(const rid_system_t *system, uint8_t *buffer, size_t buffer_size, size_t *needed_size) {
+    rid_json_t json;
+
+    if (system == NULL || (buffer == NULL && needed_size == NULL)) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    rid_cbor_start(&json, buffer, buffer_size);
+    rid_system_json_write(&json, system);
+
+    return rid_json_end(&json, needed_size);
+}
+
+/* Nullable altitude in hundredths, null leaves the invalid value from init. */
+static int system_read_altitude(
+    rid_json_object_t *object, const char *key, rid_system_t *system, int (*set)(rid_system_t *, float)
+) {
+    int32_t value;
+    int status;
+
+    status = rid_json_get_fixed(object, key, 2, &value);
+    if (status == RID_SUCCESS) {
+        status = set(system, (float)value / 100.0f);
+    }
+
+    return status;
+}
+
+int rid_system_json_read(rid_json_object_t *object, rid_system_t *system) {
+    int32_t degrees;
+    uint32_t value;
+    int status;
+
+    rid_system_init(system);
+
+    status = rid_json_get_uint(object, "operator_location_type", UINT8_MAX, &value);
+    if (status == RID_SUCCESS) {
+        status = rid_system_set_operator_location_type(system, (rid_operator_location_type_t)value);
+    }
+    if (status < RID_SUCCESS) {
+        return status;
+    }
+
+    status = rid_json_get_uint(object, "classification_type", UINT8_MAX, &value);
+    if (status == RID_SUCCESS) {
+        status = rid_system_set_classification_type(system, (rid_classification_type_t)value);
+    }
+    if (status < RID_SUCCESS) {
+        return status;
+    }
+
+    status = rid_json_get_uint(object, "ua_classification_category", UINT8_MAX, &value);
+    if (status == RID_SUCCESS) {
+        status = rid_system_set_ua_classification_category(system, (rid_ua_classification_category_t)value);
+    }
+    if (status < RID_SUCCESS) {
+        return status;
+    }
+
+    status = rid_json_get_uint(object, "ua_classification_class", UINT8_MAX, &value);
+    if (status == RID_SUCCESS) {
+        status = rid_system_set_ua_classification_class(system, (rid_ua_classification_class_t)value);
+    }
+    if (status < RID_SUCCESS) {
+        return status;
+    }
+
+    status = rid_json_get_fixed(object, "operator_latitude", 7, &degrees);
+    if (status == RID_SUCCESS) {
+        status = rid_system_set_operator_latitude(system, (double)degrees / 10000000.0);
+    }
+    if (status < RID_SUCCESS) {
+        return status;
+    }
+
+    status = rid_json_get_fixed(object, "operator_longitude", 7, &degrees);
+    if (status == RID_SUCCESS) {
+        status = rid_system_set_operator_longitude(system, (double)degrees / 10000000.0);
+    }
+    if (status < RID_SUCCESS) {
+        return status;
+    }
+
+    status = system_read_altitude(object, "operator_altitude", system, rid_system_set_operator_altitude);
+    if (status < RID_SUCCESS) {
+        return status;
+    }
+
+    status = rid_json_get_uint(object, "area_count", UINT16_MAX, &value);
+    if (status == RID_SUCCESS) {
+        status = rid_system_set_area_count(system, (uint16_t)value);
+    }
+    if (status < RID_SUCCESS) {
+        return status;
     }
 
-    if (json.position + 1 > buffer_size) {
-        return RID_ERROR_BUFFER_TOO_SMALL;
+    status = rid_json_get_uint(object, "area_radius", UINT16_MAX, &value);
+    if (status == RID_SUCCESS) {
+        status = rid_system_set_area_radius(system, (uint16_t)value);
+    }
+    if (status < RID_SUCCESS) {
+        return status;
+    }
+
+    status = system_read_altitude(object, "area_ceiling", system, rid_system_set_area_ceiling);
+    if (status < RID_SUCCESS) {
+        return status;
+    }
+
+    status = system_read_altitude(object, "area_floor", system, rid_system_set_area_floor);
+    if (status < RID_SUCCESS) {
+        return status;
+    }
+
+    status = rid_json_get_uint(object, "timestamp", UINT32_MAX, &value);
+    if (status == RID_SUCCESS) {
+        status = rid_system_set_timestamp(system, value);
+    }
+    if (status < RID_SUCCESS) {
+        return status;
     }
 
     return RID_SUCCESS;
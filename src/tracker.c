@@ -0,0 +1,306 @@
+/*
+
+MIT License
+
+Copyright (c) 2026 Mika Tuupola
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+-cut-
+
+This file is part of librid: https://github.com/tuupola/librid
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "rid/message.h"
+#include "rid/message_pack.h"
+#include "rid/tracker.h"
+#include "rid/transport.h"
+
+#include "align.h"
+
+/* Slot index value marking an empty slot. Aircraft indexes are stored +1. */
+#define RID_TRACKER_SLOT_EMPTY 0
+
+/* Keep the load factor at or below one half. */
+static uint32_t table_size(size_t capacity) {
+    uint32_t size = 2;
+
+    while (size < capacity * 2) {
+        size <<= 1;
+    }
+    return size;
+}
+
+static size_t aircraft_size(size_t capacity) {
+    return rid_align_up(capacity * sizeof(rid_aircraft_t), sizeof(uint64_t));
+}
+
+static uint32_t hash_address(const rid_address_t *address) {
+    uint64_t key = 0;
+
+    for (size_t i = 0; i < RID_ADDRESS_SIZE; ++i) {
+        key = (key << 8) | address->octets[i];
+    }
+
+    /* Fibonacci hashing, the high bits are well mixed. */
+    return (uint32_t)((key * 0x9E3779B97F4A7C15ULL) >> 32);
+}
+
+static int address_equal(const rid_address_t *a, const rid_address_t *b) {
+    return memcmp(a->octets, b->octets, RID_ADDRESS_SIZE) == 0;
+}
+
+/* Returns the slot holding the address or the empty slot ending the probe. */
+static uint32_t probe(const rid_tracker_t *tracker, const rid_address_t *address, uint32_t hash) {
+    uint32_t i = hash & tracker->mask;
+
+    while (tracker->slots[i].index != RID_TRACKER_SLOT_EMPTY) {
+        if (tracker->slots[i].hash == hash &&
+            address_equal(&tracker->aircraft[tracker->slots[i].index - 1].address, address)) {
+            return i;
+        }
+        i = (i + 1) & tracker->mask;
+    }
+    return i;
+}
+
+/* Backward shift deletion keeps probe sequences intact without tombstones. */
+static void delete_slot(rid_tracker_t *tracker, uint32_t i) {
+    uint32_t j = i;
+
+    for (;;) {
+        j = (j + 1) & tracker->mask;
+        if (tracker->slots[j].index == RID_TRACKER_SLOT_EMPTY) {
+            break;
+        }
+
+        uint32_t home = tracker->slots[j].hash & tracker->mask;
+        if (((j - home) & tracker->mask) >= ((j - i) & tracker->mask)) {
+            tracker->slots[i] = tracker->slots[j];
+            i = j;
+        }
+    }
+    tracker->slots[i].index = RID_TRACKER_SLOT_EMPTY;
+}
+
+/* Remove aircraft whose slot is known and fill the hole with the last one. */
+static void remove_at(rid_tracker_t *tracker, uint32_t slot) {
+    size_t index = tracker->slots[slot].index - 1;
+    size_t last = tracker->count - 1;
+
+    delete_slot(tracker, slot);
+
+    if (index != last) {
+        const rid_aircraft_t *moved = &tracker->aircraft[last];
+        uint32_t moved_slot = probe(tracker, &moved->address, hash_address(&moved->address));
+
+        tracker->aircraft[index] = *moved;
+        tracker->slots[moved_slot].index = (uint32_t)index + 1;
+    }
+    tracker->count = last;
+}
+
+size_t rid_tracker_storage_size(size_t capacity) {
+    if (capacity == 0 || capacity > RID_TRACKER_MAX_CAPACITY) {
+        return 0;
+    }
+    return rid_align_storage_size(aircraft_size(capacity) + table_size(capacity) * sizeof(rid_tracker_slot_t), sizeof(uint64_t));
+}
+
+int rid_tracker_init(rid_tracker_t *tracker, void *storage, size_t storage_size, size_t capacity) {
+    if (tracker == NULL || storage == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    if (capacity == 0 || capacity > RID_TRACKER_MAX_CAPACITY) {
+        return RID_ERROR_OUT_OF_RANGE;
+    }
+
+    if (storage_size < rid_tracker_storage_size(capacity)) {
+        return RID_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    uint8_t *p = rid_align_storage(storage, sizeof(uint64_t));
+
+    tracker->capacity = capacity;
+    tracker->mask = table_size(capacity) - 1;
+    tracker->aircraft = (rid_aircraft_t *)p;
+    tracker->slots = (rid_tracker_slot_t *)(p + aircraft_size(capacity));
+
+    return rid_tracker_clear(tracker);
+}
+
+int rid_tracker_clear(rid_tracker_t *tracker) {
+    if (tracker == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    tracker->count = 0;
+    memset(tracker->slots, 0, ((size_t)tracker->mask + 1) * sizeof(rid_tracker_slot_t));
+
+    return RID_SUCCESS;
+}
+
+static void store_message(rid_aircraft_t *aircraft, const void *message) {
+    uint8_t type = ((const rid_message_t *)message)->message_type;
+
+    if (type < RID_TRACKER_MESSAGE_TYPES) {
+        memcpy(&aircraft->message[type], message, RID_MESSAGE_SIZE);
+        aircraft->seen |= (uint16_t)(1 << type);
+        aircraft->message_count[type]++;
+    }
+}
+
+int rid_tracker_update(rid_tracker_t *tracker, const rid_address_t *address, const void *message, uint64_t now) {
+    if (tracker == NULL || address == NULL || message == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    rid_message_type_t type = rid_message_get_type(message);
+    const rid_message_pack_t *pack = NULL;
+
+    if (type == RID_MESSAGE_TYPE_MESSAGE_PACK) {
+        pack = (const rid_message_pack_t *)message;
+
+        int status = rid_message_pack_validate(pack);
+        if (status != RID_SUCCESS) {
+            return status;
+        }
+    } else if (type >= RID_TRACKER_MESSAGE_TYPES) {
+        return RID_ERROR_UNKNOWN_MESSAGE_TYPE;
+    }
+
+    uint32_t hash = hash_address(address);
+    uint32_t slot = probe(tracker, address, hash);
+    rid_aircraft_t *aircraft;
+
+    if (tracker->slots[slot].index == RID_TRACKER_SLOT_EMPTY) {
+        if (tracker->count == tracker->capacity) {
+            return RID_ERROR_BUFFER_TOO_SMALL;
+        }
+
+        aircraft = &tracker->aircraft[tracker->count];
+        memset(aircraft, 0, sizeof(rid_aircraft_t));
+        aircraft->address = *address;
+        aircraft->first_seen = now;
+
+        tracker->count++;
+        tracker->slots[slot].hash = hash;
+        tracker->slots[slot].index = (uint32_t)tracker->count;
+    } else {
+        aircraft = &tracker->aircraft[tracker->slots[slot].index - 1];
+    }
+
+    aircraft->last_seen = now;
+
+    if (pack != NULL) {
+        /* Unknown and nested types inside a pack are skipped. */
+        for (uint8_t i = 0; i < pack->message_count; ++i) {
+            store_message(aircraft, &pack->messages[i * RID_MESSAGE_SIZE]);
+        }
+    } else {
+        store_message(aircraft, message);
+    }
+
+    return RID_SUCCESS;
+}
+
+const rid_aircraft_t *rid_tracker_find(const rid_tracker_t *tracker, const rid_address_t *address) {
+    if (tracker == NULL || address == NULL) {
+        return NULL;
+    }
+
+    uint32_t slot = probe(tracker, address, hash_address(address));
+
+    if (tracker->slots[slot].index == RID_TRACKER_SLOT_EMPTY) {
+        return NULL;
+    }
+    return &tracker->aircraft[tracker->slots[slot].index - 1];
+}
+
+int rid_tracker_remove(rid_tracker_t *tracker, const rid_address_t *address) {
+    if (tracker == NULL || address == NULL) {
+        return RID_ERROR_NULL_POINTER;
+    }
+
+    uint32_t slot = probe(tracker, address, hash_address(address));
+
+    if (tracker->slots[slot].index == RID_TRACKER_SLOT_EMPTY) {
+        return RID_ERROR_NOT_FOUND;
+    }
+
+    remove_at(tracker, slot);
+
+    return RID_SUCCESS;
+}
+
+size_t rid_tracker_expire(rid_tracker_t *tracker, uint64_t older_than) {
+    if (tracker == NULL) {
+        return 0;
+    }
+
+    size_t removed = 0;
+    size_t i = 0;
+
+    /* A removal moves the last aircraft to i so do not advance then. */
+    while (i < tracker->count) {
+        const rid_aircraft_t *aircraft = &tracker->aircraft[i];
+
+        if (aircraft->last_seen < older_than) {
+            remove_at(tracker, probe(tracker, &aircraft->address, hash_address(&aircraft->address)));
+            removed++;
+        } else {
+            i++;
+        }
+    }
+
+    return removed;
+}
+
+size_t rid_tracker_count(const rid_tracker_t *tracker) {
+    if (tracker == NULL) {
+        return 0;
+    }
+    return tracker->count;
+}
+
+const rid_aircraft_t *rid_tracker_get_at(const rid_tracker_t *tracker, size_t index) {
+    if (tracker == NULL || index >= tracker->count) {
+        return NULL;
+    }
+    return &tracker->aircraft[index];
+}
+
+const void *rid_aircraft_get_message(const rid_aircraft_t *aircraft, rid_message_type_t type) {
+    if (aircraft == NULL || (unsigned)type >= RID_TRACKER_MESSAGE_TYPES) {
+        return NULL;
+    }
+
+    if ((aircraft->seen & (1 << type)) == 0) {
+        return NULL;
+    }
+    return &aircraft->message[type];
+}
@@ -30,6 +30,8 @@ SPDX-License-Identifier: MIT
 
 */
 
+#include <stddef.h>
+
 #include "rid/transport.h"
 
 const char *rid_transport_to_string(rid_transport_t transport) {
@@ -46,3 +48,18 @@ const char *rid_transport_to_string(rid_transport_t transport) {
             return "UNKNOWN";
     }
 }
+
+size_t rid_transport_get_max_payload(rid_transport_t transport) {
+    switch (transport) {
+        case RID_TRANSPORT_BLUETOOTH_LEGACY:
+            return RID_TRANSPORT_BLUETOOTH_LEGACY_MAX_PAYLOAD;
+        case RID_TRANSPORT_BLUETOOTH_LONG_RANGE:
+            return RID_TRANSPORT_BLUETOOTH_LONG_RANGE_MAX_PAYLOAD;
+        case RID_TRANSPORT_WIFI_NAN:
+            return RID_TRANSPORT_WIFI_NAN_MAX_PAYLOAD;
+        case RID_TRANSPORT_WIFI_BEACON:
+            return RID_TRANSPORT_WIFI_BEACON_MAX_PAYLOAD;
+        default:
+            return 0;
+    }
+}
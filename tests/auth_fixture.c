@@ -0,0 +1,65 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "auth_fixture.h"
+#include "rid/auth.h"
+#include "rid/basic_id.h"
+#include "rid/location.h"
+#include "rid/message_pack.h"
+
+void auth_fixture_signature(const uint8_t *input, size_t input_length, uint8_t *signature) {
+    memset(signature, 0, AUTH_FIXTURE_SIGNATURE_SIZE);
+    for (size_t i = 0; i < input_length; ++i) {
+        signature[i % AUTH_FIXTURE_SIGNATURE_SIZE] = (uint8_t)(signature[i % AUTH_FIXTURE_SIGNATURE_SIZE] + input[i]);
+    }
+}
+
+int auth_fixture_sign(
+    void *context, const uint8_t *input, size_t input_length,
+    uint8_t *signature, size_t signature_size, size_t *signature_length
+) {
+    (void)signature_size;
+
+    if (context != NULL) {
+        (*(int *)context)++;
+    }
+    auth_fixture_signature(input, input_length, signature);
+    *signature_length = AUTH_FIXTURE_SIGNATURE_SIZE;
+    return 0;
+}
+
+int auth_fixture_verify(
+    void *context, const uint8_t *input, size_t input_length,
+    const uint8_t *signature, size_t signature_length
+) {
+    uint8_t expected[AUTH_FIXTURE_SIGNATURE_SIZE];
+
+    if (context != NULL) {
+        (*(int *)context)++;
+    }
+    auth_fixture_signature(input, input_length, expected);
+    return signature_length == AUTH_FIXTURE_SIGNATURE_SIZE &&
+        memcmp(expected, signature, AUTH_FIXTURE_SIGNATURE_SIZE) == 0 ? 0 : RID_ERROR_INVALID_SIGNATURE;
+}
+
+void auth_fixture_make_pack(rid_message_pack_t *pack, rid_auth_t *auth, uint8_t seed) {
+    rid_basic_id_t basic_id;
+    rid_location_t location;
+
+    rid_basic_id_init(&basic_id);
+    rid_basic_id_set_uas_id(&basic_id, "1ABCD2345EF678XYZ");
+    rid_location_init(&location);
+    rid_location_set_latitude(&location, 60.0 + seed);
+
+    rid_message_pack_init(pack);
+    rid_message_pack_add_message(pack, &basic_id);
+    rid_message_pack_add_message(pack, &location);
+
+    rid_auth_init(auth);
+    rid_auth_set_timestamp(auth, 1000 + seed);
+}
+
+void auth_fixture_make_signed_pack(rid_message_pack_t *pack, rid_auth_t *auth, uint8_t seed) {
+    auth_fixture_make_pack(pack, auth, seed);
+    rid_auth_sign(auth, pack, auth_fixture_sign, NULL);
+}
@@ -0,0 +1,31 @@
+#ifndef _TESTS_AUTH_FIXTURE_H
+#define _TESTS_AUTH_FIXTURE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rid/auth.h"
+#include "rid/message_pack.h"
+
+#define AUTH_FIXTURE_SIGNATURE_SIZE 32
+
+/* Toy signature, byte i is the sum of payload bytes at positions i mod 32. */
+void auth_fixture_signature(const uint8_t *input, size_t input_length, uint8_t *signature);
+
+/* Sign and verify callbacks. A non-NULL context is an int counting the calls. */
+int auth_fixture_sign(
+    void *context, const uint8_t *input, size_t input_length,
+    uint8_t *signature, size_t signature_size, size_t *signature_length
+);
+int auth_fixture_verify(
+    void *context, const uint8_t *input, size_t input_length,
+    const uint8_t *signature, size_t signature_length
+);
+
+/* Basic ID and Location pack, the seed changes the latitude and the timestamp. */
+void auth_fixture_make_pack(rid_message_pack_t *pack, rid_auth_t *auth, uint8_t seed);
+
+/* Same as above with the auth signed using auth_fixture_sign(). */
+void auth_fixture_make_signed_pack(rid_message_pack_t *pack, rid_auth_t *auth, uint8_t seed);
+
+#endif
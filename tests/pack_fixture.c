@@ -0,0 +1,22 @@
+#include <stdint.h>
+
+#include "pack_fixture.h"
+#include "rid/basic_id.h"
+#include "rid/location.h"
+#include "rid/message_pack.h"
+
+void pack_fixture_make(rid_message_pack_t *pack, uint8_t count) {
+    rid_basic_id_t basic_id;
+    rid_location_t location;
+
+    rid_basic_id_init(&basic_id);
+    rid_basic_id_set_uas_id(&basic_id, "1596F3A4C8D2E7B9");
+    rid_location_init(&location);
+    rid_location_set_latitude(&location, 60.1699);
+
+    rid_message_pack_init(pack);
+    rid_message_pack_add_message(pack, &basic_id);
+    for (uint8_t i = 1; i < count; ++i) {
+        rid_message_pack_add_message(pack, &location);
+    }
+}
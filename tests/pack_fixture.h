@@ -0,0 +1,11 @@
+#ifndef _TESTS_PACK_FIXTURE_H
+#define _TESTS_PACK_FIXTURE_H
+
+#include <stdint.h>
+
+#include "rid/message_pack.h"
+
+/* Basic ID followed by count - 1 identical Location messages, count is at least one. */
+void pack_fixture_make(rid_message_pack_t *pack, uint8_t count);
+
+#endif
@@ -1,11 +1,14 @@
 #include <stdint.h>
 #include <string.h>
 
+#include "auth_fixture.h"
 #include "greatest.h"
 #include "rid/auth.h"
 #include "rid/auth_page.h"
 #include "rid/basic_id.h"
+#include "rid/location.h"
 #include "rid/message.h"
+#include "rid/message_pack.h"
 
 TEST test_auth_init(void) {
     rid_auth_t auth;
@@ -665,6 +668,223 @@ TEST test_message_to_json_needed(void) {
     PASS();
 }
 
+static int toy_verify_batch(void *context, rid_auth_verify_item_t *items, size_t count) {
+    int *calls = (int *)context;
+
+    (*calls)++;
+    for (size_t i = 0; i < count; ++i) {
+        /* Payloads are stored back to back. */
+        if (i > 0 && items[i].input != items[i - 1].input + items[i - 1].input_length) {
+            return -100;
+        }
+        items[i].result = auth_fixture_verify(NULL, items[i].input, items[i].input_length, items[i].signature, items[i].signature_length);
+    }
+    return 0;
+}
+
+static int failing_verify_batch(void *context, rid_auth_verify_item_t *items, size_t count) {
+    (void)context;
+    (void)items;
+    (void)count;
+    return -100;
+}
+
+TEST test_auth_verify(void) {
+    rid_message_pack_t pack;
+    rid_auth_t auth;
+
+    auth_fixture_make_signed_pack(&pack, &auth, 1);
+    ASSERT_EQ(RID_AUTH_TYPE_MESSAGE_SET_SIGNATURE, rid_auth_get_type(&auth));
+    ASSERT_EQ(32, rid_auth_get_length(&auth));
+    ASSERT_EQ(RID_SUCCESS, rid_auth_verify(&auth, &pack, auth_fixture_verify, NULL));
+
+    rid_auth_set_timestamp(&auth, 1);
+    ASSERT_EQ(RID_ERROR_INVALID_SIGNATURE, rid_auth_verify(&auth, &pack, auth_fixture_verify, NULL));
+
+    PASS();
+}
+
+TEST test_auth_verify_batch(void) {
+    rid_message_pack_t packs[4];
+    rid_auth_t auths[4];
+    const rid_auth_t *auth_pointers[4];
+    const void *pack_pointers[4];
+    int results[4];
+    int calls = 0;
+    static uint64_t scratch[512];
+
+    for (uint8_t i = 0; i < 4; ++i) {
+        auth_fixture_make_signed_pack(&packs[i], &auths[i], i);
+        auth_pointers[i] = &auths[i];
+        pack_pointers[i] = &packs[i];
+    }
+
+    /* Item 1 has a bad signature, item 2 is not signed at all. */
+    rid_auth_set_timestamp(&auths[1], 1);
+    rid_auth_set_type(&auths[2], RID_AUTH_TYPE_NETWORK_REMOTE_ID);
+
+    size_t size = rid_auth_verify_batch_scratch_size(4);
+    ASSERT(size <= sizeof(scratch));
+
+    ASSERT_EQ(RID_SUCCESS, rid_auth_verify_batch(
+        auth_pointers, pack_pointers, 4, scratch, size, toy_verify_batch, NULL, &calls, results
+    ));
+    ASSERT_EQ(1, calls);
+    ASSERT_EQ(RID_SUCCESS, results[0]);
+    ASSERT_EQ(RID_ERROR_INVALID_SIGNATURE, results[1]);
+    ASSERT_EQ(RID_ERROR_NOT_IMPLEMENTED, results[2]);
+    ASSERT_EQ(RID_SUCCESS, results[3]);
+
+    /* Without a batch callback the single callback is used. */
+    calls = 0;
+    ASSERT_EQ(RID_SUCCESS, rid_auth_verify_batch(
+        auth_pointers, pack_pointers, 4, scratch, size, NULL, auth_fixture_verify, &calls, results
+    ));
+    ASSERT_EQ(3, calls);
+    ASSERT_EQ(RID_SUCCESS, results[0]);
+    ASSERT_EQ(RID_ERROR_INVALID_SIGNATURE, results[1]);
+    ASSERT_EQ(RID_ERROR_NOT_IMPLEMENTED, results[2]);
+    ASSERT_EQ(RID_SUCCESS, results[3]);
+
+    /* Failed batch fails every verified item. */
+    ASSERT_EQ(RID_SUCCESS, rid_auth_verify_batch(
+        auth_pointers, pack_pointers, 4, scratch, size, failing_verify_batch, NULL, NULL, results
+    ));
+    ASSERT_EQ(-100, results[0]);
+    ASSERT_EQ(-100, results[1]);
+    ASSERT_EQ(RID_ERROR_NOT_IMPLEMENTED, results[2]);
+    ASSERT_EQ(-100, results[3]);
+
+    PASS();
+}
+
+TEST test_auth_verify_batch_errors(void) {
+    rid_message_pack_t pack;
+    rid_auth_t auth;
+    const rid_auth_t *auths[2] = {&auth, NULL};
+    const void *packs[2] = {&pack, &pack};
+    int results[2];
+    static uint64_t scratch[256];
+    size_t size = rid_auth_verify_batch_scratch_size(2);
+
+    auth_fixture_make_signed_pack(&pack, &auth, 1);
+
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_auth_verify_batch(NULL, packs, 2, scratch, size, NULL, auth_fixture_verify, NULL, results));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_auth_verify_batch(auths, NULL, 2, scratch, size, NULL, auth_fixture_verify, NULL, results));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_auth_verify_batch(auths, packs, 2, NULL, size, NULL, auth_fixture_verify, NULL, results));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_auth_verify_batch(auths, packs, 2, scratch, size, NULL, NULL, NULL, results));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_auth_verify_batch(auths, packs, 2, scratch, size, NULL, auth_fixture_verify, NULL, NULL));
+    ASSERT_EQ(RID_ERROR_BUFFER_TOO_SMALL, rid_auth_verify_batch(auths, packs, 2, scratch, size - 1, NULL, auth_fixture_verify, NULL, results));
+    ASSERT_EQ(0, rid_auth_verify_batch_scratch_size(SIZE_MAX));
+
+    ASSERT_EQ(RID_SUCCESS, rid_auth_verify_batch(auths, packs, 2, scratch, size, NULL, auth_fixture_verify, NULL, results));
+    ASSERT_EQ(RID_SUCCESS, results[0]);
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, results[1]);
+
+    PASS();
+}
+
+/* FNV-1a as a stand in for a streaming hash. */
+typedef struct {
+    uint64_t state;
+    int updates;
+    int fail;
+} toy_hash_t;
+
+static int toy_hash_init(void *context) {
+    toy_hash_t *hash = (toy_hash_t *)context;
+
+    hash->state = 0xcbf29ce484222325ULL;
+    hash->updates = 0;
+    return 0;
+}
+
+static int toy_hash_update(void *context, const uint8_t *data, size_t size) {
+    toy_hash_t *hash = (toy_hash_t *)context;
+
+    for (size_t i = 0; i < size; ++i) {
+        hash->state = (hash->state ^ data[i]) * 0x100000001b3ULL;
+    }
+    hash->updates++;
+    return hash->fail;
+}
+
+static int toy_hash_final(void *context, uint8_t *digest, size_t digest_size, size_t *digest_length) {
+    toy_hash_t *hash = (toy_hash_t *)context;
+
+    (void)digest_size;
+    memcpy(digest, &hash->state, sizeof(hash->state));
+    *digest_length = sizeof(hash->state);
+    return 0;
+}
+
+static int capture_payload(
+    void *context, const uint8_t *input, size_t input_length,
+    uint8_t *signature, size_t signature_size, size_t *signature_length
+) {
+    toy_hash_t *hash = (toy_hash_t *)context;
+
+    toy_hash_init(hash);
+    toy_hash_update(hash, input, input_length);
+    return auth_fixture_sign(NULL, input, input_length, signature, signature_size, signature_length);
+}
+
+TEST test_auth_sign_hashed(void) {
+    rid_message_pack_t pack;
+    rid_auth_t auth;
+    toy_hash_t state = {0};
+    toy_hash_t flat = {0};
+    rid_auth_hash_t hash = {toy_hash_init, toy_hash_update, toy_hash_final, &state};
+    uint8_t expected[32];
+    uint8_t signature[RID_AUTH_PAGE_MAX_SIGNATURE_SIZE];
+
+    auth_fixture_make_signed_pack(&pack, &auth, 1);
+
+    /* Digest of the streamed payload equals the digest of the flat one. */
+    ASSERT_EQ(RID_SUCCESS, rid_auth_sign(&auth, &pack, capture_payload, &flat));
+    ASSERT_EQ(RID_SUCCESS, rid_auth_sign_hashed(&auth, &pack, &hash, auth_fixture_sign, NULL));
+    ASSERT_EQ(3, state.updates);
+    ASSERT_EQ(flat.state, state.state);
+
+    auth_fixture_signature((const uint8_t *)&flat.state, sizeof(flat.state), expected);
+    ASSERT_EQ(32, rid_auth_get_length(&auth));
+    ASSERT_EQ(RID_SUCCESS, rid_auth_get_signature(&auth, signature, sizeof(signature)));
+    ASSERT_MEM_EQ(expected, signature, 32);
+
+    ASSERT_EQ(RID_SUCCESS, rid_auth_verify_hashed(&auth, &pack, &hash, auth_fixture_verify, NULL));
+
+    rid_auth_set_timestamp(&auth, 2000);
+    ASSERT_EQ(RID_ERROR_INVALID_SIGNATURE, rid_auth_verify_hashed(&auth, &pack, &hash, auth_fixture_verify, NULL));
+
+    PASS();
+}
+
+TEST test_auth_sign_hashed_errors(void) {
+    rid_message_pack_t pack;
+    rid_auth_t auth;
+    toy_hash_t state = {0};
+    rid_auth_hash_t hash = {toy_hash_init, toy_hash_update, toy_hash_final, &state};
+    rid_auth_hash_t incomplete = {toy_hash_init, NULL, toy_hash_final, &state};
+
+    auth_fixture_make_signed_pack(&pack, &auth, 1);
+
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_auth_sign_hashed(NULL, &pack, &hash, auth_fixture_sign, NULL));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_auth_sign_hashed(&auth, NULL, &hash, auth_fixture_sign, NULL));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_auth_sign_hashed(&auth, &pack, NULL, auth_fixture_sign, NULL));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_auth_sign_hashed(&auth, &pack, &incomplete, auth_fixture_sign, NULL));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_auth_sign_hashed(&auth, &pack, &hash, NULL, NULL));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_auth_verify_hashed(NULL, &pack, &hash, auth_fixture_verify, NULL));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_auth_verify_hashed(&auth, &pack, &incomplete, auth_fixture_verify, NULL));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_auth_verify_hashed(&auth, &pack, &hash, NULL, NULL));
+
+    /* Hash failures are passed through. */
+    state.fail = 7;
+    ASSERT_EQ(7, rid_auth_sign_hashed(&auth, &pack, &hash, auth_fixture_sign, NULL));
+    ASSERT_EQ(7, rid_auth_verify_hashed(&auth, &pack, &hash, auth_fixture_verify, NULL));
+
+    PASS();
+}
+
 SUITE(auth_suite) {
     RUN_TEST(test_auth_init);
     RUN_TEST(test_auth_validate_valid);
@@ -716,4 +936,9 @@ SUITE(auth_suite) {
     RUN_TEST(test_message_to_json_auth_page);
     RUN_TEST(test_message_to_json_null_pointer);
     RUN_TEST(test_message_to_json_needed);
+    RUN_TEST(test_auth_verify);
+    RUN_TEST(test_auth_verify_batch);
+    RUN_TEST(test_auth_verify_batch_errors);
+    RUN_TEST(test_auth_sign_hashed);
+    RUN_TEST(test_auth_sign_hashed_errors);
 }
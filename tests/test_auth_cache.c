@@ -0,0 +1,211 @@
+#include <stddef.h>
+#include <stdint.h>
+
+#include "auth_fixture.h"
+#include "greatest.h"
+#include "rid/auth.h"
+#include "rid/auth_cache.h"
+#include "rid/message.h"
+#include "rid/message_pack.h"
+
+static uint64_t storage[1024];
+
+static const uint8_t key[RID_AUTH_CACHE_KEY_SIZE] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f
+};
+
+/* Verifier with another key, every fixture signature is invalid for it. */
+static int verify_other_key(
+    void *context, const uint8_t *input, size_t input_length,
+    const uint8_t *signature, size_t signature_length
+) {
+    (void)input;
+    (void)input_length;
+    (void)signature;
+    (void)signature_length;
+
+    (*(int *)context)++;
+    return RID_ERROR_INVALID_SIGNATURE;
+}
+
+/* Verifier whose backend is not available. */
+static int verify_unavailable(
+    void *context, const uint8_t *input, size_t input_length,
+    const uint8_t *signature, size_t signature_length
+) {
+    (void)input;
+    (void)input_length;
+    (void)signature;
+    (void)signature_length;
+
+    (*(int *)context)++;
+    return RID_ERROR_NOT_IMPLEMENTED;
+}
+
+TEST test_auth_cache_init(void) {
+    rid_auth_cache_t cache;
+    size_t size = rid_auth_cache_storage_size(64);
+
+    ASSERT(size > 0);
+    ASSERT(size <= sizeof(storage));
+    ASSERT_EQ(0, rid_auth_cache_storage_size(0));
+    ASSERT_EQ(0, rid_auth_cache_storage_size(RID_AUTH_CACHE_MAX_CAPACITY + 1));
+
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_auth_cache_init(NULL, storage, size, 64, key));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_auth_cache_init(&cache, NULL, size, 64, key));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_auth_cache_init(&cache, storage, size, 64, NULL));
+    ASSERT_EQ(RID_ERROR_OUT_OF_RANGE, rid_auth_cache_init(&cache, storage, size, 0, key));
+    ASSERT_EQ(RID_ERROR_BUFFER_TOO_SMALL, rid_auth_cache_init(&cache, storage, size - 1, 64, key));
+
+    ASSERT_EQ(RID_SUCCESS, rid_auth_cache_init(&cache, storage, size, 64, key));
+    ASSERT_EQ(0, rid_auth_cache_hits(&cache));
+    ASSERT_EQ(0, rid_auth_cache_misses(&cache));
+    ASSERT_EQ(0, rid_auth_cache_hits(NULL));
+    ASSERT_EQ(0, rid_auth_cache_misses(NULL));
+
+    PASS();
+}
+
+TEST test_auth_cache_verify(void) {
+    rid_auth_cache_t cache;
+    rid_message_pack_t pack;
+    rid_auth_t auth;
+    int calls = 0;
+
+    auth_fixture_make_signed_pack(&pack, &auth, 1);
+    ASSERT_EQ(RID_SUCCESS, rid_auth_cache_init(&cache, storage, sizeof(storage), 64, key));
+
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_EQ(RID_SUCCESS, rid_auth_cache_verify(&cache, &auth, &pack, auth_fixture_verify, &calls));
+    }
+    ASSERT_EQ(1, calls);
+    ASSERT_EQ(4, rid_auth_cache_hits(&cache));
+    ASSERT_EQ(1, rid_auth_cache_misses(&cache));
+
+    /* Changed payload is verified again and the failure is cached too. */
+    rid_auth_set_timestamp(&auth, 2000);
+    ASSERT_EQ(RID_ERROR_INVALID_SIGNATURE, rid_auth_cache_verify(&cache, &auth, &pack, auth_fixture_verify, &calls));
+    ASSERT_EQ(RID_ERROR_INVALID_SIGNATURE, rid_auth_cache_verify(&cache, &auth, &pack, auth_fixture_verify, &calls));
+    ASSERT_EQ(2, calls);
+
+    /* Same payload with another signature is a different entry. */
+    rid_auth_set_timestamp(&auth, 1001);
+    uint8_t signature[32] = {0};
+    rid_auth_set_signature(&auth, signature, sizeof(signature));
+    ASSERT_EQ(RID_ERROR_INVALID_SIGNATURE, rid_auth_cache_verify(&cache, &auth, &pack, auth_fixture_verify, &calls));
+    ASSERT_EQ(3, calls);
+
+    ASSERT_EQ(RID_SUCCESS, rid_auth_cache_clear(&cache));
+    ASSERT_EQ(0, rid_auth_cache_hits(&cache));
+    ASSERT_EQ(0, rid_auth_cache_misses(&cache));
+
+    PASS();
+}
+
+TEST test_auth_cache_eviction(void) {
+    rid_auth_cache_t cache;
+    rid_message_pack_t pack[RID_AUTH_CACHE_WAYS * 4];
+    rid_auth_t auth[RID_AUTH_CACHE_WAYS * 4];
+    int calls = 0;
+
+    /* Single set, the least recently used entry is replaced. */
+    ASSERT_EQ(RID_SUCCESS, rid_auth_cache_init(&cache, storage, sizeof(storage), 1, key));
+
+    for (uint8_t i = 0; i < RID_AUTH_CACHE_WAYS + 1; ++i) {
+        auth_fixture_make_signed_pack(&pack[i], &auth[i], i);
+    }
+
+    for (uint8_t i = 0; i < RID_AUTH_CACHE_WAYS; ++i) {
+        ASSERT_EQ(RID_SUCCESS, rid_auth_cache_verify(&cache, &auth[i], &pack[i], auth_fixture_verify, &calls));
+    }
+    ASSERT_EQ(RID_AUTH_CACHE_WAYS, calls);
+
+    /* Touch the first one so the second one is the oldest. */
+    ASSERT_EQ(RID_SUCCESS, rid_auth_cache_verify(&cache, &auth[0], &pack[0], auth_fixture_verify, &calls));
+    ASSERT_EQ(RID_SUCCESS, rid_auth_cache_verify(&cache, &auth[RID_AUTH_CACHE_WAYS], &pack[RID_AUTH_CACHE_WAYS], auth_fixture_verify, &calls));
+    ASSERT_EQ(RID_AUTH_CACHE_WAYS + 1, calls);
+
+    ASSERT_EQ(RID_SUCCESS, rid_auth_cache_verify(&cache, &auth[0], &pack[0], auth_fixture_verify, &calls));
+    ASSERT_EQ(RID_AUTH_CACHE_WAYS + 1, calls);
+    ASSERT_EQ(RID_SUCCESS, rid_auth_cache_verify(&cache, &auth[1], &pack[1], auth_fixture_verify, &calls));
+    ASSERT_EQ(RID_AUTH_CACHE_WAYS + 2, calls);
+
+    PASS();
+}
+
+TEST test_auth_cache_errors(void) {
+    rid_auth_cache_t cache;
+    rid_message_pack_t pack;
+    rid_auth_t auth;
+    int calls = 0;
+
+    auth_fixture_make_signed_pack(&pack, &auth, 1);
+    ASSERT_EQ(RID_SUCCESS, rid_auth_cache_init(&cache, storage, sizeof(storage), 64, key));
+
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_auth_cache_verify(NULL, &auth, &pack, auth_fixture_verify, &calls));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_auth_cache_verify(&cache, NULL, &pack, auth_fixture_verify, &calls));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_auth_cache_verify(&cache, &auth, NULL, auth_fixture_verify, &calls));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_auth_cache_verify(&cache, &auth, &pack, NULL, &calls));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_auth_cache_clear(NULL));
+
+    /* Validation errors are returned before the cache is consulted. */
+    ASSERT_EQ(RID_ERROR_NOT_IMPLEMENTED, rid_auth_cache_verify(&cache, &auth, &auth, auth_fixture_verify, &calls));
+    ASSERT_EQ(0, calls);
+    ASSERT_EQ(0, rid_auth_cache_misses(&cache));
+
+    PASS();
+}
+
+TEST test_auth_cache_verifiers(void) {
+    rid_auth_cache_t cache;
+    rid_message_pack_t pack;
+    rid_auth_t auth;
+    int calls = 0;
+    int other_calls = 0;
+
+    auth_fixture_make_signed_pack(&pack, &auth, 1);
+    ASSERT_EQ(RID_SUCCESS, rid_auth_cache_init(&cache, storage, sizeof(storage), 64, key));
+
+    /* A result of one verifier is not returned for another. */
+    ASSERT_EQ(RID_SUCCESS, rid_auth_cache_verify(&cache, &auth, &pack, auth_fixture_verify, &calls));
+    ASSERT_EQ(RID_ERROR_INVALID_SIGNATURE, rid_auth_cache_verify(&cache, &auth, &pack, verify_other_key, &calls));
+    ASSERT_EQ(RID_SUCCESS, rid_auth_cache_verify(&cache, &auth, &pack, auth_fixture_verify, &other_calls));
+    ASSERT_EQ(2, calls);
+    ASSERT_EQ(1, other_calls);
+
+    ASSERT_EQ(RID_SUCCESS, rid_auth_cache_verify(&cache, &auth, &pack, auth_fixture_verify, &calls));
+    ASSERT_EQ(RID_ERROR_INVALID_SIGNATURE, rid_auth_cache_verify(&cache, &auth, &pack, verify_other_key, &calls));
+    ASSERT_EQ(2, calls);
+    ASSERT_EQ(2, rid_auth_cache_hits(&cache));
+    ASSERT_EQ(3, rid_auth_cache_misses(&cache));
+
+    PASS();
+}
+
+TEST test_auth_cache_transient_error(void) {
+    rid_auth_cache_t cache;
+    rid_message_pack_t pack;
+    rid_auth_t auth;
+    int calls = 0;
+
+    auth_fixture_make_signed_pack(&pack, &auth, 1);
+    ASSERT_EQ(RID_SUCCESS, rid_auth_cache_init(&cache, storage, sizeof(storage), 64, key));
+
+    /* Backend errors are not cached, every call tries again. */
+    ASSERT_EQ(RID_ERROR_NOT_IMPLEMENTED, rid_auth_cache_verify(&cache, &auth, &pack, verify_unavailable, &calls));
+    ASSERT_EQ(RID_ERROR_NOT_IMPLEMENTED, rid_auth_cache_verify(&cache, &auth, &pack, verify_unavailable, &calls));
+    ASSERT_EQ(2, calls);
+    ASSERT_EQ(0, rid_auth_cache_hits(&cache));
+    ASSERT_EQ(2, rid_auth_cache_misses(&cache));
+
+    PASS();
+}
+
+SUITE(auth_cache_suite) {
+    RUN_TEST(test_auth_cache_init);
+    RUN_TEST(test_auth_cache_verify);
+    RUN_TEST(test_auth_cache_eviction);
+    RUN_TEST(test_auth_cache_errors);
+    RUN_TEST(test_auth_cache_verifiers);
+    RUN_TEST(test_auth_cache_transient_error);
+}
@@ -450,6 +450,39 @@ TEST test_get_auth_page_data_buffer_too_small(void) {
     PASS();
 }
 
+TEST test_auth_page_validate(void) {
+    rid_auth_page_0_t page_0;
+    rid_auth_page_x_t page_x;
+
+    rid_auth_page_0_init(&page_0);
+    rid_auth_page_x_init(&page_x, 15);
+    ASSERT_EQ(RID_SUCCESS, rid_auth_page_validate(&page_0));
+    ASSERT_EQ(RID_SUCCESS, rid_auth_page_validate(&page_x));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_auth_page_validate(NULL));
+
+    /* Page 0 data and two more pages hold 63 bytes. */
+    rid_auth_page_0_set_last_page_index(&page_0, 2);
+    rid_auth_page_0_set_length(&page_0, 63);
+    ASSERT_EQ(RID_SUCCESS, rid_auth_page_validate(&page_0));
+    rid_auth_page_0_set_length(&page_0, 64);
+    ASSERT_EQ(RID_ERROR_INVALID_LAST_PAGE_INDEX, rid_auth_page_validate(&page_0));
+
+    page_0.last_page_index = 16;
+    ASSERT_EQ(RID_ERROR_INVALID_LAST_PAGE_INDEX, rid_auth_page_validate(&page_0));
+
+    rid_auth_page_0_set_last_page_index(&page_0, 15);
+    rid_auth_page_0_set_type(&page_0, RID_AUTH_TYPE_NETWORK_REMOTE_ID);
+    ASSERT_EQ(RID_ERROR_NON_EMPTY_SIGNATURE, rid_auth_page_validate(&page_0));
+
+    page_x.protocol_version = 3;
+    ASSERT_EQ(RID_ERROR_INVALID_PROTOCOL_VERSION, rid_auth_page_validate(&page_x));
+    page_x.protocol_version = RID_PROTOCOL_VERSION_2;
+    page_x.message_type = RID_MESSAGE_TYPE_LOCATION;
+    ASSERT_EQ(RID_ERROR_UNKNOWN_MESSAGE_TYPE, rid_auth_page_validate(&page_x));
+
+    PASS();
+}
+
 TEST test_auth_type_to_string(void) {
     ASSERT_STR_EQ("RID_AUTH_TYPE_NONE", rid_auth_type_to_string(RID_AUTH_TYPE_NONE));
     ASSERT_STR_EQ("RID_AUTH_TYPE_UAS_ID_SIGNATURE", rid_auth_type_to_string(RID_AUTH_TYPE_UAS_ID_SIGNATURE));
@@ -464,6 +497,7 @@ TEST test_auth_type_to_string(void) {
 SUITE(auth_page_suite) {
     RUN_TEST(test_auth_init);
     RUN_TEST(test_auth_page_init);
+    RUN_TEST(test_auth_page_validate);
 
     RUN_TEST(test_set_and_get_auth_type);
     RUN_TEST(test_set_and_get_auth_type_null_pointer);
@@ -0,0 +1,158 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "auth_fixture.h"
+#include "greatest.h"
+#include "rid/auth.h"
+#include "rid/auth_queue.h"
+#include "rid/message.h"
+#include "rid/message_pack.h"
+
+static uint64_t storage[4096];
+
+typedef struct {
+    int count;
+    int result[8];
+    void *user[8];
+    rid_auth_t auth[8];
+} done_t;
+
+static void done(void *context, const rid_auth_job_t *job) {
+    done_t *finished = (done_t *)context;
+
+    finished->result[finished->count] = job->result;
+    finished->user[finished->count] = job->user;
+    finished->auth[finished->count] = job->auth;
+    finished->count++;
+}
+
+TEST test_auth_queue_init(void) {
+    rid_auth_queue_t queue;
+    size_t size = rid_auth_queue_storage_size(8);
+
+    ASSERT(size > 0);
+    ASSERT(size <= sizeof(storage));
+    ASSERT_EQ(0, rid_auth_queue_storage_size(0));
+    ASSERT_EQ(0, rid_auth_queue_storage_size(6));
+
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_auth_queue_init(NULL, storage, size, 8));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_auth_queue_init(&queue, NULL, size, 8));
+    ASSERT_EQ(RID_ERROR_OUT_OF_RANGE, rid_auth_queue_init(&queue, storage, size, 6));
+    ASSERT_EQ(RID_ERROR_BUFFER_TOO_SMALL, rid_auth_queue_init(&queue, storage, size - 1, 8));
+    ASSERT_EQ(RID_SUCCESS, rid_auth_queue_init(&queue, storage, size, 8));
+    ASSERT_EQ(0, rid_auth_queue_count(&queue));
+    ASSERT_EQ(0, rid_auth_queue_work(&queue, 8));
+
+    PASS();
+}
+
+TEST test_auth_queue_sign_and_verify(void) {
+    rid_auth_queue_t queue;
+    rid_message_pack_t pack;
+    rid_auth_t auth;
+    rid_auth_t signed_auth;
+    done_t finished;
+    int user = 0;
+
+    memset(&finished, 0, sizeof(finished));
+    auth_fixture_make_pack(&pack, &auth, 0);
+
+    ASSERT_EQ(RID_SUCCESS, rid_auth_queue_init(&queue, storage, sizeof(storage), 8));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_auth_queue_submit_sign(&queue, &auth, &pack, &user));
+    ASSERT_EQ(RID_SUCCESS, rid_auth_queue_set_crypto(&queue, auth_fixture_sign, auth_fixture_verify, NULL));
+    ASSERT_EQ(RID_SUCCESS, rid_auth_queue_set_callback(&queue, done, &finished));
+
+    ASSERT_EQ(RID_SUCCESS, rid_auth_queue_submit_sign(&queue, &auth, &pack, &user));
+    ASSERT_EQ(1, rid_auth_queue_count(&queue));
+
+    /* Caller copy is not touched. */
+    ASSERT_EQ(0, rid_auth_get_length(&auth));
+    ASSERT_EQ(1, rid_auth_queue_work(&queue, 8));
+    ASSERT_EQ(0, rid_auth_queue_count(&queue));
+
+    ASSERT_EQ(1, finished.count);
+    ASSERT_EQ(RID_SUCCESS, finished.result[0]);
+    ASSERT_EQ(&user, finished.user[0]);
+    ASSERT_EQ(RID_AUTH_TYPE_MESSAGE_SET_SIGNATURE, rid_auth_get_type(&finished.auth[0]));
+    ASSERT_EQ(32, rid_auth_get_length(&finished.auth[0]));
+
+    /* Same signature as the synchronous path. */
+    signed_auth = auth;
+    ASSERT_EQ(RID_SUCCESS, rid_auth_sign(&signed_auth, &pack, auth_fixture_sign, NULL));
+    ASSERT_MEM_EQ(&signed_auth, &finished.auth[0], sizeof(rid_auth_t));
+
+    ASSERT_EQ(RID_SUCCESS, rid_auth_queue_submit_verify(&queue, &signed_auth, &pack, NULL));
+    rid_auth_set_timestamp(&signed_auth, 1);
+    ASSERT_EQ(RID_SUCCESS, rid_auth_queue_submit_verify(&queue, &signed_auth, &pack, NULL));
+    ASSERT_EQ(2, rid_auth_queue_work(&queue, 8));
+
+    ASSERT_EQ(3, finished.count);
+    ASSERT_EQ(RID_SUCCESS, finished.result[1]);
+    ASSERT_EQ(RID_ERROR_INVALID_SIGNATURE, finished.result[2]);
+
+    PASS();
+}
+
+TEST test_auth_queue_backpressure(void) {
+    rid_auth_queue_t queue;
+    rid_message_pack_t pack;
+    rid_auth_t auth;
+    done_t finished;
+
+    memset(&finished, 0, sizeof(finished));
+    auth_fixture_make_pack(&pack, &auth, 0);
+
+    ASSERT_EQ(RID_SUCCESS, rid_auth_queue_init(&queue, storage, sizeof(storage), 4));
+    rid_auth_queue_set_crypto(&queue, auth_fixture_sign, auth_fixture_verify, NULL);
+    rid_auth_queue_set_callback(&queue, done, &finished);
+
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_EQ(RID_SUCCESS, rid_auth_queue_submit_sign(&queue, &auth, &pack, NULL));
+    }
+    ASSERT_EQ(RID_ERROR_BUFFER_TOO_SMALL, rid_auth_queue_submit_sign(&queue, &auth, &pack, NULL));
+    ASSERT_EQ(4, rid_auth_queue_count(&queue));
+
+    ASSERT_EQ(1, rid_auth_queue_work(&queue, 1));
+    ASSERT_EQ(RID_SUCCESS, rid_auth_queue_submit_sign(&queue, &auth, &pack, NULL));
+    ASSERT_EQ(RID_SUCCESS, rid_auth_queue_close(&queue));
+
+    /* Wraps around the ring. */
+    ASSERT_EQ(4, rid_auth_queue_work(&queue, 8));
+    ASSERT_EQ(RID_ERROR_NOT_FOUND, rid_auth_queue_work(&queue, 8));
+    ASSERT_EQ(5, finished.count);
+
+    PASS();
+}
+
+TEST test_auth_queue_errors(void) {
+    rid_auth_queue_t queue;
+    rid_message_pack_t pack;
+    rid_auth_t auth;
+
+    auth_fixture_make_pack(&pack, &auth, 0);
+    ASSERT_EQ(RID_SUCCESS, rid_auth_queue_init(&queue, storage, sizeof(storage), 4));
+    rid_auth_queue_set_crypto(&queue, auth_fixture_sign, auth_fixture_verify, NULL);
+
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_auth_queue_submit_sign(NULL, &auth, &pack, NULL));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_auth_queue_submit_sign(&queue, NULL, &pack, NULL));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_auth_queue_submit_verify(&queue, &auth, NULL, NULL));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_auth_queue_set_crypto(NULL, auth_fixture_sign, auth_fixture_verify, NULL));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_auth_queue_set_callback(NULL, NULL, NULL));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_auth_queue_close(NULL));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_auth_queue_work(NULL, 1));
+    ASSERT_EQ(0, rid_auth_queue_count(NULL));
+
+    /* Checks are done when submitting, nothing is queued. */
+    ASSERT_EQ(RID_ERROR_NOT_IMPLEMENTED, rid_auth_queue_submit_sign(&queue, &auth, &auth, NULL));
+    ASSERT_EQ(RID_ERROR_NOT_IMPLEMENTED, rid_auth_queue_submit_verify(&queue, &auth, &pack, NULL));
+    ASSERT_EQ(0, rid_auth_queue_count(&queue));
+
+    PASS();
+}
+
+SUITE(auth_queue_suite) {
+    RUN_TEST(test_auth_queue_init);
+    RUN_TEST(test_auth_queue_sign_and_verify);
+    RUN_TEST(test_auth_queue_backpressure);
+    RUN_TEST(test_auth_queue_errors);
+}
@@ -0,0 +1,275 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "greatest.h"
+#include "rid/auth.h"
+#include "rid/auth_page.h"
+#include "rid/auth_reassembler.h"
+#include "rid/location.h"
+#include "rid/message.h"
+#include "rid/transport.h"
+
+static uint64_t storage[4096];
+
+static rid_address_t make_address(uint32_t n) {
+    rid_address_t address = {{0x02, 0x00, (uint8_t)(n >> 24), (uint8_t)(n >> 16), (uint8_t)(n >> 8), (uint8_t)n}};
+    return address;
+}
+
+/* 64 byte signature takes pages 0 to 3. */
+static void make_auth(rid_auth_t *auth, uint8_t seed) {
+    uint8_t signature[64];
+
+    for (size_t i = 0; i < sizeof(signature); ++i) {
+        signature[i] = (uint8_t)(seed + i);
+    }
+
+    rid_auth_init(auth);
+    rid_auth_set_type(auth, RID_AUTH_TYPE_MESSAGE_SET_SIGNATURE);
+    rid_auth_set_timestamp(auth, 1000 + seed);
+    rid_auth_set_signature(auth, signature, sizeof(signature));
+}
+
+static const void *page(const rid_auth_t *auth, uint8_t page_number) {
+    if (page_number == 0) {
+        return &auth->page_0;
+    }
+    return &auth->page_x[page_number - 1];
+}
+
+TEST test_auth_reassembler_init(void) {
+    rid_auth_reassembler_t reassembler;
+    size_t size = rid_auth_reassembler_storage_size(32);
+
+    ASSERT(size > 0);
+    ASSERT(size <= sizeof(storage));
+    ASSERT_EQ(0, rid_auth_reassembler_storage_size(0));
+
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_auth_reassembler_init(NULL, storage, size, 32));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_auth_reassembler_init(&reassembler, NULL, size, 32));
+    ASSERT_EQ(RID_ERROR_OUT_OF_RANGE, rid_auth_reassembler_init(&reassembler, storage, size, 0));
+    ASSERT_EQ(RID_ERROR_BUFFER_TOO_SMALL, rid_auth_reassembler_init(&reassembler, storage, size - 1, 32));
+
+    ASSERT_EQ(RID_SUCCESS, rid_auth_reassembler_init(&reassembler, storage, size, 32));
+    ASSERT_EQ(0, rid_auth_reassembler_count(&reassembler));
+    ASSERT_EQ(32, reassembler.capacity);
+
+    PASS();
+}
+
+TEST test_auth_reassembler_in_order(void) {
+    rid_auth_reassembler_t reassembler;
+    rid_address_t address = make_address(1);
+    rid_auth_t expected;
+    rid_auth_t auth;
+
+    make_auth(&expected, 1);
+    ASSERT_EQ(4, rid_auth_get_page_count(&expected));
+    ASSERT_EQ(RID_SUCCESS, rid_auth_reassembler_init(&reassembler, storage, sizeof(storage), 8));
+
+    for (uint8_t i = 0; i < 3; ++i) {
+        ASSERT_EQ(0, rid_auth_reassembler_update(&reassembler, &address, page(&expected, i), 100 + i, &auth));
+    }
+    ASSERT_EQ(1, rid_auth_reassembler_count(&reassembler));
+
+    const rid_auth_partial_t *partial = rid_auth_reassembler_find(&reassembler, &address);
+    ASSERT(partial != NULL);
+    ASSERT_EQ(0x07, partial->received);
+    ASSERT_EQ(100, partial->first_seen);
+    ASSERT_EQ(102, partial->last_seen);
+
+    memset(&auth, 0, sizeof(auth));
+    ASSERT_EQ(1, rid_auth_reassembler_update(&reassembler, &address, page(&expected, 3), 103, &auth));
+    ASSERT_MEM_EQ(&expected.page_0, &auth.page_0, RID_MESSAGE_SIZE);
+    ASSERT_MEM_EQ(&expected.page_x[0], &auth.page_x[0], 3 * RID_MESSAGE_SIZE);
+    ASSERT_EQ(RID_SUCCESS, rid_auth_validate(&auth));
+
+    /* Completed sets are handed out once. */
+    ASSERT_EQ(0, rid_auth_reassembler_count(&reassembler));
+    ASSERT_EQ(NULL, rid_auth_reassembler_find(&reassembler, &address));
+
+    PASS();
+}
+
+TEST test_auth_reassembler_out_of_order(void) {
+    rid_auth_reassembler_t reassembler;
+    rid_address_t address = make_address(1);
+    rid_auth_t expected;
+    rid_auth_t auth;
+    uint8_t signature[64];
+    uint8_t expected_signature[64];
+
+    make_auth(&expected, 7);
+    ASSERT_EQ(RID_SUCCESS, rid_auth_reassembler_init(&reassembler, storage, sizeof(storage), 8));
+
+    /* Page 0 last, duplicates do not complete the set. */
+    ASSERT_EQ(0, rid_auth_reassembler_update(&reassembler, &address, page(&expected, 3), 1, &auth));
+    ASSERT_EQ(0, rid_auth_reassembler_update(&reassembler, &address, page(&expected, 1), 2, &auth));
+    ASSERT_EQ(0, rid_auth_reassembler_update(&reassembler, &address, page(&expected, 3), 3, &auth));
+    ASSERT_EQ(0, rid_auth_reassembler_update(&reassembler, &address, page(&expected, 2), 4, &auth));
+    ASSERT_EQ(1, rid_auth_reassembler_update(&reassembler, &address, page(&expected, 0), 5, &auth));
+
+    ASSERT_EQ(RID_SUCCESS, rid_auth_get_signature(&auth, signature, sizeof(signature)));
+    ASSERT_EQ(RID_SUCCESS, rid_auth_get_signature(&expected, expected_signature, sizeof(expected_signature)));
+    ASSERT_MEM_EQ(expected_signature, signature, sizeof(signature));
+    ASSERT_EQ(rid_auth_get_timestamp(&expected), rid_auth_get_timestamp(&auth));
+
+    PASS();
+}
+
+TEST test_auth_reassembler_interleaved(void) {
+    rid_auth_reassembler_t reassembler;
+    rid_auth_t expected[3];
+    rid_auth_t auth;
+    rid_address_t address[3];
+    int completed = 0;
+
+    ASSERT_EQ(RID_SUCCESS, rid_auth_reassembler_init(&reassembler, storage, sizeof(storage), 8));
+
+    for (uint8_t a = 0; a < 3; ++a) {
+        address[a] = make_address(a);
+        make_auth(&expected[a], (uint8_t)(a * 50));
+    }
+
+    for (uint8_t i = 0; i < 4; ++i) {
+        for (uint8_t a = 0; a < 3; ++a) {
+            int status = rid_auth_reassembler_update(&reassembler, &address[a], page(&expected[a], i), i, &auth);
+
+            ASSERT(status >= 0);
+            if (status == 1) {
+                ASSERT_MEM_EQ(&expected[a], &auth, (size_t)4 * RID_MESSAGE_SIZE);
+                completed++;
+            }
+        }
+    }
+
+    ASSERT_EQ(3, completed);
+    ASSERT_EQ(0, rid_auth_reassembler_count(&reassembler));
+
+    PASS();
+}
+
+TEST test_auth_reassembler_restart(void) {
+    rid_auth_reassembler_t reassembler;
+    rid_address_t address = make_address(1);
+    rid_auth_t first;
+    rid_auth_t second;
+    rid_auth_t auth;
+
+    make_auth(&first, 1);
+    make_auth(&second, 2);
+    ASSERT_EQ(RID_SUCCESS, rid_auth_reassembler_init(&reassembler, storage, sizeof(storage), 8));
+
+    /* Page 2 of the first set is lost, page 1 of the second one restarts. */
+    ASSERT_EQ(0, rid_auth_reassembler_update(&reassembler, &address, page(&first, 0), 1, &auth));
+    ASSERT_EQ(0, rid_auth_reassembler_update(&reassembler, &address, page(&first, 1), 2, &auth));
+    ASSERT_EQ(0, rid_auth_reassembler_update(&reassembler, &address, page(&first, 3), 3, &auth));
+    ASSERT_EQ(0, rid_auth_reassembler_update(&reassembler, &address, page(&second, 1), 4, &auth));
+
+    const rid_auth_partial_t *partial = rid_auth_reassembler_find(&reassembler, &address);
+    ASSERT(partial != NULL);
+    ASSERT_EQ(0x02, partial->received);
+    ASSERT_EQ(4, partial->first_seen);
+
+    /* Stale page 0 would complete the set with the wrong signature. */
+    ASSERT_EQ(0, rid_auth_reassembler_update(&reassembler, &address, page(&second, 2), 5, &auth));
+    ASSERT_EQ(0, rid_auth_reassembler_update(&reassembler, &address, page(&second, 3), 6, &auth));
+    ASSERT_EQ(1, rid_auth_reassembler_update(&reassembler, &address, page(&second, 0), 7, &auth));
+    ASSERT_MEM_EQ(&second, &auth, (size_t)4 * RID_MESSAGE_SIZE);
+
+    PASS();
+}
+
+TEST test_auth_reassembler_single_page(void) {
+    rid_auth_reassembler_t reassembler;
+    rid_address_t address = make_address(1);
+    rid_auth_t expected;
+    rid_auth_t auth;
+
+    rid_auth_init(&expected);
+    rid_auth_set_type(&expected, RID_AUTH_TYPE_NETWORK_REMOTE_ID);
+    ASSERT_EQ(RID_SUCCESS, rid_auth_reassembler_init(&reassembler, storage, sizeof(storage), 8));
+
+    ASSERT_EQ(1, rid_auth_reassembler_update(&reassembler, &address, &expected.page_0, 1, &auth));
+    ASSERT_MEM_EQ(&expected.page_0, &auth.page_0, RID_MESSAGE_SIZE);
+    ASSERT_EQ(0, rid_auth_reassembler_count(&reassembler));
+
+    PASS();
+}
+
+TEST test_auth_reassembler_expire(void) {
+    rid_auth_reassembler_t reassembler;
+    rid_auth_t expected;
+    rid_auth_t auth;
+
+    make_auth(&expected, 1);
+    ASSERT_EQ(RID_SUCCESS, rid_auth_reassembler_init(&reassembler, storage, sizeof(storage), 16));
+
+    for (uint32_t i = 0; i < 10; ++i) {
+        rid_address_t address = make_address(i);
+        ASSERT_EQ(0, rid_auth_reassembler_update(&reassembler, &address, page(&expected, 0), i * 100, &auth));
+    }
+    ASSERT_EQ(10, rid_auth_reassembler_count(&reassembler));
+
+    ASSERT_EQ(5, rid_auth_reassembler_expire(&reassembler, 500));
+    ASSERT_EQ(5, rid_auth_reassembler_count(&reassembler));
+
+    for (uint32_t i = 0; i < 10; ++i) {
+        rid_address_t address = make_address(i);
+        ASSERT_EQ(i >= 5, rid_auth_reassembler_find(&reassembler, &address) != NULL);
+    }
+
+    ASSERT_EQ(RID_SUCCESS, rid_auth_reassembler_clear(&reassembler));
+    ASSERT_EQ(0, rid_auth_reassembler_count(&reassembler));
+
+    PASS();
+}
+
+TEST test_auth_reassembler_errors(void) {
+    rid_auth_reassembler_t reassembler;
+    rid_address_t address = make_address(1);
+    rid_auth_t expected;
+    rid_auth_t auth;
+    rid_location_t location;
+
+    make_auth(&expected, 1);
+    rid_location_init(&location);
+    ASSERT_EQ(RID_SUCCESS, rid_auth_reassembler_init(&reassembler, storage, sizeof(storage), 1));
+
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_auth_reassembler_update(NULL, &address, &expected, 1, &auth));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_auth_reassembler_update(&reassembler, NULL, &expected, 1, &auth));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_auth_reassembler_update(&reassembler, &address, NULL, 1, &auth));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_auth_reassembler_update(&reassembler, &address, &expected, 1, NULL));
+    ASSERT_EQ(RID_ERROR_UNKNOWN_MESSAGE_TYPE, rid_auth_reassembler_update(&reassembler, &address, &location, 1, &auth));
+
+    /* Length does not fit in the announced pages. */
+    expected.page_0.last_page_index = 2;
+    ASSERT_EQ(RID_ERROR_INVALID_LAST_PAGE_INDEX, rid_auth_reassembler_update(&reassembler, &address, &expected.page_0, 1, &auth));
+    expected.page_0.last_page_index = 16;
+    ASSERT_EQ(RID_ERROR_INVALID_LAST_PAGE_INDEX, rid_auth_reassembler_update(&reassembler, &address, &expected.page_0, 1, &auth));
+    expected.page_0.last_page_index = 3;
+
+    ASSERT_EQ(0, rid_auth_reassembler_update(&reassembler, &address, &expected.page_0, 1, &auth));
+
+    rid_address_t other = make_address(2);
+    ASSERT_EQ(RID_ERROR_BUFFER_TOO_SMALL, rid_auth_reassembler_update(&reassembler, &other, &expected.page_0, 1, &auth));
+    ASSERT_EQ(1, rid_auth_reassembler_count(&reassembler));
+
+    ASSERT_EQ(0, rid_auth_reassembler_count(NULL));
+    ASSERT_EQ(0, rid_auth_reassembler_expire(NULL, 1));
+    ASSERT_EQ(NULL, rid_auth_reassembler_find(NULL, &address));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_auth_reassembler_clear(NULL));
+
+    PASS();
+}
+
+SUITE(auth_reassembler_suite) {
+    RUN_TEST(test_auth_reassembler_init);
+    RUN_TEST(test_auth_reassembler_in_order);
+    RUN_TEST(test_auth_reassembler_out_of_order);
+    RUN_TEST(test_auth_reassembler_interleaved);
+    RUN_TEST(test_auth_reassembler_restart);
+    RUN_TEST(test_auth_reassembler_single_page);
+    RUN_TEST(test_auth_reassembler_expire);
+    RUN_TEST(test_auth_reassembler_errors);
+}
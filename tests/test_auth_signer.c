@@ -0,0 +1,173 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "auth_fixture.h"
+#include "greatest.h"
+#include "rid/auth.h"
+#include "rid/auth_signer.h"
+#include "rid/basic_id.h"
+#include "rid/location.h"
+#include "rid/message.h"
+#include "rid/message_pack.h"
+#include "rid/self_id.h"
+#include "rid/system.h"
+
+/* Fixture pack followed by a System message, location receives the Location message. */
+static void make_pack(rid_message_pack_t *pack, rid_location_t *location) {
+    rid_system_t system;
+    rid_auth_t auth;
+
+    auth_fixture_make_pack(pack, &auth, 0);
+    rid_message_pack_copy_message_at(pack, 1, location);
+    rid_system_init(&system);
+    rid_message_pack_add_message(pack, &system);
+}
+
+TEST test_auth_signer_init(void) {
+    rid_auth_signer_t signer;
+    rid_message_pack_t pack;
+    rid_location_t location;
+    rid_auth_t auth;
+
+    make_pack(&pack, &location);
+
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_auth_signer_init(NULL, &pack));
+    ASSERT_EQ(RID_SUCCESS, rid_auth_signer_init(&signer, NULL));
+    ASSERT_EQ(0, rid_message_pack_message_count(rid_auth_signer_get_pack(&signer)));
+    ASSERT_EQ(NULL, rid_auth_signer_get_pack(NULL));
+
+    /* Auth messages of a signed pack are left out. */
+    rid_auth_init(&auth);
+    rid_auth_set_timestamp(&auth, 1000);
+    ASSERT_EQ(RID_SUCCESS, rid_auth_sign(&auth, &pack, auth_fixture_sign, NULL));
+    ASSERT_EQ(RID_SUCCESS, rid_message_pack_set_auth(&pack, &auth));
+    ASSERT_EQ(5, rid_message_pack_message_count(&pack));
+
+    ASSERT_EQ(RID_SUCCESS, rid_auth_signer_init(&signer, &pack));
+    ASSERT_EQ(3, rid_message_pack_message_count(rid_auth_signer_get_pack(&signer)));
+
+    pack.message_count = 10;
+    ASSERT_EQ(RID_ERROR_INVALID_MESSAGE_COUNT, rid_auth_signer_init(&signer, &pack));
+
+    PASS();
+}
+
+TEST test_auth_signer_sign(void) {
+    rid_auth_signer_t signer;
+    rid_message_pack_t pack;
+    rid_location_t location;
+    rid_auth_t expected;
+    rid_auth_t auth;
+
+    make_pack(&pack, &location);
+    ASSERT_EQ(RID_SUCCESS, rid_auth_signer_init(&signer, &pack));
+
+    for (uint32_t second = 0; second < 5; ++second) {
+        rid_location_set_latitude(&location, 60.0 + second * 0.001);
+        ASSERT_EQ(RID_SUCCESS, rid_auth_signer_set_message(&signer, &location));
+        rid_message_pack_set_message_at(&pack, 1, &location);
+
+        rid_auth_init(&expected);
+        rid_auth_set_timestamp(&expected, 1000 + second);
+        ASSERT_EQ(RID_SUCCESS, rid_auth_sign(&expected, &pack, auth_fixture_sign, NULL));
+
+        rid_auth_init(&auth);
+        rid_auth_set_timestamp(&auth, 1000 + second);
+        ASSERT_EQ(RID_SUCCESS, rid_auth_signer_sign(&signer, &auth, auth_fixture_sign, NULL));
+
+        ASSERT_MEM_EQ(&expected, &auth, sizeof(rid_auth_t));
+        ASSERT_MEM_EQ(&pack, rid_auth_signer_get_pack(&signer), rid_message_pack_size(&pack));
+    }
+
+    PASS();
+}
+
+TEST test_auth_signer_set_message(void) {
+    rid_auth_signer_t signer;
+    rid_message_pack_t pack;
+    rid_location_t location;
+    rid_self_id_t self_id;
+    rid_auth_t auth;
+
+    make_pack(&pack, &location);
+    ASSERT_EQ(RID_SUCCESS, rid_auth_signer_init(&signer, NULL));
+
+    /* Built message by message, same order as the pack. */
+    for (uint8_t i = 0; i < pack.message_count; ++i) {
+        ASSERT_EQ(RID_SUCCESS, rid_auth_signer_set_message(&signer, rid_message_pack_get_message_at(&pack, i)));
+    }
+    ASSERT_MEM_EQ(&pack, rid_auth_signer_get_pack(&signer), rid_message_pack_size(&pack));
+
+    rid_self_id_init(&self_id);
+    ASSERT_EQ(RID_SUCCESS, rid_auth_signer_set_message_at(&signer, 2, &self_id));
+    ASSERT_MEM_EQ(&self_id, rid_message_pack_get_message_at(rid_auth_signer_get_pack(&signer), 2), RID_MESSAGE_SIZE);
+
+    rid_auth_init(&auth);
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_auth_signer_set_message(NULL, &location));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_auth_signer_set_message(&signer, NULL));
+    ASSERT_EQ(RID_ERROR_INVALID_MESSAGE_TYPE, rid_auth_signer_set_message(&signer, &auth.page_0));
+    ASSERT_EQ(RID_ERROR_INVALID_MESSAGE_TYPE, rid_auth_signer_set_message(&signer, &pack));
+    ASSERT_EQ(RID_ERROR_INVALID_MESSAGE_TYPE, rid_auth_signer_set_message_at(&signer, 0, &auth.page_0));
+    ASSERT_EQ(RID_ERROR_OUT_OF_RANGE, rid_auth_signer_set_message_at(&signer, 3, &location));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_auth_signer_sign(&signer, &auth, NULL, NULL));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_auth_signer_sign(NULL, &auth, auth_fixture_sign, NULL));
+
+    /* Same type is replaced, the pack never overflows. */
+    for (int i = 0; i < 20; ++i) {
+        ASSERT_EQ(RID_SUCCESS, rid_auth_signer_set_message(&signer, &location));
+    }
+    ASSERT_EQ(3, rid_message_pack_message_count(rid_auth_signer_get_pack(&signer)));
+
+    PASS();
+}
+
+TEST test_auth_signer_set_message_basic_id(void) {
+    rid_auth_signer_t signer;
+    rid_basic_id_t serial;
+    rid_basic_id_t registration;
+    rid_message_t reserved;
+    const rid_message_pack_t *pack;
+
+    rid_basic_id_init(&serial);
+    rid_basic_id_set_type(&serial, RID_ID_TYPE_SERIAL_NUMBER);
+    rid_basic_id_set_uas_id(&serial, "1596F3A4C8D2E7B9");
+
+    rid_basic_id_init(&registration);
+    rid_basic_id_set_type(&registration, RID_ID_TYPE_CAA_REGISTRATION_ID);
+    rid_basic_id_set_uas_id(&registration, "FIN87astrdge12k8");
+
+    ASSERT_EQ(RID_SUCCESS, rid_auth_signer_init(&signer, NULL));
+    pack = rid_auth_signer_get_pack(&signer);
+
+    /* Both Basic ID types are signed. */
+    ASSERT_EQ(RID_SUCCESS, rid_auth_signer_set_message(&signer, &serial));
+    ASSERT_EQ(RID_SUCCESS, rid_auth_signer_set_message(&signer, &registration));
+    ASSERT_EQ(2, rid_message_pack_message_count(pack));
+    ASSERT_MEM_EQ(&serial, rid_message_pack_get_message_at(pack, 0), RID_MESSAGE_SIZE);
+    ASSERT_MEM_EQ(&registration, rid_message_pack_get_message_at(pack, 1), RID_MESSAGE_SIZE);
+
+    /* Same ID type replaces only its own message. */
+    rid_basic_id_set_uas_id(&registration, "FIN87astrdge12k9");
+    ASSERT_EQ(RID_SUCCESS, rid_auth_signer_set_message(&signer, &registration));
+    ASSERT_EQ(2, rid_message_pack_message_count(pack));
+    ASSERT_MEM_EQ(&serial, rid_message_pack_get_message_at(pack, 0), RID_MESSAGE_SIZE);
+    ASSERT_MEM_EQ(&registration, rid_message_pack_get_message_at(pack, 1), RID_MESSAGE_SIZE);
+
+    /* Reserved message types cannot be signed. */
+    memset(&reserved, 0, sizeof(reserved));
+    for (uint8_t type = 0x06; type <= 0x0E; ++type) {
+        reserved.message_type = type;
+        ASSERT_EQ(RID_ERROR_INVALID_MESSAGE_TYPE, rid_auth_signer_set_message(&signer, &reserved));
+        ASSERT_EQ(RID_ERROR_INVALID_MESSAGE_TYPE, rid_auth_signer_set_message_at(&signer, 0, &reserved));
+    }
+    ASSERT_EQ(2, rid_message_pack_message_count(pack));
+
+    PASS();
+}
+
+SUITE(auth_signer_suite) {
+    RUN_TEST(test_auth_signer_init);
+    RUN_TEST(test_auth_signer_sign);
+    RUN_TEST(test_auth_signer_set_message);
+    RUN_TEST(test_auth_signer_set_message_basic_id);
+}
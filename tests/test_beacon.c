@@ -0,0 +1,177 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "greatest.h"
+#include "pack_fixture.h"
+#include "rid/beacon.h"
+#include "rid/message.h"
+#include "rid/message_pack.h"
+
+/* Fixed fields, SSID "RID", supported rates, DS parameter set and a WMM element. */
+static const uint8_t template_body[] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x64, 0x00, 0x21, 0x04,
+    0x00, 0x03, 'R', 'I', 'D',
+    0x01, 0x04, 0x82, 0x84, 0x8B, 0x96,
+    0x03, 0x01, 0x06,
+    0xDD, 0x07, 0x00, 0x50, 0xF2, 0x02, 0x00, 0x01, 0x00,
+};
+
+TEST test_beacon_build(void) {
+    rid_message_pack_t pack;
+    uint8_t element[RID_BEACON_MAX_SIZE];
+    size_t written = 0;
+    const uint8_t header[] = {0xDD, 0x3A, 0xFA, 0x0B, 0xBC, 0x0D, 0x2A};
+
+    pack_fixture_make(&pack, 2);
+
+    ASSERT_EQ(RID_SUCCESS, rid_beacon_build(&pack, 42, element, sizeof(element), &written));
+    ASSERT_EQ(RID_BEACON_HEADER_SIZE + rid_message_pack_size(&pack), written);
+    ASSERT_MEM_EQ(header, element, sizeof(header));
+    ASSERT_MEM_EQ(&pack, &element[RID_BEACON_HEADER_SIZE], rid_message_pack_size(&pack));
+
+    ASSERT_EQ(RID_ERROR_BUFFER_TOO_SMALL, rid_beacon_build(&pack, 42, element, written - 1, &written));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_beacon_build(NULL, 42, element, sizeof(element), &written));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_beacon_build(&pack, 42, NULL, 0, &written));
+
+    /* Largest pack fits the maximum size. */
+    pack_fixture_make(&pack, RID_MESSAGE_PACK_MAX_MESSAGES);
+    ASSERT_EQ(RID_SUCCESS, rid_beacon_build(&pack, 0, element, sizeof(element), &written));
+    ASSERT_EQ(RID_BEACON_MAX_SIZE, written);
+    ASSERT_EQ(RID_BEACON_MAX_SIZE - 2, element[1]);
+
+    PASS();
+}
+
+TEST test_beacon_parse(void) {
+    rid_message_pack_t pack;
+    rid_beacon_frame_t frame;
+    uint8_t body[512];
+    size_t size = sizeof(template_body);
+    size_t written;
+
+    pack_fixture_make(&pack, 3);
+    memcpy(body, template_body, size);
+    ASSERT_EQ(RID_SUCCESS, rid_beacon_build(&pack, 7, &body[size], sizeof(body) - size, &written));
+    size += written;
+
+    ASSERT_EQ(RID_SUCCESS, rid_beacon_parse(body, size, &frame));
+    ASSERT_EQ(7, frame.counter);
+    ASSERT_EQ(rid_message_pack_size(&pack), frame.message_size);
+    ASSERT_EQ(&body[sizeof(template_body) + RID_BEACON_HEADER_SIZE], frame.message);
+
+    /* Trailing FCS is ignored. */
+    memset(&body[size], 0xA5, 4);
+    ASSERT_EQ(RID_SUCCESS, rid_beacon_parse(body, size + 4, &frame));
+
+    /* Elements only. */
+    ASSERT_EQ(RID_SUCCESS, rid_beacon_parse_elements(&body[RID_BEACON_FIXED_SIZE], size - RID_BEACON_FIXED_SIZE, &frame));
+    ASSERT_EQ(7, frame.counter);
+
+    /* Truncated capture. */
+    ASSERT_EQ(RID_ERROR_INVALID_MESSAGE_SIZE, rid_beacon_parse(body, size - 1, &frame));
+
+    PASS();
+}
+
+TEST test_beacon_update(void) {
+    rid_message_pack_t pack;
+    rid_beacon_frame_t frame;
+    uint8_t body[512];
+    uint8_t copy[512];
+    size_t size = sizeof(template_body);
+    size_t first_size;
+
+    memcpy(body, template_body, size);
+
+    /* Appended to a template without Remote ID. */
+    pack_fixture_make(&pack, 2);
+    ASSERT_EQ(RID_SUCCESS, rid_beacon_update(body, &size, sizeof(body), &pack, 1));
+    ASSERT_EQ(sizeof(template_body) + RID_BEACON_HEADER_SIZE + rid_message_pack_size(&pack), size);
+    ASSERT_MEM_EQ(template_body, body, sizeof(template_body));
+    ASSERT_EQ(RID_SUCCESS, rid_beacon_parse(body, size, &frame));
+    ASSERT_EQ(1, frame.counter);
+    first_size = size;
+
+    /* Same size is overwritten in place. */
+    ASSERT_EQ(RID_SUCCESS, rid_beacon_update(body, &size, sizeof(body), &pack, 2));
+    ASSERT_EQ(first_size, size);
+    ASSERT_EQ(RID_SUCCESS, rid_beacon_parse(body, size, &frame));
+    ASSERT_EQ(2, frame.counter);
+
+    /* Element in the middle grows and the following element moves. */
+    memcpy(copy, body, size);
+    memcpy(&body[12], &copy[sizeof(template_body)], size - sizeof(template_body));
+    memcpy(&body[12 + size - sizeof(template_body)], &copy[12], sizeof(template_body) - 12);
+
+    pack_fixture_make(&pack, 5);
+    ASSERT_EQ(RID_SUCCESS, rid_beacon_update(body, &size, sizeof(body), &pack, 3));
+    ASSERT_EQ(sizeof(template_body) + RID_BEACON_HEADER_SIZE + rid_message_pack_size(&pack), size);
+    ASSERT_MEM_EQ(&template_body[12], &body[size - (sizeof(template_body) - 12)], sizeof(template_body) - 12);
+    ASSERT_EQ(RID_SUCCESS, rid_beacon_parse(body, size, &frame));
+    ASSERT_EQ(3, frame.counter);
+    ASSERT_MEM_EQ(&pack, frame.message, frame.message_size);
+
+    /* And shrinks back. */
+    pack_fixture_make(&pack, 1);
+    ASSERT_EQ(RID_SUCCESS, rid_beacon_update(body, &size, sizeof(body), &pack, 4));
+    ASSERT_EQ(sizeof(template_body) + RID_BEACON_HEADER_SIZE + rid_message_pack_size(&pack), size);
+    ASSERT_MEM_EQ(&template_body[12], &body[size - (sizeof(template_body) - 12)], sizeof(template_body) - 12);
+    ASSERT_EQ(RID_SUCCESS, rid_beacon_parse(body, size, &frame));
+    ASSERT_EQ(4, frame.counter);
+
+    /* Does not fit, nothing is changed. */
+    memcpy(copy, body, size);
+    first_size = size;
+    pack_fixture_make(&pack, RID_MESSAGE_PACK_MAX_MESSAGES);
+    ASSERT_EQ(RID_ERROR_BUFFER_TOO_SMALL, rid_beacon_update(body, &size, size + 10, &pack, 5));
+    ASSERT_EQ(first_size, size);
+    ASSERT_MEM_EQ(copy, body, size);
+
+    size = 11;
+    ASSERT_EQ(RID_ERROR_INVALID_MESSAGE_SIZE, rid_beacon_update(body, &size, sizeof(body), &pack, 5));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_beacon_update(NULL, &size, sizeof(body), &pack, 5));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_beacon_update(body, NULL, sizeof(body), &pack, 5));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_beacon_update(body, &size, sizeof(body), NULL, 5));
+
+    PASS();
+}
+
+TEST test_beacon_not_remote_id(void) {
+    rid_message_pack_t pack;
+    rid_beacon_frame_t frame;
+    uint8_t body[512];
+    size_t size = sizeof(template_body);
+    size_t written;
+    /* Vendor specific element with the OUI but other vendor type. */
+    const uint8_t other_type[] = {0xDD, 0x05, 0xFA, 0x0B, 0xBC, 0x0E, 0x00};
+    /* Element length running past the end. */
+    const uint8_t overrun[] = {0x00, 0x20, 'R', 'I', 'D'};
+    /* Single message instead of a pack. */
+    const uint8_t single[] = {0xDD, 0x08, 0xFA, 0x0B, 0xBC, 0x0D, 0x00, 0x12, 0x00, 0x00};
+
+    ASSERT_EQ(RID_ERROR_NOT_FOUND, rid_beacon_parse(template_body, sizeof(template_body), &frame));
+    ASSERT_EQ(RID_ERROR_NOT_FOUND, rid_beacon_parse(template_body, 11, &frame));
+    ASSERT_EQ(RID_ERROR_NOT_FOUND, rid_beacon_parse_elements(other_type, sizeof(other_type), &frame));
+    ASSERT_EQ(RID_ERROR_NOT_FOUND, rid_beacon_parse_elements(overrun, sizeof(overrun), &frame));
+    ASSERT_EQ(RID_ERROR_NOT_FOUND, rid_beacon_parse_elements(overrun, 0, &frame));
+    ASSERT_EQ(RID_ERROR_INVALID_MESSAGE_TYPE, rid_beacon_parse_elements(single, sizeof(single), &frame));
+
+    pack_fixture_make(&pack, 2);
+    memcpy(body, template_body, size);
+    ASSERT_EQ(RID_SUCCESS, rid_beacon_build(&pack, 1, &body[size], sizeof(body) - size, &written));
+    body[size + RID_BEACON_HEADER_SIZE + 2] = RID_MESSAGE_PACK_MAX_MESSAGES + 1;
+    ASSERT_EQ(RID_ERROR_INVALID_MESSAGE_COUNT, rid_beacon_parse(body, size + written, &frame));
+
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_beacon_parse(NULL, 0, &frame));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_beacon_parse(template_body, sizeof(template_body), NULL));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_beacon_parse_elements(NULL, 0, &frame));
+
+    PASS();
+}
+
+SUITE(beacon_suite) {
+    RUN_TEST(test_beacon_build);
+    RUN_TEST(test_beacon_parse);
+    RUN_TEST(test_beacon_update);
+    RUN_TEST(test_beacon_not_remote_id);
+}
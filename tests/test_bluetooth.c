@@ -0,0 +1,145 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "greatest.h"
+#include "rid/basic_id.h"
+#include "rid/bluetooth.h"
+#include "rid/location.h"
+#include "rid/message.h"
+#include "rid/message_pack.h"
+
+TEST test_bluetooth_build_legacy(void) {
+    rid_basic_id_t message;
+    uint8_t payload[RID_BLUETOOTH_LEGACY_SIZE];
+    size_t written = 0;
+
+    rid_basic_id_init(&message);
+    rid_basic_id_set_uas_id(&message, "1596F3A4C8D2E7B9");
+
+    ASSERT_EQ(RID_SUCCESS, rid_bluetooth_build(&message, 42, payload, sizeof(payload), &written));
+    ASSERT_EQ(RID_BLUETOOTH_LEGACY_SIZE, written);
+    ASSERT_EQ(0x1E, payload[0]);
+    ASSERT_EQ(0x16, payload[1]);
+    ASSERT_EQ(0xFA, payload[2]);
+    ASSERT_EQ(0xFF, payload[3]);
+    ASSERT_EQ(0x0D, payload[4]);
+    ASSERT_EQ(42, payload[5]);
+    ASSERT_MEM_EQ(&message, &payload[6], RID_MESSAGE_SIZE);
+
+    ASSERT_EQ(RID_ERROR_BUFFER_TOO_SMALL, rid_bluetooth_build(&message, 42, payload, sizeof(payload) - 1, &written));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_bluetooth_build(NULL, 42, payload, sizeof(payload), &written));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_bluetooth_build(&message, 42, NULL, 0, &written));
+
+    PASS();
+}
+
+TEST test_bluetooth_parse_legacy(void) {
+    rid_location_t message;
+    rid_bluetooth_frame_t frame;
+    uint8_t payload[64];
+    size_t written;
+
+    rid_location_init(&message);
+    rid_location_set_latitude(&message, 60.1699);
+
+    /* Flags and a 16-bit UUID list before the service data. */
+    payload[0] = 0x02;
+    payload[1] = 0x01;
+    payload[2] = 0x06;
+    payload[3] = 0x03;
+    payload[4] = 0x03;
+    payload[5] = 0xFA;
+    payload[6] = 0xFF;
+    ASSERT_EQ(RID_SUCCESS, rid_bluetooth_build(&message, 7, &payload[7], sizeof(payload) - 7, &written));
+
+    ASSERT_EQ(RID_SUCCESS, rid_bluetooth_parse(payload, 7 + written, &frame));
+    ASSERT_EQ(7, frame.counter);
+    ASSERT_EQ(RID_MESSAGE_SIZE, frame.message_size);
+    ASSERT_EQ(&payload[13], frame.message);
+    ASSERT_EQ(RID_MESSAGE_TYPE_LOCATION, rid_message_get_type(frame.message));
+
+    /* Service data only, as printed by btmon. */
+    ASSERT_EQ(RID_SUCCESS, rid_bluetooth_parse_service_data(&payload[11], written - 4, &frame));
+    ASSERT_EQ(7, frame.counter);
+    ASSERT_EQ(&payload[13], frame.message);
+
+    PASS();
+}
+
+TEST test_bluetooth_long_range(void) {
+    rid_message_pack_t pack;
+    rid_basic_id_t basic_id;
+    rid_location_t location;
+    rid_bluetooth_frame_t frame;
+    uint8_t payload[RID_BLUETOOTH_MAX_SIZE];
+    size_t written;
+
+    rid_basic_id_init(&basic_id);
+    rid_location_init(&location);
+    rid_message_pack_init(&pack);
+    rid_message_pack_add_message(&pack, &basic_id);
+    rid_message_pack_add_message(&pack, &location);
+
+    ASSERT_EQ(RID_SUCCESS, rid_bluetooth_build(&pack, 255, payload, sizeof(payload), &written));
+    ASSERT_EQ(RID_BLUETOOTH_HEADER_SIZE + rid_message_pack_size(&pack), written);
+    ASSERT_EQ(written - 1, payload[0]);
+
+    ASSERT_EQ(RID_SUCCESS, rid_bluetooth_parse(payload, written, &frame));
+    ASSERT_EQ(255, frame.counter);
+    ASSERT_EQ(rid_message_pack_size(&pack), frame.message_size);
+    ASSERT_MEM_EQ(&pack, frame.message, frame.message_size);
+
+    /* Pack claiming more messages than received. */
+    ASSERT_EQ(RID_ERROR_INVALID_MESSAGE_SIZE, rid_bluetooth_parse(payload, written - 1, &frame));
+
+    /* Malformed pack header, same checks as NAN and Beacon. */
+    payload[RID_BLUETOOTH_HEADER_SIZE + 1] = 24;
+    ASSERT_EQ(RID_ERROR_INVALID_MESSAGE_SIZE, rid_bluetooth_parse(payload, written, &frame));
+    payload[RID_BLUETOOTH_HEADER_SIZE + 1] = RID_MESSAGE_SIZE;
+    payload[RID_BLUETOOTH_HEADER_SIZE + 2] = RID_MESSAGE_PACK_MAX_MESSAGES + 1;
+    ASSERT_EQ(RID_ERROR_INVALID_MESSAGE_COUNT, rid_bluetooth_parse(payload, written, &frame));
+
+    /* Largest pack fits the maximum size. */
+    for (uint8_t i = 2; i < RID_MESSAGE_PACK_MAX_MESSAGES; ++i) {
+        rid_message_pack_add_message(&pack, &location);
+    }
+    ASSERT_EQ(RID_SUCCESS, rid_bluetooth_build(&pack, 0, payload, sizeof(payload), &written));
+    ASSERT_EQ(RID_BLUETOOTH_MAX_SIZE, written);
+
+    PASS();
+}
+
+TEST test_bluetooth_not_remote_id(void) {
+    rid_bluetooth_frame_t frame;
+    /* Flags, Eddystone service data and a manufacturer specific structure. */
+    const uint8_t other[] = {
+        0x02, 0x01, 0x06,
+        0x06, 0x16, 0xAA, 0xFE, 0x10, 0x00, 0x01,
+        0x05, 0xFF, 0x4C, 0x00, 0x02, 0x15,
+    };
+    /* Remote ID UUID but wrong application code. */
+    const uint8_t app_code[] = {0x07, 0x16, 0xFA, 0xFF, 0x0E, 0x00, 0x00, 0x00};
+    /* Truncated to less than one message. */
+    const uint8_t short_data[] = {0x1E, 0x16, 0xFA, 0xFF, 0x0D, 0x00, 0x02, 0x00};
+    /* Length running past the end of the payload. */
+    const uint8_t overrun[] = {0x02, 0x01, 0x06, 0x7F, 0x16, 0xAA};
+
+    ASSERT_EQ(RID_ERROR_NOT_FOUND, rid_bluetooth_parse(other, sizeof(other), &frame));
+    ASSERT_EQ(RID_ERROR_NOT_FOUND, rid_bluetooth_parse(app_code, sizeof(app_code), &frame));
+    ASSERT_EQ(RID_ERROR_INVALID_MESSAGE_SIZE, rid_bluetooth_parse(short_data, sizeof(short_data), &frame));
+    ASSERT_EQ(RID_ERROR_NOT_FOUND, rid_bluetooth_parse(overrun, sizeof(overrun), &frame));
+    ASSERT_EQ(RID_ERROR_NOT_FOUND, rid_bluetooth_parse(other, 0, &frame));
+    ASSERT_EQ(RID_ERROR_NOT_FOUND, rid_bluetooth_parse_service_data(app_code, 0, &frame));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_bluetooth_parse(NULL, 0, &frame));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_bluetooth_parse(other, sizeof(other), NULL));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_bluetooth_parse_service_data(NULL, 0, &frame));
+
+    PASS();
+}
+
+SUITE(bluetooth_suite) {
+    RUN_TEST(test_bluetooth_build_legacy);
+    RUN_TEST(test_bluetooth_parse_legacy);
+    RUN_TEST(test_bluetooth_long_range);
+    RUN_TEST(test_bluetooth_not_remote_id);
+}
@@ -0,0 +1,236 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "greatest.h"
+#include "rid/basic_id.h"
+#include "rid/location.h"
+#include "rid/message.h"
+#include "rid/message_pack.h"
+#include "rid/operator_id.h"
+#include "rid/system.h"
+
+/* Return pointer to the value following a text string key or NULL. */
+static const uint8_t *find_key(const uint8_t *cbor, size_t size, const char *key) {
+    size_t length = strlen(key);
+
+    for (size_t i = 0; i + 1 + length < size; ++i) {
+        if (cbor[i] == (0x60 | length) && memcmp(&cbor[i + 1], key, length) == 0) {
+            return &cbor[i + 1 + length];
+        }
+    }
+
+    return NULL;
+}
+
+static double read_double(const uint8_t *p) {
+    uint64_t bits = 0;
+    double value;
+
+    for (size_t i = 0; i < 8; ++i) {
+        bits = (bits << 8) | p[i];
+    }
+    memcpy(&value, &bits, sizeof(value));
+
+    return value;
+}
+
+static float read_float(const uint8_t *p) {
+    uint32_t bits = 0;
+    float value;
+
+    for (size_t i = 0; i < 4; ++i) {
+        bits = (bits << 8) | p[i];
+    }
+    memcpy(&value, &bits, sizeof(value));
+
+    return value;
+}
+
+TEST test_cbor_operator_id(void) {
+    rid_operator_id_t message;
+    uint8_t cbor[128];
+    size_t needed = 0;
+    const uint8_t expected[] = {
+        0xBF,
+        0x70, 'p', 'r', 'o', 't', 'o', 'c', 'o', 'l', '_', 'v', 'e', 'r', 's', 'i', 'o', 'n', 0x02,
+        0x6C, 'm', 'e', 's', 's', 'a', 'g', 'e', '_', 't', 'y', 'p', 'e', 0x05,
+        0x67, 'i', 'd', '_', 't', 'y', 'p', 'e', 0x00,
+        0x6B, 'o', 'p', 'e', 'r', 'a', 't', 'o', 'r', '_', 'i', 'd',
+        0x6C, 'F', 'I', 'N', '8', '7', 'a', 's', 't', 'r', 'd', 'g', 'e',
+        0xFF,
+    };
+
+    rid_operator_id_init(&message);
+    rid_operator_id_set(&message, "FIN87astrdge");
+
+    ASSERT_EQ(RID_SUCCESS, rid_operator_id_to_cbor(&message, cbor, sizeof(cbor), &needed));
+    ASSERT_EQ(sizeof(expected), needed);
+    ASSERT_MEM_EQ(expected, cbor, sizeof(expected));
+
+    PASS();
+}
+
+TEST test_cbor_location_values(void) {
+    rid_location_t location;
+    uint8_t cbor[512];
+    size_t needed = 0;
+    const uint8_t *value;
+
+    rid_location_init(&location);
+    rid_location_set_latitude(&location, 60.1699);
+    rid_location_set_longitude(&location, -24.9384);
+    rid_location_set_geodetic_altitude(&location, 120.5f);
+    rid_location_set_speed(&location, 12.25f);
+    rid_location_set_track_direction(&location, 270);
+    rid_location_set_timestamp(&location, 3600);
+
+    ASSERT_EQ(RID_SUCCESS, rid_location_to_cbor(&location, cbor, sizeof(cbor), &needed));
+    ASSERT_EQ(0xBF, cbor[0]);
+    ASSERT_EQ(0xFF, cbor[needed - 1]);
+
+    /* Coordinates need double precision. */
+    value = find_key(cbor, needed, "latitude");
+    ASSERT(value != NULL);
+    ASSERT_EQ(0xFB, value[0]);
+    ASSERT(read_double(&value[1]) == 601699000 / 1e7);
+
+    value = find_key(cbor, needed, "longitude");
+    ASSERT(value != NULL);
+    ASSERT_EQ(0xFB, value[0]);
+    ASSERT(read_double(&value[1]) == -249384000 / 1e7);
+
+    /* Exact values use single precision. */
+    value = find_key(cbor, needed, "geodetic_altitude");
+    ASSERT(value != NULL);
+    ASSERT_EQ(0xFA, value[0]);
+    ASSERT(read_float(&value[1]) == 120.5f);
+
+    value = find_key(cbor, needed, "speed");
+    ASSERT(value != NULL);
+    ASSERT_EQ(0xFA, value[0]);
+    ASSERT(read_float(&value[1]) == 12.25f);
+
+    /* Integers use the shortest head. */
+    value = find_key(cbor, needed, "track_direction");
+    ASSERT(value != NULL);
+    ASSERT_EQ(0x19, value[0]);
+    ASSERT_EQ(0x01, value[1]);
+    ASSERT_EQ(0x0E, value[2]);
+
+    value = find_key(cbor, needed, "timestamp");
+    ASSERT(value != NULL);
+    ASSERT_EQ(0x19, value[0]);
+    ASSERT_EQ(0x0E, value[1]);
+    ASSERT_EQ(0x10, value[2]);
+
+    PASS();
+}
+
+TEST test_cbor_invalid_is_null(void) {
+    rid_location_t location;
+    uint8_t cbor[512];
+    size_t needed = 0;
+    const uint8_t *value;
+
+    rid_location_init(&location);
+
+    ASSERT_EQ(RID_SUCCESS, rid_location_to_cbor(&location, cbor, sizeof(cbor), &needed));
+
+    value = find_key(cbor, needed, "latitude");
+    ASSERT(value != NULL);
+    ASSERT_EQ(0xF6, value[0]);
+
+    value = find_key(cbor, needed, "pressure_altitude");
+    ASSERT(value != NULL);
+    ASSERT_EQ(0xF6, value[0]);
+
+    PASS();
+}
+
+TEST test_cbor_needed_size(void) {
+    rid_system_t system;
+    uint8_t cbor[512];
+    size_t needed = 0;
+    size_t query = 0;
+
+    rid_system_init(&system);
+
+    ASSERT_EQ(RID_SUCCESS, rid_system_to_cbor(&system, NULL, 0, &query));
+    ASSERT(query > 0);
+
+    /* No terminator, the exact size is enough. */
+    ASSERT_EQ(RID_SUCCESS, rid_system_to_cbor(&system, cbor, query, &needed));
+    ASSERT_EQ(query, needed);
+    ASSERT_EQ(0xFF, cbor[needed - 1]);
+
+    memset(cbor, 0xAA, sizeof(cbor));
+    ASSERT_EQ(RID_ERROR_BUFFER_TOO_SMALL, rid_system_to_cbor(&system, cbor, query - 1, &needed));
+    ASSERT_EQ(query, needed);
+    ASSERT_EQ(0xAA, cbor[query - 1]);
+
+    PASS();
+}
+
+TEST test_cbor_message_pack(void) {
+    rid_message_pack_t pack;
+    rid_basic_id_t basic_id;
+    rid_location_t location;
+    uint8_t cbor[2048];
+    uint8_t single[512];
+    size_t needed = 0;
+    size_t single_needed = 0;
+    const uint8_t *value;
+
+    rid_basic_id_init(&basic_id);
+    rid_basic_id_set_uas_id(&basic_id, "1596F3A4C8D2E7B9");
+    rid_location_init(&location);
+    rid_location_set_latitude(&location, 60.1699);
+
+    rid_message_pack_init(&pack);
+    rid_message_pack_add_message(&pack, &basic_id);
+    rid_message_pack_add_message(&pack, &location);
+
+    ASSERT_EQ(RID_SUCCESS, rid_message_pack_to_cbor(&pack, cbor, sizeof(cbor), &needed));
+    ASSERT_EQ(RID_SUCCESS, rid_message_to_cbor(&pack, single, sizeof(single), &single_needed));
+    ASSERT_EQ(needed, single_needed);
+    ASSERT_MEM_EQ(cbor, single, needed);
+
+    value = find_key(cbor, needed, "messages");
+    ASSERT(value != NULL);
+    ASSERT_EQ(0x9F, value[0]);
+    ASSERT_EQ(0xBF, value[1]);
+
+    /* Nested messages encode as they do on their own. */
+    ASSERT_EQ(RID_SUCCESS, rid_basic_id_to_cbor(&basic_id, single, sizeof(single), &single_needed));
+    ASSERT_MEM_EQ(single, &value[1], single_needed);
+
+    /* Message array and the pack map are closed. */
+    ASSERT_EQ(0xFF, cbor[needed - 2]);
+    ASSERT_EQ(0xFF, cbor[needed - 1]);
+
+    PASS();
+}
+
+TEST test_cbor_null_pointer(void) {
+    rid_location_t location;
+    uint8_t cbor[16];
+    size_t needed;
+
+    rid_location_init(&location);
+
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_location_to_cbor(NULL, cbor, sizeof(cbor), &needed));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_location_to_cbor(&location, NULL, 0, NULL));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_message_to_cbor(NULL, cbor, sizeof(cbor), &needed));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_message_pack_to_cbor(NULL, cbor, sizeof(cbor), &needed));
+
+    PASS();
+}
+
+SUITE(cbor_suite) {
+    RUN_TEST(test_cbor_operator_id);
+    RUN_TEST(test_cbor_location_values);
+    RUN_TEST(test_cbor_invalid_is_null);
+    RUN_TEST(test_cbor_needed_size);
+    RUN_TEST(test_cbor_message_pack);
+    RUN_TEST(test_cbor_null_pointer);
+}
@@ -0,0 +1,412 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "greatest.h"
+#include "rid/auth.h"
+#include "rid/auth_page.h"
+#include "rid/basic_id.h"
+#include "rid/decode.h"
+#include "rid/location.h"
+#include "rid/message.h"
+#include "rid/message_pack.h"
+#include "rid/operator_id.h"
+#include "rid/self_id.h"
+#include "rid/system.h"
+
+TEST test_decode_basic_id(void) {
+    rid_basic_id_t basic_id;
+    rid_decoded_t decoded;
+
+    rid_basic_id_init(&basic_id);
+    rid_basic_id_set_type(&basic_id, RID_ID_TYPE_SERIAL_NUMBER);
+    rid_basic_id_set_ua_type(&basic_id, RID_UA_TYPE_HELICOPTER_OR_MULTIROTOR);
+    rid_basic_id_set_uas_id(&basic_id, "1ABCD2345EF678XYZ");
+
+    ASSERT_EQ(RID_SUCCESS, rid_decode_message(&basic_id, &decoded));
+    ASSERT_EQ(RID_PROTOCOL_VERSION_2, decoded.protocol_version);
+    ASSERT_EQ(RID_MESSAGE_TYPE_BASIC_ID, decoded.message_type);
+    ASSERT_EQ(RID_ID_TYPE_SERIAL_NUMBER, decoded.message.basic_id.id_type);
+    ASSERT_EQ(RID_UA_TYPE_HELICOPTER_OR_MULTIROTOR, decoded.message.basic_id.ua_type);
+    ASSERT_STR_EQ("1ABCD2345EF678XYZ", decoded.message.basic_id.uas_id);
+
+    PASS();
+}
+
+TEST test_decode_location(void) {
+    rid_location_t location;
+    rid_decoded_t decoded;
+
+    rid_location_init(&location);
+    rid_location_set_operational_status(&location, RID_OPERATIONAL_STATUS_AIRBORNE);
+    rid_location_set_height_type(&location, RID_HEIGHT_TYPE_AGL);
+    rid_location_set_latitude(&location, 62.683472);
+    rid_location_set_longitude(&location, -21.974944);
+    rid_location_set_geodetic_altitude(&location, 120.5f);
+    rid_location_set_pressure_altitude(&location, 101.5f);
+    rid_location_set_height(&location, 50.0f);
+    rid_location_set_speed(&location, 99.5f);
+    rid_location_set_vertical_speed(&location, -2.5f);
+    rid_location_set_track_direction(&location, 245);
+    rid_location_set_timestamp(&location, 12345);
+    rid_location_set_horizontal_accuracy(&location, RID_HORIZONTAL_ACCURACY_10M);
+    rid_location_set_vertical_accuracy(&location, RID_VERTICAL_ACCURACY_3M);
+    rid_location_set_speed_accuracy(&location, RID_SPEED_ACCURACY_1MS);
+    rid_location_set_baro_altitude_accuracy(&location, RID_VERTICAL_ACCURACY_10M);
+    rid_location_set_timestamp_accuracy(&location, RID_TIMESTAMP_ACCURACY_0_2S);
+
+    ASSERT_EQ(RID_SUCCESS, rid_decode_message(&location, &decoded));
+    ASSERT_EQ(RID_MESSAGE_TYPE_LOCATION, decoded.message_type);
+
+    const rid_decoded_location_t *l = &decoded.message.location;
+    ASSERT_EQ(rid_location_get_operational_status(&location), l->operational_status);
+    ASSERT_EQ(rid_location_get_height_type(&location), l->height_type);
+    ASSERT_EQ(rid_location_get_track_direction(&location), l->track_direction);
+    ASSERT(rid_location_get_speed(&location) == l->speed);
+    ASSERT(rid_location_get_vertical_speed(&location) == l->vertical_speed);
+    ASSERT(rid_location_get_latitude(&location) == l->latitude);
+    ASSERT(rid_location_get_longitude(&location) == l->longitude);
+    ASSERT(rid_location_get_pressure_altitude(&location) == l->pressure_altitude);
+    ASSERT(rid_location_get_geodetic_altitude(&location) == l->geodetic_altitude);
+    ASSERT(rid_location_get_height(&location) == l->height);
+    ASSERT_EQ(rid_location_get_horizontal_accuracy(&location), l->horizontal_accuracy);
+    ASSERT_EQ(rid_location_get_vertical_accuracy(&location), l->vertical_accuracy);
+    ASSERT_EQ(rid_location_get_speed_accuracy(&location), l->speed_accuracy);
+    ASSERT_EQ(rid_location_get_baro_altitude_accuracy(&location), l->baro_altitude_accuracy);
+    ASSERT_EQ(rid_location_get_timestamp(&location), l->timestamp);
+    ASSERT_EQ(rid_location_get_timestamp_accuracy(&location), l->timestamp_accuracy);
+
+    PASS();
+}
+
+TEST test_decode_location_invalid(void) {
+    rid_location_t location;
+    rid_decoded_t decoded;
+
+    rid_location_init(&location);
+
+    ASSERT_EQ(RID_SUCCESS, rid_decode_message(&location, &decoded));
+
+    const rid_decoded_location_t *l = &decoded.message.location;
+    ASSERT_EQ(RID_TRACK_DIRECTION_UNKNOWN, l->track_direction);
+    ASSERT(RID_SPEED_INVALID == l->speed);
+    ASSERT(RID_VERTICAL_SPEED_INVALID == l->vertical_speed);
+    ASSERT(RID_LATITUDE_INVALID == l->latitude);
+    ASSERT(RID_LONGITUDE_INVALID == l->longitude);
+    ASSERT(RID_PRESSURE_ALTITUDE_INVALID == l->pressure_altitude);
+    ASSERT(RID_GEODETIC_ALTITUDE_INVALID == l->geodetic_altitude);
+    ASSERT(RID_HEIGHT_INVALID == l->height);
+    ASSERT_EQ(RID_TIMESTAMP_INVALID, l->timestamp);
+
+    PASS();
+}
+
+TEST test_decode_location_validation_error(void) {
+    rid_location_t location;
+    rid_decoded_t decoded;
+
+    rid_location_init(&location);
+    rid_location_set_longitude(&location, 24.9384);
+    location.latitude = 900000001;
+
+    ASSERT_EQ(RID_ERROR_INVALID_LATITUDE, rid_decode_message(&location, &decoded));
+
+    /* Still decoded so caller can inspect it */
+    ASSERT_EQ(RID_MESSAGE_TYPE_LOCATION, decoded.message_type);
+    ASSERT(rid_location_get_longitude(&location) == decoded.message.location.longitude);
+
+    PASS();
+}
+
+TEST test_decode_auth_pages(void) {
+    rid_auth_t auth;
+    rid_decoded_t decoded;
+    uint8_t signature[64];
+
+    for (size_t i = 0; i < sizeof(signature); ++i) {
+        signature[i] = (uint8_t)i;
+    }
+
+    rid_auth_init(&auth);
+    rid_auth_set_type(&auth, RID_AUTH_TYPE_MESSAGE_SET_SIGNATURE);
+    rid_auth_set_timestamp(&auth, 3600);
+    rid_auth_set_signature(&auth, signature, sizeof(signature));
+
+    ASSERT_EQ(RID_SUCCESS, rid_decode_message(&auth.page_0, &decoded));
+    ASSERT_EQ(RID_MESSAGE_TYPE_AUTH, decoded.message_type);
+    ASSERT_EQ(0, decoded.message.auth.page_number);
+    ASSERT_EQ(RID_AUTH_TYPE_MESSAGE_SET_SIGNATURE, decoded.message.auth.auth_type);
+    ASSERT_EQ(3, decoded.message.auth.last_page_index);
+    ASSERT_EQ(64, decoded.message.auth.length);
+    ASSERT_EQ(3600, decoded.message.auth.timestamp);
+    ASSERT_EQ(RID_AUTH_PAGE_0_DATA_SIZE, decoded.message.auth.data_size);
+    ASSERT_MEM_EQ(signature, decoded.message.auth.data, RID_AUTH_PAGE_0_DATA_SIZE);
+
+    ASSERT_EQ(RID_SUCCESS, rid_decode_message(&auth.page_x[0], &decoded));
+    ASSERT_EQ(1, decoded.message.auth.page_number);
+    ASSERT_EQ(RID_AUTH_TYPE_MESSAGE_SET_SIGNATURE, decoded.message.auth.auth_type);
+    ASSERT_EQ(0, decoded.message.auth.last_page_index);
+    ASSERT_EQ(0, decoded.message.auth.length);
+    ASSERT_EQ(RID_AUTH_PAGE_DATA_SIZE, decoded.message.auth.data_size);
+    ASSERT_MEM_EQ(signature + RID_AUTH_PAGE_0_DATA_SIZE, decoded.message.auth.data, RID_AUTH_PAGE_DATA_SIZE);
+
+    /* Page 0 with more data than its pages can hold is decoded but invalid. */
+    auth.page_0.last_page_index = 2;
+    ASSERT_EQ(RID_ERROR_INVALID_LAST_PAGE_INDEX, rid_decode_message(&auth.page_0, &decoded));
+    ASSERT_EQ(64, decoded.message.auth.length);
+
+    PASS();
+}
+
+TEST test_decode_self_id(void) {
+    rid_self_id_t self_id;
+    rid_decoded_t decoded;
+
+    rid_self_id_init(&self_id);
+    rid_self_id_set_description_type(&self_id, RID_DESCRIPTION_TYPE_EMERGENCY);
+    rid_self_id_set_description(&self_id, "Drone delivery test");
+
+    ASSERT_EQ(RID_SUCCESS, rid_decode_message(&self_id, &decoded));
+    ASSERT_EQ(RID_MESSAGE_TYPE_SELF_ID, decoded.message_type);
+    ASSERT_EQ(RID_DESCRIPTION_TYPE_EMERGENCY, decoded.message.self_id.description_type);
+    ASSERT_STR_EQ("Drone delivery test", decoded.message.self_id.description);
+
+    PASS();
+}
+
+TEST test_decode_system(void) {
+    rid_system_t system;
+    rid_decoded_t decoded;
+
+    rid_system_init(&system);
+    rid_system_set_operator_location_type(&system, RID_OPERATOR_LOCATION_TYPE_DYNAMIC);
+    rid_system_set_classification_type(&system, RID_CLASSIFICATION_TYPE_EUROPEAN_UNION);
+    rid_system_set_ua_classification_category(&system, RID_UA_CLASSIFICATION_CATEGORY_OPEN);
+    rid_system_set_ua_classification_class(&system, RID_UA_CLASSIFICATION_CLASS_1);
+    rid_system_set_operator_latitude(&system, 60.1699);
+    rid_system_set_operator_longitude(&system, 24.9384);
+    rid_system_set_operator_altitude(&system, 15.5f);
+    rid_system_set_area_count(&system, 3);
+    rid_system_set_area_radius(&system, 250);
+    rid_system_set_area_ceiling(&system, 120.0f);
+    rid_system_set_area_floor(&system, 10.0f);
+    rid_system_set_timestamp(&system, 123456);
+
+    ASSERT_EQ(RID_SUCCESS, rid_decode_message(&system, &decoded));
+    ASSERT_EQ(RID_MESSAGE_TYPE_SYSTEM, decoded.message_type);
+
+    const rid_decoded_system_t *s = &decoded.message.system;
+    ASSERT_EQ(rid_system_get_operator_location_type(&system), s->operator_location_type);
+    ASSERT_EQ(rid_system_get_classification_type(&system), s->classification_type);
+    ASSERT_EQ(rid_system_get_ua_classification_category(&system), s->ua_classification_category);
+    ASSERT_EQ(rid_system_get_ua_classification_class(&system), s->ua_classification_class);
+    ASSERT(rid_system_get_operator_latitude(&system) == s->operator_latitude);
+    ASSERT(rid_system_get_operator_longitude(&system) == s->operator_longitude);
+    ASSERT(rid_system_get_operator_altitude(&system) == s->operator_altitude);
+    ASSERT_EQ(rid_system_get_area_count(&system), s->area_count);
+    ASSERT_EQ(rid_system_get_area_radius(&system), s->area_radius);
+    ASSERT(rid_system_get_area_ceiling(&system) == s->area_ceiling);
+    ASSERT(rid_system_get_area_floor(&system) == s->area_floor);
+    ASSERT_EQ(rid_system_get_timestamp(&system), s->timestamp);
+
+    PASS();
+}
+
+TEST test_decode_operator_id(void) {
+    rid_operator_id_t operator_id;
+    rid_decoded_t decoded;
+
+    rid_operator_id_init(&operator_id);
+    rid_operator_id_set(&operator_id, "FIN87astrdge12k8");
+
+    ASSERT_EQ(RID_SUCCESS, rid_decode_message(&operator_id, &decoded));
+    ASSERT_EQ(RID_MESSAGE_TYPE_OPERATOR_ID, decoded.message_type);
+    ASSERT_EQ(RID_ID_TYPE_OPERATOR_ID, decoded.message.operator_id.id_type);
+    ASSERT_STR_EQ("FIN87astrdge12k8", decoded.message.operator_id.operator_id);
+
+    PASS();
+}
+
+TEST test_decode_message_pack(void) {
+    rid_message_pack_t pack;
+    rid_decoded_t decoded;
+
+    rid_message_pack_init(&pack);
+
+    ASSERT_EQ(RID_ERROR_INVALID_MESSAGE_TYPE, rid_decode_message(&pack, &decoded));
+
+    PASS();
+}
+
+TEST test_decode_unknown_type(void) {
+    rid_message_t message;
+    rid_decoded_t decoded;
+
+    memset(&message, 0, sizeof(message));
+    message.message_type = 0x07;
+
+    ASSERT_EQ(RID_ERROR_UNKNOWN_MESSAGE_TYPE, rid_decode_message(&message, &decoded));
+    ASSERT_EQ(0x07, decoded.message_type);
+
+    PASS();
+}
+
+TEST test_decode_message_null_pointer(void) {
+    rid_message_t message;
+    rid_decoded_t decoded;
+
+    memset(&message, 0, sizeof(message));
+
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_decode_message(NULL, &decoded));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_decode_message(&message, NULL));
+
+    PASS();
+}
+
+TEST test_decode_batch(void) {
+    rid_message_t messages[4];
+    rid_decoded_t decoded[4];
+    int errors[4];
+
+    rid_basic_id_init((rid_basic_id_t *)&messages[0]);
+    rid_basic_id_set_uas_id((rid_basic_id_t *)&messages[0], "ABC123");
+    rid_location_init((rid_location_t *)&messages[1]);
+    rid_location_set_latitude((rid_location_t *)&messages[1], 60.1699);
+    rid_location_set_longitude((rid_location_t *)&messages[1], 24.9384);
+    memset(&messages[2], 0, sizeof(messages[2]));
+    messages[2].message_type = 0x0A;
+    rid_operator_id_init((rid_operator_id_t *)&messages[3]);
+    rid_operator_id_set((rid_operator_id_t *)&messages[3], "FIN87astrdge12k8");
+
+    ASSERT_EQ(RID_SUCCESS, rid_decode_batch(messages, 0, 4, decoded, errors));
+
+    ASSERT_EQ(RID_SUCCESS, errors[0]);
+    ASSERT_EQ(RID_MESSAGE_TYPE_BASIC_ID, decoded[0].message_type);
+    ASSERT_STR_EQ("ABC123", decoded[0].message.basic_id.uas_id);
+
+    ASSERT_EQ(RID_SUCCESS, errors[1]);
+    ASSERT_EQ(RID_MESSAGE_TYPE_LOCATION, decoded[1].message_type);
+    ASSERT(rid_location_get_latitude((rid_location_t *)&messages[1]) == decoded[1].message.location.latitude);
+
+    ASSERT_EQ(RID_ERROR_UNKNOWN_MESSAGE_TYPE, errors[2]);
+
+    ASSERT_EQ(RID_SUCCESS, errors[3]);
+    ASSERT_STR_EQ("FIN87astrdge12k8", decoded[3].message.operator_id.operator_id);
+
+    PASS();
+}
+
+TEST test_decode_batch_stride(void) {
+    /* Two byte prefix like Bluetooth app code and counter */
+    uint8_t buffer[3][2 + RID_MESSAGE_SIZE];
+    rid_decoded_t decoded[3];
+    int errors[3];
+
+    for (uint8_t i = 0; i < 3; ++i) {
+        rid_location_t location;
+
+        rid_location_init(&location);
+        rid_location_set_latitude(&location, 60.0 + i);
+        rid_location_set_longitude(&location, 24.0 + i);
+
+        buffer[i][0] = 0x0D;
+        buffer[i][1] = i;
+        memcpy(&buffer[i][2], &location, RID_MESSAGE_SIZE);
+    }
+
+    ASSERT_EQ(RID_SUCCESS, rid_decode_batch(&buffer[0][2], sizeof(buffer[0]), 3, decoded, errors));
+
+    for (uint8_t i = 0; i < 3; ++i) {
+        ASSERT_EQ(RID_SUCCESS, errors[i]);
+        ASSERT_EQ(RID_MESSAGE_TYPE_LOCATION, decoded[i].message_type);
+        ASSERT_IN_RANGE(60.0 + i, decoded[i].message.location.latitude, 0.0000001);
+        ASSERT_IN_RANGE(24.0 + i, decoded[i].message.location.longitude, 0.0000001);
+    }
+
+    PASS();
+}
+
+TEST test_decode_batch_matches_single(void) {
+    rid_message_t messages[3];
+    rid_decoded_t batch[3];
+    rid_decoded_t single;
+    int errors[3];
+
+    rid_self_id_init((rid_self_id_t *)&messages[0]);
+    rid_self_id_set_description((rid_self_id_t *)&messages[0], "Survey");
+    rid_system_init((rid_system_t *)&messages[1]);
+    rid_system_set_area_radius((rid_system_t *)&messages[1], 100);
+    rid_location_init((rid_location_t *)&messages[2]);
+    rid_location_set_speed((rid_location_t *)&messages[2], 12.25f);
+
+    ASSERT_EQ(RID_SUCCESS, rid_decode_batch(messages, RID_MESSAGE_SIZE, 3, batch, errors));
+
+    for (size_t i = 0; i < 3; ++i) {
+        memset(&single, 0, sizeof(single));
+        ASSERT_EQ(rid_decode_message(&messages[i], &single), errors[i]);
+        ASSERT_EQ(single.message_type, batch[i].message_type);
+    }
+    ASSERT_STR_EQ("Survey", batch[0].message.self_id.description);
+    ASSERT_EQ(100, batch[1].message.system.area_radius);
+    ASSERT(12.25f == batch[2].message.location.speed);
+
+    PASS();
+}
+
+TEST test_decode_batch_empty(void) {
+    rid_message_t message;
+    rid_decoded_t decoded;
+    int errors;
+
+    memset(&message, 0, sizeof(message));
+
+    ASSERT_EQ(RID_SUCCESS, rid_decode_batch(&message, 0, 0, &decoded, &errors));
+
+    PASS();
+}
+
+TEST test_decode_batch_null_pointer(void) {
+    rid_message_t message;
+    rid_decoded_t decoded;
+    int errors;
+
+    memset(&message, 0, sizeof(message));
+
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_decode_batch(NULL, 0, 1, &decoded, &errors));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_decode_batch(&message, 0, 1, NULL, &errors));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_decode_batch(&message, 0, 1, &decoded, NULL));
+
+    PASS();
+}
+
+TEST test_decode_batch_invalid_stride(void) {
+    rid_message_t message;
+    rid_decoded_t decoded;
+    int errors;
+
+    memset(&message, 0, sizeof(message));
+
+    ASSERT_EQ(RID_ERROR_OUT_OF_RANGE, rid_decode_batch(&message, RID_MESSAGE_SIZE - 1, 1, &decoded, &errors));
+
+    PASS();
+}
+
+SUITE(decode_suite) {
+    RUN_TEST(test_decode_basic_id);
+    RUN_TEST(test_decode_location);
+    RUN_TEST(test_decode_location_invalid);
+    RUN_TEST(test_decode_location_validation_error);
+    RUN_TEST(test_decode_auth_pages);
+    RUN_TEST(test_decode_self_id);
+    RUN_TEST(test_decode_system);
+    RUN_TEST(test_decode_operator_id);
+    RUN_TEST(test_decode_message_pack);
+    RUN_TEST(test_decode_unknown_type);
+    RUN_TEST(test_decode_message_null_pointer);
+
+    RUN_TEST(test_decode_batch);
+    RUN_TEST(test_decode_batch_stride);
+    RUN_TEST(test_decode_batch_matches_single);
+    RUN_TEST(test_decode_batch_empty);
+    RUN_TEST(test_decode_batch_null_pointer);
+    RUN_TEST(test_decode_batch_invalid_stride);
+}
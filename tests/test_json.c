@@ -0,0 +1,192 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "greatest.h"
+#include "pack_fixture.h"
+#include "rid/json.h"
+#include "rid/location.h"
+#include "rid/message.h"
+#include "rid/message_pack.h"
+#include "rid/operator_id.h"
+#include "rid/self_id.h"
+#include "rid/system.h"
+
+typedef struct {
+    char buffer[8192];
+    size_t length;
+    size_t calls;
+    int fail_after;
+} collector_t;
+
+static int collector_write(void *context, const char *data, size_t length) {
+    collector_t *collector = (collector_t *)context;
+
+    if (collector->fail_after >= 0 && collector->calls >= (size_t)collector->fail_after) {
+        return -100;
+    }
+    if (collector->length + length >= sizeof(collector->buffer)) {
+        return -101;
+    }
+    memcpy(collector->buffer + collector->length, data, length);
+    collector->length += length;
+    collector->buffer[collector->length] = '\0';
+    collector->calls++;
+
+    return 0;
+}
+
+static void collector_init(collector_t *collector, rid_json_sink_t *sink) {
+    memset(collector, 0, sizeof(*collector));
+    collector->fail_after = -1;
+    rid_json_sink_init(sink, collector_write, collector);
+}
+
+/* Fixture pack followed by Self ID, System and Operator ID messages. */
+static void build_pack(rid_message_pack_t *pack) {
+    rid_self_id_t self_id;
+    rid_system_t system;
+    rid_operator_id_t operator_id;
+
+    rid_self_id_init(&self_id);
+    rid_self_id_set_description(&self_id, "Say \"hello\"\\");
+    rid_system_init(&system);
+    rid_operator_id_init(&operator_id);
+
+    pack_fixture_make(pack, 2);
+    rid_message_pack_add_message(pack, &self_id);
+    rid_message_pack_add_message(pack, &system);
+    rid_message_pack_add_message(pack, &operator_id);
+}
+
+TEST test_json_sink_init(void) {
+    rid_json_sink_t sink;
+    collector_t collector;
+
+    ASSERT_EQ(RID_SUCCESS, rid_json_sink_init(&sink, collector_write, &collector));
+    ASSERT_EQ(collector_write, sink.write);
+    ASSERT_EQ(&collector, sink.context);
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_json_sink_init(NULL, collector_write, NULL));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_json_sink_init(&sink, NULL, NULL));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_json_sink_file(&sink, NULL));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_json_sink_file(NULL, stdout));
+
+    PASS();
+}
+
+TEST test_json_sink_matches_buffer(void) {
+    rid_message_pack_t pack;
+    rid_json_sink_t sink;
+    collector_t collector;
+    char expected[8192];
+
+    build_pack(&pack);
+
+    for (uint8_t i = 0; i < pack.message_count; i++) {
+        const void *message = &pack.messages[i * RID_MESSAGE_SIZE];
+
+        ASSERT_EQ(RID_SUCCESS, rid_message_to_json(message, expected, sizeof(expected), NULL));
+        collector_init(&collector, &sink);
+        ASSERT_EQ(RID_SUCCESS, rid_message_to_json_sink(message, &sink));
+        ASSERT_STR_EQ(expected, collector.buffer);
+    }
+
+    PASS();
+}
+
+TEST test_json_sink_message_pack(void) {
+    rid_message_pack_t pack;
+    rid_json_sink_t sink;
+    collector_t collector;
+    char expected[8192];
+    size_t needed = 0;
+
+    build_pack(&pack);
+
+    ASSERT_EQ(RID_SUCCESS, rid_message_pack_to_json(&pack, expected, sizeof(expected), &needed));
+    ASSERT(needed > 256);
+
+    collector_init(&collector, &sink);
+    ASSERT_EQ(RID_SUCCESS, rid_message_pack_to_json_sink(&pack, &sink));
+    ASSERT_STR_EQ(expected, collector.buffer);
+    ASSERT_EQ(needed - 1, collector.length);
+    ASSERT(collector.calls > 1);
+
+    collector_init(&collector, &sink);
+    ASSERT_EQ(RID_SUCCESS, rid_message_to_json_sink(&pack, &sink));
+    ASSERT_STR_EQ(expected, collector.buffer);
+
+    PASS();
+}
+
+TEST test_json_sink_error(void) {
+    rid_message_pack_t pack;
+    rid_json_sink_t sink;
+    collector_t collector;
+
+    build_pack(&pack);
+
+    collector_init(&collector, &sink);
+    collector.fail_after = 0;
+    ASSERT_EQ(-100, rid_message_pack_to_json_sink(&pack, &sink));
+    ASSERT_EQ(0, collector.length);
+
+    collector_init(&collector, &sink);
+    collector.fail_after = 1;
+    ASSERT_EQ(-100, rid_message_pack_to_json_sink(&pack, &sink));
+    ASSERT_EQ(1, collector.calls);
+
+    PASS();
+}
+
+TEST test_json_sink_null_pointer(void) {
+    rid_location_t location;
+    rid_json_sink_t sink = {NULL, NULL};
+
+    rid_location_init(&location);
+
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_location_to_json_sink(NULL, &sink));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_location_to_json_sink(&location, NULL));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_location_to_json_sink(&location, &sink));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_message_to_json_sink(NULL, &sink));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_message_pack_to_json_sink(NULL, &sink));
+
+    PASS();
+}
+
+TEST test_json_sink_file(void) {
+    rid_message_pack_t pack;
+    rid_json_sink_t sink;
+    char expected[8192];
+    char actual[8192];
+    size_t length;
+    FILE *file = tmpfile();
+
+    if (file == NULL) {
+        SKIPm("tmpfile() not available");
+    }
+
+    build_pack(&pack);
+    ASSERT_EQ(RID_SUCCESS, rid_message_pack_to_json(&pack, expected, sizeof(expected), NULL));
+
+    ASSERT_EQ(RID_SUCCESS, rid_json_sink_file(&sink, file));
+    ASSERT_EQ(RID_SUCCESS, rid_message_pack_to_json_sink(&pack, &sink));
+
+    rewind(file);
+    length = fread(actual, 1, sizeof(actual) - 1, file);
+    actual[length] = '\0';
+    fclose(file);
+
+    ASSERT_STR_EQ(expected, actual);
+
+    PASS();
+}
+
+SUITE(json_suite) {
+    RUN_TEST(test_json_sink_init);
+    RUN_TEST(test_json_sink_matches_buffer);
+    RUN_TEST(test_json_sink_message_pack);
+    RUN_TEST(test_json_sink_error);
+    RUN_TEST(test_json_sink_null_pointer);
+    RUN_TEST(test_json_sink_file);
+}
@@ -0,0 +1,324 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "greatest.h"
+#include "rid/auth.h"
+#include "rid/auth_page.h"
+#include "rid/basic_id.h"
+#include "rid/location.h"
+#include "rid/message.h"
+#include "rid/message_pack.h"
+#include "rid/ndjson.h"
+#include "rid/operator_id.h"
+#include "rid/self_id.h"
+#include "rid/system.h"
+#include "rid/transport.h"
+
+/* Parse JSON of message back and check the bytes are the same. */
+static enum greatest_test_res round_trip(const void *message, size_t size) {
+    static rid_message_pack_t result;
+    char json[4096];
+    char again[4096];
+
+    memset(&result, 0xAA, sizeof(result));
+
+    ASSERT_EQ(RID_SUCCESS, rid_message_to_json(message, json, sizeof(json), NULL));
+    ASSERT_EQ(RID_SUCCESS, rid_message_from_json(json, strlen(json), &result, sizeof(result)));
+    ASSERT_MEM_EQ(message, &result, size);
+    ASSERT_EQ(RID_SUCCESS, rid_message_to_json(&result, again, sizeof(again), NULL));
+    ASSERT_STR_EQ(json, again);
+
+    PASS();
+}
+
+TEST test_json_reader_location(void) {
+    rid_location_t location;
+
+    rid_location_init(&location);
+    rid_location_set_latitude(&location, 60.1699);
+    rid_location_set_longitude(&location, -24.9384);
+    rid_location_set_geodetic_altitude(&location, 120.5f);
+    rid_location_set_pressure_altitude(&location, -999.5f);
+    rid_location_set_height(&location, 35.0f);
+    rid_location_set_height_type(&location, RID_HEIGHT_TYPE_AGL);
+    rid_location_set_speed(&location, 112.5f);
+    rid_location_set_vertical_speed(&location, -3.5f);
+    rid_location_set_track_direction(&location, 270);
+    rid_location_set_operational_status(&location, RID_OPERATIONAL_STATUS_AIRBORNE);
+    rid_location_set_horizontal_accuracy(&location, RID_HORIZONTAL_ACCURACY_10M);
+    rid_location_set_timestamp(&location, 3600);
+
+    CHECK_CALL(round_trip(&location, sizeof(location)));
+
+    /* Invalid values are written as null and read back as invalid. */
+    rid_location_init(&location);
+    CHECK_CALL(round_trip(&location, sizeof(location)));
+
+    PASS();
+}
+
+TEST test_json_reader_basic_id(void) {
+    rid_basic_id_t basic_id;
+    const uint8_t uuid[16] = {
+        0x55, 0x0e, 0x84, 0x00, 0xe2, 0x9b, 0x41, 0xd4,
+        0xa7, 0x16, 0x44, 0x66, 0x55, 0x44, 0x00, 0x00,
+    };
+
+    rid_basic_id_init(&basic_id);
+    rid_basic_id_set_type(&basic_id, RID_ID_TYPE_SERIAL_NUMBER);
+    rid_basic_id_set_ua_type(&basic_id, RID_UA_TYPE_HELICOPTER_OR_MULTIROTOR);
+    rid_basic_id_set_uas_id(&basic_id, "1596F3A4C8D2E7B9");
+    CHECK_CALL(round_trip(&basic_id, sizeof(basic_id)));
+
+    /* UUID is written with dashes. */
+    rid_basic_id_set_type(&basic_id, RID_ID_TYPE_UTM_ASSIGNED_UUID);
+    memset(basic_id.uas_id, 0, sizeof(basic_id.uas_id));
+    memcpy(basic_id.uas_id, uuid, sizeof(uuid));
+    CHECK_CALL(round_trip(&basic_id, sizeof(basic_id)));
+
+    /* Session ID is written as plain hex. */
+    rid_basic_id_set_type(&basic_id, RID_ID_TYPE_SPECIFIC_SESSION_ID);
+    for (size_t i = 0; i < sizeof(basic_id.uas_id); ++i) {
+        basic_id.uas_id[i] = (char)(0xF0 - i);
+    }
+    CHECK_CALL(round_trip(&basic_id, sizeof(basic_id)));
+
+    PASS();
+}
+
+TEST test_json_reader_strings(void) {
+    rid_self_id_t self_id;
+    rid_operator_id_t operator_id;
+    rid_system_t system;
+
+    rid_self_id_init(&self_id);
+    rid_self_id_set_description(&self_id, "Say \"hello\"\\ /x");
+    CHECK_CALL(round_trip(&self_id, sizeof(self_id)));
+
+    rid_operator_id_init(&operator_id);
+    rid_operator_id_set(&operator_id, "FIN87astrdge12k8");
+    CHECK_CALL(round_trip(&operator_id, sizeof(operator_id)));
+
+    rid_system_init(&system);
+    rid_system_set_operator_latitude(&system, -33.8568);
+    rid_system_set_operator_longitude(&system, 151.2153);
+    rid_system_set_operator_altitude(&system, 15.5f);
+    rid_system_set_area_count(&system, 3);
+    rid_system_set_area_radius(&system, 250);
+    rid_system_set_area_ceiling(&system, 120.0f);
+    rid_system_set_timestamp(&system, 123456789);
+    CHECK_CALL(round_trip(&system, sizeof(system)));
+
+    PASS();
+}
+
+TEST test_json_reader_auth_page(void) {
+    rid_auth_page_0_t page_0;
+    rid_auth_page_x_t page_x;
+    const uint8_t data[RID_AUTH_PAGE_DATA_SIZE] = {
+        0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C,
+        0x0D, 0x0E, 0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+    };
+
+    rid_auth_page_0_init(&page_0);
+    rid_auth_page_0_set_type(&page_0, RID_AUTH_TYPE_UAS_ID_SIGNATURE);
+    rid_auth_page_0_set_last_page_index(&page_0, 2);
+    rid_auth_page_0_set_length(&page_0, 60);
+    rid_auth_page_0_set_timestamp(&page_0, 100000);
+    rid_auth_page_0_set_data(&page_0, data, RID_AUTH_PAGE_0_DATA_SIZE);
+    CHECK_CALL(round_trip(&page_0, sizeof(page_0)));
+
+    rid_auth_page_x_init(&page_x, 2);
+    rid_auth_page_x_set_type(&page_x, RID_AUTH_TYPE_UAS_ID_SIGNATURE);
+    rid_auth_page_x_set_data(&page_x, data, sizeof(data));
+    CHECK_CALL(round_trip(&page_x, sizeof(page_x)));
+
+    PASS();
+}
+
+TEST test_json_reader_message_pack(void) {
+    rid_message_pack_t pack;
+    rid_basic_id_t basic_id;
+    rid_location_t location;
+    rid_auth_t auth;
+    uint8_t signature[64];
+
+    for (size_t i = 0; i < sizeof(signature); ++i) {
+        signature[i] = (uint8_t)(i * 7);
+    }
+
+    rid_basic_id_init(&basic_id);
+    rid_basic_id_set_uas_id(&basic_id, "1596F3A4C8D2E7B9");
+    rid_location_init(&location);
+    rid_location_set_latitude(&location, 60.1699);
+    rid_location_set_longitude(&location, 24.9384);
+
+    rid_auth_init(&auth);
+    rid_auth_set_type(&auth, RID_AUTH_TYPE_MESSAGE_SET_SIGNATURE);
+    rid_auth_set_timestamp(&auth, 200000);
+    rid_auth_set_signature(&auth, signature, sizeof(signature));
+
+    rid_message_pack_init(&pack);
+    rid_message_pack_add_message(&pack, &basic_id);
+    rid_message_pack_add_message(&pack, &location);
+    rid_message_pack_set_auth(&pack, &auth);
+    ASSERT_EQ(6, rid_message_pack_message_count(&pack));
+
+    /* Combined auth is split back into the same pages. */
+    CHECK_CALL(round_trip(&pack, sizeof(pack)));
+
+    rid_message_pack_init(&pack);
+    CHECK_CALL(round_trip(&pack, sizeof(pack)));
+
+    PASS();
+}
+
+TEST test_json_reader_formatting(void) {
+    rid_operator_id_t message;
+    rid_location_t location;
+    char operator_id[RID_OPERATOR_ID_SIZE + 1];
+    const char *json =
+        "  {\n"
+        "    \"message_type\" : 5,\n"
+        "    \"operator_id\" : \"FIN\\u0038\\/7\",\n"
+        "    \"unknown\" : [1, {\"a\": \"]}\"}, true],\n"
+        "    \"id_type\" : 0,\n"
+        "    \"protocol_version\" : 1\n"
+        "  }  ";
+
+    ASSERT_EQ(RID_SUCCESS, rid_message_from_json(json, strlen(json), &message, sizeof(message)));
+    ASSERT_EQ(RID_MESSAGE_TYPE_OPERATOR_ID, rid_message_get_type(&message));
+    ASSERT_EQ(RID_PROTOCOL_VERSION_1, rid_message_get_protocol_version(&message));
+    rid_operator_id_get(&message, operator_id, sizeof(operator_id));
+    ASSERT_STR_EQ("FIN8/7", operator_id);
+
+    /* Extra decimals are rounded, missing ones are padded. */
+    json = "{\"protocol_version\":2,\"message_type\":1,\"latitude\":60.16990005,\"longitude\":-24.9,"
+           "\"geodetic_altitude\":null,\"pressure_altitude\":null,\"height\":100,\"height_type\":0,"
+           "\"speed\":null,\"vertical_speed\":null,\"track_direction\":null,\"operational_status\":0,"
+           "\"horizontal_accuracy\":0,\"vertical_accuracy\":0,\"speed_accuracy\":0,"
+           "\"baro_altitude_accuracy\":0,\"timestamp\":null,\"timestamp_accuracy\":0}";
+    ASSERT_EQ(RID_SUCCESS, rid_message_from_json(json, strlen(json), &location, sizeof(location)));
+    ASSERT_EQ(601699001, location.latitude);
+    ASSERT_EQ(-249000000, location.longitude);
+    ASSERT_EQ(100.0f, rid_location_get_height(&location));
+    ASSERT_EQ(RID_SPEED_INVALID, rid_location_get_speed(&location));
+    ASSERT_EQ(RID_TRACK_DIRECTION_UNKNOWN, rid_location_get_track_direction(&location));
+    ASSERT_EQ(RID_TIMESTAMP_INVALID, rid_location_get_timestamp(&location));
+
+    PASS();
+}
+
+TEST test_json_reader_errors(void) {
+    rid_message_pack_t pack;
+    rid_message_t message;
+    const char *json;
+
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_message_from_json(NULL, 0, &message, sizeof(message)));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_message_from_json("{}", 2, NULL, sizeof(message)));
+
+    json = "";
+    ASSERT_EQ(RID_ERROR_INVALID_JSON, rid_message_from_json(json, strlen(json), &message, sizeof(message)));
+    json = "[1,2]";
+    ASSERT_EQ(RID_ERROR_INVALID_JSON, rid_message_from_json(json, strlen(json), &message, sizeof(message)));
+    json = "{\"protocol_version\":2,\"message_type\":5";
+    ASSERT_EQ(RID_ERROR_INVALID_JSON, rid_message_from_json(json, strlen(json), &message, sizeof(message)));
+    json = "{\"protocol_version\":2,\"message_type\":5,\"id_type\":0}";
+    ASSERT_EQ(RID_ERROR_INVALID_JSON, rid_message_from_json(json, strlen(json), &message, sizeof(message)));
+    json = "{\"protocol_version\":2,\"message_type\":5,\"id_type\":\"0\",\"operator_id\":\"\"}";
+    ASSERT_EQ(RID_ERROR_INVALID_JSON, rid_message_from_json(json, strlen(json), &message, sizeof(message)));
+    json = "{\"protocol_version\":2,\"message_type\":5,\"id_type\":1e2,\"operator_id\":\"\"}";
+    ASSERT_EQ(RID_ERROR_INVALID_JSON, rid_message_from_json(json, strlen(json), &message, sizeof(message)));
+    json = "{\"protocol_version\":2,\"message_type\":5,\"id_type\":256,\"operator_id\":\"\"}";
+    ASSERT_EQ(RID_ERROR_OUT_OF_RANGE, rid_message_from_json(json, strlen(json), &message, sizeof(message)));
+    json = "{\"protocol_version\":2,\"message_type\":5,\"id_type\":0,\"operator_id\":\"123456789012345678901\"}";
+    ASSERT_EQ(RID_ERROR_BUFFER_TOO_LARGE, rid_message_from_json(json, strlen(json), &message, sizeof(message)));
+    /* Mismatched closer and a backslash as the last byte. */
+    json = "{\"protocol_version\":2,\"message_type\":5,\"unknown\":[},\"id_type\":0,\"operator_id\":\"\"}";
+    ASSERT_EQ(RID_ERROR_INVALID_JSON, rid_message_from_json(json, strlen(json), &message, sizeof(message)));
+    json = "{\"protocol_version\":2,\"message_type\":5,\"operator_id\":\"FIN\\";
+    ASSERT_EQ(RID_ERROR_INVALID_JSON, rid_message_from_json(json, strlen(json), &message, sizeof(message)));
+    json = "{\"protocol_version\":2,\"message_type\":7}";
+    ASSERT_EQ(RID_ERROR_UNKNOWN_MESSAGE_TYPE, rid_message_from_json(json, strlen(json), &message, sizeof(message)));
+
+    /* Message Pack does not fit in a single message. */
+    json = "{\"protocol_version\":2,\"message_type\":15,\"message_count\":0,\"messages\":[]}";
+    ASSERT_EQ(RID_ERROR_BUFFER_TOO_SMALL, rid_message_from_json(json, strlen(json), &message, sizeof(message)));
+    ASSERT_EQ(RID_SUCCESS, rid_message_from_json(json, strlen(json), &pack, sizeof(pack)));
+    json = "{\"protocol_version\":2,\"message_type\":15,\"message_count\":0,\"messages\":[1]}";
+    ASSERT_EQ(RID_ERROR_INVALID_JSON, rid_message_from_json(json, strlen(json), &pack, sizeof(pack)));
+    ASSERT_EQ(RID_ERROR_BUFFER_TOO_SMALL, rid_message_from_json(json, strlen(json), &pack, RID_MESSAGE_SIZE - 1));
+
+    PASS();
+}
+
+TEST test_json_reader_ndjson(void) {
+    rid_message_t messages[3];
+    rid_message_t result;
+    uint64_t timestamps[3] = {0, 1760000000123ULL, UINT64_MAX};
+    rid_address_t sources[3] = {
+        {{0x00, 0x11, 0x22, 0x33, 0x44, 0x55}},
+        {{0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF}},
+        {{0x02, 0x00, 0x00, 0x00, 0x00, 0x01}},
+    };
+    rid_ndjson_reader_t reader;
+    rid_address_t source;
+    uint64_t received;
+    char ndjson[4096];
+    size_t length;
+
+    rid_basic_id_init((rid_basic_id_t *)&messages[0]);
+    rid_basic_id_set_uas_id((rid_basic_id_t *)&messages[0], "1596F3A4C8D2E7B9");
+    rid_location_init((rid_location_t *)&messages[1]);
+    rid_location_set_latitude((rid_location_t *)&messages[1], 60.1699);
+    rid_system_init((rid_system_t *)&messages[2]);
+
+    ASSERT_EQ(RID_SUCCESS, rid_messages_to_ndjson(messages, 0, 3, timestamps, sources, ndjson, sizeof(ndjson), NULL));
+
+    ASSERT_EQ(RID_SUCCESS, rid_ndjson_reader_init(&reader, ndjson, strlen(ndjson)));
+    for (size_t i = 0; i < 3; ++i) {
+        ASSERT_EQ(RID_SUCCESS, rid_ndjson_reader_next(&reader, &result, sizeof(result), &received, &source));
+        ASSERT_MEM_EQ(&messages[i], &result, sizeof(result));
+        ASSERT_EQ(timestamps[i], received);
+        ASSERT_MEM_EQ(sources[i].octets, source.octets, RID_ADDRESS_SIZE);
+        ASSERT_EQ(i + 1, reader.line);
+    }
+    ASSERT_EQ(RID_ERROR_NOT_FOUND, rid_ndjson_reader_next(&reader, &result, sizeof(result), NULL, NULL));
+
+    /* Plain lines, blank lines, a bad line and no final newline. */
+    ASSERT_EQ(RID_SUCCESS, rid_messages_to_ndjson(messages, 0, 2, NULL, NULL, ndjson, sizeof(ndjson), NULL));
+    length = strlen(ndjson);
+    memcpy(ndjson + length, "\r\n\n{\"message\":1}\n", 17);
+    length += 17;
+    ASSERT_EQ(RID_SUCCESS, rid_message_to_json(&messages[2], ndjson + length, sizeof(ndjson) - length, NULL));
+    length = strlen(ndjson);
+
+    ASSERT_EQ(RID_SUCCESS, rid_ndjson_reader_init(&reader, ndjson, length));
+    ASSERT_EQ(RID_SUCCESS, rid_ndjson_reader_next(&reader, &result, sizeof(result), &received, &source));
+    ASSERT_MEM_EQ(&messages[0], &result, sizeof(result));
+    ASSERT_EQ(0, received);
+    ASSERT_EQ(0, source.octets[0]);
+    ASSERT_EQ(RID_SUCCESS, rid_ndjson_reader_next(&reader, &result, sizeof(result), NULL, NULL));
+    ASSERT_MEM_EQ(&messages[1], &result, sizeof(result));
+    ASSERT_EQ(RID_ERROR_INVALID_JSON, rid_ndjson_reader_next(&reader, &result, sizeof(result), NULL, NULL));
+    ASSERT_EQ(5, reader.line);
+    ASSERT_EQ(RID_SUCCESS, rid_ndjson_reader_next(&reader, &result, sizeof(result), NULL, NULL));
+    ASSERT_MEM_EQ(&messages[2], &result, sizeof(result));
+    ASSERT_EQ(RID_ERROR_NOT_FOUND, rid_ndjson_reader_next(&reader, &result, sizeof(result), NULL, NULL));
+
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_ndjson_reader_init(NULL, ndjson, length));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_ndjson_reader_next(&reader, NULL, 0, NULL, NULL));
+
+    PASS();
+}
+
+SUITE(json_reader_suite) {
+    RUN_TEST(test_json_reader_location);
+    RUN_TEST(test_json_reader_basic_id);
+    RUN_TEST(test_json_reader_strings);
+    RUN_TEST(test_json_reader_auth_page);
+    RUN_TEST(test_json_reader_message_pack);
+    RUN_TEST(test_json_reader_formatting);
+    RUN_TEST(test_json_reader_errors);
+    RUN_TEST(test_json_reader_ndjson);
+}
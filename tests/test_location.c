@@ -1,3 +1,4 @@
+#include <stdio.h>
 #include <string.h>
 
 #include "greatest.h"
@@ -1583,6 +1584,71 @@ TEST test_location_to_json_invalid_as_null(void) {
     PASS();
 }
 
+/* Check that "key":value in buffer matches expected token. */
+static int json_value_equals(const char *buffer, const char *key, const char *expected) {
+    char needle[64];
+    const char *p;
+
+    snprintf(needle, sizeof(needle), "\"%s\":%s", key, expected);
+    p = strstr(buffer, needle);
+
+    return p != NULL && (p[strlen(needle)] == ',' || p[strlen(needle)] == '}');
+}
+
+TEST test_location_to_json_matches_printf(void) {
+    rid_location_t location;
+    char buffer[1024];
+    char expected[32];
+
+    rid_location_init(&location);
+
+    /* Every encoded altitude and vertical speed. */
+    for (uint32_t encoded = 1; encoded <= 0xFFFF; ++encoded) {
+        location.geodetic_altitude = (uint16_t)encoded;
+        location.vertical_speed = (int8_t)(encoded & 0xFF);
+        if (location.vertical_speed == RID_VERTICAL_SPEED_INVALID_ENCODED) {
+            location.vertical_speed = 0;
+        }
+
+        ASSERT_EQ(RID_SUCCESS, rid_location_to_json(&location, buffer, sizeof(buffer), NULL));
+        snprintf(expected, sizeof(expected), "%.2f", (double)rid_location_get_geodetic_altitude(&location));
+        ASSERT(json_value_equals(buffer, "geodetic_altitude", expected));
+        snprintf(expected, sizeof(expected), "%.2f", (double)rid_location_get_vertical_speed(&location));
+        ASSERT(json_value_equals(buffer, "vertical_speed", expected));
+    }
+
+    /* Every encoded speed in both multipliers. */
+    for (uint32_t encoded = 0; encoded < 512; ++encoded) {
+        location.speed = (uint8_t)encoded;
+        location.speed_multiplier = encoded >> 8;
+        if (location.speed == RID_SPEED_INVALID_ENCODED && location.speed_multiplier == 1) {
+            continue;
+        }
+
+        ASSERT_EQ(RID_SUCCESS, rid_location_to_json(&location, buffer, sizeof(buffer), NULL));
+        snprintf(expected, sizeof(expected), "%.2f", (double)rid_location_get_speed(&location));
+        ASSERT(json_value_equals(buffer, "speed", expected));
+    }
+
+    /* Latitude and longitude including signs and extremes. */
+    static const int32_t degrees[] = {
+        1, -1, 9, -9, 10000000, -10000000, 601699000, -601699000, 900000000,
+        -900000000, 1800000000, -1800000000, 1234567, -1234567, 5, 0,
+    };
+    for (size_t i = 0; i < sizeof(degrees) / sizeof(degrees[0]); ++i) {
+        location.latitude = degrees[i];
+        location.longitude = -degrees[i] + 1;
+
+        ASSERT_EQ(RID_SUCCESS, rid_location_to_json(&location, buffer, sizeof(buffer), NULL));
+        snprintf(expected, sizeof(expected), "%.7f", rid_location_get_latitude(&location));
+        ASSERT(json_value_equals(buffer, "latitude", expected));
+        snprintf(expected, sizeof(expected), "%.7f", rid_location_get_longitude(&location));
+        ASSERT(json_value_equals(buffer, "longitude", expected));
+    }
+
+    PASS();
+}
+
 TEST test_location_to_json_needed(void) {
     rid_location_t location;
     char buffer[1024];
@@ -1716,4 +1782,5 @@ SUITE(location_suite) {
     RUN_TEST(test_location_to_json_null);
     RUN_TEST(test_location_to_json_invalid_as_null);
     RUN_TEST(test_location_to_json_needed);
+    RUN_TEST(test_location_to_json_matches_printf);
 }
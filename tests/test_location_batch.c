@@ -0,0 +1,266 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "greatest.h"
+#include "rid/basic_id.h"
+#include "rid/location.h"
+#include "rid/location_batch.h"
+#include "rid/message.h"
+
+#define TEST_LOCATION_BATCH_COUNT 37
+
+static uint8_t storage[8192];
+
+static void fill_location(rid_location_t *location, size_t i) {
+    rid_location_init(location);
+    rid_location_set_operational_status(location, RID_OPERATIONAL_STATUS_AIRBORNE);
+    rid_location_set_latitude(location, -45.0 + (double)i * 2.1234567);
+    rid_location_set_longitude(location, 170.0 - (double)i * 9.7654321);
+    rid_location_set_geodetic_altitude(location, -900.0f + (float)i * 37.5f);
+    rid_location_set_pressure_altitude(location, 120.5f + (float)i);
+    rid_location_set_height(location, (float)i * 3.0f);
+    rid_location_set_speed(location, (float)i * 6.5f);
+    rid_location_set_vertical_speed(location, -60.0f + (float)i * 3.5f);
+    rid_location_set_track_direction(location, (uint16_t)((i * 29) % 360));
+    rid_location_set_timestamp(location, (uint16_t)(i * 900));
+
+    /* Sprinkle in unknown values. */
+    if (i % 5 == 1) {
+        rid_location_set_speed(location, RID_SPEED_INVALID);
+        rid_location_set_track_direction(location, RID_TRACK_DIRECTION_UNKNOWN);
+    }
+    if (i % 7 == 2) {
+        rid_location_set_height(location, RID_HEIGHT_INVALID);
+        rid_location_set_vertical_speed(location, RID_VERTICAL_SPEED_INVALID);
+        rid_location_set_timestamp(location, RID_TIMESTAMP_INVALID);
+    }
+    if (i % 11 == 3) {
+        rid_location_set_latitude(location, 0.0);
+        rid_location_set_longitude(location, 0.0);
+        rid_location_set_geodetic_altitude(location, RID_GEODETIC_ALTITUDE_INVALID);
+        rid_location_set_pressure_altitude(location, RID_PRESSURE_ALTITUDE_INVALID);
+    }
+}
+
+static enum greatest_test_res assert_matches_getters(
+    const rid_location_batch_t *batch, size_t i, const rid_location_t *location
+) {
+    ASSERT_EQ_FMT(rid_location_get_latitude(location), batch->latitude[i], "%f");
+    ASSERT_EQ_FMT(rid_location_get_longitude(location), batch->longitude[i], "%f");
+    ASSERT_EQ_FMT((double)rid_location_get_geodetic_altitude(location), (double)batch->geodetic_altitude[i], "%f");
+    ASSERT_EQ_FMT((double)rid_location_get_pressure_altitude(location), (double)batch->pressure_altitude[i], "%f");
+    ASSERT_EQ_FMT((double)rid_location_get_height(location), (double)batch->height[i], "%f");
+    ASSERT_EQ_FMT((double)rid_location_get_speed(location), (double)batch->speed[i], "%f");
+    ASSERT_EQ_FMT((double)rid_location_get_vertical_speed(location), (double)batch->vertical_speed[i], "%f");
+    ASSERT_EQ(rid_location_get_track_direction(location), batch->track_direction[i]);
+    ASSERT_EQ(rid_location_get_timestamp(location), batch->timestamp[i]);
+    PASS();
+}
+
+TEST test_location_batch_init(void) {
+    rid_location_batch_t batch;
+    size_t size = rid_location_batch_storage_size(100);
+
+    ASSERT(size <= sizeof(storage));
+    ASSERT_EQ(RID_SUCCESS, rid_location_batch_init(&batch, storage, size, 100));
+    ASSERT_EQ(100, batch.capacity);
+    ASSERT_EQ(0, batch.count);
+
+    /* Arrays must not overlap. */
+    ASSERT((uint8_t *)batch.longitude >= (uint8_t *)(batch.latitude + 100));
+    ASSERT((uint8_t *)batch.geodetic_altitude >= (uint8_t *)(batch.longitude + 100));
+    ASSERT((uint8_t *)batch.timestamp >= (uint8_t *)(batch.track_direction + 100));
+    ASSERT((uint8_t *)(batch.timestamp + 100) <= storage + size);
+
+    PASS();
+}
+
+TEST test_location_batch_init_unaligned(void) {
+    rid_location_batch_t batch;
+    size_t size = rid_location_batch_storage_size(10);
+
+    ASSERT_EQ(RID_SUCCESS, rid_location_batch_init(&batch, storage + 3, size, 10));
+    ASSERT((uint8_t *)(batch.timestamp + 10) <= storage + 3 + size);
+    ASSERT_EQ(0, (uintptr_t)batch.latitude % 8);
+
+    PASS();
+}
+
+TEST test_location_batch_init_too_small(void) {
+    rid_location_batch_t batch;
+    size_t size = rid_location_batch_storage_size(10);
+
+    ASSERT_EQ(RID_ERROR_BUFFER_TOO_SMALL, rid_location_batch_init(&batch, storage, size - 1, 10));
+
+    PASS();
+}
+
+TEST test_location_batch_init_null_pointer(void) {
+    rid_location_batch_t batch;
+
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_location_batch_init(NULL, storage, sizeof(storage), 10));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_location_batch_init(&batch, NULL, sizeof(storage), 10));
+
+    PASS();
+}
+
+TEST test_location_batch_decode(void) {
+    rid_location_t locations[TEST_LOCATION_BATCH_COUNT];
+    rid_location_batch_t batch;
+
+    for (size_t i = 0; i < TEST_LOCATION_BATCH_COUNT; ++i) {
+        fill_location(&locations[i], i);
+    }
+
+    ASSERT_EQ(RID_SUCCESS, rid_location_batch_init(&batch, storage, sizeof(storage), TEST_LOCATION_BATCH_COUNT));
+    ASSERT_EQ(RID_SUCCESS, rid_location_batch_decode(&batch, locations, 0, TEST_LOCATION_BATCH_COUNT));
+    ASSERT_EQ(TEST_LOCATION_BATCH_COUNT, batch.count);
+
+    for (size_t i = 0; i < TEST_LOCATION_BATCH_COUNT; ++i) {
+        CHECK_CALL(assert_matches_getters(&batch, i, &locations[i]));
+    }
+
+    PASS();
+}
+
+TEST test_location_batch_decode_every_count(void) {
+    rid_location_t locations[TEST_LOCATION_BATCH_COUNT];
+    rid_location_batch_t batch;
+
+    for (size_t i = 0; i < TEST_LOCATION_BATCH_COUNT; ++i) {
+        fill_location(&locations[i], i);
+    }
+
+    /* Exercise every split between the vector blocks and the tail. */
+    for (size_t count = 0; count <= 17; ++count) {
+        ASSERT_EQ(RID_SUCCESS, rid_location_batch_init(&batch, storage, sizeof(storage), count));
+        ASSERT_EQ(RID_SUCCESS, rid_location_batch_decode(&batch, &locations[count], 0, count));
+        for (size_t i = 0; i < count; ++i) {
+            CHECK_CALL(assert_matches_getters(&batch, i, &locations[count + i]));
+        }
+    }
+
+    PASS();
+}
+
+TEST test_location_batch_decode_west(void) {
+    rid_location_t locations[9];
+    rid_location_batch_t batch;
+
+    for (size_t i = 0; i < 9; ++i) {
+        rid_location_init(&locations[i]);
+        rid_location_set_track_direction(&locations[i], (uint16_t)(180 + i * 20));
+        rid_location_set_speed(&locations[i], 60.0f + (float)i * 20.0f);
+    }
+
+    ASSERT_EQ(RID_SUCCESS, rid_location_batch_init(&batch, storage, sizeof(storage), 9));
+    ASSERT_EQ(RID_SUCCESS, rid_location_batch_decode(&batch, locations, 0, 9));
+
+    for (size_t i = 0; i < 9; ++i) {
+        ASSERT_EQ(180 + i * 20, batch.track_direction[i]);
+        CHECK_CALL(assert_matches_getters(&batch, i, &locations[i]));
+    }
+
+    PASS();
+}
+
+TEST test_location_batch_decode_other_types(void) {
+    rid_message_t messages[10];
+    rid_location_t invalid;
+    rid_location_batch_t batch;
+
+    for (size_t i = 0; i < 10; ++i) {
+        if (i % 3 == 0) {
+            rid_basic_id_init((rid_basic_id_t *)&messages[i]);
+            rid_basic_id_set_uas_id((rid_basic_id_t *)&messages[i], "1ABCD2345EF678XYZ");
+        } else {
+            fill_location((rid_location_t *)&messages[i], i);
+        }
+    }
+
+    /* Location with every field set to the invalid encoding. */
+    memset(&invalid, 0, sizeof(invalid));
+    invalid.track_direction = RID_TRACK_DIRECTION_UNKNOWN_ENCODED;
+    invalid.speed = RID_SPEED_INVALID_ENCODED;
+    invalid.speed_multiplier = 1;
+    invalid.vertical_speed = RID_VERTICAL_SPEED_INVALID_ENCODED;
+    invalid.timestamp = RID_TIMESTAMP_INVALID;
+
+    ASSERT_EQ(RID_SUCCESS, rid_location_batch_init(&batch, storage, sizeof(storage), 10));
+    ASSERT_EQ(RID_SUCCESS, rid_location_batch_decode(&batch, messages, sizeof(rid_message_t), 10));
+
+    for (size_t i = 0; i < 10; ++i) {
+        if (i % 3 == 0) {
+            CHECK_CALL(assert_matches_getters(&batch, i, &invalid));
+        } else {
+            CHECK_CALL(assert_matches_getters(&batch, i, (rid_location_t *)&messages[i]));
+        }
+    }
+
+    PASS();
+}
+
+TEST test_location_batch_decode_stride(void) {
+    struct {
+        uint8_t rssi;
+        rid_location_t location;
+        uint8_t padding[6];
+    } __attribute__((__packed__)) frames[11];
+    rid_location_batch_t batch;
+
+    for (size_t i = 0; i < 11; ++i) {
+        frames[i].rssi = (uint8_t)i;
+        fill_location(&frames[i].location, i);
+    }
+
+    ASSERT_EQ(RID_SUCCESS, rid_location_batch_init(&batch, storage, sizeof(storage), 11));
+    ASSERT_EQ(RID_SUCCESS, rid_location_batch_decode(&batch, &frames[0].location, sizeof(frames[0]), 11));
+
+    for (size_t i = 0; i < 11; ++i) {
+        CHECK_CALL(assert_matches_getters(&batch, i, &frames[i].location));
+    }
+
+    PASS();
+}
+
+TEST test_location_batch_decode_errors(void) {
+    rid_location_t locations[4];
+    rid_location_batch_t batch;
+
+    memset(locations, 0, sizeof(locations));
+
+    ASSERT_EQ(RID_SUCCESS, rid_location_batch_init(&batch, storage, sizeof(storage), 3));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_location_batch_decode(NULL, locations, 0, 3));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_location_batch_decode(&batch, NULL, 0, 3));
+    ASSERT_EQ(RID_ERROR_OUT_OF_RANGE, rid_location_batch_decode(&batch, locations, RID_MESSAGE_SIZE - 1, 3));
+    ASSERT_EQ(RID_ERROR_BUFFER_TOO_SMALL, rid_location_batch_decode(&batch, locations, 0, 4));
+    ASSERT_EQ(0, batch.count);
+
+    PASS();
+}
+
+TEST test_location_batch_kernel(void) {
+    const char *kernel = rid_location_batch_kernel();
+
+    ASSERT(
+        strcmp(kernel, "avx2") == 0 ||
+        strcmp(kernel, "sse2") == 0 ||
+        strcmp(kernel, "scalar") == 0
+    );
+
+    PASS();
+}
+
+SUITE(location_batch_suite) {
+    RUN_TEST(test_location_batch_init);
+    RUN_TEST(test_location_batch_init_unaligned);
+    RUN_TEST(test_location_batch_init_too_small);
+    RUN_TEST(test_location_batch_init_null_pointer);
+    RUN_TEST(test_location_batch_decode);
+    RUN_TEST(test_location_batch_decode_every_count);
+    RUN_TEST(test_location_batch_decode_west);
+    RUN_TEST(test_location_batch_decode_other_types);
+    RUN_TEST(test_location_batch_decode_stride);
+    RUN_TEST(test_location_batch_decode_errors);
+    RUN_TEST(test_location_batch_kernel);
+}
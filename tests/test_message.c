@@ -1,6 +1,7 @@
 #include <string.h>
 
 #include "greatest.h"
+#include "rid/auth_page.h"
 #include "rid/message.h"
 
 TEST test_get_message_type(void) {
@@ -81,6 +82,11 @@ TEST test_error_to_string(void) {
     ASSERT_STR_EQ("RID_ERROR_INVALID_UUID_VERSION", rid_error_to_string(RID_ERROR_INVALID_UUID_VERSION));
     ASSERT_STR_EQ("RID_ERROR_INVALID_UUID_VARIANT", rid_error_to_string(RID_ERROR_INVALID_UUID_VARIANT));
     ASSERT_STR_EQ("RID_ERROR_INVALID_UUID_PADDING", rid_error_to_string(RID_ERROR_INVALID_UUID_PADDING));
+    ASSERT_STR_EQ("RID_ERROR_WRITE_FAILED", rid_error_to_string(RID_ERROR_WRITE_FAILED));
+    ASSERT_STR_EQ("RID_ERROR_INVALID_SIGNATURE", rid_error_to_string(RID_ERROR_INVALID_SIGNATURE));
+    ASSERT_STR_EQ("RID_ERROR_INVALID_JSON", rid_error_to_string(RID_ERROR_INVALID_JSON));
+    ASSERT_STR_EQ("RID_ERROR_INVALID_CAPTURE", rid_error_to_string(RID_ERROR_INVALID_CAPTURE));
+    ASSERT_STR_EQ("RID_ERROR_READ_FAILED", rid_error_to_string(RID_ERROR_READ_FAILED));
     ASSERT_STR_EQ("UNKNOWN", rid_error_to_string((rid_error_t)99));
     PASS();
 }
@@ -97,6 +103,31 @@ TEST test_get_protocol_version_null_pointer(void) {
     PASS();
 }
 
+TEST test_message_validate_auth_page(void) {
+    rid_auth_page_0_t page_0;
+    rid_auth_page_x_t page_x;
+
+    rid_auth_page_0_init(&page_0);
+    rid_auth_page_x_init(&page_x, 1);
+    ASSERT_EQ(RID_SUCCESS, rid_message_validate(&page_0));
+    ASSERT_EQ(RID_SUCCESS, rid_message_validate(&page_x));
+
+    /* Length which does not fit in the pages up to the last page index. */
+    rid_auth_page_0_set_last_page_index(&page_0, 1);
+    rid_auth_page_0_set_length(&page_0, 41);
+    ASSERT_EQ(RID_ERROR_INVALID_LAST_PAGE_INDEX, rid_message_validate(&page_0));
+
+    /* Network Remote ID carries no signature. */
+    rid_auth_page_0_set_last_page_index(&page_0, 15);
+    rid_auth_page_0_set_type(&page_0, RID_AUTH_TYPE_NETWORK_REMOTE_ID);
+    ASSERT_EQ(RID_ERROR_NON_EMPTY_SIGNATURE, rid_message_validate(&page_0));
+
+    page_x.protocol_version = 3;
+    ASSERT_EQ(RID_ERROR_INVALID_PROTOCOL_VERSION, rid_message_validate(&page_x));
+
+    PASS();
+}
+
 SUITE(header_suite) {
     RUN_TEST(test_get_message_type);
     RUN_TEST(test_get_protocol_version);
@@ -105,4 +136,5 @@ SUITE(header_suite) {
     RUN_TEST(test_message_type_to_string);
     RUN_TEST(test_protocol_version_to_string);
     RUN_TEST(test_error_to_string);
+    RUN_TEST(test_message_validate_auth_page);
 }
@@ -1354,6 +1354,172 @@ TEST test_get_message_type_at_empty(void) {
     PASS();
 }
 
+TEST test_message_pack_view(void) {
+    rid_message_pack_t pack;
+    rid_basic_id_t basic_id;
+    rid_location_t location;
+    rid_auth_t auth;
+    rid_auth_t received;
+    rid_message_pack_view_t view;
+    uint8_t buffer[1 + RID_MESSAGE_PACK_MAX_SIZE];
+    uint8_t signature[20] = {1, 2, 3};
+    uint8_t index;
+
+    rid_message_pack_init(&pack);
+    rid_basic_id_init(&basic_id);
+    rid_location_init(&location);
+    rid_message_pack_add_message(&pack, &basic_id);
+    rid_message_pack_add_message(&pack, &location);
+    rid_auth_init(&auth);
+    rid_auth_set_signature(&auth, signature, sizeof(signature));
+    rid_message_pack_set_auth(&pack, &auth);
+
+    /* Unaligned, exactly as long as the pack. */
+    size_t size = rid_message_pack_size(&pack);
+    memcpy(&buffer[1], &pack, size);
+
+    ASSERT_EQ(RID_SUCCESS, rid_message_pack_view_init(&view, &buffer[1], size));
+    ASSERT_EQ(size, view.size);
+    ASSERT_EQ((const void *)&buffer[1], (const void *)view.pack);
+    ASSERT_EQ(4, rid_message_pack_message_count(view.pack));
+    ASSERT_EQ((const void *)&buffer[1 + RID_MESSAGE_PACK_HEADER_SIZE + RID_MESSAGE_SIZE], rid_message_pack_view_get_message_at(&view, 1));
+    ASSERT_EQ(NULL, rid_message_pack_view_get_message_at(&view, 4));
+    ASSERT_EQ(NULL, rid_message_pack_view_get_message_at(NULL, 0));
+
+    /* Existing accessors work on the view. */
+    ASSERT_EQ(RID_SUCCESS, rid_message_pack_validate(view.pack));
+    ASSERT_EQ(RID_SUCCESS, rid_message_pack_find_message_index_by_type(view.pack, RID_MESSAGE_TYPE_LOCATION, 0, &index));
+    ASSERT_EQ(1, index);
+    ASSERT_EQ(RID_SUCCESS, rid_message_pack_get_auth(view.pack, &received));
+    ASSERT_MEM_EQ(&auth, &received, 2 * RID_MESSAGE_SIZE);
+
+    PASS();
+}
+
+TEST test_message_pack_view_invalid(void) {
+    rid_message_pack_t pack;
+    rid_location_t location;
+    rid_message_pack_view_t view;
+
+    rid_message_pack_init(&pack);
+    rid_location_init(&location);
+    rid_message_pack_add_message(&pack, &location);
+    rid_message_pack_add_message(&pack, &location);
+
+    const uint8_t *data = (const uint8_t *)&pack;
+    size_t size = rid_message_pack_size(&pack);
+
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_message_pack_view_init(NULL, data, size));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_message_pack_view_init(&view, NULL, size));
+    ASSERT_EQ(RID_ERROR_INVALID_MESSAGE_SIZE, rid_message_pack_view_init(&view, data, 2));
+    ASSERT_EQ(RID_ERROR_INVALID_MESSAGE_SIZE, rid_message_pack_view_init(&view, data, size - 1));
+    ASSERT_EQ(RID_ERROR_INVALID_MESSAGE_TYPE, rid_message_pack_view_init(&view, (const uint8_t *)&location, RID_MESSAGE_SIZE));
+
+    /* Trailing bytes are ignored. */
+    ASSERT_EQ(RID_SUCCESS, rid_message_pack_view_init(&view, data, sizeof(pack)));
+    ASSERT_EQ(size, view.size);
+
+    pack.message_count = 10;
+    ASSERT_EQ(RID_ERROR_INVALID_MESSAGE_COUNT, rid_message_pack_view_init(&view, data, sizeof(pack)));
+
+    pack.message_count = 2;
+    pack.message_size = 24;
+    ASSERT_EQ(RID_ERROR_INVALID_MESSAGE_SIZE, rid_message_pack_view_init(&view, data, sizeof(pack)));
+
+    PASS();
+}
+
+TEST test_message_pack_index(void) {
+    rid_message_pack_t pack;
+    rid_message_pack_index_t index;
+    rid_basic_id_t basic_id;
+    rid_location_t location;
+    rid_auth_t auth;
+    rid_auth_t expected;
+    rid_auth_t received;
+    uint8_t signature[50] = {1, 2, 3};
+
+    rid_message_pack_init(&pack);
+    rid_basic_id_init(&basic_id);
+    rid_location_init(&location);
+    rid_message_pack_add_message(&pack, &basic_id);
+    rid_message_pack_add_message(&pack, &location);
+    rid_message_pack_add_message(&pack, &basic_id);
+    rid_auth_init(&auth);
+    rid_auth_set_signature(&auth, signature, sizeof(signature));
+    rid_message_pack_set_auth(&pack, &auth);
+
+    ASSERT_EQ(RID_SUCCESS, rid_message_pack_index_build(&index, &pack));
+    ASSERT_EQ((1 << RID_MESSAGE_TYPE_BASIC_ID) | (1 << RID_MESSAGE_TYPE_LOCATION) | (1 << RID_MESSAGE_TYPE_AUTH), index.present);
+
+    ASSERT_EQ(0, rid_message_pack_index_first(&index, RID_MESSAGE_TYPE_BASIC_ID));
+    ASSERT_EQ(2, rid_message_pack_index_next(&index, 0));
+    ASSERT_EQ(RID_MESSAGE_PACK_INDEX_NONE, rid_message_pack_index_next(&index, 2));
+    ASSERT_EQ(1, rid_message_pack_index_first(&index, RID_MESSAGE_TYPE_LOCATION));
+    ASSERT_EQ(RID_MESSAGE_PACK_INDEX_NONE, rid_message_pack_index_next(&index, 1));
+    ASSERT_EQ(3, rid_message_pack_index_first(&index, RID_MESSAGE_TYPE_AUTH));
+    ASSERT_EQ(4, rid_message_pack_index_next(&index, 3));
+    ASSERT_EQ(5, rid_message_pack_index_next(&index, 4));
+    ASSERT_EQ(RID_MESSAGE_PACK_INDEX_NONE, rid_message_pack_index_next(&index, 5));
+    ASSERT_EQ(RID_MESSAGE_PACK_INDEX_NONE, rid_message_pack_index_first(&index, RID_MESSAGE_TYPE_SYSTEM));
+    ASSERT_EQ(RID_MESSAGE_PACK_INDEX_NONE, rid_message_pack_index_first(NULL, RID_MESSAGE_TYPE_SYSTEM));
+    ASSERT_EQ(RID_MESSAGE_PACK_INDEX_NONE, rid_message_pack_index_next(&index, 9));
+
+    ASSERT_EQ(RID_SUCCESS, rid_message_pack_get_auth(&pack, &expected));
+    ASSERT_EQ(RID_SUCCESS, rid_message_pack_get_auth_indexed(&pack, &index, &received));
+    ASSERT_MEM_EQ(&expected, &received, sizeof(rid_auth_t));
+
+    rid_message_pack_delete_message_at(&pack, 5);
+    rid_message_pack_delete_message_at(&pack, 4);
+    rid_message_pack_delete_message_at(&pack, 3);
+    ASSERT_EQ(RID_SUCCESS, rid_message_pack_index_build(&index, &pack));
+    ASSERT_EQ(RID_ERROR_NOT_FOUND, rid_message_pack_get_auth_indexed(&pack, &index, &received));
+
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_message_pack_index_build(NULL, &pack));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_message_pack_index_build(&index, NULL));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_message_pack_get_auth_indexed(&pack, NULL, &received));
+    pack.message_count = 10;
+    ASSERT_EQ(RID_ERROR_INVALID_MESSAGE_COUNT, rid_message_pack_index_build(&index, &pack));
+
+    PASS();
+}
+
+TEST test_message_pack_set_auth_interleaved(void) {
+    rid_message_pack_t pack;
+    rid_basic_id_t basic_id;
+    rid_location_t location;
+    rid_system_t system;
+    rid_auth_t auth;
+    uint8_t signature[50] = {1, 2, 3};
+
+    rid_message_pack_init(&pack);
+    rid_basic_id_init(&basic_id);
+    rid_location_init(&location);
+    rid_system_init(&system);
+    rid_auth_init(&auth);
+    rid_auth_set_signature(&auth, signature, sizeof(signature));
+
+    /* Old pages scattered between the other messages. */
+    rid_message_pack_add_message(&pack, &basic_id);
+    memcpy(&pack.messages[1 * RID_MESSAGE_SIZE], &auth.page_0, RID_MESSAGE_SIZE);
+    memcpy(&pack.messages[2 * RID_MESSAGE_SIZE], &location, RID_MESSAGE_SIZE);
+    memcpy(&pack.messages[3 * RID_MESSAGE_SIZE], &auth.page_x[0], RID_MESSAGE_SIZE);
+    memcpy(&pack.messages[4 * RID_MESSAGE_SIZE], &auth.page_x[1], RID_MESSAGE_SIZE);
+    memcpy(&pack.messages[5 * RID_MESSAGE_SIZE], &system, RID_MESSAGE_SIZE);
+    pack.message_count = 6;
+
+    rid_auth_set_timestamp(&auth, 1000);
+    ASSERT_EQ(RID_SUCCESS, rid_message_pack_set_auth(&pack, &auth));
+    ASSERT_EQ(6, pack.message_count);
+    ASSERT_MEM_EQ(&basic_id, rid_message_pack_get_message_at(&pack, 0), RID_MESSAGE_SIZE);
+    ASSERT_MEM_EQ(&location, rid_message_pack_get_message_at(&pack, 1), RID_MESSAGE_SIZE);
+    ASSERT_MEM_EQ(&system, rid_message_pack_get_message_at(&pack, 2), RID_MESSAGE_SIZE);
+    ASSERT_MEM_EQ(&auth.page_0, rid_message_pack_get_message_at(&pack, 3), RID_MESSAGE_SIZE);
+    ASSERT_MEM_EQ(&auth.page_x[1], rid_message_pack_get_message_at(&pack, 5), RID_MESSAGE_SIZE);
+
+    PASS();
+}
+
 SUITE(message_pack_suite) {
     RUN_TEST(test_message_pack_init);
     RUN_TEST(test_message_pack_sizeof);
@@ -1433,4 +1599,8 @@ SUITE(message_pack_suite) {
     RUN_TEST(test_message_pack_to_json);
     RUN_TEST(test_message_pack_to_json_null);
     RUN_TEST(test_message_pack_to_json_needed);
+    RUN_TEST(test_message_pack_view);
+    RUN_TEST(test_message_pack_view_invalid);
+    RUN_TEST(test_message_pack_index);
+    RUN_TEST(test_message_pack_set_auth_interleaved);
 }
@@ -0,0 +1,180 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "greatest.h"
+#include "pack_fixture.h"
+#include "rid/message.h"
+#include "rid/message_pack.h"
+#include "rid/nan.h"
+#include "rid/transport.h"
+
+static const rid_address_t source = {{0x02, 0x11, 0x22, 0x33, 0x44, 0x55}};
+
+TEST test_nan_build(void) {
+    rid_message_pack_t pack;
+    uint8_t frame[RID_NAN_MAX_SIZE];
+    size_t written = 0;
+    size_t size;
+    const uint8_t header[] = {
+        0xD0, 0x00, 0x00, 0x00,
+        0x51, 0x6F, 0x9A, 0x01, 0x00, 0x00,
+        0x02, 0x11, 0x22, 0x33, 0x44, 0x55,
+        0x50, 0x6F, 0x9A, 0x01, 0x00, 0xFF,
+        0x00, 0x00,
+        0x04, 0x09, 0x50, 0x6F, 0x9A, 0x13,
+        0x03, 0x40, 0x00,
+        0x88, 0x69, 0x19, 0x9D, 0x92, 0x09,
+        0x01, 0x00, 0x10, 0x36,
+        0x2A,
+    };
+    const uint8_t trailer[] = {0x0E, 0x04, 0x00, 0x01, 0x00, 0x02, 0x2A};
+
+    pack_fixture_make(&pack, 2);
+    size = rid_message_pack_size(&pack);
+
+    ASSERT_EQ(RID_SUCCESS, rid_nan_build(&pack, 42, &source, frame, sizeof(frame), &written));
+    ASSERT_EQ(RID_NAN_HEADER_SIZE + size + RID_NAN_TRAILER_SIZE, written);
+    ASSERT_EQ(RID_NAN_HEADER_SIZE, sizeof(header));
+    ASSERT_MEM_EQ(header, frame, sizeof(header));
+    ASSERT_MEM_EQ(&pack, &frame[RID_NAN_HEADER_SIZE], size);
+    ASSERT_MEM_EQ(trailer, &frame[RID_NAN_HEADER_SIZE + size], sizeof(trailer));
+
+    ASSERT_EQ(RID_ERROR_BUFFER_TOO_SMALL, rid_nan_build(&pack, 42, &source, frame, written - 1, &written));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_nan_build(NULL, 42, &source, frame, sizeof(frame), &written));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_nan_build(&pack, 42, NULL, frame, sizeof(frame), &written));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_nan_build(&pack, 42, &source, NULL, 0, &written));
+
+    /* Largest pack fits the maximum size. */
+    for (uint8_t i = 2; i < RID_MESSAGE_PACK_MAX_MESSAGES; ++i) {
+        rid_message_pack_add_message(&pack, &pack.messages[RID_MESSAGE_SIZE]);
+    }
+    ASSERT_EQ(RID_SUCCESS, rid_nan_build(&pack, 0, &source, frame, sizeof(frame), &written));
+    ASSERT_EQ(RID_NAN_MAX_SIZE, written);
+
+    PASS();
+}
+
+TEST test_nan_parse(void) {
+    rid_message_pack_t pack;
+    rid_nan_frame_t result;
+    uint8_t frame[RID_NAN_MAX_SIZE + 16];
+    size_t written;
+
+    pack_fixture_make(&pack, 2);
+    ASSERT_EQ(RID_SUCCESS, rid_nan_build(&pack, 7, &source, frame, sizeof(frame), &written));
+
+    ASSERT_EQ(RID_SUCCESS, rid_nan_parse(frame, written, &result));
+    ASSERT_EQ(7, result.counter);
+    ASSERT_EQ(rid_message_pack_size(&pack), result.message_size);
+    ASSERT_EQ(&frame[RID_NAN_HEADER_SIZE], result.message);
+    ASSERT_MEM_EQ(&source, &result.source, sizeof(source));
+
+    /* Trailing FCS is ignored. */
+    memset(&frame[written], 0xA5, 4);
+    ASSERT_EQ(RID_SUCCESS, rid_nan_parse(frame, written + 4, &result));
+
+    /* Service specific info only, as returned by platform APIs. */
+    ASSERT_EQ(RID_SUCCESS, rid_nan_parse_service_info(&frame[RID_NAN_HEADER_SIZE - 1], result.message_size + 1, &result));
+    ASSERT_EQ(7, result.counter);
+    ASSERT_EQ(&frame[RID_NAN_HEADER_SIZE], result.message);
+
+    PASS();
+}
+
+TEST test_nan_parse_other_attributes(void) {
+    rid_message_pack_t pack;
+    rid_nan_frame_t result;
+    uint8_t built[RID_NAN_MAX_SIZE];
+    uint8_t frame[RID_NAN_MAX_SIZE + 32];
+    size_t written;
+    /* Device Capability followed by another service. */
+    const uint8_t attributes[] = {
+        0x0F, 0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x03, 0x0A, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x02, 0x00, 0x10, 0x00,
+    };
+
+    pack_fixture_make(&pack, 2);
+    ASSERT_EQ(RID_SUCCESS, rid_nan_build(&pack, 9, &source, built, sizeof(built), &written));
+
+    memcpy(frame, built, 30);
+    memcpy(&frame[30], attributes, sizeof(attributes));
+    memcpy(&frame[30 + sizeof(attributes)], &built[30], written - 30);
+
+    ASSERT_EQ(RID_SUCCESS, rid_nan_parse(frame, written + sizeof(attributes), &result));
+    ASSERT_EQ(9, result.counter);
+    ASSERT_MEM_EQ(&pack, result.message, result.message_size);
+
+    /* Only the other attributes. */
+    ASSERT_EQ(RID_ERROR_NOT_FOUND, rid_nan_parse(frame, 30 + sizeof(attributes), &result));
+
+    PASS();
+}
+
+TEST test_nan_not_remote_id(void) {
+    rid_message_pack_t pack;
+    rid_nan_frame_t result;
+    uint8_t built[RID_NAN_MAX_SIZE];
+    uint8_t frame[RID_NAN_MAX_SIZE];
+    size_t written;
+
+    pack_fixture_make(&pack, 2);
+    ASSERT_EQ(RID_SUCCESS, rid_nan_build(&pack, 1, &source, built, sizeof(built), &written));
+
+    /* Beacon instead of action frame. */
+    memcpy(frame, built, written);
+    frame[0] = 0x80;
+    ASSERT_EQ(RID_ERROR_NOT_FOUND, rid_nan_parse(frame, written, &result));
+
+    /* Wi-Fi Direct instead of NAN. */
+    memcpy(frame, built, written);
+    frame[29] = 0x09;
+    ASSERT_EQ(RID_ERROR_NOT_FOUND, rid_nan_parse(frame, written, &result));
+
+    /* Some other service. */
+    memcpy(frame, built, written);
+    frame[33] = 0x00;
+    ASSERT_EQ(RID_ERROR_NOT_FOUND, rid_nan_parse(frame, written, &result));
+
+    /* Service info not present. */
+    memcpy(frame, built, written);
+    frame[41] = 0x00;
+    ASSERT_EQ(RID_ERROR_NOT_FOUND, rid_nan_parse(frame, written, &result));
+
+    /* Single message instead of a pack. */
+    memcpy(frame, built, written);
+    frame[RID_NAN_HEADER_SIZE] = 0x22;
+    ASSERT_EQ(RID_ERROR_INVALID_MESSAGE_TYPE, rid_nan_parse(frame, written, &result));
+
+    /* Service info length shorter than the pack. */
+    memcpy(frame, built, written);
+    frame[42] = 10;
+    ASSERT_EQ(RID_ERROR_INVALID_MESSAGE_SIZE, rid_nan_parse(frame, written, &result));
+
+    /* Service info length longer than the attribute. */
+    memcpy(frame, built, written);
+    frame[42] = 0xFF;
+    ASSERT_EQ(RID_ERROR_INVALID_MESSAGE_SIZE, rid_nan_parse(frame, written, &result));
+
+    /* Too many messages. */
+    memcpy(frame, built, written);
+    frame[RID_NAN_HEADER_SIZE + 2] = RID_MESSAGE_PACK_MAX_MESSAGES + 1;
+    ASSERT_EQ(RID_ERROR_INVALID_MESSAGE_COUNT, rid_nan_parse(frame, written, &result));
+
+    /* Truncated inside the attribute. */
+    ASSERT_EQ(RID_ERROR_NOT_FOUND, rid_nan_parse(built, written - 10, &result));
+    ASSERT_EQ(RID_ERROR_NOT_FOUND, rid_nan_parse(built, 29, &result));
+
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_nan_parse(NULL, 0, &result));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_nan_parse(built, written, NULL));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_nan_parse_service_info(NULL, 0, &result));
+    ASSERT_EQ(RID_ERROR_INVALID_MESSAGE_SIZE, rid_nan_parse_service_info(built, 3, &result));
+
+    PASS();
+}
+
+SUITE(nan_suite) {
+    RUN_TEST(test_nan_build);
+    RUN_TEST(test_nan_parse);
+    RUN_TEST(test_nan_parse_other_attributes);
+    RUN_TEST(test_nan_not_remote_id);
+}
@@ -0,0 +1,220 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "greatest.h"
+#include "rid/basic_id.h"
+#include "rid/json.h"
+#include "rid/location.h"
+#include "rid/message.h"
+#include "rid/message_pack.h"
+#include "rid/ndjson.h"
+#include "rid/system.h"
+#include "rid/transport.h"
+
+typedef struct {
+    char *data;
+    size_t length;
+    size_t capacity;
+} growing_buffer_t;
+
+static int growing_write(void *context, const char *data, size_t length) {
+    growing_buffer_t *output = (growing_buffer_t *)context;
+
+    if (output->length + length + 1 > output->capacity) {
+        size_t capacity = (output->length + length + 1) * 2;
+        char *grown = realloc(output->data, capacity);
+        if (grown == NULL) {
+            return RID_ERROR_WRITE_FAILED;
+        }
+        output->data = grown;
+        output->capacity = capacity;
+    }
+    memcpy(output->data + output->length, data, length);
+    output->length += length;
+    output->data[output->length] = '\0';
+
+    return 0;
+}
+
+static int starts_with(const char *string, const char *prefix) {
+    return strncmp(string, prefix, strlen(prefix)) == 0;
+}
+
+static void fill_messages(rid_message_t *messages) {
+    rid_basic_id_t *basic_id = (rid_basic_id_t *)&messages[0];
+    rid_location_t *location = (rid_location_t *)&messages[1];
+    rid_system_t *system = (rid_system_t *)&messages[2];
+
+    rid_basic_id_init(basic_id);
+    rid_basic_id_set_uas_id(basic_id, "1596F3A4C8D2E7B9");
+    rid_location_init(location);
+    rid_location_set_latitude(location, 60.1699);
+    rid_location_set_longitude(location, 24.9384);
+    rid_system_init(system);
+}
+
+TEST test_ndjson_lines(void) {
+    rid_message_t messages[3];
+    char expected[2048] = "";
+    char actual[2048];
+    size_t needed = 0;
+
+    fill_messages(messages);
+    for (size_t i = 0; i < 3; ++i) {
+        char line[1024];
+        ASSERT_EQ(RID_SUCCESS, rid_message_to_json(&messages[i], line, sizeof(line), NULL));
+        strcat(expected, line);
+        strcat(expected, "\n");
+    }
+
+    ASSERT_EQ(RID_SUCCESS, rid_messages_to_ndjson(messages, 0, 3, NULL, NULL, actual, sizeof(actual), &needed));
+    ASSERT_STR_EQ(expected, actual);
+    ASSERT_EQ(strlen(expected) + 1, needed);
+
+    PASS();
+}
+
+TEST test_ndjson_wrapped(void) {
+    rid_message_t messages[3];
+    uint64_t timestamps[3] = {0, 1760000000123ULL, UINT64_MAX};
+    rid_address_t sources[3] = {
+        {{0x00, 0x11, 0x22, 0x33, 0x44, 0x55}},
+        {{0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF}},
+        {{0x02, 0x00, 0x00, 0x00, 0x00, 0x01}},
+    };
+    char actual[4096];
+    char line[1024];
+    char *p;
+
+    fill_messages(messages);
+    ASSERT_EQ(RID_SUCCESS, rid_messages_to_ndjson(messages, 0, 3, timestamps, sources, actual, sizeof(actual), NULL));
+
+    p = strstr(actual, "\n{\"received\":1760000000123,\"source\":\"aa:bb:cc:dd:ee:ff\",\"message\":{");
+    ASSERT(p != NULL);
+    ASSERT_EQ(RID_SUCCESS, rid_message_to_json(&messages[1], line, sizeof(line), NULL));
+    ASSERT_EQ(0, strncmp(p + strlen("\n{\"received\":1760000000123,\"source\":\"aa:bb:cc:dd:ee:ff\",\"message\":"), line, strlen(line)));
+    ASSERT(starts_with(actual, "{\"received\":0,\"source\":\"00:11:22:33:44:55\",\"message\":{"));
+    ASSERT(strstr(actual, "{\"received\":18446744073709551615,\"source\":\"02:00:00:00:00:01\",") != NULL);
+
+    ASSERT_EQ(RID_SUCCESS, rid_messages_to_ndjson(messages, 0, 1, NULL, sources, actual, sizeof(actual), NULL));
+    ASSERT(starts_with(actual, "{\"source\":\"00:11:22:33:44:55\",\"message\":{\"protocol_version\""));
+    ASSERT_STR_EQ("}}\n", actual + strlen(actual) - 3);
+
+    PASS();
+}
+
+TEST test_ndjson_message_pack_stride(void) {
+    rid_message_t messages[3];
+    rid_message_pack_t packs[2];
+    char expected[2048];
+    char actual[4096];
+
+    fill_messages(messages);
+    for (size_t i = 0; i < 2; ++i) {
+        rid_message_pack_init(&packs[i]);
+        rid_message_pack_add_message(&packs[i], &messages[0]);
+        rid_message_pack_add_message(&packs[i], &messages[1]);
+    }
+
+    ASSERT_EQ(RID_SUCCESS, rid_message_pack_to_json(&packs[0], expected, sizeof(expected) - 1, NULL));
+    strcat(expected, "\n");
+    ASSERT_EQ(RID_SUCCESS, rid_messages_to_ndjson(packs, sizeof(rid_message_pack_t), 1, NULL, NULL, actual, sizeof(actual), NULL));
+    ASSERT_STR_EQ(expected, actual);
+
+    /* Pack does not fit in a 25 byte stride. */
+    ASSERT_EQ(RID_SUCCESS, rid_messages_to_ndjson(&packs[0], 0, 1, NULL, NULL, actual, sizeof(actual), NULL));
+    ASSERT_STR_EQ("{\"protocol_version\":2,\"message_type\":15}\n", actual);
+
+    PASS();
+}
+
+TEST test_ndjson_buffer_too_small(void) {
+    rid_message_t messages[3];
+    char expected[4096];
+    char actual[64];
+    size_t needed = 0;
+    size_t query = 0;
+
+    fill_messages(messages);
+
+    ASSERT_EQ(RID_SUCCESS, rid_messages_to_ndjson(messages, 0, 3, NULL, NULL, NULL, 0, &query));
+    ASSERT_EQ(RID_SUCCESS, rid_messages_to_ndjson(messages, 0, 3, NULL, NULL, expected, sizeof(expected), NULL));
+    ASSERT_EQ(strlen(expected) + 1, query);
+
+    ASSERT_EQ(RID_ERROR_BUFFER_TOO_SMALL, rid_messages_to_ndjson(messages, 0, 3, NULL, NULL, actual, sizeof(actual), &needed));
+    ASSERT_EQ(query, needed);
+    ASSERT_EQ(sizeof(actual) - 1, strlen(actual));
+    ASSERT_EQ(0, strncmp(expected, actual, sizeof(actual) - 1));
+
+    PASS();
+}
+
+TEST test_ndjson_empty(void) {
+    rid_message_t messages[1] = {{0}};
+    char actual[16] = "garbage";
+    size_t needed = 0;
+
+    ASSERT_EQ(RID_SUCCESS, rid_messages_to_ndjson(messages, 0, 0, NULL, NULL, actual, sizeof(actual), &needed));
+    ASSERT_STR_EQ("", actual);
+    ASSERT_EQ(1, needed);
+
+    PASS();
+}
+
+TEST test_ndjson_sink(void) {
+    rid_message_t messages[300];
+    uint64_t timestamps[300];
+    rid_address_t sources[300];
+    growing_buffer_t output = {NULL, 0, 0};
+    rid_json_sink_t sink;
+    static char expected[262144];
+    size_t needed = 0;
+
+    for (size_t i = 0; i < 300; i += 3) {
+        fill_messages(&messages[i]);
+    }
+    for (size_t i = 0; i < 300; ++i) {
+        rid_address_t address = {{0x02, 0x00, 0x00, 0x00, (uint8_t)(i >> 8), (uint8_t)i}};
+        timestamps[i] = 1760000000000ULL + i * 100;
+        sources[i] = address;
+    }
+
+    ASSERT_EQ(RID_SUCCESS, rid_messages_to_ndjson(messages, 0, 300, timestamps, sources, expected, sizeof(expected), &needed));
+
+    rid_json_sink_init(&sink, growing_write, &output);
+    ASSERT_EQ(RID_SUCCESS, rid_messages_to_ndjson_sink(messages, 0, 300, timestamps, sources, &sink));
+    ASSERT(output.data != NULL);
+    ASSERT_EQ(needed - 1, output.length);
+    ASSERT_EQ(0, memcmp(expected, output.data, output.length));
+
+    free(output.data);
+
+    PASS();
+}
+
+TEST test_ndjson_errors(void) {
+    rid_message_t messages[1];
+    rid_json_sink_t sink = {NULL, NULL};
+    char actual[16];
+    size_t needed;
+
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_messages_to_ndjson(NULL, 0, 1, NULL, NULL, actual, sizeof(actual), &needed));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_messages_to_ndjson(messages, 0, 1, NULL, NULL, NULL, 0, NULL));
+    ASSERT_EQ(RID_ERROR_OUT_OF_RANGE, rid_messages_to_ndjson(messages, 24, 1, NULL, NULL, actual, sizeof(actual), &needed));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_messages_to_ndjson_sink(messages, 0, 1, NULL, NULL, NULL));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_messages_to_ndjson_sink(messages, 0, 1, NULL, NULL, &sink));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_messages_to_ndjson_sink(NULL, 0, 1, NULL, NULL, &sink));
+
+    PASS();
+}
+
+SUITE(ndjson_suite) {
+    RUN_TEST(test_ndjson_lines);
+    RUN_TEST(test_ndjson_wrapped);
+    RUN_TEST(test_ndjson_message_pack_stride);
+    RUN_TEST(test_ndjson_buffer_too_small);
+    RUN_TEST(test_ndjson_empty);
+    RUN_TEST(test_ndjson_sink);
+    RUN_TEST(test_ndjson_errors);
+}
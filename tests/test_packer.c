@@ -0,0 +1,183 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "greatest.h"
+#include "rid/auth.h"
+#include "rid/basic_id.h"
+#include "rid/location.h"
+#include "rid/message.h"
+#include "rid/message_pack.h"
+#include "rid/operator_id.h"
+#include "rid/packer.h"
+#include "rid/self_id.h"
+#include "rid/system.h"
+#include "rid/transport.h"
+
+static int contains(const rid_message_pack_t *pack, const void *message) {
+    for (uint8_t i = 0; i < pack->message_count; ++i) {
+        if (memcmp(rid_message_pack_get_message_at(pack, i), message, RID_MESSAGE_SIZE) == 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+TEST test_packer_init(void) {
+    rid_packer_t packer;
+
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_packer_init(NULL, RID_TRANSPORT_WIFI_NAN));
+    ASSERT_EQ(RID_ERROR_OUT_OF_RANGE, rid_packer_init(&packer, RID_TRANSPORT_BLUETOOTH_LEGACY));
+    ASSERT_EQ(RID_ERROR_OUT_OF_RANGE, rid_packer_init(&packer, (rid_transport_t)99));
+
+    ASSERT_EQ(RID_SUCCESS, rid_packer_init(&packer, RID_TRANSPORT_WIFI_BEACON));
+    ASSERT_EQ(9, rid_packer_get_capacity(&packer));
+    ASSERT_EQ(RID_SUCCESS, rid_packer_init(&packer, RID_TRANSPORT_BLUETOOTH_LONG_RANGE));
+    ASSERT_EQ(9, rid_packer_get_capacity(&packer));
+
+    ASSERT_EQ(RID_SUCCESS, rid_packer_set_auth_pages(&packer, 3));
+    ASSERT_EQ(6, rid_packer_get_capacity(&packer));
+    ASSERT_EQ(RID_ERROR_OUT_OF_RANGE, rid_packer_set_auth_pages(&packer, 9));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_packer_set_auth_pages(NULL, 1));
+    ASSERT_EQ(0, rid_packer_get_capacity(NULL));
+    ASSERT_EQ(0, rid_packer_pending(NULL));
+
+    PASS();
+}
+
+TEST test_packer_add_message(void) {
+    rid_packer_t packer;
+    rid_basic_id_t serial;
+    rid_basic_id_t registration;
+    rid_location_t location;
+    rid_message_pack_t pack;
+    rid_auth_t auth;
+
+    rid_packer_init(&packer, RID_TRANSPORT_WIFI_NAN);
+    rid_basic_id_init(&serial);
+    rid_basic_id_set_type(&serial, RID_ID_TYPE_SERIAL_NUMBER);
+    rid_basic_id_init(&registration);
+    rid_basic_id_set_type(&registration, RID_ID_TYPE_CAA_REGISTRATION_ID);
+    rid_location_init(&location);
+    rid_message_pack_init(&pack);
+    rid_auth_init(&auth);
+
+    ASSERT_EQ(RID_SUCCESS, rid_packer_add_message(&packer, &serial, 1, 0));
+    ASSERT_EQ(RID_SUCCESS, rid_packer_add_message(&packer, &registration, 1, 0));
+    ASSERT_EQ(RID_SUCCESS, rid_packer_add_message(&packer, &location, 2, 0));
+    ASSERT_EQ(3, rid_packer_pending(&packer));
+
+    /* Same type and ID type is replaced. */
+    rid_location_set_latitude(&location, 60.1699);
+    ASSERT_EQ(RID_SUCCESS, rid_packer_add_message(&packer, &location, 2, 1));
+    rid_basic_id_set_uas_id(&serial, "1ABCD2345EF678XYZ");
+    ASSERT_EQ(RID_SUCCESS, rid_packer_add_message(&packer, &serial, 1, 1));
+    ASSERT_EQ(3, rid_packer_pending(&packer));
+
+    ASSERT_EQ(3, rid_packer_build(&packer, &pack, 1));
+    ASSERT(contains(&pack, &serial));
+    ASSERT(contains(&pack, &registration));
+    ASSERT(contains(&pack, &location));
+    ASSERT_EQ(0, rid_packer_pending(&packer));
+
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_packer_add_message(NULL, &location, 0, 0));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_packer_add_message(&packer, NULL, 0, 0));
+    ASSERT_EQ(RID_ERROR_INVALID_MESSAGE_TYPE, rid_packer_add_message(&packer, &auth.page_0, 0, 0));
+    ASSERT_EQ(RID_ERROR_INVALID_MESSAGE_TYPE, rid_packer_add_message(&packer, &pack, 0, 0));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_packer_build(&packer, NULL, 0));
+
+    /* Pool is full once every ID type and message type is in. */
+    for (uint8_t i = 0; i < RID_PACKER_MAX_MESSAGES; ++i) {
+        serial.id_type = i;
+        rid_packer_add_message(&packer, &serial, 0, 0);
+    }
+    ASSERT_EQ(RID_PACKER_MAX_MESSAGES, packer.count);
+    rid_self_id_t self_id;
+    rid_self_id_init(&self_id);
+    ASSERT_EQ(RID_ERROR_BUFFER_TOO_SMALL, rid_packer_add_message(&packer, &self_id, 0, 0));
+
+    ASSERT_EQ(RID_SUCCESS, rid_packer_clear(&packer));
+    ASSERT_EQ(RID_ERROR_NOT_FOUND, rid_packer_build(&packer, &pack, 0));
+
+    PASS();
+}
+
+TEST test_packer_build_order(void) {
+    rid_packer_t packer;
+    rid_basic_id_t basic_id;
+    rid_location_t location;
+    rid_system_t system;
+    rid_self_id_t self_id;
+    rid_operator_id_t operator_id;
+    rid_message_pack_t pack;
+    rid_auth_t auth;
+    uint8_t signature[64] = {0};
+
+    rid_packer_init(&packer, RID_TRANSPORT_WIFI_BEACON);
+    rid_auth_init(&auth);
+    rid_auth_set_signature(&auth, signature, sizeof(signature));
+    ASSERT_EQ(RID_SUCCESS, rid_packer_set_auth_pages(&packer, 6));
+    ASSERT_EQ(3, rid_packer_get_capacity(&packer));
+
+    rid_basic_id_init(&basic_id);
+    rid_location_init(&location);
+    rid_system_init(&system);
+    rid_self_id_init(&self_id);
+    rid_operator_id_init(&operator_id);
+
+    rid_packer_add_message(&packer, &basic_id, 1, 10);
+    rid_packer_add_message(&packer, &self_id, 1, 11);
+    rid_packer_add_message(&packer, &operator_id, 1, 12);
+    rid_packer_add_message(&packer, &system, 2, 13);
+    rid_packer_add_message(&packer, &location, 3, 14);
+
+    /* Highest priority first, then the oldest update. */
+    ASSERT_EQ(3, rid_packer_build(&packer, &pack, 100));
+    ASSERT_MEM_EQ(&basic_id, rid_message_pack_get_message_at(&pack, 0), RID_MESSAGE_SIZE);
+    ASSERT_MEM_EQ(&location, rid_message_pack_get_message_at(&pack, 1), RID_MESSAGE_SIZE);
+    ASSERT_MEM_EQ(&system, rid_message_pack_get_message_at(&pack, 2), RID_MESSAGE_SIZE);
+    ASSERT_EQ(2, rid_packer_pending(&packer));
+
+    /* Pending ones go first, the frame is filled with the rest. */
+    ASSERT_EQ(3, rid_packer_build(&packer, &pack, 200));
+    ASSERT(contains(&pack, &self_id));
+    ASSERT(contains(&pack, &operator_id));
+    ASSERT(contains(&pack, &location));
+    ASSERT_EQ(0, rid_packer_pending(&packer));
+
+    /* Reserved room is enough for signing. */
+    ASSERT_EQ(RID_SUCCESS, rid_packer_set_auth_pages(&packer, rid_auth_get_page_count(&auth)));
+    ASSERT_EQ(RID_MESSAGE_PACK_MAX_MESSAGES - rid_auth_get_page_count(&auth), rid_packer_build(&packer, &pack, 300));
+    ASSERT_EQ(RID_SUCCESS, rid_message_pack_set_auth(&pack, &auth));
+    ASSERT_EQ(RID_MESSAGE_PACK_MAX_MESSAGES, pack.message_count);
+    ASSERT(rid_message_pack_size(&pack) <= RID_TRANSPORT_WIFI_BEACON_MAX_PAYLOAD);
+
+    PASS();
+}
+
+TEST test_packer_expire(void) {
+    rid_packer_t packer;
+    rid_location_t location;
+    rid_system_t system;
+
+    rid_packer_init(&packer, RID_TRANSPORT_WIFI_NAN);
+    rid_location_init(&location);
+    rid_system_init(&system);
+
+    rid_packer_add_message(&packer, &system, 0, 100);
+    rid_packer_add_message(&packer, &location, 0, 200);
+
+    ASSERT_EQ(0, rid_packer_expire(&packer, 100));
+    ASSERT_EQ(1, rid_packer_expire(&packer, 150));
+    ASSERT_EQ(1, packer.count);
+    ASSERT_MEM_EQ(&location, &packer.entries[0].message, RID_MESSAGE_SIZE);
+    ASSERT_EQ(0, rid_packer_expire(NULL, 150));
+
+    PASS();
+}
+
+SUITE(packer_suite) {
+    RUN_TEST(test_packer_init);
+    RUN_TEST(test_packer_add_message);
+    RUN_TEST(test_packer_build_order);
+    RUN_TEST(test_packer_expire);
+}
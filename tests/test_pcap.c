@@ -0,0 +1,485 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "greatest.h"
+#include "pack_fixture.h"
+#include "rid/beacon.h"
+#include "rid/bluetooth.h"
+#include "rid/location.h"
+#include "rid/message.h"
+#include "rid/message_pack.h"
+#include "rid/nan.h"
+#include "rid/pcap.h"
+#include "rid/transport.h"
+
+typedef struct {
+    uint8_t data[65536];
+    size_t size;
+    int big_endian;
+} capture_t;
+
+/* Radio information before the link layer packet. */
+#define BLE_PSEUDO_HEADER_SIZE 10
+
+static const rid_address_t wifi_source = {{0x02, 0x11, 0x22, 0x33, 0x44, 0x55}};
+static const rid_address_t ble_source = {{0xC0, 0xFF, 0xEE, 0x00, 0x00, 0x01}};
+
+static void put(capture_t *capture, const void *data, size_t size) {
+    memcpy(&capture->data[capture->size], data, size);
+    capture->size += size;
+}
+
+static void put8(capture_t *capture, uint8_t value) {
+    capture->data[capture->size++] = value;
+}
+
+static void put16(capture_t *capture, uint16_t value) {
+    if (capture->big_endian) {
+        put8(capture, (uint8_t)(value >> 8));
+        put8(capture, (uint8_t)value);
+    } else {
+        put8(capture, (uint8_t)value);
+        put8(capture, (uint8_t)(value >> 8));
+    }
+}
+
+static void put32(capture_t *capture, uint32_t value) {
+    if (capture->big_endian) {
+        put16(capture, (uint16_t)(value >> 16));
+        put16(capture, (uint16_t)value);
+    } else {
+        put16(capture, (uint16_t)value);
+        put16(capture, (uint16_t)(value >> 16));
+    }
+}
+
+static void pcap_header(capture_t *capture, uint32_t magic, uint32_t link_type) {
+    capture->size = 0;
+    put32(capture, magic);
+    put16(capture, 2);
+    put16(capture, 4);
+    put32(capture, 0);
+    put32(capture, 0);
+    put32(capture, 65535);
+    put32(capture, link_type);
+}
+
+static void pcap_record(capture_t *capture, uint32_t seconds, uint32_t fraction, const uint8_t *data, size_t size) {
+    put32(capture, seconds);
+    put32(capture, fraction);
+    put32(capture, (uint32_t)size);
+    put32(capture, (uint32_t)size);
+    put(capture, data, size);
+}
+
+static void pcapng_section(capture_t *capture) {
+    put32(capture, 0x0A0D0D0A);
+    put32(capture, 28);
+    put32(capture, 0x1A2B3C4D);
+    put16(capture, 1);
+    put16(capture, 0);
+    put32(capture, 0xFFFFFFFF);
+    put32(capture, 0xFFFFFFFF);
+    put32(capture, 28);
+}
+
+static void pcapng_interface(capture_t *capture, uint16_t link_type, int resolution) {
+    uint32_t size = resolution < 0 ? 20 : 32;
+
+    put32(capture, 1);
+    put32(capture, size);
+    put16(capture, link_type);
+    put16(capture, 0);
+    put32(capture, 0);
+    if (resolution >= 0) {
+        put16(capture, 9);
+        put16(capture, 1);
+        put8(capture, (uint8_t)resolution);
+        put8(capture, 0);
+        put16(capture, 0);
+        put32(capture, 0);
+    }
+    put32(capture, size);
+}
+
+static void pcapng_packet(capture_t *capture, uint32_t interface, uint64_t timestamp, const uint8_t *data, size_t size) {
+    uint32_t padded = (uint32_t)((size + 3) & ~(size_t)3);
+    const uint8_t zero[4] = {0};
+
+    put32(capture, 6);
+    put32(capture, 32 + padded);
+    put32(capture, interface);
+    put32(capture, (uint32_t)(timestamp >> 32));
+    put32(capture, (uint32_t)timestamp);
+    put32(capture, (uint32_t)size);
+    put32(capture, (uint32_t)size);
+    put(capture, data, size);
+    put(capture, zero, padded - size);
+    put32(capture, 32 + padded);
+}
+
+/* Radiotap header without fields. */
+static size_t radiotap(uint8_t *buffer) {
+    const uint8_t header[] = {0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00};
+
+    memcpy(buffer, header, sizeof(header));
+    return sizeof(header);
+}
+
+static size_t beacon_frame(uint8_t *buffer, const rid_message_pack_t *pack, uint8_t counter) {
+    const uint8_t fixed[] = {
+        0x80, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0x02, 0x11, 0x22, 0x33, 0x44, 0x55, 0x02, 0x11, 0x22, 0x33, 0x44, 0x55, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x64, 0x00, 0x21, 0x04,
+        0x00, 0x03, 'R', 'I', 'D',
+    };
+    size_t written = 0;
+
+    memcpy(buffer, fixed, sizeof(fixed));
+    if (pack != NULL) {
+        rid_beacon_build(pack, counter, &buffer[sizeof(fixed)], RID_BEACON_MAX_SIZE, &written);
+    }
+    return sizeof(fixed) + written;
+}
+
+/* Legacy non connectable advertisement with access address and CRC. */
+static size_t ble_legacy(uint8_t *buffer, const void *message, uint8_t counter) {
+    size_t written = 0;
+
+    buffer[0] = 0xD6;
+    buffer[1] = 0xBE;
+    buffer[2] = 0x89;
+    buffer[3] = 0x8E;
+    buffer[4] = 0x42;
+    memcpy(&buffer[6], ble_source.octets, RID_ADDRESS_SIZE);
+    rid_bluetooth_build(message, counter, &buffer[12], RID_BLUETOOTH_LEGACY_SIZE, &written);
+    buffer[5] = (uint8_t)(RID_ADDRESS_SIZE + written);
+    memset(&buffer[12 + written], 0xAA, 3);
+    return 12 + written + 3;
+}
+
+/* AUX_ADV_IND with AdvA and ADI in the extended header. */
+static size_t ble_extended(uint8_t *buffer, const rid_message_pack_t *pack, uint8_t counter) {
+    size_t written = 0;
+
+    buffer[0] = 0xD6;
+    buffer[1] = 0xBE;
+    buffer[2] = 0x89;
+    buffer[3] = 0x8E;
+    buffer[4] = 0x07;
+    buffer[6] = 0x09;
+    buffer[7] = 0x09;
+    memcpy(&buffer[8], ble_source.octets, RID_ADDRESS_SIZE);
+    buffer[14] = 0x01;
+    buffer[15] = 0x20;
+    rid_bluetooth_build(pack, counter, &buffer[16], RID_BLUETOOTH_MAX_SIZE, &written);
+    buffer[5] = (uint8_t)(10 + written);
+    memset(&buffer[16 + written], 0xAA, 3);
+    return 16 + written + 3;
+}
+
+TEST test_pcap_radiotap(void) {
+    static capture_t capture;
+    rid_message_pack_t pack;
+    rid_pcap_reader_t reader;
+    rid_pcap_record_t record;
+    uint8_t frame[512];
+    size_t size;
+
+    pack_fixture_make(&pack, 2);
+    capture.big_endian = 0;
+    pcap_header(&capture, 0xA1B2C3D4, RID_PCAP_LINKTYPE_IEEE802_11_RADIOTAP);
+
+    size = radiotap(frame);
+    size += beacon_frame(&frame[size], NULL, 0);
+    pcap_record(&capture, 1760000000, 1, frame, size);
+
+    size = radiotap(frame);
+    size += beacon_frame(&frame[size], &pack, 5);
+    pcap_record(&capture, 1760000000, 2, frame, size);
+
+    size = radiotap(frame);
+    rid_nan_build(&pack, 6, &wifi_source, &frame[size], sizeof(frame) - size, &size);
+    size += 8;
+    pcap_record(&capture, 1760000001, 999999, frame, size);
+
+    ASSERT_EQ(RID_SUCCESS, rid_pcap_reader_init(&reader, capture.data, capture.size));
+
+    ASSERT_EQ(RID_SUCCESS, rid_pcap_reader_next(&reader, &record));
+    ASSERT_EQ(RID_TRANSPORT_WIFI_BEACON, record.transport);
+    ASSERT_EQ(1760000000000002ULL, record.timestamp);
+    ASSERT_EQ(5, record.counter);
+    ASSERT_EQ(rid_message_pack_size(&pack), record.message_size);
+    ASSERT_MEM_EQ(&pack, record.message, record.message_size);
+    ASSERT_MEM_EQ(&wifi_source, &record.source, sizeof(wifi_source));
+    ASSERT(record.message > capture.data && record.message < capture.data + capture.size);
+
+    ASSERT_EQ(RID_SUCCESS, rid_pcap_reader_next(&reader, &record));
+    ASSERT_EQ(RID_TRANSPORT_WIFI_NAN, record.transport);
+    ASSERT_EQ(1760000001999999ULL, record.timestamp);
+    ASSERT_EQ(6, record.counter);
+    ASSERT_MEM_EQ(&pack, record.message, record.message_size);
+    ASSERT_MEM_EQ(&wifi_source, &record.source, sizeof(wifi_source));
+
+    ASSERT_EQ(RID_ERROR_NOT_FOUND, rid_pcap_reader_next(&reader, &record));
+    ASSERT_EQ(RID_ERROR_NOT_FOUND, rid_pcap_reader_next(&reader, &record));
+
+    PASS();
+}
+
+TEST test_pcap_big_endian_nanoseconds(void) {
+    static capture_t capture;
+    rid_message_pack_t pack;
+    rid_pcap_reader_t reader;
+    rid_pcap_record_t record;
+    uint8_t frame[512];
+    size_t size;
+
+    pack_fixture_make(&pack, 2);
+    capture.big_endian = 1;
+    pcap_header(&capture, 0xA1B23C4D, RID_PCAP_LINKTYPE_IEEE802_11);
+
+    size = beacon_frame(frame, &pack, 9);
+    pcap_record(&capture, 1760000000, 123456789, frame, size);
+
+    ASSERT_EQ(RID_SUCCESS, rid_pcap_reader_init(&reader, capture.data, capture.size));
+    ASSERT_EQ(RID_SUCCESS, rid_pcap_reader_next(&reader, &record));
+    ASSERT_EQ(1760000000123456ULL, record.timestamp);
+    ASSERT_EQ(9, record.counter);
+    ASSERT_EQ(RID_ERROR_NOT_FOUND, rid_pcap_reader_next(&reader, &record));
+
+    PASS();
+}
+
+TEST test_pcapng_bluetooth(void) {
+    static capture_t capture;
+    rid_message_pack_t pack;
+    rid_location_t location;
+    rid_pcap_reader_t reader;
+    rid_pcap_record_t record;
+    uint8_t packet[512];
+    size_t size;
+
+    pack_fixture_make(&pack, 2);
+    rid_location_init(&location);
+    rid_location_set_latitude(&location, 60.1699);
+
+    for (int big_endian = 0; big_endian <= 1; ++big_endian) {
+        capture.size = 0;
+        capture.big_endian = big_endian;
+        pcapng_section(&capture);
+        pcapng_interface(&capture, RID_PCAP_LINKTYPE_BLUETOOTH_LE_LL, -1);
+        pcapng_interface(&capture, RID_PCAP_LINKTYPE_BLUETOOTH_LE_LL_WITH_PHDR, 9);
+
+        /* Advertisement without Remote ID. */
+        memset(packet, 0, sizeof(packet));
+        size = ble_legacy(packet, &location, 1);
+        packet[12] = 0x02;
+        packet[13] = 0x01;
+        packet[14] = 0x06;
+        pcapng_packet(&capture, 0, 1, packet, size);
+
+        size = ble_legacy(packet, &location, 2);
+        pcapng_packet(&capture, 0, 1760000000000001ULL, packet, size);
+
+        memset(packet, 0, BLE_PSEUDO_HEADER_SIZE);
+        size = ble_extended(&packet[BLE_PSEUDO_HEADER_SIZE], &pack, 3);
+        pcapng_packet(&capture, 1, 1760000000123456789ULL, packet, BLE_PSEUDO_HEADER_SIZE + size);
+
+        /* Unknown interface is skipped. */
+        pcapng_packet(&capture, 5, 0, packet, BLE_PSEUDO_HEADER_SIZE + size);
+
+        ASSERT_EQ(RID_SUCCESS, rid_pcap_reader_init(&reader, capture.data, capture.size));
+
+        ASSERT_EQ(RID_SUCCESS, rid_pcap_reader_next(&reader, &record));
+        ASSERT_EQ(RID_TRANSPORT_BLUETOOTH_LEGACY, record.transport);
+        ASSERT_EQ(1760000000000001ULL, record.timestamp);
+        ASSERT_EQ(2, record.counter);
+        ASSERT_EQ(RID_MESSAGE_SIZE, record.message_size);
+        ASSERT_MEM_EQ(&location, record.message, RID_MESSAGE_SIZE);
+        ASSERT_MEM_EQ(&ble_source, &record.source, sizeof(ble_source));
+
+        ASSERT_EQ(RID_SUCCESS, rid_pcap_reader_next(&reader, &record));
+        ASSERT_EQ(RID_TRANSPORT_BLUETOOTH_LONG_RANGE, record.transport);
+        ASSERT_EQ(1760000000123456ULL, record.timestamp);
+        ASSERT_EQ(3, record.counter);
+        ASSERT_EQ(rid_message_pack_size(&pack), record.message_size);
+        ASSERT_MEM_EQ(&pack, record.message, record.message_size);
+        ASSERT_MEM_EQ(&ble_source, &record.source, sizeof(ble_source));
+
+        ASSERT_EQ(RID_ERROR_NOT_FOUND, rid_pcap_reader_next(&reader, &record));
+    }
+
+    PASS();
+}
+
+TEST test_pcap_invalid(void) {
+    static capture_t capture;
+    rid_message_pack_t pack;
+    rid_pcap_reader_t reader;
+    rid_pcap_record_t record;
+    uint8_t frame[512];
+    size_t size;
+    const uint8_t garbage[32] = {0x01, 0x02, 0x03};
+
+    pack_fixture_make(&pack, 2);
+    capture.big_endian = 0;
+    pcap_header(&capture, 0xA1B2C3D4, RID_PCAP_LINKTYPE_IEEE802_11);
+    size = beacon_frame(frame, &pack, 1);
+    pcap_record(&capture, 1, 0, frame, size);
+    pcap_record(&capture, 2, 0, frame, size);
+
+    /* Second record is cut short. */
+    ASSERT_EQ(RID_SUCCESS, rid_pcap_reader_init(&reader, capture.data, capture.size - 1));
+    ASSERT_EQ(RID_SUCCESS, rid_pcap_reader_next(&reader, &record));
+    ASSERT_EQ(RID_ERROR_INVALID_CAPTURE, rid_pcap_reader_next(&reader, &record));
+    ASSERT_EQ(RID_ERROR_NOT_FOUND, rid_pcap_reader_next(&reader, &record));
+
+    ASSERT_EQ(RID_ERROR_INVALID_CAPTURE, rid_pcap_reader_init(&reader, garbage, sizeof(garbage)));
+    ASSERT_EQ(RID_ERROR_INVALID_CAPTURE, rid_pcap_reader_init(&reader, capture.data, 10));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_pcap_reader_init(NULL, capture.data, capture.size));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_pcap_reader_init(&reader, NULL, 0));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_pcap_reader_next(NULL, &record));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_pcap_reader_next(&reader, NULL));
+
+    /* Section header with a bad block length. */
+    capture.size = 0;
+    pcapng_section(&capture);
+    capture.data[4] = 0xFF;
+    ASSERT_EQ(RID_ERROR_INVALID_CAPTURE, rid_pcap_reader_init(&reader, capture.data, capture.size));
+
+    PASS();
+}
+
+static size_t count_records(rid_pcap_reader_t *reader, uint64_t *checksum) {
+    rid_pcap_record_t record;
+    size_t count = 0;
+
+    while (rid_pcap_reader_next(reader, &record) == RID_SUCCESS) {
+        *checksum = *checksum * 31 + record.timestamp + record.counter;
+        count++;
+    }
+
+    return count;
+}
+
+TEST test_pcap_split(void) {
+    static capture_t capture;
+    rid_message_pack_t pack;
+    rid_pcap_reader_t reader;
+    rid_pcap_reader_t chunks[8];
+    uint8_t frame[512];
+    size_t chunk_count = 0;
+    size_t size;
+
+    pack_fixture_make(&pack, 2);
+
+    for (int pcapng = 0; pcapng <= 1; ++pcapng) {
+        uint64_t expected_checksum = 0;
+        uint64_t checksum = 0;
+        size_t expected;
+        size_t total = 0;
+
+        capture.big_endian = 0;
+        capture.size = 0;
+        if (pcapng) {
+            pcapng_section(&capture);
+            pcapng_interface(&capture, RID_PCAP_LINKTYPE_IEEE802_11, -1);
+        } else {
+            pcap_header(&capture, 0xA1B2C3D4, RID_PCAP_LINKTYPE_IEEE802_11);
+        }
+
+        /* Frames of varying length, every third one with Remote ID. */
+        for (uint32_t i = 0; i < 200; ++i) {
+            size = beacon_frame(frame, i % 3 == 0 ? &pack : NULL, (uint8_t)i);
+            size += i % 7;
+            if (pcapng) {
+                pcapng_packet(&capture, 0, 1760000000000000ULL + i, frame, size);
+            } else {
+                pcap_record(&capture, 1760000000, i, frame, size);
+            }
+        }
+
+        ASSERT_EQ(RID_SUCCESS, rid_pcap_reader_init(&reader, capture.data, capture.size));
+        expected = count_records(&reader, &expected_checksum);
+        ASSERT_EQ(67, expected);
+
+        ASSERT_EQ(RID_SUCCESS, rid_pcap_reader_init(&reader, capture.data, capture.size));
+        ASSERT_EQ(RID_SUCCESS, rid_pcap_reader_split(&reader, chunks, 8, &chunk_count));
+        ASSERT_EQ(8, chunk_count);
+
+        for (size_t i = 0; i < chunk_count; ++i) {
+            size_t count = count_records(&chunks[i], &checksum);
+            ASSERT(count > 0);
+            total += count;
+        }
+        ASSERT_EQ(expected, total);
+        ASSERT_EQ(expected_checksum, checksum);
+    }
+
+    /* Small captures give fewer chunks. */
+    ASSERT_EQ(RID_SUCCESS, rid_pcap_reader_init(&reader, capture.data, 28 + 20 + 32 + 44));
+    ASSERT_EQ(RID_SUCCESS, rid_pcap_reader_split(&reader, chunks, 8, &chunk_count));
+    ASSERT_EQ(1, chunk_count);
+
+    ASSERT_EQ(RID_ERROR_OUT_OF_RANGE, rid_pcap_reader_split(&reader, chunks, 0, &chunk_count));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_pcap_reader_split(&reader, NULL, 8, &chunk_count));
+
+    PASS();
+}
+
+TEST test_pcap_map(void) {
+    static capture_t capture;
+    rid_message_pack_t pack;
+    rid_pcap_mapping_t mapping;
+    rid_pcap_reader_t reader;
+    rid_pcap_record_t record;
+    uint8_t frame[512];
+    const char *path = "test_pcap.tmp";
+    FILE *file;
+    int status;
+
+    pack_fixture_make(&pack, 2);
+    capture.big_endian = 0;
+    pcap_header(&capture, 0xA1B2C3D4, RID_PCAP_LINKTYPE_IEEE802_11);
+    pcap_record(&capture, 1, 0, frame, beacon_frame(frame, &pack, 4));
+
+    file = fopen(path, "wb");
+    if (file == NULL) {
+        SKIPm("can not write temporary file");
+    }
+    fwrite(capture.data, 1, capture.size, file);
+    fclose(file);
+
+    status = rid_pcap_map(&mapping, path);
+    if (status == RID_ERROR_NOT_IMPLEMENTED) {
+        remove(path);
+        SKIPm("memory mapping not supported");
+    }
+    ASSERT_EQ(RID_SUCCESS, status);
+    ASSERT_EQ(capture.size, mapping.size);
+
+    ASSERT_EQ(RID_SUCCESS, rid_pcap_reader_init(&reader, mapping.data, mapping.size));
+    ASSERT_EQ(RID_SUCCESS, rid_pcap_reader_next(&reader, &record));
+    ASSERT_EQ(4, record.counter);
+
+    ASSERT_EQ(RID_SUCCESS, rid_pcap_unmap(&mapping));
+    ASSERT_EQ(NULL, mapping.data);
+    remove(path);
+
+    ASSERT_EQ(RID_ERROR_READ_FAILED, rid_pcap_map(&mapping, "does/not/exist.pcap"));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_pcap_map(NULL, path));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_pcap_map(&mapping, NULL));
+
+    PASS();
+}
+
+SUITE(pcap_suite) {
+    RUN_TEST(test_pcap_radiotap);
+    RUN_TEST(test_pcap_big_endian_nanoseconds);
+    RUN_TEST(test_pcapng_bluetooth);
+    RUN_TEST(test_pcap_invalid);
+    RUN_TEST(test_pcap_split);
+    RUN_TEST(test_pcap_map);
+}
@@ -0,0 +1,276 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "greatest.h"
+#include "rid/location.h"
+#include "rid/message.h"
+#include "rid/pcap.h"
+#include "rid/pipeline.h"
+#include "rid/tracker.h"
+#include "rid/transport.h"
+
+#define WORKERS 4
+#define CAPACITY 64
+#define AIRCRAFT 32
+
+static uint64_t storage[(1 << 20) / sizeof(uint64_t)];
+static rid_location_t location;
+
+static rid_pcap_record_t make_record(uint8_t n, uint64_t timestamp) {
+    rid_pcap_record_t record;
+
+    memset(&record, 0, sizeof(record));
+    record.source.octets[0] = 0x60;
+    record.source.octets[5] = n;
+    record.message = (const uint8_t *)&location;
+    record.message_size = RID_MESSAGE_SIZE;
+    record.timestamp = timestamp;
+    record.transport = RID_TRANSPORT_BLUETOOTH_LEGACY;
+
+    return record;
+}
+
+/* Run every worker once, last one first so the output is out of order. */
+static int work_all(rid_pipeline_t *pipeline) {
+    int total = 0;
+
+    for (size_t i = WORKERS; i > 0; --i) {
+        int count = rid_pipeline_work(pipeline, i - 1, SIZE_MAX);
+        if (count > 0) {
+            total += count;
+        }
+    }
+    return total;
+}
+
+static int status_callback(void *context, rid_tracker_t *tracker, rid_pipeline_item_t *item) {
+    size_t *calls = (size_t *)context;
+
+    (*calls)++;
+    if (rid_tracker_find(tracker, &item->record.source) == NULL) {
+        return RID_ERROR_NOT_FOUND;
+    }
+    return item->status == RID_SUCCESS ? 42 : item->status;
+}
+
+TEST test_pipeline_storage_size(void) {
+    ASSERT(rid_pipeline_storage_size(WORKERS, CAPACITY, AIRCRAFT) > 0);
+    ASSERT(rid_pipeline_storage_size(WORKERS, CAPACITY, AIRCRAFT) <= sizeof(storage));
+    ASSERT(rid_pipeline_storage_size(8, CAPACITY, AIRCRAFT) > rid_pipeline_storage_size(4, CAPACITY, AIRCRAFT));
+    ASSERT_EQ(0, rid_pipeline_storage_size(0, CAPACITY, AIRCRAFT));
+    ASSERT_EQ(0, rid_pipeline_storage_size(RID_PIPELINE_MAX_WORKERS + 1, CAPACITY, AIRCRAFT));
+    ASSERT_EQ(0, rid_pipeline_storage_size(WORKERS, 0, AIRCRAFT));
+    ASSERT_EQ(0, rid_pipeline_storage_size(WORKERS, 100, AIRCRAFT));
+    ASSERT_EQ(0, rid_pipeline_storage_size(WORKERS, CAPACITY, 0));
+
+    PASS();
+}
+
+TEST test_pipeline_init_errors(void) {
+    rid_pipeline_t pipeline;
+    size_t size = rid_pipeline_storage_size(WORKERS, CAPACITY, AIRCRAFT);
+
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_pipeline_init(NULL, storage, size, WORKERS, CAPACITY, AIRCRAFT, RID_PIPELINE_ORDERED));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_pipeline_init(&pipeline, NULL, size, WORKERS, CAPACITY, AIRCRAFT, RID_PIPELINE_ORDERED));
+    ASSERT_EQ(RID_ERROR_OUT_OF_RANGE, rid_pipeline_init(&pipeline, storage, size, 0, CAPACITY, AIRCRAFT, RID_PIPELINE_ORDERED));
+    ASSERT_EQ(RID_ERROR_OUT_OF_RANGE, rid_pipeline_init(&pipeline, storage, size, WORKERS, 3, AIRCRAFT, RID_PIPELINE_ORDERED));
+    ASSERT_EQ(RID_ERROR_OUT_OF_RANGE, rid_pipeline_init(&pipeline, storage, size, WORKERS, CAPACITY, AIRCRAFT, (rid_pipeline_mode_t)2));
+    ASSERT_EQ(RID_ERROR_BUFFER_TOO_SMALL, rid_pipeline_init(&pipeline, storage, size - 1, WORKERS, CAPACITY, AIRCRAFT, RID_PIPELINE_ORDERED));
+
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_pipeline_push(NULL, NULL));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_pipeline_work(NULL, 0, 1));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_pipeline_collect(NULL, NULL, 1));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_pipeline_close(NULL));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_pipeline_set_callback(NULL, NULL, NULL));
+
+    ASSERT_EQ(RID_SUCCESS, rid_pipeline_init(&pipeline, storage, size, WORKERS, CAPACITY, AIRCRAFT, RID_PIPELINE_ORDERED));
+    ASSERT_EQ(RID_ERROR_OUT_OF_RANGE, rid_pipeline_work(&pipeline, WORKERS, 1));
+    ASSERT_EQ(NULL, rid_pipeline_tracker(&pipeline, WORKERS));
+
+    PASS();
+}
+
+TEST test_pipeline_unordered(void) {
+    rid_pipeline_t pipeline;
+    rid_pipeline_item_t items[CAPACITY];
+    size_t collected = 0;
+    size_t tracked = 0;
+
+    rid_location_init(&location);
+    ASSERT_EQ(RID_SUCCESS, rid_pipeline_init(&pipeline, storage, sizeof(storage), WORKERS, CAPACITY, AIRCRAFT, RID_PIPELINE_UNORDERED));
+
+    for (uint8_t i = 0; i < AIRCRAFT; ++i) {
+        rid_pcap_record_t record = make_record(i, 1000 + i);
+        ASSERT_EQ(RID_SUCCESS, rid_pipeline_push(&pipeline, &record));
+    }
+
+    ASSERT_EQ(0, rid_pipeline_collect(&pipeline, items, CAPACITY));
+    ASSERT_EQ(AIRCRAFT, work_all(&pipeline));
+    ASSERT_EQ(0, work_all(&pipeline));
+
+    while (collected < AIRCRAFT) {
+        int count = rid_pipeline_collect(&pipeline, &items[collected], CAPACITY - collected);
+        ASSERT(count > 0);
+        collected += (size_t)count;
+    }
+
+    for (size_t i = 0; i < AIRCRAFT; ++i) {
+        ASSERT_EQ(RID_SUCCESS, items[i].status);
+        ASSERT_EQ(1000 + items[i].sequence, items[i].record.timestamp);
+    }
+
+    for (size_t i = 0; i < WORKERS; ++i) {
+        tracked += rid_tracker_count(rid_pipeline_tracker(&pipeline, i));
+    }
+    ASSERT_EQ(AIRCRAFT, tracked);
+
+    PASS();
+}
+
+TEST test_pipeline_ordered(void) {
+    rid_pipeline_t pipeline;
+    rid_pipeline_item_t items[8];
+    uint64_t expected = 0;
+
+    rid_location_init(&location);
+    ASSERT_EQ(RID_SUCCESS, rid_pipeline_init(&pipeline, storage, sizeof(storage), WORKERS, CAPACITY, AIRCRAFT, RID_PIPELINE_ORDERED));
+
+    for (size_t round = 0; round < 4; ++round) {
+        for (uint8_t i = 0; i < AIRCRAFT; ++i) {
+            rid_pcap_record_t record = make_record(i, round);
+            ASSERT_EQ(RID_SUCCESS, rid_pipeline_push(&pipeline, &record));
+        }
+        work_all(&pipeline);
+    }
+    ASSERT_EQ(RID_SUCCESS, rid_pipeline_close(&pipeline));
+
+    for (;;) {
+        int count = rid_pipeline_collect(&pipeline, items, 8);
+        if (count == RID_ERROR_NOT_FOUND) {
+            break;
+        }
+        ASSERT(count > 0);
+        for (int i = 0; i < count; ++i) {
+            ASSERT_EQ(expected, items[i].sequence);
+            ASSERT_EQ(expected / AIRCRAFT, items[i].record.timestamp);
+            ASSERT_EQ(expected % AIRCRAFT, items[i].record.source.octets[5]);
+            expected++;
+        }
+    }
+    ASSERT_EQ(4 * AIRCRAFT, expected);
+
+    for (size_t i = 0; i < WORKERS; ++i) {
+        ASSERT_EQ(RID_ERROR_NOT_FOUND, rid_pipeline_work(&pipeline, i, SIZE_MAX));
+    }
+
+    PASS();
+}
+
+TEST test_pipeline_sharding(void) {
+    rid_pipeline_t pipeline;
+    size_t used = 0;
+
+    rid_location_init(&location);
+    ASSERT_EQ(RID_SUCCESS, rid_pipeline_init(&pipeline, storage, sizeof(storage), WORKERS, CAPACITY, AIRCRAFT, RID_PIPELINE_UNORDERED));
+
+    for (uint8_t i = 0; i < AIRCRAFT; ++i) {
+        rid_pcap_record_t record = make_record(i, i);
+        ASSERT_EQ(RID_SUCCESS, rid_pipeline_push(&pipeline, &record));
+        ASSERT_EQ(RID_SUCCESS, rid_pipeline_push(&pipeline, &record));
+    }
+    work_all(&pipeline);
+
+    /* Each aircraft is only in the tracker of the worker owning it. */
+    for (uint8_t i = 0; i < AIRCRAFT; ++i) {
+        rid_pcap_record_t record = make_record(i, i);
+        size_t owner = rid_pipeline_worker(&pipeline, &record.source);
+
+        ASSERT(owner < WORKERS);
+        for (size_t w = 0; w < WORKERS; ++w) {
+            const rid_aircraft_t *aircraft = rid_tracker_find(rid_pipeline_tracker(&pipeline, w), &record.source);
+            ASSERT_EQ(w == owner, aircraft != NULL);
+        }
+
+        const rid_aircraft_t *aircraft = rid_pipeline_find(&pipeline, &record.source);
+        ASSERT(aircraft != NULL);
+        ASSERT_EQ(2, aircraft->message_count[RID_MESSAGE_TYPE_LOCATION]);
+    }
+
+    for (size_t w = 0; w < WORKERS; ++w) {
+        if (rid_tracker_count(rid_pipeline_tracker(&pipeline, w)) > 0) {
+            used++;
+        }
+    }
+    ASSERT(used > 1);
+
+    PASS();
+}
+
+TEST test_pipeline_full(void) {
+    rid_pipeline_t pipeline;
+    rid_pipeline_item_t items[8];
+    rid_pcap_record_t record = make_record(1, 0);
+
+    rid_location_init(&location);
+    ASSERT_EQ(RID_SUCCESS, rid_pipeline_init(&pipeline, storage, sizeof(storage), 1, 4, AIRCRAFT, RID_PIPELINE_ORDERED));
+
+    for (size_t i = 0; i < 4; ++i) {
+        ASSERT_EQ(RID_SUCCESS, rid_pipeline_push(&pipeline, &record));
+    }
+    ASSERT_EQ(RID_ERROR_BUFFER_TOO_SMALL, rid_pipeline_push(&pipeline, &record));
+
+    ASSERT_EQ(1, rid_pipeline_work(&pipeline, 0, 1));
+    ASSERT_EQ(RID_SUCCESS, rid_pipeline_push(&pipeline, &record));
+    ASSERT_EQ(3, rid_pipeline_work(&pipeline, 0, SIZE_MAX));
+
+    /* Output ring is full, the last item waits until some are collected. */
+    ASSERT_EQ(0, rid_pipeline_work(&pipeline, 0, SIZE_MAX));
+    ASSERT_EQ(2, rid_pipeline_collect(&pipeline, items, 2));
+    ASSERT_EQ(1, rid_pipeline_work(&pipeline, 0, SIZE_MAX));
+    ASSERT_EQ(3, rid_pipeline_collect(&pipeline, items, 8));
+    ASSERT_EQ(4, items[2].sequence);
+
+    ASSERT_EQ(0, rid_pipeline_work(&pipeline, 0, SIZE_MAX));
+    ASSERT_EQ(0, rid_pipeline_collect(&pipeline, items, 8));
+    ASSERT_EQ(RID_SUCCESS, rid_pipeline_close(&pipeline));
+    ASSERT_EQ(RID_ERROR_NOT_FOUND, rid_pipeline_work(&pipeline, 0, SIZE_MAX));
+    ASSERT_EQ(RID_ERROR_NOT_FOUND, rid_pipeline_collect(&pipeline, items, 8));
+
+    PASS();
+}
+
+TEST test_pipeline_callback(void) {
+    rid_pipeline_t pipeline;
+    rid_pipeline_item_t items[4];
+    rid_pcap_record_t record = make_record(1, 0);
+    rid_pcap_record_t invalid = make_record(2, 0);
+    uint8_t unknown[RID_MESSAGE_SIZE] = {0xC0};
+    size_t calls = 0;
+
+    invalid.message = unknown;
+
+    rid_location_init(&location);
+    ASSERT_EQ(RID_SUCCESS, rid_pipeline_init(&pipeline, storage, sizeof(storage), 1, 4, AIRCRAFT, RID_PIPELINE_UNORDERED));
+    ASSERT_EQ(RID_SUCCESS, rid_pipeline_set_callback(&pipeline, status_callback, &calls));
+
+    ASSERT_EQ(RID_SUCCESS, rid_pipeline_push(&pipeline, &record));
+    ASSERT_EQ(RID_SUCCESS, rid_pipeline_push(&pipeline, &invalid));
+    ASSERT_EQ(2, rid_pipeline_work(&pipeline, 0, SIZE_MAX));
+    ASSERT_EQ(2, rid_pipeline_collect(&pipeline, items, 4));
+
+    ASSERT_EQ(2, calls);
+    ASSERT_EQ(42, items[0].status);
+    ASSERT_EQ(RID_ERROR_NOT_FOUND, items[1].status);
+
+    PASS();
+}
+
+SUITE(pipeline_suite) {
+    RUN_TEST(test_pipeline_storage_size);
+    RUN_TEST(test_pipeline_init_errors);
+    RUN_TEST(test_pipeline_unordered);
+    RUN_TEST(test_pipeline_ordered);
+    RUN_TEST(test_pipeline_sharding);
+    RUN_TEST(test_pipeline_full);
+    RUN_TEST(test_pipeline_callback);
+}
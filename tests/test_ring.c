@@ -0,0 +1,164 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "greatest.h"
+#include "rid/location.h"
+#include "rid/message.h"
+#include "rid/message_pack.h"
+#include "rid/ring.h"
+
+#define CAPACITY 8
+
+static uint64_t storage[(64 * 1024) / sizeof(uint64_t)];
+
+static void make_messages(rid_message_t *messages, size_t count, uint8_t first) {
+    for (size_t i = 0; i < count; ++i) {
+        rid_location_init((rid_location_t *)&messages[i]);
+        messages[i].body[23] = (uint8_t)(first + i);
+    }
+}
+
+TEST test_ring_storage_size(void) {
+    ASSERT(rid_ring_storage_size(RID_RING_MESSAGE, CAPACITY) >= CAPACITY * RID_RING_MESSAGE_SLOT_SIZE);
+    ASSERT(rid_ring_storage_size(RID_RING_MESSAGE_PACK, CAPACITY) >= CAPACITY * RID_RING_MESSAGE_PACK_SLOT_SIZE);
+    ASSERT_EQ(0, rid_ring_storage_size(RID_RING_MESSAGE, 0));
+    ASSERT_EQ(0, rid_ring_storage_size(RID_RING_MESSAGE, 6));
+    ASSERT_EQ(0, rid_ring_storage_size(RID_RING_MESSAGE, RID_RING_MAX_CAPACITY * 2));
+    ASSERT_EQ(0, rid_ring_storage_size((rid_ring_type_t)2, CAPACITY));
+
+    PASS();
+}
+
+TEST test_ring_init_errors(void) {
+    rid_ring_t ring;
+    rid_message_t message;
+    size_t size = rid_ring_storage_size(RID_RING_MESSAGE, CAPACITY);
+
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_ring_init(NULL, storage, size, RID_RING_MESSAGE, CAPACITY, RID_RING_SINGLE_PRODUCER));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_ring_init(&ring, NULL, size, RID_RING_MESSAGE, CAPACITY, RID_RING_SINGLE_PRODUCER));
+    ASSERT_EQ(RID_ERROR_OUT_OF_RANGE, rid_ring_init(&ring, storage, size, RID_RING_MESSAGE, 3, RID_RING_SINGLE_PRODUCER));
+    ASSERT_EQ(RID_ERROR_OUT_OF_RANGE, rid_ring_init(&ring, storage, size, RID_RING_MESSAGE, CAPACITY, (rid_ring_producer_t)2));
+    ASSERT_EQ(RID_ERROR_BUFFER_TOO_SMALL, rid_ring_init(&ring, storage, size - 1, RID_RING_MESSAGE, CAPACITY, RID_RING_SINGLE_PRODUCER));
+    ASSERT_EQ(RID_SUCCESS, rid_ring_init(&ring, storage, size, RID_RING_MESSAGE, CAPACITY, RID_RING_SINGLE_PRODUCER));
+
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_ring_push(NULL, &message, 1));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_ring_push(&ring, NULL, 1));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_ring_pop(NULL, &message, 1));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_ring_pop(&ring, NULL, 1));
+    ASSERT_EQ(0, rid_ring_count(NULL));
+
+    PASS();
+}
+
+static enum greatest_test_res ring_messages(rid_ring_producer_t producer) {
+    rid_ring_t ring;
+    rid_message_t in[CAPACITY * 2];
+    rid_message_t out[CAPACITY * 2];
+
+    make_messages(in, CAPACITY * 2, 0);
+    ASSERT_EQ(RID_SUCCESS, rid_ring_init(&ring, storage, sizeof(storage), RID_RING_MESSAGE, CAPACITY, producer));
+
+    ASSERT_EQ(0, rid_ring_pop(&ring, out, CAPACITY));
+    ASSERT_EQ(3, rid_ring_push(&ring, in, 3));
+    ASSERT_EQ(3, rid_ring_count(&ring));
+    ASSERT_EQ(2, rid_ring_pop(&ring, out, 2));
+    ASSERT_MEM_EQ(in, out, 2 * RID_MESSAGE_SIZE);
+
+    /* Only the free slots are filled, the ring wraps around. */
+    ASSERT_EQ(CAPACITY - 1, rid_ring_push(&ring, &in[3], CAPACITY * 2 - 3));
+    ASSERT_EQ(CAPACITY, rid_ring_count(&ring));
+    ASSERT_EQ(0, rid_ring_push(&ring, in, 1));
+
+    ASSERT_EQ(CAPACITY, rid_ring_pop(&ring, out, CAPACITY * 2));
+    ASSERT_MEM_EQ(&in[2], out, CAPACITY * RID_MESSAGE_SIZE);
+    ASSERT_EQ(0, rid_ring_count(&ring));
+    ASSERT_EQ(0, rid_ring_pop(&ring, out, CAPACITY));
+
+    PASS();
+}
+
+TEST test_ring_messages(void) {
+    CHECK_CALL(ring_messages(RID_RING_SINGLE_PRODUCER));
+    PASS();
+}
+
+TEST test_ring_messages_multi_producer(void) {
+    CHECK_CALL(ring_messages(RID_RING_MULTI_PRODUCER));
+    PASS();
+}
+
+TEST test_ring_laps(void) {
+    rid_ring_t ring;
+    rid_message_t in[3];
+    rid_message_t out[3];
+
+    ASSERT_EQ(RID_SUCCESS, rid_ring_init(&ring, storage, sizeof(storage), RID_RING_MESSAGE, CAPACITY, RID_RING_MULTI_PRODUCER));
+
+    for (uint8_t n = 0; n < 100; ++n) {
+        make_messages(in, 3, (uint8_t)(n * 3));
+        ASSERT_EQ(3, rid_ring_push(&ring, in, 3));
+        ASSERT_EQ(3, rid_ring_pop(&ring, out, 3));
+        ASSERT_MEM_EQ(in, out, sizeof(in));
+    }
+
+    PASS();
+}
+
+TEST test_ring_message_packs(void) {
+    rid_ring_t ring;
+    rid_message_pack_t in[3];
+    rid_message_pack_t out[3];
+    rid_location_t location;
+
+    rid_location_init(&location);
+    rid_location_set_latitude(&location, 60.1699);
+
+    for (size_t i = 0; i < 3; ++i) {
+        rid_message_pack_init(&in[i]);
+        for (size_t j = 0; j <= i * 4; ++j) {
+            rid_message_pack_add_message(&in[i], &location);
+        }
+    }
+
+    ASSERT_EQ(RID_SUCCESS, rid_ring_init(&ring, storage, sizeof(storage), RID_RING_MESSAGE_PACK, CAPACITY, RID_RING_SINGLE_PRODUCER));
+    ASSERT_EQ(3, rid_ring_push(&ring, in, 3));
+    ASSERT_EQ(3, rid_ring_pop(&ring, out, 3));
+
+    for (size_t i = 0; i < 3; ++i) {
+        size_t size = 3 + in[i].message_count * RID_MESSAGE_SIZE;
+
+        ASSERT_EQ(1 + i * 4, out[i].message_count);
+        ASSERT_MEM_EQ(&in[i], &out[i], size);
+    }
+
+    PASS();
+}
+
+TEST test_ring_invalid_message_pack(void) {
+    rid_ring_t ring;
+    rid_message_pack_t in[3];
+    rid_message_pack_t out[3];
+
+    for (size_t i = 0; i < 3; ++i) {
+        rid_message_pack_init(&in[i]);
+    }
+    in[1].message_count = RID_MESSAGE_PACK_MAX_MESSAGES + 1;
+
+    ASSERT_EQ(RID_SUCCESS, rid_ring_init(&ring, storage, sizeof(storage), RID_RING_MESSAGE_PACK, CAPACITY, RID_RING_SINGLE_PRODUCER));
+    ASSERT_EQ(1, rid_ring_push(&ring, in, 3));
+    ASSERT_EQ(RID_ERROR_INVALID_MESSAGE_COUNT, rid_ring_push(&ring, &in[1], 2));
+    ASSERT_EQ(1, rid_ring_push(&ring, &in[2], 1));
+    ASSERT_EQ(2, rid_ring_pop(&ring, out, 3));
+
+    PASS();
+}
+
+SUITE(ring_suite) {
+    RUN_TEST(test_ring_storage_size);
+    RUN_TEST(test_ring_init_errors);
+    RUN_TEST(test_ring_messages);
+    RUN_TEST(test_ring_messages_multi_producer);
+    RUN_TEST(test_ring_laps);
+    RUN_TEST(test_ring_message_packs);
+    RUN_TEST(test_ring_invalid_message_pack);
+}
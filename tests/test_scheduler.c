@@ -0,0 +1,332 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "greatest.h"
+#include "rid/auth.h"
+#include "rid/auth_page.h"
+#include "rid/basic_id.h"
+#include "rid/location.h"
+#include "rid/message.h"
+#include "rid/message_pack.h"
+#include "rid/scheduler.h"
+#include "rid/system.h"
+#include "rid/transport.h"
+
+static uint64_t storage[50000];
+
+static void set_messages(rid_scheduler_t *scheduler, uint32_t aircraft, uint64_t now) {
+    rid_basic_id_t basic_id;
+    rid_location_t location;
+    rid_system_t system;
+
+    rid_basic_id_init(&basic_id);
+    rid_location_init(&location);
+    rid_location_set_latitude(&location, 60.0 + aircraft * 0.001);
+    rid_system_init(&system);
+
+    rid_scheduler_set_message(scheduler, aircraft, &basic_id, now);
+    rid_scheduler_set_message(scheduler, aircraft, &location, now);
+    rid_scheduler_set_message(scheduler, aircraft, &system, now);
+}
+
+static void make_auth(rid_auth_t *auth, size_t signature_size) {
+    uint8_t signature[RID_AUTH_PAGE_MAX_SIGNATURE_SIZE];
+
+    for (size_t i = 0; i < signature_size; ++i) {
+        signature[i] = (uint8_t)i;
+    }
+    rid_auth_init(auth);
+    rid_auth_set_type(auth, RID_AUTH_TYPE_MESSAGE_SET_SIGNATURE);
+    rid_auth_set_timestamp(auth, 1000);
+    rid_auth_set_signature(auth, signature, signature_size);
+}
+
+TEST test_scheduler_init(void) {
+    rid_scheduler_t scheduler;
+    size_t size = rid_scheduler_storage_size(RID_TRANSPORT_BLUETOOTH_LEGACY, 10);
+
+    ASSERT(size > 0);
+    ASSERT(rid_scheduler_storage_size(RID_TRANSPORT_WIFI_NAN, 10) < size);
+    ASSERT_EQ(0, rid_scheduler_storage_size(RID_TRANSPORT_WIFI_NAN, 0));
+    ASSERT_EQ(0, rid_scheduler_storage_size((rid_transport_t)4, 10));
+    ASSERT_EQ(0, rid_scheduler_storage_size(RID_TRANSPORT_WIFI_NAN, RID_SCHEDULER_MAX_CAPACITY + 1));
+
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_scheduler_init(NULL, storage, sizeof(storage), RID_TRANSPORT_BLUETOOTH_LEGACY, 10));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_scheduler_init(&scheduler, NULL, sizeof(storage), RID_TRANSPORT_BLUETOOTH_LEGACY, 10));
+    ASSERT_EQ(RID_ERROR_OUT_OF_RANGE, rid_scheduler_init(&scheduler, storage, sizeof(storage), RID_TRANSPORT_BLUETOOTH_LEGACY, 0));
+    ASSERT_EQ(RID_ERROR_BUFFER_TOO_SMALL, rid_scheduler_init(&scheduler, storage, size - 1, RID_TRANSPORT_BLUETOOTH_LEGACY, 10));
+    ASSERT_EQ(RID_SUCCESS, rid_scheduler_init(&scheduler, (uint8_t *)storage + 1, size, RID_TRANSPORT_BLUETOOTH_LEGACY, 10));
+
+    ASSERT_EQ(0, rid_scheduler_count(&scheduler));
+    ASSERT_EQ(UINT64_MAX, rid_scheduler_next_due(&scheduler));
+    ASSERT_EQ(UINT64_MAX, rid_scheduler_next_due(NULL));
+    ASSERT_EQ(NULL, rid_scheduler_get_aircraft(&scheduler, 10));
+
+    ASSERT_EQ(RID_ERROR_OUT_OF_RANGE, rid_scheduler_set_interval(&scheduler, RID_MESSAGE_TYPE_LOCATION, 0));
+    ASSERT_EQ(RID_ERROR_OUT_OF_RANGE, rid_scheduler_set_interval(&scheduler, RID_MESSAGE_TYPE_MESSAGE_PACK, 100));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_scheduler_set_interval(NULL, RID_MESSAGE_TYPE_LOCATION, 100));
+
+    PASS();
+}
+
+TEST test_scheduler_set_message_errors(void) {
+    rid_scheduler_t scheduler;
+    rid_message_pack_t pack;
+    rid_location_t location;
+    rid_scheduler_frame_t frame;
+    rid_auth_t auth;
+
+    rid_scheduler_init(&scheduler, storage, sizeof(storage), RID_TRANSPORT_BLUETOOTH_LEGACY, 10);
+    rid_location_init(&location);
+    rid_message_pack_init(&pack);
+    make_auth(&auth, 32);
+
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_scheduler_set_message(NULL, 0, &location, 0));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_scheduler_set_message(&scheduler, 0, NULL, 0));
+    ASSERT_EQ(RID_ERROR_OUT_OF_RANGE, rid_scheduler_set_message(&scheduler, 10, &location, 0));
+    ASSERT_EQ(RID_ERROR_INVALID_MESSAGE_TYPE, rid_scheduler_set_message(&scheduler, 0, &pack, 0));
+    ASSERT_EQ(RID_ERROR_INVALID_MESSAGE_TYPE, rid_scheduler_set_message(&scheduler, 0, &auth.page_0, 0));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_scheduler_set_auth(&scheduler, 0, NULL, 0));
+    ASSERT_EQ(RID_ERROR_OUT_OF_RANGE, rid_scheduler_set_auth(&scheduler, 10, &auth, 0));
+    ASSERT_EQ(RID_ERROR_NOT_FOUND, rid_scheduler_remove(&scheduler, 0));
+    ASSERT_EQ(RID_ERROR_OUT_OF_RANGE, rid_scheduler_remove(&scheduler, 10));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_scheduler_next(&scheduler, 0, NULL));
+    ASSERT_EQ(RID_ERROR_NOT_FOUND, rid_scheduler_next(&scheduler, 0, &frame));
+
+    PASS();
+}
+
+TEST test_scheduler_bluetooth_legacy_rates(void) {
+    rid_scheduler_t scheduler;
+    rid_scheduler_frame_t frame;
+    rid_auth_t auth;
+    uint32_t frames[RID_SCHEDULER_MESSAGE_TYPES] = {0};
+    uint32_t pages[3] = {0};
+
+    rid_scheduler_init(&scheduler, storage, sizeof(storage), RID_TRANSPORT_BLUETOOTH_LEGACY, 4);
+    set_messages(&scheduler, 2, 0);
+    make_auth(&auth, 50);
+    ASSERT_EQ(3, rid_auth_get_page_count(&auth));
+    ASSERT_EQ(RID_SUCCESS, rid_scheduler_set_auth(&scheduler, 2, &auth, 0));
+    ASSERT_EQ(4, rid_scheduler_count(&scheduler));
+    ASSERT_EQ(0, rid_scheduler_next_due(&scheduler));
+
+    for (uint64_t now = 0; now < 9000; now += 50) {
+        while (rid_scheduler_next(&scheduler, now, &frame) == RID_SUCCESS) {
+            ASSERT_EQ(2, frame.aircraft);
+            ASSERT_EQ(RID_MESSAGE_SIZE, frame.size);
+            ASSERT_EQ(frame.type, rid_message_get_type(frame.data));
+            ASSERT(frame.due <= now);
+            /* Counter steps per message type. */
+            ASSERT_EQ((uint8_t)frames[frame.type], frame.counter);
+            frames[frame.type]++;
+            if (frame.type == RID_MESSAGE_TYPE_AUTH) {
+                pages[((const rid_auth_page_x_t *)frame.data)->page_number]++;
+            }
+        }
+    }
+
+    ASSERT_EQ(9, frames[RID_MESSAGE_TYPE_LOCATION]);
+    ASSERT_EQ(3, frames[RID_MESSAGE_TYPE_BASIC_ID]);
+    ASSERT_EQ(3, frames[RID_MESSAGE_TYPE_SYSTEM]);
+    ASSERT_EQ(0, frames[RID_MESSAGE_TYPE_SELF_ID]);
+    ASSERT_EQ(3, pages[0]);
+    ASSERT_EQ(3, pages[1]);
+    ASSERT_EQ(3, pages[2]);
+
+    PASS();
+}
+
+TEST test_scheduler_message_pack(void) {
+    rid_scheduler_t scheduler;
+    rid_scheduler_frame_t frame;
+    rid_message_pack_t *pack = (rid_message_pack_t *)frame.data;
+    rid_auth_t auth;
+    rid_auth_t received;
+
+    rid_scheduler_init(&scheduler, storage, sizeof(storage), RID_TRANSPORT_WIFI_BEACON, 4);
+    set_messages(&scheduler, 1, 500);
+    ASSERT_EQ(1, rid_scheduler_count(&scheduler));
+    ASSERT_EQ(RID_ERROR_NOT_FOUND, rid_scheduler_next(&scheduler, 499, &frame));
+
+    ASSERT_EQ(RID_SUCCESS, rid_scheduler_next(&scheduler, 500, &frame));
+    ASSERT_EQ(1, frame.aircraft);
+    ASSERT_EQ(RID_MESSAGE_TYPE_MESSAGE_PACK, frame.type);
+    ASSERT_EQ(0, frame.counter);
+    ASSERT_EQ(RID_SUCCESS, rid_message_pack_validate(pack));
+    ASSERT_EQ(3, pack->message_count);
+    ASSERT_EQ(rid_message_pack_size(pack), frame.size);
+    ASSERT(frame.size <= RID_TRANSPORT_WIFI_BEACON_MAX_PAYLOAD);
+    ASSERT_EQ(1500, rid_scheduler_next_due(&scheduler));
+
+    /* Small signature fits the pack. */
+    make_auth(&auth, 50);
+    ASSERT_EQ(RID_SUCCESS, rid_scheduler_set_auth(&scheduler, 1, &auth, 600));
+    ASSERT_EQ(RID_SUCCESS, rid_scheduler_next(&scheduler, 1500, &frame));
+    ASSERT_EQ(1, frame.counter);
+    ASSERT_EQ(6, pack->message_count);
+    ASSERT_EQ(RID_SUCCESS, rid_message_pack_get_auth(pack, &received));
+    ASSERT_MEM_EQ(&auth, &received, 3 * RID_MESSAGE_SIZE);
+
+    /* Eight pages do not fit with three messages, they are rotated. */
+    make_auth(&auth, 170);
+    ASSERT_EQ(8, rid_auth_get_page_count(&auth));
+    ASSERT_EQ(RID_SUCCESS, rid_scheduler_set_auth(&scheduler, 1, &auth, 1600));
+    ASSERT_EQ(RID_SUCCESS, rid_scheduler_next(&scheduler, 2500, &frame));
+    ASSERT_EQ(9, pack->message_count);
+    ASSERT_MEM_EQ(&auth.page_0, rid_message_pack_get_message_at(pack, 3), RID_MESSAGE_SIZE);
+    ASSERT_MEM_EQ(&auth.page_x[4], rid_message_pack_get_message_at(pack, 8), RID_MESSAGE_SIZE);
+    ASSERT_EQ(RID_SUCCESS, rid_scheduler_next(&scheduler, 3500, &frame));
+    ASSERT_MEM_EQ(&auth.page_x[5], rid_message_pack_get_message_at(pack, 3), RID_MESSAGE_SIZE);
+    ASSERT_MEM_EQ(&auth.page_x[6], rid_message_pack_get_message_at(pack, 4), RID_MESSAGE_SIZE);
+    ASSERT_MEM_EQ(&auth.page_0, rid_message_pack_get_message_at(pack, 5), RID_MESSAGE_SIZE);
+
+    PASS();
+}
+
+TEST test_scheduler_two_basic_ids(void) {
+    rid_scheduler_t scheduler;
+    rid_scheduler_frame_t frame;
+    rid_message_pack_t *pack = (rid_message_pack_t *)frame.data;
+    rid_basic_id_t serial;
+    rid_basic_id_t registration;
+    rid_basic_id_t other;
+    uint32_t sent[2] = {0};
+
+    rid_basic_id_init(&serial);
+    rid_basic_id_set_type(&serial, RID_ID_TYPE_SERIAL_NUMBER);
+    rid_basic_id_set_uas_id(&serial, "1596F3A4C8D2E7B9");
+    rid_basic_id_init(&registration);
+    rid_basic_id_set_type(&registration, RID_ID_TYPE_CAA_REGISTRATION_ID);
+    rid_basic_id_set_uas_id(&registration, "FIN87astrdge12k8");
+    rid_basic_id_init(&other);
+    rid_basic_id_set_type(&other, RID_ID_TYPE_UTM_ASSIGNED_UUID);
+
+    rid_scheduler_init(&scheduler, storage, sizeof(storage), RID_TRANSPORT_BLUETOOTH_LEGACY, 4);
+    ASSERT_EQ(RID_SUCCESS, rid_scheduler_set_message(&scheduler, 0, &serial, 0));
+    ASSERT_EQ(RID_SUCCESS, rid_scheduler_set_message(&scheduler, 0, &registration, 0));
+    ASSERT_EQ(2, rid_scheduler_count(&scheduler));
+
+    /* Same ID type replaces, a third ID type is rejected. */
+    rid_basic_id_set_uas_id(&serial, "1596F3A4C8D2E7C0");
+    ASSERT_EQ(RID_SUCCESS, rid_scheduler_set_message(&scheduler, 0, &serial, 0));
+    ASSERT_EQ(RID_ERROR_BUFFER_TOO_SMALL, rid_scheduler_set_message(&scheduler, 0, &other, 0));
+    ASSERT_EQ(2, rid_scheduler_count(&scheduler));
+
+    /* Both are sent at the Basic ID interval and share the counter. */
+    for (uint64_t now = 0; now < 9000; now += 50) {
+        while (rid_scheduler_next(&scheduler, now, &frame) == RID_SUCCESS) {
+            ASSERT_EQ(RID_MESSAGE_TYPE_BASIC_ID, frame.type);
+            ASSERT_EQ((uint8_t)(sent[0] + sent[1]), frame.counter);
+            if (memcmp(frame.data, &serial, RID_MESSAGE_SIZE) == 0) {
+                sent[0]++;
+            } else {
+                ASSERT_MEM_EQ(&registration, frame.data, RID_MESSAGE_SIZE);
+                sent[1]++;
+            }
+        }
+    }
+    ASSERT_EQ(3, sent[0]);
+    ASSERT_EQ(3, sent[1]);
+
+    /* Message Pack transports send both in the same pack. */
+    rid_scheduler_init(&scheduler, storage, sizeof(storage), RID_TRANSPORT_WIFI_NAN, 4);
+    ASSERT_EQ(RID_SUCCESS, rid_scheduler_set_message(&scheduler, 3, &serial, 0));
+    ASSERT_EQ(RID_SUCCESS, rid_scheduler_set_message(&scheduler, 3, &registration, 0));
+    ASSERT_EQ(RID_SUCCESS, rid_scheduler_next(&scheduler, 0, &frame));
+    ASSERT_EQ(RID_SUCCESS, rid_message_pack_validate(pack));
+    ASSERT_EQ(2, pack->message_count);
+    ASSERT_MEM_EQ(&serial, rid_message_pack_get_message_at(pack, 0), RID_MESSAGE_SIZE);
+    ASSERT_MEM_EQ(&registration, rid_message_pack_get_message_at(pack, 1), RID_MESSAGE_SIZE);
+
+    PASS();
+}
+
+TEST test_scheduler_many_aircraft(void) {
+    rid_scheduler_t scheduler;
+    rid_scheduler_frame_t frame;
+    static uint64_t last[500];
+    size_t capacity = 500;
+
+    ASSERT(rid_scheduler_storage_size(RID_TRANSPORT_BLUETOOTH_LEGACY, capacity) <= sizeof(storage));
+    rid_scheduler_init(&scheduler, storage, sizeof(storage), RID_TRANSPORT_BLUETOOTH_LEGACY, capacity);
+
+    /* Start times spread over one second. */
+    for (uint32_t i = 0; i < capacity; ++i) {
+        set_messages(&scheduler, i, i * 2);
+        last[i] = i * 2;
+    }
+    ASSERT_EQ(3 * capacity, rid_scheduler_count(&scheduler));
+
+    for (uint64_t now = 0; now < 10000; now += 10) {
+        uint64_t previous = 0;
+
+        while (rid_scheduler_next(&scheduler, now, &frame) == RID_SUCCESS) {
+            ASSERT(frame.due >= previous);
+            previous = frame.due;
+            if (frame.type == RID_MESSAGE_TYPE_LOCATION) {
+                ASSERT(frame.due - last[frame.aircraft] <= RID_SCHEDULER_DYNAMIC_INTERVAL);
+                last[frame.aircraft] = frame.due;
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < capacity; i += 2) {
+        ASSERT_EQ(RID_SUCCESS, rid_scheduler_remove(&scheduler, i));
+    }
+    ASSERT_EQ(3 * capacity / 2, rid_scheduler_count(&scheduler));
+    ASSERT_EQ(0, rid_scheduler_get_aircraft(&scheduler, 0)->present);
+
+    /* Remaining aircraft come out in order and removed ones never. */
+    uint64_t previous = 0;
+    while (rid_scheduler_next(&scheduler, 20000, &frame) == RID_SUCCESS && frame.due < 20000) {
+        ASSERT_EQ(1, frame.aircraft % 2);
+        ASSERT(frame.due >= previous);
+        previous = frame.due;
+    }
+
+    PASS();
+}
+
+TEST test_scheduler_late(void) {
+    rid_scheduler_t scheduler;
+    rid_scheduler_frame_t frame;
+    rid_location_t location;
+
+    rid_scheduler_init(&scheduler, storage, sizeof(storage), RID_TRANSPORT_WIFI_NAN, 1);
+    rid_scheduler_set_interval(&scheduler, RID_MESSAGE_TYPE_LOCATION, 200);
+    rid_location_init(&location);
+    rid_scheduler_set_message(&scheduler, 0, &location, 0);
+
+    ASSERT_EQ(RID_SUCCESS, rid_scheduler_next(&scheduler, 0, &frame));
+    ASSERT_EQ(200, rid_scheduler_next_due(&scheduler));
+
+    /* Slightly late keeps the phase. */
+    ASSERT_EQ(RID_SUCCESS, rid_scheduler_next(&scheduler, 250, &frame));
+    ASSERT_EQ(200, frame.due);
+    ASSERT_EQ(400, rid_scheduler_next_due(&scheduler));
+
+    /* Missed frames are not sent in a burst. */
+    ASSERT_EQ(RID_SUCCESS, rid_scheduler_next(&scheduler, 1000, &frame));
+    ASSERT_EQ(RID_ERROR_NOT_FOUND, rid_scheduler_next(&scheduler, 1000, &frame));
+    ASSERT_EQ(1200, rid_scheduler_next_due(&scheduler));
+
+    /* Updating a message keeps the schedule. */
+    rid_scheduler_set_message(&scheduler, 0, &location, 1100);
+    ASSERT_EQ(1200, rid_scheduler_next_due(&scheduler));
+
+    ASSERT_EQ(RID_SUCCESS, rid_scheduler_clear(&scheduler));
+    ASSERT_EQ(0, rid_scheduler_count(&scheduler));
+
+    PASS();
+}
+
+SUITE(scheduler_suite) {
+    RUN_TEST(test_scheduler_init);
+    RUN_TEST(test_scheduler_set_message_errors);
+    RUN_TEST(test_scheduler_bluetooth_legacy_rates);
+    RUN_TEST(test_scheduler_message_pack);
+    RUN_TEST(test_scheduler_two_basic_ids);
+    RUN_TEST(test_scheduler_many_aircraft);
+    RUN_TEST(test_scheduler_late);
+}
@@ -290,6 +290,41 @@ TEST test_self_id_to_json_needed(void) {
     PASS();
 }
 
+TEST test_self_id_to_json_escape(void) {
+    rid_self_id_t message;
+    char buffer[256];
+
+    rid_self_id_init(&message);
+    memcpy(message.description, "Long clean run \"a\\b\x01\x1f~", RID_DESCRIPTION_SIZE);
+
+    ASSERT_EQ(RID_SUCCESS, rid_self_id_to_json(&message, buffer, sizeof(buffer), NULL));
+    ASSERT(strstr(buffer, "\"description\":\"Long clean run \\\"a\\\\b\\u0001\\u001f~\"") != NULL);
+
+    PASS();
+}
+
+TEST test_self_id_to_json_truncated(void) {
+    rid_self_id_t message;
+    char full[256];
+    char buffer[256];
+    size_t needed = 0;
+
+    rid_self_id_init(&message);
+    rid_self_id_set_description(&message, "Welcome to \"Costco\"");
+    ASSERT_EQ(RID_SUCCESS, rid_self_id_to_json(&message, full, sizeof(full), &needed));
+
+    /* Truncated output is the longest prefix which fits, terminated. */
+    for (size_t size = 1; size < needed; ++size) {
+        memset(buffer, '#', sizeof(buffer));
+        ASSERT_EQ(RID_ERROR_BUFFER_TOO_SMALL, rid_self_id_to_json(&message, buffer, size, NULL));
+        ASSERT_EQ(size - 1, strlen(buffer));
+        ASSERT_EQ(0, strncmp(full, buffer, size - 1));
+        ASSERT_EQ('#', buffer[size]);
+    }
+
+    PASS();
+}
+
 SUITE(self_id_suite) {
     RUN_TEST(test_self_id_init);
     RUN_TEST(test_self_id_init_null_pointer);
@@ -315,4 +350,6 @@ SUITE(self_id_suite) {
     RUN_TEST(test_self_id_to_json);
     RUN_TEST(test_self_id_to_json_null);
     RUN_TEST(test_self_id_to_json_needed);
+    RUN_TEST(test_self_id_to_json_escape);
+    RUN_TEST(test_self_id_to_json_truncated);
 }
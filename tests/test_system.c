@@ -1,4 +1,5 @@
 #include <stdint.h>
+#include <stdio.h>
 #include <string.h>
 
 #include "greatest.h"
@@ -812,6 +813,32 @@ TEST test_system_to_json(void) {
     PASS();
 }
 
+TEST test_system_to_json_matches_printf(void) {
+    rid_system_t system;
+    char buffer[1024];
+    char expected[64];
+
+    rid_system_init(&system);
+    system.operator_latitude = -337;
+    system.operator_longitude = 1799999999;
+
+    for (uint32_t encoded = 1; encoded <= 0xFFFF; encoded += 7) {
+        system.operator_altitude = (uint16_t)encoded;
+
+        ASSERT_EQ(RID_SUCCESS, rid_system_to_json(&system, buffer, sizeof(buffer), NULL));
+        snprintf(expected, sizeof(expected), "\"operator_altitude\":%.2f,", (double)rid_system_get_operator_altitude(&system));
+        ASSERT(strstr(buffer, expected) != NULL);
+    }
+
+    snprintf(expected, sizeof(expected), "\"operator_latitude\":%.7f,", rid_system_get_operator_latitude(&system));
+    ASSERT(strstr(buffer, expected) != NULL);
+    snprintf(expected, sizeof(expected), "\"operator_longitude\":%.7f,", rid_system_get_operator_longitude(&system));
+    ASSERT(strstr(buffer, expected) != NULL);
+    ASSERT(strstr(buffer, "\"operator_latitude\":-0.0000337,") != NULL);
+
+    PASS();
+}
+
 TEST test_system_to_json_null(void) {
     rid_system_t system;
     char buffer[1024];
@@ -942,4 +969,5 @@ SUITE(system_suite) {
     RUN_TEST(test_system_to_json_null);
     RUN_TEST(test_system_to_json_invalid_as_null);
     RUN_TEST(test_system_to_json_needed);
+    RUN_TEST(test_system_to_json_matches_printf);
 }
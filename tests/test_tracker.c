@@ -0,0 +1,327 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "greatest.h"
+#include "rid/basic_id.h"
+#include "rid/location.h"
+#include "rid/message.h"
+#include "rid/message_pack.h"
+#include "rid/operator_id.h"
+#include "rid/system.h"
+#include "rid/tracker.h"
+#include "rid/transport.h"
+
+static uint64_t storage[16384];
+
+static rid_address_t make_address(uint32_t n) {
+    rid_address_t address = {{0x02, 0x00, (uint8_t)(n >> 24), (uint8_t)(n >> 16), (uint8_t)(n >> 8), (uint8_t)n}};
+    return address;
+}
+
+TEST test_tracker_init(void) {
+    rid_tracker_t tracker;
+    size_t size = rid_tracker_storage_size(100);
+
+    ASSERT(size > 0);
+    ASSERT(size <= sizeof(storage));
+    ASSERT_EQ(RID_SUCCESS, rid_tracker_init(&tracker, storage, size, 100));
+    ASSERT_EQ(0, rid_tracker_count(&tracker));
+    ASSERT_EQ(100, tracker.capacity);
+
+    PASS();
+}
+
+TEST test_tracker_init_errors(void) {
+    rid_tracker_t tracker;
+    size_t size = rid_tracker_storage_size(100);
+
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_tracker_init(NULL, storage, size, 100));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_tracker_init(&tracker, NULL, size, 100));
+    ASSERT_EQ(RID_ERROR_OUT_OF_RANGE, rid_tracker_init(&tracker, storage, size, 0));
+    ASSERT_EQ(RID_ERROR_BUFFER_TOO_SMALL, rid_tracker_init(&tracker, storage, size - 1, 100));
+
+    PASS();
+}
+
+TEST test_tracker_update(void) {
+    rid_tracker_t tracker;
+    rid_address_t address = make_address(1);
+    rid_location_t location;
+    rid_basic_id_t basic_id;
+
+    rid_location_init(&location);
+    rid_location_set_latitude(&location, 60.1699);
+    rid_basic_id_init(&basic_id);
+    rid_basic_id_set_uas_id(&basic_id, "1ABCD2345EF678XYZ");
+
+    ASSERT_EQ(RID_SUCCESS, rid_tracker_init(&tracker, storage, sizeof(storage), 10));
+    ASSERT_EQ(NULL, rid_tracker_find(&tracker, &address));
+
+    ASSERT_EQ(RID_SUCCESS, rid_tracker_update(&tracker, &address, &location, 1000));
+    ASSERT_EQ(RID_SUCCESS, rid_tracker_update(&tracker, &address, &basic_id, 1500));
+    ASSERT_EQ(RID_SUCCESS, rid_tracker_update(&tracker, &address, &location, 2000));
+    ASSERT_EQ(1, rid_tracker_count(&tracker));
+
+    const rid_aircraft_t *aircraft = rid_tracker_find(&tracker, &address);
+    ASSERT(aircraft != NULL);
+    ASSERT_MEM_EQ(address.octets, aircraft->address.octets, RID_ADDRESS_SIZE);
+    ASSERT_EQ(1000, aircraft->first_seen);
+    ASSERT_EQ(2000, aircraft->last_seen);
+    ASSERT_EQ(2, aircraft->message_count[RID_MESSAGE_TYPE_LOCATION]);
+    ASSERT_EQ(1, aircraft->message_count[RID_MESSAGE_TYPE_BASIC_ID]);
+    ASSERT_EQ(0, aircraft->message_count[RID_MESSAGE_TYPE_SYSTEM]);
+
+    ASSERT_MEM_EQ(&location, rid_aircraft_get_message(aircraft, RID_MESSAGE_TYPE_LOCATION), RID_MESSAGE_SIZE);
+    ASSERT_MEM_EQ(&basic_id, rid_aircraft_get_message(aircraft, RID_MESSAGE_TYPE_BASIC_ID), RID_MESSAGE_SIZE);
+    ASSERT_EQ(NULL, rid_aircraft_get_message(aircraft, RID_MESSAGE_TYPE_SYSTEM));
+    ASSERT_EQ(NULL, rid_aircraft_get_message(aircraft, RID_MESSAGE_TYPE_MESSAGE_PACK));
+
+    PASS();
+}
+
+TEST test_tracker_update_latest_wins(void) {
+    rid_tracker_t tracker;
+    rid_address_t address = make_address(1);
+    rid_location_t location;
+
+    ASSERT_EQ(RID_SUCCESS, rid_tracker_init(&tracker, storage, sizeof(storage), 10));
+
+    rid_location_init(&location);
+    rid_location_set_speed(&location, 10.0f);
+    ASSERT_EQ(RID_SUCCESS, rid_tracker_update(&tracker, &address, &location, 1));
+    rid_location_set_speed(&location, 20.0f);
+    ASSERT_EQ(RID_SUCCESS, rid_tracker_update(&tracker, &address, &location, 2));
+
+    const void *latest = rid_aircraft_get_message(rid_tracker_find(&tracker, &address), RID_MESSAGE_TYPE_LOCATION);
+    ASSERT_EQ_FMT(20.0, (double)rid_location_get_speed(latest), "%f");
+
+    PASS();
+}
+
+TEST test_tracker_update_message_pack(void) {
+    rid_tracker_t tracker;
+    rid_address_t address = make_address(7);
+    rid_message_pack_t pack;
+    rid_location_t location;
+    rid_system_t system;
+    rid_operator_id_t operator_id;
+
+    rid_location_init(&location);
+    rid_system_init(&system);
+    rid_operator_id_init(&operator_id);
+    rid_operator_id_set(&operator_id, "FIN87astrdge12k8");
+
+    rid_message_pack_init(&pack);
+    rid_message_pack_add_message(&pack, &location);
+    rid_message_pack_add_message(&pack, &system);
+    rid_message_pack_add_message(&pack, &operator_id);
+
+    ASSERT_EQ(RID_SUCCESS, rid_tracker_init(&tracker, storage, sizeof(storage), 10));
+    ASSERT_EQ(RID_SUCCESS, rid_tracker_update(&tracker, &address, &pack, 5));
+
+    const rid_aircraft_t *aircraft = rid_tracker_find(&tracker, &address);
+    ASSERT(aircraft != NULL);
+    ASSERT_EQ(1, aircraft->message_count[RID_MESSAGE_TYPE_LOCATION]);
+    ASSERT_EQ(1, aircraft->message_count[RID_MESSAGE_TYPE_SYSTEM]);
+    ASSERT_EQ(1, aircraft->message_count[RID_MESSAGE_TYPE_OPERATOR_ID]);
+    ASSERT_MEM_EQ(&operator_id, rid_aircraft_get_message(aircraft, RID_MESSAGE_TYPE_OPERATOR_ID), RID_MESSAGE_SIZE);
+
+    pack.message_count = RID_MESSAGE_PACK_MAX_MESSAGES + 1;
+    ASSERT_EQ(RID_ERROR_INVALID_MESSAGE_COUNT, rid_tracker_update(&tracker, &address, &pack, 6));
+
+    PASS();
+}
+
+TEST test_tracker_update_errors(void) {
+    rid_tracker_t tracker;
+    rid_address_t address = make_address(1);
+    rid_message_t message;
+
+    memset(&message, 0, sizeof(message));
+    ASSERT_EQ(RID_SUCCESS, rid_tracker_init(&tracker, storage, sizeof(storage), 10));
+
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_tracker_update(NULL, &address, &message, 0));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_tracker_update(&tracker, NULL, &message, 0));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_tracker_update(&tracker, &address, NULL, 0));
+
+    message.message_type = 0x09;
+    ASSERT_EQ(RID_ERROR_UNKNOWN_MESSAGE_TYPE, rid_tracker_update(&tracker, &address, &message, 0));
+    ASSERT_EQ(0, rid_tracker_count(&tracker));
+
+    PASS();
+}
+
+TEST test_tracker_full(void) {
+    rid_tracker_t tracker;
+    rid_location_t location;
+
+    rid_location_init(&location);
+    ASSERT_EQ(RID_SUCCESS, rid_tracker_init(&tracker, storage, sizeof(storage), 3));
+
+    for (uint32_t i = 0; i < 3; ++i) {
+        rid_address_t address = make_address(i);
+        ASSERT_EQ(RID_SUCCESS, rid_tracker_update(&tracker, &address, &location, i));
+    }
+
+    rid_address_t address = make_address(3);
+    ASSERT_EQ(RID_ERROR_BUFFER_TOO_SMALL, rid_tracker_update(&tracker, &address, &location, 3));
+
+    /* Known aircraft can still be updated. */
+    address = make_address(1);
+    ASSERT_EQ(RID_SUCCESS, rid_tracker_update(&tracker, &address, &location, 3));
+
+    PASS();
+}
+
+TEST test_tracker_remove(void) {
+    rid_tracker_t tracker;
+    rid_location_t location;
+
+    rid_location_init(&location);
+    ASSERT_EQ(RID_SUCCESS, rid_tracker_init(&tracker, storage, sizeof(storage), 64));
+
+    for (uint32_t i = 0; i < 64; ++i) {
+        rid_address_t address = make_address(i);
+        ASSERT_EQ(RID_SUCCESS, rid_tracker_update(&tracker, &address, &location, i));
+    }
+
+    /* Remove every other aircraft. */
+    for (uint32_t i = 0; i < 64; i += 2) {
+        rid_address_t address = make_address(i);
+        ASSERT_EQ(RID_SUCCESS, rid_tracker_remove(&tracker, &address));
+        ASSERT_EQ(RID_ERROR_NOT_FOUND, rid_tracker_remove(&tracker, &address));
+    }
+
+    ASSERT_EQ(32, rid_tracker_count(&tracker));
+    for (uint32_t i = 0; i < 64; ++i) {
+        rid_address_t address = make_address(i);
+        const rid_aircraft_t *aircraft = rid_tracker_find(&tracker, &address);
+        if (i % 2) {
+            ASSERT(aircraft != NULL);
+            ASSERT_EQ(i, aircraft->first_seen);
+        } else {
+            ASSERT_EQ(NULL, aircraft);
+        }
+    }
+
+    PASS();
+}
+
+TEST test_tracker_expire(void) {
+    rid_tracker_t tracker;
+    rid_location_t location;
+
+    rid_location_init(&location);
+    ASSERT_EQ(RID_SUCCESS, rid_tracker_init(&tracker, storage, sizeof(storage), 100));
+
+    for (uint32_t i = 0; i < 100; ++i) {
+        rid_address_t address = make_address(i * 7919);
+        ASSERT_EQ(RID_SUCCESS, rid_tracker_update(&tracker, &address, &location, i));
+    }
+
+    ASSERT_EQ(0, rid_tracker_expire(&tracker, 0));
+    ASSERT_EQ(60, rid_tracker_expire(&tracker, 60));
+    ASSERT_EQ(40, rid_tracker_count(&tracker));
+
+    for (size_t i = 0; i < rid_tracker_count(&tracker); ++i) {
+        ASSERT(rid_tracker_get_at(&tracker, i)->last_seen >= 60);
+    }
+    for (uint32_t i = 0; i < 100; ++i) {
+        rid_address_t address = make_address(i * 7919);
+        ASSERT_EQ(i >= 60, rid_tracker_find(&tracker, &address) != NULL);
+    }
+
+    ASSERT_EQ(40, rid_tracker_expire(&tracker, UINT64_MAX));
+    ASSERT_EQ(0, rid_tracker_count(&tracker));
+    ASSERT_EQ(0, rid_tracker_expire(NULL, 0));
+
+    PASS();
+}
+
+TEST test_tracker_get_at(void) {
+    rid_tracker_t tracker;
+    rid_address_t address = make_address(5);
+    rid_location_t location;
+
+    rid_location_init(&location);
+    ASSERT_EQ(RID_SUCCESS, rid_tracker_init(&tracker, storage, sizeof(storage), 4));
+    ASSERT_EQ(RID_SUCCESS, rid_tracker_update(&tracker, &address, &location, 1));
+
+    ASSERT(rid_tracker_get_at(&tracker, 0) == rid_tracker_find(&tracker, &address));
+    ASSERT_EQ(NULL, rid_tracker_get_at(&tracker, 1));
+    ASSERT_EQ(NULL, rid_tracker_get_at(NULL, 0));
+
+    PASS();
+}
+
+TEST test_tracker_clear(void) {
+    rid_tracker_t tracker;
+    rid_address_t address = make_address(5);
+    rid_location_t location;
+
+    rid_location_init(&location);
+    ASSERT_EQ(RID_SUCCESS, rid_tracker_init(&tracker, storage, sizeof(storage), 4));
+    ASSERT_EQ(RID_SUCCESS, rid_tracker_update(&tracker, &address, &location, 1));
+    ASSERT_EQ(RID_SUCCESS, rid_tracker_clear(&tracker));
+
+    ASSERT_EQ(0, rid_tracker_count(&tracker));
+    ASSERT_EQ(NULL, rid_tracker_find(&tracker, &address));
+    ASSERT_EQ(RID_ERROR_NULL_POINTER, rid_tracker_clear(NULL));
+
+    PASS();
+}
+
+/* Random inserts and removals checked against a flat reference. */
+TEST test_tracker_churn(void) {
+    rid_tracker_t tracker;
+    rid_location_t location;
+    uint8_t present[512];
+    uint32_t state = 12345;
+
+    memset(present, 0, sizeof(present));
+    rid_location_init(&location);
+    ASSERT_EQ(RID_SUCCESS, rid_tracker_init(&tracker, storage, sizeof(storage), 512));
+
+    for (int n = 0; n < 20000; ++n) {
+        state = state * 1103515245 + 12345;
+        uint32_t key = (state >> 16) % 512;
+        rid_address_t address = make_address(key << 8);
+
+        if ((state >> 8) & 1) {
+            ASSERT_EQ(RID_SUCCESS, rid_tracker_update(&tracker, &address, &location, (uint64_t)n));
+            present[key] = 1;
+        } else {
+            ASSERT_EQ(present[key] ? RID_SUCCESS : RID_ERROR_NOT_FOUND, rid_tracker_remove(&tracker, &address));
+            present[key] = 0;
+        }
+    }
+
+    size_t count = 0;
+    for (uint32_t key = 0; key < 512; ++key) {
+        rid_address_t address = make_address(key << 8);
+        const rid_aircraft_t *aircraft = rid_tracker_find(&tracker, &address);
+        ASSERT_EQ(present[key], aircraft != NULL);
+        if (aircraft != NULL) {
+            ASSERT_MEM_EQ(address.octets, aircraft->address.octets, RID_ADDRESS_SIZE);
+        }
+        count += present[key];
+    }
+    ASSERT_EQ(count, rid_tracker_count(&tracker));
+
+    PASS();
+}
+
+SUITE(tracker_suite) {
+    RUN_TEST(test_tracker_init);
+    RUN_TEST(test_tracker_init_errors);
+    RUN_TEST(test_tracker_update);
+    RUN_TEST(test_tracker_update_latest_wins);
+    RUN_TEST(test_tracker_update_message_pack);
+    RUN_TEST(test_tracker_update_errors);
+    RUN_TEST(test_tracker_full);
+    RUN_TEST(test_tracker_remove);
+    RUN_TEST(test_tracker_expire);
+    RUN_TEST(test_tracker_get_at);
+    RUN_TEST(test_tracker_clear);
+    RUN_TEST(test_tracker_churn);
+}
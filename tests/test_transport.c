@@ -10,6 +10,16 @@ TEST test_transport_to_string(void) {
     PASS();
 }
 
+TEST test_transport_get_max_payload(void) {
+    ASSERT_EQ(25, rid_transport_get_max_payload(RID_TRANSPORT_BLUETOOTH_LEGACY));
+    ASSERT_EQ(255, rid_transport_get_max_payload(RID_TRANSPORT_BLUETOOTH_LONG_RANGE));
+    ASSERT_EQ(255, rid_transport_get_max_payload(RID_TRANSPORT_WIFI_NAN));
+    ASSERT_EQ(250, rid_transport_get_max_payload(RID_TRANSPORT_WIFI_BEACON));
+    ASSERT_EQ(0, rid_transport_get_max_payload((rid_transport_t)99));
+    PASS();
+}
+
 SUITE(transport_suite) {
     RUN_TEST(test_transport_to_string);
+    RUN_TEST(test_transport_get_max_payload);
 }
@@ -15,7 +15,26 @@ int main(int argc, char **argv) {
     RUN_SUITE(message_pack_suite);
     RUN_SUITE(auth_page_suite);
     RUN_SUITE(auth_suite);
+    RUN_SUITE(auth_cache_suite);
+    RUN_SUITE(auth_queue_suite);
+    RUN_SUITE(auth_reassembler_suite);
+    RUN_SUITE(auth_signer_suite);
     RUN_SUITE(transport_suite);
+    RUN_SUITE(decode_suite);
+    RUN_SUITE(location_batch_suite);
+    RUN_SUITE(tracker_suite);
+    RUN_SUITE(json_suite);
+    RUN_SUITE(ndjson_suite);
+    RUN_SUITE(cbor_suite);
+    RUN_SUITE(json_reader_suite);
+    RUN_SUITE(bluetooth_suite);
+    RUN_SUITE(nan_suite);
+    RUN_SUITE(beacon_suite);
+    RUN_SUITE(pcap_suite);
+    RUN_SUITE(pipeline_suite);
+    RUN_SUITE(ring_suite);
+    RUN_SUITE(scheduler_suite);
+    RUN_SUITE(packer_suite);
 
     GREATEST_MAIN_END();
 }
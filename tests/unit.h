@@ -12,6 +12,25 @@ extern SUITE(system_suite);
 extern SUITE(message_pack_suite);
 extern SUITE(auth_page_suite);
 extern SUITE(auth_suite);
+extern SUITE(auth_cache_suite);
+extern SUITE(auth_queue_suite);
+extern SUITE(auth_reassembler_suite);
+extern SUITE(auth_signer_suite);
 extern SUITE(transport_suite);
+extern SUITE(decode_suite);
+extern SUITE(location_batch_suite);
+extern SUITE(tracker_suite);
+extern SUITE(json_suite);
+extern SUITE(ndjson_suite);
+extern SUITE(cbor_suite);
+extern SUITE(json_reader_suite);
+extern SUITE(bluetooth_suite);
+extern SUITE(nan_suite);
+extern SUITE(beacon_suite);
+extern SUITE(pcap_suite);
+extern SUITE(pipeline_suite);
+extern SUITE(ring_suite);
+extern SUITE(scheduler_suite);
+extern SUITE(packer_suite);
 
 #endif
\ No newline at end of file